@@ -153,6 +153,16 @@ find_package(Lz4 REQUIRED)
 include_directories(SYSTEM ${LZ4_INCLUDE_DIR})
 ADD_THIRDPARTY_LIB(lz4 STATIC_LIB "${LZ4_STATIC_LIB}")
 
+## ZSTD
+# Optional for now: ZSTD compression and compression dictionaries are only available when the
+# library is present in the thirdparty directory.
+find_package(Zstd)
+if (ZSTD_FOUND)
+  include_directories(SYSTEM ${ZSTD_INCLUDE_DIR})
+  ADD_THIRDPARTY_LIB(zstd STATIC_LIB "${ZSTD_STATIC_LIB}")
+  ADD_CXX_FLAGS("-DZSTD")
+endif()
+
 ## ZLib
 find_package(Zlib REQUIRED)
 include_directories(SYSTEM ${ZLIB_INCLUDE_DIR})
@@ -114,6 +114,18 @@ DEFINE_bool(enable_cdc_state_table_caching, true, "Enable caching the cdc_state
 
 DEFINE_bool(enable_collect_cdc_metrics, true, "Enable collecting cdc metrics.");
 
+DEFINE_bool(cdc_state_batch_checkpoint_updates, false,
+            "Instead of writing the checkpoint to the cdc_state table in the GetChanges call, keep "
+            "the latest checkpoint of each tablet in memory and write checkpoints of all tablets "
+            "in one batch from the background thread. Cuts the cdc_state write load on tservers "
+            "with many replicated tablets.");
+TAG_FLAG(cdc_state_batch_checkpoint_updates, advanced);
+TAG_FLAG(cdc_state_batch_checkpoint_updates, runtime);
+
+DEFINE_test_flag(bool, cdc_fail_checkpoint_batch_flush, false,
+                 "Fail writing of the checkpoints buffered with "
+                 "cdc_state_batch_checkpoint_updates.");
+
 DEFINE_double(cdc_read_safe_deadline_ratio, .10,
               "When the heartbeat deadline has this percentage of time remaining, "
               "the master should halt tablet report processing so it can respond in time.");
@@ -1135,7 +1147,7 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
   if (record.checkpoint_type == IMPLICIT) {
     if (UpdateCheckpointRequired(record, cdc_sdk_op_id)) {
       s = UpdateCheckpoint(producer_tablet, OpId::FromPB(resp->checkpoint().op_id()),
-                           op_id, session, last_record_hybrid_time);
+                           op_id, session, last_record_hybrid_time, BatchCheckpointUpdate::kTrue);
     }
 
     RPC_STATUS_RETURN_ERROR(s, resp->mutable_error(), CDCErrorPB::INTERNAL_ERROR, context);
@@ -1365,6 +1377,8 @@ void CDCServiceImpl::UpdatePeersAndMetrics() {
       // Have not yet received any GetChanges requests, so skip background thread work.
       continue;
     }
+    WARN_NOT_OK(FlushPendingCheckpointUpdates(), "Failed to update checkpoints in cdc_state");
+
     // Should we update lag metrics default every 1s.
     if (ShouldUpdateLagMetrics(time_since_update_metrics)) {
       UpdateLagMetrics();
@@ -2031,35 +2045,88 @@ Status CDCServiceImpl::UpdateCheckpoint(const ProducerTabletInfo& producer_table
                                         const OpId& sent_op_id,
                                         const OpId& commit_op_id,
                                         const client::YBSessionPtr& session,
-                                        uint64_t last_record_hybrid_time) {
+                                        uint64_t last_record_hybrid_time,
+                                        BatchCheckpointUpdate batch) {
   bool update_cdc_state = impl_->UpdateCheckpoint(producer_tablet, sent_op_id, commit_op_id);
 
   if (update_cdc_state) {
-    auto cdc_state = VERIFY_RESULT(GetCdcStateTable());
-    const auto op = cdc_state->NewUpdateOp();
-    auto* const req = op->mutable_request();
-    DCHECK(!producer_tablet.stream_id.empty() && !producer_tablet.tablet_id.empty());
-    QLAddStringHashValue(req, producer_tablet.tablet_id);
-    QLAddStringRangeValue(req, producer_tablet.stream_id);
-
-    cdc_state->AddStringColumnValue(req, master::kCdcCheckpoint, commit_op_id.ToString());
     // If we have a last record hybrid time, use that for physical time. If not, it means we're
     // caught up, so the current time.
-    uint64_t last_replication_time_micros = last_record_hybrid_time != 0 ?
+    MicrosTime last_replication_time_micros = last_record_hybrid_time != 0 ?
         HybridTime(last_record_hybrid_time).GetPhysicalValueMicros() : GetCurrentTimeMicros();
-    cdc_state->AddTimestampColumnValue(req, master::kCdcLastReplicationTime,
-                                       last_replication_time_micros);
-    // Only perform the update if we have a row in cdc_state to prevent a race condition where
-    // a stream is deleted and then this logic inserts entries in cdc_state from that deleted
-    // stream.
-    auto* condition = req->mutable_if_expr()->mutable_condition();
-    condition->set_op(QL_OP_EXISTS);
+    if (batch && GetAtomicFlag(&FLAGS_cdc_state_batch_checkpoint_updates)) {
+      // The latest checkpoint of the tablet supersedes the pending one.
+      std::lock_guard<std::mutex> l(pending_checkpoint_updates_mutex_);
+      pending_checkpoint_updates_[producer_tablet] =
+          PendingCheckpoint{commit_op_id, last_replication_time_micros};
+      return Status::OK();
+    }
+    auto op = VERIFY_RESULT(
+        MakeCheckpointUpdateOp(producer_tablet, commit_op_id, last_replication_time_micros));
     RETURN_NOT_OK(RefreshCacheOnFail(session->ApplyAndFlush(op)));
   }
 
   return Status::OK();
 }
 
+Result<client::YBOperationPtr> CDCServiceImpl::MakeCheckpointUpdateOp(
+    const ProducerTabletInfo& producer_tablet, const OpId& checkpoint,
+    MicrosTime last_replication_time_micros) {
+  auto cdc_state = VERIFY_RESULT(GetCdcStateTable());
+  const auto op = cdc_state->NewUpdateOp();
+  auto* const req = op->mutable_request();
+  DCHECK(!producer_tablet.stream_id.empty() && !producer_tablet.tablet_id.empty());
+  QLAddStringHashValue(req, producer_tablet.tablet_id);
+  QLAddStringRangeValue(req, producer_tablet.stream_id);
+
+  cdc_state->AddStringColumnValue(req, master::kCdcCheckpoint, checkpoint.ToString());
+  cdc_state->AddTimestampColumnValue(req, master::kCdcLastReplicationTime,
+                                     last_replication_time_micros);
+  // Only perform the update if we have a row in cdc_state to prevent a race condition where
+  // a stream is deleted and then this logic inserts entries in cdc_state from that deleted
+  // stream.
+  auto* condition = req->mutable_if_expr()->mutable_condition();
+  condition->set_op(QL_OP_EXISTS);
+  return op;
+}
+
+Status CDCServiceImpl::FlushPendingCheckpointUpdates() {
+  std::unordered_map<ProducerTabletInfo, PendingCheckpoint, ProducerTabletInfo::Hash> checkpoints;
+  {
+    std::lock_guard<std::mutex> l(pending_checkpoint_updates_mutex_);
+    if (pending_checkpoint_updates_.empty()) {
+      return Status::OK();
+    }
+    checkpoints.swap(pending_checkpoint_updates_);
+  }
+
+  auto status = [this, &checkpoints]() -> Status {
+    if (FLAGS_TEST_cdc_fail_checkpoint_batch_flush) {
+      return STATUS(IOError, "Simulated failure of checkpoints batch flush");
+    }
+    std::vector<client::YBOperationPtr> ops;
+    ops.reserve(checkpoints.size());
+    for (const auto& tablet_and_checkpoint : checkpoints) {
+      const auto& pending = tablet_and_checkpoint.second;
+      ops.push_back(VERIFY_RESULT(MakeCheckpointUpdateOp(
+          tablet_and_checkpoint.first, pending.checkpoint, pending.last_replication_time_micros)));
+    }
+    auto session = client()->NewSession();
+    session->SetTimeout(MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms));
+    return RefreshCacheOnFail(session->ApplyAndFlush(ops));
+  }();
+
+  if (!status.ok()) {
+    // Checkpoints are retried on the next flush, a newer checkpoint of the tablet replaces them.
+    std::lock_guard<std::mutex> l(pending_checkpoint_updates_mutex_);
+    for (auto& tablet_and_checkpoint : checkpoints) {
+      pending_checkpoint_updates_.emplace(std::move(tablet_and_checkpoint));
+    }
+    return status.CloneAndPrepend(Format("Failed to update $0 checkpoints", checkpoints.size()));
+  }
+  return Status::OK();
+}
+
 std::shared_ptr<CDCTabletMetrics> CDCServiceImpl::GetCDCTabletMetrics(
     const ProducerTabletInfo& producer,
     std::shared_ptr<tablet::TabletPeer> tablet_peer) {
@@ -14,6 +14,8 @@
 #define ENT_SRC_YB_CDC_CDC_SERVICE_H
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "yb/cdc/cdc_error.h"
 #include "yb/cdc/cdc_metrics.h"
@@ -33,6 +35,7 @@
 
 #include "yb/util/net/net_util.h"
 #include "yb/util/service_util.h"
+#include "yb/util/strongly_typed_bool.h"
 
 namespace yb {
 
@@ -50,6 +53,9 @@ class TSTabletManager;
 
 namespace cdc {
 
+// Whether the checkpoint could be buffered, when cdc_state_batch_checkpoint_updates is set.
+YB_STRONGLY_TYPED_BOOL(BatchCheckpointUpdate);
+
 typedef std::unordered_map<HostPort, std::shared_ptr<CDCServiceProxy>, HostPortHash>
     CDCServiceProxyMap;
 
@@ -162,7 +168,8 @@ class CDCServiceImpl : public CDCServiceIf {
                                   const OpId& sent_op_id,
                                   const OpId& commit_op_id,
                                   const client::YBSessionPtr& session,
-                                  uint64_t last_record_hybrid_time);
+                                  uint64_t last_record_hybrid_time,
+                                  BatchCheckpointUpdate batch = BatchCheckpointUpdate::kFalse);
 
   Result<google::protobuf::RepeatedPtrField<master::TabletLocationsPB>> GetTablets(
       const CDCStreamId& stream_id);
@@ -229,6 +236,15 @@ class CDCServiceImpl : public CDCServiceIf {
 
   MicrosTime GetLastReplicatedTime(const std::shared_ptr<tablet::TabletPeer>& tablet_peer);
 
+  Result<client::YBOperationPtr> MakeCheckpointUpdateOp(
+      const ProducerTabletInfo& producer_tablet, const OpId& checkpoint,
+      MicrosTime last_replication_time_micros);
+
+  // Writes checkpoints buffered with cdc_state_batch_checkpoint_updates to cdc_state table.
+  // Checkpoints that failed to be written are kept, unless a newer checkpoint of the same tablet
+  // was buffered meanwhile.
+  CHECKED_STATUS FlushPendingCheckpointUpdates() EXCLUDES(pending_checkpoint_updates_mutex_);
+
   bool ShouldUpdateLagMetrics(MonoTime time_since_update_metrics);
 
   Result<std::shared_ptr<client::TableHandle>> GetCdcStateTable() EXCLUDES(mutex_);
@@ -292,6 +308,17 @@ class CDCServiceImpl : public CDCServiceIf {
 
   // True when this service has received a GetChanges request on a valid replication stream.
   std::atomic<bool> cdc_enabled_{false};
+
+  struct PendingCheckpoint {
+    OpId checkpoint;
+    MicrosTime last_replication_time_micros;
+  };
+
+  // Latest checkpoint of each tablet that was not written to cdc_state yet, see
+  // cdc_state_batch_checkpoint_updates.
+  std::mutex pending_checkpoint_updates_mutex_;
+  std::unordered_map<ProducerTabletInfo, PendingCheckpoint, ProducerTabletInfo::Hash>
+      pending_checkpoint_updates_ GUARDED_BY(pending_checkpoint_updates_mutex_);
 };
 
 }  // namespace cdc
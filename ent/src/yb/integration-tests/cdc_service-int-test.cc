@@ -77,6 +77,8 @@ DECLARE_int32(cdc_read_rpc_timeout_ms);
 DECLARE_int32(TEST_get_changes_read_loop_delay_ms);
 DECLARE_double(cdc_read_safe_deadline_ratio);
 DECLARE_bool(TEST_xcluster_simulate_have_more_records);
+DECLARE_bool(cdc_state_batch_checkpoint_updates);
+DECLARE_bool(TEST_cdc_fail_checkpoint_batch_flush);
 
 METRIC_DECLARE_entity(cdc);
 METRIC_DECLARE_gauge_int64(last_read_opid_index);
@@ -219,15 +221,13 @@ void VerifyCdcStateNotEmpty(client::YBClient* client) {
   ASSERT_GT(op_id.index, 0);
 }
 
-void VerifyCdcStateMatches(client::YBClient* client,
-                           const CDCStreamId& stream_id,
-                           const TabletId& tablet_id,
-                           uint64_t term,
-                           uint64_t index)  {
+Result<OpId> GetCdcStateCheckpoint(client::YBClient* client,
+                                   const CDCStreamId& stream_id,
+                                   const TabletId& tablet_id) {
   client::TableHandle table;
   client::YBTableName cdc_state_table(
       YQL_DATABASE_CQL, master::kSystemNamespaceName, master::kCdcStateTableName);
-  ASSERT_OK(table.Open(cdc_state_table, client));
+  RETURN_NOT_OK(table.Open(cdc_state_table, client));
   const auto op = table.NewReadOp();
   auto* const req = op->mutable_request();
   QLAddStringHashValue(req, tablet_id);
@@ -238,18 +238,26 @@ void VerifyCdcStateMatches(client::YBClient* client,
   table.AddColumns({master::kCdcCheckpoint}, req);
 
   auto session = client->NewSession();
-  ASSERT_OK(session->ApplyAndFlush(op));
+  RETURN_NOT_OK(session->ApplyAndFlush(op));
+
+  auto row_block = ql::RowsResult(op.get()).GetRowBlock();
+  if (row_block->row_count() != 1) {
+    return STATUS_FORMAT(IllegalState, "Expected 1 cdc_state row, found $0",
+                         row_block->row_count());
+  }
+
+  return OpId::FromString(row_block->row(0).column(0).string_value());
+}
 
+void VerifyCdcStateMatches(client::YBClient* client,
+                           const CDCStreamId& stream_id,
+                           const TabletId& tablet_id,
+                           uint64_t term,
+                           uint64_t index)  {
   LOG(INFO) << strings::Substitute("Verifying tablet: $0, stream: $1, op_id: $2",
       tablet_id, stream_id, OpId(term, index).ToString());
 
-  auto row_block = ql::RowsResult(op.get()).GetRowBlock();
-  ASSERT_EQ(row_block->row_count(), 1);
-
-  string checkpoint = row_block->row(0).column(0).string_value();
-  auto result = OpId::FromString(checkpoint);
-  ASSERT_OK(result);
-  OpId op_id = *result;
+  auto op_id = ASSERT_RESULT(GetCdcStateCheckpoint(client, stream_id, tablet_id));
 
   ASSERT_EQ(op_id.term, term);
   ASSERT_EQ(op_id.index, index);
@@ -1501,6 +1509,81 @@ TEST_P(CDCServiceTest, TestCheckpointUpdate) {
   VerifyStreamDeletedFromCdcState(client_.get(), stream_id_, tablet_id);
 }
 
+// Test that checkpoints buffered with cdc_state_batch_checkpoint_updates reach cdc_state table,
+// and are kept until written when the batch flush fails.
+TEST_P(CDCServiceTest, TestBatchedCheckpointUpdate) {
+  FLAGS_cdc_state_checkpoint_update_interval_ms = 0;
+  FLAGS_cdc_state_batch_checkpoint_updates = true;
+  FLAGS_TEST_cdc_fail_checkpoint_batch_flush = true;
+
+  CreateCDCStream(cdc_proxy_, table_.table()->id(), &stream_id_);
+
+  std::string tablet_id;
+  GetTablet(&tablet_id);
+
+  const auto& proxy = cluster_->mini_tablet_server(0)->server()->proxy();
+
+  // Insert test rows.
+  tserver::WriteRequestPB write_req;
+  tserver::WriteResponsePB write_resp;
+  write_req.set_tablet_id(tablet_id);
+  {
+    RpcController rpc;
+    AddTestRowInsert(1, 11, "key1", &write_req);
+    AddTestRowInsert(2, 22, "key2", &write_req);
+
+    SCOPED_TRACE(write_req.DebugString());
+    ASSERT_OK(WriteToProxyWithRetries(proxy, write_req, &write_resp, &rpc));
+    SCOPED_TRACE(write_resp.DebugString());
+    ASSERT_FALSE(write_resp.has_error());
+  }
+
+  GetChangesRequestPB change_req;
+  GetChangesResponsePB change_resp;
+
+  change_req.set_tablet_id(tablet_id);
+  change_req.set_stream_id(stream_id_);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_index(0);
+  change_req.mutable_from_checkpoint()->mutable_op_id()->set_term(0);
+
+  {
+    RpcController rpc;
+    SCOPED_TRACE(change_req.DebugString());
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    SCOPED_TRACE(change_resp.DebugString());
+    ASSERT_FALSE(change_resp.has_error());
+    ASSERT_EQ(change_resp.records_size(), 2);
+  }
+
+  // Pass in checkpoint that producer can mark as committed.
+  const auto checkpoint = change_resp.checkpoint().op_id();
+  change_req.mutable_from_checkpoint()->CopyFrom(change_resp.checkpoint());
+  change_resp.Clear();
+  {
+    RpcController rpc;
+    SCOPED_TRACE(change_req.DebugString());
+    ASSERT_OK(cdc_proxy_->GetChanges(change_req, &change_resp, &rpc));
+    SCOPED_TRACE(change_resp.DebugString());
+    ASSERT_FALSE(change_resp.has_error());
+    ASSERT_EQ(change_resp.records_size(), 0);
+  }
+
+  // Several flush attempts fail meanwhile, the checkpoint is not written.
+  SleepFor(MonoDelta::FromMilliseconds(500 * kTimeMultiplier));
+  ASSERT_NO_FATALS(VerifyCdcStateMatches(client_.get(), stream_id_, tablet_id, 0, 0));
+
+  // The failed checkpoint is written by a later flush, without another GetChanges call.
+  FLAGS_TEST_cdc_fail_checkpoint_batch_flush = false;
+  ASSERT_OK(WaitFor([&]() -> Result<bool> {
+    return GetCdcStateCheckpoint(client_.get(), stream_id_, tablet_id) ==
+           OpId::FromPB(checkpoint);
+  }, MonoDelta::FromSeconds(10) * kTimeMultiplier, "Wait for checkpoint in cdc_state"));
+
+  // Cleanup stream before shutdown.
+  ASSERT_OK(client_->DeleteCDCStream(stream_id_));
+  VerifyStreamDeletedFromCdcState(client_.get(), stream_id_, tablet_id);
+}
+
 namespace {
 void WaitForCDCIndex(const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
                      int64_t expected_index,
@@ -24,6 +24,9 @@
 
 #include "yb/gutil/strings/substitute.h"
 
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/scheduler.h"
+
 #include "yb/util/logging.h"
 #include "yb/util/status_log.h"
 #include "yb/util/threadpool.h"
@@ -44,6 +47,8 @@ DEFINE_bool(cdc_consumer_use_proxy_forwarding, false,
 
 DECLARE_int32(cdc_read_rpc_timeout_ms);
 
+using namespace std::literals;
+
 namespace yb {
 namespace tserver {
 namespace enterprise {
@@ -121,9 +126,35 @@ void CDCPoller::DoPoll() {
     delay = std::max(delay, (int64_t)1 << poll_failures_); // exponential backoff for failures.
   }
   if (delay > 0) {
-    SleepFor(MonoDelta::FromMilliseconds(delay));
+    // Wait in the scheduler instead of sleeping, so pollers of idle tablets do not occupy threads
+    // of the shared thread pool while backing off.
+    std::weak_ptr<CDCPoller> weak_poller(retained);
+    producer_client_->client->messenger()->scheduler().Schedule(
+        [weak_poller](const Status& status) {
+          auto poller = weak_poller.lock();
+          if (!poller || !status.ok()) {
+            return;
+          }
+          WARN_NOT_OK(poller->thread_pool_->SubmitFunc(
+                          std::bind(&CDCPoller::DoDelayedPoll, poller.get())),
+                      "Could not submit delayed Poll to thread pool");
+        },
+        delay * 1ms);
+    return;
   }
 
+  SendGetChanges();
+}
+
+void CDCPoller::DoDelayedPoll() {
+  RETURN_WHEN_OFFLINE();
+
+  auto retained = shared_from_this();
+  std::lock_guard<std::mutex> l(data_mutex_);
+  SendGetChanges();
+}
+
+void CDCPoller::SendGetChanges() {
   cdc::GetChangesRequestPB req;
   req.set_stream_id(producer_tablet_info_.stream_id);
   req.set_tablet_id(producer_tablet_info_.tablet_id);
@@ -70,6 +70,9 @@ class CDCPoller : public std::enable_shared_from_this<CDCPoller> {
   bool CheckOnline();
 
   void DoPoll();
+  // Polls after the backoff delay scheduled by DoPoll.
+  void DoDelayedPoll();
+  void SendGetChanges() REQUIRES(data_mutex_);
   // Does the work of sending the changes to the output client.
   void HandlePoll(yb::Status status,
                   std::shared_ptr<cdc::GetChangesResponsePB> resp);
@@ -13,6 +13,7 @@
 #include "yb/tserver/twodc_output_client.h"
 
 #include <shared_mutex>
+#include <unordered_map>
 
 #include "yb/cdc/cdc_util.h"
 #include "yb/cdc/cdc_rpc.h"
@@ -69,19 +70,21 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
       producer_tablet_info_(producer_tablet_info),
       local_client_(local_client),
       rpcs_(rpcs),
-      write_handle_(rpcs->InvalidHandle()),
       apply_changes_clbk_(std::move(apply_changes_clbk)),
       use_local_tserver_(use_local_tserver),
       all_tablets_result_(STATUS(Uninitialized, "Result has not been initialized.")) {}
 
   ~TwoDCOutputClient() {
     std::lock_guard<decltype(lock_)> l(lock_);
-    rpcs_->Abort({&write_handle_});
+    for (auto& tablet_and_handle : write_handles_) {
+      rpcs_->Abort({&tablet_and_handle.second});
+    }
   }
 
   CHECKED_STATUS ApplyChanges(const cdc::GetChangesResponsePB* resp) override;
 
-  void WriteCDCRecordDone(const Status& status, const WriteResponsePB& response);
+  void WriteCDCRecordDone(
+      const TabletId& tablet_id, const Status& status, const WriteResponsePB& response);
 
  private:
 
@@ -107,6 +110,10 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   CHECKED_STATUS ProcessRecord(
       const std::vector<std::string>& tablet_ids, const cdc::CDCRecordPB& record);
 
+  // Sends the first buffered write of every tablet, following writes for a tablet are sent when
+  // the previous one completes.
+  CHECKED_STATUS SendBufferedWrites();
+
   void SendNextCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request);
 
   // Increment processed record count.
@@ -126,14 +133,17 @@ class TwoDCOutputClient : public cdc::CDCOutputClient {
   cdc::ProducerTabletInfo producer_tablet_info_;
   std::shared_ptr<CDCClient> local_client_;
   rpc::Rpcs* rpcs_;
-  rpc::Rpcs::Handle write_handle_ GUARDED_BY(lock_);
+  // Handles of write RPCs by destination tablet, there is at most one write in flight per tablet.
+  // Entries are not erased, so aborting an RPC could wait on its handle.
+  std::unordered_map<TabletId, rpc::Rpcs::Handle> write_handles_ GUARDED_BY(lock_);
+  size_t num_outstanding_tablet_writes_ GUARDED_BY(lock_) = 0;
   std::function<void(const cdc::OutputClientResponse& response)> apply_changes_clbk_;
 
   bool use_local_tserver_;
 
   std::shared_ptr<client::YBTable> table_;
 
-  // Used to protect error_status_, op_id_, done_processing_, write_handle_ and record counts.
+  // Used to protect error_status_, op_id_, done_processing_, write handles and record counts.
   mutable rw_spinlock lock_;
   Status error_status_ GUARDED_BY(lock_);
   OpIdPB op_id_ GUARDED_BY(lock_) = consensus::MinimumOpId();
@@ -248,22 +258,30 @@ Status TwoDCOutputClient::ProcessChangesStartingFromIndex(int start) {
   }
 
   if (processed_write_record) {
-    // Send out the buffered writes.
-    std::unique_ptr<WriteRequestPB> write_request;
-    {
-      std::lock_guard<decltype(lock_)> l(lock_);
-      write_request = write_strategy_->GetNextWriteRequest();
-    }
-    if (!write_request) {
-      LOG(WARNING) << "Expected to find a write_request but were unable to";
-      return STATUS(IllegalState, "Could not find a write request to send");
-    }
-    SendNextCDCWriteToTablet(std::move(write_request));
+    return SendBufferedWrites();
   }
 
   return Status::OK();
 }
 
+Status TwoDCOutputClient::SendBufferedWrites() {
+  std::vector<std::unique_ptr<WriteRequestPB>> write_requests;
+  {
+    std::lock_guard<decltype(lock_)> l(lock_);
+    write_requests = write_strategy_->GetFirstWriteRequests();
+    // Set before sending, since writes could complete before all of them are sent.
+    num_outstanding_tablet_writes_ = write_requests.size();
+  }
+  if (write_requests.empty()) {
+    LOG(WARNING) << "Expected to find a write_request but were unable to";
+    return STATUS(IllegalState, "Could not find a write request to send");
+  }
+  for (auto& write_request : write_requests) {
+    SendNextCDCWriteToTablet(std::move(write_request));
+  }
+  return Status::OK();
+}
+
 bool TwoDCOutputClient::UseLocalTserver() {
   return use_local_tserver_ && !FLAGS_cdc_force_remote_tserver;
 }
@@ -343,52 +361,64 @@ Status TwoDCOutputClient::ProcessSplitOp(const cdc::CDCRecordPB& record) {
 }
 
 void TwoDCOutputClient::SendNextCDCWriteToTablet(std::unique_ptr<WriteRequestPB> write_request) {
-  // TODO: This should be parallelized for better performance with M:N setups.
   auto deadline = CoarseMonoClock::Now() +
                   MonoDelta::FromMilliseconds(FLAGS_cdc_write_rpc_timeout_ms);
   std::lock_guard<decltype(lock_)> l(lock_);
-  write_handle_ = rpcs_->Prepare();
-  if (write_handle_ != rpcs_->InvalidHandle()) {
+  auto& write_handle = write_handles_.emplace(
+      write_request->tablet_id(), rpcs_->InvalidHandle()).first->second;
+  write_handle = rpcs_->Prepare();
+  if (write_handle != rpcs_->InvalidHandle()) {
     // Send in nullptr for RemoteTablet since cdc rpc now gets the tablet_id from the write request.
-    *write_handle_ = CreateCDCWriteRpc(
+    *write_handle = CreateCDCWriteRpc(
         deadline,
         nullptr /* RemoteTablet */,
         table_,
         local_client_->client.get(),
         write_request.get(),
-        std::bind(&TwoDCOutputClient::WriteCDCRecordDone, this, _1, _2),
+        std::bind(&TwoDCOutputClient::WriteCDCRecordDone, this, write_request->tablet_id(), _1,
+                  _2),
         UseLocalTserver());
-    (**write_handle_).SendRpc();
+    (**write_handle).SendRpc();
   } else {
     LOG(WARNING) << "Invalid handle for CDC write, tablet ID: " << write_request->tablet_id();
   }
 }
 
-void TwoDCOutputClient::WriteCDCRecordDone(const Status& status, const WriteResponsePB& response) {
+void TwoDCOutputClient::WriteCDCRecordDone(
+    const TabletId& tablet_id, const Status& status, const WriteResponsePB& response) {
   // Handle response.
   rpc::RpcCommandPtr retained = nullptr;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    retained = rpcs_->Unregister(&write_handle_);
+    retained = rpcs_->Unregister(&write_handles_[tablet_id]);
   }
   if (!status.ok()) {
-    HandleError(status, true /* done */);
-    return;
+    HandleError(status, false /* done */);
   } else if (response.has_error()) {
-    HandleError(StatusFromPB(response.error().status()), true /* done */);
-    return;
+    HandleError(StatusFromPB(response.error().status()), false /* done */);
+  } else {
+    cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
   }
-  cdc_consumer_->IncrementNumSuccessfulWriteRpcs();
 
-  // See if we need to handle any more writes.
+  // See if we need to handle any more writes for this tablet. After a failure no more writes are
+  // sent, but the response is returned only after writes to other tablets are completed.
   std::unique_ptr <WriteRequestPB> write_request;
+  bool failed;
   {
     std::lock_guard<decltype(lock_)> l(lock_);
-    write_request = write_strategy_->GetNextWriteRequest();
+    failed = !error_status_.ok();
+    if (!failed) {
+      write_request = write_strategy_->GetNextWriteRequest(tablet_id);
+    }
+    if (!write_request && --num_outstanding_tablet_writes_ != 0) {
+      return;
+    }
   }
 
   if (write_request) {
     SendNextCDCWriteToTablet(std::move(write_request));
+  } else if (failed) {
+    HandleResponse();
   } else {
     // We may still have more records to process (in case of ddls/master requests).
     int next_record = 0;
@@ -137,7 +137,7 @@ CHECKED_STATUS AddRecord(
 // Max number of records in a request is cdc_max_apply_batch_num_records, and max size of a request
 // is cdc_max_apply_batch_size_kb. Batches are not sent by opid order, since a GetChangesResponse
 // can contain interleaved records to multiple tablets. Rather, we send batches to each tablet
-// in order for that tablet, before moving on to the next tablet.
+// in order for that tablet, while different tablets are written in parallel.
 class BatchedWriteImplementation : public TwoDCWriteInterface {
   ~BatchedWriteImplementation() = default;
 
@@ -169,16 +169,28 @@ class BatchedWriteImplementation : public TwoDCWriteInterface {
     return AddRecord(record, write_request->mutable_write_batch());
   }
 
-  std::unique_ptr<WriteRequestPB> GetNextWriteRequest() override {
-    if (records_.empty()) {
+  std::vector<std::unique_ptr<WriteRequestPB>> GetFirstWriteRequests() override {
+    std::vector<std::unique_ptr<WriteRequestPB>> result;
+    result.reserve(records_.size());
+    for (auto& tablet_and_queue : records_) {
+      result.push_back(std::move(tablet_and_queue.second.front()));
+      tablet_and_queue.second.pop_front();
+    }
+    return result;
+  }
+
+  std::unique_ptr<WriteRequestPB> GetNextWriteRequest(const std::string& tablet_id) override {
+    auto it = records_.find(tablet_id);
+    if (it == records_.end()) {
       return nullptr;
     }
-    auto& queue = records_.begin()->second;
-    auto next_req = std::move(queue.front());
-    queue.pop_front();
+    auto& queue = it->second;
     if (queue.empty()) {
-      records_.erase(next_req->tablet_id());
+      records_.erase(it);
+      return nullptr;
     }
+    auto next_req = std::move(queue.front());
+    queue.pop_front();
     return next_req;
   }
 
@@ -15,6 +15,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace yb {
 namespace cdc {
@@ -31,7 +32,12 @@ namespace enterprise {
 class TwoDCWriteInterface {
  public:
   virtual ~TwoDCWriteInterface() {}
-  virtual std::unique_ptr<WriteRequestPB> GetNextWriteRequest() = 0;
+  // Returns the first pending write request of every tablet. Writes to different tablets could be
+  // sent in parallel.
+  virtual std::vector<std::unique_ptr<WriteRequestPB>> GetFirstWriteRequests() = 0;
+  // Returns the next write request for the tablet, should be invoked after the previous write
+  // request for this tablet was completed. Returns nullptr if there are no more writes for it.
+  virtual std::unique_ptr<WriteRequestPB> GetNextWriteRequest(const std::string& tablet_id) = 0;
   virtual CHECKED_STATUS ProcessRecord(
       const std::string& tablet_id, const cdc::CDCRecordPB& record) = 0;
 };
@@ -30,10 +30,12 @@ import org.slf4j.LoggerFactory;
 
 import org.yb.YBTestRunner;
 
+import com.datastax.driver.core.BatchStatement;
 import com.datastax.driver.core.PreparedStatement;
 import com.datastax.driver.core.ResultSet;
 import com.datastax.driver.core.Row;
 import com.datastax.driver.core.Session;
+import com.datastax.driver.core.SimpleStatement;
 import com.datastax.driver.core.exceptions.SyntaxError;
 import com.datastax.driver.core.exceptions.UnauthorizedException;
 import com.google.common.io.Closeables;
@@ -716,6 +718,40 @@ public class TestAuthorizationEnforcement extends BaseAuthenticationCQLTest {
     insertRow(cs2.getSession(), keyspace, table);
   }
 
+  @Test
+  public void testBatchStatementWithCachedParseTree() throws Exception {
+    createTableAndVerify(cs.getSession(), keyspace, table);
+
+    BatchStatement batch = new BatchStatement();
+    batch.add(new SimpleStatement(
+        String.format("INSERT INTO %s.%s (h, v) VALUES (%d, %d)", keyspace, table, VALUE, VALUE)));
+
+    // Run the batch as the superuser on every tserver, so that the parse tree of the non-prepared
+    // INSERT is cached everywhere before the role without permissions runs the same batch.
+    for (int i = 0; i < NUM_TABLET_SERVERS; i++) {
+      cs.getSession().execute(batch);
+    }
+
+    thrown.expect(UnauthorizedException.class);
+    cs2.getSession().execute(batch);
+  }
+
+  @Test
+  public void testBatchStatementWithModifyPermissionAndCachedParseTree() throws Exception {
+    createTableAndVerify(cs.getSession(), keyspace, table);
+    grantPermission(MODIFY, TABLE, table, username);
+
+    BatchStatement batch = new BatchStatement();
+    batch.add(new SimpleStatement(
+        String.format("INSERT INTO %s.%s (h, v) VALUES (%d, %d)", keyspace, table, VALUE, VALUE)));
+    for (int i = 0; i < NUM_TABLET_SERVERS; i++) {
+      cs.getSession().execute(batch);
+    }
+
+    cs2.getSession().execute(batch);
+    selectAndVerify(cs.getSession(), keyspace, table);
+  }
+
   /*
    * UPDDATE statements tests.
    */
@@ -13,6 +13,9 @@
 
 #include "yb/client/async_rpc.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "yb/client/batcher.h"
 #include "yb/client/client_error.h"
 #include "yb/client/in_flight_op.h"
@@ -30,7 +33,9 @@
 #include "yb/gutil/casts.h"
 #include "yb/gutil/strings/substitute.h"
 
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_controller.h"
+#include "yb/rpc/scheduler.h"
 
 #include "yb/util/cast.h"
 #include "yb/util/flag_tags.h"
@@ -70,6 +75,12 @@ METRIC_DEFINE_counter(server, consistent_prefix_failed_reads,
     yb::MetricUnit::kRequests,
     "Number of consistent prefix reads that failed to be served by the closest replica.");
 
+METRIC_DEFINE_counter(server, consistent_prefix_hedged_reads,
+    "Number of consistent prefix reads that were also sent to another replica.",
+    yb::MetricUnit::kRequests,
+    "Number of consistent prefix reads that were also sent to another replica, because the "
+    "first replica did not reply in time.");
+
 DEFINE_int32(ybclient_print_trace_every_n, 0,
              "Controls the rate at which traces from ybclient are printed. Setting this to 0 "
              "disables printing the collected traces.");
@@ -89,6 +100,25 @@ DEFINE_bool(detect_duplicates_for_retryable_requests, true,
 DEFINE_bool(ysql_forward_rpcs_to_local_tserver, false,
             "When true, forward the PGSQL rpcs to the local tServer.");
 
+DEFINE_bool(ybclient_hedged_reads, false,
+            "When true, consistent prefix read that did not get reply from the selected replica "
+            "in time is also sent to the next closest replica, and the first successful response "
+            "is used.");
+TAG_FLAG(ybclient_hedged_reads, advanced);
+TAG_FLAG(ybclient_hedged_reads, runtime);
+
+DEFINE_int32(ybclient_hedged_read_min_delay_ms, 5,
+             "Min time to wait for reply from the selected replica before the read is hedged. "
+             "Time is estimated from latencies of reads served by the replica's tablet server.");
+TAG_FLAG(ybclient_hedged_read_min_delay_ms, advanced);
+TAG_FLAG(ybclient_hedged_read_min_delay_ms, runtime);
+
+DEFINE_int32(ybclient_hedged_read_max_delay_ms, 200,
+             "Max time to wait for reply from the selected replica before the read is hedged. "
+             "Also used when there is no latency estimate for the replica's tablet server.");
+TAG_FLAG(ybclient_hedged_read_max_delay_ms, advanced);
+TAG_FLAG(ybclient_hedged_read_max_delay_ms, runtime);
+
 DEFINE_CAPABILITY(PickReadTimeAtTabletServer, 0x8284d67b);
 
 DECLARE_bool(collect_end_to_end_traces);
@@ -133,7 +163,8 @@ AsyncRpcMetrics::AsyncRpcMetrics(const scoped_refptr<yb::MetricEntity>& entity)
       time_to_send(METRIC_handler_latency_yb_client_time_to_send.Instantiate(entity)),
       consistent_prefix_successful_reads(
           METRIC_consistent_prefix_successful_reads.Instantiate(entity)),
-      consistent_prefix_failed_reads(METRIC_consistent_prefix_failed_reads.Instantiate(entity)) {
+      consistent_prefix_failed_reads(METRIC_consistent_prefix_failed_reads.Instantiate(entity)),
+      consistent_prefix_hedged_reads(METRIC_consistent_prefix_hedged_reads.Instantiate(entity)) {
 }
 
 AsyncRpc::AsyncRpc(
@@ -207,19 +238,23 @@ std::shared_ptr<const YBTable> AsyncRpc::table() const {
 void AsyncRpc::Finished(const Status& status) {
   Status new_status = status;
   if (tablet_invoker_.Done(&new_status)) {
-    if (tablet().is_split() ||
-        ClientError(new_status) == ClientErrorCode::kTablePartitionListIsStale) {
-      ops_[0].yb_op->MarkTablePartitionListAsStale();
-    }
-    if (async_rpc_metrics_ && status.ok() && tablet_invoker_.is_consistent_prefix()) {
-      IncrementCounter(async_rpc_metrics_->consistent_prefix_successful_reads);
-    }
-    ProcessResponseFromTserver(new_status);
-    batcher_->Flushed(ops_, new_status, MakeFlushExtraResult());
-    retained_self_.reset();
+    Complete(status, new_status);
   }
 }
 
+void AsyncRpc::Complete(const Status& status, const Status& new_status) {
+  if (tablet().is_split() ||
+      ClientError(new_status) == ClientErrorCode::kTablePartitionListIsStale) {
+    ops_[0].yb_op->MarkTablePartitionListAsStale();
+  }
+  if (async_rpc_metrics_ && status.ok() && tablet_invoker_.is_consistent_prefix()) {
+    IncrementCounter(async_rpc_metrics_->consistent_prefix_successful_reads);
+  }
+  ProcessResponseFromTserver(new_status);
+  batcher_->Flushed(ops_, new_status, MakeFlushExtraResult());
+  retained_self_.reset();
+}
+
 void AsyncRpc::Failed(const Status& status) {
   std::string error_message = status.message().ToBuffer();
   auto redis_error_code = status.IsInvalidCommand() || status.IsInvalidArgument() ?
@@ -460,13 +495,18 @@ void HandleExtraFields(YBqlReadOp* op, tserver::ReadRequestPB* req) {
 
 template <class OpType, class Req, class Out>
 void FillOps(
-    const InFlightOps& ops, YBOperation::Type expected_type, Req* req, Out* out) {
+    const InFlightOps& ops, YBOperation::Type expected_type, Req* req, Out* out,
+    bool copy_requests = false) {
   out->Reserve(narrow_cast<int>(ops.size()));
   size_t idx = 0;
   for (auto& op : ops) {
     CHECK_EQ(op.yb_op->type(), expected_type);
     auto* concrete_op = down_cast<OpType*>(op.yb_op.get());
-    out->AddAllocated(concrete_op->mutable_request());
+    if (copy_requests) {
+      out->Add()->CopyFrom(*concrete_op->mutable_request());
+    } else {
+      out->AddAllocated(concrete_op->mutable_request());
+    }
     HandleExtraFields(concrete_op, req);
     VLOG(4) << ++idx << ") encoded row: " << op.yb_op->ToString();
   }
@@ -581,7 +621,7 @@ void WriteRpc::SwapResponses() {
         const auto& ql_response = ql_op->response();
         if (ql_response.has_rows_data_sidecar()) {
           Slice rows_data = CHECK_RESULT(
-              retrier().controller().GetSidecar(ql_response.rows_data_sidecar()));
+              SidecarController().GetSidecar(ql_response.rows_data_sidecar()));
           ql_op->mutable_rows_data()->assign(rows_data.cdata(), rows_data.size());
         }
         ql_idx++;
@@ -634,29 +674,133 @@ void WriteRpc::NotifyBatcher(const Status& status) {
   batcher_->ProcessWriteResponse(*this, status);
 }
 
+bool WriteRpc::CanCoalesce() const {
+  return table()->table_type() == YBTableType::YQL_TABLE_TYPE && !batcher_->transaction() &&
+         !req_.has_write_batch() && !req_.has_read_time() && !req_.has_external_hybrid_time() &&
+         coalesced_into_ == nullptr && coalesced_.empty();
+}
+
+void WriteRpc::Coalesce(const std::shared_ptr<WriteRpc>& rpc) {
+  DCHECK(rpc->CanCoalesce());
+  // Requests are owned by operations, so they are released by both RPCs, see ~WriteRpc.
+  auto* batch = req_.mutable_ql_write_batch();
+  for (auto& request : *rpc->req_.mutable_ql_write_batch()) {
+    batch->AddAllocated(&request);
+  }
+  if (rpc->req_.propagated_hybrid_time() > req_.propagated_hybrid_time()) {
+    req_.set_propagated_hybrid_time(rpc->req_.propagated_hybrid_time());
+  }
+  TRACE_TO(rpc->trace_, "Coalesced into $0", ToString());
+  rpc->coalesced_into_ = this;
+  rpc->retained_self_ = rpc;
+  coalesced_.push_back(rpc);
+}
+
+void WriteRpc::ProcessResponseFromTserver(const Status& status) {
+  if (!coalesced_.empty()) {
+    // Responses for operations of coalesced RPCs follow responses for own operations, in the
+    // order of requests.
+    auto* responses = resp_.mutable_ql_response_batch();
+    const auto num_own_responses = narrow_cast<int>(ops_.size());
+    auto idx = num_own_responses;
+    for (const auto& rpc : coalesced_) {
+      auto& rpc_resp = rpc->resp_;
+      if (resp_.has_error()) {
+        *rpc_resp.mutable_error() = resp_.error();
+      }
+      if (resp_.has_propagated_hybrid_time()) {
+        rpc_resp.set_propagated_hybrid_time(resp_.propagated_hybrid_time());
+      }
+      for (size_t i = 0; i != rpc->ops_.size() && idx < responses->size(); ++i, ++idx) {
+        rpc_resp.add_ql_response_batch()->Swap(responses->Mutable(idx));
+      }
+      rpc->CoalescedFinished(status);
+    }
+    coalesced_.clear();
+    if (responses->size() > num_own_responses) {
+      responses->DeleteSubrange(num_own_responses, responses->size() - num_own_responses);
+    }
+  }
+  AsyncRpcBase::ProcessResponseFromTserver(status);
+}
+
+void WriteRpc::CoalescedFinished(const Status& status) {
+  if (!status.ok()) {
+    if (tablet().is_split() ||
+        ClientError(status) == ClientErrorCode::kTablePartitionListIsStale) {
+      ops_[0].yb_op->MarkTablePartitionListAsStale();
+    }
+    Failed(status);
+  }
+  ProcessResponseFromTserver(status);
+  batcher_->Flushed(ops_, status, MakeFlushExtraResult());
+  retained_self_.reset();
+}
+
+const rpc::RpcController& WriteRpc::SidecarController() const {
+  return coalesced_into_ ? coalesced_into_->retrier().controller() : retrier().controller();
+}
+
 bool WriteRpc::ShouldRetryExpiredRequest() {
   return req_.min_running_request_id() == kInitializeFromMinRunning;
 }
 
+struct ReadRpc::HedgeState {
+  // Number of copies of the read that are not finished yet.
+  std::atomic<size_t> running{1};
+  std::atomic<bool> completed{false};
+
+  // Returns false if operations were already completed, so hedged copy should not be sent.
+  bool Start() {
+    ++running;
+    if (completed.load()) {
+      --running;
+      return false;
+    }
+    return true;
+  }
+
+  // Returns true if finished copy of the read should complete operations. Failure completes
+  // operations only when there are no other copies that could succeed.
+  bool Finish(bool success) {
+    const bool last = --running == 0;
+    if (!success && !last) {
+      return false;
+    }
+    bool expected = false;
+    return completed.compare_exchange_strong(expected, true);
+  }
+};
+
 ReadRpc::ReadRpc(const AsyncRpcData& data, YBConsistencyLevel yb_consistency_level)
-    : AsyncRpcBase(data, yb_consistency_level) {
+    : AsyncRpcBase(data, yb_consistency_level),
+      hedge_(yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX &&
+             !tablet_invoker_.local_tserver_only() && GetAtomicFlag(&FLAGS_ybclient_hedged_reads)
+                 ? std::make_shared<HedgeState>() : nullptr),
+      is_hedge_(false),
+      need_consistent_read_(data.need_consistent_read),
+      need_metadata_(data.need_metadata) {
   TRACE_TO(trace_, "ReadRpc initiated");
   VTRACE_TO(1, trace_, "Tablet $0 table $1", data.tablet->tablet_id(), table()->name().ToString());
-  req_.set_consistency_level(yb_consistency_level);
-  req_.set_proxy_uuid(data.batcher->proxy_uuid());
+  SetReadOptions(yb_consistency_level);
+  if (hedge_) {
+    // Response could be received in the thread that sends the hedged copy.
+    mutable_retrier()->mutable_controller()->set_allow_local_calls_in_curr_thread(false);
+  }
 
+  const bool copy_requests = hedge_ != nullptr;
   switch (table()->table_type()) {
     case YBTableType::REDIS_TABLE_TYPE:
       FillOps<YBRedisReadOp>(
-          ops_, YBOperation::Type::REDIS_READ, &req_, req_.mutable_redis_batch());
+          ops_, YBOperation::Type::REDIS_READ, &req_, req_.mutable_redis_batch(), copy_requests);
       break;
     case YBTableType::YQL_TABLE_TYPE:
       FillOps<YBqlReadOp>(
-          ops_, YBOperation::Type::QL_READ, &req_, req_.mutable_ql_batch());
+          ops_, YBOperation::Type::QL_READ, &req_, req_.mutable_ql_batch(), copy_requests);
       break;
     case YBTableType::PGSQL_TABLE_TYPE:
       FillOps<YBPgsqlReadOp>(
-          ops_, YBOperation::Type::PGSQL_READ, &req_, req_.mutable_pgsql_batch());
+          ops_, YBOperation::Type::PGSQL_READ, &req_, req_.mutable_pgsql_batch(), copy_requests);
       break;
     case YBTableType::UNKNOWN_TABLE_TYPE:
     case YBTableType::TRANSACTION_STATUS_TABLE_TYPE:
@@ -668,6 +812,36 @@ ReadRpc::ReadRpc(const AsyncRpcData& data, YBConsistencyLevel yb_consistency_lev
           << req_.ShortDebugString();
 }
 
+ReadRpc::ReadRpc(
+    const AsyncRpcData& data, const ReadRpc& primary, const std::string& excluded_ts_uuid,
+    const ReadHybridTime& read_time)
+    : AsyncRpcBase(data, YBConsistencyLevel::CONSISTENT_PREFIX),
+      hedge_(primary.hedge_),
+      is_hedge_(true),
+      need_consistent_read_(data.need_consistent_read),
+      need_metadata_(data.need_metadata) {
+  TRACE_TO(trace_, "Hedged ReadRpc initiated");
+  SetReadOptions(YBConsistencyLevel::CONSISTENT_PREFIX);
+  // Operation requests could be already reused, when primary read completes operations, so copy
+  // them from the primary request.
+  req_.mutable_redis_batch()->CopyFrom(primary.req_.redis_batch());
+  req_.mutable_ql_batch()->CopyFrom(primary.req_.ql_batch());
+  req_.mutable_pgsql_batch()->CopyFrom(primary.req_.pgsql_batch());
+  if (read_time) {
+    read_time.AddToPB(&req_);
+  }
+  tablet_invoker_.ExcludeTabletServer(excluded_ts_uuid);
+}
+
+void ReadRpc::SetReadOptions(YBConsistencyLevel yb_consistency_level) {
+  req_.set_consistency_level(yb_consistency_level);
+  req_.set_proxy_uuid(batcher_->proxy_uuid());
+  const auto max_staleness = batcher_->follower_read_max_staleness();
+  if (yb_consistency_level == YBConsistencyLevel::CONSISTENT_PREFIX && max_staleness) {
+    req_.set_max_staleness_ms(std::max<int64_t>(max_staleness.ToMilliseconds(), 1));
+  }
+}
+
 ReadRpc::~ReadRpc() {
   // Get locality metrics if enabled, but skip for system tables as those go to the master.
   if (async_rpc_metrics_ && !table()->name().is_system()) {
@@ -678,9 +852,11 @@ ReadRpc::~ReadRpc() {
     read_rpc_time->Increment(ToMicroseconds(CoarseMonoClock::Now() - start_));
   }
 
-  ReleaseOps(req_.mutable_redis_batch());
-  ReleaseOps(req_.mutable_ql_batch());
-  ReleaseOps(req_.mutable_pgsql_batch());
+  if (!hedge_) {
+    ReleaseOps(req_.mutable_redis_batch());
+    ReleaseOps(req_.mutable_ql_batch());
+    ReleaseOps(req_.mutable_pgsql_batch());
+  }
 }
 
 void ReadRpc::CallRemoteMethod() {
@@ -689,6 +865,12 @@ void ReadRpc::CallRemoteMethod() {
   TRACE_TO(trace, "SendRpcToTserver");
   ADOPT_TRACE(trace.get());
 
+  attempt_ts_ = &tablet_invoker_.current_ts();
+  attempt_start_ = CoarseMonoClock::Now();
+  if (hedge_ && !is_hedge_ && num_attempts() == 1) {
+    ScheduleHedge();
+  }
+
   tablet_invoker_.ReadAsync(req_, &resp_, PrepareController(),
                             std::bind(&ReadRpc::Finished, this, Status::OK()));
   TRACE_TO(trace, "RpcDispatched Asynchronously");
@@ -779,6 +961,97 @@ void ReadRpc::NotifyBatcher(const Status& status) {
   batcher_->ProcessReadResponse(*this, status);
 }
 
+void ReadRpc::Finished(const Status& status) {
+  if (attempt_ts_ && status.ok() && retrier().controller().status().ok()) {
+    attempt_ts_->RecordReadLatency(MonoDelta(CoarseMonoClock::Now() - attempt_start_));
+  }
+  attempt_ts_ = nullptr;
+
+  if (!hedge_) {
+    AsyncRpc::Finished(status);
+    return;
+  }
+
+  Status new_status = status;
+  if (!tablet_invoker_.Done(&new_status)) {
+    return;
+  }
+  if (!hedge_->Finish(new_status.ok() && !resp_.has_error())) {
+    VLOG_WITH_FUNC(3) << ToString() << " not used: " << new_status;
+    retained_self_.reset();
+    return;
+  }
+  completing_ = true;
+  if (!new_status.ok()) {
+    // Failed calls from TabletInvoker::Done were ignored, since the other copy could succeed.
+    AsyncRpc::Failed(new_status);
+  }
+  Complete(status, new_status);
+}
+
+void ReadRpc::Failed(const Status& status) {
+  // Only the copy of hedged read that completes operations could update their responses.
+  if (hedge_ && !completing_) {
+    return;
+  }
+  AsyncRpc::Failed(status);
+}
+
+void ReadRpc::ScheduleHedge() {
+  RemoteTabletPtr tablet = tablet_invoker_.tablet();
+  std::vector<RemoteTabletServer*> servers;
+  tablet->GetRemoteTabletServers(&servers);
+  if (servers.size() < 2) {
+    return;
+  }
+
+  const auto& ts = tablet_invoker_.current_ts();
+  const auto min_delay = MonoDelta::FromMilliseconds(
+      GetAtomicFlag(&FLAGS_ybclient_hedged_read_min_delay_ms));
+  const auto max_delay = MonoDelta::FromMilliseconds(
+      GetAtomicFlag(&FLAGS_ybclient_hedged_read_max_delay_ms));
+  auto delay = ts.ReadLatencyHighPercentile();
+  if (!delay.Initialized() || delay > max_delay) {
+    delay = max_delay;
+  } else if (delay < min_delay) {
+    delay = min_delay;
+  }
+
+  // Request could be updated by retries, so the read time is captured now.
+  auto read_time = ReadHybridTime::FromReadTimePB(req_);
+  auto self = std::static_pointer_cast<ReadRpc>(shared_from_this());
+  auto primary_ts_uuid = ts.permanent_uuid();
+  retrier().messenger()->scheduler().Schedule(
+      [self, tablet, primary_ts_uuid, read_time](const Status& status) {
+        if (status.ok()) {
+          self->SendHedge(tablet, primary_ts_uuid, read_time);
+        }
+      },
+      delay.ToSteadyDuration());
+}
+
+void ReadRpc::SendHedge(
+    const RemoteTabletPtr& tablet, const std::string& primary_ts_uuid,
+    const ReadHybridTime& read_time) {
+  if (!hedge_->Start()) {
+    return;
+  }
+  VLOG_WITH_FUNC(3) << "Hedging read of tablet " << tablet->tablet_id() << ", no reply from "
+                    << primary_ts_uuid;
+  if (async_rpc_metrics_) {
+    IncrementCounter(async_rpc_metrics_->consistent_prefix_hedged_reads);
+  }
+
+  AsyncRpcData data;
+  data.batcher = batcher_;
+  data.tablet = tablet.get();
+  data.need_consistent_read = need_consistent_read_;
+  data.ops = ops_;
+  data.need_metadata = need_metadata_;
+  std::shared_ptr<ReadRpc> hedge(new ReadRpc(data, *this, primary_ts_uuid, read_time));
+  hedge->SendRpc();
+}
+
 }  // namespace internal
 }  // namespace client
 }  // namespace yb
@@ -53,6 +53,7 @@ struct AsyncRpcMetrics {
   scoped_refptr<Histogram> time_to_send;
   scoped_refptr<Counter> consistent_prefix_successful_reads;
   scoped_refptr<Counter> consistent_prefix_failed_reads;
+  scoped_refptr<Counter> consistent_prefix_hedged_reads;
 };
 
 using InFlightOps = boost::iterator_range<std::vector<InFlightOp>::iterator>;
@@ -98,6 +99,10 @@ class AsyncRpc : public rpc::Rpc, public TabletRpc {
  protected:
   void Finished(const Status& status) override;
 
+  // Processes the final result of this RPC, status is the result of the last attempt, and
+  // new_status is the result updated by TabletInvoker::Done.
+  void Complete(const Status& status, const Status& new_status);
+
   void SendRpcToTserver(int attempt_num) override;
 
   virtual void CallRemoteMethod() = 0;
@@ -171,11 +176,31 @@ class WriteRpc : public AsyncRpcBase<tserver::WriteRequestPB, tserver::WriteResp
 
   virtual ~WriteRpc();
 
+  // Returns true if this RPC could be merged with RPCs of other batchers, see WriteCoalescer.
+  bool CanCoalesce() const;
+
+  // Appends operations of rpc to the request of this RPC. Response for them is passed to rpc
+  // when this RPC is finished, and rpc itself is never sent.
+  void Coalesce(const std::shared_ptr<WriteRpc>& rpc);
+
  private:
   void SwapResponses() override;
   void CallRemoteMethod() override;
   void NotifyBatcher(const Status& status) override;
   bool ShouldRetryExpiredRequest() override;
+  void ProcessResponseFromTserver(const Status& status) override;
+
+  // Completes RPC that was merged into coalesced_into_.
+  void CoalescedFinished(const Status& status);
+
+  // Controller that received sidecars for responses of this RPC.
+  const rpc::RpcController& SidecarController() const;
+
+  // RPCs whose operations were appended to the request of this RPC.
+  std::vector<std::shared_ptr<WriteRpc>> coalesced_;
+
+  // RPC that sends operations of this RPC.
+  WriteRpc* coalesced_into_ = nullptr;
 };
 
 class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadResponsePB> {
@@ -185,10 +210,42 @@ class ReadRpc : public AsyncRpcBase<tserver::ReadRequestPB, tserver::ReadRespons
 
   virtual ~ReadRpc();
 
+ protected:
+  void Finished(const Status& status) override;
+  void Failed(const Status& status) override;
+
  private:
+  // State shared by consistent prefix read and its hedged copy, that is sent to another replica
+  // when the first replica does not reply in time. Only one of them completes operations.
+  struct HedgeState;
+
+  // Creates hedged copy of the primary read, that does not use replica on tablet server with
+  // excluded_ts_uuid.
+  ReadRpc(const AsyncRpcData& data, const ReadRpc& primary, const std::string& excluded_ts_uuid,
+          const ReadHybridTime& read_time);
+
+  void SetReadOptions(YBConsistencyLevel yb_consistency_level);
   void SwapResponses() override;
   void CallRemoteMethod() override;
   void NotifyBatcher(const Status& status) override;
+
+  void ScheduleHedge();
+  void SendHedge(const RemoteTabletPtr& tablet, const std::string& primary_ts_uuid,
+                 const ReadHybridTime& read_time);
+
+  // Set for consistent prefix reads that could be hedged. Requests of such reads are copies of
+  // operation requests owned by req_, since the copy that did not complete operations could
+  // still use its request.
+  std::shared_ptr<HedgeState> hedge_;
+  const bool is_hedge_;
+  // Whether this copy of the hedged read completes operations.
+  bool completing_ = false;
+  const bool need_consistent_read_;
+  const bool need_metadata_;
+
+  // Tablet server and start time of the current attempt, used to track read latency.
+  const RemoteTabletServer* attempt_ts_ = nullptr;
+  CoarseTimePoint attempt_start_;
 };
 
 }  // namespace internal
@@ -57,6 +57,7 @@
 #include "yb/client/session.h"
 #include "yb/client/table.h"
 #include "yb/client/transaction.h"
+#include "yb/client/write_coalescer.h"
 #include "yb/client/yb_op.h"
 #include "yb/client/yb_table_name.h"
 
@@ -521,7 +522,9 @@ void Batcher::ExecuteOperations(Initial initial) {
     if (transaction) {
       transaction->trace()->AddChildTrace(rpc->trace());
     }
-    rpc->SendRpc();
+    if (!client_->data_->write_coalescer_->Submit(rpc, messenger())) {
+      rpc->SendRpc();
+    }
   }
 }
 
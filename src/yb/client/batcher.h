@@ -50,6 +50,7 @@
 #include "yb/util/async_util.h"
 #include "yb/util/atomic.h"
 #include "yb/util/locks.h"
+#include "yb/util/monotime.h"
 #include "yb/util/status_fwd.h"
 #include "yb/util/threadpool.h"
 
@@ -234,6 +235,14 @@ class Batcher : public Runnable, public std::enable_shared_from_this<Batcher> {
 
   double RejectionScore(int attempt_num);
 
+  void SetFollowerReadMaxStaleness(MonoDelta value) {
+    follower_read_max_staleness_ = value;
+  }
+
+  MonoDelta follower_read_max_staleness() const {
+    return follower_read_max_staleness_;
+  }
+
   // Returns errors occurred due tablet resolution or flushing operations to tablet server(s).
   // Caller takes ownership of the returned errors.
   CollectedErrors GetAndClearPendingErrors();
@@ -332,6 +341,9 @@ class Batcher : public Runnable, public std::enable_shared_from_this<Batcher> {
 
   RejectionScoreSourcePtr rejection_score_source_;
 
+  // Max staleness of reads served by followers, not limited by the client when not initialized.
+  MonoDelta follower_read_max_staleness_;
+
   DISALLOW_COPY_AND_ASSIGN(Batcher);
 };
 
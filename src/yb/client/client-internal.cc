@@ -52,6 +52,7 @@
 #include "yb/client/client_master_rpc.h"
 #include "yb/client/meta_cache.h"
 #include "yb/client/table_info.h"
+#include "yb/client/write_coalescer.h"
 
 #include "yb/common/index.h"
 #include "yb/common/redis_constants_common.h"
@@ -307,7 +308,8 @@ YB_CLIENT_SPECIALIZE_SIMPLE_EX(Replication, UpdateCDCStream);
 YB_CLIENT_SPECIALIZE_SIMPLE_EX(Replication, UpdateConsumerOnProducerSplit);
 
 YBClient::Data::Data()
-    : leader_master_rpc_(rpcs_.InvalidHandle()),
+    : write_coalescer_(std::make_shared<internal::WriteCoalescer>()),
+      leader_master_rpc_(rpcs_.InvalidHandle()),
       latest_observed_hybrid_time_(YBClient::kNoHybridTime),
       id_(ClientId::GenerateRandom()) {
   for(auto& cache : tserver_count_cached_) {
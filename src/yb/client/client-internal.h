@@ -428,6 +428,7 @@ class YBClient::Data {
   std::unique_ptr<rpc::Messenger> messenger_holder_;
   std::unique_ptr<rpc::ProxyCache> proxy_cache_;
   scoped_refptr<internal::MetaCache> meta_cache_;
+  std::shared_ptr<internal::WriteCoalescer> write_coalescer_;
   scoped_refptr<MetricEntity> metric_entity_;
 
   // Set of hostnames and IPs on the local host.
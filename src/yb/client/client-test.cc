@@ -130,6 +130,10 @@ DECLARE_int32(min_backoff_ms_exponent);
 DECLARE_int32(max_backoff_ms_exponent);
 DECLARE_bool(TEST_force_master_lookup_all_tablets);
 DECLARE_double(TEST_simulate_lookup_timeout_probability);
+DECLARE_int32(ybclient_write_coalescing_window_us);
+DECLARE_bool(ybclient_hedged_reads);
+DECLARE_int32(ybclient_hedged_read_min_delay_ms);
+DECLARE_int32(ybclient_hedged_read_max_delay_ms);
 
 METRIC_DECLARE_counter(rpcs_queue_overflow);
 
@@ -1195,6 +1199,32 @@ TEST_F(ClientTest, TestMultipleMultiRowManualBatches) {
   ASSERT_EQ("{ int32:0, int32:0, string:\"hello world\", null }", rows[0]);
 }
 
+// Test that writes of different sessions flushed at the same time are coalesced, and each session
+// receives responses for its own operations.
+TEST_F(ClientTest, CoalesceWritesOfDifferentSessions) {
+  FLAGS_ybclient_write_coalescing_window_us = 100000;
+
+  constexpr int kNumSessions = 20;
+  std::vector<YBSessionPtr> sessions;
+  std::vector<std::future<FlushStatus>> futures;
+  for (int i = 0; i != kNumSessions; ++i) {
+    sessions.push_back(CreateSession());
+    ApplyInsertToSession(sessions.back().get(), client_table_, i, i * 10, "coalesced");
+    futures.push_back(sessions.back()->FlushFuture());
+  }
+  for (auto& future : futures) {
+    ASSERT_OK(future.get().status);
+  }
+  for (const auto& session : sessions) {
+    ASSERT_FALSE(session->HasNotFlushedOperations());
+  }
+
+  ASSERT_EQ(kNumSessions, CountRowsFromClient(client_table_));
+  auto rows = ScanTableToStrings(client_table_);
+  std::sort(rows.begin(), rows.end());
+  ASSERT_EQ("{ int32:0, int32:0, string:\"coalesced\", null }", rows[0]);
+}
+
 // Test a batch where one of the inserted rows succeeds and duplicates succeed too.
 TEST_F(ClientTest, TestBatchWithDuplicates) {
   auto session = CreateSession();
@@ -1690,6 +1720,30 @@ TEST_F(ClientTest, TestReplicatedMultiTabletTableFailover) {
   }
 }
 
+TEST_F(ClientTest, HedgedConsistentPrefixReads) {
+  FLAGS_ybclient_hedged_reads = true;
+  // Hedge every read, so both replicas reply and only one of replies should be used.
+  FLAGS_ybclient_hedged_read_min_delay_ms = 0;
+  FLAGS_ybclient_hedged_read_max_delay_ms = 0;
+
+  const YBTableName kReplicatedTable(YQL_DATABASE_CQL, "replicated_hedged_reads");
+  const int kNumRowsToWrite = 100;
+  const int kNumReads = 20;
+
+  TableHandle table;
+  ASSERT_NO_FATALS(CreateTable(kReplicatedTable, kNumTablets, &table));
+  ASSERT_NO_FATALS(InsertTestRows(table, kNumRowsToWrite));
+
+  ASSERT_OK(WaitFor([&table] {
+    return CountRowsFromClient(
+        table, YBConsistencyLevel::CONSISTENT_PREFIX, kNoBound, kNoBound) == kNumRowsToWrite;
+  }, 10s, "Rows replicated to all replicas"));
+  for (int i = 0; i != kNumReads; ++i) {
+    ASSERT_EQ(kNumRowsToWrite, CountRowsFromClient(
+        table, YBConsistencyLevel::CONSISTENT_PREFIX, kNoBound, kNoBound));
+  }
+}
+
 // This test that we can keep writing to a tablet when the leader
 // tablet dies.
 // This currently forces leader promotion through RPC and creates
@@ -1985,6 +1985,10 @@ void YBClient::LookupTabletById(const std::string& tablet_id,
       tablet_id, table, include_inactive, deadline, std::move(callback), use_cache);
 }
 
+internal::RemoteTabletPtr YBClient::GetCachedTablet(const TabletId& tablet_id) {
+  return data_->meta_cache_->GetCachedTablet(tablet_id);
+}
+
 void YBClient::LookupAllTablets(const std::shared_ptr<const YBTable>& table,
                                 CoarseTimePoint deadline,
                                 LookupTabletRangeCallback callback) {
@@ -744,6 +744,9 @@ class YBClient {
                         CoarseTimePoint deadline,
                         LookupTabletRangeCallback callback);
 
+  // Returns tablet from the meta cache, or nullptr if it is not cached.
+  internal::RemoteTabletPtr GetCachedTablet(const TabletId& tablet_id);
+
   std::future<Result<internal::RemoteTabletPtr>> LookupTabletByKeyFuture(
       const std::shared_ptr<YBTable>& table,
       const std::string& partition_key,
@@ -127,6 +127,7 @@ class MetaCache;
 class PermissionsCache;
 class ReadRpc;
 class TabletInvoker;
+class WriteCoalescer;
 class WriteRpc;
 
 struct InFlightOp;
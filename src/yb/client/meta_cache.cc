@@ -34,7 +34,9 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cstdlib>
 #include <list>
 #include <memory>
 #include <shared_mutex>
@@ -148,6 +150,15 @@ using ProcessedTablesMap =
 
 namespace {
 
+std::vector<TableId> ProcessedTableIds(const ProcessedTablesMap& processed_tables) {
+  std::vector<TableId> result;
+  result.reserve(processed_tables.size());
+  for (const auto& table_id_and_tablets : processed_tables) {
+    result.push_back(table_id_and_tablets.first);
+  }
+  return result;
+}
+
 // We join tablet partitions to groups, so tablet state info in one group requested with single
 // RPC call to master.
 // kPartitionGroupSize defines size of this group.
@@ -302,6 +313,30 @@ LocalityLevel RemoteTabletServer::LocalityLevelWith(const CloudInfoPB& cloud_inf
   return LocalityLevel::kZone;
 }
 
+void RemoteTabletServer::RecordReadLatency(MonoDelta latency) const {
+  // Same smoothing factors as used for round trip time estimation in TCP.
+  const int64_t sample = std::max<int64_t>(latency.ToMicroseconds(), 0);
+  const auto smoothed = read_latency_us_.load(std::memory_order_acquire);
+  if (smoothed < 0) {
+    read_latency_deviation_us_.store(sample / 2, std::memory_order_release);
+    read_latency_us_.store(sample, std::memory_order_release);
+    return;
+  }
+  const auto deviation = read_latency_deviation_us_.load(std::memory_order_acquire);
+  read_latency_deviation_us_.store(
+      deviation + (std::abs(sample - smoothed) - deviation) / 4, std::memory_order_release);
+  read_latency_us_.store(smoothed + (sample - smoothed) / 8, std::memory_order_release);
+}
+
+MonoDelta RemoteTabletServer::ReadLatencyHighPercentile() const {
+  const auto smoothed = read_latency_us_.load(std::memory_order_acquire);
+  if (smoothed < 0) {
+    return MonoDelta();
+  }
+  return MonoDelta::FromMicroseconds(
+      smoothed + 2 * read_latency_deviation_us_.load(std::memory_order_acquire));
+}
+
 HostPortPB RemoteTabletServer::DesiredHostPort(const CloudInfoPB& cloud_info) const {
   SharedLock<rw_spinlock> lock(mutex_);
   return yb::DesiredHostPort(
@@ -999,6 +1034,8 @@ Status MetaCache::ProcessTabletLocations(
           VLOG_WITH_PREFIX_AND_FUNC(4) << msg_formatter();
           if (table_partition_list_version.has_value()) {
             if (table_partition_list_version.get() != table_data.partition_list->version) {
+              // Tablets of previous locations could be already updated.
+              PublishTablesSnapshotUnlocked(ProcessedTableIds(processed_tables));
               return STATUS(
                   TryAgain, msg_formatter(),
                   ClientError(ClientErrorCode::kTablePartitionListIsStale));
@@ -1081,6 +1118,7 @@ Status MetaCache::ProcessTabletLocations(
         }
       }
     }
+    PublishTablesSnapshotUnlocked(ProcessedTableIds(processed_tables));
     if (lookup_rpc) {
       lookup_rpc->AddCallbacksToBeNotified(processed_tables, &tables_, &to_notify);
       lookup_rpc->CleanupRequest();
@@ -1204,6 +1242,7 @@ void MetaCache::InvalidateTableCache(const YBTable& table) {
     // Only update partitions here after invalidating TableData cache to avoid inconsistencies.
     // See https://github.com/yugabyte/yugabyte-db/issues/6890.
     table_data.partition_list = table_partition_list;
+    PublishTablesSnapshotUnlocked({table_id});
   }
   for (const auto& callback : to_notify) {
     const auto s = STATUS_EC_FORMAT(
@@ -1775,6 +1814,36 @@ void MetaCache::LookupByIdFailed(
   }
 }
 
+TablePartitionsSnapshotPtr TablesSnapshot::Get(const TableId& table_id) const {
+  const auto& stripe = StripeFor(table_id);
+  std::lock_guard<simple_spinlock> lock(stripe.lock);
+  auto it = stripe.tables.find(table_id);
+  return it != stripe.tables.end() ? it->second : nullptr;
+}
+
+void TablesSnapshot::Set(const TableId& table_id, TablePartitionsSnapshotPtr snapshot) {
+  auto& stripe = StripeFor(table_id);
+  // Old snapshot is released after the lock, since it could be the last reference to it.
+  std::lock_guard<simple_spinlock> lock(stripe.lock);
+  stripe.tables[table_id].swap(snapshot);
+}
+
+namespace {
+
+// Returns true if tablet found by partition_start_key could be used to serve this key.
+bool CoversPartitionStart(const RemoteTablet& tablet, const PartitionKey& partition_start_key) {
+  // Stale entries must be re-fetched.
+  if (tablet.stale()) {
+    return false;
+  }
+
+  // partition_start_key < partition.end OR tablet does not end.
+  return tablet.partition().partition_key_end().compare(partition_start_key) > 0 ||
+         tablet.partition().partition_key_end().empty();
+}
+
+} // namespace
+
 RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
     const TableId& table_id, const VersionedPartitionStartKey& versioned_partition_start_key) {
   auto it = tables_.find(table_id);
@@ -1805,19 +1874,54 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
   }
 
   const auto& result = tablet_it->second;
+  return CoversPartitionStart(*result, partition_start_key) ? result : nullptr;
+}
 
-  // Stale entries must be re-fetched.
-  if (result->stale()) {
+RemoteTabletPtr MetaCache::LookupTabletByKeyLockFree(
+    const TableId& table_id, const VersionedPartitionStartKey& partition_start) {
+  auto snapshot_ptr = tables_snapshot_.Get(table_id);
+  if (!snapshot_ptr) {
     return nullptr;
   }
 
-  if (result->partition().partition_key_end().compare(partition_start_key) > 0 ||
-      result->partition().partition_key_end().empty()) {
-    // partition_start_key < partition.end OR tablet does not end.
-    return result;
+  const auto& snapshot = *snapshot_ptr;
+  // Same as for TableData, tablets are only valid for the partition list version they were
+  // fetched for.
+  if (snapshot.partition_list_version != partition_start.partition_list_version) {
+    return nullptr;
   }
 
-  return nullptr;
+  const auto& partition_start_key = *partition_start.key;
+  auto tablet_it = std::lower_bound(
+      snapshot.tablets.begin(), snapshot.tablets.end(), partition_start_key,
+      [](const auto& entry, const PartitionKey& key) {
+    return entry.first < key;
+  });
+  if (tablet_it == snapshot.tablets.end() || tablet_it->first != partition_start_key) {
+    return nullptr;
+  }
+
+  const auto& result = tablet_it->second;
+  if (!CoversPartitionStart(*result, partition_start_key) || !result->HasLeader()) {
+    return nullptr;
+  }
+  VLOG_WITH_PREFIX(5) << "Lock free lookup: found tablet " << result->tablet_id();
+  return result;
+}
+
+void MetaCache::PublishTablesSnapshotUnlocked(const std::vector<TableId>& table_ids) {
+  for (const auto& table_id : table_ids) {
+    auto it = tables_.find(table_id);
+    if (it == tables_.end()) {
+      continue;
+    }
+    const auto& table_data = it->second;
+    auto snapshot = std::make_shared<TablePartitionsSnapshot>();
+    snapshot->partition_list_version = table_data.partition_list->version;
+    snapshot->tablets.assign(
+        table_data.tablets_by_partition.begin(), table_data.tablets_by_partition.end());
+    tables_snapshot_.Set(table_id, std::move(snapshot));
+  }
 }
 
 boost::optional<std::vector<RemoteTabletPtr>> MetaCache::FastLookupAllTabletsUnlocked(
@@ -2028,6 +2132,14 @@ void MetaCache::LookupTabletByKey(const std::shared_ptr<YBTable>& table,
                     << ", partition_key: " << Slice(partition_key).ToDebugHexString()
                     << ", partition_start: " << Slice(*partition_start).ToDebugHexString();
 
+  // Most lookups hit the cache, so try the published snapshot first without locking mutex_.
+  auto tablet = LookupTabletByKeyLockFree(
+      table->id(), {partition_start, table_partition_list->version});
+  if (tablet) {
+    callback(tablet);
+    return;
+  }
+
   PartitionGroupStartKeyPtr partition_group_start;
   if (DoLookupTabletByKey<SharedLock<std::shared_timed_mutex>>(
           table, table_partition_list, partition_start, deadline, &callback,
@@ -2065,6 +2177,11 @@ RemoteTabletPtr MetaCache::LookupTabletByIdFastPathUnlocked(const TabletId& tabl
   return nullptr;
 }
 
+RemoteTabletPtr MetaCache::GetCachedTablet(const TabletId& tablet_id) {
+  SharedLock<decltype(mutex_)> lock(mutex_);
+  return LookupTabletByIdFastPathUnlocked(tablet_id);
+}
+
 template <class Lock>
 bool MetaCache::DoLookupTabletById(
     const TabletId& tablet_id,
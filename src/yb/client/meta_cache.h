@@ -33,6 +33,8 @@
 #ifndef YB_CLIENT_META_CACHE_H
 #define YB_CLIENT_META_CACHE_H
 
+#include <array>
+#include <atomic>
 #include <shared_mutex>
 #include <map>
 #include <string>
@@ -143,6 +145,14 @@ class RemoteTabletServer {
 
   HostPortPB DesiredHostPort(const CloudInfoPB& cloud_info) const;
 
+  // Records latency of a read served by this tablet server.
+  void RecordReadLatency(MonoDelta latency) const;
+
+  // Returns latency that most of reads served by this tablet server fit in, or uninitialized
+  // MonoDelta if no reads were recorded yet. It is estimated as smoothed latency plus twice its
+  // smoothed deviation, that is close to 95th percentile for normally distributed latencies.
+  MonoDelta ReadLatencyHighPercentile() const;
+
   std::string TEST_PlacementZone() const;
 
  private:
@@ -157,6 +167,10 @@ class RemoteTabletServer {
   const tserver::LocalTabletServer* const local_tserver_ = nullptr;
   scoped_refptr<Histogram> dns_resolve_histogram_;
   std::vector<CapabilityId> capabilities_ GUARDED_BY(mutex_);
+  // Smoothed read latency and its deviation in microseconds, negative latency means that there
+  // were no reads yet. Not guarded, since concurrent updates could only lose a sample.
+  mutable std::atomic<int64_t> read_latency_us_{-1};
+  mutable std::atomic<int64_t> read_latency_deviation_us_{0};
 
   DISALLOW_COPY_AND_ASSIGN(RemoteTabletServer);
 };
@@ -465,6 +479,45 @@ struct TableData {
   // miss the key, because it doesn't exist in 1st post-split tablet.
 };
 
+// Immutable copy of TableData::tablets_by_partition, that is published by MetaCache after each
+// update, so lookups of a tablet by partition key could be done without locking MetaCache.
+struct TablePartitionsSnapshot {
+  // Version of TableData::partition_list that tablets correspond to.
+  PartitionListVersion partition_list_version;
+  // Tablets sorted by partition key start.
+  std::vector<std::pair<PartitionKey, RemoteTabletPtr>> tablets;
+};
+
+using TablePartitionsSnapshotPtr = std::shared_ptr<const TablePartitionsSnapshot>;
+
+// Published table snapshots are split into stripes by table id, each protected by its own
+// spinlock. Lookup holds the lock only to copy the pointer to the snapshot, so lookups of
+// different tables do not contend, and publishing replaces only the entry of the updated table.
+class TablesSnapshot {
+ public:
+  TablePartitionsSnapshotPtr Get(const TableId& table_id) const;
+
+  void Set(const TableId& table_id, TablePartitionsSnapshotPtr snapshot);
+
+ private:
+  static constexpr size_t kNumStripes = 16;
+
+  struct Stripe {
+    mutable simple_spinlock lock;
+    std::unordered_map<TableId, TablePartitionsSnapshotPtr> tables GUARDED_BY(lock);
+  };
+
+  const Stripe& StripeFor(const TableId& table_id) const {
+    return stripes_[std::hash<TableId>()(table_id) % kNumStripes];
+  }
+
+  Stripe& StripeFor(const TableId& table_id) {
+    return stripes_[std::hash<TableId>()(table_id) % kNumStripes];
+  }
+
+  std::array<Stripe, kNumStripes> stripes_;
+};
+
 class LookupCallbackVisitor : public boost::static_visitor<> {
  public:
   explicit LookupCallbackVisitor(const LookupCallbackParam& param) : param_(param) {
@@ -530,6 +583,10 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
                         LookupTabletCallback callback,
                         UseCache use_cache);
 
+  // Returns cached tablet with specified id, or nullptr if it is not cached. Does not send any
+  // RPCs.
+  RemoteTabletPtr GetCachedTablet(const TabletId& tablet_id);
+
   // Return the local tablet server if available.
   RemoteTabletServer* local_tserver() const {
     return local_tserver_;
@@ -581,6 +638,15 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
   RemoteTabletPtr LookupTabletByIdFastPathUnlocked(const TabletId& tablet_id)
       REQUIRES_SHARED(mutex_);
 
+  // Lookup the given tablet by partition_start_key in the published tables snapshot, without
+  // taking mutex_. Returns nullptr if tablet is not cached or should be refreshed.
+  RemoteTabletPtr LookupTabletByKeyLockFree(
+      const TableId& table_id, const VersionedPartitionStartKey& partition_start);
+
+  // Publishes new snapshot of tablets_by_partition for specified tables, snapshots of other tables
+  // are left intact.
+  void PublishTablesSnapshotUnlocked(const std::vector<TableId>& table_ids) REQUIRES(mutex_);
+
   // Update our information about the given tablet server.
   //
   // This is called when we get some response from the master which contains
@@ -681,6 +747,10 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   std::unordered_map<TableId, TableData> tables_ GUARDED_BY(mutex_);
 
+  // Snapshot of tables_ partitions used by lookups by key. Updated only while mutex_ is held
+  // exclusively.
+  TablesSnapshot tables_snapshot_;
+
   // Cache of tablets, keyed by tablet ID.
   std::unordered_map<TabletId, RemoteTabletPtr> tablets_by_id_ GUARDED_BY(mutex_);
 
@@ -29,15 +29,18 @@
 #include "yb/rocksdb/db.h"
 
 #include "yb/tablet/tablet.h"
+#include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_peer.h"
 
 #include "yb/tserver/mini_tablet_server.h"
+#include "yb/tserver/service_util.h"
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/ts_tablet_manager.h"
 
 #include "yb/util/async_util.h"
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/format.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random.h"
 #include "yb/util/random_util.h"
 #include "yb/util/status_format.h"
@@ -1287,6 +1290,87 @@ TEST_F(QLDmlTest, ReadFollower) {
   ASSERT_TRUE(missing_rows.empty()) << "Missing rows: " << yb::ToString(missing_rows);
 }
 
+namespace {
+
+int64_t StaleFollowerReadRejections(const std::vector<tablet::TabletPeerPtr>& peers) {
+  int64_t result = 0;
+  for (const auto& peer : peers) {
+    result += peer->tablet()->metrics()->stale_follower_read_rejections->value();
+  }
+  return result;
+}
+
+} // namespace
+
+// Checks that a follower within the session staleness bound serves consistent prefix reads.
+TEST_F(QLDmlTest, FollowerReadWithinMaxStaleness) {
+  constexpr int kNumRows = 100;
+  const auto kMaxStaleness = 30s * kTimeMultiplier;
+
+  ASSERT_NO_FATALS(InsertRows(kNumRows));
+  // Only the client bound should be applied.
+  FLAGS_max_stale_read_bound_time_ms = 0;
+
+  auto session = NewSession();
+  session->SetFollowerReadMaxStaleness(kMaxStaleness);
+  for (int i = 0; i != kNumRows; ++i) {
+    auto row = ASSERT_RESULT(
+        ReadRow(session, KeyForIndex(i), YBConsistencyLevel::CONSISTENT_PREFIX));
+    ASSERT_EQ(row, ValueForIndex(i));
+  }
+
+  auto peers = ListTableTabletPeers(cluster_.get(), table_->id());
+  ASSERT_EQ(StaleFollowerReadRejections(peers), 0);
+
+  // Client could pick leaders only, so also check followers directly.
+  size_t num_followers = 0;
+  for (const auto& peer : peers) {
+    if (peer->LeaderStatus() != consensus::LeaderStatus::NOT_LEADER) {
+      continue;
+    }
+    ++num_followers;
+    auto* staleness = peer->tablet()->metrics()->follower_read_staleness.get();
+    auto staleness_reads = staleness->TotalCount();
+    ASSERT_OK(tserver::GetTablet(
+        nullptr, peer->tablet_id(), peer, YBConsistencyLevel::CONSISTENT_PREFIX,
+        tserver::AllowSplitTablet::kFalse, ToMilliseconds(kMaxStaleness)));
+    ASSERT_EQ(staleness->TotalCount(), staleness_reads + 1);
+  }
+  ASSERT_GT(num_followers, 0);
+  ASSERT_EQ(StaleFollowerReadRejections(peers), 0);
+}
+
+// Checks that a follower lagging past the session staleness bound rejects consistent prefix
+// reads, even when the server side bound is disabled.
+TEST_F(QLDmlTest, FollowerReadPastMaxStaleness) {
+  DontVerifyClusterBeforeNextTearDown();
+  constexpr int kNumRows = 100;
+  const auto kMaxStaleness = 500ms;
+
+  ASSERT_NO_FATALS(InsertRows(kNumRows));
+
+  for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+    cluster_->mini_tablet_server(i)->Shutdown();
+  }
+  ASSERT_OK(cluster_->mini_tablet_server(0)->Start());
+  FLAGS_max_stale_read_bound_time_ms = 0;
+
+  // The only alive tserver does not receive updates from a leader, so its safe time does not
+  // move and staleness keeps increasing.
+  auto session = NewSession();
+  ASSERT_OK(ReadRow(session, KeyForIndex(0), YBConsistencyLevel::CONSISTENT_PREFIX));
+  std::this_thread::sleep_for(kMaxStaleness * 2);
+
+  auto peers = ListTableTabletPeers(cluster_.get(), table_->id());
+  auto rejections_before = StaleFollowerReadRejections(peers);
+
+  session->SetTimeout(5s * kTimeMultiplier);
+  session->SetFollowerReadMaxStaleness(kMaxStaleness);
+  auto row = ReadRow(session, KeyForIndex(0), YBConsistencyLevel::CONSISTENT_PREFIX);
+  ASSERT_NOK(row);
+  ASSERT_GT(StaleFollowerReadRejections(peers), rejections_before);
+}
+
 TEST_F(QLDmlTest, DeletePartialRangeKey) {
   auto session = NewSession();
   RowKey row_key{1, "a", 2, "b"};
@@ -13,6 +13,9 @@
 //
 //
 
+#include <future>
+#include <unordered_set>
+
 #include "yb/client/error.h"
 #include "yb/client/schema.h"
 #include "yb/client/session.h"
@@ -63,17 +66,22 @@ DECLARE_bool(TEST_master_fail_transactional_tablet_lookups);
 DECLARE_bool(TEST_transaction_allow_rerequest_status);
 DECLARE_bool(delete_intents_sst_files);
 DECLARE_bool(enable_load_balancing);
+DECLARE_bool(enable_wait_queues);
 DECLARE_bool(fail_on_out_of_range_clock_skew);
 DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_bool(rocksdb_disable_compactions);
 DECLARE_int32(TEST_delay_init_tablet_peer_ms);
 DECLARE_int32(log_min_seconds_to_retain);
+DECLARE_int32(max_transactions_in_remove_intents_batch);
 DECLARE_int32(remote_bootstrap_max_chunk_size);
+DECLARE_int32(txn_max_apply_batch_records);
+DECLARE_int32(wait_queue_max_wait_ms);
 DECLARE_int64(transaction_rpc_timeout_ms);
 DECLARE_uint64(TEST_transaction_delay_status_reply_usec_in_tests);
 DECLARE_uint64(aborted_intent_cleanup_ms);
 DECLARE_uint64(max_clock_skew_usec);
 DECLARE_uint64(transaction_heartbeat_usec);
+DECLARE_uint64(transaction_region_local_status_tablets_refresh_ms);
 
 namespace yb {
 namespace client {
@@ -584,6 +592,27 @@ TEST_F(QLTransactionTest, SimpleWriteConflict) {
   ASSERT_NOK(transaction->CommitFuture().get());
 }
 
+TEST_F(QLTransactionTest, WaitForConflictingTransaction) {
+  FLAGS_enable_wait_queues = true;
+  FLAGS_wait_queue_max_wait_ms = 60000 * kTimeMultiplier;
+
+  auto txn1 = CreateTransaction();
+  ASSERT_OK(WriteRow(CreateSession(txn1), 1 /* key */, 1 /* value */));
+
+  auto txn2 = CreateTransaction();
+  auto session2 = CreateSession(txn2);
+  ASSERT_OK(WriteRow(session2, 1 /* key */, 2 /* value */, WriteOpType::INSERT, Flush::kFalse));
+  auto flush_future = session2->FlushFuture();
+
+  // Write of txn2 waits for txn1, instead of aborting it.
+  ASSERT_EQ(flush_future.wait_for(1s * kTimeMultiplier), std::future_status::timeout);
+
+  txn1->Abort();
+  ASSERT_OK(flush_future.get().status);
+  ASSERT_OK(txn2->CommitFuture().get());
+  VERIFY_ROW(CreateSession(), 1, 2);
+}
+
 void QLTransactionTest::TestReadOnlyTablets(IsolationLevel isolation_level,
                                             bool perform_write,
                                             bool written_intents_expected) {
@@ -835,6 +864,23 @@ TEST_F(QLTransactionTest, ResolveIntentsWriteReadWithinTransactionAndRollback) {
   ASSERT_OK(cluster_->RestartSync());
 }
 
+// Check that intents of multiple transactions, removed using the same write batch, are removed
+// completely, even when each of them does not fit into a single batch.
+TEST_F(QLTransactionTest, RemoveIntentsBatch) {
+  constexpr size_t kTransactions = 10;
+
+  FLAGS_max_transactions_in_remove_intents_batch = 4;
+  FLAGS_txn_max_apply_batch_records = 3;
+
+  for (size_t i = 0; i != kTransactions; ++i) {
+    WriteData(WriteOpType::INSERT, i);
+  }
+
+  ASSERT_OK(WaitTransactionsCleaned());
+  ASSERT_OK(WaitIntentsCleaned());
+  VerifyData(kTransactions);
+}
+
 TEST_F(QLTransactionTest, CheckCompactionAbortCleanup) {
   SetAtomicFlag(0ULL, &FLAGS_max_clock_skew_usec); // To avoid read restart in this test.
   FLAGS_TEST_disable_proactive_txn_cleanup_on_abort = true;
@@ -1466,6 +1512,59 @@ TEST_F_EX(QLTransactionTest, ChangeLeader, QLTransactionBigLogSegmentSizeTest) {
   ASSERT_LE(expirations.load() * 100, successes * 5);
 }
 
+// Pick status tablets from several threads, while their leaders move and the region local
+// candidates are refreshed.
+TEST_F(QLTransactionTest, PickStatusTabletDuringLeaderChanges) {
+  constexpr size_t kThreads = 4;
+  constexpr auto kTestTime = 5s;
+
+  FLAGS_transaction_region_local_status_tablets_refresh_ms = 10;
+
+  // Load status tablets into the meta cache.
+  ASSERT_NO_FATALS(WriteData());
+  auto status_tablets = ASSERT_RESULT(client_->GetTransactionStatusTablets(CloudInfoPB()));
+  std::unordered_set<TabletId> status_tablet_ids(
+      status_tablets.global_tablets.begin(), status_tablets.global_tablets.end());
+  ASSERT_FALSE(status_tablet_ids.empty());
+
+  TestThreadHolder thread_holder;
+  std::atomic<size_t> picks{0};
+  for (size_t i = 0; i != kThreads; ++i) {
+    thread_holder.AddThreadFunctor(
+        [this, &stop = thread_holder.stop_flag(), &status_tablet_ids, &picks] {
+      while (!stop.load(std::memory_order_acquire)) {
+        std::promise<Result<TabletId>> promise;
+        transaction_manager_->PickStatusTablet(
+            [&promise](const Result<TabletId>& tablet_id) { promise.set_value(tablet_id); },
+            TransactionLocality::GLOBAL);
+        auto tablet_id = ASSERT_RESULT(promise.get_future().get());
+        ASSERT_EQ(status_tablet_ids.count(tablet_id), 1) << tablet_id;
+        ++picks;
+      }
+    });
+  }
+
+  auto test_finish = CoarseMonoClock::now() + kTestTime;
+  while (CoarseMonoClock::now() < test_finish) {
+    for (size_t i = 0; i != cluster_->num_tablet_servers(); ++i) {
+      auto peers = cluster_->mini_tablet_server(i)->server()->tablet_manager()->GetTabletPeers();
+      for (const auto& peer : peers) {
+        if (status_tablet_ids.count(peer->tablet_id()) && peer->consensus() &&
+            peer->consensus()->GetLeaderStatus() != consensus::LeaderStatus::NOT_LEADER) {
+          consensus::LeaderStepDownRequestPB req;
+          req.set_tablet_id(peer->tablet_id());
+          consensus::LeaderStepDownResponsePB resp;
+          ASSERT_OK(peer->consensus()->StepDown(&req, &resp));
+        }
+      }
+    }
+    std::this_thread::sleep_for(500ms);
+  }
+  thread_holder.Stop();
+
+  ASSERT_GT(picks.load(), 0);
+}
+
 class RemoteBootstrapTest : public QLTransactionTest {
  protected:
   void SetUp() override {
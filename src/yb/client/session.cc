@@ -90,6 +90,13 @@ void YBSession::SetRejectionScoreSource(RejectionScoreSourcePtr rejection_score_
   batcher_config_.rejection_score_source = std::move(rejection_score_source);
 }
 
+void YBSession::SetFollowerReadMaxStaleness(MonoDelta value) {
+  if (batcher_) {
+    batcher_->SetFollowerReadMaxStaleness(value);
+  }
+  batcher_config_.follower_read_max_staleness = value;
+}
+
 YBSession::~YBSession() {
   WARN_NOT_OK(Close(true), "Closed Session with pending operations.");
 }
@@ -142,6 +149,7 @@ internal::BatcherPtr CreateBatcher(const YBSession::BatcherConfig& config) {
       config.client, config.session.lock(), config.transaction, config.read_point(),
       config.force_consistent_read);
   batcher->SetRejectionScoreSource(config.rejection_score_source);
+  batcher->SetFollowerReadMaxStaleness(config.follower_read_max_staleness);
   return batcher;
 }
 
@@ -229,6 +229,11 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   void SetRejectionScoreSource(RejectionScoreSourcePtr rejection_score_source);
 
+  // Sets max staleness of consistent prefix reads of this session. A follower that is staler
+  // rejects the read, so it is retried on another replica. Uninitialized value means that only
+  // the server side bound max_stale_read_bound_time_ms is applied.
+  void SetFollowerReadMaxStaleness(MonoDelta value);
+
   struct BatcherConfig {
     std::weak_ptr<YBSession> session;
     client::YBClient* client;
@@ -237,6 +242,7 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
     bool allow_local_calls_in_curr_thread = true;
     bool force_consistent_read = false;
     RejectionScoreSourcePtr rejection_score_source;
+    MonoDelta follower_read_max_staleness;
 
     ConsistentReadPoint* read_point() const;
   };
@@ -90,9 +90,18 @@ void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   }
 
   std::vector<RemoteTabletServer*> candidates;
+  std::set<std::string> blacklist;
+  if (!excluded_ts_uuid_.empty()) {
+    blacklist.insert(excluded_ts_uuid_);
+  }
   current_ts_ = client_->data_->SelectTServer(tablet_.get(),
-                                              YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
-                                              &candidates);
+                                              YBClient::ReplicaSelection::CLOSEST_REPLICA,
+                                              blacklist, &candidates);
+  if (!current_ts_ && !blacklist.empty()) {
+    current_ts_ = client_->data_->SelectTServer(tablet_.get(),
+                                                YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
+                                                &candidates);
+  }
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
@@ -291,6 +300,7 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
       .status = STATUS(IllegalState, "Not the leader"),
       .time = CoarseMonoClock::now()
     });
+    ApplyLeaderHint(reason);
   } else {
     VLOG(1) << "Failing " << command_->ToString() << " to a new replica: " << reason
             << ", old replica: " << yb::ToString(current_ts_);
@@ -312,6 +322,26 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
   return status;
 }
 
+void TabletInvoker::ApplyLeaderHint(const Status& status) {
+  auto leader_hint = tserver::TabletServerLeaderHint::ValueFromStatus(status);
+  if (!tablet_ || !leader_hint || leader_hint->empty()) {
+    return;
+  }
+  const auto& leader_uuid = leader_hint->front();
+  for (auto* ts : tablet_->GetRemoteTabletServers(IncludeFailedReplicas::kTrue)) {
+    // Don't trust the hint if this replica has already rejected us, the hint could be stale.
+    if (ts->permanent_uuid() != leader_uuid || followers_.count(ts)) {
+      continue;
+    }
+    VLOG(1) << "Tablet " << tablet_id_ << ": leader hint " << ts->ToString() << " for "
+            << command_->ToString();
+    // Update the cache shared with other RPCs, so they go to the new leader right away.
+    if (tablet_->MarkTServerAsLeader(ts)) {
+      return;
+    }
+  }
+}
+
 bool TabletInvoker::Done(Status* status) {
   TRACE_TO(trace_, "Done($0)", status->ToString(false));
   ADOPT_TRACE(trace_);
@@ -108,6 +108,10 @@ class TabletInvoker {
 
   bool is_consistent_prefix() const { return consistent_prefix_; }
 
+  // Consistent prefix read will not select replica on tablet server with specified uuid, unless
+  // there are no other replicas. Used by hedged reads to send the read to other replica.
+  void ExcludeTabletServer(const std::string& uuid) { excluded_ts_uuid_ = uuid; }
+
  private:
   friend class TabletRpcTest;
   FRIEND_TEST(TabletRpcTest, TabletInvokerSelectTabletServerRace);
@@ -127,6 +131,10 @@ class TabletInvoker {
   CHECKED_STATUS FailToNewReplica(const Status& reason,
                                   const tserver::TabletServerErrorPB* error_code = nullptr);
 
+  // Marks the replica reported as leader by NOT_THE_LEADER response, so the retry and other RPCs
+  // to this tablet go to it without a master lookup.
+  void ApplyLeaderHint(const Status& status);
+
   // Called when we finish a lookup (to find the new consensus leader). Retries
   // the rpc after a short delay.
   void LookupTabletCb(const Result<RemoteTabletPtr>& result);
@@ -184,6 +192,9 @@ class TabletInvoker {
 
   const bool consistent_prefix_;
 
+  // See ExcludeTabletServer.
+  std::string excluded_ts_uuid_;
+
   // The TS receiving the write. May change if the write is retried.
   // RemoteTabletServer is taken from YBClient cache, so it is guaranteed that those objects are
   // alive while YBClient is alive. Because we don't delete them, but only add and update.
@@ -15,6 +15,9 @@
 
 #include "yb/client/transaction_manager.h"
 
+#include <array>
+#include <limits>
+
 #include "yb/client/client.h"
 #include "yb/client/meta_cache.h"
 #include "yb/client/table.h"
@@ -26,7 +29,11 @@
 
 #include "yb/server/server_base_options.h"
 
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
+#include "yb/util/locks.h"
+#include "yb/util/monotime.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/string_util.h"
@@ -38,6 +45,20 @@ DEFINE_uint64(transaction_manager_workers_limit, 50,
 DEFINE_uint64(transaction_manager_queue_limit, 500,
               "Max number of tasks used by transaction manager");
 
+DEFINE_bool(transaction_prefer_region_local_status_tablet, true,
+            "When there is no status tablet led by the local tablet server, prefer status tablets "
+            "whose cached leader is in the local region, to avoid cross region round trips on "
+            "transaction status updates.");
+TAG_FLAG(transaction_prefer_region_local_status_tablet, advanced);
+TAG_FLAG(transaction_prefer_region_local_status_tablet, runtime);
+
+DEFINE_uint64(transaction_region_local_status_tablets_refresh_ms, 1000,
+              "How often the list of status tablets whose cached leader is in the local region "
+              "is refreshed from the meta cache. The list is also refreshed when status tablets "
+              "change.");
+TAG_FLAG(transaction_region_local_status_tablets_refresh_ms, advanced);
+TAG_FLAG(transaction_region_local_status_tablets_refresh_ms, runtime);
+
 namespace yb {
 namespace client {
 
@@ -47,8 +68,8 @@ namespace {
 // the same placement.
 class TransactionTableState {
  public:
-  explicit TransactionTableState(LocalTabletFilter local_tablet_filter)
-      : local_tablet_filter_(local_tablet_filter) {
+  TransactionTableState(YBClient* client, LocalTabletFilter local_tablet_filter)
+      : client_(client), local_tablet_filter_(local_tablet_filter) {
   }
 
   void InvokeCallback(const PickStatusTabletCallback& callback,
@@ -110,12 +131,74 @@ class TransactionTableState {
         callback(*RandomElement(ids));
         return true;
       }
+    }
+    if (PickRegionLocalStatusTabletId(tablets, callback)) {
+      return true;
+    }
+    if (local_tablet_filter_) {
       return false;
     }
     callback(RandomElement(tablets));
     return true;
   }
 
+  // Picks a status tablet id from 'tablets' whose leader is known to be in the local region.
+  // Returns false if there are no such tablets in the meta cache.
+  bool PickRegionLocalStatusTabletId(const std::vector<TabletId>& tablets,
+                                     const PickStatusTabletCallback& callback)
+      REQUIRES_SHARED(mutex_) {
+    if (!client_ || !GetAtomicFlag(&FLAGS_transaction_prefer_region_local_status_tablet)) {
+      return false;
+    }
+    auto& candidates = region_local_candidates_[&tablets == &tablets_.global_tablets ? 0 : 1];
+    const auto now = CoarseMonoClock::now();
+    TabletId picked;
+    bool refresh = false;
+    {
+      std::lock_guard<simple_spinlock> lock(region_local_mutex_);
+      if (!candidates.refreshing &&
+          (candidates.status_tablets_version != status_tablets_version_ ||
+           now >= candidates.next_refresh)) {
+        candidates.refreshing = true;
+        refresh = true;
+      } else if (candidates.status_tablets_version == status_tablets_version_ &&
+                 !candidates.ids.empty()) {
+        picked = RandomElement(candidates.ids);
+      }
+    }
+    if (refresh) {
+      // Leaders are looked up in the meta cache without holding the spin lock, other threads
+      // keep picking from the previous candidates meanwhile.
+      auto ids = RegionLocalTabletIds(tablets);
+      std::lock_guard<simple_spinlock> lock(region_local_mutex_);
+      candidates.ids = std::move(ids);
+      candidates.status_tablets_version = status_tablets_version_;
+      candidates.next_refresh = now + MonoDelta::FromMilliseconds(GetAtomicFlag(
+          &FLAGS_transaction_region_local_status_tablets_refresh_ms));
+      candidates.refreshing = false;
+      if (!candidates.ids.empty()) {
+        picked = RandomElement(candidates.ids);
+      }
+    }
+    if (picked.empty()) {
+      return false;
+    }
+    callback(picked);
+    return true;
+  }
+
+  std::vector<TabletId> RegionLocalTabletIds(const std::vector<TabletId>& tablets) {
+    std::vector<TabletId> result;
+    for (const auto& id : tablets) {
+      auto tablet = client_->GetCachedTablet(id);
+      auto* leader = tablet ? tablet->LeaderTServer() : nullptr;
+      if (leader && leader->IsLocalRegion()) {
+        result.push_back(id);
+      }
+    }
+    return result;
+  }
+
   const std::vector<TabletId>& PickTabletList(TransactionLocality locality)
       REQUIRES_SHARED(mutex_) {
     if (tablets_.placement_local_tablets.empty()) {
@@ -130,6 +213,21 @@ class TransactionTableState {
     FATAL_INVALID_ENUM_VALUE(TransactionLocality, locality);
   }
 
+  // Status tablets whose leader is in the local region, according to the meta cache. Checking
+  // leaders of all status tablets is too expensive to do for each transaction, so candidates are
+  // cached until the status tablets list changes, or
+  // transaction_region_local_status_tablets_refresh_ms passes.
+  struct RegionLocalCandidates {
+    // Version of the status tablets lists the candidates were picked from, max() when the
+    // candidates were not picked yet.
+    uint64_t status_tablets_version = std::numeric_limits<uint64_t>::max();
+    CoarseTimePoint next_refresh;
+    bool refreshing = false;
+    std::vector<TabletId> ids;
+  };
+
+  YBClient* const client_;
+
   LocalTabletFilter local_tablet_filter_;
 
   // Set to true once transaction tablets have been loaded at least once. global_tablets
@@ -146,6 +244,10 @@ class TransactionTableState {
   uint64_t status_tablets_version_ GUARDED_BY(mutex_) = 0;
 
   TransactionStatusTablets tablets_ GUARDED_BY(mutex_);
+
+  simple_spinlock region_local_mutex_;
+  // Candidates for global and placement local status tablets.
+  std::array<RegionLocalCandidates, 2> region_local_candidates_ GUARDED_BY(region_local_mutex_);
 };
 
 // Loads transaction tablets list to cache.
@@ -232,7 +334,7 @@ class TransactionManager::Impl {
                 LocalTabletFilter local_tablet_filter)
       : client_(client),
         clock_(clock),
-        table_state_{std::move(local_tablet_filter)},
+        table_state_{client, std::move(local_tablet_filter)},
         thread_pool_(
             "TransactionManager", FLAGS_transaction_manager_queue_limit,
             FLAGS_transaction_manager_workers_limit),
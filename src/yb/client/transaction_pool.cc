@@ -13,7 +13,9 @@
 
 #include "yb/client/transaction_pool.h"
 
+#include <cmath>
 #include <deque>
+#include <vector>
 
 #include <gflags/gflags.h>
 
@@ -41,6 +43,12 @@ DEFINE_double(transaction_pool_reserve_factor, 2,
               "During cleanup we will preserve number of transactions in pool that equals to"
                   " average number or take requests during prepration multiplied by this factor");
 
+DEFINE_int32(transaction_pool_max_refill_batch, 8,
+             "Max number of transactions that pool starts preparing on a single take request, "
+             "when observed demand is higher than the number of prepared transactions.");
+TAG_FLAG(transaction_pool_max_refill_batch, advanced);
+TAG_FLAG(transaction_pool_max_refill_batch, runtime);
+
 DEFINE_bool(force_global_transactions, false,
             "Force all transactions to be global transactions");
 
@@ -67,6 +75,12 @@ METRIC_DEFINE_gauge_uint32(
     server, transaction_pool_prepared, "Number of prepared transactions in pool",
     yb::MetricUnit::kTransactions, "Number of prepared transactions in pool");
 
+METRIC_DEFINE_gauge_uint32(
+    server, transaction_pool_target_size, "Number of transactions that pool tries to keep",
+    yb::MetricUnit::kTransactions,
+    "Number of prepared and preparing transactions that pool tries to keep, based on the observed "
+    "number of take requests during transaction preparation");
+
 namespace yb {
 namespace client {
 
@@ -85,6 +99,7 @@ class SingleLocalityPool {
       cache_queries_ = METRIC_transaction_pool_cache_queries.Instantiate(metric_entity);
       gauge_preparing_ = METRIC_transaction_pool_preparing.Instantiate(metric_entity, 0);
       gauge_prepared_ = METRIC_transaction_pool_prepared.Instantiate(metric_entity, 0);
+      gauge_target_size_ = METRIC_transaction_pool_target_size.Instantiate(metric_entity, 0);
     }
   }
 
@@ -101,7 +116,8 @@ class SingleLocalityPool {
   }
 
   YBTransactionPtr Take() {
-    YBTransactionPtr result, new_txn;
+    YBTransactionPtr result;
+    std::vector<YBTransactionPtr> new_txns;
     uint64_t old_taken;
     IncrementCounter(cache_queries_);
     {
@@ -123,20 +139,43 @@ class SingleLocalityPool {
         IncrementHistogram(cache_histogram_, 100);
         IncrementCounter(cache_hits_);
       }
-      new_txn = std::make_shared<YBTransaction>(&manager_, locality_);
-      ++preparing_transactions_;
+      new_txns.resize(NumTransactionsToPrepare());
+      for (auto& new_txn : new_txns) {
+        new_txn = std::make_shared<YBTransaction>(&manager_, locality_);
+      }
+      preparing_transactions_ += new_txns.size();
     }
-    IncrementGauge(gauge_preparing_);
-    internal::InFlightOpsGroupsWithMetadata ops_info;
-    if (new_txn->batcher_if().Prepare(
-        &ops_info, ForceConsistentRead::kFalse, TransactionRpcDeadline(), Initial::kFalse,
-        std::bind(&SingleLocalityPool::TransactionReady, this, _1, new_txn, old_taken))) {
-      TransactionReady(Status::OK(), new_txn, old_taken);
+    for (const auto& new_txn : new_txns) {
+      IncrementGauge(gauge_preparing_);
+      internal::InFlightOpsGroupsWithMetadata ops_info;
+      if (new_txn->batcher_if().Prepare(
+          &ops_info, ForceConsistentRead::kFalse, TransactionRpcDeadline(), Initial::kFalse,
+          std::bind(&SingleLocalityPool::TransactionReady, this, _1, new_txn, old_taken))) {
+        TransactionReady(Status::OK(), new_txn, old_taken);
+      }
     }
     return result;
   }
 
  private:
+  // We create at least one new transaction on each take request, so number of transactions in
+  // pool follows demand. When observed demand is higher than the number of transactions in pool,
+  // for instance during a burst, more transactions are prepared at once, so the pool is refilled
+  // before the following take requests.
+  size_t NumTransactionsToPrepare() REQUIRES(mutex_) {
+    auto target = static_cast<size_t>(std::ceil(
+        demand_estimate_ * FLAGS_transaction_pool_reserve_factor));
+    if (gauge_target_size_) {
+      gauge_target_size_->set_value(static_cast<uint32_t>(target));
+    }
+    auto current = transactions_.size() + preparing_transactions_;
+    if (target <= current + 1) {
+      return 1;
+    }
+    return std::min<size_t>(
+        target - current, std::max(FLAGS_transaction_pool_max_refill_batch, 1));
+  }
+
   void TransactionReady(
       const Status& status, const YBTransactionPtr& txn, uint64_t taken_before_creation) {
     if (status.ok()) {
@@ -148,6 +187,9 @@ class SingleLocalityPool {
     if (status.ok()) {
       uint64_t taken_during_preparation = taken_transactions_ - taken_before_creation;
       taken_during_preparation_sum_ += taken_during_preparation;
+      // Exponential moving average of take requests during preparation, i.e. take rate
+      // multiplied by preparation latency.
+      demand_estimate_ += (taken_during_preparation - demand_estimate_) * kDemandEstimateAlpha;
       transactions_.push_back({ txn, taken_during_preparation });
     }
     --preparing_transactions_;
@@ -244,6 +286,8 @@ class SingleLocalityPool {
     uint64_t taken_during_preparation;
   };
 
+  static constexpr double kDemandEstimateAlpha = 0.1;
+
   TransactionManager& manager_;
   TransactionLocality locality_;
   scoped_refptr<Histogram> cache_histogram_;
@@ -251,6 +295,7 @@ class SingleLocalityPool {
   scoped_refptr<Counter> cache_queries_;
   scoped_refptr<AtomicGauge<uint32_t>> gauge_preparing_;
   scoped_refptr<AtomicGauge<uint32_t>> gauge_prepared_;
+  scoped_refptr<AtomicGauge<uint32_t>> gauge_target_size_;
   std::mutex mutex_;
   std::condition_variable cond_;
   std::deque<TransactionEntry> transactions_ GUARDED_BY(mutex_);
@@ -260,6 +305,7 @@ class SingleLocalityPool {
   uint64_t taken_transactions_ GUARDED_BY(mutex_) = 0;
   uint64_t taken_during_preparation_sum_ GUARDED_BY(mutex_) = 0;
   uint64_t taken_transactions_at_last_cleanup_ GUARDED_BY(mutex_) = 0;
+  double demand_estimate_ GUARDED_BY(mutex_) = 0;
 };
 } // namespace
 
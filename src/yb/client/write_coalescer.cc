@@ -0,0 +1,130 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/client/write_coalescer.h"
+
+#include <algorithm>
+
+#include "yb/client/async_rpc.h"
+#include "yb/client/in_flight_op.h"
+#include "yb/client/meta_cache.h"
+#include "yb/client/table.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/scheduler.h"
+
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/status.h"
+
+DEFINE_int32(ybclient_write_coalescing_window_us, 0,
+             "Time that non-transactional YCQL writes could wait for writes of other sessions to "
+             "the same tablet, to be sent in a single Write RPC. 0 to disable.");
+TAG_FLAG(ybclient_write_coalescing_window_us, advanced);
+TAG_FLAG(ybclient_write_coalescing_window_us, runtime);
+
+DEFINE_int32(ybclient_write_coalescing_max_ops, 256,
+             "Coalesced writes are sent right away, when they contain at least this number of "
+             "operations.");
+TAG_FLAG(ybclient_write_coalescing_max_ops, advanced);
+TAG_FLAG(ybclient_write_coalescing_max_ops, runtime);
+
+namespace yb {
+namespace client {
+namespace internal {
+
+WriteCoalescer::WriteCoalescer() = default;
+
+WriteCoalescer::~WriteCoalescer() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  LOG_IF(DFATAL, !pending_.empty())
+      << "Destroying write coalescer with " << pending_.size() << " pending tablets";
+}
+
+bool WriteCoalescer::Submit(const std::shared_ptr<AsyncRpc>& rpc, rpc::Messenger* messenger) {
+  auto window_us = GetAtomicFlag(&FLAGS_ybclient_write_coalescing_window_us);
+  if (window_us <= 0) {
+    return false;
+  }
+  auto write_rpc = std::dynamic_pointer_cast<WriteRpc>(rpc);
+  if (!write_rpc || !write_rpc->CanCoalesce()) {
+    return false;
+  }
+
+  Key key(write_rpc->tablet().tablet_id(), write_rpc->table()->id());
+  std::vector<std::shared_ptr<WriteRpc>> ready;
+  bool schedule = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& pending = pending_[key];
+    pending.rpcs.push_back(write_rpc);
+    pending.num_ops += write_rpc->ops().size();
+    if (pending.num_ops >= static_cast<size_t>(
+            GetAtomicFlag(&FLAGS_ybclient_write_coalescing_max_ops))) {
+      ready.swap(pending.rpcs);
+      pending_.erase(key);
+    } else {
+      schedule = pending.rpcs.size() == 1;
+    }
+  }
+
+  if (!ready.empty()) {
+    Send(std::move(ready));
+  } else if (schedule) {
+    // Keep coalescer alive until the task is executed, since it could be executed after the
+    // shutdown of the client, when messenger is shared.
+    auto self = shared_from_this();
+    messenger->scheduler().Schedule(
+        [self, key](const Status&) { self->Flush(key); },
+        std::chrono::microseconds(window_us));
+  }
+  return true;
+}
+
+void WriteCoalescer::Flush(const Key& key) {
+  std::vector<std::shared_ptr<WriteRpc>> rpcs;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pending_.find(key);
+    if (it == pending_.end()) {
+      return;
+    }
+    rpcs.swap(it->second.rpcs);
+    pending_.erase(it);
+  }
+  // Even if scheduler was aborted, we still send RPCs, so they would be completed.
+  Send(std::move(rpcs));
+}
+
+void WriteCoalescer::Send(std::vector<std::shared_ptr<WriteRpc>> rpcs) {
+  // Use RPC with the earliest deadline to send merged request, so no operation waits for the
+  // response longer than its own deadline.
+  auto primary_it = std::min_element(
+      rpcs.begin(), rpcs.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs->deadline() < rhs->deadline();
+  });
+  auto primary = *primary_it;
+  for (const auto& rpc : rpcs) {
+    if (rpc != primary) {
+      primary->Coalesce(rpc);
+    }
+  }
+  VLOG(4) << "Sending " << rpcs.size() << " coalesced write RPCs as " << primary->ToString();
+  primary->SendRpc();
+}
+
+} // namespace internal
+} // namespace client
+} // namespace yb
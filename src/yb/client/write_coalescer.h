@@ -0,0 +1,72 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#ifndef YB_CLIENT_WRITE_COALESCER_H
+#define YB_CLIENT_WRITE_COALESCER_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/entity_ids_types.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/rpc/rpc_fwd.h"
+
+namespace yb {
+namespace client {
+namespace internal {
+
+// Merges non-transactional YCQL write RPCs that are sent by different batchers to the same tablet
+// within ybclient_write_coalescing_window_us into a single WriteRequestPB. Responses are fanned
+// back out to the original RPCs, so each batcher sees them as if its RPC was sent separately.
+//
+// Used by the CQL proxy, where each connection flushes its own session, so many small concurrent
+// single row writes to the same tablet would otherwise become separate Write RPCs.
+class WriteCoalescer : public std::enable_shared_from_this<WriteCoalescer> {
+ public:
+  WriteCoalescer();
+  ~WriteCoalescer();
+
+  // Returns true if rpc was taken by coalescer and will be sent later, possibly merged with other
+  // RPCs. Otherwise caller should send rpc itself.
+  bool Submit(const std::shared_ptr<AsyncRpc>& rpc, rpc::Messenger* messenger);
+
+ private:
+  using Key = std::pair<TabletId, TableId>;
+
+  struct Pending {
+    std::vector<std::shared_ptr<WriteRpc>> rpcs;
+    size_t num_ops = 0;
+  };
+
+  void Flush(const Key& key);
+
+  static void Send(std::vector<std::shared_ptr<WriteRpc>> rpcs);
+
+  std::mutex mutex_;
+  std::map<Key, Pending> pending_ GUARDED_BY(mutex_);
+};
+
+} // namespace internal
+} // namespace client
+} // namespace yb
+
+#endif // YB_CLIENT_WRITE_COALESCER_H
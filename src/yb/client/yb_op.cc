@@ -78,6 +78,14 @@ using std::unique_ptr;
 
 namespace {
 
+// Returns cleared buffer for encoding of key column values. The buffer is reused by calls from the
+// same thread, so hashing of write operations by key does not allocate.
+std::string& KeyColumnsBuffer() {
+  static thread_local std::string buffer;
+  buffer.clear();
+  return buffer;
+}
+
 CHECKED_STATUS InitHashPartitionKey(
     const Schema& schema, const PartitionSchema& partition_schema, PgsqlReadRequestPB* request) {
   // Read partition key from read request.
@@ -499,7 +507,7 @@ size_t YBqlWriteHashKeyComparator::operator()(const YBqlWriteOpPtr& op) const {
   boost::hash_combine(hash, op->table()->id());
 
   // Hash the hash key.
-  string key;
+  auto& key = KeyColumnsBuffer();
   for (const auto& value : op->request().hashed_column_values()) {
     AppendToKey(value.value(), &key);
   }
@@ -533,7 +541,7 @@ size_t YBqlWritePrimaryKeyComparator::operator()(const YBqlWriteOpPtr& op) const
   size_t hash = YBqlWriteHashKeyComparator()(op);
 
   // Hash the range key also.
-  string key;
+  auto& key = KeyColumnsBuffer();
   for (const auto& value : op->request().range_column_values()) {
     AppendToKey(value.value(), &key);
   }
@@ -119,6 +119,15 @@ std::string Partition::ToString() const {
 }
 
 namespace {
+
+// Returns cleared buffer for encoding of hash column values. The buffer is reused by calls from
+// the same thread, so partition keys of requests are encoded without allocations.
+std::string& HashColumnsBuffer() {
+  static thread_local std::string buffer;
+  buffer.clear();
+  return buffer;
+}
+
 // Extracts the column IDs from a protobuf repeated field of column identifiers.
 Status ExtractColumnIds(const RepeatedPtrField<PartitionSchemaPB_ColumnIdentifierPB>& identifiers,
                         const Schema& schema,
@@ -357,7 +366,7 @@ Status PartitionSchema::EncodeKey(const RepeatedPtrField<QLExpressionPB>& hash_c
 
   switch (*hash_schema_) {
     case YBHashSchema::kMultiColumnHash: {
-      string tmp;
+      auto& tmp = HashColumnsBuffer();
       for (const auto &col_expr_pb : hash_col_values) {
         AppendToKey(col_expr_pb.value(), &tmp);
       }
@@ -386,7 +395,7 @@ Status PartitionSchema::EncodeKey(const RepeatedPtrField<PgsqlExpressionPB>& has
     case YBHashSchema::kPgsqlHash: {
       // TODO(neil) Discussion is needed. PGSQL hash should be done appropriately.
       // For now, let's not doing anything. Just borrow code from multi column hashing style.
-      string tmp;
+      auto& tmp = HashColumnsBuffer();
       for (const auto &col_expr_pb : hash_col_values) {
         AppendToKey(col_expr_pb.value(), &tmp);
       }
@@ -614,6 +614,18 @@ size_t QLTableRow::ColumnCount() const {
   return result;
 }
 
+size_t QLTableRow::SpaceUsed() const {
+  size_t result = sizeof(*this) +
+                  column_id_to_index_.size() * sizeof(decltype(column_id_to_index_)::value_type);
+  for (size_t i = 0; i != values_.size(); ++i) {
+    result += sizeof(QLTableColumn) + sizeof(bool);
+    if (assigned_[i]) {
+      result += values_[i].value.SpaceUsedLong() - sizeof(QLValuePB);
+    }
+  }
+  return result;
+}
+
 void QLTableRow::Clear() {
   if (num_assigned_ == 0) {
     return;
@@ -103,6 +103,9 @@ class QLTableRow {
   // Clear the row.
   void Clear();
 
+  // Estimated memory used by the row, including assigned column values.
+  size_t SpaceUsed() const;
+
   // Compare column value between two rows.
   bool MatchColumn(ColumnIdRep col_id, const QLTableRow& source) const;
   bool MatchColumn(const ColumnId& col, const QLTableRow& source) const {
@@ -74,6 +74,10 @@ class TransactionStatusManagerMock : public TransactionStatusManager {
     return HybridTime::kMin;
   }
 
+  bool MayHaveIntentsWithPrefix(const Slice& key_prefix) const override {
+    return true;
+  }
+
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override {
     return STATUS(NotSupported, "WaitForSafeTime not implemented");
   }
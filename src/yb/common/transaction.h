@@ -38,6 +38,7 @@
 
 #include "yb/util/enums.h"
 #include "yb/util/math_util.h"
+#include "yb/util/slice.h"
 #include "yb/util/strongly_typed_uuid.h"
 #include "yb/util/uint_set.h"
 
@@ -163,6 +164,10 @@ class TransactionStatusManager {
   // Returns minimal running hybrid time of all running transactions.
   virtual HybridTime MinRunningHybridTime() const = 0;
 
+  // Returns false when it is known that running transactions don't have intents for keys that
+  // start with the specified prefix.
+  virtual bool MayHaveIntentsWithPrefix(const Slice& key_prefix) const = 0;
+
   virtual Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) = 0;
 
   virtual const TabletId& tablet_id() const = 0;
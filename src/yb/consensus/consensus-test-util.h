@@ -945,6 +945,7 @@ class TestRaftConsensusQueueIface : public PeerMessageQueueObserver {
                             int64_t term,
                             const std::string& reason) override {}
   void MajorityReplicatedNumSSTFilesChanged(uint64_t) override {}
+  void NotifyLogPrefetched() override {}
 
  private:
   mutable simple_spinlock lock_;
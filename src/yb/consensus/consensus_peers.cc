@@ -57,6 +57,7 @@
 #include "yb/tablet/tablet_error.h"
 #include "yb/tserver/tserver_error.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/backoff_waiter.h"
 #include "yb/util/fault_injection.h"
 #include "yb/util/flag_tags.h"
@@ -86,6 +87,8 @@ TAG_FLAG(max_wait_for_processresponse_before_closing_ms, advanced);
 DECLARE_int32(raft_heartbeat_interval_ms);
 
 DECLARE_bool(enable_multi_raft_heartbeat_batcher);
+DECLARE_bool(multi_raft_batch_ops);
+DECLARE_uint64(multi_raft_max_batched_request_bytes);
 
 DEFINE_test_flag(double, fault_crash_on_leader_request_fraction, 0.0,
                  "Fraction of the time when the leader will crash just before sending an "
@@ -360,6 +363,19 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   minimum_viable_heartbeat_ = cur_heartbeat_id_ + 1;
   processing_lock.unlock();
   performing_update_lock.release();
+
+  // Small requests with ops are batched with requests of other tablets to the same server, to
+  // reduce the number of RPCs when there are many raft groups.
+  if (!req_is_heartbeat && multi_raft_batcher_ && FLAGS_enable_multi_raft_heartbeat_batcher &&
+      GetAtomicFlag(&FLAGS_multi_raft_batch_ops) &&
+      update_request_.ByteSizeLong() <=
+          GetAtomicFlag(&FLAGS_multi_raft_max_batched_request_bytes)) {
+    multi_raft_batcher_->AddRequestToBatch(&update_request_, &update_response_,
+                                           std::bind(&Peer::ProcessUpdateResponse,
+                                                     retain_self, _1));
+    return;
+  }
+
   controller_.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
   proxy_->UpdateAsync(&update_request_, trigger_mode, &update_response_, &controller_,
                       std::bind(&Peer::ProcessResponse, retain_self));
@@ -444,12 +460,16 @@ bool Peer::ProcessResponseWithStatus(const Status& status,
 }
 
 void Peer::ProcessResponse() {
-  DCHECK(performing_update_mutex_.is_locked()) << "Got a response when nothing was pending.";
   auto status = controller_.status();
   if (status.ok()) {
     status = controller_.thread_pool_failure();
   }
   controller_.Reset();
+  ProcessUpdateResponse(status);
+}
+
+void Peer::ProcessUpdateResponse(const Status& status) {
+  DCHECK(performing_update_mutex_.is_locked()) << "Got a response when nothing was pending.";
   CleanRequestOps(&update_request_);
 
   auto performing_update_lock = LockPerformingUpdate(std::adopt_lock);
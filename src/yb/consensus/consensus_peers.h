@@ -186,6 +186,9 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // requires IO or may block.
   void ProcessResponse();
 
+  // Handles response to the update request, that was sent directly or as part of multi raft batch.
+  void ProcessUpdateResponse(const Status& status);
+
   // Signals that a heartbeat response was received from the peer.
   void ProcessHeartbeatResponse(const Status& status);
 
@@ -273,7 +276,7 @@ class Peer : public std::enable_shared_from_this<Peer> {
   std::shared_ptr<rpc::PeriodicTimer> heartbeater_;
 
   // Batcher that currently batches heartbeat requests that are sent by each consensus peer
-  // on a per tserver level
+  // on a per tserver level, and small update requests when multi_raft_batch_ops is set.
   MultiRaftHeartbeatBatcherPtr multi_raft_batcher_;
 
   // Thread pool used to construct requests to this peer.
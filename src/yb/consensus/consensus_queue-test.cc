@@ -55,6 +55,7 @@
 
 DECLARE_bool(enable_data_block_fsync);
 DECLARE_uint64(consensus_max_batch_size_bytes);
+DECLARE_bool(remote_bootstrap_from_closest_peer);
 
 METRIC_DECLARE_entity(tablet);
 
@@ -879,6 +880,119 @@ TEST_F(ConsensusQueueTest, TestTriggerRemoteBootstrapIfTabletNotFound) {
             rb_req.source_private_addr()[0].ShortDebugString());
 }
 
+// Test that a witness is never picked as the remote bootstrap source, even when it is the closest
+// peer to the new replica, because it has no data to send.
+TEST_F(ConsensusQueueTest, TestRemoteBootstrapSkipsWitnessSource) {
+  FLAGS_remote_bootstrap_from_closest_peer = true;
+  constexpr auto kWitnessUuid = "peer-2";
+  constexpr auto kFollowerUuid = "peer-3";
+
+  auto config = BuildRaftConfigPBForTests(4);
+  for (auto& peer_pb : *config.mutable_peers()) {
+    auto* cloud_info = peer_pb.mutable_cloud_info();
+    cloud_info->set_placement_cloud("cloud");
+    cloud_info->set_placement_region("region2");
+    if (peer_pb.permanent_uuid() == kLeaderUuid) {
+      cloud_info->set_placement_region("region1");
+      cloud_info->set_placement_zone("zone1");
+    } else if (peer_pb.permanent_uuid() == kFollowerUuid) {
+      cloud_info->set_placement_zone("zone3");
+    } else {
+      // The new replica and the witness share a zone.
+      cloud_info->set_placement_zone("zone2");
+    }
+    peer_pb.set_witness(peer_pb.permanent_uuid() == kWitnessUuid);
+  }
+
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(OpId::Min(), OpId::Min().term, OpId::Min(), config);
+
+  // The witness and the data-bearing follower are both caught up.
+  for (const auto* uuid : {kWitnessUuid, kFollowerUuid}) {
+    queue_->TrackPeer(uuid);
+    ConsensusRequestPB request;
+    ReplicateMsgsHolder refs;
+    bool needs_remote_bootstrap;
+    ASSERT_OK(queue_->RequestForPeer(uuid, &request, &refs, &needs_remote_bootstrap));
+    ConsensusResponsePB response;
+    response.set_responder_uuid(uuid);
+    SetLastReceivedAndLastCommitted(&response, OpId::Min());
+    queue_->ResponseFromPeer(uuid, response);
+  }
+
+  queue_->TrackPeer(kPeerUuid);
+  ConsensusRequestPB request;
+  ReplicateMsgsHolder refs;
+  bool needs_remote_bootstrap;
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ConsensusResponsePB response;
+  response.set_responder_uuid(kPeerUuid);
+  response.mutable_error()->set_code(tserver::TabletServerErrorPB::TABLET_NOT_FOUND);
+  StatusToPB(STATUS(NotFound, "No such tablet"), response.mutable_error()->mutable_status());
+  ASSERT_TRUE(queue_->ResponseFromPeer(kPeerUuid, response));
+
+  request.Clear();
+  refs.Reset();
+  ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+  ASSERT_TRUE(needs_remote_bootstrap);
+
+  StartRemoteBootstrapRequestPB rb_req;
+  ASSERT_OK(queue_->GetRemoteBootstrapRequestForPeer(kPeerUuid, &rb_req));
+  ASSERT_EQ(kFollowerUuid, rb_req.bootstrap_peer_uuid());
+  ASSERT_EQ("zone3", rb_req.source_cloud_info().placement_zone());
+}
+
+// Test that a witness leader remote bootstraps new peers from a follower that has data, even
+// without closest peer selection, and refuses to do it when there is no such follower.
+TEST_F(ConsensusQueueTest, TestWitnessLeaderRemoteBootstrapsFromFollower) {
+  FLAGS_remote_bootstrap_from_closest_peer = false;
+  constexpr auto kFollowerUuid = "peer-2";
+
+  auto config = BuildRaftConfigPBForTests(3);
+  for (auto& peer_pb : *config.mutable_peers()) {
+    peer_pb.set_witness(peer_pb.permanent_uuid() == kLeaderUuid);
+  }
+  queue_->Init(OpId::Min());
+  queue_->SetLeaderMode(OpId::Min(), OpId::Min().term, OpId::Min(), config);
+
+  auto request_remote_bootstrap = [this]() {
+    queue_->TrackPeer(kPeerUuid);
+    ConsensusRequestPB request;
+    ReplicateMsgsHolder refs;
+    bool needs_remote_bootstrap;
+    ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+    ConsensusResponsePB response;
+    response.set_responder_uuid(kPeerUuid);
+    response.mutable_error()->set_code(tserver::TabletServerErrorPB::TABLET_NOT_FOUND);
+    StatusToPB(STATUS(NotFound, "No such tablet"), response.mutable_error()->mutable_status());
+    ASSERT_TRUE(queue_->ResponseFromPeer(kPeerUuid, response));
+    request.Clear();
+    refs.Reset();
+    ASSERT_OK(queue_->RequestForPeer(kPeerUuid, &request, &refs, &needs_remote_bootstrap));
+    ASSERT_TRUE(needs_remote_bootstrap);
+  };
+
+  // The follower has not responded yet, so there is no source with data.
+  ASSERT_NO_FATALS(request_remote_bootstrap());
+  StartRemoteBootstrapRequestPB rb_req;
+  ASSERT_TRUE(queue_->GetRemoteBootstrapRequestForPeer(kPeerUuid, &rb_req).IsIllegalState());
+
+  queue_->TrackPeer(kFollowerUuid);
+  {
+    ConsensusRequestPB request;
+    ReplicateMsgsHolder refs;
+    bool needs_remote_bootstrap;
+    ASSERT_OK(queue_->RequestForPeer(kFollowerUuid, &request, &refs, &needs_remote_bootstrap));
+    ConsensusResponsePB response;
+    response.set_responder_uuid(kFollowerUuid);
+    SetLastReceivedAndLastCommitted(&response, OpId::Min());
+    queue_->ResponseFromPeer(kFollowerUuid, response);
+  }
+
+  ASSERT_OK(queue_->GetRemoteBootstrapRequestForPeer(kPeerUuid, &rb_req));
+  ASSERT_EQ(kFollowerUuid, rb_req.bootstrap_peer_uuid());
+}
+
 // Tests that ReadReplicatedMessagesForCDC() only reads messages until the last known
 // committed index.
 TEST_F(ConsensusQueueTest, TestReadReplicatedMessagesForCDC) {
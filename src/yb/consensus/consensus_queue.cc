@@ -119,6 +119,19 @@ DEFINE_int32(consensus_lagging_follower_threshold, 10,
 TAG_FLAG(consensus_lagging_follower_threshold, advanced);
 TAG_FLAG(consensus_lagging_follower_threshold, runtime);
 
+DEFINE_bool(enable_log_cache_prefetch, false,
+            "Whether operations that lagging peers need, and that are missing in the log cache, "
+            "should be read from disk in background instead of while preparing requests to peers.");
+TAG_FLAG(enable_log_cache_prefetch, advanced);
+TAG_FLAG(enable_log_cache_prefetch, runtime);
+
+DEFINE_bool(remote_bootstrap_from_closest_peer, false,
+            "Whether the leader should direct a new replica to remotely bootstrap from an up to "
+            "date follower that is placed closer to it than the leader, e.g. in the same zone. "
+            "The leader then only supplies operations that the follower did not have.");
+TAG_FLAG(remote_bootstrap_from_closest_peer, advanced);
+TAG_FLAG(remote_bootstrap_from_closest_peer, runtime);
+
 DEFINE_test_flag(bool, disallow_lmp_failures, false,
                  "Whether we disallow PRECEDING_ENTRY_DIDNT_MATCH failures for non new peers.");
 
@@ -208,8 +221,10 @@ PeerMessageQueue::PeerMessageQueue(const scoped_refptr<MetricEntity>& metric_ent
                                    const string& tablet_id,
                                    const server::ClockPtr& clock,
                                    ConsensusContext* context,
-                                   unique_ptr<ThreadPoolToken> raft_pool_token)
+                                   unique_ptr<ThreadPoolToken> raft_pool_token,
+                                   unique_ptr<ThreadPoolToken> log_prefetch_token)
     : raft_pool_observers_token_(std::move(raft_pool_token)),
+      log_prefetch_token_(std::move(log_prefetch_token)),
       local_peer_pb_(local_peer_pb),
       local_peer_uuid_(local_peer_pb_.has_permanent_uuid() ? local_peer_pb_.permanent_uuid()
                                                            : string()),
@@ -447,6 +462,7 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
   int64_t previously_sent_index;
   uint64_t num_log_ops_to_send;
   HybridTime propagated_safe_time;
+  ReadFromDisk read_from_disk = ReadFromDisk::kTrue;
 
   // Should be before now_ht, i.e. not greater than propagated_hybrid_time.
   if (context_) {
@@ -536,6 +552,12 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     *needs_remote_bootstrap = peer->needs_remote_bootstrap;
 
     previously_sent_index = peer->next_index - 1;
+    // Ops that were already prefetched for this peer, but are missing in the log cache, e.g.
+    // because of eviction, are read synchronously, so the peer could make progress.
+    if (log_prefetch_token_ && GetAtomicFlag(&FLAGS_enable_log_cache_prefetch) &&
+        (peer->waiting_for_log_prefetch || peer->log_prefetch_index != peer->next_index)) {
+      read_from_disk = ReadFromDisk::kFalse;
+    }
     if (FLAGS_enable_consensus_exponential_backoff && peer->last_num_messages_sent >= 0) {
       // Previous request to peer has not been acked. Reduce number of entries to be sent
       // in this attempt using exponential backoff. Note that to_index is inclusive.
@@ -585,7 +607,9 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
     auto max_batch_size = FLAGS_consensus_max_batch_size_bytes - request->ByteSizeLong();
     auto to_index = num_log_ops_to_send == kSendUnboundedLogOps ?
         0 : previously_sent_index + num_log_ops_to_send;
-    auto result = ReadFromLogCache(previously_sent_index, to_index, max_batch_size, uuid);
+    auto result = ReadFromLogCache(
+        previously_sent_index, to_index, max_batch_size, uuid, CoarseTimePoint::max(),
+        read_from_disk);
 
     if (PREDICT_FALSE(!result.ok())) {
       if (PREDICT_TRUE(result.status().IsNotFound())) {
@@ -597,6 +621,10 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
       return result.status();
     }
 
+    if (result->missing_op_index) {
+      StartLogPrefetch(uuid, result->missing_op_index);
+    }
+
     preceding_id = result->preceding_op;
     // We use AddAllocated rather than copy, because we pin the log cache at the "all replicated"
     // point. At some point we may want to allow partially loading (and not pinning) earlier
@@ -671,12 +699,13 @@ Result<ReadOpsResult> PeerMessageQueue::ReadFromLogCache(int64_t after_index,
                                                          int64_t to_index,
                                                          size_t max_batch_size,
                                                          const std::string& peer_uuid,
-                                                         const CoarseTimePoint deadline) {
+                                                         const CoarseTimePoint deadline,
+                                                         ReadFromDisk read_from_disk) {
   DCHECK_LT(FLAGS_consensus_max_batch_size_bytes + 1_KB, FLAGS_rpc_max_message_size);
 
   // We try to get the follower's next_index from our log.
   // Note this is not using "term" and needs to change
-  auto result = log_cache_.ReadOps(after_index, to_index, max_batch_size, deadline);
+  auto result = log_cache_.ReadOps(after_index, to_index, max_batch_size, deadline, read_from_disk);
   if (PREDICT_FALSE(!result.ok())) {
     auto s = result.status();
     if (PREDICT_TRUE(s.IsNotFound())) {
@@ -700,6 +729,50 @@ Result<ReadOpsResult> PeerMessageQueue::ReadFromLogCache(int64_t after_index,
   return result;
 }
 
+void PeerMessageQueue::StartLogPrefetch(const std::string& uuid, int64_t missing_op_index) {
+  {
+    LockGuard lock(queue_lock_);
+    auto peer = FindPtrOrNull(peers_map_, uuid);
+    if (PREDICT_FALSE(peer == nullptr)) {
+      return;
+    }
+    // Should be set before starting prefetch, so it is reset when prefetch finishes.
+    peer->waiting_for_log_prefetch = true;
+  }
+
+  auto started = log_cache_.Prefetch(
+      missing_op_index - 1, log_prefetch_token_.get(),
+      std::bind(&PeerMessageQueue::LogPrefetchFinished, this));
+
+  LockGuard lock(queue_lock_);
+  auto peer = FindPtrOrNull(peers_map_, uuid);
+  if (PREDICT_FALSE(peer == nullptr)) {
+    return;
+  }
+  if (!started.ok()) {
+    LOG_WITH_PREFIX_UNLOCKED(WARNING)
+        << "Failed to start log prefetch for " << uuid << ": " << started.status();
+    // Fall back to reading from disk while preparing the next request.
+    peer->waiting_for_log_prefetch = false;
+    peer->log_prefetch_index = missing_op_index;
+  } else if (*started) {
+    peer->log_prefetch_index = missing_op_index;
+  }
+  // Otherwise another prefetch is in progress, the peer will retry after it finishes.
+}
+
+void PeerMessageQueue::LogPrefetchFinished() {
+  {
+    LockGuard lock(queue_lock_);
+    for (const auto& id_and_peer : peers_map_) {
+      id_and_peer.second->waiting_for_log_prefetch = false;
+    }
+  }
+  NotifyObservers("log prefetched", [](PeerMessageQueueObserver* observer) {
+    observer->NotifyLogPrefetched();
+  });
+}
+
 // Read majority replicated messages from cache for CDC.
 // CDC producer will use this to get the messages to send in response to cdc::GetChanges RPC.
 Result<ReadOpsResult> PeerMessageQueue::ReadReplicatedMessagesForCDC(
@@ -745,9 +818,71 @@ Result<ReadOpsResult> PeerMessageQueue::ReadReplicatedMessagesForCDC(
   return result;
 }
 
+namespace {
+
+// Returns the number of leading placement levels (cloud, region, zone) that are the same in
+// lhs and rhs.
+int CommonPlacementLevels(const CloudInfoPB& lhs, const CloudInfoPB& rhs) {
+  if (lhs.placement_cloud() != rhs.placement_cloud()) {
+    return 0;
+  }
+  if (lhs.placement_region() != rhs.placement_region()) {
+    return 1;
+  }
+  if (lhs.placement_zone() != rhs.placement_zone()) {
+    return 2;
+  }
+  return 3;
+}
+
+} // namespace
+
+const RaftPeerPB* PeerMessageQueue::FindRemoteBootstrapSourceUnlocked(const string& uuid) {
+  if (!queue_state_.active_config) {
+    return nullptr;
+  }
+  // Witness leader does not have tablet data, so it always needs a follower as the source.
+  const bool local_is_witness = IsRaftConfigWitness(local_peer_uuid_,
+                                                    *queue_state_.active_config);
+  if (!local_is_witness && !GetAtomicFlag(&FLAGS_remote_bootstrap_from_closest_peer)) {
+    return nullptr;
+  }
+  const auto& peers = queue_state_.active_config->peers();
+  auto dest_it = std::find_if(peers.begin(), peers.end(), [&uuid](const RaftPeerPB& peer_pb) {
+    return peer_pb.permanent_uuid() == uuid;
+  });
+  if (dest_it == peers.end() || (!local_is_witness && !dest_it->has_cloud_info())) {
+    return nullptr;
+  }
+
+  auto best_levels = local_is_witness
+      ? -1 : CommonPlacementLevels(local_peer_pb_.cloud_info(), dest_it->cloud_info());
+  const RaftPeerPB* result = nullptr;
+  for (const auto& peer_pb : peers) {
+    if (peer_pb.permanent_uuid() == uuid || peer_pb.permanent_uuid() == local_peer_uuid_ ||
+        peer_pb.member_type() != PeerMemberType::VOTER || peer_pb.witness() ||
+        peer_pb.last_known_private_addr().empty()) {
+      continue;
+    }
+    // The source should have all committed operations, and be reachable by the leader.
+    auto* peer = FindPtrOrNull(peers_map_, peer_pb.permanent_uuid());
+    if (!peer || !peer->is_last_exchange_successful ||
+        peer->last_received < queue_state_.committed_op_id) {
+      continue;
+    }
+    auto levels = CommonPlacementLevels(peer_pb.cloud_info(), dest_it->cloud_info());
+    if (levels > best_levels) {
+      best_levels = levels;
+      result = &peer_pb;
+    }
+  }
+  return result;
+}
+
 Status PeerMessageQueue::GetRemoteBootstrapRequestForPeer(const string& uuid,
                                                           StartRemoteBootstrapRequestPB* req) {
   TrackedPeer* peer = nullptr;
+  RaftPeerPB source_pb = local_peer_pb_;
   {
     LockGuard lock(queue_lock_);
     DCHECK_EQ(queue_state_.state, State::kQueueOpen);
@@ -756,6 +891,15 @@ Status PeerMessageQueue::GetRemoteBootstrapRequestForPeer(const string& uuid,
     if (PREDICT_FALSE(peer == nullptr || queue_state_.mode == Mode::NON_LEADER)) {
       return STATUS(NotFound, "Peer not tracked or queue not in leader mode.");
     }
+    if (peer->needs_remote_bootstrap) {
+      auto* source = FindRemoteBootstrapSourceUnlocked(uuid);
+      if (source) {
+        source_pb = *source;
+      } else if (IsRaftConfigWitness(local_peer_uuid_, *queue_state_.active_config)) {
+        return STATUS_FORMAT(
+            IllegalState, "Witness leader has no follower to remote bootstrap peer $0 from", uuid);
+      }
+    }
   }
 
   if (PREDICT_FALSE(!peer->needs_remote_bootstrap)) {
@@ -770,10 +914,14 @@ Status PeerMessageQueue::GetRemoteBootstrapRequestForPeer(const string& uuid,
   req->Clear();
   req->set_dest_uuid(uuid);
   req->set_tablet_id(tablet_id_);
-  req->set_bootstrap_peer_uuid(local_peer_uuid_);
-  *req->mutable_source_private_addr() = local_peer_pb_.last_known_private_addr();
-  *req->mutable_source_broadcast_addr() = local_peer_pb_.last_known_broadcast_addr();
-  *req->mutable_source_cloud_info() = local_peer_pb_.cloud_info();
+  if (source_pb.permanent_uuid() != local_peer_uuid_) {
+    LOG_WITH_PREFIX_UNLOCKED(INFO) << "Remote bootstrapping peer " << uuid << " from follower "
+                                   << source_pb.permanent_uuid();
+  }
+  req->set_bootstrap_peer_uuid(source_pb.permanent_uuid());
+  *req->mutable_source_private_addr() = source_pb.last_known_private_addr();
+  *req->mutable_source_broadcast_addr() = source_pb.last_known_broadcast_addr();
+  *req->mutable_source_cloud_info() = source_pb.cloud_info();
   req->set_caller_term(queue_state_.current_term);
   peer->needs_remote_bootstrap = false; // Now reset the flag.
   return Status::OK();
@@ -1240,8 +1388,10 @@ bool PeerMessageQueue::ResponseFromPeer(const std::string& peer_uuid,
 
     // If our log has the next request for the peer or if the peer's committed index is lower than
     // our own, set 'more_pending' to true.
-    result = log_cache_.HasOpBeenWritten(peer->next_index) ||
-        (peer->last_known_committed_idx < queue_state_.committed_op_id.index);
+    // A peer that waits for log prefetch is woken up when prefetch finishes.
+    result = !peer->waiting_for_log_prefetch &&
+        (log_cache_.HasOpBeenWritten(peer->next_index) ||
+         peer->last_known_committed_idx < queue_state_.committed_op_id.index);
 
     mode_copy = queue_state_.mode;
     if (mode_copy == Mode::LEADER) {
@@ -1362,6 +1512,10 @@ void PeerMessageQueue::Close() {
     context_->ListenNumSSTFilesChanged(std::function<void()>());
     installed_num_sst_files_changed_listener_ = false;
   }
+  // Finished prefetch notifies observers, so prefetch should be stopped first.
+  if (log_prefetch_token_) {
+    log_prefetch_token_->Shutdown();
+  }
   raft_pool_observers_token_->Shutdown();
   LockGuard lock(queue_lock_);
   ClearUnlocked();
@@ -1531,6 +1685,11 @@ bool PeerMessageQueue::CanPeerBecomeLeader(const std::string& peer_uuid) const {
     LOG(ERROR) << "Invalid peer UUID: " << peer_uuid;
     return false;
   }
+  if (queue_state_.active_config &&
+      IsRaftConfigWitness(peer_uuid, *queue_state_.active_config)) {
+    LOG(INFO) << Format("Peer $0 cannot become Leader as it is a witness", peer_uuid);
+    return false;
+  }
   const bool peer_can_be_leader = peer->last_received >= queue_state_.majority_replicated_op_id;
   if (!peer_can_be_leader) {
     LOG(INFO) << Format(
@@ -1560,6 +1719,10 @@ string PeerMessageQueue::GetUpToDatePeer() const {
       if (local_peer_uuid_ == entry.first) {
         continue;
       }
+      if (queue_state_.active_config &&
+          IsRaftConfigWitness(entry.first, *queue_state_.active_config)) {
+        continue;
+      }
       if (highest_op_id > entry.second->last_received) {
         continue;
       } else if (highest_op_id == entry.second->last_received) {
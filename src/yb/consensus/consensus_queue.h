@@ -178,6 +178,13 @@ class PeerMessageQueue {
 
     uint64_t num_sst_files = 0;
 
+    // Index of the first operation that was prefetched from disk for this peer. Operations starting
+    // from this index are read from disk synchronously if they are still missing in the log cache.
+    int64_t log_prefetch_index = kInvalidOpIdIndex;
+
+    // Whether the peer waits for log cache prefetch to finish before the next request.
+    bool waiting_for_log_prefetch = false;
+
    private:
     // The last term we saw from a given peer.
     // This is only used for sanity checking that a peer doesn't
@@ -193,7 +200,8 @@ class PeerMessageQueue {
                    const std::string& tablet_id,
                    const server::ClockPtr& clock,
                    ConsensusContext* context,
-                   std::unique_ptr<ThreadPoolToken> raft_pool_observers_token);
+                   std::unique_ptr<ThreadPoolToken> raft_pool_observers_token,
+                   std::unique_ptr<ThreadPoolToken> log_prefetch_token = nullptr);
 
   // Initialize the queue.
   virtual void Init(const OpId& last_locally_replicated);
@@ -496,8 +504,20 @@ class PeerMessageQueue {
   // Callback when a REPLICATE message has finished appending to the local log.
   void LocalPeerAppendFinished(const OpId& id, const Status& status);
 
+  // Starts prefetch of operations starting from 'missing_op_index' into the log cache, for the
+  // specified peer.
+  void StartLogPrefetch(const std::string& uuid, int64_t missing_op_index);
+
+  // Callback when log cache prefetch has finished, wakes up peers that were waiting for it.
+  void LogPrefetchFinished();
+
   void NumSSTFilesChanged();
 
+  // Returns the follower that the peer with the specified uuid should be remotely bootstrapped
+  // from, or nullptr if the local peer should be the source.
+  const RaftPeerPB* FindRemoteBootstrapSourceUnlocked(const std::string& uuid)
+      REQUIRES(queue_lock_);
+
   // Updates op id replicated on each node.
   void UpdateAllReplicatedOpId(OpId* result) REQUIRES(queue_lock_);
 
@@ -526,13 +546,18 @@ class PeerMessageQueue {
     int64_t to_index,
     size_t max_batch_size,
     const std::string& peer_uuid,
-    const CoarseTimePoint deadline = CoarseTimePoint::max());
+    const CoarseTimePoint deadline = CoarseTimePoint::max(),
+    ReadFromDisk read_from_disk = ReadFromDisk::kTrue);
 
   std::vector<PeerMessageQueueObserver*> observers_;
 
   // The pool token which executes observer notifications.
   std::unique_ptr<ThreadPoolToken> raft_pool_observers_token_;
 
+  // The pool token which reads operations missing in the log cache for lagging peers in
+  // background. When it is not set, such operations are read while preparing the request.
+  std::unique_ptr<ThreadPoolToken> log_prefetch_token_;
+
   // PB containing identifying information about the local peer.
   const RaftPeerPB local_peer_pb_;
   const yb::PeerId local_peer_uuid_;
@@ -617,6 +642,10 @@ class PeerMessageQueueObserver {
 
   virtual void MajorityReplicatedNumSSTFilesChanged(uint64_t majority_replicated_num_sst_files) = 0;
 
+  // Notify Consensus that operations for lagging peers were prefetched into the log cache, so
+  // requests should be sent to such peers.
+  virtual void NotifyLogPrefetched() = 0;
+
   virtual ~PeerMessageQueueObserver() {}
 };
 
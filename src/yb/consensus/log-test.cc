@@ -57,8 +57,10 @@ DEFINE_int32(num_batches, 10000,
              "Number of batches to write to/read from the Log in TestWriteManyBatches");
 
 DECLARE_int32(log_min_segments_to_retain);
+DECLARE_int32(log_max_recycled_segments);
 DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
+DECLARE_string(log_compression_codec);
 DECLARE_int32(o_direct_block_alignment_bytes);
 DECLARE_int32(o_direct_block_size_bytes);
 
@@ -235,6 +237,57 @@ TEST_F(LogTest, TestFsync) {
   ASSERT_OK(log_->Close());
 }
 
+TEST_F(LogTest, TestCompression) {
+  FLAGS_log_compression_codec = "lz4";
+  BuildLog();
+
+  const std::string kCompressibleValue(4_KB, 'x');
+  OpIdPB opid = MakeOpId(1, 1);
+  AppendReplicateBatch(opid, opid, { TupleForAppend(1, 0, kCompressibleValue) });
+  ASSERT_OK(AppendNoOp(&opid));
+  ASSERT_OK(log_->AllocateSegmentAndRollOver());
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(LZ4_LOG_COMPRESSION, segments[0]->header().compression_codec());
+  // Compressed batch should be much smaller than the value it contains.
+  ASSERT_LT(segments[0]->readable_up_to(), static_cast<int64_t>(kCompressibleValue.size()));
+
+  auto read_entries = segments[0]->ReadEntries();
+  ASSERT_OK(read_entries.status);
+  ASSERT_EQ(2, read_entries.entries.size());
+  const auto& write_batch = read_entries.entries[0]->replicate().write().write_batch();
+  ASSERT_EQ(2, write_batch.write_pairs_size());
+  ASSERT_GE(write_batch.write_pairs(1).value().size(), kCompressibleValue.size());
+
+  ASSERT_OK(log_->Close());
+}
+
+TEST_F(LogTest, TestCompressEntryBatch) {
+  Random rng(SeedRandom());
+  const std::string compressible(1_KB, 'x');
+  std::string incompressible;
+  for (size_t i = 0; i != 1_KB; ++i) {
+    incompressible.push_back(static_cast<char>(rng.Next()));
+  }
+  std::vector<LogCompressionCodecPB> codecs = { NO_LOG_COMPRESSION, LZ4_LOG_COMPRESSION };
+#if defined(ZSTD)
+  codecs.push_back(ZSTD_LOG_COMPRESSION);
+#endif
+  for (auto codec : codecs) {
+    for (const auto& data : { compressible, incompressible, std::string() }) {
+      faststring compressed_buf;
+      auto compressed = CompressEntryBatch(codec, data, &compressed_buf);
+      // Incompressible data is stored as is, with only the batch codec byte added.
+      ASSERT_LE(compressed.size(), data.size() + (codec == NO_LOG_COMPRESSION ? 0 : 1));
+      faststring uncompressed_buf;
+      auto uncompressed = ASSERT_RESULT(UncompressEntryBatch(
+          codec, compressed, &uncompressed_buf));
+      ASSERT_EQ(data, uncompressed.ToBuffer()) << LogCompressionCodecPB_Name(codec);
+    }
+  }
+}
+
 // Tests interval for durable wal write
 TEST_F(LogTest, TestFsyncInterval) {
   options_.interval_durable_wal_write = MonoDelta::FromMilliseconds(1);
@@ -679,6 +732,63 @@ TEST_F(LogTest, TestGCWithLogRunning) {
   }
 }
 
+// Test that files of GC'd segments are reused by new segments, and that entries of the GC'd
+// segments are not visible in the reused file.
+TEST_F(LogTest, TestRecycleGCedSegments) {
+  FLAGS_log_max_recycled_segments = 1;
+  BuildLog();
+
+  vector<LogAnchor*> anchors;
+  ElementDeleter deleter(&anchors);
+
+  const int kNumTotalSegments = 4;
+  const int kNumOpsPerSegment = 5;
+  int num_gced_segments;
+  OpIdPB op_id = MakeOpId(1, 1);
+  int64_t anchored_index = -1;
+
+  ASSERT_OK(AppendMultiSegmentSequence(kNumTotalSegments, kNumOpsPerSegment,
+                                       &op_id, &anchors));
+  ASSERT_OK(log_anchor_registry_->Unregister(anchors[0]));
+  ASSERT_OK(log_anchor_registry_->Unregister(anchors[1]));
+  ASSERT_OK(log_anchor_registry_->GetEarliestRegisteredLogIndex(&anchored_index));
+  ASSERT_OK(log_->GC(anchored_index, &num_gced_segments));
+  ASSERT_EQ(2, num_gced_segments);
+
+  // Only one of the GC'd segments is kept, the other one is deleted.
+  ASSERT_EQ(1, log_->TEST_num_recycled_segments());
+  CheckRightNumberOfSegmentFiles(2);
+
+  // The next segment reuses the recycled file.
+  ASSERT_OK(RollLog());
+  ASSERT_EQ(0, log_->TEST_num_recycled_segments());
+  CreateAndRegisterNewAnchor(op_id.index(), &anchors);
+  ASSERT_OK(AppendNoOps(&op_id, kNumOpsPerSegment));
+  ASSERT_OK(log_->Close());
+  CheckRightNumberOfSegmentFiles(3);
+
+  // Reopen the log and check that all retained entries are read back, and nothing else.
+  BuildLog();
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(4, segments.size()) << DumpSegmentsToString(segments);
+  const int64_t last_index = op_id.index() - 1;
+  ReplicateMsgs repls;
+  int64_t starting_op_segment_seq_num;
+  yb::SchemaPB schema;
+  uint32_t schema_version;
+  ASSERT_OK(log_->GetLogReader()->ReadReplicatesInRange(
+      anchored_index, last_index, LogReader::kNoSizeLimit, &repls, &starting_op_segment_seq_num,
+      &schema, &schema_version));
+  ASSERT_EQ(last_index - anchored_index + 1, static_cast<int64_t>(repls.size()));
+  ASSERT_EQ(last_index, repls.back()->id().index());
+  ASSERT_OK(log_->Close());
+
+  for (size_t i = 2; i < anchors.size(); i++) {
+    ASSERT_OK(log_anchor_registry_->Unregister(anchors[i]));
+  }
+}
+
 // Test that, when we are set to retain a given number of log segments,
 // we also retain any relevant log index chunks, even if those operations
 // are not necessary for recovery.
@@ -90,6 +90,7 @@
 #include "yb/util/trace.h"
 #include "yb/util/tsan_util.h"
 #include "yb/util/unique_lock.h"
+#include "yb/util/wait_state.h"
 
 using namespace yb::size_literals;  // NOLINT.
 using namespace std::literals;  // NOLINT.
@@ -115,6 +116,15 @@ DEFINE_int32(log_min_seconds_to_retain, 900,
 TAG_FLAG(log_min_seconds_to_retain, runtime);
 TAG_FLAG(log_min_seconds_to_retain, advanced);
 
+DEFINE_int32(log_max_recycled_segments, 0,
+             "The maximum number of GC'd log segment files per tablet that are kept to be reused "
+             "by new segments, instead of being deleted. A reused file is overwritten with zeros "
+             "in the background before it becomes active, so appends never write to unallocated "
+             "or uninitialized blocks. Has no effect when log_preallocate_segments is off or "
+             "the WAL is encrypted.");
+TAG_FLAG(log_max_recycled_segments, runtime);
+TAG_FLAG(log_max_recycled_segments, advanced);
+
 // Flags for controlling kernel watchdog limits.
 DEFINE_int32(consensus_log_scoped_watch_delay_callback_threshold_ms, 1000,
              "If calling consensus log callback(s) take longer than this, the kernel watchdog "
@@ -191,6 +201,10 @@ static bool dummy = google::RegisterFlagValidator(
 
 static std::string kSegmentPlaceholderFilePrefix = ".tmp.newsegment";
 static std::string kSegmentPlaceholderFileTemplate = kSegmentPlaceholderFilePrefix + "XXXXXX";
+// Recycled segments share the placeholder prefix, so they are not copied with the log.
+static std::string kSegmentRecycledFilePrefix = kSegmentPlaceholderFilePrefix + ".recycled-";
+
+constexpr size_t kRecycledSegmentZeroFillChunkSize = 1_MB;
 
 namespace yb {
 namespace log {
@@ -623,6 +637,8 @@ Status Log::Init() {
 
   }
 
+  RETURN_NOT_OK(LoadRecycledSegments());
+
   if (durable_wal_write_) {
     YB_LOG_FIRST_N(INFO, 1) << "durable_wal_write is turned on.";
   } else if (interval_durable_wal_write_) {
@@ -965,6 +981,7 @@ Status Log::Sync() {
       periodic_sync_needed_.store(false);
       periodic_sync_unsynced_bytes_ = 0;
       LOG_SLOW_EXECUTION(WARNING, 50, "Fsync log took a long time") {
+        ScopedWaitEvent wait_event(WaitEvent::kWalSync);
         RETURN_NOT_OK(active_segment_->Sync());
       }
     }
@@ -1169,10 +1186,17 @@ Status Log::GC(int64_t min_op_idx, int32_t* num_gced) {
     // Now that they are no longer referenced by the Log, delete the files.
     *num_gced = 0;
     for (const scoped_refptr<ReadableLogSegment>& segment : segments_to_delete) {
-      LOG_WITH_PREFIX(INFO) << "Deleting log segment in path: " << segment->path()
-                            << " (GCed ops < " << segment->footer().max_replicate_index() + 1
-                            << ")";
-      RETURN_NOT_OK(get_env()->DeleteFile(segment->path()));
+      // The file of a segment that is still referenced could be read, so it is not reused.
+      if (segment->HasOneRef() && RecycleSegment(*segment)) {
+        LOG_WITH_PREFIX(INFO) << "Recycled log segment in path: " << segment->path()
+                              << " (GCed ops < " << segment->footer().max_replicate_index() + 1
+                              << ")";
+      } else {
+        LOG_WITH_PREFIX(INFO) << "Deleting log segment in path: " << segment->path()
+                              << " (GCed ops < " << segment->footer().max_replicate_index() + 1
+                              << ")";
+        RETURN_NOT_OK(get_env()->DeleteFile(segment->path()));
+      }
       (*num_gced)++;
 
       if (metrics_) {
@@ -1423,13 +1447,32 @@ Status Log::PreAllocateNewSegment() {
   // We always want to sync on close: https://github.com/yugabyte/yugabyte-db/issues/3490
   opts.sync_on_close = true;
   opts.o_direct = durable_wal_write_;
+
+  std::string recycled_path;
+  {
+    std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+    if (!recycled_segments_.empty()) {
+      recycled_path = std::move(recycled_segments_.back());
+      recycled_segments_.pop_back();
+    }
+  }
+  if (!recycled_path.empty()) {
+    auto status = ReuseRecycledSegment(opts, recycled_path);
+    if (status.ok()) {
+      allocation_state_.store(
+          SegmentAllocationState::kAllocationFinished, std::memory_order_release);
+      return Status::OK();
+    }
+    LOG_WITH_PREFIX(WARNING) << "Failed to reuse recycled segment " << recycled_path << ": "
+                             << status;
+    WARN_NOT_OK(get_env()->DeleteFile(recycled_path), "Failed to delete recycled segment");
+  }
+
   RETURN_NOT_OK(CreatePlaceholderSegment(opts, &next_segment_path_, &next_segment_file_));
 
   if (options_.preallocate_segments) {
     uint64_t next_segment_size = NextSegmentDesiredSize();
     TRACE("Preallocating $0 byte segment in $1", next_segment_size, next_segment_path_);
-    // TODO (perf) zero the new segments -- this could result in additional performance
-    // improvements.
     RETURN_NOT_OK(next_segment_file_->PreAllocate(next_segment_size));
   }
 
@@ -1437,6 +1480,93 @@ Status Log::PreAllocateNewSegment() {
   return Status::OK();
 }
 
+Status Log::ReuseRecycledSegment(const WritableFileOptions& opts, const std::string& path) {
+  // The whole file is overwritten, so no entry of the GC'd segment is left after the zeros.
+  const uint64_t file_size = VERIFY_RESULT(get_env()->GetFileSize(path));
+  const uint64_t zero_fill_size = std::max(NextSegmentDesiredSize(), file_size);
+  TRACE("Zeroing $0 bytes of recycled segment $1", zero_fill_size, path);
+
+  WritableFileOptions reuse_opts = opts;
+  reuse_opts.mode = Env::OPEN_EXISTING;
+  reuse_opts.overwrite_existing = true;
+  {
+    std::unique_ptr<WritableFile> file;
+    RETURN_NOT_OK(get_env()->NewWritableFile(reuse_opts, path, &file));
+    const std::string zeros(kRecycledSegmentZeroFillChunkSize, '\0');
+    for (uint64_t written = 0; written < zero_fill_size;) {
+      const auto chunk_size = std::min<uint64_t>(zeros.size(), zero_fill_size - written);
+      RETURN_NOT_OK(file->Append(Slice(zeros.data(), chunk_size)));
+      written += chunk_size;
+    }
+    // Zeros are synced on close, before the file could become the active segment.
+    RETURN_NOT_OK(file->Close());
+  }
+
+  std::unique_ptr<WritableFile> file;
+  RETURN_NOT_OK(get_env()->NewWritableFile(reuse_opts, path, &file));
+  // Blocks are already allocated, so it is cheap. It lets Close() truncate the unused tail.
+  RETURN_NOT_OK(file->PreAllocate(zero_fill_size));
+  next_segment_path_ = path;
+  next_segment_file_.reset(file.release());
+  VLOG_WITH_PREFIX(1) << "Reused recycled segment as next WAL segment, path: " << path;
+  return Status::OK();
+}
+
+bool Log::RecycleSegment(const ReadableLogSegment& segment) {
+  const auto max_recycled_segments = FLAGS_log_max_recycled_segments;
+  if (max_recycled_segments <= 0 || !options_.preallocate_segments ||
+      get_env()->IsEncrypted()) {
+    return false;
+  }
+  // A hard linked file is shared with another log, e.g. with a child tablet after split.
+  auto link_count = get_env()->GetFileLinkCount(segment.path());
+  if (!link_count.ok() || *link_count != 1) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+  if (recycled_segments_.size() >= static_cast<size_t>(max_recycled_segments)) {
+    return false;
+  }
+  auto path = JoinPathSegments(
+      wal_dir_, kSegmentRecycledFilePrefix + std::to_string(segment.header().sequence_number()));
+  auto status = get_env()->RenameFile(segment.path(), path);
+  if (!status.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to recycle log segment " << segment.path() << ": "
+                             << status;
+    return false;
+  }
+  recycled_segments_.push_back(std::move(path));
+  return true;
+}
+
+Status Log::LoadRecycledSegments() {
+  const auto files = VERIFY_RESULT(get_env()->GetChildren(wal_dir_, ExcludeDots::kTrue));
+  size_t max_recycled_segments = 0;
+  if (options_.preallocate_segments && !get_env()->IsEncrypted()) {
+    max_recycled_segments = std::max(FLAGS_log_max_recycled_segments, 0);
+  }
+
+  std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+  for (const auto& file : files) {
+    if (!boost::starts_with(file, kSegmentRecycledFilePrefix)) {
+      continue;
+    }
+    auto path = JoinPathSegments(wal_dir_, file);
+    if (recycled_segments_.size() < max_recycled_segments) {
+      recycled_segments_.push_back(std::move(path));
+    } else {
+      RETURN_NOT_OK(get_env()->DeleteFile(path));
+    }
+  }
+  return Status::OK();
+}
+
+size_t Log::TEST_num_recycled_segments() const {
+  std::lock_guard<std::mutex> lock(recycled_segments_mutex_);
+  return recycled_segments_.size();
+}
+
 Status Log::SwitchToAllocatedSegment() {
   CHECK_EQ(allocation_state(), SegmentAllocationState::kAllocationFinished);
 
@@ -1466,6 +1596,7 @@ Status Log::SwitchToAllocatedSegment() {
   header.set_minor_version(kLogMinorVersion);
   header.set_sequence_number(active_segment_sequence_number_);
   header.set_unused_tablet_id(tablet_id_);
+  header.set_compression_codec(NewSegmentCompressionCodec());
 
   // Set up the new footer. This will be maintained as the segment is written.
   footer_builder_.Clear();
@@ -1613,9 +1744,12 @@ Status LogEntryBatch::Serialize() {
   }
   DCHECK_NE(entry_batch_pb_.mono_time(), 0);
   total_size_bytes_ = entry_batch_pb_.ByteSize();
-  buffer_.reserve(total_size_bytes_);
+  buffer_.resize(total_size_bytes_);
 
-  pb_util::AppendToString(entry_batch_pb_, &buffer_);
+  // Sizes of all nested messages were cached by ByteSize above, so serialize with them instead of
+  // walking replicate messages of the batch again.
+  auto end = entry_batch_pb_.SerializeWithCachedSizesToArray(buffer_.data());
+  DCHECK_EQ(end - buffer_.data(), static_cast<ptrdiff_t>(total_size_bytes_));
 
   state_ = kEntrySerialized;
   return Status::OK();
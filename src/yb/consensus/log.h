@@ -277,6 +277,9 @@ class Log : public RefCountedThreadSafe<Log> {
 
   CHECKED_STATUS TEST_SubmitFuncToAppendToken(const std::function<void()>& func);
 
+  // Returns the number of GC'd segments kept for reuse.
+  size_t TEST_num_recycled_segments() const;
+
   // Returns the number of segments.
   size_t num_segments() const;
 
@@ -367,6 +370,18 @@ class Log : public RefCountedThreadSafe<Log> {
   // Preallocates the space for a new segment.
   CHECKED_STATUS PreAllocateNewSegment();
 
+  // Prepares the recycled segment file at 'path' to be used as the next segment. Its contents
+  // are overwritten with zeros, so entries of the GC'd segment could not be read after a crash,
+  // and all blocks of the file are initialized before the first append.
+  CHECKED_STATUS ReuseRecycledSegment(const WritableFileOptions& opts, const std::string& path);
+
+  // Renames the GC'd segment to a recycled segment placeholder, so its file could be reused by
+  // the next segment allocation. Returns false if the segment file should be deleted instead.
+  bool RecycleSegment(const ReadableLogSegment& segment);
+
+  // Picks up recycled segments left by the previous run, deleting the ones above the limit.
+  CHECKED_STATUS LoadRecycledSegments();
+
   // Returns the desired size for the next log segment to be created.
   uint64_t NextSegmentDesiredSize();
 
@@ -439,6 +454,10 @@ class Log : public RefCountedThreadSafe<Log> {
   // The path for the next allocated segment.
   std::string next_segment_path_;
 
+  // Files of GC'd segments that are reused by the next segment allocations.
+  mutable std::mutex recycled_segments_mutex_;
+  std::vector<std::string> recycled_segments_ GUARDED_BY(recycled_segments_mutex_);
+
   // Lock to protect mutations to log_state_ and other shared state variables.
   mutable percpu_rwlock state_lock_;
 
@@ -52,6 +52,7 @@
 
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
@@ -430,5 +431,33 @@ TEST_F(LogCacheTest, TestMTReadAndWrite) {
   ASSERT_GT(num_appended, 0);
 }
 
+TEST_F(LogCacheTest, Prefetch) {
+  constexpr int kNumPrefetchMessages = 10;
+  ASSERT_OK(AppendReplicateMessagesToCache(1, kNumPrefetchMessages));
+  ASSERT_OK(log_->WaitUntilAllFlushed());
+  cache_->EvictThroughOp(kNumPrefetchMessages);
+  ASSERT_EQ(0, cache_->num_cached_ops());
+
+  auto read_result = ASSERT_RESULT(cache_->ReadOps(
+      0, 0 /* to_op_index */, 8_MB, CoarseTimePoint::max(), ReadFromDisk::kFalse));
+  ASSERT_TRUE(read_result.messages.empty());
+  ASSERT_EQ(1, read_result.missing_op_index);
+  ASSERT_TRUE(read_result.have_more_messages);
+
+  std::unique_ptr<ThreadPool> prefetch_pool;
+  ASSERT_OK(ThreadPoolBuilder("prefetch").Build(&prefetch_pool));
+  auto token = prefetch_pool->NewToken(ThreadPool::ExecutionMode::SERIAL);
+  CountDownLatch latch(1);
+  ASSERT_TRUE(ASSERT_RESULT(cache_->Prefetch(0, token.get(), [&latch] { latch.CountDown(); })));
+  latch.Wait();
+  ASSERT_EQ(kNumPrefetchMessages, cache_->metrics_.prefetched_ops->value());
+
+  read_result = ASSERT_RESULT(cache_->ReadOps(
+      0, 0 /* to_op_index */, 8_MB, CoarseTimePoint::max(), ReadFromDisk::kFalse));
+  ASSERT_EQ(kNumPrefetchMessages, read_result.messages.size());
+  ASSERT_EQ(0, read_result.missing_op_index);
+  ASSERT_EQ(OpIdStrForIndex(1), OpIdToString(read_result.messages[0]->id()));
+}
+
 } // namespace consensus
 } // namespace yb
@@ -46,6 +46,7 @@
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/locks.h"
@@ -56,6 +57,7 @@
 #include "yb/util/result.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
+#include "yb/util/threadpool.h"
 
 using namespace std::literals;
 
@@ -76,6 +78,12 @@ DEFINE_int32(global_log_cache_size_limit_percentage, 5,
              "entries across all tablets. Default is 5.");
 TAG_FLAG(global_log_cache_size_limit_percentage, advanced);
 
+DEFINE_int32(log_cache_prefetch_size_mb, 16,
+             "Max size of operations read from disk by a single log cache prefetch for lagging "
+             "peers.");
+TAG_FLAG(log_cache_prefetch_size_mb, advanced);
+TAG_FLAG(log_cache_prefetch_size_mb, runtime);
+
 DEFINE_test_flag(bool, log_cache_skip_eviction, false,
                  "Don't evict log entries in tests.");
 
@@ -90,6 +98,9 @@ METRIC_DEFINE_gauge_int64(tablet, log_cache_size, "Log Cache Memory Usage",
 METRIC_DEFINE_counter(tablet, log_cache_disk_reads, "Log Cache Disk Reads",
                       yb::MetricUnit::kEntries,
                       "Amount of operations read from disk.");
+METRIC_DEFINE_counter(tablet, log_cache_prefetched_ops, "Log Cache Prefetched Operations",
+                      yb::MetricUnit::kEntries,
+                      "Amount of operations read from disk into the log cache in background.");
 
 DECLARE_bool(get_changes_honor_deadline);
 
@@ -185,6 +196,7 @@ LogCache::PrepareAppendResult LogCache::PrepareAppendOperations(const ReplicateM
     // If the index is not consecutive then it must be lower than or equal to the last index, i.e.
     // we're overwriting.
     CHECK_LE(first_idx_in_batch, next_sequential_op_index_);
+    ++overwrite_generation_;
 
     // Now remove the overwritten operations.
     for (int64_t i = first_idx_in_batch; i < next_sequential_op_index_; ++i) {
@@ -297,7 +309,8 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index, size_t max_size_
 Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
                                         int64_t to_op_index,
                                         size_t max_size_bytes,
-                                        CoarseTimePoint deadline) {
+                                        CoarseTimePoint deadline,
+                                        ReadFromDisk read_from_disk) {
   DCHECK_GE(after_op_index, 0);
 
   VLOG_WITH_PREFIX_UNLOCKED(4) << "ReadOps, after_op_index: " << after_op_index
@@ -329,6 +342,10 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
     // If the messages the peer needs haven't been loaded into the queue yet, load them.
     MessageCache::const_iterator iter = cache_.lower_bound(next_index);
     if (iter == cache_.end() || iter->first != next_index) {
+      if (!read_from_disk) {
+        result.missing_op_index = next_index;
+        break;
+      }
       int64_t up_to;
       if (iter == cache_.end()) {
         // Read all the way to the current op.
@@ -415,10 +432,98 @@ Result<ReadOpsResult> LogCache::ReadOps(int64_t after_op_index,
       }
     }
   }
-  result.have_more_messages = HaveMoreMessages(remaining_space < 0);
+  result.have_more_messages = HaveMoreMessages(
+      remaining_space < 0 || result.missing_op_index != 0);
   return result;
 }
 
+Result<bool> LogCache::Prefetch(
+    int64_t after_op_index, ThreadPoolToken* token, std::function<void()> callback) {
+  int64_t overwrite_generation;
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    if (prefetch_in_progress_) {
+      return false;
+    }
+    prefetch_in_progress_ = true;
+    overwrite_generation = overwrite_generation_;
+  }
+
+  auto status = token->SubmitFunc(
+      [this, after_op_index, overwrite_generation, callback = std::move(callback)] {
+    DoPrefetch(after_op_index, overwrite_generation);
+    callback();
+  });
+  if (!status.ok()) {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    prefetch_in_progress_ = false;
+    return status;
+  }
+  return true;
+}
+
+void LogCache::DoPrefetch(int64_t after_op_index, int64_t overwrite_generation) {
+  int64_t up_to;
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    // Read up to the next entry that's in the cache or the last written op.
+    up_to = next_sequential_op_index_ - 1;
+    auto it = cache_.upper_bound(after_op_index);
+    if (it != cache_.end()) {
+      up_to = std::min(up_to, it->first - 1);
+    }
+  }
+
+  ReplicateMsgs msgs;
+  if (up_to > after_op_index) {
+    int64_t starting_op_segment_seq_num;
+    SchemaPB schema;
+    uint32_t schema_version;
+    auto status = log_->GetLogReader()->ReadReplicatesInRange(
+        after_op_index + 1, up_to, GetAtomicFlag(&FLAGS_log_cache_prefetch_size_mb) * 1_MB, &msgs,
+        &starting_op_segment_seq_num, &schema, &schema_version);
+    if (!status.ok()) {
+      LOG_WITH_PREFIX_UNLOCKED(WARNING)
+          << "Failed to prefetch ops " << after_op_index + 1 << ".." << up_to << ": " << status;
+      msgs.clear();
+    }
+  }
+
+  // SpaceUsed is relatively expensive, so do calculations outside the lock
+  std::vector<CacheEntry> entries;
+  entries.reserve(msgs.size());
+  for (const auto& msg : msgs) {
+    entries.push_back(CacheEntry { msg, static_cast<int64_t>(msg->SpaceUsedLong()), true });
+  }
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  prefetch_in_progress_ = false;
+  metrics_.disk_reads->IncrementBy(msgs.size());
+  if (overwrite_generation != overwrite_generation_) {
+    VLOG_WITH_PREFIX_UNLOCKED(1) << "Ops were overwritten during prefetch, dropping prefetched ops";
+    return;
+  }
+
+  size_t num_added = 0;
+  for (auto& entry : entries) {
+    auto index = entry.msg->id().index();
+    if (index >= next_sequential_op_index_ || cache_.count(index)) {
+      break;
+    }
+    // Prefetched ops should not cause eviction of other ops, so stop at the memory limit.
+    if (!tracker_->TryConsume(entry.mem_usage)) {
+      break;
+    }
+    metrics_.size->IncrementBy(entry.mem_usage);
+    metrics_.num_ops->Increment();
+    cache_.emplace(index, std::move(entry));
+    ++num_added;
+  }
+  metrics_.prefetched_ops->IncrementBy(num_added);
+  VLOG_WITH_PREFIX_UNLOCKED(1)
+      << "Prefetched " << num_added << " of " << msgs.size() << " ops after " << after_op_index;
+}
+
 size_t LogCache::EvictThroughOp(int64_t index, int64_t bytes_to_evict) {
   std::lock_guard<simple_spinlock> lock(lock_);
   return EvictSomeUnlocked(index, bytes_to_evict);
@@ -615,7 +720,8 @@ int64_t LogCache::num_cached_ops() const {
 LogCache::Metrics::Metrics(const scoped_refptr<MetricEntity>& metric_entity)
   : INSTANTIATE_METRIC(num_ops, 0),
     INSTANTIATE_METRIC(size, 0),
-    INSTANTIATE_METRIC(disk_reads) {
+    INSTANTIATE_METRIC(disk_reads),
+    INSTANTIATE_METRIC(prefetched_ops) {
 }
 #undef INSTANTIATE_METRIC
 
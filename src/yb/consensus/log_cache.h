@@ -37,6 +37,7 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -63,12 +64,14 @@
 #include "yb/util/status_callback.h"
 
 YB_STRONGLY_TYPED_BOOL(HaveMoreMessages);
+YB_STRONGLY_TYPED_BOOL(ReadFromDisk);
 
 namespace yb {
 
 class MetricEntity;
 class MemTracker;
 class OpIdPB;
+class ThreadPoolToken;
 
 namespace consensus {
 
@@ -81,6 +84,9 @@ struct ReadOpsResult {
   uint32_t header_schema_version;
   HaveMoreMessages have_more_messages = HaveMoreMessages::kFalse;
   int64_t read_from_disk_size = 0;
+  // Index of the first operation that was not read because it is missing in the cache, and reading
+  // from disk was not allowed. 0 if there is no such operation.
+  int64_t missing_op_index = 0;
 };
 
 // Write-through cache for the log.
@@ -126,10 +132,24 @@ class LogCache {
   // until 'to_op_index' (inclusive).
   //
   // If 'to_op_index' is 0, then all operations after 'after_op_index' will be included.
+  //
+  // If 'read_from_disk' is false, reading stops at the first operation that is missing in the
+  // cache, and its index is returned in missing_op_index.
   Result<ReadOpsResult> ReadOps(int64_t after_op_index,
                                 int64_t to_op_index,
                                 size_t max_size_bytes,
-                                CoarseTimePoint deadline = CoarseTimePoint::max());
+                                CoarseTimePoint deadline = CoarseTimePoint::max(),
+                                ReadFromDisk read_from_disk = ReadFromDisk::kTrue);
+
+  // Asynchronously reads operations following 'after_op_index' from disk into the cache, using
+  // 'token', so following ReadOps calls could get them without disk I/O. At most
+  // log_cache_prefetch_size_mb of operations are read, and prefetched operations are accounted
+  // for in the cache memory limit.
+  //
+  // Returns true if prefetch was started, in this case 'callback' is invoked when it finishes.
+  // Returns false if another prefetch is in progress.
+  Result<bool> Prefetch(
+      int64_t after_op_index, ThreadPoolToken* token, std::function<void()> callback);
 
   // Append the operations into the log and the cache.  When the messages have completed writing
   // into the on-disk log, fires 'callback'.
@@ -189,6 +209,7 @@ class LogCache {
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimitMB);
   FRIEND_TEST(LogCacheTest, TestGlobalMemoryLimitPercentage);
   FRIEND_TEST(LogCacheTest, TestReplaceMessages);
+  FRIEND_TEST(LogCacheTest, Prefetch);
   friend class LogCacheTest;
 
   // An entry in the cache.
@@ -231,6 +252,8 @@ class LogCache {
 
   PrepareAppendResult PrepareAppendOperations(const ReplicateMsgs& msgs);
 
+  void DoPrefetch(int64_t after_op_index, int64_t overwrite_generation);
+
   log::LogPtr const log_;
 
   // The UUID of the local peer.
@@ -257,6 +280,13 @@ class LogCache {
   // log.  Protected by lock_.
   int64_t min_pinned_op_index_;
 
+  // Incremented each time operations are overwritten, so results of prefetch that was started
+  // before the overwrite are not added to the cache. Protected by lock_.
+  int64_t overwrite_generation_ = 0;
+
+  // Whether prefetch is in progress. Protected by lock_.
+  bool prefetch_in_progress_ = false;
+
   // Pointer to a parent memtracker for all log caches. This exists to compute server-wide cache
   // size and enforce a server-wide memory limit.  When the first instance of a log cache is
   // created, a new entry is added to MemTracker's static map; subsequent entries merely increment
@@ -277,6 +307,8 @@ class LogCache {
     scoped_refptr<AtomicGauge<int64_t>> size;
 
     scoped_refptr<Counter> disk_reads;
+
+    scoped_refptr<Counter> prefetched_ops;
   };
   Metrics metrics_;
 
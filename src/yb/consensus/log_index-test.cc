@@ -93,6 +93,35 @@ TEST_F(LogIndexTest, TestBasic) {
   VerifyEntry(MakeOpId(5, 1), 1, 50000);
 }
 
+TEST_F(LogIndexTest, TestGetEntries) {
+  // Entries span the boundary of index chunks.
+  constexpr int64_t kFirstIndex = 999998;
+  constexpr int64_t kNumEntries = 4;
+  for (int64_t index = kFirstIndex; index != kFirstIndex + kNumEntries; ++index) {
+    ASSERT_OK(AddEntry(MakeOpId(1, index), 1, index * 10));
+  }
+
+  std::vector<LogIndexEntry> entries;
+  // Reading stops at the first missing entry.
+  ASSERT_OK(index_->GetEntries(kFirstIndex, kFirstIndex + kNumEntries + 10, &entries));
+  ASSERT_EQ(kNumEntries, entries.size());
+  for (int64_t i = 0; i != kNumEntries; ++i) {
+    ASSERT_EQ(yb::OpId(1, kFirstIndex + i), entries[i].op_id);
+    ASSERT_EQ(1, entries[i].segment_sequence_number);
+    ASSERT_EQ((kFirstIndex + i) * 10, entries[i].offset_in_segment);
+  }
+
+  entries.clear();
+  ASSERT_OK(index_->GetEntries(kFirstIndex + 1, kFirstIndex + 2, &entries));
+  ASSERT_EQ(2, entries.size());
+  ASSERT_EQ(kFirstIndex + 2, entries.back().op_id.index);
+
+  entries.clear();
+  auto status = index_->GetEntries(kFirstIndex - 1, kFirstIndex + 1, &entries);
+  ASSERT_TRUE(status.IsNotFound()) << status;
+  ASSERT_TRUE(entries.empty());
+}
+
 // This test relies on kEntriesPerIndexChunk being 1000000, and that's no longer
 // the case after D1719 (2fe27d886390038bc734ea28638a1b1435e7d0d4) on Mac.
 #if !defined(__APPLE__)
@@ -46,6 +46,7 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -277,6 +278,41 @@ Status LogIndex::GetEntry(int64_t index, LogIndexEntry* entry) {
   return Status::OK();
 }
 
+Status LogIndex::GetEntries(
+    int64_t start_index, int64_t end_index, std::vector<LogIndexEntry>* entries) {
+  int64_t index = start_index;
+  while (index <= end_index) {
+    scoped_refptr<IndexChunk> chunk;
+    auto status = GetChunkForIndex(index, false /* do not create */, &chunk);
+    if (!status.ok()) {
+      if (index == start_index) {
+        return status;
+      }
+      break;
+    }
+    // Read all requested entries of this chunk under a single lock.
+    auto chunk_end = std::min(end_index + 1, (index / kEntriesPerIndexChunk + 1) *
+                                             kEntriesPerIndexChunk);
+    std::lock_guard<simple_spinlock> l(open_chunks_lock_);
+    for (; index != chunk_end; ++index) {
+      PhysicalEntry phys;
+      chunk->GetEntry(index % kEntriesPerIndexChunk, &phys);
+      if (phys.offset_in_segment == 0) {
+        if (index == start_index) {
+          return STATUS(NotFound, "entry not found");
+        }
+        return Status::OK();
+      }
+      entries->emplace_back();
+      auto& entry = entries->back();
+      entry.op_id = yb::OpId(phys.term, index);
+      entry.segment_sequence_number = phys.segment_sequence_number;
+      entry.offset_in_segment = phys.offset_in_segment;
+    }
+  }
+  return Status::OK();
+}
+
 void LogIndex::GC(int64_t min_index_to_retain) {
   auto min_chunk_to_retain = min_index_to_retain / kEntriesPerIndexChunk;
 
@@ -34,6 +34,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "yb/gutil/macros.h"
 #include "yb/gutil/ref_counted.h"
@@ -83,6 +84,12 @@ class LogIndex : public RefCountedThreadSafe<LogIndex> {
   // Returns NotFound() if the given log entry was never written.
   CHECKED_STATUS GetEntry(int64_t index, LogIndexEntry* entry);
 
+  // Retrieve existing entries for indexes in range [start_index, end_index], appending them to
+  // 'entries'. Stops at the first entry that was never written.
+  // Returns NotFound() if the entry for start_index was never written.
+  CHECKED_STATUS GetEntries(
+      int64_t start_index, int64_t end_index, std::vector<LogIndexEntry>* entries);
+
   // Indicate that we no longer need to retain information about indexes lower than the
   // given index. Note that the implementation is conservative and _may_ choose to retain
   // earlier entries.
@@ -43,6 +43,7 @@
 
 #include "yb/gutil/dynamic_annotations.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/env_util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
@@ -50,6 +51,7 @@
 #include "yb/util/monotime.h"
 #include "yb/util/path_util.h"
 #include "yb/util/result.h"
+#include "yb/util/size_literals.h"
 
 DEFINE_bool(enable_log_retention_by_op_idx, true,
             "If true, logs will be retained based on an op id passed by the cdc service");
@@ -90,6 +92,13 @@ DEFINE_test_flag(int32, get_changes_read_loop_delay_ms, 0,
                  "Amount of time to sleep for between each iteration of the loop in "
                  "ReadReplicatesInRange. This is used to test the return of partial results.");
 
+DEFINE_int64(log_reader_readahead_bytes, 256_KB,
+             "When a range of ops is read from the log, the platform is asked to read ahead the "
+             "batches of each segment in the range, plus this number of bytes after the last "
+             "batch. 0 disables readahead.");
+TAG_FLAG(log_reader_readahead_bytes, advanced);
+TAG_FLAG(log_reader_readahead_bytes, runtime);
+
 namespace yb {
 namespace log {
 
@@ -393,6 +402,28 @@ Status LogReader::ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
   return Status::OK();
 }
 
+void LogReader::ReadaheadBatches(const std::vector<LogIndexEntry>& index_entries) const {
+  const auto readahead_bytes = GetAtomicFlag(&FLAGS_log_reader_readahead_bytes);
+  if (readahead_bytes <= 0 || index_entries.size() < 2) {
+    return;
+  }
+
+  size_t group_start = 0;
+  for (size_t i = 1; i <= index_entries.size(); ++i) {
+    const auto& first = index_entries[group_start];
+    if (i != index_entries.size() &&
+        index_entries[i].segment_sequence_number == first.segment_sequence_number) {
+      continue;
+    }
+    auto segment = GetSegmentBySequenceNumber(first.segment_sequence_number);
+    if (segment) {
+      auto end = index_entries[i - 1].offset_in_segment + readahead_bytes;
+      segment->readable_file()->Readahead(first.offset_in_segment, end - first.offset_in_segment);
+    }
+    group_start = i;
+  }
+}
+
 Status LogReader::ReadReplicatesInRange(
     const int64_t starting_at,
     const int64_t up_to,
@@ -419,6 +450,10 @@ Status LogReader::ReadReplicatesInRange(
   bool limit_exceeded = false;
   faststring tmp_buf;
   LogEntryBatchPB batch;
+  // Index entries are looked up in blocks, so batches of each block could be read ahead.
+  constexpr int64_t kIndexEntriesPerLookup = 128;
+  std::vector<LogIndexEntry> index_entries;
+  size_t index_entry_pos = 0;
   for (int64_t index = starting_at; index <= up_to && !limit_exceeded; index++) {
     // Stop reading if a deadline was specified and the deadline has been exceeded.
     if (deadline != CoarseTimePoint::max() && CoarseMonoClock::Now() >= deadline) {
@@ -429,9 +464,16 @@ Status LogReader::ReadReplicatesInRange(
       SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_get_changes_read_loop_delay_ms));
     }
 
-    LogIndexEntry index_entry;
-    RETURN_NOT_OK_PREPEND(log_index_->GetEntry(index, &index_entry),
-                          Substitute("Failed to read log index for op $0", index));
+    if (index_entry_pos == index_entries.size()) {
+      index_entries.clear();
+      index_entry_pos = 0;
+      RETURN_NOT_OK_PREPEND(
+          log_index_->GetEntries(
+              index, std::min(up_to, index + kIndexEntriesPerLookup - 1), &index_entries),
+          Substitute("Failed to read log index for op $0", index));
+      ReadaheadBatches(index_entries);
+    }
+    const LogIndexEntry index_entry = index_entries[index_entry_pos++];
 
     if (index == starting_at && starting_op_segment_seq_num != nullptr) {
       *starting_op_segment_seq_num = index_entry.segment_sequence_number;
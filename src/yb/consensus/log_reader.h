@@ -190,6 +190,10 @@ class LogReader {
                                           faststring* tmp_buf,
                                           LogEntryBatchPB* batch) const;
 
+  // Asks the platform to read ahead batches pointed to by the provided index entries, so
+  // following reads of a contiguous range of ops do not wait for the device one batch at a time.
+  void ReadaheadBatches(const std::vector<LogIndexEntry>& index_entries) const;
+
   LogReader(Env* env, const scoped_refptr<LogIndex>& index,
             std::string log_prefix,
             const scoped_refptr<MetricEntity>& table_metric_entity,
@@ -37,8 +37,17 @@
 #include <limits>
 #include <utility>
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <glog/logging.h>
 
+#if defined(LZ4)
+#include <lz4.h>
+#endif
+
+#if defined(ZSTD)
+#include <zstd.h>
+#endif
+
 #include "yb/common/hybrid_time.h"
 
 #include "yb/consensus/opid_util.h"
@@ -49,12 +58,14 @@
 #include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/util.h"
 
+#include "yb/util/cast.h"
 #include "yb/util/coding-inl.h"
 #include "yb/util/coding.h"
 #include "yb/util/crc.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/env_util.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/result.h"
 #include "yb/util/size_literals.h"
@@ -104,6 +115,22 @@ DEFINE_bool(require_durable_wal_write, false, "Whether durable WAL write is requ
     "the system will soft downgrade the durable_wal_write flag.");
 TAG_FLAG(require_durable_wal_write, stable);
 
+DEFINE_string(log_compression_codec, "none",
+              "Codec used to compress entry batches of new WAL segments: none, lz4 or zstd. "
+              "Segments written with compression could not be read by older versions.");
+TAG_FLAG(log_compression_codec, advanced);
+
+static bool ValidateLogCompressionCodec(const char* flagname, const std::string& value) {
+  if (boost::iequals(value, "none") || boost::iequals(value, "lz4") ||
+      boost::iequals(value, "zstd")) {
+    return true;
+  }
+  LOG(ERROR) << "Invalid value for " << flagname << ": " << value;
+  return false;
+}
+static bool log_compression_codec_validator_registered = google::RegisterFlagValidator(
+    &FLAGS_log_compression_codec, &ValidateLogCompressionCodec);
+
 namespace yb {
 namespace log {
 
@@ -788,10 +815,19 @@ Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
   }
 
 
+  faststring uncompressed_buf;
+  auto entry_batch_data = UncompressEntryBatch(
+      header_.compression_codec(), entry_batch_slice, &uncompressed_buf);
+  if (!entry_batch_data.ok()) {
+    return entry_batch_data.status().CloneAndPrepend(
+        Substitute("Could not decompress entry in byte range $0-$1",
+                   *offset, *offset + header.msg_length));
+  }
+
   LogEntryBatchPB read_entry_batch;
   s = pb_util::ParseFromArray(&read_entry_batch,
-                              entry_batch_slice.data(),
-                              header.msg_length);
+                              entry_batch_data->data(),
+                              entry_batch_data->size());
 
   if (!s.ok()) return STATUS(Corruption, Substitute("Could parse PB. Cause: $0",
                                                     s.ToString()));
@@ -863,9 +899,11 @@ Status WritableLogSegment::WriteFooterAndClose(const LogSegmentFooterPB& footer)
 }
 
 
-Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
+Status WritableLogSegment::WriteEntryBatch(const Slice& entry_batch_data) {
   DCHECK(is_header_written_);
   DCHECK(!is_footer_written_);
+  Slice data = CompressEntryBatch(
+      header_.compression_codec(), entry_batch_data, &compression_buffer_);
   uint8_t header_buf[kEntryHeaderSize];
 
   // First encode the length of the message.
@@ -935,6 +973,131 @@ bool IsLogFileName(const string& fname) {
   return true;
 }
 
+LogCompressionCodecPB NewSegmentCompressionCodec() {
+  const auto& codec = FLAGS_log_compression_codec;
+  if (boost::iequals(codec, "lz4")) {
+    return LZ4_LOG_COMPRESSION;
+  }
+  if (boost::iequals(codec, "zstd")) {
+#if defined(ZSTD)
+    return ZSTD_LOG_COMPRESSION;
+#else
+    YB_LOG_EVERY_N_SECS(WARNING, 60) << "ZSTD is not supported by this build, using LZ4 for WAL";
+    return LZ4_LOG_COMPRESSION;
+#endif
+  }
+  return NO_LOG_COMPRESSION;
+}
+
+namespace {
+
+Slice StoreUncompressed(const Slice& data, faststring* buffer) {
+  buffer->clear();
+  buffer->reserve(data.size() + 1);
+  buffer->push_back(NO_LOG_COMPRESSION);
+  buffer->append(data.data(), data.size());
+  return Slice(*buffer);
+}
+
+} // namespace
+
+Slice CompressEntryBatch(LogCompressionCodecPB codec, const Slice& data, faststring* buffer) {
+  if (codec == NO_LOG_COMPRESSION) {
+    return data;
+  }
+
+  buffer->clear();
+  buffer->push_back(codec);
+  PutVarint32(buffer, narrow_cast<uint32_t>(data.size()));
+  const size_t header_size = buffer->size();
+  size_t compressed_size = 0;
+  switch (codec) {
+    case LZ4_LOG_COMPRESSION: {
+#if defined(LZ4)
+      int bound = LZ4_compressBound(narrow_cast<int>(data.size()));
+      buffer->resize(header_size + bound);
+      int res = LZ4_compress_default(
+          data.cdata(), to_char_ptr(buffer->data() + header_size), narrow_cast<int>(data.size()),
+          bound);
+      compressed_size = res > 0 ? res : 0;
+#endif
+      break;
+    }
+    case ZSTD_LOG_COMPRESSION: {
+#if defined(ZSTD)
+      size_t bound = ZSTD_compressBound(data.size());
+      buffer->resize(header_size + bound);
+      size_t res = ZSTD_compress(
+          buffer->data() + header_size, bound, data.data(), data.size(), 1 /* level */);
+      compressed_size = ZSTD_isError(res) ? 0 : res;
+#endif
+      break;
+    }
+    case NO_LOG_COMPRESSION:
+      break;
+  }
+
+  // Batch is left uncompressed if compression failed or does not save space.
+  if (compressed_size == 0 || header_size + compressed_size > data.size()) {
+    return StoreUncompressed(data, buffer);
+  }
+  buffer->resize(header_size + compressed_size);
+  return Slice(*buffer);
+}
+
+Result<Slice> UncompressEntryBatch(
+    LogCompressionCodecPB codec, const Slice& data, faststring* buffer) {
+  if (codec == NO_LOG_COMPRESSION) {
+    return data;
+  }
+
+  Slice input = data;
+  if (input.empty()) {
+    return STATUS(Corruption, "Empty compressed entry batch");
+  }
+  auto batch_codec = static_cast<uint8_t>(input.consume_byte());
+  if (batch_codec == NO_LOG_COMPRESSION) {
+    return input;
+  }
+  uint32_t uncompressed_size = 0;
+  if (!GetVarint32(&input, &uncompressed_size)) {
+    return STATUS(Corruption, "Failed to decode uncompressed size of entry batch");
+  }
+  buffer->resize(uncompressed_size);
+  switch (batch_codec) {
+    case LZ4_LOG_COMPRESSION: {
+#if defined(LZ4)
+      int res = LZ4_decompress_safe(
+          input.cdata(), to_char_ptr(buffer->data()), narrow_cast<int>(input.size()),
+          narrow_cast<int>(uncompressed_size));
+      if (res < 0 || static_cast<uint32_t>(res) != uncompressed_size) {
+        return STATUS_FORMAT(
+            Corruption, "Failed to decompress LZ4 entry batch: $0, expected size: $1",
+            res, uncompressed_size);
+      }
+      return Slice(*buffer);
+#else
+      return STATUS(NotSupported, "LZ4 is not supported by this build");
+#endif
+    }
+    case ZSTD_LOG_COMPRESSION: {
+#if defined(ZSTD)
+      size_t res = ZSTD_decompress(
+          buffer->data(), uncompressed_size, input.data(), input.size());
+      if (ZSTD_isError(res) || res != uncompressed_size) {
+        return STATUS_FORMAT(
+            Corruption, "Failed to decompress ZSTD entry batch: $0, expected size: $1",
+            ZSTD_isError(res) ? ZSTD_getErrorName(res) : std::to_string(res), uncompressed_size);
+      }
+      return Slice(*buffer);
+#else
+      return STATUS(NotSupported, "ZSTD is not supported by this build");
+#endif
+    }
+  }
+  return STATUS_FORMAT(Corruption, "Unknown entry batch codec: $0", static_cast<int>(batch_codec));
+}
+
 std::vector<std::string> ParseDirFlags(string flag_dirs, string flag_name) {
   std::vector<std::string> paths = strings::Split(flag_dirs, ",", strings::SkipEmpty());
   return paths;
@@ -52,9 +52,11 @@
 #include "yb/util/atomic.h"
 #include "yb/util/compare_util.h"
 #include "yb/util/env.h"
+#include "yb/util/faststring.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/restart_safe_clock.h"
+#include "yb/util/result.h"
 #include "yb/util/status.h"
 #include "yb/util/tostring.h"
 
@@ -397,6 +399,7 @@ class WritableLogSegment {
   // Appends the provided batch of data, including a header
   // and checksum.
   // Makes sure that the log segment has not been closed.
+  // Data is compressed with the codec from the segment header, if any.
   CHECKED_STATUS WriteEntryBatch(const Slice& entry_batch_data);
 
   // Makes sure the I/O buffers in the underlying writable file are flushed.
@@ -460,6 +463,9 @@ class WritableLogSegment {
   // The offset where the last written entry ends.
   int64_t written_offset_;
 
+  // Buffer for compressed entry batch, reused across writes.
+  faststring compression_buffer_;
+
   DISALLOW_COPY_AND_ASSIGN(WritableLogSegment);
 };
 
@@ -474,6 +480,19 @@ LogEntryBatchPB CreateBatchFromAllocatedOperations(const ReplicateMsgs& msgs);
 // Checks if 'fname' is a correctly formatted name of log segment file.
 bool IsLogFileName(const std::string& fname);
 
+// Returns codec that should be used to compress entry batches of new log segments, according to
+// log_compression_codec flag.
+LogCompressionCodecPB NewSegmentCompressionCodec();
+
+// Encodes entry batch data for a segment that uses specified codec. Returns data itself when
+// segment is not compressed, otherwise returns slice pointing to buffer.
+Slice CompressEntryBatch(LogCompressionCodecPB codec, const Slice& data, faststring* buffer);
+
+// Decodes entry batch data read from a segment that uses specified codec. Returns data itself when
+// segment is not compressed, otherwise decompresses data into buffer.
+Result<Slice> UncompressEntryBatch(
+    LogCompressionCodecPB codec, const Slice& data, faststring* buffer);
+
 CHECKED_STATUS CheckPathsAreODirectWritable(const std::vector<std::string>& paths);
 CHECKED_STATUS CheckRelevantPathsAreODirectWritable();
 
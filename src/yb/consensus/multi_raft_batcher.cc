@@ -18,9 +18,13 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus.proxy.h"
 
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/periodic.h"
 
 #include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
+#include "yb/util/source_location.h"
+#include "yb/util/status_format.h"
 
 using namespace std::literals;
 using namespace std::placeholders;
@@ -43,6 +47,24 @@ DEFINE_uint64(multi_raft_batch_size, 1,
 TAG_FLAG(multi_raft_batch_size, experimental);
 TAG_FLAG(multi_raft_batch_size, hidden);
 
+DEFINE_bool(multi_raft_batch_ops, false,
+            "Whether to batch small raft requests with replicate messages, together with "
+            "heartbeats. Requires enable_multi_raft_heartbeat_batcher.");
+TAG_FLAG(multi_raft_batch_ops, experimental);
+TAG_FLAG(multi_raft_batch_ops, runtime);
+
+DEFINE_uint64(multi_raft_max_batched_request_bytes, 16_KB,
+              "Max size of raft request with replicate messages that could be batched. Larger "
+              "requests are sent to the remote peer directly.");
+TAG_FLAG(multi_raft_max_batched_request_bytes, experimental);
+TAG_FLAG(multi_raft_max_batched_request_bytes, runtime);
+
+DEFINE_int32(multi_raft_batch_max_delay_us, 500,
+             "Max time that a raft request with replicate messages could wait in a batch before "
+             "the batch is sent. Zero means that such batch is sent immediately.");
+TAG_FLAG(multi_raft_batch_max_delay_us, experimental);
+TAG_FLAG(multi_raft_batch_max_delay_us, runtime);
+
 DECLARE_int32(consensus_rpc_timeout_ms);
 
 namespace yb {
@@ -55,6 +77,8 @@ struct MultiRaftHeartbeatBatcher::MultiRaftConsensusData {
   MultiRaftConsensusResponsePB batch_res;
   rpc::RpcController controller;
   std::vector<ResponseCallbackData> response_callback_data;
+  // Whether some of the requests carry replicate messages.
+  bool has_ops = false;
 };
 
 MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(const yb::HostPort& hostport,
@@ -77,30 +101,76 @@ void MultiRaftHeartbeatBatcher::Start() {
   batch_sender_->Start();
 }
 
-MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() = default;
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+  // Replicate messages of the unsent batch are owned by the log cache, so they should be returned
+  // to the requests before the batch is destroyed.
+  InvokeCallbacks(current_batch_.get(), STATUS(Aborted, "Batcher is shutting down"));
+}
 
 void MultiRaftHeartbeatBatcher::AddRequestToBatch(ConsensusRequestPB* request,
                                                   ConsensusResponsePB* response,
                                                   HeartbeatResponseCallback callback) {
   std::shared_ptr<MultiRaftConsensusData> data = nullptr;
+  std::weak_ptr<MultiRaftConsensusData> schedule_send;
+  const bool has_ops = request->ops_size() != 0;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     current_batch_->response_callback_data.push_back({
+      request,
       response,
       std::move(callback)
     });
     // Add a ConsensusRequestPB to the batch
     current_batch_->batch_req.add_consensus_request()->Swap(request);
-    if (FLAGS_multi_raft_batch_size > 0
-        && current_batch_->response_callback_data.size() >= FLAGS_multi_raft_batch_size) {
+    if (has_ops && !current_batch_->has_ops) {
+      current_batch_->has_ops = true;
+      schedule_send = current_batch_;
+    }
+    if ((FLAGS_multi_raft_batch_size > 0
+            && current_batch_->response_callback_data.size() >= FLAGS_multi_raft_batch_size) ||
+        (has_ops && FLAGS_multi_raft_batch_max_delay_us <= 0)) {
       data = PrepareNextBatchRequest();
     }
   }
   if (data) {
     SendBatchRequest(data);
+    return;
+  }
+  if (schedule_send.expired()) {
+    return;
+  }
+
+  std::weak_ptr<MultiRaftHeartbeatBatcher> weak_self = shared_from_this();
+  auto task_id = messenger_->ScheduleOnReactor(
+      [weak_self, schedule_send](const Status& status) {
+        auto self = weak_self.lock();
+        if (self && status.ok()) {
+          self->SendBatchWithOps(schedule_send);
+        }
+      },
+      MonoDelta::FromMicroseconds(FLAGS_multi_raft_batch_max_delay_us), SOURCE_LOCATION(),
+      messenger_);
+  if (task_id == rpc::kInvalidTaskId) {
+    // Messenger is shutting down, the batch will be sent by the periodic timer or aborted.
+    VLOG(1) << "Failed to schedule send of multi raft batch";
   }
 }
 
+void MultiRaftHeartbeatBatcher::SendBatchWithOps(
+    const std::weak_ptr<MultiRaftConsensusData>& weak_data) {
+  std::shared_ptr<MultiRaftConsensusData> data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto scheduled_data = weak_data.lock();
+    if (!scheduled_data || scheduled_data != current_batch_) {
+      // Batch was already sent.
+      return;
+    }
+    data = PrepareNextBatchRequest();
+  }
+  SendBatchRequest(data);
+}
+
 void MultiRaftHeartbeatBatcher::PrepareAndSendBatchRequest() {
   std::shared_ptr<MultiRaftConsensusData> data;
   {
@@ -129,6 +199,10 @@ void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsen
   data->controller.Reset();
   data->controller.set_timeout(MonoDelta::FromMilliseconds(
     FLAGS_consensus_rpc_timeout_ms * data->batch_req.consensus_request_size()));
+  if (data->has_ops) {
+    // Replicate responses are processed in the same way as non batched ones.
+    data->controller.set_invoke_callback_mode(rpc::InvokeCallbackMode::kThreadPoolHigh);
+  }
   consensus_proxy_->MultiRaftUpdateConsensusAsync(
     data->batch_req, &data->batch_res, &data->controller,
     std::bind(&MultiRaftHeartbeatBatcher::MultiRaftUpdateHeartbeatResponseCallback,
@@ -138,13 +212,33 @@ void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsen
 void MultiRaftHeartbeatBatcher::MultiRaftUpdateHeartbeatResponseCallback(
     std::shared_ptr<MultiRaftConsensusData> data) {
   auto status = data->controller.status();
+  if (status.ok()) {
+    status = data->controller.thread_pool_failure();
+  }
+  if (status.ok() &&
+      data->batch_res.consensus_response_size() != data->batch_req.consensus_request_size()) {
+    status = STATUS_FORMAT(
+        IllegalState, "Wrong number of responses in multi raft batch: $0, while $1 expected",
+        data->batch_res.consensus_response_size(), data->batch_req.consensus_request_size());
+  }
+  InvokeCallbacks(data.get(), status);
+}
+
+void MultiRaftHeartbeatBatcher::InvokeCallbacks(
+    MultiRaftConsensusData* data, const Status& status) {
   for (int i = 0; i < data->batch_req.consensus_request_size(); i++) {
-    auto callback_data = data->response_callback_data[i];
+    auto& callback_data = data->response_callback_data[i];
+    auto* request = data->batch_req.mutable_consensus_request(i);
+    if (request->ops_size() != 0) {
+      callback_data.req->Swap(request);
+    }
     if (status.ok()) {
       callback_data.resp->Swap(data->batch_res.mutable_consensus_response(i));
     }
     callback_data.callback(status);
   }
+  data->response_callback_data.clear();
+  data->batch_req.clear_consensus_request();
 }
 
 MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger,
@@ -44,6 +44,10 @@ using HeartbeatResponseCallback = std::function<void(const Status&)>;
 //   FLAGS_multi_raft_batch_size
 // - To improve efficency multiple batches may be processed concurrently
 //   but only a single batch is being built at any given time
+// - When FLAGS_multi_raft_batch_ops is set, small requests that carry replicate messages are
+//   batched as well. A batch that contains such request is sent at most
+//   FLAGS_multi_raft_batch_max_delay_us after the first of them was added, so the latency budget
+//   of replication does not depend on the heartbeat interval
 class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
  public:
   MultiRaftHeartbeatBatcher(const yb::HostPort& hostport,
@@ -59,6 +63,8 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
   // If the batch executes sucessfully then the response is populated and the callback is executed.
   // If the batch rpc call fails the response will NOT be populated and the callback will be
   // executed with an error status.
+  // If the request carries replicate messages, they are swapped back to the request before the
+  // callback is executed, so the caller could release them.
   void AddRequestToBatch(ConsensusRequestPB* request,
                          ConsensusResponsePB* response,
                          HeartbeatResponseCallback callback);
@@ -66,6 +72,7 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
  private:
   // Tracks a single peers ConsensusResponsePB as well as its ProcessResponse callback.
   struct ResponseCallbackData {
+    ConsensusRequestPB* req;
     ConsensusResponsePB* resp;
     HeartbeatResponseCallback callback;
   };
@@ -84,6 +91,14 @@ class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftH
 
   void MultiRaftUpdateHeartbeatResponseCallback(std::shared_ptr<MultiRaftConsensusData> data);
 
+  // Sends the batch if it is still being built. Invoked when the latency budget of a batch that
+  // carries replicate messages expires.
+  void SendBatchWithOps(const std::weak_ptr<MultiRaftConsensusData>& weak_data);
+
+  // Returns requests with replicate messages to their owners and invokes all callbacks of the
+  // batch with the specified status.
+  static void InvokeCallbacks(MultiRaftConsensusData* data, const Status& status);
+
   rpc::Messenger* messenger_;
 
   ConsensusServiceProxyPtr consensus_proxy_;
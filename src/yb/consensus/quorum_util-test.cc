@@ -74,5 +74,21 @@ TEST(QuorumUtilTest, TestMemberExtraction) {
   ASSERT_EQ("B", peer_pb.permanent_uuid());
 }
 
+TEST(QuorumUtilTest, TestWitness) {
+  RaftConfigPB config;
+  SetPeerInfo("A", PeerMemberType::VOTER, config.add_peers());
+  SetPeerInfo("B", PeerMemberType::VOTER, config.add_peers());
+  auto* witness = config.add_peers();
+  SetPeerInfo("C", PeerMemberType::VOTER, witness);
+  witness->set_witness(true);
+
+  ASSERT_FALSE(IsRaftConfigWitness("A", config));
+  ASSERT_FALSE(IsRaftConfigWitness("B", config));
+  ASSERT_TRUE(IsRaftConfigWitness("C", config));
+  ASSERT_FALSE(IsRaftConfigWitness("invalid", config));
+  // Witness is a regular voter for quorum purposes.
+  ASSERT_TRUE(IsRaftConfigVoter("C", config));
+}
+
 } // namespace consensus
 } // namespace yb
@@ -56,6 +56,9 @@ enum RaftConfigState {
 bool IsRaftConfigMember(const std::string& uuid, const RaftConfigPB& config);
 bool IsRaftConfigVoter(const std::string& uuid, const RaftConfigPB& config);
 
+// Returns true if the specified peer is a member of the config and is a witness.
+bool IsRaftConfigWitness(const std::string& uuid, const RaftConfigPB& config);
+
 // Get the specified member of the config.
 // Returns Status::NotFound if a member with the specified uuid could not be
 // found in the config.
@@ -343,6 +343,7 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
       options.tablet_id,
       clock,
       consensus_context,
+      raft_pool->NewToken(ThreadPool::ExecutionMode::SERIAL),
       raft_pool->NewToken(ThreadPool::ExecutionMode::SERIAL));
 
   DCHECK(local_peer_pb.has_permanent_uuid());
@@ -821,6 +822,13 @@ Status RaftConsensus::StepDown(const LeaderStepDownRequestPB* req, LeaderStepDow
   const bool forced = (req->has_force_step_down() && req->force_step_down());
   if (req->has_new_leader_uuid()) {
     new_leader_uuid = req->new_leader_uuid();
+    if (IsRaftConfigWitness(new_leader_uuid, state_->GetActiveConfigUnlocked())) {
+      resp->mutable_error()->set_code(TabletServerErrorPB::LEADER_NOT_READY_TO_STEP_DOWN);
+      StatusToPB(
+          STATUS(InvalidArgument, "Suggested peer is a witness"),
+          resp->mutable_error()->mutable_status());
+      return Status::OK();
+    }
     if (!forced && !queue_->CanPeerBecomeLeader(new_leader_uuid)) {
       resp->mutable_error()->set_code(TabletServerErrorPB::LEADER_NOT_READY_TO_STEP_DOWN);
       StatusToPB(
@@ -1316,6 +1324,10 @@ void RaftConsensus::MajorityReplicatedNumSSTFilesChanged(
   majority_num_sst_files_.store(majority_replicated_num_sst_files, std::memory_order_release);
 }
 
+void RaftConsensus::NotifyLogPrefetched() {
+  peer_manager_->SignalRequest(RequestTriggerMode::kNonEmptyOnly);
+}
+
 void RaftConsensus::UpdateMajorityReplicated(
     const MajorityReplicatedData& majority_replicated_data, OpId* committed_op_id,
     OpId* last_applied_op_id) {
@@ -1375,6 +1387,21 @@ void RaftConsensus::UpdateMajorityReplicated(
                   "Start step down failed");
     }
     delayed_step_down_.term = OpId::kUnknownTerm;
+  } else if (!majority_replicated_data.peer_got_all_ops.empty() &&
+             state_->GetActiveRoleUnlocked() == PeerRole::LEADER) {
+    // Witness counts towards the majority, so it could be the only voter that has all committed
+    // operations and win the election. But it does not have tablet data, so it stays the leader
+    // only until some full voter receives all operations, and then transfers leadership to it.
+    const auto& config = state_->GetActiveConfigUnlocked();
+    if (IsRaftConfigWitness(state_->GetPeerUuid(), config)) {
+      const auto* peer = FindPeer(config, majority_replicated_data.peer_got_all_ops);
+      if (peer && peer->member_type() == PeerMemberType::VOTER && !peer->witness()) {
+        LOG_WITH_PREFIX(INFO) << "Witness transfers leadership to synchronized peer "
+                              << peer->permanent_uuid();
+        WARN_NOT_OK(StartStepDownUnlocked(*peer, /* graceful= */ false),
+                    "Start step down failed");
+      }
+    }
   }
 
   if (committed_index_changed &&
@@ -341,6 +341,8 @@ class RaftConsensus : public std::enable_shared_from_this<RaftConsensus>,
 
   void MajorityReplicatedNumSSTFilesChanged(uint64_t majority_replicated_num_sst_files) override;
 
+  void NotifyLogPrefetched() override;
+
   // Control whether printing of log messages should be done for a particular
   // function call.
   enum AllowLogging {
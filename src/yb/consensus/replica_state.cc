@@ -1342,6 +1342,12 @@ void ReplicaState::NotifyReplicationFinishedUnlocked(
 
 consensus::LeaderState ReplicaState::RefreshLeaderStateCacheUnlocked(CoarseTimePoint* now) const {
   auto result = GetLeaderStateUnlocked(LeaderLeaseCheckMode::NEED_LEASE, now);
+  if (result.status == LeaderStatus::LEADER_AND_READY &&
+      IsRaftConfigWitness(peer_uuid_, GetActiveConfigUnlocked())) {
+    // Witness does not have tablet data, so it never serves as a leader. It only keeps leadership
+    // until a full voter catches up, so clients should retry on the same server meanwhile.
+    result.MakeNotReadyLeader(LeaderStatus::LEADER_BUT_NO_OP_NOT_COMMITTED);
+  }
   LeaderStateCache cache;
   if (result.status == LeaderStatus::LEADER_AND_READY) {
     cache.Set(result.status, result.term, majority_replicated_lease_expiration_);
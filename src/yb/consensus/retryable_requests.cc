@@ -27,6 +27,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/opid.h"
 #include "yb/util/result.h"
@@ -148,6 +149,13 @@ struct ClientRetryableRequests {
   RestartSafeCoarseTimePoint empty_since;
 };
 
+// Approximate memory used by entries of containers above, including container nodes overhead.
+constexpr size_t kRunningRequestBytes = sizeof(RunningRetryableRequest) + 2 * sizeof(void*);
+constexpr size_t kReplicatedRangeBytes =
+    sizeof(ReplicatedRetryableRequestRange) + 6 * sizeof(void*);
+constexpr size_t kClientBytes =
+    sizeof(ClientId) + sizeof(ClientRetryableRequests) + 2 * sizeof(void*);
+
 std::chrono::seconds RangeTimeLimit() {
   return std::chrono::seconds(FLAGS_retryable_request_range_time_limit_secs);
 }
@@ -267,6 +275,8 @@ class RetryableRequests::Impl {
     OpId result = OpId::Max();
     auto now = clock_.Now();
     auto clean_start = now - GetAtomicFlag(&FLAGS_retryable_request_timeout_secs) * 1s;
+    size_t num_running = 0;
+    size_t num_replicated = 0;
     for (auto ci = clients_.begin(); ci != clients_.end();) {
       ClientRetryableRequests& client_retryable_requests = ci->second;
       auto& op_id_index = client_retryable_requests.replicated.get<OpIdIndex>();
@@ -295,9 +305,17 @@ class RetryableRequests::Impl {
           continue;
         }
       }
+      num_running += client_retryable_requests.running.size();
+      num_replicated += op_id_index.size();
       ++ci;
     }
 
+    if (mem_tracker_consumption_) {
+      mem_tracker_consumption_.Reset(
+          clients_.size() * kClientBytes + num_running * kRunningRequestBytes +
+          num_replicated * kReplicatedRangeBytes);
+    }
+
     return result;
   }
 
@@ -376,6 +394,10 @@ class RetryableRequests::Impl {
         metric_entity, 0);
   }
 
+  void SetMemTracker(const MemTrackerPtr& mem_tracker) {
+    mem_tracker_consumption_ = ScopedTrackedConsumption(mem_tracker, 0);
+  }
+
   RetryableRequestsCounts TEST_Counts() {
     RetryableRequestsCounts result;
     for (const auto& p : clients_) {
@@ -545,6 +567,8 @@ class RetryableRequests::Impl {
   RestartSafeCoarseMonoClock clock_;
   scoped_refptr<AtomicGauge<int64_t>> running_requests_gauge_;
   scoped_refptr<AtomicGauge<int64_t>> replicated_request_ranges_gauge_;
+  // Memory used by requests, updated when expired requests are cleaned.
+  ScopedTrackedConsumption mem_tracker_consumption_;
 };
 
 RetryableRequests::RetryableRequests(std::string log_prefix)
@@ -596,5 +620,9 @@ void RetryableRequests::SetMetricEntity(const scoped_refptr<MetricEntity>& metri
   impl_->SetMetricEntity(metric_entity);
 }
 
+void RetryableRequests::SetMemTracker(const std::shared_ptr<MemTracker>& mem_tracker) {
+  impl_->SetMemTracker(mem_tracker);
+}
+
 } // namespace consensus
 } // namespace yb
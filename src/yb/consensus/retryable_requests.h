@@ -22,6 +22,7 @@
 
 namespace yb {
 
+class MemTracker;
 class MetricEntity;
 struct OpId;
 
@@ -66,6 +67,9 @@ class RetryableRequests {
 
   void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity);
 
+  // Memory used by requests is reported to the specified tracker.
+  void SetMemTracker(const std::shared_ptr<MemTracker>& mem_tracker);
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
@@ -26,7 +26,9 @@
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb_compaction_filter.h"
+#include "yb/docdb/key_bounds.h"
 #include "yb/docdb/primitive_value.h"
+#include "yb/docdb/value_type.h"
 
 #include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/version_edit.h"
@@ -118,6 +120,24 @@ void SetRetentionPolicy(
   manual_policy->SetHistoryCutoff(history_cutoff);
 }
 
+// Retention policy that counts the directives that were committed.
+class CountingHistoryRetentionPolicy : public ManualHistoryRetentionPolicy {
+ public:
+  HistoryRetentionDirective GetRetentionDirective() override {
+    ++num_committed_directives_;
+    return ManualHistoryRetentionPolicy::GetRetentionDirective();
+  }
+
+  HistoryRetentionDirective ProposedRetentionDirective() override {
+    return ManualHistoryRetentionPolicy::GetRetentionDirective();
+  }
+
+  int num_committed_directives() const { return num_committed_directives_; }
+
+ private:
+  int num_committed_directives_ = 0;
+};
+
 void ExpirationFilterTest::TestFilterFilesAgainstResults(
     DocDBCompactionFileFilterFactory* filter_factory,
     const std::vector<ConsensusFrontier>& frontiers,
@@ -349,6 +369,32 @@ TEST_F(ExpirationFilterTest, TestFilterBasedOnTableTTLOnly) {
   TestFilterFilesAgainstResults(&factory, frontiers, expected_results);
 }
 
+TEST_F(ExpirationFilterTest, TestTentativeFilterDoesNotCommitHistoryCutoff) {
+  auto retention_policy = std::make_shared<CountingHistoryRetentionPolicy>();
+  DocDBCompactionFileFilterFactory factory(retention_policy, clock_);
+  auto now = clock_->Now();
+  SetRetentionPolicy(retention_policy, MonoDelta::FromSeconds(1)); // set TTL to 1 second
+  std::vector<ConsensusFrontier> frontiers = {
+    CreateConsensusFrontier(now.AddSeconds(-100), kUseDefaultTTL), // discard
+    CreateConsensusFrontier(now.AddSeconds(100), kUseDefaultTTL), // keep
+  };
+  std::vector<FilterDecision> expected_results {
+    FilterDecision::kDiscard, FilterDecision::kKeep
+  };
+
+  // Tentative filter makes the same decisions, without committing the retention directive.
+  auto file_ptrs = CreateFilePtrs(frontiers);
+  auto filter = factory.CreateTentativeCompactionFileFilter(file_ptrs);
+  for (size_t i = 0; i < file_ptrs.size(); i++) {
+    EXPECT_EQ(filter->Filter(file_ptrs[i]), expected_results[i]) << i;
+  }
+  DeleteFilePtrs(&file_ptrs);
+  ASSERT_EQ(retention_policy->num_committed_directives(), 0);
+
+  TestFilterFilesAgainstResults(&factory, frontiers, expected_results);
+  ASSERT_EQ(retention_policy->num_committed_directives(), 1);
+}
+
 TEST_F(ExpirationFilterTest, TestFilterBasedOnTableTTLNoValueTTLData) {
   DocDBCompactionFileFilterFactory factory =
       DocDBCompactionFileFilterFactory(retention_policy_, clock_);
@@ -477,5 +523,40 @@ TEST_F(ExpirationFilterTest, TestFilterMixTableAndValueTTLWithTrustValueTTLFlag)
   TestFilterFilesAgainstResults(&factory, frontiers, expected_results);
 }
 
+TEST_F(ExpirationFilterTest, TestFilterOutOfKeyBounds) {
+  const KeyBounds key_bounds("k20", "k40");
+  // TTL based expiration is disabled, so only key bounds are checked.
+  DocDBCompactionFileFilterFactory factory(nullptr, clock_, &key_bounds);
+  const std::string apply_state_key(1, ValueTypeAsChar::kTransactionApplyState);
+  const std::vector<std::pair<std::string, std::string>> file_keys = {
+    {"k00", "k10"}, // discard
+    {"k10", "k20"}, // keep
+    {"k10", "k50"}, // keep
+    {"k25", "k35"}, // keep
+    {"k39", "k50"}, // keep
+    {"k40", "k50"}, // discard
+    {apply_state_key, "k10"}, // keep, transaction apply state is not bounded
+  };
+  std::vector<FilterDecision> expected_results {
+    FilterDecision::kDiscard, FilterDecision::kKeep, FilterDecision::kKeep, FilterDecision::kKeep,
+    FilterDecision::kKeep, FilterDecision::kDiscard, FilterDecision::kKeep
+  };
+
+  std::vector<rocksdb::FileMetaData> files(file_keys.size());
+  std::vector<rocksdb::FileMetaData*> file_ptrs;
+  for (size_t i = 0; i != file_keys.size(); ++i) {
+    files[i] = CreateFile();
+    files[i].smallest = rocksdb::MakeFileBoundaryValues(
+        file_keys[i].first, 100, rocksdb::kTypeValue);
+    files[i].largest = rocksdb::MakeFileBoundaryValues(
+        file_keys[i].second, 100, rocksdb::kTypeValue);
+    file_ptrs.push_back(&files[i]);
+  }
+  auto filter = factory.CreateCompactionFileFilter(file_ptrs);
+  for (size_t i = 0; i != files.size(); ++i) {
+    EXPECT_EQ(filter->Filter(&files[i]), expected_results[i]) << i;
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
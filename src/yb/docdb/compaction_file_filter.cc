@@ -20,6 +20,8 @@
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb_compaction_filter.h"
+#include "yb/docdb/key_bounds.h"
+#include "yb/docdb/value_type.h"
 
 #include "yb/gutil/casts.h"
 
@@ -105,7 +107,32 @@ bool IsLastKeyCreatedBeforeHistoryCutoff(ExpirationTime expiry, HybridTime histo
   return expiry.created_ht < history_cutoff;
 }
 
+bool IsFileOutOfBounds(const FileMetaData* file, const KeyBounds* key_bounds) {
+  if (!key_bounds || !key_bounds->IsInitialized()) {
+    return false;
+  }
+  const auto smallest = file->smallest.key.user_key();
+  // Transaction apply state records are kept regardless of key bounds, see
+  // DocDBCompactionFilter::GetLiveRanges.
+  static constexpr char kApplyStateEndChar = ValueTypeAsChar::kTransactionApplyState + 1;
+  if (smallest.compare(Slice(&kApplyStateEndChar, 1)) < 0) {
+    return false;
+  }
+  return (!key_bounds->upper.empty() && smallest.compare(key_bounds->upper) >= 0) ||
+         (!key_bounds->lower.empty() &&
+          file->largest.key.user_key().compare(key_bounds->lower) < 0);
+}
+
 FilterDecision DocDBCompactionFileFilter::Filter(const FileMetaData* file) {
+  // Files without keys within key bounds could be filtered independently of other files, since
+  // the compaction filter removes all of their records anyway.
+  if (IsFileOutOfBounds(file, key_bounds_)) {
+    VLOG(2) << "Filtering file, out of key bounds: "
+        << " bounds: " << key_bounds_->ToString()
+        << " file: " << file->ToString();
+    return FilterDecision::kDiscard;
+  }
+
   // Filtering a file based on TTL expiration needs to be done from the oldest files to
   // the newest in order to prevent conflicts with tombstoned values that have expired,
   // but are referenced in later files or later versions. If any file is "kept" by
@@ -156,8 +183,26 @@ const char* DocDBCompactionFileFilter::Name() const {
 
 unique_ptr<CompactionFileFilter> DocDBCompactionFileFilterFactory::CreateCompactionFileFilter(
     const vector<FileMetaData*>& input_files) {
+  return DoCreateCompactionFileFilter(input_files, /* commit_history_cutoff = */ true);
+}
+
+unique_ptr<CompactionFileFilter>
+DocDBCompactionFileFilterFactory::CreateTentativeCompactionFileFilter(
+    const vector<FileMetaData*>& input_files) {
+  return DoCreateCompactionFileFilter(input_files, /* commit_history_cutoff = */ false);
+}
+
+unique_ptr<CompactionFileFilter> DocDBCompactionFileFilterFactory::DoCreateCompactionFileFilter(
+    const vector<FileMetaData*>& input_files, bool commit_history_cutoff) {
   const HybridTime filter_ht = clock_->Now();
-  auto history_retention = retention_policy_->GetRetentionDirective();
+  if (!retention_policy_) {
+    // Only filter files by key bounds, nothing is older than the min hybrid time.
+    return std::make_unique<DocDBCompactionFileFilter>(
+        MonoDelta::kMax, HybridTime::kMin, HybridTime::kMin, filter_ht, EXP_NORMAL, key_bounds_);
+  }
+  auto history_retention = commit_history_cutoff
+      ? retention_policy_->GetRetentionDirective()
+      : retention_policy_->ProposedRetentionDirective();
   MonoDelta table_ttl = history_retention.table_ttl;
   HybridTime history_cutoff = history_retention.history_cutoff;
   HybridTime min_kept_ht = HybridTime::kMax;
@@ -187,7 +232,7 @@ unique_ptr<CompactionFileFilter> DocDBCompactionFileFilterFactory::CreateCompact
     }
   }
   return std::make_unique<DocDBCompactionFileFilter>(
-      table_ttl, history_cutoff, min_kept_ht, filter_ht, mode);
+      table_ttl, history_cutoff, min_kept_ht, filter_ht, mode, key_bounds_);
 }
 
 const char* DocDBCompactionFileFilterFactory::Name() const {
@@ -51,12 +51,20 @@ bool TtlIsExpired(
 
 bool IsLastKeyCreatedBeforeHistoryCutoff(ExpirationTime expiry, HybridTime history_cutoff);
 
+// Returns true if the file does not contain keys that are kept by DocDBCompactionFilter with the
+// specified key bounds, i.e. all of its keys are filtered out by compaction.
+bool IsFileOutOfBounds(const rocksdb::FileMetaData* file, const KeyBounds* key_bounds);
+
 // DocDBCompactionFileFilter will discard any files with a maximum HybridTime below
 // its max_ht_to_expire_, and keep any files with a maximum HybridTime above that value.
 // This parameter is determined by the filter factory at the time of the filter's creation.
 // table_ttl_, history_cutoff_, and filter_ht_ are all recorded at the time of filter
 // creation, and are used to sanity check the filter and ensure that we don't accidentally
 // discard a file that hasn't expired.
+//
+// If key_bounds_ is specified, files that don't contain any keys within them are discarded as
+// well, so data of the parent tablet that does not belong to this tablet after split is removed
+// without reading it.
 class DocDBCompactionFileFilter : public rocksdb::CompactionFileFilter {
  public:
   DocDBCompactionFileFilter(
@@ -64,12 +72,14 @@ class DocDBCompactionFileFilter : public rocksdb::CompactionFileFilter {
       const HybridTime history_cutoff,
       const HybridTime max_ht_to_expire,
       const HybridTime filter_ht,
-      const ExpiryMode mode)
+      const ExpiryMode mode,
+      const KeyBounds* key_bounds = nullptr)
       : table_ttl_(table_ttl),
         history_cutoff_(history_cutoff),
         max_ht_to_expire_(max_ht_to_expire),
         filter_ht_(filter_ht),
-        mode_(mode) {}
+        mode_(mode),
+        key_bounds_(key_bounds) {}
 
   rocksdb::FilterDecision Filter(const rocksdb::FileMetaData* file) override;
 
@@ -83,26 +93,36 @@ class DocDBCompactionFileFilter : public rocksdb::CompactionFileFilter {
   const HybridTime max_ht_to_expire_;
   const HybridTime filter_ht_;
   const ExpiryMode mode_;
+  const KeyBounds* key_bounds_;
 };
 
 // DocDBCompactionFileFilterFactory will create new DocDBCompactionFileFilters, using its
 // history retention policy and the current HybridTime from its clock to create constant
-// parameters for the new filter.
+// parameters for the new filter. Files are not expired by TTL when retention_policy is null.
 class DocDBCompactionFileFilterFactory : public rocksdb::CompactionFileFilterFactory {
  public:
   DocDBCompactionFileFilterFactory(
       std::shared_ptr<HistoryRetentionPolicy> retention_policy,
-      scoped_refptr<server::Clock> clock)
-      : retention_policy_(retention_policy), clock_(clock) {}
+      scoped_refptr<server::Clock> clock,
+      const KeyBounds* key_bounds = nullptr)
+      : retention_policy_(retention_policy), clock_(clock), key_bounds_(key_bounds) {}
 
   std::unique_ptr<rocksdb::CompactionFileFilter> CreateCompactionFileFilter(
       const std::vector<rocksdb::FileMetaData*>& inputs) override;
 
+  // Uses the history cutoff proposed by the retention policy, without committing it.
+  std::unique_ptr<rocksdb::CompactionFileFilter> CreateTentativeCompactionFileFilter(
+      const std::vector<rocksdb::FileMetaData*>& inputs) override;
+
   const char* Name() const override;
 
  private:
+  std::unique_ptr<rocksdb::CompactionFileFilter> DoCreateCompactionFileFilter(
+      const std::vector<rocksdb::FileMetaData*>& inputs, bool commit_history_cutoff);
+
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
   scoped_refptr<server::Clock> clock_;
+  const KeyBounds* key_bounds_;
 };
 
 }  // namespace docdb
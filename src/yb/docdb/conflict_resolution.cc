@@ -12,6 +12,7 @@
 //
 #include "yb/docdb/conflict_resolution.h"
 
+#include <algorithm>
 #include <map>
 
 #include "yb/common/hybrid_time.h"
@@ -24,6 +25,7 @@
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/intent_keys_filter.h"
 #include "yb/docdb/shared_lock_manager.h"
 #include "yb/docdb/transaction_dump.h"
 #include "yb/util/logging.h"
@@ -127,10 +129,11 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
                    TransactionStatusManager* status_manager,
                    PartialRangeKeyIntents partial_range_key_intents,
                    std::unique_ptr<ConflictResolverContext> context,
+                   WaitForTransactionsCallback wait_callback,
                    ResolutionCallback callback)
       : doc_db_(doc_db), status_manager_(*status_manager), request_scope_(status_manager),
         partial_range_key_intents_(partial_range_key_intents), context_(std::move(context)),
-        callback_(std::move(callback)) {}
+        wait_callback_(std::move(wait_callback)), callback_(std::move(callback)) {}
 
   PartialRangeKeyIntents partial_range_key_intents() {
     return partial_range_key_intents_;
@@ -260,6 +263,12 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
     return Status::OK();
   }
 
+  // Returns false if there are definitely no intents for the specified doc path.
+  bool MayHaveIntents(Slice intent_key_prefix) const {
+    return !doc_db_.intent_keys_filter ||
+           doc_db_.intent_keys_filter->MayContain(intent_key_prefix);
+  }
+
   void EnsureIntentIteratorCreated() {
     if (!intent_iter_.Initialized()) {
       intent_iter_ = CreateRocksDBIterator(
@@ -341,12 +350,44 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
       return true;
     }
 
+    if (ShouldWait()) {
+      WaitForRemainingTransactions();
+      return false;
+    }
+
     RETURN_NOT_OK(context_->CheckPriority(this, RemainingTransactions()));
 
     AbortTransactions();
     return false;
   }
 
+  // Writes with WAIT_SKIP policy should not wait, they skip locked rows instead.
+  bool ShouldWait() {
+    if (!wait_callback_) {
+      return false;
+    }
+    for (const auto& transaction : RemainingTransactions()) {
+      if (transaction.wait_policy != WAIT_ERROR) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Passes pending conflicting transactions to the wait callback, instead of aborting them.
+  void WaitForRemainingTransactions() {
+    std::vector<TransactionId> blockers;
+    blockers.reserve(remaining_transactions_);
+    for (const auto& transaction : RemainingTransactions()) {
+      blockers.push_back(transaction.id);
+    }
+    TRACE("Wait for $0 transactions", blockers.size());
+    VLOG_WITH_PREFIX(4) << "Wait for: " << yb::ToString(blockers);
+    intent_iter_.Reset();
+    auto wait_callback = std::move(wait_callback_);
+    wait_callback(context_->transaction_id(), std::move(blockers));
+  }
+
   // Returns true when there are no conflicts left.
   Result<bool> CheckLocalCommits() {
     return DoCleanup([this](auto* transaction) -> Result<bool> {
@@ -514,6 +555,7 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   RequestScope request_scope_;
   PartialRangeKeyIntents partial_range_key_intents_;
   std::unique_ptr<ConflictResolverContext> context_;
+  WaitForTransactionsCallback wait_callback_;
   ResolutionCallback callback_;
 
   BoundedRocksDbIterator intent_iter_;
@@ -867,8 +909,18 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
     // This is to prevent the case when we create an iterator on the regular DB where a
     // provisional record has not yet been applied, and then create an iterator the intents
     // DB where the provisional record has already been removed.
-    resolver->EnsureIntentIteratorCreated();
+    // The same applies to the intent keys filter, so it is checked for all keys at this point.
+    boost::container::small_vector<bool, 16> may_have_intents;
+    may_have_intents.reserve(container.size());
+    for (const auto& i : container) {
+      may_have_intents.push_back(resolver->MayHaveIntents(i.first.AsSlice()));
+    }
+    if (std::find(may_have_intents.begin(), may_have_intents.end(), true) !=
+            may_have_intents.end()) {
+      resolver->EnsureIntentIteratorCreated();
+    }
 
+    size_t idx = 0;
     for (const auto& i : container) {
       if (read_time_ != HybridTime::kMax) {
         const Slice intent_key = i.first.AsSlice();
@@ -881,6 +933,9 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
           RETURN_NOT_OK(checker.Check(intent_key, strong, wait_policy));
         }
       }
+      if (!may_have_intents[idx++]) {
+        continue;
+      }
       buffer.Reset(i.first.AsSlice());
       RETURN_NOT_OK(resolver->ReadIntentConflicts(i.second.types, &buffer, wait_policy));
     }
@@ -979,6 +1034,9 @@ class OperationConflictResolverContext : public ConflictResolverContextBase {
     EnumerateIntentsCallback callback = [&strong_intent_types, resolver](
         IntentStrength intent_strength, FullDocKey full_doc_key, Slice,
         KeyBytes* encoded_key_buffer, LastKey) {
+      if (!resolver->MayHaveIntents(encoded_key_buffer->AsSlice())) {
+        return Status::OK();
+      }
       return resolver->ReadIntentConflicts(
           intent_strength == IntentStrength::kStrong ? strong_intent_types
                                                      : StrongToWeak(strong_intent_types),
@@ -1045,13 +1103,15 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 WaitForTransactionsCallback wait_callback,
                                  ResolutionCallback callback) {
   DCHECK(hybrid_time.is_valid());
   TRACE("ResolveTransactionConflicts");
   auto context = std::make_unique<TransactionConflictResolverContext>(
       doc_ops, write_batch, hybrid_time, read_time, conflicts_metric);
   auto resolver = std::make_shared<ConflictResolver>(
-      doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
+      doc_db, status_manager, partial_range_key_intents, std::move(context),
+      std::move(wait_callback), std::move(callback));
   // Resolve takes a self reference to extend lifetime.
   resolver->Resolve();
   TRACE("resolver->Resolve done");
@@ -1068,7 +1128,8 @@ void ResolveOperationConflicts(const DocOperations& doc_ops,
   auto context = std::make_unique<OperationConflictResolverContext>(&doc_ops, resolution_ht,
                                                                     conflicts_metric);
   auto resolver = std::make_shared<ConflictResolver>(
-      doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
+      doc_db, status_manager, partial_range_key_intents, std::move(context),
+      WaitForTransactionsCallback(), std::move(callback));
   // Resolve takes a self reference to extend lifetime.
   resolver->Resolve();
   TRACE("resolver->Resolve done");
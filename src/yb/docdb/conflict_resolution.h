@@ -17,6 +17,7 @@
 #include <boost/function.hpp>
 
 #include "yb/common/common_fwd.h"
+#include "yb/common/transaction.h"
 
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/doc_operation.h"
@@ -37,6 +38,11 @@ namespace docdb {
 
 using ResolutionCallback = boost::function<void(const Result<HybridTime>&)>;
 
+// Invoked instead of ResolutionCallback when transaction waiter conflicts only with pending
+// transactions, and should wait for blockers to finish before retrying conflict resolution.
+using WaitForTransactionsCallback = boost::function<void(
+    const TransactionId& waiter, std::vector<TransactionId> blockers)>;
+
 // Resolves conflicts for write batch of transaction.
 // Read all intents that could conflict with intents generated by provided write_batch.
 // Forms set of conflicting transactions.
@@ -48,6 +54,7 @@ using ResolutionCallback = boost::function<void(const Result<HybridTime>&)>;
 // db - db that contains tablet data.
 // status_manager - status manager that should be used during this conflict resolution.
 // conflicts_metric - transaction_conflicts metric to update.
+// wait_callback - when set, it is invoked instead of aborting conflicting pending transactions.
 void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  const KeyValueWriteBatchPB& write_batch,
                                  HybridTime resolution_ht,
@@ -56,6 +63,7 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 WaitForTransactionsCallback wait_callback,
                                  ResolutionCallback callback);
 
 // Resolves conflicts for doc operations.
@@ -13,6 +13,7 @@
 
 #include "yb/docdb/cql_operation.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
@@ -38,8 +39,11 @@
 #include "yb/docdb/docdb_debug.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/primitive_value_util.h"
+#include "yb/docdb/ql_row_cache.h"
 #include "yb/docdb/ql_storage_interface.h"
 
+#include "yb/gutil/endian.h"
+
 #include "yb/util/debug-util.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/result.h"
@@ -248,6 +252,55 @@ CHECKED_STATUS CheckUserTimestampForCollections(const UserTimeMicros user_timest
   return Status::OK();
 }
 
+// Only non-transactional point reads of a single partition, whose result does not depend on the
+// read time, could be served from the row cache.
+bool IsRowCacheable(const QLReadRequestPB& request, const Schema& schema) {
+  return request.has_hash_code() &&
+         (!request.has_max_hash_code() || request.max_hash_code() == request.hash_code()) &&
+         !request.hashed_column_values().empty() &&
+         !request.distinct() && !request.is_aggregate() &&
+         !request.has_paging_state() && !request.has_offset() &&
+         !schema.has_statics() && !schema.table_properties().HasDefaultTimeToLive();
+}
+
+// Rows with TTL expire depending on the read time. Rows without non-key columns could be kept
+// alive by the liveness column with TTL, so they are not cached as well.
+bool IsRowCacheable(const QLTableRow& row, const Schema& non_static_projection) {
+  bool has_value = false;
+  for (size_t i = 0; i != non_static_projection.num_columns(); ++i) {
+    int64_t ttl_seconds;
+    if (!row.GetTTL(non_static_projection.column_id(i), &ttl_seconds).ok()) {
+      continue;
+    }
+    if (ttl_seconds != -1) {
+      return false;
+    }
+    has_value = true;
+  }
+  return has_value;
+}
+
+// Row cache key contains all request fields that affect rows returned by the iterator.
+std::string RowCacheKey(const QLReadRequestPB& request) {
+  std::string result;
+  auto append = [&result](const google::protobuf::MessageLite& message) {
+    const auto start = result.size();
+    result.append(sizeof(uint32_t), '\0');
+    message.AppendToString(&result);
+    BigEndian::Store32(&result[start], static_cast<uint32_t>(result.size() - start));
+  };
+  for (const auto& value : request.hashed_column_values()) {
+    append(value);
+  }
+  append(request.where_expr());
+  append(request.if_expr());
+  append(request.column_refs());
+  result.push_back(request.is_forward_scan());
+  const auto schema_version = request.schema_version();
+  result.append(reinterpret_cast<const char*>(&schema_version), sizeof(schema_version));
+  return result;
+}
+
 } // namespace
 
 QLWriteOperation::QLWriteOperation(std::reference_wrapper<const QLWriteRequestPB> request,
@@ -1481,6 +1534,33 @@ Status QLReadOperation::Execute(const YQLStorageIf& ql_storage,
   RETURN_NOT_OK(ql_storage.BuildYQLScanSpec(
       request_, read_time, schema, read_static_columns, static_projection, &spec,
       &static_row_spec));
+
+  const bool use_row_cache =
+      row_cache_ && !txn_op_context_ && IsRowCacheable(request_, schema);
+  const uint16_t hash_code = request_.hash_code();
+  std::string row_cache_key;
+  uint64_t row_cache_epoch = 0;
+  std::vector<QLTableRow> rows_to_cache;
+  if (use_row_cache) {
+    row_cache_key = RowCacheKey(request_);
+    std::vector<QLTableRow> cached_rows;
+    // When there are more cached rows than the limit, paging state should be filled using
+    // iterator. So such reads are not served from the cache.
+    if (row_cache_->Lookup(hash_code, row_cache_key, read_time.read, &cached_rows) &&
+        cached_rows.size() <= row_count_limit) {
+      int match_count = 0;
+      for (const auto& row : cached_rows) {
+        RETURN_NOT_OK(AddRowToResult(
+            spec, row, row_count_limit, offset, resultset, &match_count, &num_rows_skipped));
+      }
+      VTRACE(1, "Fetched $0 rows from row cache.", resultset->rsrow_count());
+      *restart_read_ht = HybridTime::kInvalid;
+      return Status::OK();
+    }
+    // Epoch should be obtained before reading, so rows that could be affected by a concurrent
+    // write are not cached.
+    row_cache_epoch = row_cache_->Epoch(hash_code);
+  }
   RETURN_NOT_OK(ql_storage.GetIterator(request_, projection, schema, txn_op_context_,
                                        deadline, read_time, *spec, &iter));
   VTRACE(1, "Initialized iterator");
@@ -1574,6 +1654,9 @@ Status QLReadOperation::Execute(const YQLStorageIf& ql_storage,
           }
         }
         static_dealt_with = true;
+        if (use_row_cache && rows_to_cache.size() <= QLRowCache::kMaxRowsPerEntry) {
+          rows_to_cache.push_back(non_static_row);
+        }
         RETURN_NOT_OK(AddRowToResult(
             spec, non_static_row, row_count_limit, offset, resultset, &match_count,
             &num_rows_skipped));
@@ -1581,6 +1664,16 @@ Status QLReadOperation::Execute(const YQLStorageIf& ql_storage,
     }
   }
 
+  if (use_row_cache && rows_to_cache.size() <= QLRowCache::kMaxRowsPerEntry &&
+      !VERIFY_RESULT(iter->HasNext()) && !iter->RestartReadHt().is_valid() &&
+      std::all_of(rows_to_cache.begin(), rows_to_cache.end(),
+                  [&non_static_projection](const QLTableRow& row) {
+                    return IsRowCacheable(row, non_static_projection);
+                  })) {
+    row_cache_->Insert(
+        hash_code, row_cache_key, row_cache_epoch, read_time.read, std::move(rows_to_cache));
+  }
+
   if (request_.is_aggregate() && match_count > 0) {
     RETURN_NOT_OK(PopulateAggregate(selected_row, resultset));
   }
@@ -189,8 +189,9 @@ class QLReadOperation : public DocExprExecutor {
  public:
   QLReadOperation(
       const QLReadRequestPB& request,
-      const TransactionOperationContext& txn_op_context)
-      : request_(request), txn_op_context_(txn_op_context) {}
+      const TransactionOperationContext& txn_op_context,
+      QLRowCache* row_cache = nullptr)
+      : request_(request), txn_op_context_(txn_op_context), row_cache_(row_cache) {}
 
   CHECKED_STATUS Execute(const YQLStorageIf& ql_storage,
                          CoarseTimePoint deadline,
@@ -231,6 +232,8 @@ class QLReadOperation : public DocExprExecutor {
 
   const QLReadRequestPB& request_;
   const TransactionOperationContext txn_op_context_;
+  // Cache of rows returned by point reads, nullptr when the tablet does not have row cache.
+  QLRowCache* const row_cache_;
   QLResponsePB response_;
 };
 
@@ -391,6 +391,74 @@ CHECKED_STATUS DocExprExecutor::EvalMin(const QLValuePB& val, QLValue *aggr_min)
   return Status::OK();
 }
 
+bool DocExprExecutor::IsMergeableAggregate(const PgsqlExpressionPB& expr) {
+  if (!expr.has_tscall()) {
+    return false;
+  }
+  switch (static_cast<bfpg::TSOpcode>(expr.tscall().opcode())) {
+    case bfpg::TSOpcode::kCount: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt8: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt16: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt32: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt64: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumFloat: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumDouble: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kMin: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kMax:
+      return true;
+    default:
+      return false;
+  }
+}
+
+CHECKED_STATUS DocExprExecutor::MergeAggregate(
+    const PgsqlExpressionPB& expr, const QLValuePB& partial, QLValue *aggr) {
+  if (IsNull(partial)) {
+    return Status::OK();
+  }
+  if (aggr->IsNull()) {
+    *aggr = partial;
+    return Status::OK();
+  }
+
+  const auto tsopcode = static_cast<bfpg::TSOpcode>(expr.tscall().opcode());
+  switch (tsopcode) {
+    case bfpg::TSOpcode::kCount: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt8: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt16: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt32: FALLTHROUGH_INTENDED;
+    case bfpg::TSOpcode::kSumInt64:
+      // Both count and integer sums are accumulated as int64.
+      aggr->set_int64_value(aggr->int64_value() + partial.int64_value());
+      return Status::OK();
+
+    case bfpg::TSOpcode::kSumFloat:
+      aggr->set_float_value(aggr->float_value() + partial.float_value());
+      return Status::OK();
+
+    case bfpg::TSOpcode::kSumDouble:
+      aggr->set_double_value(aggr->double_value() + partial.double_value());
+      return Status::OK();
+
+    case bfpg::TSOpcode::kMin:
+      if (aggr->value() > partial) {
+        *aggr = partial;
+      }
+      return Status::OK();
+
+    case bfpg::TSOpcode::kMax:
+      if (aggr->value() < partial) {
+        *aggr = partial;
+      }
+      return Status::OK();
+
+    default:
+      break;
+  }
+  return STATUS_FORMAT(
+      NotSupported, "Aggregate $0 could not be merged", static_cast<int>(tsopcode));
+}
+
 CHECKED_STATUS DocExprExecutor::EvalAvg(const QLValuePB& val, QLValue *aggr_avg) {
   if (IsNull(val)) {
     return Status::OK();
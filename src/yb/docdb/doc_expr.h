@@ -54,6 +54,14 @@ class DocExprExecutor : public QLExprExecutor {
   CHECKED_STATUS EvalMin(const QLValuePB& val, QLValue *aggr_min);
   CHECKED_STATUS EvalAvg(const QLValuePB& val, QLValue *aggr_avg);
 
+  // Whether partial results of the aggregate expression, computed over disjoint sets of rows, could
+  // be combined with MergeAggregate.
+  static bool IsMergeableAggregate(const PgsqlExpressionPB& expr);
+
+  // Combine partial result of the mergeable aggregate expression into the aggregate result.
+  static CHECKED_STATUS MergeAggregate(
+      const PgsqlExpressionPB& expr, const QLValuePB& partial, QLValue *aggr);
+
   CHECKED_STATUS EvalParametricToJson(const QLExpressionPB& operand,
                                       const QLTableRow& table_row,
                                       QLValue *result,
@@ -855,10 +855,12 @@ class DocDbAwareV2FilterPolicy : public DocDbAwareFilterPolicyBase {
 };
 
 // This filter policy takes into account following parts of keys for filtering:
-// - For range-based partitioned tables (such tables have 0 hashed components):
-// use all hash components of the doc key.
 // - For hash-based partitioned tables (such tables have >0 hashed components):
+// use all hash components of the doc key.
+// - For range-based partitioned tables (such tables have 0 hashed components):
 // use first range component of the doc key.
+// The cotable id or pgtable id prefix is always included, so colocated tables are filtered by
+// their own keys.
 class DocDbAwareV3FilterPolicy : public DocDbAwareFilterPolicyBase {
  public:
   DocDbAwareV3FilterPolicy(size_t filter_block_size_bits, rocksdb::Logger* logger)
@@ -869,6 +871,10 @@ class DocDbAwareV3FilterPolicy : public DocDbAwareFilterPolicyBase {
   const KeyTransformer* GetKeyTransformer() const override;
 };
 
+// Returns key transformer that extracts the whole encoded DocKey, used to build hash index of
+// data blocks.
+const rocksdb::FilterPolicy::KeyTransformer* DocKeyExtractor();
+
 }  // namespace docdb
 }  // namespace yb
 
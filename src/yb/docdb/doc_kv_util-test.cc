@@ -118,6 +118,29 @@ TEST(DocKVUtilTest, ZeroEncodingAndDecoding) {
   }
 }
 
+TEST(DocKVUtilTest, ComplementZeroEncodingAndDecoding) {
+  rocksdb::Random rng(12345); // initialize with a fixed seed
+  for (int i = 0; i < 1000; ++i) {
+    int len = rng.Next() % 200;
+    string s;
+    s.reserve(len);
+    for (int j = 0; j < len; ++j) {
+      // Use a small alphabet, so zero and 0xff characters are frequent.
+      static const char kAlphabet[] = {'\0', '\x01', 'a', '\xfe', '\xff'};
+      s.push_back(kAlphabet[rng.Next() % sizeof(kAlphabet)]);
+    }
+    KeyBuffer buf;
+    ComplementZeroEncodeAndAppendStrToKey(s, &buf);
+    buf.append("suffix"s);
+
+    string decoded_str;
+    rocksdb::Slice slice = buf.AsSlice();
+    ASSERT_OK(DecodeComplementZeroEncodedStr(&slice, &decoded_str));
+    ASSERT_EQ(s, decoded_str);
+    ASSERT_EQ("suffix", slice.ToBuffer());
+  }
+}
+
 TEST(DocKVUtilTest, TableTTL) {
   Schema schema;
   EXPECT_TRUE(TableTTL(schema).Equals(Value::kMaxTtl));
@@ -13,6 +13,8 @@
 
 #include "yb/docdb/doc_kv_util.h"
 
+#include <string.h>
+
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/value_type.h"
@@ -77,10 +79,24 @@ template <char END_OF_STRING>
 void AppendEncodedStrToKey(const string &s, KeyBuffer *dest) {
   static_assert(END_OF_STRING == '\0' || END_OF_STRING == '\xff',
                 "Only characters '\0' and '\xff' allowed as a template parameter");
-  if (END_OF_STRING == '\0' && s.find('\0') == string::npos) {
-    // Fast path: no zero characters, nothing to encode.
-    dest->append(s);
+  if (END_OF_STRING == '\0') {
+    // Copy runs of non zero characters at once, escaping zeros between them. When there are no
+    // zero characters, the whole string is appended as is.
+    const char* p = s.data();
+    const char* end = p + s.size();
+    for (;;) {
+      auto next_zero = static_cast<const char*>(memchr(p, '\0', end - p));
+      if (!next_zero) {
+        dest->append(p, end);
+        break;
+      }
+      dest->append(p, next_zero);
+      dest->push_back('\0');
+      dest->push_back('\1');
+      p = next_zero + 1;
+    }
   } else {
+    dest->reserve(dest->size() + s.size() + kEncodedKeyStrTerminatorSize);
     for (char c : s) {
       if (c == '\0') {
         dest->push_back(END_OF_STRING);
@@ -114,6 +130,18 @@ void TerminateComplementZeroEncodedKeyStr(KeyBuffer *dest) {
   TerminateEncodedKeyStr<'\xff'>(dest);
 }
 
+// Appends decoded characters of the run that does not contain END_OF_STRING.
+template<char END_OF_STRING>
+inline void AppendDecodedRun(const char* begin, const char* end, string* result) {
+  const auto old_size = result->size();
+  result->append(begin, end);
+  if (END_OF_STRING != '\0') {
+    for (auto it = result->begin() + old_size; it != result->end(); ++it) {
+      *it ^= END_OF_STRING;
+    }
+  }
+}
+
 template<char END_OF_STRING>
 Status DecodeEncodedStr(rocksdb::Slice* slice, string* result) {
   static_assert(END_OF_STRING == '\0' || END_OF_STRING == '\xff',
@@ -123,7 +151,16 @@ Status DecodeEncodedStr(rocksdb::Slice* slice, string* result) {
   const char* end = p + slice->size();
 
   while (p != end) {
-    if (*p == END_OF_STRING) {
+    // Regular characters up to the next END_OF_STRING are decoded as a single run.
+    auto next = static_cast<const char*>(memchr(p, END_OF_STRING, end - p));
+    if (!next) {
+      next = end;
+    }
+    if (result != nullptr && next != p) {
+      AppendDecodedRun<END_OF_STRING>(p, next, result);
+    }
+    p = next;
+    if (p != end) {
       ++p;
       if (p == end) {
         return STATUS(Corruption, StringPrintf("Encoded string ends with only one \\0x%02x ",
@@ -146,11 +183,6 @@ Status DecodeEncodedStr(rocksdb::Slice* slice, string* result) {
             R"#(\0x%02x\0x%02x (must be either \0x%02x\0x%02x or \0x%02x\0x%02x))#",
             END_OF_STRING, *p, END_OF_STRING, END_OF_STRING, END_OF_STRING, END_OF_STRING_ESCAPE));
       }
-    } else {
-      if (result != nullptr) {
-        result->push_back((*p) ^ END_OF_STRING);
-      }
-      ++p;
     }
   }
   if (result != nullptr) {
@@ -11,8 +11,13 @@
 // under the License.
 //
 
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <thread>
 
+#include "yb/bfpg/tserver_opcodes.h"
+
 #include "yb/common/common.pb.h"
 #include "yb/common/index.h"
 #include "yb/common/ql_protocol_util.h"
@@ -27,6 +32,7 @@
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
+#include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/redis_operation.h"
 
@@ -41,10 +47,13 @@
 #include "yb/util/size_literals.h"
 #include "yb/util/tostring.h"
 
+#include "yb/yql/pggate/util/pg_wire.h"
+
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
+DECLARE_uint64(ysql_max_aggregate_groups_per_response);
 
 using namespace std::literals; // NOLINT
 
@@ -1283,5 +1292,169 @@ TEST_F(DocOperationTest, EarlyFilesFilteredBeforeBigFile) {
   ASSERT_EQ(kNumFilesToExpire, stats->getTickerCount(rocksdb::COMPACTION_FILES_FILTERED));
 }
 
+// Reads a non-null column value written by pggate::WriteColumn.
+template <class T>
+T ReadPgColumn(Slice* cursor) {
+  uint8_t header;
+  cursor->remove_prefix(pggate::PgWire::ReadNumber(cursor, &header));
+  EXPECT_FALSE(pggate::PgWireDataHeader(header).is_null());
+  T value;
+  cursor->remove_prefix(pggate::PgWire::ReadNumber(cursor, &value));
+  return value;
+}
+
+class DocOperationPgsqlReadTest : public DocOperationTest {
+ protected:
+  DocOperationPgsqlReadTest() {
+    ColumnSchema key_column_schema("k", INT32, false, false);
+    ColumnSchema value_column_schema("v", INT32, false, false);
+    const vector<ColumnSchema> columns({key_column_schema, value_column_schema});
+    schema_ = Schema(columns, CreateColumnIds(columns.size()), 1);
+  }
+
+  // Inserts rows with keys from 0 to num_rows - 1, the value of a row is its key modulo
+  // num_values.
+  void InsertRows(int32_t num_rows, int32_t num_values) {
+    for (int32_t key = 0; key != num_rows; ++key) {
+      QLWriteRequestPB ql_writereq_pb;
+      QLResponsePB ql_writeresp_pb;
+      ql_writereq_pb.set_type(QLWriteRequestPB::QL_STMT_INSERT);
+      AddRangeKeyColumn(key, &ql_writereq_pb);
+      AddColumnValues(schema_, {key % num_values}, &ql_writereq_pb);
+      ASSERT_NO_FATALS(WriteQL(
+          ql_writereq_pb, schema_, &ql_writeresp_pb, HybridTime::FromMicros(1000)));
+    }
+  }
+
+  // Executes a page of the read request, the rows data is placed into rows_data without the rows
+  // count. The paging state of the request is replaced by the paging state of the response.
+  Result<size_t> ReadPage(PgsqlReadRequestPB* request, std::string* rows_data) {
+    QLRocksDBStorage ql_storage(doc_db());
+    PgsqlReadOperation read_op(*request, kNonTransactionalOperationContext);
+    faststring result_buffer;
+    HybridTime restart_read_ht;
+    auto num_rows = VERIFY_RESULT(read_op.Execute(
+        ql_storage, CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000),
+        true /* is_explicit_request_read_time */, schema_, nullptr /* index_schema */,
+        &result_buffer, &restart_read_ht));
+    rows_data->assign(result_buffer.c_str() + sizeof(int64_t),
+                      result_buffer.size() - sizeof(int64_t));
+    if (read_op.response().has_paging_state()) {
+      *request->mutable_paging_state() = read_op.response().paging_state();
+    } else {
+      request->clear_paging_state();
+    }
+    return num_rows;
+  }
+
+  Schema schema_;
+};
+
+TEST_F_EX(DocOperationTest, PgsqlGroupedAggregatePaging, DocOperationPgsqlReadTest) {
+  constexpr int32_t kNumRows = 100;
+  constexpr int32_t kNumGroups = 10;
+  constexpr size_t kGroupsLimit = 3;
+  FLAGS_ysql_max_aggregate_groups_per_response = kGroupsLimit;
+  ASSERT_NO_FATALS(InsertRows(kNumRows, kNumGroups));
+
+  // SELECT v, COUNT(v) FROM t GROUP BY v.
+  PgsqlReadRequestPB request;
+  auto* tscall = request.add_targets()->mutable_tscall();
+  tscall->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+  tscall->add_operands()->set_column_id(1);
+  request.add_group_by_exprs()->set_column_id(1);
+  request.mutable_column_refs()->add_ids(1);
+  request.set_is_aggregate(true);
+  request.set_return_paging_state(true);
+
+  std::map<int32_t, int64_t> counts;
+  size_t num_pages = 0;
+  do {
+    std::string rows_data;
+    const auto num_groups = ASSERT_RESULT(ReadPage(&request, &rows_data));
+    ASSERT_GT(num_groups, 0U);
+    ASSERT_LE(num_groups, kGroupsLimit);
+    Slice cursor(rows_data);
+    for (size_t i = 0; i != num_groups; ++i) {
+      const auto value = ReadPgColumn<int32_t>(&cursor);
+      counts[value] += ReadPgColumn<int64_t>(&cursor);
+    }
+    ASSERT_TRUE(cursor.empty());
+    ++num_pages;
+  } while (request.has_paging_state());
+
+  // Partial aggregates of the same group returned by different pages add up to the group total.
+  ASSERT_GE(num_pages, kNumRows / kGroupsLimit);
+  ASSERT_EQ(counts.size(), static_cast<size_t>(kNumGroups));
+  for (const auto& value_and_count : counts) {
+    ASSERT_EQ(value_and_count.second, kNumRows / kNumGroups) << "Group " << value_and_count.first;
+  }
+}
+
+// SELECT v FROM t ORDER BY v DESC LIMIT top_n_limit, with a smaller paged limit.
+PgsqlReadRequestPB TopNReadRequest(uint64_t top_n_limit) {
+  PgsqlReadRequestPB request;
+  request.add_targets()->set_column_id(1);
+  request.mutable_column_refs()->add_ids(1);
+  auto* order_by = request.add_order_by();
+  order_by->mutable_expr()->set_column_id(1);
+  order_by->set_is_descending(true);
+  request.set_top_n_limit(top_n_limit);
+  request.set_limit(1);
+  request.set_return_paging_state(true);
+  return request;
+}
+
+TEST_F_EX(DocOperationTest, PgsqlTopN, DocOperationPgsqlReadTest) {
+  constexpr int32_t kNumRows = 100;
+  constexpr int32_t kTopNLimit = 5;
+  ASSERT_NO_FATALS(InsertRows(kNumRows, kNumRows));
+
+  auto request = TopNReadRequest(kTopNLimit);
+  std::string rows_data;
+  // The top-N read scans the whole tablet, neither the paged limit nor the number of kept rows
+  // stops it.
+  ASSERT_EQ(ASSERT_RESULT(ReadPage(&request, &rows_data)), static_cast<size_t>(kTopNLimit));
+  ASSERT_FALSE(request.has_paging_state());
+  Slice cursor(rows_data);
+  for (int32_t value = kNumRows - 1; value != kNumRows - 1 - kTopNLimit; --value) {
+    ASSERT_EQ(ReadPgColumn<int32_t>(&cursor), value);
+  }
+  ASSERT_TRUE(cursor.empty());
+}
+
+TEST_F_EX(DocOperationTest, PgsqlTopNSizeLimit, DocOperationPgsqlReadTest) {
+  constexpr int32_t kNumRows = 100;
+  constexpr uint64_t kTopNLimit = 5;
+  // Each row takes 5 bytes: the column header and int32 value.
+  constexpr uint64_t kSizeLimit = 10;
+  ASSERT_NO_FATALS(InsertRows(kNumRows, kNumRows));
+
+  auto request = TopNReadRequest(kTopNLimit);
+  request.set_size_limit(kSizeLimit);
+  std::vector<int32_t> values;
+  size_t num_pages = 0;
+  do {
+    std::string rows_data;
+    const auto num_rows = ASSERT_RESULT(ReadPage(&request, &rows_data));
+    // Kept rows are counted against the size limit, so a page stops once they reach it.
+    ASSERT_LE(rows_data.size(), kSizeLimit);
+    Slice cursor(rows_data);
+    for (size_t i = 0; i != num_rows; ++i) {
+      values.push_back(ReadPgColumn<int32_t>(&cursor));
+    }
+    ASSERT_TRUE(cursor.empty());
+    ++num_pages;
+  } while (request.has_paging_state());
+  ASSERT_GT(num_pages, 1U);
+
+  // The client sorts the rows of all pages and applies the limit.
+  std::sort(values.begin(), values.end(), std::greater<int32_t>());
+  ASSERT_GE(values.size(), kTopNLimit);
+  for (size_t i = 0; i != kTopNLimit; ++i) {
+    ASSERT_EQ(values[i], kNumRows - 1 - static_cast<int32_t>(i));
+  }
+}
+
 }  // namespace docdb
 }  // namespace yb
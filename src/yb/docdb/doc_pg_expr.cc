@@ -11,8 +11,6 @@
 // under the License.
 //
 
-#include <list>
-
 #include "yb/docdb/doc_pg_expr.h"
 #include "yb/docdb/docdb_pgapi.h"
 #include "yb/util/logging.h"
@@ -128,28 +126,64 @@ class DocPgExprExecutor::Private {
   // Retrieve expressions from the row according to the added column references
   CHECKED_STATUS PreparePgRowData(const QLTableRow& table_row) {
     YbgMemoryContext old;
+    start_row_batch(&old);
+    Status s = fill_expr_context(table_row);
+    // Restore previous memory context
+    YbgSetCurrentMemoryContext(old, nullptr);
+    return s;
+  }
+
+  // Evaluate where clause expressions for the batch of rows
+  CHECKED_STATUS EvalWhereBatch(const std::vector<QLTableRow>& rows,
+                                size_t num_rows,
+                                std::vector<bool>* matches) {
+    SCHECK_LE(num_rows, rows.size(), InternalError, "Batch size exceeds number of rows");
+    matches->assign(num_rows, true);
+    if (where_clause_.empty()) {
+      return Status::OK();
+    }
+    YbgMemoryContext old;
+    // The row context is reset once for the batch, values of all the rows share it
+    start_row_batch(&old);
     Status s = Status::OK();
+    for (size_t i = 0; s.ok() && i != num_rows; ++i) {
+      s = fill_expr_context(rows[i]);
+      if (s.ok()) {
+        bool match;
+        s = eval_where_expr_calls(&match);
+        (*matches)[i] = match;
+      }
+    }
+    // Restore previous memory context
+    YbgSetCurrentMemoryContext(old, nullptr);
+    return s;
+  }
+
+  bool has_where_clause() const {
+    return !where_clause_.empty();
+  }
+
+  // Make the per row memory context current, creating or resetting it.
+  void start_row_batch(YbgMemoryContext *old) {
     if (row_ctx_ == nullptr) {
       // The first row, prepare memory context for per row allocations
       YbgCreateMemoryContext(mem_ctx_, "DocPg Row Context", &row_ctx_);
-      YbgSetCurrentMemoryContext(row_ctx_, &old);
+      YbgSetCurrentMemoryContext(row_ctx_, old);
     } else {
       // Clean up memory allocations that may be still around after previous row was processed
-      YbgSetCurrentMemoryContext(row_ctx_, &old);
+      YbgSetCurrentMemoryContext(row_ctx_, old);
       YbgResetMemoryContext();
     }
+  }
+
+  // Transfer referenced row values to the expr_ctx_ container. Expects row_ctx_ to be current.
+  CHECKED_STATUS fill_expr_context(const QLTableRow& table_row) {
     // If there are no column references the expression context will not be used
-    if (!var_map_.empty()) {
-      s = ensure_expr_context();
-      // Transfer referenced row values to the expr_ctx_ container
-      if (s.ok()) {
-        s = DocPgPrepareExprCtx(table_row, var_map_, expr_ctx_);
-      }
+    if (var_map_.empty()) {
+      return Status::OK();
     }
-
-    // Restore previous memory context
-    YbgSetCurrentMemoryContext(old, nullptr);
-    return s;
+    RETURN_NOT_OK(ensure_expr_context());
+    return DocPgPrepareExprCtx(table_row, var_map_, expr_ctx_);
   }
 
   // Create the expression context if does not exist
@@ -168,9 +202,17 @@ class DocPgExprExecutor::Private {
   // Evaluate where clause expressions
   CHECKED_STATUS EvalWhereExprCalls(bool *result) {
     YbgMemoryContext old;
+    YbgSetCurrentMemoryContext(row_ctx_, &old);
+    Status s = eval_where_expr_calls(result);
+    // Restore previous context
+    YbgSetCurrentMemoryContext(old, nullptr);
+    return s;
+  }
+
+  // Evaluate where clause expressions in the current memory context
+  CHECKED_STATUS eval_where_expr_calls(bool *result) {
     uint64_t datum;
     bool is_null;
-    YbgSetCurrentMemoryContext(row_ctx_, &old);
     // If where_clause_ is empty or all the expressions yield true, the result will remain true
     *result = true;
     for (auto expr : where_clause_) {
@@ -182,8 +224,6 @@ class DocPgExprExecutor::Private {
         break;
       }
     }
-    // Restore previous context
-    YbgSetCurrentMemoryContext(old, nullptr);
     return Status::OK();
   }
 
@@ -227,10 +267,10 @@ class DocPgExprExecutor::Private {
   // Container for Postgres-format data retrieved from the DocDB row.
   // Provides fast access to is_nulls and datums by index(attribute number).
   YbgExprContext expr_ctx_ = nullptr;
-  // List of where clause expressions
-  std::list<YbgPreparedExpr> where_clause_;
-  // List of target expressions with their type info
-  std::list<DocPgEvalExprData> targets_;
+  // Where clause expressions, stored contiguously as they are iterated for every row
+  std::vector<YbgPreparedExpr> where_clause_;
+  // Target expressions with their type info
+  std::vector<DocPgEvalExprData> targets_;
   // Storage for column references. Key is the attribute number, value is basically DocDB column id
   // and type info.
   // There are couple minor benefits of using ordered map here. First, we tolerate duplicate column
@@ -281,5 +321,19 @@ CHECKED_STATUS DocPgExprExecutor::Exec(const QLTableRow& table_row,
   return Status::OK();
 }
 
+CHECKED_STATUS DocPgExprExecutor::ExecWhere(const std::vector<QLTableRow>& rows,
+                                            size_t num_rows,
+                                            std::vector<bool>* matches) {
+  if (private_.get() == nullptr) {
+    matches->assign(num_rows, true);
+    return Status::OK();
+  }
+  return private_->EvalWhereBatch(rows, num_rows, matches);
+}
+
+bool DocPgExprExecutor::has_where_clause() const {
+  return private_ != nullptr && private_->has_where_clause();
+}
+
 }  // namespace docdb
 }  // namespace yb
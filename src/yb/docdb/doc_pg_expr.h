@@ -86,6 +86,18 @@ class DocPgExprExecutor {
                       std::vector<QLExprResult>* results,
                       bool* match);
 
+  // Evaluate the where clause for a batch of rows.
+  // The first num_rows entries of the rows vector are evaluated, and matches is resized to num_rows
+  // with the match flag of every row. Target expressions are not evaluated. Per row memory is
+  // released once per batch rather than once per row, so memory allocated while evaluating
+  // expressions is retained until the next call. The batch size should be reasonably small.
+  CHECKED_STATUS ExecWhere(const std::vector<QLTableRow>& rows,
+                           size_t num_rows,
+                           std::vector<bool>* matches);
+
+  // Returns true if any where clause expression has been added to the executor.
+  bool has_where_clause() const;
+
  private:
   // The relation schema
   const Schema *schema_;
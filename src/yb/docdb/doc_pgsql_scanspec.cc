@@ -23,6 +23,7 @@
 #include "yb/docdb/value_type.h"
 
 #include "yb/rocksdb/db/compaction.h"
+#include "yb/rocksdb/table/data_block_boundaries.h"
 
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
@@ -58,13 +59,23 @@ class PgsqlRangeBasedFileFilter : public rocksdb::ReadFileFilter {
   }
 
   bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    return BoundariesMayMatch(file.smallest, file.largest);
+  }
+
+  bool FilterDataBlock(const rocksdb::DataBlockBoundaries& block) const override {
+    return BoundariesMayMatch(block.smallest, block.largest);
+  }
+
+  template <class Boundaries>
+  bool BoundariesMayMatch(const Boundaries& smallest_values,
+                          const Boundaries& largest_values) const {
     for (size_t i = 0; i != lower_bounds_.size(); ++i) {
       const Slice lower_bound = lower_bounds_[i].AsSlice();
       const Slice upper_bound = upper_bounds_[i].AsSlice();
 
       rocksdb::UserBoundaryTag tag = TagForRangeComponent(i);
-      const Slice *smallest = file.smallest.user_value_with_tag(tag);
-      const Slice *largest = file.largest.user_value_with_tag(tag);
+      const Slice *smallest = smallest_values.user_value_with_tag(tag);
+      const Slice *largest = largest_values.user_value_with_tag(tag);
 
       if (!GreaterOrEquals(&upper_bound, smallest) || !GreaterOrEquals(largest, &lower_bound)) {
         return false;
@@ -27,6 +27,7 @@
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/subdoc_reader.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -130,49 +131,115 @@ CHECKED_STATUS DocDBTableReader::InitForKey(const Slice& sub_doc_key) {
 Result<bool> DocDBTableReader::Get(
     const Slice& root_doc_key, const vector<PrimitiveValue>* projection, SubDocument* result) {
   RETURN_NOT_OK(InitForKey(root_doc_key));
+  if (projection != nullptr) {
+    auto doc_found = VERIFY_RESULT(ReadProjection(
+        root_doc_key, *projection,
+        [result](size_t index, const PrimitiveValue& subkey, SubDocument* value) {
+          result->SetChild(subkey, std::move(*value));
+        }));
+    if (doc_found) {
+      return true;
+    }
+  }
+  return ReadWholeDocument(root_doc_key, result);
+}
+
+Result<bool> DocDBTableReader::GetProjected(
+    const Slice& root_doc_key, const vector<PrimitiveValue>& projection,
+    vector<boost::optional<SubDocument>>* projected_values) {
+  projected_values->resize(projection.size());
+  RETURN_NOT_OK(InitForKey(root_doc_key));
+  auto doc_found = VERIFY_RESULT(ReadProjection(
+      root_doc_key, projection,
+      [projected_values](size_t index, const PrimitiveValue& subkey, SubDocument* value) {
+        (*projected_values)[index] = std::move(*value);
+      }));
+  if (doc_found) {
+    return true;
+  }
+
+  SubDocument whole_doc;
+  if (!VERIFY_RESULT(ReadWholeDocument(root_doc_key, &whole_doc))) {
+    return false;
+  }
+  // Some non-projected column exists, so take projected values from the whole document.
+  for (size_t i = 0; i != projection.size(); ++i) {
+    SubDocument* child = whole_doc.GetChild(projection[i]);
+    if (child) {
+      (*projected_values)[i] = std::move(*child);
+    } else {
+      (*projected_values)[i] = boost::none;
+    }
+  }
+  return true;
+}
+
+template <class Consumer>
+Result<bool> DocDBTableReader::ReadProjection(
+    const Slice& root_doc_key, const vector<PrimitiveValue>& projection,
+    const Consumer& consumer) {
   // Seed key_bytes with the subdocument key. For each subkey in the projection, build subdocument
   // and reuse key_bytes while appending the subkey.
   KeyBytes key_bytes;
   // Preallocate some extra space to avoid allocation for small subkeys.
   key_bytes.Reserve(root_doc_key.size() + kMaxBytesPerEncodedHybridTime + 32);
   key_bytes.AppendRawBytes(root_doc_key);
-  if (projection != nullptr) {
-    bool doc_found = false;
-    const size_t subdocument_key_size = key_bytes.size();
-    for (const PrimitiveValue& subkey : *projection) {
-      // Append subkey to subdocument key. Reserve extra kMaxBytesPerEncodedHybridTime + 1 bytes in
-      // key_bytes to avoid the internal buffer from getting reallocated and moved by SeekForward()
-      // appending the hybrid time, thereby invalidating the buffer pointer saved by prefix_scope.
-      subkey.AppendToKey(&key_bytes);
-      key_bytes.Reserve(key_bytes.size() + kMaxBytesPerEncodedHybridTime + 1);
-      // This seek is to initialize the iterator for BuildSubDocument call.
-      iter_->SeekForward(&key_bytes);
-      SubDocument descendant;
-      auto reader = VERIFY_RESULT(subdoc_reader_builder_.Build(key_bytes));
-      RETURN_NOT_OK(reader->Get(&descendant));
-      doc_found = doc_found || (
-          descendant.value_type() != ValueType::kInvalid
-          && descendant.value_type() != ValueType::kTombstone);
-      result->SetChild(subkey, std::move(descendant));
-
-      // Restore subdocument key by truncating the appended subkey.
+  bool doc_found = false;
+  const size_t subdocument_key_size = key_bytes.size();
+  PackedRowDecoder packed_row_decoder;
+  const bool has_packed_row = !subdoc_reader_builder_.packed_row().empty();
+  if (has_packed_row) {
+    RETURN_NOT_OK(packed_row_decoder.Init(subdoc_reader_builder_.packed_row()));
+    // The packed row by itself means that the row exists.
+    doc_found = true;
+  }
+  for (size_t index = 0; index != projection.size(); ++index) {
+    const PrimitiveValue& subkey = projection[index];
+    // Append subkey to subdocument key. Reserve extra kMaxBytesPerEncodedHybridTime + 1 bytes in
+    // key_bytes to avoid the internal buffer from getting reallocated and moved by SeekForward()
+    // appending the hybrid time, thereby invalidating the buffer pointer saved by prefix_scope.
+    subkey.AppendToKey(&key_bytes);
+    key_bytes.Reserve(key_bytes.size() + kMaxBytesPerEncodedHybridTime + 1);
+    SubDocument descendant;
+    if (has_packed_row &&
+        VERIFY_RESULT(GetPackedColumn(subkey, key_bytes, packed_row_decoder, &descendant))) {
+      consumer(index, subkey, &descendant);
       key_bytes.Truncate(subdocument_key_size);
+      continue;
     }
-    if (doc_found) {
-      iter_->SeekOutOfSubDoc(root_doc_key);
-      return true;
+    // This seek is to initialize the iterator for BuildSubDocument call.
+    if (has_packed_row) {
+      // GetPackedColumn could move the iterator past the beginning of the column.
+      iter_->Seek(key_bytes);
+    } else {
+      iter_->SeekForward(&key_bytes);
     }
+    auto reader = VERIFY_RESULT(subdoc_reader_builder_.Build(key_bytes));
+    RETURN_NOT_OK(reader->Get(&descendant));
+    doc_found = doc_found || (
+        descendant.value_type() != ValueType::kInvalid
+        && descendant.value_type() != ValueType::kTombstone);
+    consumer(index, subkey, &descendant);
+
+    // Restore subdocument key by truncating the appended subkey.
+    key_bytes.Truncate(subdocument_key_size);
   }
+  if (doc_found) {
+    iter_->SeekOutOfSubDoc(root_doc_key);
+  }
+  return doc_found;
+}
 
+Result<bool> DocDBTableReader::ReadWholeDocument(const Slice& root_doc_key, SubDocument* result) {
   // If doc is not found, decide if some non-projection column exists.
   // Currently we read the whole doc here,
   // may be optimized by exiting on the first column in future.
-  // TODO -- is resetting *result = SubDocument() needed here?
   // TODO -- Add some metrics to understand:
   // (a) how often we scan back
   // (b) how often it's useful
   // Also maybe in debug mode add some every-n logging of the rocksdb values for which it is
   // useful
+  KeyBytes key_bytes(root_doc_key);
   iter_->Seek(key_bytes);
   auto reader = VERIFY_RESULT(subdoc_reader_builder_.Build(key_bytes));
   RETURN_NOT_OK(reader->Get(result));
@@ -180,5 +247,42 @@ Result<bool> DocDBTableReader::Get(
       && result->value_type() != ValueType::kTombstone;
 }
 
+Result<bool> DocDBTableReader::GetPackedColumn(
+    const PrimitiveValue& subkey, const KeyBytes& column_key, const PackedRowDecoder& decoder,
+    SubDocument* result) {
+  const bool is_liveness_column = subkey == PrimitiveValue::kLivenessColumn;
+  if (!is_liveness_column && subkey.value_type() != ValueType::kColumnId) {
+    return false;
+  }
+
+  const DocHybridTime& packed_row_write_time = subdoc_reader_builder_.packed_row_write_time();
+  DocHybridTime column_write_time = packed_row_write_time;
+  Slice column_value;
+  {
+    IntentAwareIteratorPrefixScope prefix_scope(column_key, iter_);
+    RETURN_NOT_OK(iter_->FindLatestRecord(column_key, &column_write_time, &column_value));
+  }
+  if (column_write_time != packed_row_write_time) {
+    return false;
+  }
+
+  if (is_liveness_column) {
+    *result = SubDocument(ValueType::kNullLow);
+    return true;
+  }
+
+  Slice encoded_value = decoder.GetValue(subkey.GetColumnId());
+  if (encoded_value.empty()) {
+    // Null columns are not stored in a packed row.
+    *result = SubDocument(ValueType::kInvalid);
+    return true;
+  }
+  PrimitiveValue value;
+  RETURN_NOT_OK(value.DecodeFromValue(encoded_value));
+  value.SetWriteTime(packed_row_write_time.hybrid_time().GetPhysicalValueMicros());
+  *result = SubDocument(std::move(value));
+  return true;
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -17,6 +17,8 @@
 #include <string>
 #include <vector>
 
+#include <boost/optional.hpp>
+
 #include "yb/docdb/docdb_fwd.h"
 #include "yb/rocksdb/cache.h"
 
@@ -93,6 +95,13 @@ class DocDBTableReader {
       const Slice& root_doc_key, const std::vector<PrimitiveValue>* projection,
       SubDocument* result);
 
+  // Same as Get, but instead of building a SubDocument rooted at root_doc_key, stores the value of
+  // each projected subkey to the entry of projected_values with the same index. Entries for subkeys
+  // that are not present in the document are set to none.
+  Result<bool> GetProjected(
+      const Slice& root_doc_key, const std::vector<PrimitiveValue>& projection,
+      std::vector<boost::optional<SubDocument>>* projected_values);
+
  private:
   // Initializes the reader to read a row at sub_doc_key by seeking to and reading obsolescence info
   // at that row.
@@ -102,6 +111,23 @@ class DocDBTableReader {
   // seek_fwd_suffices_ flag.
   void SeekTo(const Slice& subdoc_key);
 
+  // Reads each subkey in projection and passes its index, subkey and read value to consumer.
+  // Returns true if some projected subkey or a packed row was found.
+  template <class Consumer>
+  Result<bool> ReadProjection(
+      const Slice& root_doc_key, const std::vector<PrimitiveValue>& projection,
+      const Consumer& consumer);
+
+  // Reads the whole document at root_doc_key into result.
+  Result<bool> ReadWholeDocument(const Slice& root_doc_key, SubDocument* result);
+
+  // Reads the column identified by subkey from the packed row found at the root of the current
+  // document. Returns false if the column was written after the row was packed, so it should be
+  // read from its own entry.
+  Result<bool> GetPackedColumn(
+      const PrimitiveValue& subkey, const KeyBytes& column_key, const PackedRowDecoder& decoder,
+      SubDocument* result);
+
   // Owned by caller.
   IntentAwareIterator* iter_;
   DeadlineInfo deadline_info_;
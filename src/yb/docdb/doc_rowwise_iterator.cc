@@ -14,6 +14,7 @@
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include <iterator>
 
+#include <algorithm>
 #include <cstdint>
 #include <ostream>
 #include <string>
@@ -1288,8 +1289,8 @@ Result<bool> DocRowwiseIterator::HasNext() const {
       }
     }
 
-    row_ = SubDocument();
-    auto doc_found_res = doc_reader_->Get(sub_doc_key, &projection_subkeys_, &row_);
+    auto doc_found_res = doc_reader_->GetProjected(
+        sub_doc_key, projection_subkeys_, &projected_values_);
     if (!doc_found_res.ok()) {
       has_next_status_ = doc_found_res.status();
       return has_next_status_;
@@ -1390,7 +1391,7 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
     const auto& column_id = projection.column_id(i);
     const auto ql_type = projection.column(i).type();
-    const SubDocument* column_value = row_.GetChild(PrimitiveValue(column_id));
+    const SubDocument* column_value = GetProjectedValue(PrimitiveValue(column_id));
     if (column_value != nullptr) {
       QLTableColumn& column = table_row->AllocColumn(column_id);
       SubDocument::ToQLValuePB(*column_value, ql_type, &column.value);
@@ -1405,8 +1406,17 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+const SubDocument* DocRowwiseIterator::GetProjectedValue(const PrimitiveValue& subkey) const {
+  auto it = std::lower_bound(projection_subkeys_.begin(), projection_subkeys_.end(), subkey);
+  if (it == projection_subkeys_.end() || *it != subkey) {
+    return nullptr;
+  }
+  const auto& value = projected_values_[it - projection_subkeys_.begin()];
+  return value ? value.get_ptr() : nullptr;
+}
+
 bool DocRowwiseIterator::LivenessColumnExists() const {
-  const SubDocument* subdoc = row_.GetChild(PrimitiveValue::kLivenessColumn);
+  const SubDocument* subdoc = GetProjectedValue(PrimitiveValue::kLivenessColumn);
   return subdoc != nullptr && subdoc->value_type() != ValueType::kInvalid;
 }
 
@@ -1461,7 +1471,13 @@ Result<bool> DocRowwiseIterator::SeekTuple(const Slice& tuple_id) {
       tuple_key_->Truncate(1 + size);
     }
     tuple_key_->AppendRawBytes(tuple_id);
-    db_iter_->Seek(*tuple_key_);
+    if (seek_tuple_forward_) {
+      db_iter_->SeekForward(&*tuple_key_);
+    } else {
+      db_iter_->Seek(*tuple_key_);
+    }
+  } else if (seek_tuple_forward_) {
+    db_iter_->SeekForward(tuple_id);
   } else {
     db_iter_->Seek(tuple_id);
   }
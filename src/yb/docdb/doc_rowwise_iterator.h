@@ -116,6 +116,12 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
     debug_dump_ = value;
   }
 
+  // When set, SeekTuple uses SeekForward, so it could reuse the current iterator position.
+  // Tuple ids passed to SeekTuple must then be in increasing order.
+  void set_seek_tuple_forward(bool value) {
+    seek_tuple_forward_ = value;
+  }
+
  private:
   template <class T>
   CHECKED_STATUS DoInit(const T& spec);
@@ -163,6 +169,10 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  // Returns the value of the given projected subkey read for the current row, or nullptr if it is
+  // not present in the row.
+  const SubDocument* GetProjectedValue(const PrimitiveValue& subkey) const;
+
   const Schema& projection_;
   // Used to maintain ownership of projection_.
   // Separate field is used since ownership could be optional.
@@ -199,8 +209,8 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   // Indicates whether we've already finished iterating.
   mutable bool done_;
 
-  // HasNext constructs the whole row's SubDocument.
-  mutable SubDocument row_;
+  // HasNext reads values of projection_subkeys_ for the current row, in the same order.
+  mutable std::vector<boost::optional<SubDocument>> projected_values_;
 
   // The current row's primary key. It is set to lower bound in the beginning.
   mutable Slice row_key_;
@@ -229,6 +239,8 @@ class DocRowwiseIterator : public YQLRowwiseIteratorIf {
   mutable bool ignore_ttl_ = false;
 
   bool debug_dump_ = false;
+
+  bool seek_tuple_forward_ = false;
 };
 
 }  // namespace docdb
@@ -329,6 +329,22 @@ CHECKED_STATUS DocWriteBatch::SetPrimitiveInternal(
   return Status::OK();
 }
 
+Status DocWriteBatch::SetPackedRow(const Slice& encoded_doc_key, std::string packed_row) {
+  if (put_batch_.size() > numeric_limits<IntraTxnWriteId>::max()) {
+    return STATUS_SUBSTITUTE(
+        NotSupported,
+        "Trying to add more than $0 key/value pairs in the same single-shard txn.",
+        numeric_limits<IntraTxnWriteId>::max());
+  }
+  DCHECK_EQ(DecodeValueType(packed_row), ValueType::kPackedRow);
+
+  const auto write_id = static_cast<IntraTxnWriteId>(put_batch_.size());
+  key_prefix_.Reset(encoded_doc_key);
+  put_batch_.emplace_back(key_prefix_.ToStringBuffer(), std::move(packed_row));
+  cache_.Put(key_prefix_, DocHybridTime(HybridTime::kMax, write_id), ValueType::kPackedRow);
+  return Status::OK();
+}
+
 Status DocWriteBatch::SetPrimitive(
     const DocPath& doc_path,
     const Value& value,
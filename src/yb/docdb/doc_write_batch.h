@@ -186,6 +186,10 @@ class DocWriteBatch {
                         read_ht, deadline, query_id, user_timestamp);
   }
 
+  // Writes the row encoded by RowPacker at the root of the document identified by encoded_doc_key.
+  // The packed row overwrites all previously written columns of this document.
+  CHECKED_STATUS SetPackedRow(const Slice& encoded_doc_key, std::string packed_row);
+
   void Clear();
   bool IsEmpty() const { return put_batch_.empty(); }
 
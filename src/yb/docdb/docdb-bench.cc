@@ -0,0 +1,225 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Benchmarks of DocDB hot paths: doc key encoding and decoding, row writes, with and without
+// packing, and DocRowwiseIterator scans of plain rows and of rows with pending transaction intents.
+//
+// Each benchmark logs a single line prefixed with "BENCHMARK_RESULT", followed by a JSON object
+// with the number of operations, throughput and CPU time per operation, so results could be
+// collected by scripts.
+
+#include <string>
+#include <vector>
+
+#include "yb/common/ql_expr.h"
+#include "yb/common/ql_value.h"
+#include "yb/common/read_hybrid_time.h"
+#include "yb/common/transaction-test-util.h"
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_rowwise_iterator.h"
+#include "yb/docdb/doc_write_batch.h"
+#include "yb/docdb/docdb_test_base.h"
+#include "yb/docdb/docdb_test_util.h"
+#include "yb/docdb/packed_row.h"
+
+#include "yb/util/format.h"
+#include "yb/util/stopwatch.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+DEFINE_int32(docdb_bench_num_rows, 100000, "Number of rows written by each DocDB benchmark.");
+DEFINE_int32(docdb_bench_num_scans, 5, "Number of full scans performed by scan benchmarks.");
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr int kNumValueColumns = 4;
+constexpr int kFirstValueColumnId = 11;
+constexpr int kRowsPerBatch = 100;
+
+const auto kWriteTime = HybridTime::FromMicros(1000);
+const auto kIntentsWriteTime = HybridTime::FromMicros(2000);
+const auto kReadTime = ReadHybridTime::FromMicros(2500);
+
+Schema BenchSchema() {
+  std::vector<ColumnSchema> columns;
+  std::vector<ColumnId> ids;
+  columns.emplace_back("k", DataType::INT64, /* is_nullable = */ false);
+  ids.emplace_back(kFirstValueColumnId - 1);
+  for (int i = 0; i != kNumValueColumns; ++i) {
+    columns.emplace_back(
+        Format("c$0", i), i % 2 ? DataType::STRING : DataType::INT64, /* is_nullable = */ true);
+    ids.emplace_back(kFirstValueColumnId + i);
+  }
+  return Schema(columns, ids, 1);
+}
+
+KeyBytes RowKey(int row) {
+  return DocKey(std::vector<PrimitiveValue>{PrimitiveValue(static_cast<int64_t>(row))}).Encode();
+}
+
+PrimitiveValue ColumnValue(int row, int column) {
+  if (column % 2) {
+    return PrimitiveValue(Format("value_$0_$1", row, column));
+  }
+  return PrimitiveValue(static_cast<int64_t>(row) * kNumValueColumns + column);
+}
+
+void LogResult(const std::string& name, int64_t num_ops, const CpuTimes& elapsed) {
+  LOG(INFO) << "BENCHMARK_RESULT " << Format(
+      R"({"name": "$0", "ops": $1, "wall_sec": $2, "ops_per_sec": $3, )"
+      R"("user_cpu_us_per_op": $4, "sys_cpu_us_per_op": $5})",
+      name, num_ops, elapsed.wall_seconds(), num_ops / elapsed.wall_seconds(),
+      elapsed.user / 1000.0 / num_ops, elapsed.system / 1000.0 / num_ops);
+}
+
+} // namespace
+
+class DocDBBench : public DocDBTestBase {
+ protected:
+  DocDBBench() : schema_(BenchSchema()) {}
+
+  // Writes FLAGS_docdb_bench_num_rows rows, one entry per column or one packed row per row.
+  void WriteRows(bool packed, HybridTime hybrid_time) {
+    auto dwb = MakeDocWriteBatch();
+    for (int row = 0; row != FLAGS_docdb_bench_num_rows; ++row) {
+      auto key = RowKey(row);
+      if (packed) {
+        RowPacker packer(/* schema_version= */ 0);
+        for (int column = 0; column != kNumValueColumns; ++column) {
+          ASSERT_OK(packer.AddValue(
+              ColumnId(kFirstValueColumnId + column), ColumnValue(row, column)));
+        }
+        ASSERT_OK(dwb.SetPackedRow(key.AsSlice(), packer.Complete()));
+      } else {
+        for (int column = 0; column != kNumValueColumns; ++column) {
+          ASSERT_OK(dwb.SetPrimitive(
+              DocPath(key, PrimitiveValue(ColumnId(kFirstValueColumnId + column))),
+              ColumnValue(row, column)));
+        }
+      }
+      if ((row + 1) % kRowsPerBatch == 0) {
+        ASSERT_OK(WriteToRocksDBAndClear(&dwb, hybrid_time));
+      }
+    }
+    ASSERT_OK(WriteToRocksDBAndClear(&dwb, hybrid_time));
+  }
+
+  void BenchmarkWrite(const std::string& name, bool packed) {
+    Stopwatch sw(Stopwatch::THIS_THREAD);
+    sw.start();
+    ASSERT_NO_FATALS(WriteRows(packed, kWriteTime));
+    sw.stop();
+    LogResult(name, FLAGS_docdb_bench_num_rows, sw.elapsed());
+  }
+
+  void BenchmarkScan(const std::string& name, const TransactionOperationContext& txn_op_context) {
+    ASSERT_OK(FlushRocksDbAndWait());
+
+    QLTableRow row;
+    int64_t num_rows = 0;
+    Stopwatch sw(Stopwatch::THIS_THREAD);
+    sw.start();
+    for (int i = 0; i != FLAGS_docdb_bench_num_scans; ++i) {
+      DocRowwiseIterator iter(
+          schema_, schema_, txn_op_context, doc_db(), CoarseTimePoint::max() /* deadline */,
+          kReadTime);
+      ASSERT_OK(iter.Init(YQL_TABLE_TYPE));
+      while (ASSERT_RESULT(iter.HasNext())) {
+        ASSERT_OK(iter.NextRow(&row));
+        ++num_rows;
+      }
+    }
+    sw.stop();
+    ASSERT_EQ(num_rows, static_cast<int64_t>(FLAGS_docdb_bench_num_rows) *
+                        FLAGS_docdb_bench_num_scans);
+    LogResult(name, num_rows, sw.elapsed());
+  }
+
+  Schema schema_;
+};
+
+// Encodes and decodes short keys, as most of DocDB keys are, with hashed string and integer
+// components and an integer range component.
+TEST_F(DocDBBench, EncodeDecodeKeys) {
+  std::vector<DocKey> doc_keys;
+  doc_keys.reserve(FLAGS_docdb_bench_num_rows);
+  for (int row = 0; row != FLAGS_docdb_bench_num_rows; ++row) {
+    doc_keys.emplace_back(
+        static_cast<DocKeyHash>(row),
+        std::vector<PrimitiveValue>{
+            PrimitiveValue(Format("user_$0", row)), PrimitiveValue(static_cast<int64_t>(row))},
+        std::vector<PrimitiveValue>{PrimitiveValue(static_cast<int64_t>(row) * 2)});
+  }
+
+  std::vector<KeyBytes> encoded_keys;
+  encoded_keys.reserve(doc_keys.size());
+  Stopwatch sw(Stopwatch::THIS_THREAD);
+  sw.start();
+  for (const auto& doc_key : doc_keys) {
+    encoded_keys.push_back(doc_key.Encode());
+  }
+  sw.stop();
+  LogResult("encode_keys", encoded_keys.size(), sw.elapsed());
+
+  DocKey decoded;
+  sw.start();
+  for (const auto& encoded_key : encoded_keys) {
+    ASSERT_OK(decoded.FullyDecodeFrom(encoded_key.AsSlice()));
+  }
+  sw.stop();
+  LogResult("decode_keys", encoded_keys.size(), sw.elapsed());
+  ASSERT_EQ(decoded, doc_keys.back());
+}
+
+TEST_F(DocDBBench, WriteRows) {
+  BenchmarkWrite("write_rows", /* packed= */ false);
+}
+
+TEST_F(DocDBBench, WritePackedRows) {
+  BenchmarkWrite("write_packed_rows", /* packed= */ true);
+}
+
+TEST_F(DocDBBench, ScanRows) {
+  ASSERT_NO_FATALS(WriteRows(/* packed= */ false, kWriteTime));
+  BenchmarkScan("scan_rows", kNonTransactionalOperationContext);
+}
+
+TEST_F(DocDBBench, ScanPackedRows) {
+  ASSERT_NO_FATALS(WriteRows(/* packed= */ true, kWriteTime));
+  BenchmarkScan("scan_packed_rows", kNonTransactionalOperationContext);
+}
+
+// Scans committed rows that are all overwritten by a transaction that is still pending at the
+// read time, so every row goes through intent resolution.
+TEST_F(DocDBBench, ScanRowsWithIntents) {
+  ASSERT_NO_FATALS(WriteRows(/* packed= */ false, kWriteTime));
+
+  TransactionStatusManagerMock txn_status_manager;
+  SetTransactionIsolationLevel(IsolationLevel::SNAPSHOT_ISOLATION);
+  auto txn_id = TransactionId::GenerateRandom();
+  SetCurrentTransactionId(txn_id);
+  ASSERT_NO_FATALS(WriteRows(/* packed= */ false, kIntentsWriteTime));
+  ResetCurrentTransactionId();
+  txn_status_manager.Commit(txn_id, HybridTime::FromMicros(3000));
+
+  BenchmarkScan(
+      "scan_rows_with_intents",
+      TransactionOperationContext(TransactionId::GenerateRandom(), &txn_status_manager));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -41,6 +41,18 @@ using rocksdb::FilterDecision;
 namespace yb {
 namespace docdb {
 
+namespace {
+
+// Control fields are stored before the primitive value, each of them starts with its own value
+// type. So we could check for their presence without decoding the value.
+bool MayHaveControlFields(const Slice& value) {
+  const auto value_type = DecodeValueType(value);
+  return value_type == ValueType::kMergeFlags || value_type == ValueType::kHybridTime ||
+         value_type == ValueType::kTtl || value_type == ValueType::kUserTimestamp;
+}
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 
 DocDBCompactionFilter::DocDBCompactionFilter(
@@ -202,7 +214,7 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
   //
   // TODO: could there be a case when there is still a read request running that uses an old schema,
   //       and we end up removing some data that the client expects to see?
-  if (sub_key_ends_.size() > 1) {
+  if (sub_key_ends_.size() > 1 && !retention_.deleted_cols->empty()) {
     // Column ID is the first subkey in every CQL row.
     if (key[sub_key_ends_[0]]  == ValueTypeAsChar::kColumnId) {
       Slice column_id_slice(key.data() + sub_key_ends_[0] + 1, key.data() + sub_key_ends_[1]);
@@ -219,7 +231,10 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
 
   Value value;
   Slice value_slice = existing_value;
-  RETURN_NOT_OK(value.DecodeControlFields(&value_slice));
+  // Most of the values don't have control fields, so we decode them only when present.
+  if (value_slice.empty() || MayHaveControlFields(value_slice)) {
+    RETURN_NOT_OK(value.DecodeControlFields(&value_slice));
+  }
   const auto value_type = static_cast<ValueType>(
       value_slice.FirstByteOr(ValueTypeAsChar::kInvalid));
   const Expiration curr_exp(ht.hybrid_time(), value.ttl());
@@ -384,6 +399,10 @@ HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective()
           ShouldRetainDeleteMarkersInMajorCompaction::kFalse};
 }
 
+HistoryRetentionDirective ManualHistoryRetentionPolicy::ProposedRetentionDirective() {
+  return GetRetentionDirective();
+}
+
 void ManualHistoryRetentionPolicy::SetHistoryCutoff(HybridTime history_cutoff) {
   history_cutoff_.store(history_cutoff, std::memory_order_release);
 }
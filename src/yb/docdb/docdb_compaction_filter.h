@@ -169,6 +169,10 @@ class HistoryRetentionPolicy {
  public:
   virtual ~HistoryRetentionPolicy() = default;
   virtual HistoryRetentionDirective GetRetentionDirective() = 0;
+
+  // Returns the directive that GetRetentionDirective would return now, without committing its
+  // history cutoff.
+  virtual HistoryRetentionDirective ProposedRetentionDirective() = 0;
 };
 
 class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
@@ -191,6 +195,8 @@ class ManualHistoryRetentionPolicy : public HistoryRetentionPolicy {
  public:
   HistoryRetentionDirective GetRetentionDirective() override;
 
+  HistoryRetentionDirective ProposedRetentionDirective() override;
+
   void SetHistoryCutoff(HybridTime history_cutoff);
 
   void AddDeletedColumn(ColumnId col);
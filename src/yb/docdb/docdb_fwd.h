@@ -33,10 +33,13 @@ class DocRowwiseIterator;
 class DocWriteBatch;
 class HistoryRetentionPolicy;
 class IntentAwareIterator;
+class IntentKeysFilter;
 class KeyBytes;
 class ManualHistoryRetentionPolicy;
+class PackedRowDecoder;
 class PgsqlWriteOperation;
 class PrimitiveValue;
+class QLRowCache;
 class QLWriteOperation;
 class RedisWriteOperation;
 class SharedLockManager;
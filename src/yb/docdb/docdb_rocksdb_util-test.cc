@@ -26,12 +26,27 @@ DECLARE_int32(priority_thread_pool_size);
 DECLARE_int32(block_restart_interval);
 DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
+DECLARE_int32(max_nexts_to_avoid_seek);
+DECLARE_int32(max_nexts_to_avoid_seek_adaptive_limit);
 
 namespace yb {
 namespace docdb {
 
 class DocDBRocksDBUtilTest : public YBTest {};
 
+namespace {
+
+// Simulates seeks to keys that are located the specified number of Next() calls away.
+void SimulateSeeks(AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek, int distance, int num_seeks) {
+  for (int i = 0; i != num_seeks; ++i) {
+    const auto max_nexts = nexts_to_avoid_seek->StartSeek();
+    const bool reached = distance <= max_nexts;
+    nexts_to_avoid_seek->FinishSeek(reached ? distance : max_nexts, reached);
+  }
+}
+
+} // namespace
+
 TEST_F(DocDBRocksDBUtilTest, MaxBackgroundFlushesDefault) {
   FLAGS_num_cpus = 16;
   auto options = TEST_AutoInitFromRocksDBFlags();
@@ -210,5 +225,33 @@ TEST_F(DocDBRocksDBUtilTest, RocksDBRateLimiter) {
   }
 }
 
+TEST_F(DocDBRocksDBUtilTest, AdaptiveNextsToAvoidSeekDisabled) {
+  FLAGS_max_nexts_to_avoid_seek = 3;
+  FLAGS_max_nexts_to_avoid_seek_adaptive_limit = 0;
+  AdaptiveNextsToAvoidSeek nexts_to_avoid_seek;
+  SimulateSeeks(&nexts_to_avoid_seek, 10, 1000);
+  ASSERT_EQ(nexts_to_avoid_seek.StartSeek(), 3);
+  ASSERT_EQ(nexts_to_avoid_seek.max_nexts(), 3);
+}
+
+TEST_F(DocDBRocksDBUtilTest, AdaptiveNextsToAvoidSeek) {
+  FLAGS_max_nexts_to_avoid_seek = 2;
+  FLAGS_max_nexts_to_avoid_seek_adaptive_limit = 8;
+  AdaptiveNextsToAvoidSeek nexts_to_avoid_seek;
+  ASSERT_EQ(nexts_to_avoid_seek.max_nexts(), 2);
+
+  // Keys are close enough, so Next() calls are cheaper than Seek().
+  SimulateSeeks(&nexts_to_avoid_seek, 5, 1000);
+  ASSERT_EQ(nexts_to_avoid_seek.max_nexts(), 5);
+
+  // Keys are too far, so Next() calls are just wasted.
+  SimulateSeeks(&nexts_to_avoid_seek, 20, 4000);
+  ASSERT_EQ(nexts_to_avoid_seek.max_nexts(), 0);
+
+  // Keys are adjacent again.
+  SimulateSeeks(&nexts_to_avoid_seek, 1, 4000);
+  ASSERT_EQ(nexts_to_avoid_seek.max_nexts(), 1);
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -13,6 +13,8 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <thread>
 
@@ -36,14 +38,17 @@
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/rate_limiter.h"
+#include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/table.h"
 #include "yb/rocksdb/table/filtering_iterator.h"
 #include "yb/rocksdb/types.h"
 #include "yb/rocksdb/util/compression.h"
+#include "yb/rocksdb/util/statistics.h"
 
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/priority_thread_pool.h"
 #include "yb/util/result.h"
 #include "yb/util/size_literals.h"
@@ -82,7 +87,10 @@ DEFINE_uint64(rocksdb_universal_compaction_always_include_size_threshold, 64_MB,
 DEFINE_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
 DEFINE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 1_GB,
-             "Use to control write rate of flush and compaction.");
+             "Use to control write rate of flush and compaction. When the rate limiter is shared "
+             "across the tablet server, changes are applied to the running rate limiter, "
+             "otherwise they affect RocksDB instances opened after the change.");
+TAG_FLAG(rocksdb_compact_flush_rate_limit_bytes_per_sec, runtime);
 DEFINE_string(rocksdb_compact_flush_rate_limit_sharing_mode, "tserver",
               "Allows to control rate limit sharing/calculation across RocksDB instances\n"
               "  tserver - rate limit is shared across all RocksDB instances"
@@ -92,8 +100,16 @@ DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximum number of key range subcompactions a single RocksDB compaction could be split "
+             "into. Subcompactions run in parallel in the priority thread pool. 1 - disabled.");
 DEFINE_int32(rocksdb_max_write_buffer_number, 2,
              "Maximum number of write buffers that are built up in memory.");
+DEFINE_uint64(rocksdb_max_manifest_file_size, 64_MB,
+             "Size of RocksDB MANIFEST file after which a new MANIFEST file, that starts with a "
+             "snapshot of the current version, is written. Limits the number of version edits "
+             "that are replayed when the tablet is opened. 0 - unlimited.");
+TAG_FLAG(rocksdb_max_manifest_file_size, advanced);
 
 DEFINE_int64(db_block_size_bytes, 32_KB,
              "Size of RocksDB data block (in bytes).");
@@ -119,6 +135,11 @@ DEFINE_bool(use_docdb_aware_bloom_filter, true,
 DEFINE_int32(max_nexts_to_avoid_seek, 2,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
 
+DEFINE_int32(max_nexts_to_avoid_seek_adaptive_limit, 0,
+             "Max number of next calls that DocDB iterators could choose to try before doing a "
+             "rocksdb seek, based on the observed distances to the seek keys. 0 to always use "
+             "max_nexts_to_avoid_seek.");
+
 DEFINE_bool(use_multi_level_index, true, "Whether to use multi-level data index.");
 
 DEFINE_string(
@@ -126,6 +147,16 @@ DEFINE_string(
     "Key-value encoding to use for regular data blocks in RocksDB. Possible options: "
     "shared_prefix, three_shared_parts");
 
+DEFINE_bool(regular_tablets_store_data_block_boundaries, false,
+            "Whether SST files of regular tablets should store min/max values of the DocDB range "
+            "key components of each data block, so scans with range column bounds could skip data "
+            "blocks that cannot match.");
+
+DEFINE_bool(regular_tablets_data_block_hash_index, false,
+            "Whether data blocks of regular tablets SST files should contain hash index over "
+            "DocKeys, so point reads could find the restart interval without binary search. SST "
+            "files written with this option can't be read by versions without its support.");
+
 DEFINE_uint64(initial_seqno, 1ULL << 50, "Initial seqno for new RocksDB instances.");
 
 DEFINE_int32(num_reserved_small_compaction_threads, -1, "Number of reserved small compaction "
@@ -143,6 +174,15 @@ DEFINE_string(compression_type, "Snappy",
               "On-disk compression type to use in RocksDB."
               "By default, Snappy is used if supported.");
 
+DEFINE_int32(rocksdb_compression_max_dict_bytes, 16_KB,
+             "Maximum size of the dictionary trained for each SST file written by compaction, "
+             "used to compress its data blocks. Only applies to ZSTD compression, 0 disables "
+             "dictionaries.");
+
+DEFINE_bool(rocksdb_pin_top_level_index, false,
+            "Keep the top level data index of each SST file in memory instead of the block cache, "
+            "so it is never evicted. Lower levels of the multi-level index are still cached.");
+
 DEFINE_int32(block_restart_interval, kDefaultBlockStartInterval,
              "Controls the number of keys to look at for computing the diff encoding.");
 
@@ -158,7 +198,8 @@ Result<rocksdb::CompressionType> GetConfiguredCompressionType(const std::string&
     rocksdb::kNoCompression,
     rocksdb::kSnappyCompression,
     rocksdb::kZlibCompression,
-    rocksdb::kLZ4Compression
+    rocksdb::kLZ4Compression,
+    rocksdb::kZSTDNotFinalCompression
   };
   for (const auto& compression_type : kValidRocksDBCompressionTypes) {
     if (flag_value == rocksdb::CompressionTypeToString(compression_type)) {
@@ -230,15 +271,90 @@ namespace docdb {
 
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
 
-void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter) {
+constexpr int AdaptiveNextsToAvoidSeek::kMaxLimit;
+constexpr uint32_t AdaptiveNextsToAvoidSeek::kExplorationPeriod;
+constexpr uint32_t AdaptiveNextsToAvoidSeek::kSamplesPerAdjustment;
+constexpr int AdaptiveNextsToAvoidSeek::kSeekCost;
+
+AdaptiveNextsToAvoidSeek::AdaptiveNextsToAvoidSeek(rocksdb::Statistics* statistics)
+    : statistics_(statistics),
+      max_nexts_(std::max(FLAGS_max_nexts_to_avoid_seek, 0)),
+      limit_(std::min(std::max(FLAGS_max_nexts_to_avoid_seek_adaptive_limit, 0), kMaxLimit)) {
+  samples_.fill(0);
+  if (limit_ != 0) {
+    max_nexts_ = std::min(max_nexts_, limit_);
+  }
+}
+
+AdaptiveNextsToAvoidSeek::~AdaptiveNextsToAvoidSeek() {
+  if (nexts_) {
+    rocksdb::RecordTick(statistics_, rocksdb::NUMBER_DB_NEXT_TO_AVOID_SEEK, nexts_);
+  }
+  if (seeks_avoided_) {
+    rocksdb::RecordTick(statistics_, rocksdb::NUMBER_DB_SEEK_AVOIDED, seeks_avoided_);
+  }
+  if (seeks_after_nexts_) {
+    rocksdb::RecordTick(statistics_, rocksdb::NUMBER_DB_SEEK_AFTER_NEXT, seeks_after_nexts_);
+  }
+}
+
+int AdaptiveNextsToAvoidSeek::StartSeek() {
+  exploring_ = limit_ != 0 && num_seeks_++ % kExplorationPeriod == 0;
+  return exploring_ ? limit_ : max_nexts_;
+}
+
+void AdaptiveNextsToAvoidSeek::FinishSeek(int nexts, bool reached) {
+  nexts_ += nexts;
+  if (reached) {
+    if (nexts) {
+      ++seeks_avoided_;
+    }
+  } else if (nexts) {
+    ++seeks_after_nexts_;
+  }
+  if (!exploring_) {
+    return;
+  }
+  exploring_ = false;
+  ++samples_[reached ? nexts : limit_ + 1];
+  if (++num_samples_ >= kSamplesPerAdjustment) {
+    Adjust();
+  }
+}
+
+void AdaptiveNextsToAvoidSeek::Adjust() {
+  // Cost of a seek that tries n Next() calls is the distance to the seek key, when it is reachable
+  // within n calls, otherwise it is n plus the cost of the actual Seek().
+  uint64_t best_cost = std::numeric_limits<uint64_t>::max();
+  for (int n = 0; n <= limit_; ++n) {
+    uint64_t cost = 0;
+    for (int distance = 0; distance <= limit_ + 1; ++distance) {
+      cost += static_cast<uint64_t>(samples_[distance]) *
+              (distance <= n ? distance : n + kSeekCost);
+    }
+    if (cost < best_cost) {
+      best_cost = cost;
+      max_nexts_ = n;
+    }
+  }
+  // Halve the samples, so the choice follows changes of the access pattern.
+  for (auto& count : samples_) {
+    count /= 2;
+  }
+  num_samples_ /= 2;
+}
+
+void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter,
+                 AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek) {
   if (!iter->Valid() || iter->key().compare(slice) >= 0) {
     return;
   }
-  ROCKSDB_SEEK(iter, slice);
+  ROCKSDB_SEEK_ADAPTIVE(iter, slice, nexts_to_avoid_seek);
 }
 
-void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter) {
-  SeekForward(key_bytes.AsSlice(), iter);
+void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter,
+                 AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek) {
+  SeekForward(key_bytes.AsSlice(), iter, nexts_to_avoid_seek);
 }
 
 KeyBytes AppendDocHt(const Slice& key, const DocHybridTime& doc_ht) {
@@ -248,39 +364,52 @@ KeyBytes AppendDocHt(const Slice& key, const DocHybridTime& doc_ht) {
   return KeyBytes(key, Slice(buf, end));
 }
 
-void SeekPastSubKey(const Slice& key, rocksdb::Iterator* iter) {
-  SeekForward(AppendDocHt(key, DocHybridTime::kMin), iter);
+void SeekPastSubKey(const Slice& key, rocksdb::Iterator* iter,
+                    AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek) {
+  SeekForward(AppendDocHt(key, DocHybridTime::kMin), iter, nexts_to_avoid_seek);
 }
 
-void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter) {
+void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter,
+                     AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek) {
   key_bytes->AppendValueType(ValueType::kMaxByte);
-  SeekForward(*key_bytes, iter);
+  SeekForward(*key_bytes, iter, nexts_to_avoid_seek);
   key_bytes->RemoveValueTypeSuffix(ValueType::kMaxByte);
 }
 
 void SeekPossiblyUsingNext(rocksdb::Iterator* iter, const Slice& seek_key,
+                           AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek,
                            int* next_count, int* seek_count) {
-  for (int nexts = FLAGS_max_nexts_to_avoid_seek; nexts-- > 0;) {
+  const int max_nexts = nexts_to_avoid_seek ? nexts_to_avoid_seek->StartSeek()
+                                            : FLAGS_max_nexts_to_avoid_seek;
+  int nexts = 0;
+  for (;;) {
     if (!iter->Valid() || iter->key().compare(seek_key) >= 0) {
       VTRACE(3, "Did $0 Next(s) instead of a Seek", nexts);
-      return;
+      break;
+    }
+    if (nexts >= max_nexts) {
+      VTRACE(3, "Forced to do an actual Seek after $0 Next(s)", nexts);
+      iter->Seek(seek_key);
+      ++*seek_count;
+      break;
     }
     VLOG(4) << "Skipping: " << SubDocKey::DebugSliceToString(iter->key());
 
     iter->Next();
-    ++*next_count;
+    ++nexts;
+  }
+  *next_count += nexts;
+  if (nexts_to_avoid_seek) {
+    nexts_to_avoid_seek->FinishSeek(nexts, *seek_count == 0);
   }
-
-  VTRACE(3, "Forced to do an actual Seek after $0 Next(s)", FLAGS_max_nexts_to_avoid_seek);
-  iter->Seek(seek_key);
-  ++*seek_count;
 }
 
 void PerformRocksDBSeek(
     rocksdb::Iterator *iter,
     const rocksdb::Slice &seek_key,
     const char* file_name,
-    int line) {
+    int line,
+    AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek) {
   int next_count = 0;
   int seek_count = 0;
   if (seek_key.size() == 0) {
@@ -290,7 +419,7 @@ void PerformRocksDBSeek(
     iter->Seek(seek_key);
     ++seek_count;
   } else {
-    SeekPossiblyUsingNext(iter, seek_key, &next_count, &seek_count);
+    SeekPossiblyUsingNext(iter, seek_key, nexts_to_avoid_seek, &next_count, &seek_count);
   }
   VLOG(4) << Substitute(
       "PerformRocksDBSeek at $0:$1:\n"
@@ -361,8 +490,18 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
   // TODO(dtxn) do we need separate options for intents db?
   rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
       user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
+  // Reads that use bloom filter only access keys with the same hashed or first range components as
+  // user_key_for_filter.
+  Slice key_prefix;
+  if (bloom_filter_mode == BloomFilterMode::USE_BLOOM_FILTER && user_key_for_filter) {
+    auto prefix_size = DocKey::EncodedSize(
+        *user_key_for_filter, DocKeyPart::kUpToHashOrFirstRange);
+    if (prefix_size.ok()) {
+      key_prefix = user_key_for_filter->Prefix(*prefix_size);
+    }
+  }
   return std::make_unique<IntentAwareIterator>(
-      doc_db, read_opts, deadline, read_time, txn_op_context);
+      doc_db, read_opts, deadline, read_time, txn_op_context, key_prefix);
 }
 
 namespace {
@@ -564,6 +703,20 @@ int32_t GetGlobalRocksDBPriorityThreadPoolSize() {
   return priority_thread_pool_size;
 }
 
+namespace {
+
+// Returns the encoded DocKey that the key starts with, so subcompactions never split records of
+// the same document. Keys that do not start with a DocKey are returned as is.
+Slice SubcompactionKeyPrefix(Slice key) {
+  auto doc_key_size = DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey);
+  if (!doc_key_size.ok()) {
+    return key;
+  }
+  return key.Prefix(*doc_key_size);
+}
+
+} // namespace
+
 void InitRocksDBOptions(
     rocksdb::Options* options, const string& log_prefix,
     const shared_ptr<rocksdb::Statistics>& statistics,
@@ -598,6 +751,7 @@ void InitRocksDBOptions(
   // Since the flag validator for FLAGS_compression_type will fail if the result of this call is not
   // OK, this CHECK_RESULT should never fail and is safe.
   options->compression = CHECK_RESULT(GetConfiguredCompressionType(FLAGS_compression_type));
+  options->compression_opts.max_dict_bytes = FLAGS_rocksdb_compression_max_dict_bytes;
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -606,12 +760,15 @@ void InitRocksDBOptions(
   // Set block cache options.
   if (tablet_options.block_cache) {
     table_options.block_cache = tablet_options.block_cache;
+    table_options.index_and_filter_block_cache = tablet_options.index_and_filter_block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
+    table_options.pin_top_level_index = FLAGS_rocksdb_pin_top_level_index;
   } else {
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
   }
+  table_options.persistent_cache = tablet_options.persistent_cache;
 
   AutoInitFromBlockBasedTableOptions(&table_options);
 
@@ -663,6 +820,9 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    options->max_subcompactions = std::max(FLAGS_rocksdb_max_subcompactions, 1);
+    options->subcompaction_key_prefix_extractor =
+        std::make_shared<std::function<Slice(Slice)>>(&SubcompactionKeyPrefix);
     options->rate_limiter = tablet_options.rate_limiter ? tablet_options.rate_limiter
                                                         : CreateRocksDBRateLimiter();
   } else {
@@ -671,6 +831,9 @@ void InitRocksDBOptions(
   }
 
   options->max_write_buffer_number = FLAGS_rocksdb_max_write_buffer_number;
+  if (FLAGS_rocksdb_max_manifest_file_size > 0) {
+    options->max_manifest_file_size = FLAGS_rocksdb_max_manifest_file_size;
+  }
 
   options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
       0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
@@ -931,9 +1094,11 @@ Status RocksDBPatcher::UpdateFileSizes() {
   return impl_->UpdateFileSizes();
 }
 
-Status ForceRocksDBCompact(rocksdb::DB* db) {
+Status ForceRocksDBCompact(rocksdb::DB* db, uint32_t target_path_id) {
+  rocksdb::CompactRangeOptions options;
+  options.target_path_id = target_path_id;
   RETURN_NOT_OK_PREPEND(
-      db->CompactRange(rocksdb::CompactRangeOptions(), /* begin = */ nullptr, /* end = */ nullptr),
+      db->CompactRange(options, /* begin = */ nullptr, /* end = */ nullptr),
       "Compact range failed:");
   return Status::OK();
 }
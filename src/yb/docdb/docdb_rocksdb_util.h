@@ -14,6 +14,8 @@
 #ifndef YB_DOCDB_DOCDB_ROCKSDB_UTIL_H_
 #define YB_DOCDB_DOCDB_ROCKSDB_UTIL_H_
 
+#include <array>
+
 #include <boost/optional.hpp>
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
@@ -33,32 +35,87 @@ namespace docdb {
 
 class IntentAwareIterator;
 
+// Chooses the number of Next() calls that a seek of a single iterator tries before falling back to
+// the actual Seek(). Every kExplorationPeriod-th seek tries up to the adaptive limit of Next()
+// calls and records how many of them were needed to reach the seek key. From these samples the
+// number of Next() calls that minimizes the expected cost of a seek is picked.
+// Also counts Next() calls done to avoid seeks and reports them to RocksDB statistics when
+// destroyed.
+class AdaptiveNextsToAvoidSeek {
+ public:
+  static constexpr int kMaxLimit = 32;
+  static constexpr uint32_t kExplorationPeriod = 16;
+  static constexpr uint32_t kSamplesPerAdjustment = 16;
+  // Approximate cost of Seek() in units of Next() calls.
+  static constexpr int kSeekCost = 8;
+
+  explicit AdaptiveNextsToAvoidSeek(rocksdb::Statistics* statistics = nullptr);
+  ~AdaptiveNextsToAvoidSeek();
+
+  AdaptiveNextsToAvoidSeek(const AdaptiveNextsToAvoidSeek&) = delete;
+  void operator=(const AdaptiveNextsToAvoidSeek&) = delete;
+
+  // Returns the max number of Next() calls to try for the seek that is being started.
+  int StartSeek();
+
+  // Records the outcome of the seek started by StartSeek. nexts is the number of Next() calls
+  // done, reached is false when the actual Seek() was done after them.
+  void FinishSeek(int nexts, bool reached);
+
+  int max_nexts() const { return max_nexts_; }
+
+ private:
+  void Adjust();
+
+  rocksdb::Statistics* const statistics_;
+  // Max number of Next() calls tried by the regular seeks.
+  int max_nexts_;
+  // Max number of Next() calls tried by the exploration seeks. Zero if adaptation is disabled.
+  const int limit_;
+  uint32_t num_seeks_ = 0;
+  uint32_t num_samples_ = 0;
+  bool exploring_ = false;
+  // Number of exploration seeks that reached the seek key with the specified number of Next()
+  // calls. The last element is used for seeks that did not reach it in limit_ calls.
+  std::array<uint32_t, kMaxLimit + 2> samples_;
+
+  uint64_t nexts_ = 0;
+  uint64_t seeks_avoided_ = 0;
+  uint64_t seeks_after_nexts_ = 0;
+};
+
 // See to a rocksdb point that is at least sub_doc_key.
 // If the iterator is already positioned far enough, does not perform a seek.
-void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter);
+void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter,
+                 AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek = nullptr);
 
-void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter);
+void SeekForward(const KeyBytes& key_bytes, rocksdb::Iterator *iter,
+                 AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek = nullptr);
 
 // When we replace HybridTime::kMin in the end of seek key, next seek will skip older versions of
 // this key, but will not skip any subkeys in its subtree. If the iterator is already positioned far
 // enough, does not perform a seek.
-void SeekPastSubKey(const Slice& key, rocksdb::Iterator* iter);
+void SeekPastSubKey(const Slice& key, rocksdb::Iterator* iter,
+                    AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek = nullptr);
 
 // Seek out of the given SubDocKey. For efficiency, the method that takes a non-const KeyBytes
 // pointer avoids memory allocation by using the KeyBytes buffer to prepare the key to seek to by
 // appending an extra byte. The appended byte is removed when the method returns.
-void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter);
+void SeekOutOfSubKey(KeyBytes* key_bytes, rocksdb::Iterator* iter,
+                     AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek = nullptr);
 
 KeyBytes AppendDocHt(const Slice& key, const DocHybridTime& doc_ht);
 
 // A wrapper around the RocksDB seek operation that uses Next() up to the configured number of
-// times to avoid invalidating iterator state. In debug mode it also allows printing detailed
-// information about RocksDB seeks.
+// times to avoid invalidating iterator state. When nexts_to_avoid_seek is specified, it is used to
+// pick the number of Next() calls instead of the max_nexts_to_avoid_seek flag. In debug mode it
+// also allows printing detailed information about RocksDB seeks.
 void PerformRocksDBSeek(
     rocksdb::Iterator *iter,
     const rocksdb::Slice &seek_key,
     const char* file_name,
-    int line);
+    int line,
+    AdaptiveNextsToAvoidSeek* nexts_to_avoid_seek = nullptr);
 
 // TODO: is there too much overhead in passing file name and line here in release mode?
 #define ROCKSDB_SEEK(iter, key) \
@@ -66,6 +123,11 @@ void PerformRocksDBSeek(
     PerformRocksDBSeek((iter), (key), __FILE__, __LINE__); \
   } while (0)
 
+#define ROCKSDB_SEEK_ADAPTIVE(iter, key, nexts_to_avoid_seek) \
+  do { \
+    PerformRocksDBSeek((iter), (key), __FILE__, __LINE__, (nexts_to_avoid_seek)); \
+  } while (0)
+
 enum class BloomFilterMode {
   USE_BLOOM_FILTER,
   DONT_USE_BLOOM_FILTER,
@@ -100,7 +162,8 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     const Slice* iterate_upper_bound = nullptr);
 
 // Request RocksDB compaction and wait until it completes.
-CHECKED_STATUS ForceRocksDBCompact(rocksdb::DB* db);
+// Output is placed in db_paths[target_path_id].
+CHECKED_STATUS ForceRocksDBCompact(rocksdb::DB* db, uint32_t target_path_id = 0);
 
 rocksdb::Options TEST_AutoInitFromRocksDBFlags();
 
@@ -109,6 +109,10 @@ class NonTransactionalStatusProvider: public TransactionStatusManager {
     return HybridTime::kMax;
   }
 
+  bool MayHaveIntentsWithPrefix(const Slice& key_prefix) const override {
+    return false;
+  }
+
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override {
     return STATUS(NotSupported, "WaitForSafeTime not implemented");
   }
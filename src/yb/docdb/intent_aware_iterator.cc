@@ -229,6 +229,10 @@ std::string EncodeHybridTime(HybridTime value) {
   return DocHybridTime(value, kMaxWriteId).EncodedInDocDbFormat();
 }
 
+rocksdb::Statistics* DocDBStatistics(rocksdb::DB* db) {
+  return db ? db->GetOptions().statistics.get() : nullptr;
+}
+
 } // namespace
 
 IntentAwareIterator::IntentAwareIterator(
@@ -236,7 +240,8 @@ IntentAwareIterator::IntentAwareIterator(
     const rocksdb::ReadOptions& read_opts,
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
-    const TransactionOperationContext& txn_op_context)
+    const TransactionOperationContext& txn_op_context,
+    const Slice& key_prefix)
     : read_time_(read_time),
       encoded_read_time_read_(EncodeHybridTime(read_time_.read)),
       encoded_read_time_local_limit_(EncodeHybridTime(read_time_.local_limit)),
@@ -245,6 +250,8 @@ IntentAwareIterator::IntentAwareIterator(
           read_time_.local_limit > read_time_.read ? Slice(encoded_read_time_local_limit_)
                                                    : Slice(encoded_read_time_read_)),
       txn_op_context_(txn_op_context),
+      intent_nexts_to_avoid_seek_(DocDBStatistics(doc_db.intents)),
+      regular_nexts_to_avoid_seek_(DocDBStatistics(doc_db.regular)),
       transaction_status_cache_(txn_op_context_, read_time, deadline) {
   VTRACE(1, __func__);
   VLOG(4) << "IntentAwareIterator, read_time: " << read_time
@@ -253,7 +260,9 @@ IntentAwareIterator::IntentAwareIterator(
   if (txn_op_context) {
     VTRACE(1, "Checking MinRunningTime");
     const auto min_running_ht = txn_op_context.txn_status_manager->MinRunningHybridTime();
-    if (min_running_ht != HybridTime::kMax && min_running_ht < read_time.global_limit) {
+    if (min_running_ht != HybridTime::kMax && min_running_ht < read_time.global_limit &&
+        (key_prefix.empty() ||
+         txn_op_context.txn_status_manager->MayHaveIntentsWithPrefix(key_prefix))) {
       intent_iter_ = docdb::CreateRocksDBIterator(doc_db.intents,
                                                   doc_db.key_bounds,
                                                   docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
@@ -264,7 +273,8 @@ IntentAwareIterator::IntentAwareIterator(
     } else {
       VLOG(4) << "No relevant transactions running: "
               << "min_running_ht=" << min_running_ht << ", "
-              << "global_limit=" << read_time.global_limit;
+              << "global_limit=" << read_time.global_limit << ", "
+              << "key_prefix=" << key_prefix.ToDebugHexString();
     }
   }
   VTRACE(2, "Done Checking MinRunningTime");
@@ -293,7 +303,7 @@ void IntentAwareIterator::Seek(const Slice& key) {
     return;
   }
 
-  ROCKSDB_SEEK(&iter_, key);
+  ROCKSDB_SEEK_ADAPTIVE(&iter_, key, &regular_nexts_to_avoid_seek_);
   skip_future_records_needed_ = true;
 
   if (intent_iter_.Initialized()) {
@@ -359,7 +369,7 @@ void IntentAwareIterator::SeekPastSubKey(const Slice& key) {
     return;
   }
 
-  docdb::SeekPastSubKey(key, &iter_);
+  docdb::SeekPastSubKey(key, &iter_, &regular_nexts_to_avoid_seek_);
   skip_future_records_needed_ = true;
   if (intent_iter_.Initialized() && status_.ok()) {
     // Skip all intents for subdoc_key.
@@ -374,7 +384,7 @@ void IntentAwareIterator::SeekOutOfSubDoc(KeyBytes* key_bytes) {
     return;
   }
 
-  docdb::SeekOutOfSubKey(key_bytes, &iter_);
+  docdb::SeekOutOfSubKey(key_bytes, &iter_, &regular_nexts_to_avoid_seek_);
   skip_future_records_needed_ = true;
   if (intent_iter_.Initialized() && status_.ok()) {
     // See comment for SubDocKey::AdvanceOutOfSubDoc.
@@ -479,7 +489,7 @@ Status IntentAwareIterator::NextFullValue(
 bool IntentAwareIterator::PreparePrev(const Slice& key) {
   VLOG(4) << __func__ << "(" << SubDocKey::DebugSliceToString(key) << ")";
 
-  ROCKSDB_SEEK(&iter_, key);
+  ROCKSDB_SEEK_ADAPTIVE(&iter_, key, &regular_nexts_to_avoid_seek_);
 
   if (iter_.Valid()) {
     iter_.Prev();
@@ -490,7 +500,8 @@ bool IntentAwareIterator::PreparePrev(const Slice& key) {
 
   if (intent_iter_.Initialized()) {
     ResetIntentUpperbound();
-    ROCKSDB_SEEK(&intent_iter_, GetIntentPrefixForKeyWithoutHt(key));
+    ROCKSDB_SEEK_ADAPTIVE(
+        &intent_iter_, GetIntentPrefixForKeyWithoutHt(key), &intent_nexts_to_avoid_seek_);
     if (intent_iter_.Valid()) {
       intent_iter_.Prev();
     } else {
@@ -566,7 +577,7 @@ void IntentAwareIterator::SeekIntentIterIfNeeded() {
       break;
     case SeekIntentIterNeeded::kSeek:
       VLOG(4) << __func__ << ", seek: " << SubDocKey::DebugSliceToString(seek_key_buffer_);
-      ROCKSDB_SEEK(&intent_iter_, seek_key_buffer_);
+      ROCKSDB_SEEK_ADAPTIVE(&intent_iter_, seek_key_buffer_, &intent_nexts_to_avoid_seek_);
       SeekToSuitableIntent<Direction::kForward>();
       seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
       return;
@@ -645,7 +656,7 @@ Slice IntentAwareIterator::value() {
 
 void IntentAwareIterator::SeekForwardRegular(const Slice& slice) {
   VLOG(4) << "SeekForwardRegular(" << SubDocKey::DebugSliceToString(slice) << ")";
-  docdb::SeekForward(slice, &iter_);
+  docdb::SeekForward(slice, &iter_, &regular_nexts_to_avoid_seek_);
   skip_future_records_needed_ = true;
 }
 
@@ -738,7 +749,8 @@ void IntentAwareIterator::SeekForwardToSuitableIntent() {
     }
   }
 
-  docdb::SeekForward(seek_key_buffer_.AsSlice(), &intent_iter_);
+  docdb::SeekForward(
+      seek_key_buffer_.AsSlice(), &intent_iter_, &intent_nexts_to_avoid_seek_);
   SeekToSuitableIntent<Direction::kForward>();
 }
 
@@ -20,6 +20,7 @@
 #include "yb/common/read_hybrid_time.h"
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/key_bytes.h"
 #include "yb/docdb/transaction_status_cache.h"
 
@@ -58,6 +59,9 @@ struct FetchKeyResult {
 //
 // KeyBytes/Slice passed to Seek* methods should not contain hybrid time.
 // HybridTime of subdoc_key in Seek* methods would be ignored.
+//
+// When key_prefix is not empty, all keys read through the iterator should start with it. It is used
+// to avoid creating intents DB iterator when running transactions don't have intents for such keys.
 class IntentAwareIterator {
  public:
   IntentAwareIterator(
@@ -65,7 +69,8 @@ class IntentAwareIterator {
       const rocksdb::ReadOptions& read_opts,
       CoarseTimePoint deadline,
       const ReadHybridTime& read_time,
-      const TransactionOperationContext& txn_op_context);
+      const TransactionOperationContext& txn_op_context,
+      const Slice& key_prefix = Slice());
 
   IntentAwareIterator(const IntentAwareIterator& other) = delete;
   void operator=(const IntentAwareIterator& other) = delete;
@@ -287,6 +292,9 @@ class IntentAwareIterator {
   const TransactionOperationContext txn_op_context_;
   docdb::BoundedRocksDbIterator intent_iter_;
   docdb::BoundedRocksDbIterator iter_;
+  // Pick the number of Next() calls to try before Seek() for intent_iter_ and iter_ respectively.
+  AdaptiveNextsToAvoidSeek intent_nexts_to_avoid_seek_;
+  AdaptiveNextsToAvoidSeek regular_nexts_to_avoid_seek_;
   // iter_valid_ is true if and only if iter_ is positioned at key which matches top prefix from
   // the stack and record time satisfies read_time_ criteria.
   bool iter_valid_ = false;
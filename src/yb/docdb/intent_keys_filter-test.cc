@@ -0,0 +1,100 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <limits>
+#include <string>
+
+#include "yb/docdb/intent_keys_filter.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr size_t kNumCounters = 1024;
+
+std::string Key(int i) {
+  return "key" + std::to_string(i);
+}
+
+} // namespace
+
+class IntentKeysFilterTest : public YBTest {
+};
+
+TEST_F(IntentKeysFilterTest, AddRemove) {
+  constexpr int kNumKeys = 100;
+  IntentKeysFilter filter(kNumCounters);
+  ASSERT_TRUE(filter.enabled());
+  for (int i = 0; i != kNumKeys; ++i) {
+    ASSERT_FALSE(filter.MayContain(Key(i)));
+  }
+
+  // Each key is added twice, as for two intents of the same doc path.
+  for (int i = 0; i != kNumKeys; ++i) {
+    filter.Add(Key(i));
+    filter.Add(Key(i));
+  }
+  for (int i = 0; i != kNumKeys; ++i) {
+    ASSERT_TRUE(filter.MayContain(Key(i)));
+  }
+
+  for (int i = 0; i != kNumKeys; ++i) {
+    filter.Remove(Key(i));
+  }
+  for (int i = 0; i != kNumKeys; ++i) {
+    ASSERT_TRUE(filter.MayContain(Key(i)));
+  }
+
+  for (int i = 0; i != kNumKeys; ++i) {
+    filter.Remove(Key(i));
+  }
+  for (int i = 0; i != kNumKeys; ++i) {
+    ASSERT_FALSE(filter.MayContain(Key(i)));
+  }
+}
+
+TEST_F(IntentKeysFilterTest, NoFalseNegatives) {
+  // Use a small filter, so counters are shared by many keys.
+  constexpr size_t kSmallNumCounters = 16;
+  constexpr int kNumKeys = 1000;
+  IntentKeysFilter filter(kSmallNumCounters);
+  for (int i = 0; i != kNumKeys; ++i) {
+    filter.Add(Key(i));
+  }
+  // Remove even keys, all odd keys should still be reported.
+  for (int i = 0; i < kNumKeys; i += 2) {
+    filter.Remove(Key(i));
+  }
+  for (int i = 1; i < kNumKeys; i += 2) {
+    ASSERT_TRUE(filter.MayContain(Key(i))) << i;
+  }
+}
+
+TEST_F(IntentKeysFilterTest, Saturation) {
+  constexpr int kNumAdds = std::numeric_limits<uint16_t>::max() + 10;
+  IntentKeysFilter filter(kNumCounters);
+  for (int i = 0; i != kNumAdds; ++i) {
+    filter.Add(Key(0));
+  }
+  // Saturated counters are not decremented, so the key stays in the filter.
+  for (int i = 0; i != kNumAdds; ++i) {
+    filter.Remove(Key(0));
+  }
+  ASSERT_TRUE(filter.MayContain(Key(0)));
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,131 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/intent_keys_filter.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "yb/docdb/bounded_rocksdb_iterator.h"
+#include "yb/docdb/conflict_resolution.h"
+#include "yb/docdb/docdb-internal.h"
+#include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/key_bounds.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/hash_util.h"
+#include "yb/util/logging.h"
+#include "yb/util/status.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr size_t kNumProbes = 2;
+constexpr uint64_t kHashSeed = 0x3a5b1c7e9d2f4861ULL;
+constexpr uint16_t kSaturated = std::numeric_limits<uint16_t>::max();
+
+uint64_t DocPathHash(Slice doc_path) {
+  return HashUtil::MurmurHash2_64(doc_path.data(), doc_path.size(), kHashSeed);
+}
+
+} // namespace
+
+IntentKeysFilter::IntentKeysFilter(size_t num_counters)
+    : num_counters_(std::max<size_t>(num_counters, 1)),
+      counters_(new std::atomic<uint16_t>[num_counters_]) {
+  for (size_t i = 0; i != num_counters_; ++i) {
+    counters_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+IntentKeysFilter::~IntentKeysFilter() = default;
+
+std::atomic<uint16_t>& IntentKeysFilter::Counter(uint64_t hash, size_t idx) const {
+  // Use the two halves of the hash as two independent hash functions.
+  auto probe_hash = idx == 0 ? hash : (hash >> 32) | (hash << 32);
+  return counters_[probe_hash % num_counters_];
+}
+
+void IntentKeysFilter::Add(Slice doc_path) {
+  auto hash = DocPathHash(doc_path);
+  for (size_t i = 0; i != kNumProbes; ++i) {
+    auto& counter = Counter(hash, i);
+    auto value = counter.load(std::memory_order_acquire);
+    while (value != kSaturated &&
+           !counter.compare_exchange_weak(value, value + 1, std::memory_order_acq_rel)) {
+    }
+  }
+}
+
+void IntentKeysFilter::Remove(Slice doc_path) {
+  auto hash = DocPathHash(doc_path);
+  for (size_t i = 0; i != kNumProbes; ++i) {
+    auto& counter = Counter(hash, i);
+    auto value = counter.load(std::memory_order_acquire);
+    // Counter could be zero only if loading failed, the filter is disabled in this case.
+    while (value != kSaturated && value != 0 &&
+           !counter.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel)) {
+    }
+  }
+}
+
+bool IntentKeysFilter::MayContain(Slice doc_path) const {
+  if (!enabled()) {
+    return true;
+  }
+  auto hash = DocPathHash(doc_path);
+  for (size_t i = 0; i != kNumProbes; ++i) {
+    if (Counter(hash, i).load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Status IntentKeysFilter::Load(rocksdb::DB* intents_db) {
+  // Keep the filter disabled until all intents are added.
+  enabled_.store(false, std::memory_order_release);
+  for (size_t i = 0; i != num_counters_; ++i) {
+    counters_[i].store(0, std::memory_order_relaxed);
+  }
+
+  auto iter = CreateRocksDBIterator(
+      intents_db, &KeyBounds::kNoBounds, BloomFilterMode::DONT_USE_BLOOM_FILTER,
+      boost::none /* user_key_for_filter */, rocksdb::kDefaultQueryId);
+  size_t num_intents = 0;
+  for (iter.SeekToFirst(); iter.Valid(); iter.Next()) {
+    auto key = iter.key();
+    if (GetKeyType(key, StorageDbType::kIntents) != KeyType::kIntentKey ||
+        key[0] == ValueTypeAsChar::kTransactionApplyState) {
+      continue;
+    }
+    auto intent = ParseIntentKey(key, Slice());
+    if (!intent.ok()) {
+      LOG(WARNING) << "Intent keys filter disabled, failed to parse "
+                   << key.ToDebugHexString() << ": " << intent.status();
+      return Status::OK();
+    }
+    Add(intent->doc_path);
+    ++num_intents;
+  }
+  RETURN_NOT_OK(iter.status());
+
+  VLOG(1) << "Loaded " << num_intents << " intents to intent keys filter";
+  enabled_.store(true, std::memory_order_release);
+  return Status::OK();
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,72 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_INTENT_KEYS_FILTER_H
+#define YB_DOCDB_INTENT_KEYS_FILTER_H
+
+#include <atomic>
+#include <memory>
+
+#include "yb/rocksdb/rocksdb_fwd.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+// Per-tablet counting bloom filter of doc paths that have intents in the intents DB, both strong
+// and weak ones. It is used by conflict resolution to skip seeking the intents DB for keys that
+// definitely have no live intents.
+//
+// The filter never reports an absent doc path for a key that has intents, as long as every intent
+// written to the intents DB is added before it is written, and removed only when the intent is
+// deleted. Intents that disappear by other means, e.g. during compaction, just leave stale
+// counts, i.e. false positives. Counters that reach their max value are never decremented.
+//
+// This class is thread-safe.
+class IntentKeysFilter {
+ public:
+  explicit IntentKeysFilter(size_t num_counters);
+  ~IntentKeysFilter();
+
+  // Should be called before the intent for doc_path is written to the intents DB.
+  void Add(Slice doc_path);
+
+  // Should be called when the intent for doc_path is deleted from the intents DB.
+  void Remove(Slice doc_path);
+
+  // Returns false only if there are no intents for doc_path.
+  bool MayContain(Slice doc_path) const;
+
+  // Resets the filter and adds doc paths of all intents that are present in intents_db. The filter
+  // is disabled, i.e. MayContain always returns true, if some intent could not be parsed.
+  // Should not be called concurrently with other methods.
+  CHECKED_STATUS Load(rocksdb::DB* intents_db);
+
+  bool enabled() const {
+    return enabled_.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::atomic<uint16_t>& Counter(uint64_t hash, size_t idx) const;
+
+  const size_t num_counters_;
+  std::unique_ptr<std::atomic<uint16_t>[]> counters_;
+  std::atomic<bool> enabled_{true};
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_INTENT_KEYS_FILTER_H
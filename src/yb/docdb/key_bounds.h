@@ -14,6 +14,7 @@
 #ifndef YB_DOCDB_KEY_BOUNDS_H
 #define YB_DOCDB_KEY_BOUNDS_H
 
+#include "yb/docdb/docdb_fwd.h"
 #include "yb/docdb/key_bytes.h"
 #include "yb/rocksdb/rocksdb_fwd.h"
 
@@ -52,13 +53,15 @@ struct DocDB {
   rocksdb::DB* regular = nullptr;
   rocksdb::DB* intents = nullptr;
   const KeyBounds* key_bounds = nullptr;
+  // Optional filter of keys that have intents, used to skip lookups in the intents DB.
+  IntentKeysFilter* intent_keys_filter = nullptr;
 
   static DocDB FromRegularUnbounded(rocksdb::DB* regular) {
     return {regular, nullptr /* intents */, &KeyBounds::kNoBounds};
   }
 
   DocDB WithoutIntents() {
-    return {regular, nullptr /* intents */, key_bounds};
+    return {regular, nullptr /* intents */, key_bounds, nullptr /* intent_keys_filter */};
   }
 };
 
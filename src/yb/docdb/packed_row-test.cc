@@ -0,0 +1,75 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+#include "yb/docdb/primitive_value.h"
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class PackedRowTest : public YBTest {
+};
+
+TEST_F(PackedRowTest, PackUnpack) {
+  RowPacker packer(/* schema_version= */ 3);
+  ASSERT_OK(packer.AddValue(ColumnId(11), PrimitiveValue(100)));
+  ASSERT_OK(packer.AddValue(ColumnId(12), PrimitiveValue::kTombstone));
+  ASSERT_OK(packer.AddValue(ColumnId(15), PrimitiveValue("value")));
+  auto packed_row = packer.Complete();
+  ASSERT_EQ(ValueType::kPackedRow, DecodeValueType(packed_row));
+
+  PackedRowDecoder decoder;
+  ASSERT_OK(decoder.Init(packed_row));
+  ASSERT_EQ(3U, decoder.schema_version());
+  // Null columns are not packed.
+  ASSERT_EQ(2U, decoder.num_columns());
+  ASSERT_TRUE(decoder.GetValue(ColumnId(12)).empty());
+  ASSERT_TRUE(decoder.GetValue(ColumnId(13)).empty());
+
+  PrimitiveValue value;
+  ASSERT_OK(value.DecodeFromValue(decoder.GetValue(ColumnId(11))));
+  ASSERT_EQ(PrimitiveValue(100), value);
+  ASSERT_OK(value.DecodeFromValue(decoder.GetValue(ColumnId(15))));
+  ASSERT_EQ(PrimitiveValue("value"), value);
+
+  // Packed row is a valid DocDB value, its columns are accessed through the decoder.
+  Value decoded_value;
+  ASSERT_OK(decoded_value.Decode(packed_row));
+  ASSERT_EQ(ValueType::kPackedRow, decoded_value.value_type());
+}
+
+TEST_F(PackedRowTest, ColumnOrder) {
+  RowPacker packer(/* schema_version= */ 0);
+  ASSERT_OK(packer.AddValue(ColumnId(12), PrimitiveValue(1)));
+  ASSERT_NOK(packer.AddValue(ColumnId(12), PrimitiveValue(2)));
+  ASSERT_NOK(packer.AddValue(ColumnId(11), PrimitiveValue(3)));
+}
+
+TEST_F(PackedRowTest, Corruption) {
+  RowPacker packer(/* schema_version= */ 1);
+  ASSERT_OK(packer.AddValue(ColumnId(11), PrimitiveValue("some text")));
+  auto packed_row = packer.Complete();
+
+  PackedRowDecoder decoder;
+  ASSERT_NOK(decoder.Init(Slice(packed_row.data(), packed_row.size() - 1)));
+  ASSERT_NOK(decoder.Init(packed_row + "x"));
+  ASSERT_NOK(decoder.Init(packed_row.substr(1)));
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,114 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/packed_row.h"
+
+#include <algorithm>
+
+#include "yb/docdb/primitive_value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/gutil/casts.h"
+
+#include "yb/util/fast_varint.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
+
+namespace yb {
+namespace docdb {
+
+RowPacker::RowPacker(uint32_t schema_version) : schema_version_(schema_version) {}
+
+Status RowPacker::AddValue(ColumnId column_id, const PrimitiveValue& value) {
+  if (column_id.rep() <= last_column_id_) {
+    return STATUS_FORMAT(
+        InvalidArgument, "Columns should be packed in ascending order: $0 after $1",
+        column_id, last_column_id_);
+  }
+  last_column_id_ = column_id.rep();
+  if (value.value_type() == ValueType::kTombstone) {
+    // Null columns are not stored in a packed row.
+    return Status::OK();
+  }
+  values_.emplace_back(column_id.rep(), value.ToValue());
+  return Status::OK();
+}
+
+std::string RowPacker::Complete() {
+  size_t total_size = 1 + 2 * util::kMaxVarIntBufferSize;
+  for (const auto& column_and_value : values_) {
+    total_size += 2 * util::kMaxVarIntBufferSize + column_and_value.second.size();
+  }
+
+  std::string result;
+  result.reserve(total_size);
+  result.push_back(ValueTypeAsChar::kPackedRow);
+  util::FastAppendUnsignedVarIntToStr(schema_version_, &result);
+  util::FastAppendUnsignedVarIntToStr(values_.size(), &result);
+  for (const auto& column_and_value : values_) {
+    util::FastAppendSignedVarIntToBuffer(column_and_value.first, &result);
+    util::FastAppendUnsignedVarIntToStr(column_and_value.second.size(), &result);
+    result.append(column_and_value.second);
+  }
+  values_.clear();
+  return result;
+}
+
+Status PackedRowDecoder::Init(const Slice& packed_row) {
+  Slice input = packed_row;
+  columns_.clear();
+  if (ConsumeValueType(&input) != ValueType::kPackedRow) {
+    return STATUS_FORMAT(Corruption, "Not a packed row: $0", packed_row.ToDebugHexString());
+  }
+  schema_version_ = narrow_cast<uint32_t>(VERIFY_RESULT(util::FastDecodeUnsignedVarInt(&input)));
+  auto num_columns = VERIFY_RESULT(util::FastDecodeUnsignedVarInt(&input));
+  columns_.reserve(num_columns);
+  for (uint64_t i = 0; i != num_columns; ++i) {
+    // Use the bounds-checked decoder: it never reads before packed_row.data(), while the unsafe
+    // one could read up to 7 bytes before the value when the row starts at a buffer boundary.
+    int64_t column_id;
+    size_t decoded_size;
+    RETURN_NOT_OK(util::FastDecodeSignedVarInt(
+        input.cdata(), input.size(), packed_row.cdata(), &column_id, &decoded_size));
+    input.remove_prefix(decoded_size);
+    auto size = VERIFY_RESULT(util::FastDecodeUnsignedVarInt(&input));
+    if (size == 0 || size > input.size()) {
+      return STATUS_FORMAT(
+          Corruption, "Bad size of packed column $0: $1, bytes left: $2",
+          column_id, size, input.size());
+    }
+    columns_.emplace_back(narrow_cast<ColumnIdRep>(column_id), Slice(input.data(), size));
+    input.remove_prefix(size);
+  }
+  if (!input.empty()) {
+    return STATUS_FORMAT(
+        Corruption, "Extra data after packed row with $0 columns: $1",
+        num_columns, input.ToDebugHexString());
+  }
+  return Status::OK();
+}
+
+Slice PackedRowDecoder::GetValue(ColumnId column_id) const {
+  auto it = std::lower_bound(
+      columns_.begin(), columns_.end(), column_id.rep(),
+      [](const std::pair<ColumnIdRep, Slice>& lhs, ColumnIdRep rhs) {
+    return lhs.first < rhs;
+  });
+  if (it == columns_.end() || it->first != column_id.rep()) {
+    return Slice();
+  }
+  return it->second;
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,84 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PACKED_ROW_H_
+#define YB_DOCDB_PACKED_ROW_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "yb/common/column_id.h"
+
+#include "yb/docdb/docdb_fwd.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status_fwd.h"
+
+namespace yb {
+namespace docdb {
+
+// A packed row stores all non-key columns of a row in a single value written at the document key,
+// instead of one RocksDB entry per column. Its encoding is:
+//   ValueType::kPackedRow
+//   unsigned varint  schema version the row was packed with
+//   unsigned varint  number of packed columns
+//   for each column, in ascending column id order:
+//     signed varint    column id
+//     unsigned varint  size of the encoded column value
+//     bytes            column value, encoded with PrimitiveValue::ToValue
+// Columns that are null are not packed. Column updates written after the packed row are stored as
+// regular per-column entries and take precedence over the packed value while reading.
+class RowPacker {
+ public:
+  explicit RowPacker(uint32_t schema_version);
+
+  // Columns should be added in ascending column id order.
+  CHECKED_STATUS AddValue(ColumnId column_id, const PrimitiveValue& value);
+
+  // Returns the encoded packed row. The packer should not be used after this call.
+  std::string Complete();
+
+ private:
+  uint32_t schema_version_;
+  ColumnIdRep last_column_id_ = -1;
+  std::vector<std::pair<ColumnIdRep, std::string>> values_;
+};
+
+// Provides access to the columns of an encoded packed row. The decoder does not copy column data,
+// so the encoded row should outlive the decoder.
+class PackedRowDecoder {
+ public:
+  PackedRowDecoder() = default;
+
+  // Parses the packed row. The provided slice should start with ValueType::kPackedRow.
+  CHECKED_STATUS Init(const Slice& packed_row);
+
+  uint32_t schema_version() const { return schema_version_; }
+
+  size_t num_columns() const { return columns_.size(); }
+
+  // Returns the encoded value of the given column, or an empty slice if it was not packed.
+  Slice GetValue(ColumnId column_id) const;
+
+  const std::vector<std::pair<ColumnIdRep, Slice>>& columns() const { return columns_; }
+
+ private:
+  uint32_t schema_version_ = 0;
+  std::vector<std::pair<ColumnIdRep, Slice>> columns_;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_PACKED_ROW_H_
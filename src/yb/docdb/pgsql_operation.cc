@@ -13,7 +13,9 @@
 
 #include "yb/docdb/pgsql_operation.h"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -34,13 +36,17 @@
 #include "yb/docdb/docdb_pgapi.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value_util.h"
 #include "yb/docdb/ql_storage_interface.h"
 
+#include "yb/util/atomic.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/result.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
 
 #include "yb/yql/pggate/util/pg_doc_data.h"
@@ -69,6 +75,39 @@ DEFINE_bool(pgsql_consistent_transactional_paging, true,
             "be stale. The latter is preferable for long scans. The data returned for the first "
             "page of results is never stale regardless of this flag.");
 
+DEFINE_bool(ysql_enable_packed_row, false,
+            "Whether inserted YSQL rows should be stored as a single packed value instead of one "
+            "value per column. Updates of packed rows are still written per column.");
+TAG_FLAG(ysql_enable_packed_row, experimental);
+TAG_FLAG(ysql_enable_packed_row, runtime);
+
+DEFINE_uint64(ysql_scan_filter_batch_size, 64,
+              "Number of rows fetched by a YSQL table scan before the pushed down where clause is "
+              "evaluated for all of them at once. Set to 1 to evaluate the where clause row by "
+              "row.");
+TAG_FLAG(ysql_scan_filter_batch_size, advanced);
+TAG_FLAG(ysql_scan_filter_batch_size, runtime);
+
+DEFINE_int32(ysql_aggregate_scan_parallelism, 1,
+             "Maximal number of key ranges that are scanned in parallel by a YSQL aggregate read "
+             "of a tablet. Ranges are bounded by keys taken from the SST file boundaries, their "
+             "partial aggregates are merged. Set to 1 to scan the tablet sequentially.");
+TAG_FLAG(ysql_aggregate_scan_parallelism, advanced);
+TAG_FLAG(ysql_aggregate_scan_parallelism, runtime);
+
+DEFINE_uint64(ysql_max_aggregate_groups_per_response, 10000,
+              "Maximal number of groups that a grouped YSQL aggregate read keeps in memory. When "
+              "it is reached, the read returns partial aggregates of the groups collected so far "
+              "with a paging state, and the next page continues the scan.");
+TAG_FLAG(ysql_max_aggregate_groups_per_response, advanced);
+TAG_FLAG(ysql_max_aggregate_groups_per_response, runtime);
+
+DEFINE_bool(ysql_batch_ybctid_multi_get, true,
+            "Whether rows of a YSQL read by a batch of ybctids are looked up in ybctid order "
+            "using a single iterator, instead of creating an iterator for each ybctid.");
+TAG_FLAG(ysql_batch_ybctid_multi_get, advanced);
+TAG_FLAG(ysql_batch_ybctid_multi_get, runtime);
+
 DEFINE_test_flag(int32, slowdown_pgsql_aggregate_read_ms, 0,
                  "If set > 0, slows down the response to pgsql aggregate read by this amount.");
 
@@ -438,10 +477,18 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
     }
   }
 
-  RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
-      DocPath(encoded_doc_key_.as_slice(), PrimitiveValue::kLivenessColumn),
-      Value(PrimitiveValue()),
-      data.read_time, data.deadline, request_.stmt_id()));
+  // Upserts and backfill writes could be applied on top of an existing row, so they have to keep
+  // columns which are not present in the request and are never packed.
+  const bool pack_row = FLAGS_ysql_enable_packed_row && !is_upsert && !request_.is_backfill();
+  std::vector<std::pair<ColumnId, PrimitiveValue>> packed_columns;
+  if (pack_row) {
+    packed_columns.reserve(request_.column_values().size());
+  } else {
+    RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
+        DocPath(encoded_doc_key_.as_slice(), PrimitiveValue::kLivenessColumn),
+        Value(PrimitiveValue()),
+        data.read_time, data.deadline, request_.stmt_id()));
+  }
 
   for (const auto& column_value : request_.column_values()) {
     // Get the column.
@@ -461,12 +508,33 @@ Status PgsqlWriteOperation::ApplyInsert(const DocOperationApplyData& data, IsUps
     const SubDocument sub_doc =
         SubDocument::FromQLValuePB(expr_result.Value(), column.sorting_type());
 
+    if (pack_row) {
+      SCHECK_FORMAT(IsPrimitiveValueType(sub_doc.value_type()) ||
+                        sub_doc.value_type() == ValueType::kTombstone,
+                    InvalidArgument, "Cannot pack value of column $0: $1",
+                    column_id, sub_doc.ToString());
+      packed_columns.emplace_back(column_id, sub_doc);
+      continue;
+    }
+
     // Inserting into specified column.
     DocPath sub_path(encoded_doc_key_.as_slice(), PrimitiveValue(column_id));
     RETURN_NOT_OK(data.doc_write_batch->InsertSubDocument(
         sub_path, sub_doc, data.read_time, data.deadline, request_.stmt_id()));
   }
 
+  if (pack_row) {
+    std::sort(packed_columns.begin(), packed_columns.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.first < rhs.first;
+    });
+    RowPacker packer(request_.schema_version());
+    for (const auto& column_id_and_value : packed_columns) {
+      RETURN_NOT_OK(packer.AddValue(column_id_and_value.first, column_id_and_value.second));
+    }
+    RETURN_NOT_OK(data.doc_write_batch->SetPackedRow(
+        encoded_doc_key_.as_slice(), packer.Complete()));
+  }
+
   RETURN_NOT_OK(PopulateResultSet(table_row));
 
   response_->set_status(PgsqlResponsePB::PGSQL_STATUS_OK);
@@ -943,6 +1011,22 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
     }
     row_count_limit = request_.limit();
   }
+  const bool is_top_n = !request_.order_by().empty() && request_.has_top_n_limit() &&
+                        !request_.is_aggregate();
+  if (is_top_n) {
+    if (request_.top_n_limit() == 0) {
+      return fetched_rows;
+    }
+    // The top-N read scans all matching rows, it is only stopped by the deadline and size limit.
+    row_count_limit = std::numeric_limits<std::size_t>::max();
+  }
+
+  const auto split_keys = VERIFY_RESULT(GetParallelAggregateSplitKeys(ql_storage, schema));
+  if (!split_keys.empty()) {
+    return ExecuteParallelAggregate(
+        ql_storage, deadline, read_time, is_explicit_request_read_time, schema, split_keys,
+        row_count_limit, result_buffer, has_paging_state);
+  }
 
   // Create the projection of regular columns selected by the row block plus any referenced in
   // the WHERE condition. When DocRowwiseIterator::NextRow() populates the value map, it uses this
@@ -996,53 +1080,87 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   CoarseTimePoint stop_scan = deadline - FLAGS_ysql_scan_deadline_margin_ms * 1ms;
 
   // Fetching data.
+  // When the where clause is pushed down, rows of a table scan are fetched in batches and the
+  // where clause is evaluated for the whole batch. The batch never exceeds the number of rows left
+  // to fetch, so the iterator is not advanced beyond the paging state position.
+  size_t batch_size = 1;
+  if (!request_.has_index_request() && expr_exec.has_where_clause()) {
+    batch_size = std::max<uint64_t>(FLAGS_ysql_scan_filter_batch_size, 1);
+  }
   int match_count = 0;
-  QLTableRow row;
-  while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
-         !scan_time_exceeded) {
-    row.Clear();
-
-    // If there is an index request, fetch ybbasectid from the index and use it as ybctid
-    // to fetch from the base table. Otherwise, fetch from the base table directly.
-    if (request_.has_index_request()) {
-      RETURN_NOT_OK(iter->NextRow(&row));
-      const auto& tuple_id = row.GetValue(ybbasectid_id);
-      SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
-      if (!VERIFY_RESULT(table_iter_->SeekTuple(tuple_id->binary_value()))) {
-        DocKey doc_key;
-        RETURN_NOT_OK(doc_key.DecodeFrom(tuple_id->binary_value()));
-        return STATUS_FORMAT(Corruption, "ybctid $0 not found in indexed table", doc_key);
-      }
+  std::vector<QLTableRow> rows(batch_size);
+  std::vector<bool> matches;
+  // Size limit is checked only between batches, so rows that were read from the iterator are not
+  // skipped by the paging state.
+  // The same applies to the limit on the number of groups of the grouped aggregate.
+  const size_t result_size_limit = request_.size_limit()
+      ? result_buffer->size() + request_.size_limit() : std::numeric_limits<size_t>::max();
+  const size_t groups_limit = std::max<uint64_t>(
+      GetAtomicFlag(&FLAGS_ysql_max_aggregate_groups_per_response), 1);
+  bool size_limit_exceeded = false;
+  while (fetched_rows < row_count_limit && !scan_time_exceeded && !size_limit_exceeded) {
+    const size_t batch_limit = std::min(batch_size, row_count_limit - fetched_rows);
+    size_t num_rows = 0;
+    while (num_rows < batch_limit && VERIFY_RESULT(iter->HasNext())) {
+      QLTableRow& row = rows[num_rows];
       row.Clear();
-      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
-    } else {
-      RETURN_NOT_OK(iter->NextRow(projection, &row));
+
+      // If there is an index request, fetch ybbasectid from the index and use it as ybctid
+      // to fetch from the base table. Otherwise, fetch from the base table directly.
+      if (request_.has_index_request()) {
+        RETURN_NOT_OK(iter->NextRow(&row));
+        const auto& tuple_id = row.GetValue(ybbasectid_id);
+        SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
+        if (!VERIFY_RESULT(table_iter_->SeekTuple(tuple_id->binary_value()))) {
+          DocKey doc_key;
+          RETURN_NOT_OK(doc_key.DecodeFrom(tuple_id->binary_value()));
+          return STATUS_FORMAT(Corruption, "ybctid $0 not found in indexed table", doc_key);
+        }
+        row.Clear();
+        RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+      } else {
+        RETURN_NOT_OK(iter->NextRow(projection, &row));
+      }
+      ++num_rows;
+    }
+    if (num_rows == 0) {
+      break;
     }
 
-    // Match the row with the where condition before adding to the row block.
-    bool is_match = true;
-    RETURN_NOT_OK(expr_exec.Exec(row, nullptr, &is_match));
-    if (is_match) {
+    // Match the rows with the where condition before adding to the row block.
+    RETURN_NOT_OK(expr_exec.ExecWhere(rows, num_rows, &matches));
+    for (size_t i = 0; i != num_rows; ++i) {
+      if (!matches[i]) {
+        continue;
+      }
       match_count++;
       if (request_.is_aggregate()) {
-        RETURN_NOT_OK(EvalAggregate(row));
+        RETURN_NOT_OK(EvalAggregate(rows[i]));
+      } else if (is_top_n) {
+        RETURN_NOT_OK(EvalTopN(rows[i], request_.top_n_limit()));
       } else {
-        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+        RETURN_NOT_OK(PopulateResultSet(rows[i], result_buffer));
         ++fetched_rows;
       }
     }
 
     // Check if we are running out of time
     scan_time_exceeded = CoarseMonoClock::now() >= stop_scan;
+    size_limit_exceeded = result_buffer->size() + top_n_heap_bytes_ >= result_size_limit ||
+                          aggr_groups_.size() >= groups_limit;
   }
 
   VLOG(1) << "Stopped iterator after " << match_count << " matches, "
           << fetched_rows << " rows fetched";
   VLOG(1) << "Deadline is " << (scan_time_exceeded ? "" : "not ") << "exceeded";
+  VLOG(1) << "Size limit is " << (size_limit_exceeded ? "" : "not ") << "exceeded";
 
   if (request_.is_aggregate() && match_count > 0) {
-    RETURN_NOT_OK(PopulateAggregate(row, result_buffer));
-    ++fetched_rows;
+    RETURN_NOT_OK(PopulateAggregate(rows.front(), result_buffer));
+    fetched_rows += request_.group_by_exprs().empty() ? 1 : aggr_groups_.size();
+  }
+  if (is_top_n) {
+    fetched_rows = PopulateTopN(result_buffer);
   }
 
   if (PREDICT_FALSE(FLAGS_TEST_slowdown_pgsql_aggregate_read_ms > 0) && request_.is_aggregate()) {
@@ -1051,11 +1169,272 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const YQLStorageIf& ql_storage,
   }
 
   RETURN_NOT_OK(SetPagingStateIfNecessary(
-      iter, fetched_rows, row_count_limit, scan_time_exceeded, scan_schema,
+      iter, fetched_rows, row_count_limit, scan_time_exceeded || size_limit_exceeded, scan_schema,
       read_time, has_paging_state));
   return fetched_rows;
 }
 
+Result<std::vector<KeyBytes>> PgsqlReadOperation::GetParallelAggregateSplitKeys(
+    const YQLStorageIf& ql_storage, const Schema& schema) {
+  std::vector<KeyBytes> result;
+  const auto parallelism = FLAGS_ysql_aggregate_scan_parallelism;
+  // Ranges are scanned by the table iterators, bounded by the tuple ids, so scans over an index,
+  // backward or restricted by the key columns are executed sequentially. The same applies to
+  // colocated tables, because tuple ids do not contain the colocation prefix.
+  if (parallelism <= 1 || read_pool_ == nullptr || !request_.is_aggregate() ||
+      request_.has_index_request() || !request_.is_forward_scan() ||
+      request_.is_for_backfill() || request_.partition_column_values_size() != 0 ||
+      request_.range_column_values_size() != 0 || request_.has_condition_expr() ||
+      !request_.group_by_exprs().empty() || schema.has_cotable_id() || schema.has_pgtable_id()) {
+    return result;
+  }
+  for (const auto& expr : request_.targets()) {
+    if (!IsMergeableAggregate(expr)) {
+      return result;
+    }
+  }
+
+  std::vector<KeyBytes> split_keys;
+  RETURN_NOT_OK(ql_storage.GetSplitDocKeys(&split_keys));
+
+  KeyBytes start_doc_key;
+  if (request_.has_paging_state() && !request_.paging_state().next_row_key().empty()) {
+    SubDocKey start_sub_doc_key;
+    RETURN_NOT_OK(start_sub_doc_key.FullyDecodeFrom(request_.paging_state().next_row_key()));
+    start_doc_key = start_sub_doc_key.doc_key().Encode();
+  }
+
+  // Keep only the keys that are strictly inside of the range scanned by the request.
+  auto is_inside_scan = [this, &schema, &start_doc_key](const KeyBytes& key) {
+    if (!start_doc_key.empty() && key.AsSlice().compare(start_doc_key.AsSlice()) <= 0) {
+      return false;
+    }
+    DocKey doc_key(schema);
+    if (!doc_key.FullyDecodeFrom(key.AsSlice()).ok()) {
+      return false;
+    }
+    if (schema.num_hash_key_columns() > 0) {
+      return doc_key.has_hash() &&
+             (!request_.has_hash_code() || doc_key.hash() >= request_.hash_code()) &&
+             (!request_.has_max_hash_code() || doc_key.hash() <= request_.max_hash_code());
+    }
+    return (!request_.has_lower_bound() ||
+            key.AsSlice().compare(request_.lower_bound().key()) > 0) &&
+           (!request_.has_upper_bound() ||
+            key.AsSlice().compare(request_.upper_bound().key()) < 0);
+  };
+  split_keys.erase(
+      std::remove_if(split_keys.begin(), split_keys.end(),
+                     [&is_inside_scan](const KeyBytes& key) { return !is_inside_scan(key); }),
+      split_keys.end());
+
+  // Pick evenly distributed keys when there are more of them than necessary.
+  const size_t num_splits = std::min<size_t>(parallelism - 1, split_keys.size());
+  result.reserve(num_splits);
+  for (size_t i = 1; i <= num_splits; ++i) {
+    result.push_back(std::move(split_keys[i * split_keys.size() / (num_splits + 1)]));
+  }
+  return result;
+}
+
+Result<size_t> PgsqlReadOperation::ExecuteParallelAggregate(
+    const YQLStorageIf& ql_storage,
+    CoarseTimePoint deadline,
+    const ReadHybridTime& read_time,
+    bool is_explicit_request_read_time,
+    const Schema& schema,
+    const std::vector<KeyBytes>& split_keys,
+    size_t row_count_limit,
+    faststring *result_buffer,
+    bool *has_paging_state) {
+  Schema projection;
+  if (!request_.col_refs().empty()) {
+    RETURN_NOT_OK(CreateProjection(schema, request_.col_refs(), &projection));
+  } else {
+    RETURN_NOT_OK(CreateProjection(schema, request_.column_refs(), &projection));
+  }
+
+  struct RangeScan {
+    PgsqlReadOperation* operation;
+    const KeyBytes* start_doc_key;
+    const KeyBytes* end_doc_key;
+    Status status;
+    bool completed = false;
+  };
+
+  // The first range is scanned by this operation, so its partial aggregate is used as the merge
+  // target and its iterator is used for the paging state if the scan is not completed.
+  const size_t num_ranges = split_keys.size() + 1;
+  std::vector<std::unique_ptr<PgsqlReadOperation>> range_operations;
+  std::vector<RangeScan> ranges;
+  range_operations.reserve(num_ranges - 1);
+  ranges.reserve(num_ranges);
+  for (size_t i = 0; i != num_ranges; ++i) {
+    PgsqlReadOperation* operation = this;
+    if (i != 0) {
+      range_operations.push_back(std::make_unique<PgsqlReadOperation>(request_, txn_op_context_));
+      operation = range_operations.back().get();
+    }
+    ranges.push_back(RangeScan {
+      .operation = operation,
+      .start_doc_key = i != 0 ? &split_keys[i - 1] : nullptr,
+      .end_doc_key = i != split_keys.size() ? &split_keys[i] : nullptr,
+    });
+  }
+
+  const CoarseTimePoint stop_scan = deadline - FLAGS_ysql_scan_deadline_margin_ms * 1ms;
+  auto scan_range = [&](RangeScan* range) {
+    auto completed = range->operation->AggregateRange(
+        ql_storage, deadline, read_time, is_explicit_request_read_time, schema, projection,
+        range->start_doc_key, range->end_doc_key, stop_scan);
+    if (completed.ok()) {
+      range->completed = *completed;
+    } else {
+      range->status = completed.status();
+    }
+  };
+
+  CountDownLatch latch(num_ranges - 1);
+  for (size_t i = 1; i != num_ranges; ++i) {
+    auto task = [&scan_range, &latch, range = &ranges[i]] {
+      scan_range(range);
+      latch.CountDown();
+    };
+    if (!read_pool_->SubmitFunc(task).ok()) {
+      task();
+    }
+  }
+  scan_range(&ranges.front());
+  latch.Wait();
+
+  for (const auto& range : ranges) {
+    RETURN_NOT_OK(range.status);
+  }
+
+  // Partial aggregates are merged in key order up to the first range that was stopped because of
+  // the deadline. The next page continues from the position where this range was stopped, so later
+  // ranges are discarded.
+  size_t last_range = 0;
+  for (;; ++last_range) {
+    const auto& range = ranges[last_range];
+    const auto& partial_result = range.operation->aggr_result_;
+    if (range.operation != this && !partial_result.empty()) {
+      if (aggr_result_.empty()) {
+        aggr_result_.resize(partial_result.size());
+      }
+      for (size_t i = 0; i != partial_result.size(); ++i) {
+        RETURN_NOT_OK(MergeAggregate(
+            request_.targets(narrow_cast<int>(i)), partial_result[i].Value(),
+            &aggr_result_[i].ForceNewValue()));
+      }
+    }
+    if (!range.completed || last_range + 1 == num_ranges) {
+      break;
+    }
+  }
+  VLOG(1) << "Merged " << last_range + 1 << " of " << num_ranges << " aggregate scan ranges";
+
+  size_t fetched_rows = 0;
+  if (!aggr_result_.empty()) {
+    RETURN_NOT_OK(PopulateAggregate(QLTableRow::empty_row(), result_buffer));
+    ++fetched_rows;
+  }
+
+  if (PREDICT_FALSE(FLAGS_TEST_slowdown_pgsql_aggregate_read_ms > 0)) {
+    TRACE("Sleeping for $0 ms", FLAGS_TEST_slowdown_pgsql_aggregate_read_ms);
+    SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_slowdown_pgsql_aggregate_read_ms));
+  }
+
+  const auto& last_scan = ranges[last_range];
+  RETURN_NOT_OK(SetPagingStateIfNecessary(
+      last_scan.operation->table_iter_.get(), fetched_rows, row_count_limit,
+      !last_scan.completed, &schema, read_time, has_paging_state));
+
+  // Execute reports restart read time of table_iter_, so it should be the iterator that requires
+  // the latest restart among all ranges.
+  for (const auto& operation : range_operations) {
+    const auto restart_read_ht = operation->table_iter_->RestartReadHt();
+    if (!restart_read_ht.is_valid()) {
+      continue;
+    }
+    const auto current_restart_read_ht = table_iter_->RestartReadHt();
+    if (!current_restart_read_ht.is_valid() || current_restart_read_ht < restart_read_ht) {
+      table_iter_ = std::move(operation->table_iter_);
+    }
+  }
+  return fetched_rows;
+}
+
+Result<bool> PgsqlReadOperation::AggregateRange(const YQLStorageIf& ql_storage,
+                                                CoarseTimePoint deadline,
+                                                const ReadHybridTime& read_time,
+                                                bool is_explicit_request_read_time,
+                                                const Schema& schema,
+                                                const Schema& projection,
+                                                const KeyBytes* start_doc_key,
+                                                const KeyBytes* end_doc_key,
+                                                CoarseTimePoint stop_scan) {
+  if (start_doc_key) {
+    DocKey doc_key(schema);
+    RETURN_NOT_OK(doc_key.FullyDecodeFrom(start_doc_key->AsSlice()));
+    RETURN_NOT_OK(ql_storage.GetIterator(
+        request_, projection, schema, txn_op_context_, deadline, read_time, doc_key,
+        &table_iter_));
+  } else {
+    table_iter_ = VERIFY_RESULT(CreateIterator(
+        ql_storage, request_, projection, schema, txn_op_context_,
+        deadline, read_time, is_explicit_request_read_time));
+  }
+
+  // Each range has its own executor, because the where clause is evaluated concurrently.
+  DocPgExprExecutor expr_exec(&schema);
+  for (const PgsqlColRefPB& column_ref : request_.col_refs()) {
+    RETURN_NOT_OK(expr_exec.AddColumnRef(column_ref));
+  }
+  for (const PgsqlExpressionPB& expr : request_.where_clauses()) {
+    RETURN_NOT_OK(expr_exec.AddWhereExpression(expr));
+  }
+
+  size_t batch_size = 1;
+  if (expr_exec.has_where_clause()) {
+    batch_size = std::max<uint64_t>(FLAGS_ysql_scan_filter_batch_size, 1);
+  }
+  std::vector<QLTableRow> rows(batch_size);
+  std::vector<bool> matches;
+  for (;;) {
+    bool range_end = false;
+    size_t num_rows = 0;
+    while (num_rows < batch_size) {
+      if (!VERIFY_RESULT(table_iter_->HasNext()) ||
+          (end_doc_key &&
+           VERIFY_RESULT(table_iter_->GetTupleId()).compare(end_doc_key->AsSlice()) >= 0)) {
+        range_end = true;
+        break;
+      }
+      QLTableRow& row = rows[num_rows];
+      row.Clear();
+      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
+      ++num_rows;
+    }
+
+    if (num_rows != 0) {
+      RETURN_NOT_OK(expr_exec.ExecWhere(rows, num_rows, &matches));
+      for (size_t i = 0; i != num_rows; ++i) {
+        if (matches[i]) {
+          RETURN_NOT_OK(EvalAggregate(rows[i]));
+        }
+      }
+    }
+
+    if (range_end) {
+      return true;
+    }
+    if (CoarseMonoClock::now() >= stop_scan) {
+      return false;
+    }
+  }
+}
+
 Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_storage,
                                                       CoarseTimePoint deadline,
                                                       const ReadHybridTime& read_time,
@@ -1065,6 +1444,11 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_sto
   Schema projection;
   RETURN_NOT_OK(CreateProjection(schema, request_.column_refs(), &projection));
 
+  if (FLAGS_ysql_batch_ybctid_multi_get && request_.batch_arguments_size() > 1) {
+    return ExecuteMultiGetYbctid(
+        ql_storage, deadline, read_time, schema, projection, result_buffer);
+  }
+
   QLTableRow row;
   size_t row_count = 0;
   for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
@@ -1091,6 +1475,65 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const YQLStorageIf& ql_sto
   return row_count;
 }
 
+Result<size_t> PgsqlReadOperation::ExecuteMultiGetYbctid(const YQLStorageIf& ql_storage,
+                                                         CoarseTimePoint deadline,
+                                                         const ReadHybridTime& read_time,
+                                                         const Schema& schema,
+                                                         const Schema& projection,
+                                                         faststring *result_buffer) {
+  const auto& batch_arguments = request_.batch_arguments();
+  const int num_arguments = batch_arguments.size();
+
+  // Look up rows in ybctid order, so the iterator moves forward only and could reuse its position
+  // and the data blocks loaded for the previous row.
+  std::vector<int> lookup_order(num_arguments);
+  std::iota(lookup_order.begin(), lookup_order.end(), 0);
+  std::sort(lookup_order.begin(), lookup_order.end(), [&batch_arguments](int lhs, int rhs) {
+    return batch_arguments.Get(lhs).ybctid().value().binary_value() <
+           batch_arguments.Get(rhs).ybctid().value().binary_value();
+  });
+
+  RETURN_NOT_OK(ql_storage.GetIteratorForYbctids(
+      projection, schema, txn_op_context_, deadline, read_time, &table_iter_));
+
+  std::vector<QLTableRow> rows(num_arguments);
+  std::vector<bool> found(num_arguments, false);
+  const std::string* prev_ybctid = nullptr;
+  int prev_idx = -1;
+  for (const auto idx : lookup_order) {
+    const auto& ybctid = batch_arguments.Get(idx).ybctid().value().binary_value();
+    // The iterator only seeks forward, so a repeated ybctid reuses the row that was just read.
+    if (prev_ybctid && *prev_ybctid == ybctid) {
+      rows[idx] = rows[prev_idx];
+      found[idx] = found[prev_idx];
+      continue;
+    }
+    prev_ybctid = &ybctid;
+    prev_idx = idx;
+    if (VERIFY_RESULT(table_iter_->SeekTuple(ybctid))) {
+      RETURN_NOT_OK(table_iter_->NextRow(projection, &rows[idx]));
+      found[idx] = true;
+    }
+  }
+
+  // Rows are returned in the order of batch arguments, the same way as they are returned when
+  // looked up one by one.
+  size_t row_count = 0;
+  for (int idx = 0; idx != num_arguments; ++idx) {
+    if (!found[idx]) {
+      continue;
+    }
+    RETURN_NOT_OK(PopulateResultSet(rows[idx], result_buffer));
+    response_.add_batch_orders(batch_arguments.Get(idx).order());
+    row_count++;
+  }
+
+  // Mark all rows were processed even in case some of the ybctids were not found.
+  response_.set_batch_arg_count(request_.batch_arguments_size());
+
+  return row_count;
+}
+
 Status PgsqlReadOperation::SetPagingStateIfNecessary(const YQLRowwiseIteratorIf* iter,
                                                      size_t fetched_rows,
                                                      const size_t row_count_limit,
@@ -1160,6 +1603,9 @@ Status PgsqlReadOperation::GetTupleId(QLValue *result) const {
 }
 
 Status PgsqlReadOperation::EvalAggregate(const QLTableRow& table_row) {
+  if (!request_.group_by_exprs().empty()) {
+    return EvalGroupedAggregate(table_row);
+  }
   if (aggr_result_.empty()) {
     int column_count = request_.targets().size();
     aggr_result_.resize(column_count);
@@ -1172,8 +1618,129 @@ Status PgsqlReadOperation::EvalAggregate(const QLTableRow& table_row) {
   return Status::OK();
 }
 
+Status PgsqlReadOperation::EvalGroupedAggregate(const QLTableRow& table_row) {
+  const auto& group_by_exprs = request_.group_by_exprs();
+  std::vector<QLExprResult> group_values(group_by_exprs.size());
+  group_key_buffer_.clear();
+  for (int i = 0; i != group_by_exprs.size(); ++i) {
+    RETURN_NOT_OK(EvalExpr(group_by_exprs.Get(i), table_row, group_values[i].Writer()));
+    RETURN_NOT_OK(pggate::WriteColumn(group_values[i].Value(), &group_key_buffer_));
+  }
+
+  auto it = aggr_groups_.find(group_key_buffer_.ToString());
+  if (it == aggr_groups_.end()) {
+    it = aggr_groups_.emplace(group_key_buffer_.ToString(), AggregateGroup()).first;
+    auto& group = it->second;
+    group.group_values.resize(group_values.size());
+    for (size_t i = 0; i != group_values.size(); ++i) {
+      group_values[i].MoveTo(&group.group_values[i]);
+    }
+    group.aggr_result.resize(request_.targets().size());
+  }
+
+  int aggr_index = 0;
+  for (const PgsqlExpressionPB& expr : request_.targets()) {
+    RETURN_NOT_OK(EvalExpr(expr, table_row, it->second.aggr_result[aggr_index++].Writer()));
+  }
+  return Status::OK();
+}
+
+namespace {
+
+// Ordering of the top-N read, Postgres ordering of NULLs is used.
+class TopNRowLess {
+ public:
+  explicit TopNRowLess(const google::protobuf::RepeatedPtrField<PgsqlOrderByPB>& order_by)
+      : order_by_(order_by) {}
+
+  bool operator()(const std::vector<QLValuePB>& lhs, const std::vector<QLValuePB>& rhs) const {
+    for (int i = 0; i != order_by_.size(); ++i) {
+      const auto& order_by = order_by_.Get(i);
+      const bool lhs_null = IsNull(lhs[i]);
+      const bool rhs_null = IsNull(rhs[i]);
+      if (lhs_null || rhs_null) {
+        if (lhs_null != rhs_null) {
+          return lhs_null == order_by.nulls_first();
+        }
+        continue;
+      }
+      const auto cmp = Compare(lhs[i], rhs[i]);
+      if (cmp != 0) {
+        return order_by.is_descending() ? cmp > 0 : cmp < 0;
+      }
+    }
+    return false;
+  }
+
+ private:
+  const google::protobuf::RepeatedPtrField<PgsqlOrderByPB>& order_by_;
+};
+
+} // namespace
+
+Status PgsqlReadOperation::EvalTopN(const QLTableRow& table_row, size_t limit) {
+  TopNRowLess less(request_.order_by());
+  auto heap_less = [&less](const TopNRow& lhs, const TopNRow& rhs) {
+    return less(lhs.sort_values, rhs.sort_values);
+  };
+
+  TopNRow row;
+  row.sort_values.resize(request_.order_by().size());
+  for (int i = 0; i != request_.order_by().size(); ++i) {
+    QLExprResult value;
+    RETURN_NOT_OK(EvalExpr(request_.order_by(i).expr(), table_row, value.Writer()));
+    value.MoveTo(&row.sort_values[i]);
+  }
+  // Rows that do not make it into the first "limit" rows are not serialized at all.
+  if (top_n_heap_.size() >= limit && !less(row.sort_values, top_n_heap_.front().sort_values)) {
+    return Status::OK();
+  }
+
+  faststring row_data;
+  RETURN_NOT_OK(PopulateResultSet(table_row, &row_data));
+  row.row_data = row_data.ToString();
+  top_n_heap_bytes_ += row.row_data.size();
+  if (top_n_heap_.size() >= limit) {
+    std::pop_heap(top_n_heap_.begin(), top_n_heap_.end(), heap_less);
+    top_n_heap_bytes_ -= top_n_heap_.back().row_data.size();
+    top_n_heap_.back() = std::move(row);
+  } else {
+    top_n_heap_.push_back(std::move(row));
+  }
+  std::push_heap(top_n_heap_.begin(), top_n_heap_.end(), heap_less);
+  return Status::OK();
+}
+
+size_t PgsqlReadOperation::PopulateTopN(faststring *result_buffer) {
+  TopNRowLess less(request_.order_by());
+  std::sort_heap(
+      top_n_heap_.begin(), top_n_heap_.end(), [&less](const TopNRow& lhs, const TopNRow& rhs) {
+    return less(lhs.sort_values, rhs.sort_values);
+  });
+  for (const auto& row : top_n_heap_) {
+    result_buffer->append(row.row_data);
+  }
+  auto result = top_n_heap_.size();
+  top_n_heap_.clear();
+  top_n_heap_bytes_ = 0;
+  return result;
+}
+
 Status PgsqlReadOperation::PopulateAggregate(const QLTableRow& table_row,
                                              faststring *result_buffer) {
+  if (!request_.group_by_exprs().empty()) {
+    for (const auto& key_and_group : aggr_groups_) {
+      const auto& group = key_and_group.second;
+      for (const auto& value : group.group_values) {
+        RETURN_NOT_OK(pggate::WriteColumn(value, result_buffer));
+      }
+      for (const auto& result : group.aggr_result) {
+        RETURN_NOT_OK(pggate::WriteColumn(result.Value(), result_buffer));
+      }
+    }
+    return Status::OK();
+  }
+
   int column_count = request_.targets().size();
   for (int rscol_index = 0; rscol_index < column_count; rscol_index++) {
     RETURN_NOT_OK(pggate::WriteColumn(aggr_result_[rscol_index].Value(), result_buffer));
@@ -14,6 +14,10 @@
 #ifndef YB_DOCDB_PGSQL_OPERATION_H
 #define YB_DOCDB_PGSQL_OPERATION_H
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include "yb/common/pgsql_protocol.pb.h"
 
 #include "yb/docdb/doc_expr.h"
@@ -22,9 +26,12 @@
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/ql_rowwise_iterator_interface.h"
 
+#include "yb/util/faststring.h"
+
 namespace yb {
 
 class IndexInfo;
+class ThreadPool;
 
 namespace docdb {
 
@@ -125,9 +132,12 @@ class PgsqlWriteOperation :
 class PgsqlReadOperation : public DocExprExecutor {
  public:
   // Construct and access methods.
+  // When read_pool is specified, large aggregate scans could be split into key ranges that are
+  // scanned by the tasks submitted to this pool.
   PgsqlReadOperation(const PgsqlReadRequestPB& request,
-                     const TransactionOperationContext& txn_op_context)
-      : request_(request), txn_op_context_(txn_op_context) {
+                     const TransactionOperationContext& txn_op_context,
+                     ThreadPool* read_pool = nullptr)
+      : request_(request), txn_op_context_(txn_op_context), read_pool_(read_pool) {
   }
 
   const PgsqlReadRequestPB& request() const { return request_; }
@@ -177,6 +187,14 @@ class PgsqlReadOperation : public DocExprExecutor {
                                     faststring *result_buffer,
                                     HybridTime *restart_read_ht);
 
+  // Looks up rows of all batch arguments using a single iterator.
+  Result<size_t> ExecuteMultiGetYbctid(const YQLStorageIf& ql_storage,
+                                       CoarseTimePoint deadline,
+                                       const ReadHybridTime& read_time,
+                                       const Schema& schema,
+                                       const Schema& projection,
+                                       faststring *result_buffer);
+
   Result<size_t> ExecuteSample(const YQLStorageIf& ql_storage,
                                CoarseTimePoint deadline,
                                const ReadHybridTime& read_time,
@@ -186,11 +204,49 @@ class PgsqlReadOperation : public DocExprExecutor {
                                HybridTime *restart_read_ht,
                                bool *has_paging_state);
 
+  // Returns keys that split the range scanned by the aggregate request into parts, that could be
+  // scanned in parallel. Empty when the request could not be executed in parallel.
+  Result<std::vector<KeyBytes>> GetParallelAggregateSplitKeys(const YQLStorageIf& ql_storage,
+                                                              const Schema& schema);
+
+  // Execute the aggregate request by scanning ranges bounded by split_keys in parallel and merging
+  // their partial aggregates.
+  Result<size_t> ExecuteParallelAggregate(const YQLStorageIf& ql_storage,
+                                          CoarseTimePoint deadline,
+                                          const ReadHybridTime& read_time,
+                                          bool is_explicit_request_read_time,
+                                          const Schema& schema,
+                                          const std::vector<KeyBytes>& split_keys,
+                                          size_t row_count_limit,
+                                          faststring *result_buffer,
+                                          bool *has_paging_state);
+
+  // Aggregate rows with keys in [start_doc_key, end_doc_key) range. Null start_doc_key means that
+  // the scan starts where the request starts, null end_doc_key means that the scan is not bounded.
+  // Returns false if the scan was stopped by stop_scan before reaching the end of the range.
+  Result<bool> AggregateRange(const YQLStorageIf& ql_storage,
+                              CoarseTimePoint deadline,
+                              const ReadHybridTime& read_time,
+                              bool is_explicit_request_read_time,
+                              const Schema& schema,
+                              const Schema& projection,
+                              const KeyBytes* start_doc_key,
+                              const KeyBytes* end_doc_key,
+                              CoarseTimePoint stop_scan);
+
   CHECKED_STATUS PopulateResultSet(const QLTableRow& table_row,
                                    faststring *result_buffer);
 
   CHECKED_STATUS EvalAggregate(const QLTableRow& table_row);
 
+  CHECKED_STATUS EvalGroupedAggregate(const QLTableRow& table_row);
+
+  // Keeps the row if it is among the first "limit" rows in the order of the top-N read.
+  CHECKED_STATUS EvalTopN(const QLTableRow& table_row, size_t limit);
+
+  // Writes the rows kept by EvalTopN in the order of the top-N read, returns number of rows.
+  size_t PopulateTopN(faststring *result_buffer);
+
   CHECKED_STATUS PopulateAggregate(const QLTableRow& table_row,
                                    faststring *result_buffer);
 
@@ -207,9 +263,29 @@ class PgsqlReadOperation : public DocExprExecutor {
   //------------------------------------------------------------------------------------------------
   const PgsqlReadRequestPB& request_;
   const TransactionOperationContext txn_op_context_;
+  ThreadPool* const read_pool_;
   PgsqlResponsePB response_;
   YQLRowwiseIteratorIf::UniPtr table_iter_;
   YQLRowwiseIteratorIf::UniPtr index_iter_;
+
+  // Partial aggregates of the grouped aggregate read, keyed by encoded values of the GROUP BY
+  // expressions.
+  struct AggregateGroup {
+    std::vector<QLValuePB> group_values;
+    std::vector<QLExprResult> aggr_result;
+  };
+  std::unordered_map<std::string, AggregateGroup> aggr_groups_;
+  faststring group_key_buffer_;
+
+  // Rows of the top-N read, max heap in the order of the read, so the last of the kept rows is
+  // on top.
+  struct TopNRow {
+    std::vector<QLValuePB> sort_values;
+    std::string row_data;
+  };
+  std::vector<TopNRow> top_n_heap_;
+  // Total size of row_data of the rows in top_n_heap_, counted against the response size limit.
+  size_t top_n_heap_bytes_ = 0;
 };
 
 }  // namespace docdb
@@ -69,6 +69,7 @@ using yb::util::DecodeDoubleFromKey;
     case ValueType::kMergeFlags: FALLTHROUGH_INTENDED; \
     case ValueType::kObject: FALLTHROUGH_INTENDED; \
     case ValueType::kObsoleteIntentPrefix: FALLTHROUGH_INTENDED; \
+    case ValueType::kPackedRow: FALLTHROUGH_INTENDED; \
     case ValueType::kRedisList: FALLTHROUGH_INTENDED;            \
     case ValueType::kRedisSet: FALLTHROUGH_INTENDED; \
     case ValueType::kRedisSortedSet: FALLTHROUGH_INTENDED;  \
@@ -230,6 +231,8 @@ string PrimitiveValue::ToString(AutoDecodeKeys auto_decode_keys) const {
       return Format("SystemColumnId($0)", column_id_val_);
     case ValueType::kObject:
       return "{}";
+    case ValueType::kPackedRow:
+      return "PackedRow";
     case ValueType::kRedisSet:
       return "()";
     case ValueType::kRedisTS:
@@ -607,6 +610,9 @@ string PrimitiveValue::ToValue() const {
       result.push_back(static_cast<char>(gin_null_val_));
       return result;
 
+    case ValueType::kPackedRow:
+      // Packed rows are encoded by RowPacker.
+      FALLTHROUGH_INTENDED;
     case ValueType::kIntentTypeSet: FALLTHROUGH_INTENDED;
     case ValueType::kObsoleteIntentTypeSet: FALLTHROUGH_INTENDED;
     case ValueType::kObsoleteIntentType: FALLTHROUGH_INTENDED;
@@ -1069,7 +1075,9 @@ Status PrimitiveValue::DecodeFromValue(const rocksdb::Slice& rocksdb_slice) {
     case ValueType::kRedisSet: FALLTHROUGH_INTENDED;
     case ValueType::kRedisTS: FALLTHROUGH_INTENDED;
     case ValueType::kRedisSortedSet: FALLTHROUGH_INTENDED;
-    case ValueType::kTombstone:
+    case ValueType::kTombstone: FALLTHROUGH_INTENDED;
+    // Columns of a packed row are decoded separately using PackedRowDecoder.
+    case ValueType::kPackedRow:
       type_ = value_type;
       complex_data_structure_ = nullptr;
       return Status::OK();
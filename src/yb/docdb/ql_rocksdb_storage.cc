@@ -13,6 +13,8 @@
 
 #include "yb/docdb/ql_rocksdb_storage.h"
 
+#include <algorithm>
+
 #include "yb/common/pgsql_protocol.pb.h"
 #include "yb/common/ql_protocol.pb.h"
 
@@ -20,6 +22,10 @@
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/primitive_value_util.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/metadata.h"
 
 #include "yb/util/result.h"
 
@@ -142,6 +148,20 @@ Status QLRocksDBStorage::GetIterator(uint64 stmt_id,
   return Status::OK();
 }
 
+Status QLRocksDBStorage::GetIteratorForYbctids(const Schema& projection,
+                                               const Schema& schema,
+                                               const TransactionOperationContext& txn_op_context,
+                                               CoarseTimePoint deadline,
+                                               const ReadHybridTime& read_time,
+                                               YQLRowwiseIteratorIf::UniPtr* iter) const {
+  auto doc_iter = std::make_unique<DocRowwiseIterator>(
+      projection, schema, txn_op_context, doc_db_, deadline, read_time);
+  RETURN_NOT_OK(doc_iter->Init(TableType::PGSQL_TABLE_TYPE));
+  doc_iter->set_seek_tuple_forward(true);
+  *iter = std::move(doc_iter);
+  return Status::OK();
+}
+
 Status QLRocksDBStorage::GetIterator(const PgsqlReadRequestPB& request,
                                      const Schema& projection,
                                      const Schema& schema,
@@ -235,5 +255,41 @@ Status QLRocksDBStorage::GetIterator(const PgsqlReadRequestPB& request,
   return Status::OK();
 }
 
+Status QLRocksDBStorage::GetSplitDocKeys(std::vector<KeyBytes>* doc_keys) const {
+  doc_keys->clear();
+  std::vector<std::string> keys;
+  for (const auto& file : doc_db_.regular->GetLiveFilesMetaData()) {
+    keys.push_back(file.smallest.key);
+  }
+  // Compacted tablet could have just a single SST file, use its middle key to split it.
+  auto middle_key = doc_db_.regular->GetMiddleKey();
+  if (middle_key.ok()) {
+    keys.push_back(std::move(*middle_key));
+  }
+  std::sort(keys.begin(), keys.end());
+
+  for (const auto& key : keys) {
+    if (key.empty() || IsInternalRecordKeyType(DecodeValueType(key[0]))) {
+      continue;
+    }
+    auto doc_key_size = DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey);
+    if (!doc_key_size.ok() || *doc_key_size == 0) {
+      continue;
+    }
+    Slice doc_key(key.data(), *doc_key_size);
+    if (!IsWithinBounds(doc_db_.key_bounds, doc_key) ||
+        (!doc_keys->empty() && doc_keys->back().AsSlice().compare(doc_key) >= 0)) {
+      continue;
+    }
+    doc_keys->emplace_back(doc_key);
+  }
+
+  // The smallest key starts the first part, so it does not split anything.
+  if (!doc_keys->empty()) {
+    doc_keys->erase(doc_keys->begin());
+  }
+  return Status::OK();
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -80,6 +80,15 @@ class QLRocksDBStorage : public YQLStorageIf {
                              const QLValuePB& ybctid,
                              YQLRowwiseIteratorIf::UniPtr* iter) const override;
 
+  CHECKED_STATUS GetIteratorForYbctids(const Schema& projection,
+                                       const Schema& schema,
+                                       const TransactionOperationContext& txn_op_context,
+                                       CoarseTimePoint deadline,
+                                       const ReadHybridTime& read_time,
+                                       YQLRowwiseIteratorIf::UniPtr* iter) const override;
+
+  CHECKED_STATUS GetSplitDocKeys(std::vector<KeyBytes>* doc_keys) const override;
+
  private:
   const DocDB doc_db_;
 };
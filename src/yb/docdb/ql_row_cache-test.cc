@@ -0,0 +1,134 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/common/ql_expr.h"
+#include "yb/common/ql_value.h"
+
+#include "yb/docdb/ql_row_cache.h"
+
+#include "yb/util/mem_tracker.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr size_t kCapacity = 1024 * 1024;
+constexpr ColumnIdRep kColumnId = kFirstColumnIdRep + 1;
+
+std::vector<QLTableRow> MakeRows(int32_t value) {
+  std::vector<QLTableRow> result(1);
+  result[0].AllocColumn(kColumnId).value.set_int32_value(value);
+  return result;
+}
+
+int32_t CachedValue(
+    QLRowCache* cache, uint16_t hash_code, const std::string& key, HybridTime read_ht) {
+  std::vector<QLTableRow> rows;
+  if (!cache->Lookup(hash_code, key, read_ht, &rows)) {
+    return -1;
+  }
+  EXPECT_EQ(rows.size(), 1U);
+  return rows[0].GetValue(kColumnId)->int32_value();
+}
+
+} // namespace
+
+class QLRowCacheTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    mem_tracker_ = MemTracker::CreateTracker("test");
+    cache_ = std::make_unique<QLRowCache>(kCapacity, mem_tracker_);
+  }
+
+  void TearDown() override {
+    cache_.reset();
+    EXPECT_EQ(mem_tracker_->consumption(), 0);
+    YBTest::TearDown();
+  }
+
+  MemTrackerPtr mem_tracker_;
+  std::unique_ptr<QLRowCache> cache_;
+};
+
+TEST_F(QLRowCacheTest, LookupAndInvalidate) {
+  const std::string kKey = "key";
+  constexpr uint16_t kHashCode = 0x1234;
+
+  auto epoch = cache_->Epoch(kHashCode);
+  cache_->Insert(kHashCode, kKey, epoch, HybridTime(100), MakeRows(1));
+  ASSERT_GT(mem_tracker_->consumption(), 0);
+
+  // Entry is not valid for reads before the time it was read at.
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(99)), -1);
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(100)), 1);
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(200)), 1);
+  // Different key with the same hash code.
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, "other", HybridTime(200)), -1);
+
+  // Entry read before the write is not inserted.
+  epoch = cache_->Epoch(kHashCode);
+  cache_->Invalidate(kHashCode, HybridTime(300), /* has_ttl= */ false);
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(400)), -1);
+  cache_->Insert(kHashCode, kKey, epoch, HybridTime(400), MakeRows(2));
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(400)), -1);
+
+  // Entry read before the write time is not inserted.
+  epoch = cache_->Epoch(kHashCode);
+  cache_->Insert(kHashCode, kKey, epoch, HybridTime(250), MakeRows(2));
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(400)), -1);
+
+  cache_->Insert(kHashCode, kKey, epoch, HybridTime(400), MakeRows(3));
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(400)), 3);
+
+  // Write to other hash code does not affect the entry.
+  cache_->Invalidate(kHashCode + 1, HybridTime(500), /* has_ttl= */ false);
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(500)), 3);
+
+  cache_->Clear();
+  ASSERT_EQ(cache_->TEST_size(), 0U);
+  ASSERT_EQ(mem_tracker_->consumption(), 0);
+}
+
+TEST_F(QLRowCacheTest, Ttl) {
+  const std::string kKey = "key";
+  constexpr uint16_t kHashCode = 0x4321;
+
+  cache_->Invalidate(kHashCode, HybridTime(100), /* has_ttl= */ true);
+  cache_->Insert(kHashCode, kKey, cache_->Epoch(kHashCode), HybridTime(200), MakeRows(1));
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(200)), -1);
+
+  // Later writes without TTL do not make the slot cacheable again.
+  cache_->Invalidate(kHashCode, HybridTime(300), /* has_ttl= */ false);
+  cache_->Insert(kHashCode, kKey, cache_->Epoch(kHashCode), HybridTime(400), MakeRows(1));
+  ASSERT_EQ(CachedValue(cache_.get(), kHashCode, kKey, HybridTime(400)), -1);
+}
+
+TEST_F(QLRowCacheTest, Eviction) {
+  constexpr int kNumKeys = 50000;
+  for (int i = 0; i != kNumKeys; ++i) {
+    const auto hash_code = static_cast<uint16_t>(i);
+    cache_->Insert(
+        hash_code, std::to_string(i), cache_->Epoch(hash_code), HybridTime(100), MakeRows(i));
+  }
+  ASSERT_LT(cache_->TEST_size(), static_cast<size_t>(kNumKeys));
+  ASSERT_LE(mem_tracker_->consumption(), static_cast<int64_t>(kCapacity));
+  // The most recently inserted entry is still present.
+  ASSERT_EQ(CachedValue(cache_.get(), kNumKeys - 1, std::to_string(kNumKeys - 1), HybridTime(100)),
+            kNumKeys - 1);
+}
+
+} // namespace docdb
+} // namespace yb
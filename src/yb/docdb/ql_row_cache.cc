@@ -0,0 +1,234 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/ql_row_cache.h"
+
+#include <array>
+#include <mutex>
+
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include "yb/common/ql_expr.h"
+
+#include "yb/gutil/endian.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr size_t kNumShards = 16;
+constexpr size_t kSlotsPerShard = 64;
+constexpr size_t kHashCodeSize = sizeof(uint16_t);
+
+std::string HashCodePrefix(uint16_t hash_code) {
+  std::string result(kHashCodeSize, '\0');
+  BigEndian::Store16(&result[0], hash_code);
+  return result;
+}
+
+} // namespace
+
+constexpr size_t QLRowCache::kMaxRowsPerEntry;
+
+class QLRowCache::Shard {
+ public:
+  Shard(size_t capacity, MemTracker* mem_tracker)
+      : capacity_(capacity), mem_tracker_(mem_tracker) {}
+
+  ~Shard() {
+    Clear();
+  }
+
+  uint64_t Epoch(uint16_t hash_code) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return SlotForHashCode(hash_code).epoch;
+  }
+
+  bool Lookup(const std::string& key, HybridTime read_ht, std::vector<QLTableRow>* rows) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || read_ht < it->read_ht) {
+      return false;
+    }
+    *rows = it->rows;
+    auto& lru = entries_.get<LruTag>();
+    lru.relocate(lru.begin(), entries_.project<LruTag>(it));
+    return true;
+  }
+
+  void Insert(uint16_t hash_code, std::string key, uint64_t epoch, HybridTime read_ht,
+              std::vector<QLTableRow> rows) {
+    size_t charge = sizeof(Entry) + key.size();
+    for (const auto& row : rows) {
+      charge += row.SpaceUsed();
+    }
+    if (charge > capacity_) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& slot = SlotForHashCode(hash_code);
+    if (slot.epoch != epoch || slot.has_ttl || slot.last_write_ht > read_ht) {
+      return;
+    }
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      Erase(it);
+    }
+    while (consumption_ + charge > capacity_) {
+      auto& lru = entries_.get<LruTag>();
+      Erase(entries_.project<KeyTag>(std::prev(lru.end())));
+    }
+    entries_.insert(Entry{std::move(key), read_ht, std::move(rows), charge});
+    consumption_ += charge;
+    mem_tracker_->Consume(charge);
+  }
+
+  void Invalidate(uint16_t hash_code, HybridTime write_ht, bool has_ttl) {
+    const auto prefix = HashCodePrefix(hash_code);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = SlotForHashCode(hash_code);
+    ++slot.epoch;
+    slot.last_write_ht.MakeAtLeast(write_ht);
+    slot.has_ttl = slot.has_ttl || has_ttl;
+    auto it = entries_.lower_bound(prefix);
+    while (it != entries_.end() && it->key.compare(0, kHashCodeSize, prefix) == 0) {
+      it = Erase(it);
+    }
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& slot : slots_) {
+      ++slot.epoch;
+    }
+    entries_.clear();
+    mem_tracker_->Release(consumption_);
+    consumption_ = 0;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  struct Entry {
+    std::string key;
+    HybridTime read_ht;
+    std::vector<QLTableRow> rows;
+    size_t charge;
+  };
+
+  struct Slot {
+    // Incremented on each invalidation of the slot.
+    uint64_t epoch = 0;
+    HybridTime last_write_ht = HybridTime::kMin;
+    bool has_ttl = false;
+  };
+
+  class KeyTag;
+  class LruTag;
+
+  typedef boost::multi_index_container<
+      Entry,
+      boost::multi_index::indexed_by<
+          boost::multi_index::ordered_unique<
+              boost::multi_index::tag<KeyTag>,
+              boost::multi_index::member<Entry, std::string, &Entry::key>
+          >,
+          boost::multi_index::sequenced<
+              boost::multi_index::tag<LruTag>
+          >
+      >
+  > Entries;
+
+  Slot& SlotForHashCode(uint16_t hash_code) {
+    return slots_[(hash_code / kNumShards) % kSlotsPerShard];
+  }
+
+  const Slot& SlotForHashCode(uint16_t hash_code) const {
+    return slots_[(hash_code / kNumShards) % kSlotsPerShard];
+  }
+
+  Entries::iterator Erase(Entries::iterator it) {
+    consumption_ -= it->charge;
+    mem_tracker_->Release(it->charge);
+    return entries_.erase(it);
+  }
+
+  const size_t capacity_;
+  MemTracker* const mem_tracker_;
+
+  mutable std::mutex mutex_;
+  Entries entries_;
+  std::array<Slot, kSlotsPerShard> slots_;
+  size_t consumption_ = 0;
+};
+
+QLRowCache::QLRowCache(size_t capacity, const MemTrackerPtr& parent_mem_tracker)
+    : mem_tracker_(MemTracker::FindOrCreateTracker("RowCache", parent_mem_tracker)) {
+  shards_.reserve(kNumShards);
+  for (size_t i = 0; i != kNumShards; ++i) {
+    shards_.push_back(std::make_unique<Shard>(capacity / kNumShards, mem_tracker_.get()));
+  }
+}
+
+QLRowCache::~QLRowCache() = default;
+
+QLRowCache::Shard& QLRowCache::ShardForHashCode(uint16_t hash_code) const {
+  return *shards_[hash_code % kNumShards];
+}
+
+uint64_t QLRowCache::Epoch(uint16_t hash_code) const {
+  return ShardForHashCode(hash_code).Epoch(hash_code);
+}
+
+bool QLRowCache::Lookup(uint16_t hash_code, const std::string& key, HybridTime read_ht,
+                        std::vector<QLTableRow>* rows) {
+  return ShardForHashCode(hash_code).Lookup(HashCodePrefix(hash_code) + key, read_ht, rows);
+}
+
+void QLRowCache::Insert(uint16_t hash_code, const std::string& key, uint64_t epoch,
+                        HybridTime read_ht, std::vector<QLTableRow> rows) {
+  if (rows.size() > kMaxRowsPerEntry || !read_ht.is_valid()) {
+    return;
+  }
+  ShardForHashCode(hash_code).Insert(
+      hash_code, HashCodePrefix(hash_code) + key, epoch, read_ht, std::move(rows));
+}
+
+void QLRowCache::Invalidate(uint16_t hash_code, HybridTime write_ht, bool has_ttl) {
+  ShardForHashCode(hash_code).Invalidate(hash_code, write_ht, has_ttl);
+}
+
+void QLRowCache::Clear() {
+  for (auto& shard : shards_) {
+    shard->Clear();
+  }
+}
+
+size_t QLRowCache::TEST_size() const {
+  size_t result = 0;
+  for (const auto& shard : shards_) {
+    result += shard->size();
+  }
+  return result;
+}
+
+} // namespace docdb
+} // namespace yb
@@ -0,0 +1,85 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_QL_ROW_CACHE_H
+#define YB_DOCDB_QL_ROW_CACHE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "yb/common/common_fwd.h"
+#include "yb/common/hybrid_time.h"
+
+#include "yb/util/mem_tracker.h"
+
+namespace yb {
+namespace docdb {
+
+// Per-tablet cache of decoded rows returned by YCQL point reads, that allows hot rows to be served
+// without going through the DocDB iterator, RocksDB block cache and block decoding.
+//
+// Entries are grouped by the hash code of the partition key. Each hash code maps to a slot that
+// tracks the hybrid time of the latest write applied to that hash code. A cached entry reflects
+// the state of its rows as of the hybrid time it was read at, and stays valid for any later read
+// time until a write to the same hash code is applied, since writes are applied in hybrid time
+// order before the safe time is moved past them.
+//
+// Rows with TTL are not cached, because their content depends on the read time. Slots that
+// received a write with TTL stop admitting new entries.
+//
+// This class is thread-safe.
+class QLRowCache {
+ public:
+  QLRowCache(size_t capacity, const MemTrackerPtr& parent_mem_tracker);
+  ~QLRowCache();
+
+  // Max number of rows stored in a single cache entry.
+  static constexpr size_t kMaxRowsPerEntry = 8;
+
+  // Returns current epoch of the slot for hash_code. The epoch should be obtained before reading
+  // rows from DocDB and passed to Insert, so rows read concurrently with a write are not cached.
+  uint64_t Epoch(uint16_t hash_code) const;
+
+  // Fills rows cached for the key if they are valid for read hybrid time. Returns false if there
+  // is no valid entry.
+  bool Lookup(uint16_t hash_code, const std::string& key, HybridTime read_ht,
+              std::vector<QLTableRow>* rows);
+
+  // Stores rows read for the key at read_ht. Rows are not stored if the slot was invalidated after
+  // epoch was obtained.
+  void Insert(uint16_t hash_code, const std::string& key, uint64_t epoch, HybridTime read_ht,
+              std::vector<QLTableRow> rows);
+
+  // Invalidates all entries for hash_code. Should be called after the write with write_ht was
+  // applied to the regular DB and before it becomes visible to readers.
+  void Invalidate(uint16_t hash_code, HybridTime write_ht, bool has_ttl);
+
+  // Drops all entries, for cases when the tablet data is replaced.
+  void Clear();
+
+  size_t TEST_size() const;
+
+ private:
+  class Shard;
+
+  Shard& ShardForHashCode(uint16_t hash_code) const;
+
+  MemTrackerPtr mem_tracker_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+} // namespace docdb
+} // namespace yb
+
+#endif // YB_DOCDB_QL_ROW_CACHE_H
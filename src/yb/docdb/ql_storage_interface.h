@@ -17,6 +17,7 @@
 #include <limits>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "yb/common/common_fwd.h"
 
@@ -99,6 +100,21 @@ class YQLStorageIf {
                                      const ReadHybridTime& read_time,
                                      const QLValuePB& ybctid,
                                      std::unique_ptr<YQLRowwiseIteratorIf>* iter) const = 0;
+
+  // Create iterator for querying multiple rows by ybctid. Rows are looked up with SeekTuple, which
+  // only seeks forward, so ybctids must be looked up in increasing order.
+  virtual CHECKED_STATUS GetIteratorForYbctids(
+      const Schema& projection,
+      const Schema& schema,
+      const TransactionOperationContext& txn_op_context,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      std::unique_ptr<YQLRowwiseIteratorIf>* iter) const = 0;
+
+  // Fill sorted encoded doc keys that could be used to split the stored data into parts that are
+  // scanned independently. Keys are taken from the SST file boundaries, so sizes of the parts
+  // are only roughly similar.
+  virtual CHECKED_STATUS GetSplitDocKeys(std::vector<KeyBytes>* doc_keys) const = 0;
 };
 
 }  // namespace docdb
@@ -620,19 +620,23 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
         int new_elements_added = 0;
         int return_value = 0;
         for (int i = 0; i < kv.subkey_size(); i++) {
-          // Check whether the value is already in the document, if so delete it.
-          SubDocKey key_reverse = SubDocKey(DocKey::FromRedisKey(kv.hash_code(), kv.key()),
-                                            PrimitiveValue(ValueType::kSSReverse),
-                                            PrimitiveValue(kv.value(i)));
           SubDocument subdoc_reverse;
           bool subdoc_reverse_found = false;
-          auto encoded_key_reverse = key_reverse.EncodeWithoutHt();
-          GetRedisSubDocumentData get_data = { encoded_key_reverse, &subdoc_reverse,
-                                               &subdoc_reverse_found };
-          RETURN_NOT_OK(GetRedisSubDocument(
-              data.doc_write_batch->doc_db(),
-              get_data, redis_query_id(), TransactionOperationContext(), data.deadline,
-              data.read_time));
+          // Check whether the value is already in the document, if so delete it. There is nothing
+          // to look up when the sorted set does not exist yet, so adding members to a new sorted
+          // set does not read before write.
+          if (data_type != REDIS_TYPE_NONE) {
+            SubDocKey key_reverse = SubDocKey(DocKey::FromRedisKey(kv.hash_code(), kv.key()),
+                                              PrimitiveValue(ValueType::kSSReverse),
+                                              PrimitiveValue(kv.value(i)));
+            auto encoded_key_reverse = key_reverse.EncodeWithoutHt();
+            GetRedisSubDocumentData get_data = { encoded_key_reverse, &subdoc_reverse,
+                                                 &subdoc_reverse_found };
+            RETURN_NOT_OK(GetRedisSubDocument(
+                data.doc_write_batch->doc_db(),
+                get_data, redis_query_id(), TransactionOperationContext(), data.deadline,
+                data.read_time));
+          }
 
           // Flag indicating whether we should add the given entry to the sorted set.
           bool should_add_entry = true;
@@ -715,7 +719,10 @@ Status RedisWriteOperation::ApplySet(const DocOperationApplyData& data) {
         }
 
         if (new_elements_added > 0) {
-          int64_t card = VERIFY_RESULT(GetCardinality(iterator_.get(), kv));
+          int64_t card = 0;
+          if (data_type != REDIS_TYPE_NONE) {
+            card = VERIFY_RESULT(GetCardinality(iterator_.get(), kv));
+          }
           // Insert card + new_elements_added back into the document for the updated card.
           kv_entries_card = SubDocument(PrimitiveValue(card + new_elements_added));
           kv_entries.SetChild(PrimitiveValue(ValueType::kCounter), SubDocument(kv_entries_card));
@@ -21,6 +21,7 @@
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/intent_keys_filter.h"
 #include "yb/docdb/value_type.h"
 
 #include "yb/gutil/walltime.h"
@@ -305,6 +306,9 @@ CHECKED_STATUS TransactionalWriter::operator()(
   if (last_key && FLAGS_enable_transaction_sealing) {
     reverse_value_prefix = replicated_batches_state_;
   }
+  if (intent_keys_filter_) {
+    intent_keys_filter_->Add(key->AsSlice());
+  }
   AddIntent<kNumKeyParts>(transaction_id_, key_parts, value, handler_, reverse_value_prefix);
 
   return Status::OK();
@@ -351,6 +355,9 @@ CHECKED_STATUS TransactionalWriter::AddWeakIntent(
       doc_ht_buffer->EncodeWithValueType(hybrid_time_, write_id_++),
   }};
 
+  if (intent_keys_filter_) {
+    intent_keys_filter_->Add(intent_and_types.first.AsSlice());
+  }
   AddIntent<kNumKeyParts>(transaction_id_, key, value, handler_);
 
   return Status::OK();
@@ -360,9 +367,11 @@ DocHybridTimeBuffer::DocHybridTimeBuffer() {
   buffer_[0] = ValueTypeAsChar::kHybridTime;
 }
 
-IntentsWriterContext::IntentsWriterContext(const TransactionId& transaction_id)
+IntentsWriterContext::IntentsWriterContext(
+    const TransactionId& transaction_id, int64_t* shared_left_records)
     : transaction_id_(transaction_id),
-      left_records_(FLAGS_txn_max_apply_batch_records) {
+      own_left_records_(FLAGS_txn_max_apply_batch_records),
+      left_records_(shared_left_records ? shared_left_records : &own_left_records_) {
 }
 
 IntentsWriter::IntentsWriter(const Slice& start_key,
@@ -566,8 +575,11 @@ void ApplyIntentsContext::Complete(rocksdb::DirectWriteHandler* handler) {
   }
 }
 
-RemoveIntentsContext::RemoveIntentsContext(const TransactionId& transaction_id)
-    : IntentsWriterContext(transaction_id) {
+RemoveIntentsContext::RemoveIntentsContext(
+    const TransactionId& transaction_id, IntentKeysFilter* intent_keys_filter,
+    int64_t* shared_left_records)
+    : IntentsWriterContext(transaction_id, shared_left_records),
+      intent_keys_filter_(intent_keys_filter) {
 }
 
 Result<bool> RemoveIntentsContext::Entry(
@@ -580,6 +592,10 @@ Result<bool> RemoveIntentsContext::Entry(
   handler->SingleDelete(key);
   RegisterRecord();
   if (!metadata) {
+    if (intent_keys_filter_) {
+      auto intent = VERIFY_RESULT(ParseIntentKey(value, transaction_id().AsSlice()));
+      intent_keys_filter_->Remove(intent.doc_path);
+    }
     handler->SingleDelete(value);
     RegisterRecord();
   }
@@ -80,6 +80,11 @@ class TransactionalWriter : public rocksdb::DirectWriter {
     metadata_to_store_ = value;
   }
 
+  // Doc paths of written intents are added to the filter, if it is set.
+  void SetIntentKeysFilter(IntentKeysFilter* value) {
+    intent_keys_filter_ = value;
+  }
+
   CHECKED_STATUS operator()(
       IntentStrength intent_strength, FullDocKey, Slice value_slice, KeyBytes* key,
       LastKey last_key);
@@ -100,6 +105,7 @@ class TransactionalWriter : public rocksdb::DirectWriter {
   IntraTxnWriteId intra_txn_write_id_;
   IntraTxnWriteId write_id_ = 0;
   const TransactionMetadataPB* metadata_to_store_ = nullptr;
+  IntentKeysFilter* intent_keys_filter_ = nullptr;
 
   // TODO(dtxn) weak & strong intent in one batch.
   // TODO(dtxn) extract part of code knowing about intents structure to lower level.
@@ -114,10 +120,16 @@ class TransactionalWriter : public rocksdb::DirectWriter {
 // Base class used by IntentsWriter to handle found intents.
 class IntentsWriterContext {
  public:
-  explicit IntentsWriterContext(const TransactionId& transaction_id);
+  // When shared_left_records is not null, it is the budget of records shared by all contexts of
+  // the same write batch. Otherwise each context could write up to txn_max_apply_batch_records.
+  explicit IntentsWriterContext(
+      const TransactionId& transaction_id, int64_t* shared_left_records = nullptr);
 
   virtual ~IntentsWriterContext() = default;
 
+  IntentsWriterContext(const IntentsWriterContext&) = delete;
+  void operator=(const IntentsWriterContext&) = delete;
+
   // Called at the start of iteration. Passed key of the first found entry, if present.
   virtual void Start(const boost::optional<Slice>& first_key) {}
 
@@ -141,11 +153,11 @@ class IntentsWriterContext {
   }
 
   bool reached_records_limit() const {
-    return left_records_ <= 0;
+    return *left_records_ <= 0;
   }
 
   void RegisterRecord() {
-    --left_records_;
+    --*left_records_;
   }
 
  protected:
@@ -159,7 +171,8 @@ class IntentsWriterContext {
  private:
   TransactionId transaction_id_;
   ApplyTransactionState apply_state_;
-  int64_t left_records_;
+  int64_t own_left_records_;
+  int64_t* left_records_;
 };
 
 class IntentsWriter : public rocksdb::DirectWriter {
@@ -212,7 +225,11 @@ class ApplyIntentsContext : public IntentsWriterContext {
 
 class RemoveIntentsContext : public IntentsWriterContext {
  public:
-  explicit RemoveIntentsContext(const TransactionId& transaction_id);
+  // Doc paths of removed intents are removed from intent_keys_filter, when it is not null.
+  // See IntentsWriterContext for shared_left_records.
+  RemoveIntentsContext(
+      const TransactionId& transaction_id, IntentKeysFilter* intent_keys_filter,
+      int64_t* shared_left_records = nullptr);
 
   Result<bool> Entry(
       const Slice& key, const Slice& value, bool metadata,
@@ -220,6 +237,7 @@ class RemoveIntentsContext : public IntentsWriterContext {
 
   void Complete(rocksdb::DirectWriteHandler* handler) override;
  private:
+  IntentKeysFilter* intent_keys_filter_;
 };
 
 } // namespace docdb
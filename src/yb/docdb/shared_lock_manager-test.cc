@@ -21,6 +21,7 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/result.h"
 #include "yb/util/test_macros.h"
@@ -35,6 +36,10 @@ using std::thread;
 
 DECLARE_bool(dump_lock_keys);
 
+METRIC_DEFINE_entity(test);
+METRIC_DEFINE_coarse_histogram(test, test_key_lock_wait_latency, "Key lock wait latency",
+                               yb::MetricUnit::kMicroseconds, "Testing key lock wait latency");
+
 namespace yb {
 namespace docdb {
 
@@ -199,5 +204,33 @@ TEST_F(SharedLockManagerTest, DumpKeys) {
       "{ key: 626172 intent_types: [kStrongRead, kStrongWrite] }]");
 }
 
+TEST_F(SharedLockManagerTest, WaitLatency) {
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_test.Instantiate(&registry, "test");
+  auto wait_latency = METRIC_test_key_lock_wait_latency.Instantiate(entity);
+  lm_.SetWaitLatencyHistogram(wait_latency);
+
+  {
+    // Uncontended lock does not wait.
+    auto lb1 = TestLockBatch();
+    ASSERT_OK(lb1.status());
+    ASSERT_EQ(wait_latency->TotalCount(), 0U);
+
+    auto lb2 = TestLockBatch(CoarseMonoClock::now() + 10ms);
+    ASSERT_NOK(lb2.status());
+    ASSERT_EQ(wait_latency->TotalCount(), 1U);
+  }
+
+  // Keys from different shards could be locked and unlocked independently.
+  for (int i = 0; i != 100; ++i) {
+    LockBatch lb(&lm_, {
+        {RefCntPrefix(Format("key_$0", i)), IntentTypeSet({IntentType::kStrongWrite})},
+        {RefCntPrefix(Format("key_$0", i + 1)), IntentTypeSet({IntentType::kWeakWrite})}},
+        CoarseTimePoint::max());
+    ASSERT_OK(lb.status());
+  }
+  ASSERT_EQ(wait_latency->TotalCount(), 1U);
+}
+
 } // namespace docdb
 } // namespace yb
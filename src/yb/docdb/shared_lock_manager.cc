@@ -25,9 +25,11 @@
 #include "yb/docdb/lock_batch.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/metrics.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/trace.h"
+#include "yb/util/wait_state.h"
 
 using std::string;
 
@@ -111,8 +113,8 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the shard mutex is locked.
+  // Shard mutex resides in lock manager and is the same for all keys of the shard.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -120,7 +122,10 @@ struct LockedBatchEntry {
 
   std::atomic<size_t> num_waiters{0};
 
-  MUST_USE_RESULT bool Lock(IntentTypeSet lock, CoarseTimePoint deadline);
+  // Time spent waiting for conflicting locks to be released is recorded to wait_latency when it is
+  // specified.
+  MUST_USE_RESULT bool Lock(
+      IntentTypeSet lock, CoarseTimePoint deadline, Histogram* wait_latency);
 
   void Unlock(IntentTypeSet lock);
 
@@ -137,29 +142,51 @@ class SharedLockManager::Impl {
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  void SetWaitLatencyHistogram(scoped_refptr<Histogram> wait_latency) {
+    wait_latency_ = std::move(wait_latency);
+  }
+
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(shard.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
+  // Keys are distributed between shards by hash, so concurrent writes of different keys usually
+  // don't contend on the same mutex.
+  static constexpr size_t kNumShards = 16;
+
+  struct Shard {
+    // The shard mutex should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+  };
+
+  Shard& ShardForKey(const RefCntPrefix& key) {
+    // Use high bits of the hash, since low bits are used by the shard map to pick a bucket.
+    return shards_[(RefCntPrefixHash()(key) >> 8) % kNumShards];
+  }
+
+  // Make sure the entries exist in the locks maps and return pointers so we can access
+  // them without holding the shard lock. Returns a vector with pointers in the same order
   // as the keys in the batch.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  std::array<Shard, kNumShards> shards_;
 
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  scoped_refptr<Histogram> wait_latency_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -184,19 +211,30 @@ std::string SharedLockManager::ToString(const LockState& state) {
   return result;
 }
 
-bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
+bool LockedBatchEntry::Lock(
+    IntentTypeSet lock_type, CoarseTimePoint deadline, Histogram* wait_latency) {
   size_t type_idx = lock_type.ToUIntPtr();
   auto& num_holding = this->num_holding;
   auto old_value = num_holding.load(std::memory_order_acquire);
   auto add = kIntentTypeSetAdd[type_idx];
+  CoarseTimePoint wait_start;
+  auto record_wait = [wait_latency, &wait_start] {
+    if (wait_latency && wait_start != CoarseTimePoint()) {
+      wait_latency->Increment(ToMicroseconds(CoarseMonoClock::now() - wait_start));
+    }
+  };
   for (;;) {
     if ((old_value & kIntentTypeSetConflicts[type_idx]) == 0) {
       auto new_value = old_value + add;
       if (num_holding.compare_exchange_weak(old_value, new_value, std::memory_order_acq_rel)) {
+        record_wait();
         return true;
       }
       continue;
     }
+    if (wait_start == CoarseTimePoint()) {
+      wait_start = CoarseMonoClock::now();
+    }
     num_waiters.fetch_add(1, std::memory_order_release);
     auto se = ScopeExit([this] {
       num_waiters.fetch_sub(1, std::memory_order_release);
@@ -204,8 +242,10 @@ bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
     std::unique_lock<std::mutex> lock(mutex);
     old_value = num_holding.load(std::memory_order_acquire);
     if ((old_value & kIntentTypeSetConflicts[type_idx]) != 0) {
+      ScopedWaitEvent wait_event(WaitEvent::kLockManager);
       if (deadline != CoarseTimePoint::max()) {
         if (cond_var.wait_until(lock, deadline) == std::cv_status::timeout) {
+          record_wait();
           return false;
         }
       } else {
@@ -263,7 +303,7 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
     const auto intent_types = key_and_intent_type.intent_types;
     VLOG(4) << "Locking " << yb::ToString(intent_types) << ": "
             << key_and_intent_type.key.as_slice().ToDebugHexString();
-    if (!key_and_intent_type.locked->Lock(intent_types, deadline)) {
+    if (!key_and_intent_type.locked->Lock(intent_types, deadline, wait_latency_.get())) {
       while (it != key_to_intent_type->begin()) {
         --it;
         it->locked->Unlock(it->intent_types);
@@ -278,16 +318,17 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
 }
 
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& shard = ShardForKey(key_and_intent_type.key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto& value = shard.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!shard.free_lock_entries.empty()) {
+        value = shard.free_lock_entries.back();
+        shard.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        shard.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = shard.lock_entries.back().get();
       }
     }
     value->ref_count++;
@@ -306,11 +347,12 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (const auto& item : key_to_intent_type) {
+    auto& shard = ShardForKey(item.key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      shard.locks.erase(item.key);
+      shard.free_lock_entries.push_back(item.locked);
     }
   }
 }
@@ -328,5 +370,9 @@ void SharedLockManager::Unlock(const LockBatchEntries& key_to_intent_type) {
   impl_->Unlock(key_to_intent_type);
 }
 
+void SharedLockManager::SetWaitLatencyHistogram(scoped_refptr<Histogram> wait_latency) {
+  impl_->SetWaitLatencyHistogram(std::move(wait_latency));
+}
+
 }  // namespace docdb
 }  // namespace yb
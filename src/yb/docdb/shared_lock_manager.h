@@ -21,6 +21,9 @@
 #include "yb/docdb/shared_lock_manager_fwd.h"
 #include "yb/docdb/intent.h"
 
+#include "yb/gutil/ref_counted.h"
+
+#include "yb/util/metrics_fwd.h"
 #include "yb/util/monotime.h"
 
 namespace yb {
@@ -47,6 +50,10 @@ class SharedLockManager {
   // Release the batch of locks. Requires that the locks are held.
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  // Time that Lock spends waiting for conflicting locks is recorded to this histogram.
+  // Should be set before the lock manager is used.
+  void SetWaitLatencyHistogram(scoped_refptr<Histogram> wait_latency);
+
   // Whether or not the state is possible
   static std::string ToString(const LockState& state);
 
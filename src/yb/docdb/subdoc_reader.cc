@@ -31,6 +31,7 @@
 #include "yb/docdb/expiration.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/docdb/key_bytes.h"
+#include "yb/docdb/packed_row.h"
 #include "yb/docdb/primitive_value.h"
 #include "yb/docdb/subdocument.h"
 #include "yb/docdb/value.h"
@@ -179,6 +180,11 @@ class LazySubDocumentHolder {
   // if it has not yet been constructed.
   Result<SubDocument*> Get();
 
+  // Returns true if the SubDocument specified by this instance is constructed, or if it is a direct
+  // child already present in its constructed parent, e.g. because it was unpacked from a packed
+  // row.
+  Result<bool> IsConstructedInParent() const;
+
  private:
   // The constructed SubDocument specified by this instance.
   SubDocument* target_ = nullptr;
@@ -224,10 +230,30 @@ Result<SubDocument*> LazySubDocumentHolder::Get() {
       "never get here.");
 }
 
+Result<bool> LazySubDocumentHolder::IsConstructedInParent() const {
+  if (target_) {
+    return true;
+  }
+  if (!parent_->IsConstructed()) {
+    return false;
+  }
+  Slice temp = key_;
+  temp.remove_prefix(parent_->key_.size());
+  PrimitiveValue child_key_part;
+  RETURN_NOT_OK(child_key_part.DecodeFromKey(&temp));
+  if (!temp.empty()) {
+    return false;
+  }
+  const SubDocument* parent = parent_->target_;
+  return parent->GetChild(child_key_part) != nullptr;
+}
+
 // This class provides a wrapper to access data corresponding to a RocksDB row.
 class DocDbRowData {
  public:
-  DocDbRowData(const Slice& key, const DocHybridTime& write_time, Value&& value);
+  DocDbRowData(
+      const Slice& key, const DocHybridTime& write_time, Value&& value,
+      std::string packed_row = std::string());
 
   static Result<std::unique_ptr<DocDbRowData>> CurrentRow(IntentAwareIterator* iter);
 
@@ -243,19 +269,26 @@ class DocDbRowData {
 
   bool IsPrimitiveValue() const { return IsPrimitiveValueType(value_.value_type()); }
 
+  bool IsPackedRow() const { return value_.value_type() == ValueType::kPackedRow; }
+
   PrimitiveValue* mutable_primitive_value() { return value_.mutable_primitive_value(); }
 
+  // Encoded packed row, set only if IsPackedRow() is true.
+  const std::string& packed_row() const { return packed_row_; }
+
  private:
   const KeyBytes target_key_;
   const DocHybridTime write_time_;
   Value value_;
+  const std::string packed_row_;
 
   DISALLOW_COPY_AND_ASSIGN(DocDbRowData);
 };
 
 DocDbRowData::DocDbRowData(
-    const Slice& key, const DocHybridTime& write_time, Value&& value):
-    target_key_(std::move(key)), write_time_(std::move(write_time)), value_(std::move(value)) {}
+    const Slice& key, const DocHybridTime& write_time, Value&& value, std::string packed_row):
+    target_key_(std::move(key)), write_time_(std::move(write_time)), value_(std::move(value)),
+    packed_row_(std::move(packed_row)) {}
 
 Result<std::unique_ptr<DocDbRowData>> DocDbRowData::CurrentRow(IntentAwareIterator* iter) {
   auto key_data = VERIFY_RESULT(iter->FetchKey());
@@ -274,7 +307,17 @@ Result<std::unique_ptr<DocDbRowData>> DocDbRowData::CurrentRow(IntentAwareIterat
     return STATUS(Corruption, "No hybrid timestamp found on entry");
   }
 
-  return std::make_unique<DocDbRowData>(key_data.key, key_data.write_time, std::move(value));
+  std::string packed_row;
+  if (value.value_type() == ValueType::kPackedRow) {
+    // Value does not keep the packed columns, so take them from the encoded value.
+    Slice encoded_value = iter->value();
+    Value control_fields;
+    RETURN_NOT_OK(control_fields.DecodeControlFields(&encoded_value));
+    packed_row = encoded_value.ToBuffer();
+  }
+
+  return std::make_unique<DocDbRowData>(
+      key_data.key, key_data.write_time, std::move(value), std::move(packed_row));
 }
 
 // This class provides a convenience handle for modifying a SubDocument specified by a provided
@@ -295,6 +338,13 @@ class DocDbRowAssembler {
 
   CHECKED_STATUS SetPrimitiveValue(DocDbRowData* row);
 
+  // Replaces the SubDocument with the columns stored in the given packed row.
+  CHECKED_STATUS SetPackedRow(const PackedRowDecoder& decoder, const DocHybridTime& write_time);
+
+  // Makes sure that a value unpacked for this key from the parent packed row is overwritten by the
+  // subsequent SetTombstone call.
+  CHECKED_STATUS HidePackedValue();
+
   Result<bool> HasStoredValue();
 
  private:
@@ -342,6 +392,28 @@ Status DocDbRowAssembler::SetPrimitiveValue(DocDbRowData* row) {
   return Status::OK();
 }
 
+Status DocDbRowAssembler::SetPackedRow(
+    const PackedRowDecoder& decoder, const DocHybridTime& write_time) {
+  auto* subdoc = VERIFY_RESULT(root_.Get());
+  *subdoc = SubDocument();
+  const auto write_time_micros = write_time.hybrid_time().GetPhysicalValueMicros();
+  for (const auto& column_id_and_value : decoder.columns()) {
+    PrimitiveValue value;
+    RETURN_NOT_OK(value.DecodeFromValue(column_id_and_value.second));
+    value.SetWriteTime(write_time_micros);
+    subdoc->SetChild(
+        PrimitiveValue(ColumnId(column_id_and_value.first)), SubDocument(std::move(value)));
+  }
+  return Status::OK();
+}
+
+Status DocDbRowAssembler::HidePackedValue() {
+  if (!root_.IsConstructed() && VERIFY_RESULT(root_.IsConstructedInParent())) {
+    RETURN_NOT_OK(root_.Get());
+  }
+  return Status::OK();
+}
+
 Result<bool> DocDbRowAssembler::HasStoredValue() {
   if (!root_.IsConstructed()) {
     return false;
@@ -586,6 +658,15 @@ Status ProcessCollection(ScopedDocDbRowContextWithData* scope) {
   return Status::OK();
 }
 
+Status ProcessPackedRow(ScopedDocDbRowContextWithData* scope) {
+  PackedRowDecoder decoder;
+  RETURN_NOT_OK(decoder.Init(scope->data()->packed_row()));
+  RETURN_NOT_OK(scope->mutable_assembler()->SetPackedRow(decoder, scope->data()->write_time()));
+  // Columns written after the row was packed are stored as children and override packed values.
+  RETURN_NOT_OK(ProcessChildren(scope->collection()));
+  return Status::OK();
+}
+
 Status MaybeReviveCollection(ScopedDocDbRowContextWithData* scope) {
   auto num_children = VERIFY_RESULT(ProcessChildren(scope->collection()));
   if (num_children == 0) {
@@ -602,6 +683,10 @@ Status ProcessSubDocument(ScopedDocDbRowContextWithData* scope) {
   auto obsolescence_tracker = scope->obsolescence_tracker();
 
   if (data->IsTombstone() || obsolescence_tracker->IsObsolete(data->write_time())) {
+    if (data->IsTombstone() && !obsolescence_tracker->IsObsolete(data->write_time())) {
+      // A tombstone written after the parent row was packed deletes the packed column value.
+      RETURN_NOT_OK(assembler->HidePackedValue());
+    }
     if (data->IsPrimitiveValue()) {
       VLOG(4) << "Discarding overwritten or expired primitive value";
       return assembler->SetTombstone();
@@ -612,6 +697,10 @@ Status ProcessSubDocument(ScopedDocDbRowContextWithData* scope) {
     return MaybeReviveCollection(scope);
   }
 
+  if (data->IsPackedRow()) {
+    return ProcessPackedRow(scope);
+  }
+
   if (data->IsCollection()) {
     return ProcessCollection(scope);
   }
@@ -683,6 +772,8 @@ Status SubDocumentReaderBuilder::InitObsolescenceInfo(
     const ObsolescenceTracker& table_obsolescence_tracker,
     const Slice& root_doc_key, const Slice& target_subdocument_key) {
   parent_obsolescence_tracker_ = table_obsolescence_tracker;
+  packed_row_.clear();
+  packed_row_write_time_ = DocHybridTime::kInvalid;
 
   // Look at ancestors to collect ttl/write-time metadata.
   IntentAwareIteratorPrefixScope prefix_scope(root_doc_key, iter_);
@@ -714,6 +805,15 @@ Status SubDocumentReaderBuilder::UpdateWithParentWriteInfo(
     return Status::OK();
   }
 
+  if (doc_ht != parent_obsolescence_tracker_.GetHighWriteTime()) {
+    Value control_fields;
+    RETURN_NOT_OK(control_fields.DecodeControlFields(&value));
+    if (DecodeValueType(value) == ValueType::kPackedRow) {
+      packed_row_.assign(value.cdata(), value.size());
+      packed_row_write_time_ = doc_ht;
+    }
+  }
+
   parent_obsolescence_tracker_ = parent_obsolescence_tracker_.Child(doc_ht);
   return Status::OK();
 }
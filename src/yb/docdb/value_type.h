@@ -138,6 +138,8 @@ namespace docdb {
     ((kWriteId, 'w')) /* ASCII code 119 */ \
     ((kTransactionId, 'x')) /* ASCII code 120 */ \
     ((kTableId, 'y')) /* ASCII code 121 */ \
+    /* All non-key columns of a row stored in a single value at the document key. */ \
+    ((kPackedRow, 'z')) /* ASCII code 122 */ \
     \
     ((kObject, '{'))  /* ASCII code 123 */ \
     \
@@ -209,7 +211,8 @@ constexpr inline bool IsInternalRecordKeyType(const ValueType value_type) {
 constexpr inline bool IsPrimitiveValueType(const ValueType value_type) {
   return (kMinPrimitiveValueType <= value_type && value_type <= kMaxPrimitiveValueType &&
           !IsCollectionType(value_type) &&
-          value_type != ValueType::kTombstone) ||
+          value_type != ValueType::kTombstone &&
+          value_type != ValueType::kPackedRow) ||
           value_type == ValueType::kTransactionApplyState ||
           value_type == ValueType::kExternalTransactionId;
 }
@@ -75,6 +75,11 @@ DEFINE_string(fs_wal_dirs, "",
                   "also and that's a reasonable default for most use cases.");
 TAG_FLAG(fs_wal_dirs, stable);
 
+DEFINE_string(fs_cold_data_dirs, "",
+              "Comma-separated list of directories on slower and cheaper storage that tablets can "
+              "use for large SST files produced by compactions. Recently written files and the "
+              "intents DB always stay in fs_data_dirs. This is an optional argument.");
+
 DEFINE_string(instance_uuid_override, "",
               "When creating local instance metadata (for master or tserver) in an empty data "
               "directory, use this UUID instead of randomly-generated one. Can be used to replace "
@@ -128,6 +133,7 @@ FsManagerOpts::FsManagerOpts()
   }
   wal_paths = strings::Split(FLAGS_fs_wal_dirs, ",", strings::SkipEmpty());
   data_paths = strings::Split(FLAGS_fs_data_dirs, ",", strings::SkipEmpty());
+  cold_data_paths = strings::Split(FLAGS_fs_cold_data_dirs, ",", strings::SkipEmpty());
 }
 
 FsManagerOpts::~FsManagerOpts() = default;
@@ -150,6 +156,7 @@ FsManager::FsManager(Env* env,
       read_only_(opts.read_only),
       wal_fs_roots_(opts.wal_paths),
       data_fs_roots_(opts.data_paths),
+      cold_data_fs_roots_(opts.cold_data_paths),
       server_type_(opts.server_type),
       metric_entity_(opts.metric_entity),
       parent_mem_tracker_(opts.parent_mem_tracker),
@@ -177,6 +184,9 @@ Status FsManager::Init() {
   for (const string& data_fs_root : data_fs_roots_) {
     all_roots.insert(data_fs_root);
   }
+  for (const string& cold_data_fs_root : cold_data_fs_roots_) {
+    all_roots.insert(cold_data_fs_root);
+  }
 
   // Build a map of original root --> canonicalized root, sanitizing each
   // root a bit as we go.
@@ -226,6 +236,15 @@ Status FsManager::Init() {
   } else {
     LOG(FATAL) << "Data directories (fs_data_dirs) must be specified";
   }
+  for (const string& cold_data_fs_root : cold_data_fs_roots_) {
+    auto canonicalized = FindOrDie(canonicalized_roots, cold_data_fs_root);
+    if (canonicalized_data_fs_roots_.count(canonicalized)) {
+      return STATUS_FORMAT(
+          InvalidArgument, "Directory $0 is specified in both fs_data_dirs and fs_cold_data_dirs",
+          cold_data_fs_root);
+    }
+    canonicalized_cold_data_fs_roots_.insert(canonicalized);
+  }
 
   for (const RootMap::value_type& e : canonicalized_roots) {
     canonicalized_all_fs_roots_.insert(e.second);
@@ -235,6 +254,7 @@ Status FsManager::Init() {
     VLOG(1) << "WAL roots: " << canonicalized_wal_fs_roots_;
     VLOG(1) << "Metadata root: " << canonicalized_metadata_fs_root_;
     VLOG(1) << "Data roots: " << canonicalized_data_fs_roots_;
+    VLOG(1) << "Cold data roots: " << canonicalized_cold_data_fs_roots_;
     VLOG(1) << "All roots: " << canonicalized_all_fs_roots_;
   }
 
@@ -323,6 +343,8 @@ Status FsManager::DeleteFileSystemLayout(ShouldDeleteLogs also_delete_logs) {
     }
     auto data_dirs = GetDataRootDirs();
     removal_list.insert(removal_list.begin(), data_dirs.begin(), data_dirs.end());
+    auto cold_data_dirs = GetColdDataRootDirs();
+    removal_list.insert(removal_list.begin(), cold_data_dirs.begin(), cold_data_dirs.end());
     removal_set.insert(removal_list.begin(), removal_list.end());
   }
 
@@ -466,6 +488,10 @@ std::set<std::string> FsManager::GetAncillaryDirs(bool add_metadata_dirs) const
     ancillary_dirs.emplace(data_dir);
     ancillary_dirs.emplace(JoinPathSegments(data_dir, kRocksDBDirName));
   }
+  for (const string& data_dir : GetColdDataRootDirs()) {
+    ancillary_dirs.emplace(data_dir);
+    ancillary_dirs.emplace(JoinPathSegments(data_dir, kRocksDBDirName));
+  }
   return ancillary_dirs;
 }
 
@@ -544,6 +570,14 @@ vector<string> FsManager::GetDataRootDirs() const {
   return data_paths;
 }
 
+vector<string> FsManager::GetColdDataRootDirs() const {
+  vector<string> data_paths;
+  for (const string& data_fs_root : canonicalized_cold_data_fs_roots_) {
+    data_paths.push_back(DataDir(data_fs_root, server_type_));
+  }
+  return data_paths;
+}
+
 vector<string> FsManager::GetWalRootDirs() const {
   DCHECK(initted_);
   vector<string> wal_dirs;
@@ -91,6 +91,9 @@ struct FsManagerOpts {
   // The paths where data blocks will be stored. Cannot be empty.
   std::vector<std::string> data_paths;
 
+  // The paths on slower storage where large SST files of tablets could be moved. Could be empty.
+  std::vector<std::string> cold_data_paths;
+
   // Whether or not read-write operations should be allowed. Defaults to false.
   bool read_only;
 
@@ -162,6 +165,9 @@ class FsManager {
 
   std::vector<std::string> GetDataRootDirs() const;
 
+  // Returns data root dirs located on the cold storage tier, empty if there is no such tier.
+  std::vector<std::string> GetColdDataRootDirs() const;
+
   std::vector<std::string> GetWalRootDirs() const;
 
   // Used for tests only. If GetWalRootDirs returns an empty vector, we will crash the process.
@@ -272,6 +278,7 @@ class FsManager {
   // as-is; they are first canonicalized during Init().
   const std::vector<std::string> wal_fs_roots_;
   const std::vector<std::string> data_fs_roots_;
+  const std::vector<std::string> cold_data_fs_roots_;
   const std::string server_type_;
 
   scoped_refptr<MetricEntity> metric_entity_;
@@ -286,6 +293,7 @@ class FsManager {
   std::set<std::string> canonicalized_wal_fs_roots_;
   std::string canonicalized_metadata_fs_root_;
   std::set<std::string> canonicalized_data_fs_roots_;
+  std::set<std::string> canonicalized_cold_data_fs_roots_;
   std::set<std::string> canonicalized_all_fs_roots_;
 
   std::unique_ptr<InstanceMetadataPB> metadata_;
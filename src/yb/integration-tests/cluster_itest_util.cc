@@ -1024,7 +1024,8 @@ Status AddServer(const TServerDetails* leader,
                  const boost::optional<int64_t>& cas_config_opid_index,
                  const MonoDelta& timeout,
                  TabletServerErrorPB::Code* error_code,
-                 bool retry) {
+                 bool retry,
+                 bool witness) {
   ChangeConfigRequestPB req;
   ChangeConfigResponsePB resp;
   RpcController rpc;
@@ -1036,6 +1037,9 @@ Status AddServer(const TServerDetails* leader,
   RaftPeerPB* peer = req.mutable_server();
   peer->set_permanent_uuid(replica_to_add->uuid());
   peer->set_member_type(member_type);
+  if (witness) {
+    peer->set_witness(true);
+  }
   CopyRegistration(replica_to_add->registration->common(), peer);
   if (cas_config_opid_index) {
     req.set_cas_config_opid_index(*cas_config_opid_index);
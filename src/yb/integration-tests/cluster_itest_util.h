@@ -400,7 +400,7 @@ Status WriteSimpleTestRow(const TServerDetails* replica,
                           const MonoDelta& timeout);
 
 // Run a ConfigChange to ADD_SERVER on 'replica_to_add'.
-// The RPC request is sent to 'leader'.
+// The RPC request is sent to 'leader'. If 'witness' is set, the replica is added as a witness.
 Status AddServer(const TServerDetails* leader,
                  const TabletId& tablet_id,
                  const TServerDetails* replica_to_add,
@@ -408,7 +408,8 @@ Status AddServer(const TServerDetails* leader,
                  const boost::optional<int64_t>& cas_config_opid_index,
                  const MonoDelta& timeout,
                  tserver::TabletServerErrorPB::Code* error_code = nullptr,
-                 bool retry = true);
+                 bool retry = true,
+                 bool witness = false);
 
 // Run a ConfigChange to REMOVE_SERVER on 'replica_to_remove'.
 // The RPC request is sent to 'leader'.
@@ -13,6 +13,7 @@
 
 #include <chrono>
 #include <regex>
+#include <set>
 
 #include "yb/client/table.h"
 
@@ -36,19 +37,24 @@
 #include "yb/tserver/ts_tablet_manager.h"
 
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/test_util.h"
 
 using namespace std::literals;
 
+DECLARE_bool(enable_global_memstore_cost_based_flush);
 DECLARE_bool(flush_rocksdb_on_shutdown);
 DECLARE_int64(global_memstore_size_percentage);
 DECLARE_int64(global_memstore_size_mb_max);
+DECLARE_uint64(global_memstore_min_flush_batch_bytes);
 DECLARE_int32(memstore_size_mb);
 DECLARE_int32(rocksdb_level0_file_num_compaction_trigger);
 DECLARE_int32(rocksdb_max_background_flushes);
 
+METRIC_DECLARE_counter(global_memstore_flushes_batched);
+
 namespace yb {
 namespace client {
 class YBTableName;
@@ -264,6 +270,38 @@ TEST_F(FlushITest, TestFlushHappens) {
   ASSERT_GT(flushed_after_writes, 0);
 }
 
+TEST_F(FlushITest, TestCostBasedBatchedFlush) {
+  FLAGS_enable_global_memstore_cost_based_flush = true;
+  // Batch is bigger than the global memstore limit, so all tablets with non empty memtable are
+  // flushed at once.
+  FLAGS_global_memstore_min_flush_batch_bytes = kServerLimitMB * 1_MB * 2;
+  auto batched_flushes = METRIC_global_memstore_flushes_batched.Instantiate(
+      cluster_->mini_tablet_server(0)->server()->metric_entity());
+  const auto batched_flushes_before = batched_flushes->value();
+  WriteAtLeast((kServerLimitMB * 1_MB) + 1);
+  ASSERT_OK(WaitFor(
+      [this] {
+        return tablet_manager_listener_->GetFlushedTablets().size() >=
+               implicit_cast<size_t>(kNumTablets);
+      },
+      60s, "Batched flush", kWaitDelay));
+
+  // The workload writes to all tablets, so the first flush round picks one of them and batches
+  // the rest with it.
+  std::set<TabletId> expected_tablets;
+  for (const auto& peer : cluster_->GetTabletPeers(0)) {
+    expected_tablets.insert(peer->tablet_id());
+  }
+  auto flushed_tablets = tablet_manager_listener_->GetFlushedTablets();
+  std::set<TabletId> first_round_tablets(
+      flushed_tablets.begin(), flushed_tablets.begin() + kNumTablets);
+  ASSERT_EQ(first_round_tablets, expected_tablets);
+  ASSERT_GE(batched_flushes->value() - batched_flushes_before, kNumTablets - 1);
+  ASSERT_OK(LoggedWaitFor(
+      [this] { return !memory_monitor()->Exceeded(); }, 30s,
+      "Waiting until memory is freed by flushes...", kWaitDelay));
+}
+
 void FlushITest::TestFlushPicksOldestInactiveTabletAfterCompaction(bool with_restart) {
   // Trigger compaction early.
   FLAGS_rocksdb_level0_file_num_compaction_trigger = 2;
@@ -25,6 +25,7 @@
 #include "yb/integration-tests/yb_table_test_base.h"
 
 #include "yb/master/master_client.proxy.h"
+#include "yb/master/master_cluster.proxy.h"
 
 #include "yb/tools/yb-admin_client.h"
 
@@ -99,6 +100,46 @@ class LoadBalancerPlacementPolicyTest : public YBTableTestBase {
     return count;
   }
 
+  // Returns the number of leaders of the given table on each tserver.
+  Result<vector<int>> GetLeadersOnTservers(const string& tablename, size_t num_tservers) {
+    auto proxy = GetMasterLeaderProxy<master::MasterClientProxy>();
+    master::GetTableLocationsRequestPB req;
+    req.mutable_table()->set_table_name(tablename);
+    req.mutable_table()->mutable_namespace_()->set_name(table_name().namespace_name());
+    master::GetTableLocationsResponsePB resp;
+
+    rpc::RpcController rpc;
+    rpc.set_timeout(kDefaultTimeout);
+    RETURN_NOT_OK(proxy.GetTableLocations(req, &resp, &rpc));
+
+    vector<int> result(num_tservers);
+    for (const auto& loc : resp.tablet_locations()) {
+      for (const auto& replica : loc.replicas()) {
+        if (replica.role() != PeerRole::LEADER) {
+          continue;
+        }
+        for (size_t i = 0; i < num_tservers; ++i) {
+          if (replica.ts_info().permanent_uuid() ==
+                  external_mini_cluster()->tablet_server(i)->instance_id().permanent_uuid()) {
+            ++result[i];
+          }
+        }
+      }
+    }
+    LOG(INFO) << Format("For table name $0 leader counts $1", tablename, result);
+    return result;
+  }
+
+  Result<bool> AreLeadersOnPreferredOnly() {
+    master::AreLeadersOnPreferredOnlyRequestPB req;
+    master::AreLeadersOnPreferredOnlyResponsePB resp;
+    rpc::RpcController rpc;
+    rpc.set_timeout(kDefaultTimeout);
+    auto proxy = GetMasterLeaderProxy<master::MasterClusterProxy>();
+    RETURN_NOT_OK(proxy.AreLeadersOnPreferredOnly(req, &resp, &rpc));
+    return !resp.has_error();
+  }
+
   void CustomizeExternalMiniCluster(ExternalMiniClusterOptions* opts) override {
     opts->extra_tserver_flags.push_back("--placement_cloud=c");
     opts->extra_tserver_flags.push_back("--placement_region=r");
@@ -213,6 +254,55 @@ TEST_F(LoadBalancerPlacementPolicyTest, CreateTableWithPlacementPolicyTest) {
   }
 }
 
+TEST_F(LoadBalancerPlacementPolicyTest, TableAffinitizedLeadersTest) {
+  // Set cluster placement policy with leaders preferred in zone 0.
+  ASSERT_OK(yb_admin_client_->ModifyPlacementInfo("c.r.z0,c.r.z1,c.r.z2", 3, ""));
+  ASSERT_OK(yb_admin_client_->SetPreferredZones({"c.r.z0"}));
+
+  const string& affinitized_table = "affinitized-leaders-test";
+  const yb::client::YBTableName placement_table(
+    YQL_DATABASE_CQL, table_name().namespace_name(), affinitized_table);
+
+  yb::client::YBSchemaBuilder b;
+  yb::client::YBSchema schema;
+  b.AddColumn("k")->Type(BINARY)->NotNull()->HashPrimaryKey();
+  ASSERT_OK(b.Build(&schema));
+
+  // The table is placed in all zones like the cluster, but prefers leaders in zone 1.
+  master::ReplicationInfoPB replication_info;
+  replication_info.mutable_live_replicas()->set_num_replicas(3);
+  for (const auto& zone : {"z0", "z1", "z2"}) {
+    auto* placement_block = replication_info.mutable_live_replicas()->add_placement_blocks();
+    auto* cloud_info = placement_block->mutable_cloud_info();
+    cloud_info->set_placement_cloud("c");
+    cloud_info->set_placement_region("r");
+    cloud_info->set_placement_zone(zone);
+    placement_block->set_min_num_replicas(1);
+  }
+  auto* affinitized_leader = replication_info.add_affinitized_leaders();
+  affinitized_leader->set_placement_cloud("c");
+  affinitized_leader->set_placement_region("r");
+  affinitized_leader->set_placement_zone("z1");
+
+  ASSERT_OK(NewTableCreator()->table_name(placement_table).schema(&schema).replication_info(
+    replication_info).Create());
+
+  // Leaders of the table follow its own affinitized leaders, while leaders of the other table
+  // follow the cluster-wide preferred zone.
+  const auto num_tservers = num_tablet_servers();
+  ASSERT_OK(WaitFor([&]() -> Result<bool> {
+    auto table_leaders = VERIFY_RESULT(GetLeadersOnTservers(affinitized_table, num_tservers));
+    auto cluster_leaders = VERIFY_RESULT(GetLeadersOnTservers(
+        table_name().table_name(), num_tservers));
+    return table_leaders == vector<int>{0, num_tablets(), 0} &&
+           cluster_leaders == vector<int>{num_tablets(), 0, 0};
+  }, kDefaultTimeout * 2, "Leaders on preferred zones"));
+
+  ASSERT_OK(WaitFor([&]() {
+    return AreLeadersOnPreferredOnly();
+  }, kDefaultTimeout, "AreLeadersOnPreferredOnly"));
+}
+
 TEST_F(LoadBalancerPlacementPolicyTest, PlacementPolicyTest) {
   // Set cluster placement policy.
   ASSERT_OK(yb_admin_client_->ModifyPlacementInfo("c.r.z0,c.r.z1,c.r.z2", 3, ""));
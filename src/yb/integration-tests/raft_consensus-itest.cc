@@ -624,6 +624,34 @@ TEST_F(RaftConsensusITest, MultiThreadedMutateAndInsertThroughConsensus) {
   ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread * FLAGS_num_client_threads);
 }
 
+// Tests that writes are replicated when raft requests with operations are sent in multi raft
+// batches, whose updates are applied concurrently by the followers.
+TEST_F(RaftConsensusITest, InsertWithMultiRaftBatchOps) {
+  ASSERT_NO_FATALS(BuildAndStart({
+      "--enable_multi_raft_heartbeat_batcher=true"s,
+      "--multi_raft_batch_ops=true"s,
+      "--multi_raft_batch_size=4"s,
+  }));
+
+  int num_threads = FLAGS_num_client_threads;
+  for (int i = 0; i < num_threads; i++) {
+    scoped_refptr<yb::Thread> new_thread;
+    CHECK_OK(yb::Thread::Create("test", strings::Substitute("ts-test$0", i),
+                                  &RaftConsensusITest::InsertTestRowsRemoteThread,
+                                  this, i * FLAGS_client_inserts_per_thread,
+                                  FLAGS_client_inserts_per_thread,
+                                  FLAGS_client_num_batches_per_thread,
+                                  vector<CountDownLatch*>(),
+                                  &new_thread));
+    threads_.push_back(new_thread);
+  }
+  for (scoped_refptr<yb::Thread> thr : threads_) {
+    CHECK_OK(ThreadJoiner(thr.get()).Join());
+  }
+
+  ASSERT_ALL_REPLICAS_AGREE(FLAGS_client_inserts_per_thread * FLAGS_num_client_threads);
+}
+
 TEST_F(RaftConsensusITest, TestReadOnNonLeader) {
   ASSERT_NO_FATALS(BuildAndStart(vector<string>()));
 
@@ -2362,6 +2390,69 @@ TEST_F(RaftConsensusITest, TestAtomicAddRemoveServer) {
                                   active_tablet_servers, tablet_id_, ++cur_log_index));
 }
 
+// Replaces the replicas that have data, one at a time, while a witness is in the config. The
+// replica that is added back must be remote bootstrapped from the remaining data replica, and
+// must have all rows once it is the only data replica left.
+TEST_F(RaftConsensusITest, ReplaceDataReplicasWithWitness) {
+  FLAGS_num_tablet_servers = 3;
+  const MonoDelta kTimeout = MonoDelta::FromSeconds(30);
+  constexpr int kRowsPerStep = 100;
+  vector<string> ts_flags = { "--enable_leader_failure_detection=false"s };
+  vector<string> master_flags = {
+    "--catalog_manager_wait_for_new_tablets_to_elect_leader=false"s,
+    "--use_create_table_leader_hint=false"s,
+    "--enable_load_balancing=false"s,
+  };
+  ASSERT_NO_FATALS(BuildAndStart(ts_flags, master_flags));
+
+  vector<TServerDetails*> tservers = TServerDetailsVector(tablet_servers_);
+  TServerDetails* leader_ts = tservers[0];
+  TServerDetails* data_ts = tservers[1];
+  TServerDetails* witness_ts = tservers[2];
+  ASSERT_OK(StartElection(leader_ts, tablet_id_, kTimeout));
+  ASSERT_OK(WaitForServersToAgree(kTimeout, tablet_servers_, tablet_id_, 1));
+  ASSERT_OK(WaitUntilCommittedOpIdIndexIs(1, leader_ts, tablet_id_, kTimeout));
+  ASSERT_NO_FATALS(InsertTestRowsRemoteThread(0, kRowsPerStep, 1, {}));
+
+  // Turn the third replica into a witness.
+  auto active_tablet_servers = CreateTabletServerMapUnowned(tablet_servers_);
+  ASSERT_OK(RemoveServer(leader_ts, tablet_id_, witness_ts, boost::none, kTimeout));
+  ASSERT_EQ(1, active_tablet_servers.erase(witness_ts->uuid()));
+  ASSERT_OK(DeleteTablet(witness_ts, tablet_id_, tablet::TABLET_DATA_TOMBSTONED, boost::none,
+                         kTimeout));
+  ASSERT_OK(AddServer(leader_ts, tablet_id_, witness_ts, PeerMemberType::PRE_VOTER, boost::none,
+                      kTimeout, nullptr /* error_code */, true /* retry */, true /* witness */));
+  InsertOrDie(&active_tablet_servers, witness_ts->uuid(), witness_ts);
+  auto op_id = ASSERT_RESULT(GetLastOpIdForReplica(
+      tablet_id_, leader_ts, consensus::RECEIVED_OPID, kTimeout));
+  ASSERT_OK(WaitForServersToAgree(kTimeout, active_tablet_servers, tablet_id_, op_id.index));
+
+  // Kill the data follower. The leader and the witness form a majority and commit more rows.
+  cluster_->tablet_server_by_uuid(data_ts->uuid())->Shutdown();
+  ASSERT_EQ(1, active_tablet_servers.erase(data_ts->uuid()));
+  ASSERT_NO_FATALS(InsertTestRowsRemoteThread(kRowsPerStep, kRowsPerStep, 1, {}));
+  ASSERT_OK(RemoveServer(leader_ts, tablet_id_, data_ts, boost::none, kTimeout));
+
+  // Add the replica back with empty data, so it is remote bootstrapped.
+  ASSERT_OK(cluster_->tablet_server_by_uuid(data_ts->uuid())->Restart());
+  ASSERT_OK(DeleteTablet(data_ts, tablet_id_, tablet::TABLET_DATA_TOMBSTONED, boost::none,
+                         kTimeout));
+  ASSERT_OK(AddServer(leader_ts, tablet_id_, data_ts, PeerMemberType::PRE_VOTER, boost::none,
+                      kTimeout));
+  InsertOrDie(&active_tablet_servers, data_ts->uuid(), data_ts);
+  op_id = ASSERT_RESULT(GetLastOpIdForReplica(
+      tablet_id_, leader_ts, consensus::RECEIVED_OPID, kTimeout));
+  ASSERT_OK(WaitForServersToAgree(kTimeout, active_tablet_servers, tablet_id_, op_id.index));
+
+  // Kill the original leader, so the added replica is the only one with data.
+  cluster_->tablet_server_by_uuid(leader_ts->uuid())->Shutdown();
+  ASSERT_OK(StartElection(data_ts, tablet_id_, kTimeout));
+  ASSERT_OK(WaitUntilLeader(data_ts, tablet_id_, kTimeout));
+
+  vector<string> results;
+  ASSERT_NO_FATALS(WaitForRowCount(data_ts->tserver_proxy.get(), 2 * kRowsPerStep, &results));
+}
+
 // Ensure that we can elect a server that is in the "pending" configuration.  This is required by
 // the Raft protocol. See Diego Ongaro's PhD thesis, section 4.1, where it states that "it is the
 // caller's configuration that is used in reaching consensus, both for voting and for log
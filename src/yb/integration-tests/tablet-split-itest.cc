@@ -126,6 +126,7 @@ DECLARE_int32(timestamp_history_retention_interval_sec);
 DECLARE_int64(db_block_cache_size_bytes);
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_uint64(prevent_split_for_ttl_tables_for_seconds);
+DECLARE_uint64(tablet_split_table_cooldown_sec);
 
 namespace yb {
 class TabletSplitITestWithIsolationLevel : public TabletSplitITest,
@@ -1296,6 +1297,41 @@ TEST_F(AutomaticTabletSplitITest, DroppedTablesExcludedFromOutstandingSplitLimit
       table2_name));          // table
 }
 
+TEST_F(AutomaticTabletSplitITest, TableSplitCooldown) {
+  constexpr int kNumRowsPerBatch = 1000;
+  constexpr int kNumInitialTablets = 2;
+
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_low_phase_shard_count_per_node) = 1;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_low_phase_size_threshold_bytes) = 0;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_high_phase_size_threshold_bytes) = 0;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_table_cooldown_sec) = 3600;
+  // Keep split children from becoming split candidates.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_TEST_pause_before_post_split_compaction) = true;
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_automatic_tablet_splitting) = false;
+
+  SetNumTablets(kNumInitialTablets);
+  CreateTable();
+  ASSERT_OK(WriteRows(kNumRowsPerBatch, 1));
+  for (const auto& peer : ListTableActiveTabletLeadersPeers(cluster_.get(), table_->id())) {
+    ASSERT_OK(FlushAllTabletReplicas(peer->tablet_id()));
+  }
+
+  // Both tablets are split candidates, but only one of them is split within the cooldown.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_enable_automatic_tablet_splitting) = true;
+  ASSERT_OK(WaitForTabletSplitCompletion(kNumInitialTablets + 1));
+  SleepForBgTaskIters(2);
+  ASSERT_NOK(WaitForTabletSplitCompletion(
+      kNumInitialTablets + 2, // expected_non_split_tablets
+      0,                      // expected_split_tablets (default)
+      0,                      // num_replicas_online (default)
+      client::kTableName,     // table (default)
+      false));                // core_dump_on_failure
+
+  // Without the cooldown the other tablet is split as well.
+  ANNOTATE_UNPROTECTED_WRITE(FLAGS_tablet_split_table_cooldown_sec) = 0;
+  ASSERT_OK(WaitForTabletSplitCompletion(kNumInitialTablets + 2));
+}
+
 TEST_F(AutomaticTabletSplitITest, IncludeTasksInOutstandingSplits) {
   constexpr int kNumRowsPerBatch = 1000;
   constexpr int kInitialNumTablets = 2;
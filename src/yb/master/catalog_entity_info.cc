@@ -78,6 +78,7 @@ void TabletReplica::UpdateFrom(const TabletReplica& source) {
   state = source.state;
   role = source.role;
   member_type = source.member_type;
+  witness = source.witness;
   should_disable_lb_move = source.should_disable_lb_move;
   fs_data_dir = source.fs_data_dir;
   time_updated = MonoTime::Now();
@@ -75,6 +75,8 @@ struct TabletReplica {
   tablet::RaftGroupStatePB state;
   PeerRole role;
   consensus::PeerMemberType member_type;
+  // Replica is a witness, i.e. keeps only the WAL and could not become a leader.
+  bool witness = false;
   MonoTime time_updated;
 
   // Replica is reporting that load balancer moves should be disabled. This could happen in the case
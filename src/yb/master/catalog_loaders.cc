@@ -261,11 +261,13 @@ Status TabletLoader::Visit(const TabletId& tablet_id, const SysTabletsEntryPB& m
     catalog_manager_->tablegroup_ids_map_[first_table->id().substr(0, 32)] = tg;
   }
 
-  LOG(INFO) << "Loaded metadata for " << (tablet_deleted ? "deleted " : "")
-            << "tablet " << tablet_id
-            << " (first table " << first_table->ToString() << ")";
+  // Clusters could have hundreds of thousands of tablets, so do not log each of them by default.
+  // The new leader could not serve requests until all tablets are loaded.
+  VLOG(1) << "Loaded metadata for " << (tablet_deleted ? "deleted " : "")
+          << "tablet " << tablet_id
+          << " (first table " << first_table->ToString() << ")";
 
-  VLOG(1) << "Metadata for tablet " << tablet_id << ": " << metadata.ShortDebugString();
+  VLOG(2) << "Metadata for tablet " << tablet_id << ": " << metadata.ShortDebugString();
 
   if (listed_as_hidden) {
     catalog_manager_->hidden_tablets_.push_back(tablet);
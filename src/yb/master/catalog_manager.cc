@@ -1089,10 +1089,13 @@ Status CatalogManager::VisitSysCatalog(int64_t term) {
 template <class Loader>
 Status CatalogManager::Load(const std::string& title, const int64_t term) {
   LOG_WITH_PREFIX(INFO) << __func__ << ": Loading " << title << " into memory.";
+  auto start = CoarseMonoClock::Now();
   std::unique_ptr<Loader> loader = std::make_unique<Loader>(this, term);
   RETURN_NOT_OK_PREPEND(
       sys_catalog_->Visit(loader.get()),
       "Failed while visiting " + title + " in sys catalog");
+  LOG_WITH_PREFIX(INFO) << __func__ << ": Loaded " << title << " in "
+                        << MonoDelta(CoarseMonoClock::Now() - start);
   return Status::OK();
 }
 
@@ -8433,6 +8436,8 @@ void CatalogManager::CreateNewReplicaForLocalMemory(TSDescriptor* ts_desc,
                                       << " - " << report.state();
     new_replica->role = GetConsensusRole(ts_desc->permanent_uuid(), *consensus_state);
     new_replica->member_type = GetConsensusMemberType(ts_desc->permanent_uuid(), *consensus_state);
+    new_replica->witness = consensus::IsRaftConfigWitness(
+        ts_desc->permanent_uuid(), consensus_state->config());
   }
   if (report.has_should_disable_lb_move()) {
     new_replica->should_disable_lb_move = report.should_disable_lb_move();
@@ -10259,15 +10264,35 @@ Status CatalogManager::AreLeadersOnPreferredOnly(const AreLeadersOnPreferredOnly
     }
   }
 
-  // Only need to fetch if txn tables are not using preferred zones.
-  vector<TableInfoPtr> tables;
-  if (!FLAGS_transaction_tables_use_preferred_zones) {
-    tables = master_->catalog_manager()->GetTables(GetTablesMode::kRunning);
+  vector<TableInfoPtr> tables = master_->catalog_manager()->GetTables(GetTablesMode::kRunning);
+
+  // Tables with their own affinitized leaders, from custom placement or tablespace, are checked
+  // against those zones, the same way the load balancer places their leaders.
+  TableToReplicationInfoMap table_replication_info;
+  auto tablespace_manager = GetTablespaceManager();
+  for (const auto& table : tables) {
+    if (table->GetTableType() == TRANSACTION_STATUS_TABLE_TYPE &&
+        !FLAGS_transaction_tables_use_preferred_zones) {
+      continue;
+    }
+    boost::optional<ReplicationInfoPB> replication_info;
+    {
+      auto table_lock = table->LockForRead();
+      if (table_lock->pb.has_replication_info()) {
+        replication_info = table_lock->pb.replication_info();
+      }
+    }
+    if (!replication_info && tablespace_manager) {
+      replication_info = VERIFY_RESULT(tablespace_manager->GetTableReplicationInfo(table));
+    }
+    if (replication_info && replication_info->affinitized_leaders_size() > 0) {
+      table_replication_info.emplace(table->id(), std::move(*replication_info));
+    }
   }
 
   auto l = ClusterConfig()->LockForRead();
   Status s = CatalogManagerUtil::AreLeadersOnPreferredOnly(
-      ts_descs, l->pb.replication_info(), tables);
+      ts_descs, l->pb.replication_info(), tables, table_replication_info);
   if (!s.ok()) {
     return SetupError(
         resp->mutable_error(), MasterErrorPB::CAN_RETRY_ARE_LEADERS_ON_PREFERRED_ONLY_CHECK, s);
@@ -63,11 +63,38 @@ Status CatalogManagerUtil::IsLoadBalanced(const master::TSDescriptorVector& ts_d
 Status CatalogManagerUtil::AreLeadersOnPreferredOnly(
     const TSDescriptorVector& ts_descs,
     const ReplicationInfoPB& replication_info,
-    const vector<scoped_refptr<TableInfo>>& tables) {
+    const vector<scoped_refptr<TableInfo>>& tables,
+    const TableToReplicationInfoMap& table_replication_info) {
   if (PREDICT_FALSE(ts_descs.empty())) {
     return Status::OK();
   }
 
+  // Leaders of tables with their own affinitized leaders must be in the zones of the table, and
+  // are not counted against the cluster-wide affinitized leaders below.
+  std::map<std::string, int> table_affinitized_leaders;
+  for (const auto& table : tables) {
+    auto it = table_replication_info.find(table->id());
+    if (it == table_replication_info.end()) {
+      continue;
+    }
+    for (const auto& tablet : table->GetTablets()) {
+      auto leader = tablet->GetLeader();
+      if (!leader.ok()) {
+        return STATUS(
+            IllegalState,
+            Substitute("No leader found for tablet $0 of table $1.",
+                       tablet->tablet_id(), table->id()));
+      }
+      if (!(*leader)->IsAcceptingLeaderLoad(it->second)) {
+        return STATUS(
+            IllegalState,
+            Substitute("Expected no leaders of table $0 on tserver $1, found tablet $2.",
+                       table->id(), (*leader)->permanent_uuid(), tablet->tablet_id()));
+      }
+      ++table_affinitized_leaders[(*leader)->permanent_uuid()];
+    }
+  }
+
   // Variables for checking transaction leader spread.
   auto num_servers = ts_descs.size();
   std::map<std::string, int> txn_map;
@@ -117,13 +144,19 @@ Status CatalogManagerUtil::AreLeadersOnPreferredOnly(
     // Check that leaders are on preferred ts only.
     // If transaction tables follow preferred nodes, then we verify that there are 0 leaders.
     // Otherwise, we need to check that there are 0 non-txn leaders on the ts.
+    auto table_leaders = table_affinitized_leaders.find(ts_desc->permanent_uuid());
+    int excluded_leaders = system_tablets_leaders;
+    if (table_leaders != table_affinitized_leaders.end()) {
+      excluded_leaders += table_leaders->second;
+    }
     if (!ts_desc->IsAcceptingLeaderLoad(replication_info) &&
-        ts_desc->leader_count() > system_tablets_leaders) {
-      // This is a ts that shouldn't have leader load (asides from txn leaders) but does.
+        ts_desc->leader_count() > excluded_leaders) {
+      // This is a ts that shouldn't have leader load (asides from txn leaders and leaders of
+      // tables with their own affinitized leaders) but does.
       return STATUS(
           IllegalState,
           Substitute("Expected no leader load on tserver $0, found $1.",
-                     ts_desc->permanent_uuid(), ts_desc->leader_count() - system_tablets_leaders));
+                     ts_desc->permanent_uuid(), ts_desc->leader_count() - excluded_leaders));
     }
   }
   return Status::OK();
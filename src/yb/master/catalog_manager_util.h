@@ -29,6 +29,7 @@ namespace yb {
 namespace master {
 
 using ZoneToDescMap = std::unordered_map<string, TSDescriptorVector>;
+using TableToReplicationInfoMap = std::unordered_map<TableId, ReplicationInfoPB>;
 
 struct Comparator;
 
@@ -42,10 +43,13 @@ class CatalogManagerUtil {
   // actually has no leader load.
   // If transaction_tables_use_preferred_zones = false, then we also check if txn status tablet
   // leaders are spread evenly based on the information in `tables`.
+  // Leaders of the tables in `table_replication_info` are checked against the affinitized leaders
+  // of the table instead of the cluster-wide ones.
   static CHECKED_STATUS AreLeadersOnPreferredOnly(
       const TSDescriptorVector& ts_descs,
       const ReplicationInfoPB& replication_info,
-      const vector<scoped_refptr<TableInfo>>& tables = {});
+      const vector<scoped_refptr<TableInfo>>& tables = {},
+      const TableToReplicationInfoMap& table_replication_info = {});
 
   // Creates a mapping from tserver uuid to the number of transaction leaders present.
   static void CalculateTxnLeaderMap(std::map<std::string, int>* txn_map,
@@ -195,8 +195,9 @@ std::vector<std::pair<TabletId, std::string>> GetLeadersOnTSToMove(
   }
   std::vector<std::pair<TabletId, std::string>> intersection;
   copy_if(peers.begin(), peers.end(), std::back_inserter(intersection),
-          [&leaders](const std::pair<TabletId, std::string>& tablet) {
-            return leaders.count(tablet.first) > 0;
+          [&leaders, &to_ts_meta](const std::pair<TabletId, std::string>& tablet) {
+            return leaders.count(tablet.first) > 0 &&
+                   to_ts_meta.witness_tablets.count(tablet.first) == 0;
           });
   return intersection;
 }
@@ -962,6 +963,10 @@ Result<bool> ClusterLoadBalancer::GetTabletToMove(
       if (ContainsKey(from_ts_meta.disabled_by_ts_tablets, tablet_id)) {
         continue;
       }
+      // Witness replicas keep their placement, moving one would add a full replica instead.
+      if (ContainsKey(from_ts_meta.witness_tablets, tablet_id)) {
+        continue;
+      }
 
       if (VERIFY_RESULT(
           state_->CanAddTabletToTabletServer(tablet_id, to_ts, &GetPlacementByTablet(tablet_id)))) {
@@ -1368,9 +1373,23 @@ void ClusterLoadBalancer::GetAllAffinitizedZones(AffinitizedZonesSet* affinitize
   }
 }
 
+void ClusterLoadBalancer::GetTableAffinitizedZones(AffinitizedZonesSet* affinitized_zones) const {
+  auto table = GetTableInfo(state_->table_id_);
+  if (table) {
+    auto replication_info = GetTableReplicationInfo(table);
+    if (replication_info.ok() && replication_info->affinitized_leaders_size() > 0) {
+      for (const auto& ci : replication_info->affinitized_leaders()) {
+        affinitized_zones->insert(ci);
+      }
+      return;
+    }
+  }
+  GetAllAffinitizedZones(affinitized_zones);
+}
+
 void ClusterLoadBalancer::InitializeTSDescriptors() {
   if (state_->use_preferred_zones_) {
-    GetAllAffinitizedZones(&state_->affinitized_zones_);
+    GetTableAffinitizedZones(&state_->affinitized_zones_);
   }
   // Set the blacklist so we can also mark the tablet servers as we add them up.
   state_->SetBlacklist(GetServerBlacklist());
@@ -262,6 +262,10 @@ class ClusterLoadBalancer {
 
   virtual void GetAllAffinitizedZones(AffinitizedZonesSet* affinitized_zones) const;
 
+  // Get the leader affinitized zones of the current table. Preferred zones from custom placement
+  // or tablespace of the table take precedence over the cluster wide preferred zones.
+  void GetTableAffinitizedZones(AffinitizedZonesSet* affinitized_zones) const;
+
   // Go through sorted_load_ and figure out which tablet to rebalance and from which TS that is
   // serving it to which other TS.
   //
@@ -201,6 +201,10 @@ Status PerTableLoadState::UpdateTablet(TabletInfo *tablet) {
       VLOG(1) << "Replica was disabled by TS: " << replica.ToString();
     }
 
+    if (replica.witness) {
+      meta_ts.witness_tablets.insert(tablet_id);
+    }
+
     // If this replica is blacklisted, we want to keep track of these specially, so we can
     // prioritize accordingly.
     if (blacklisted_servers_.count(ts_uuid)) {
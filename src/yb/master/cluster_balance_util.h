@@ -161,6 +161,10 @@ struct CBTabletServerMetadata {
 
   // The set of tablet ids that this tablet server disabled (ex. after split).
   std::set<TabletId> disabled_by_ts_tablets;
+
+  // The set of tablet ids that have a witness replica on this tablet server. Witness replicas are
+  // placed explicitly, they are not moved and do not receive leaders.
+  std::set<TabletId> witness_tablets;
 };
 
 struct CBTabletServerLoadCounts {
@@ -54,7 +54,8 @@ class MasterTabletServiceImpl : public tserver::TabletServiceImpl {
  private:
   Result<std::shared_ptr<tablet::AbstractTablet>> GetTabletForRead(
     const TabletId& tablet_id, tablet::TabletPeerPtr tablet_peer,
-    YBConsistencyLevel consistency_level, tserver::AllowSplitTablet allow_split_tablet) override;
+    YBConsistencyLevel consistency_level, tserver::AllowSplitTablet allow_split_tablet,
+    uint64_t max_staleness_ms) override;
 
   Master *const master_;
   DISALLOW_COPY_AND_ASSIGN(MasterTabletServiceImpl);
@@ -73,6 +73,12 @@ DEFINE_uint64(prevent_split_for_ttl_tables_for_seconds, 86400,
               "Seconds between checks for whether to split a table with TTL. Checks are disabled "
               "if this value is set to 0.");
 
+DEFINE_uint64(tablet_split_table_cooldown_sec, 0,
+              "Minimum time between scheduling automatic splits of tablets of the same table, so "
+              "a table whose tablets all cross the split threshold at once is not split in a "
+              "storm. Cooldown is disabled if this value is set to 0.");
+TAG_FLAG(tablet_split_table_cooldown_sec, runtime);
+
 namespace yb {
 namespace master {
 
@@ -237,13 +243,20 @@ bool TabletSplitManager::ShouldSplitTablet(const TabletInfo& tablet) {
   return false;
 }
 
-void TabletSplitManager::ScheduleSplits(const unordered_set<TabletId>& splits_to_schedule) {
+void TabletSplitManager::ScheduleSplits(
+    const unordered_set<TabletId>& splits_to_schedule,
+    const std::unordered_map<TabletId, TableId>& new_split_tables) {
   for (const auto& tablet_id : splits_to_schedule) {
     auto s = driver_->SplitTablet(tablet_id, false /* select_all_tablets_for_split */);
     if (!s.ok()) {
       WARN_NOT_OK(s, Format("Failed to start/restart split for tablet_id: $0.", tablet_id));
-    } else {
-      LOG(INFO) << Substitute("Scheduled split for tablet_id: $0.", tablet_id);
+      continue;
+    }
+    LOG(INFO) << Substitute("Scheduled split for tablet_id: $0.", tablet_id);
+    // Only a new split that was actually scheduled starts the cooldown of its table.
+    const auto it = new_split_tables.find(tablet_id);
+    if (it != new_split_tables.end()) {
+      last_split_time_by_table_[it->second] = CoarseMonoClock::Now();
     }
   }
 }
@@ -344,16 +357,42 @@ void TabletSplitManager::DoSplitting(const TableInfoMap& table_info_map) {
     }
   }
 
+  // Forget the split times of dropped tables and of tables whose cooldown has passed.
+  const auto now = CoarseMonoClock::Now();
+  const std::chrono::seconds cooldown(FLAGS_tablet_split_table_cooldown_sec);
+  for (auto it = last_split_time_by_table_.begin(); it != last_split_time_by_table_.end();) {
+    const auto table_it = table_info_map.find(it->first);
+    if (now >= it->second + cooldown || table_it == table_info_map.end() ||
+        table_it->second->is_deleted()) {
+      it = last_split_time_by_table_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
   // Add any new splits to the set of splits to schedule (while respecting the max number of
-  // outstanding splits).
+  // outstanding splits and the per table cooldown). With the cooldown, at most one new split per
+  // table is scheduled in a round.
+  std::unordered_map<TabletId, TableId> new_split_tables;
+  unordered_set<TableId> tables_with_new_split;
   for (const auto& tablet : new_split_candidates) {
     if (!can_split_more()) {
       break;
     }
+    if (cooldown != 0s) {
+      const auto& table_id = tablet->table()->id();
+      if (last_split_time_by_table_.count(table_id) ||
+          !tables_with_new_split.insert(table_id).second) {
+        VLOG(1) << Substitute("Table $0 is in split cooldown, skipping split of tablet_id: $1",
+                              table_id, tablet->id());
+        continue;
+      }
+      new_split_tables.emplace(tablet->id(), table_id);
+    }
     splits_to_schedule.insert(tablet->id());
   }
 
-  ScheduleSplits(splits_to_schedule);
+  ScheduleSplits(splits_to_schedule, new_split_tables);
 }
 
 void TabletSplitManager::MaybeDoSplitting(const TableInfoMap& table_info_map) {
@@ -48,7 +48,10 @@ class TabletSplitManager : public TabletSplitCompleteHandlerIf {
  private:
   bool ShouldSplitTablet(const TabletInfo& tablet);
 
-  void ScheduleSplits(const unordered_set<TabletId>& splits_to_schedule);
+  // Schedules the splits, new_split_tables maps the tablets of new splits that are subject to the
+  // per table cooldown to their tables.
+  void ScheduleSplits(const unordered_set<TabletId>& splits_to_schedule,
+                      const std::unordered_map<TabletId, TableId>& new_split_tables);
 
   void DoSplitting(const TableInfoMap& table_info_map);
 
@@ -58,6 +61,11 @@ class TabletSplitManager : public TabletSplitCompleteHandlerIf {
 
   CoarseTimePoint last_run_time_;
 
+  // Time when a new split was last scheduled for each table in cooldown, see
+  // tablet_split_table_cooldown_sec. Entries are removed when the cooldown passes or the table is
+  // dropped.
+  std::unordered_map<TableId, CoarseTimePoint> last_split_time_by_table_;
+
   std::mutex mutex_;
   std::unordered_map<TableId, CoarseTimePoint> ignore_table_for_splitting_until_ GUARDED_BY(mutex_);
 
@@ -113,6 +113,23 @@ class YQLVirtualTable : public docdb::YQLStorageIf {
     return Status::OK();
   }
 
+  CHECKED_STATUS GetIteratorForYbctids(
+      const Schema& projection,
+      const Schema& schema,
+      const TransactionOperationContext& txn_op_context,
+      CoarseTimePoint deadline,
+      const ReadHybridTime& read_time,
+      docdb::YQLRowwiseIteratorIf::UniPtr* iter) const override {
+    LOG(FATAL) << "Postgresql virtual tables are not yet implemented";
+    return Status::OK();
+  }
+
+  CHECKED_STATUS GetSplitDocKeys(std::vector<docdb::KeyBytes>* doc_keys) const override {
+    // Virtual tables are generated on the fly, so they are always scanned as a whole.
+    doc_keys->clear();
+    return Status::OK();
+  }
+
  protected:
   // Finds the given column name in the schema and updates the specified column in the given row
   // with the provided value.
@@ -55,18 +55,31 @@ enum SubCacheType {
   MULTI_TOUCH
 };
 
+// Policy used to decide whether a new entry is admitted to a full cache.
+enum class CacheAdmissionPolicy {
+  // Always admit new entries, evicting the least recently used ones.
+  kAlways,
+  // Admit a new entry only when its estimated access frequency is not lower than the frequency
+  // of the entry it would evict (TinyLFU). Protects frequently used entries from being evicted by
+  // large scans.
+  kFrequency,
+};
+
 class Cache;
 
 // Create a new cache with a fixed size capacity. The cache is sharded
 // to 2^num_shard_bits shards, by hash of the key. The total capacity
 // is divided and evenly assigned to each shard.
 //
-// The parameter num_shard_bits defaults to 4, and strict_capacity_limit
-// defaults to false.
+// The parameter num_shard_bits defaults to 4, strict_capacity_limit
+// defaults to false and admission_policy defaults to kAlways.
 extern shared_ptr<Cache> NewLRUCache(size_t capacity);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
+extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
+                                     bool strict_capacity_limit,
+                                     CacheAdmissionPolicy admission_policy);
 
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
@@ -192,6 +192,14 @@ class CompactionFileFilterFactory {
   virtual std::unique_ptr<CompactionFileFilter> CreateCompactionFileFilter(
       const std::vector<FileMetaData*>& input_files) = 0;
 
+  // Creates a filter that is only used to check whether some files could be discarded, before any
+  // compaction is picked. Unlike CreateCompactionFileFilter, it should not change state visible
+  // outside of the factory, for instance commit a new history cutoff.
+  virtual std::unique_ptr<CompactionFileFilter> CreateTentativeCompactionFileFilter(
+      const std::vector<FileMetaData*>& input_files) {
+    return CreateCompactionFileFilter(input_files);
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
@@ -591,7 +591,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // With a single level, outputs of subcompactions have disjoint key ranges and are recorded as
+    // a single sorted run of level 0.
+    return (number_levels_ > 1 && output_level_ > 0) || number_levels_ == 1;
   } else {
     return false;
   }
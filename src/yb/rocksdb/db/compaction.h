@@ -299,6 +299,11 @@ class Compaction {
   yb::PriorityThreadPoolSuspender* suspender() { return suspender_; }
   void SetSuspender(yb::PriorityThreadPoolSuspender* value) { suspender_ = value; }
 
+  // Priority of the task running this compaction in the priority thread pool, used for tasks
+  // running its subcompactions.
+  int priority() const { return priority_.load(std::memory_order_acquire); }
+  void SetPriority(int value) { priority_.store(value, std::memory_order_release); }
+
  private:
   Compaction(VersionStorageInfo* input_version,
              const MutableCFOptions& mutable_cf_options,
@@ -388,6 +393,8 @@ class Compaction {
   CompactionReason compaction_reason_;
 
   yb::PriorityThreadPoolSuspender* suspender_ = nullptr;
+
+  std::atomic<int> priority_{0};
 };
 
 // Utility function
@@ -32,6 +32,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <condition_variable>
 #include <functional>
 #include <list>
 #include <memory>
@@ -72,6 +73,9 @@
 #include "yb/util/stats/perf_step_timer.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/gutil/walltime.h"
+
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/result.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
@@ -123,6 +127,9 @@ struct CompactionJob::SubcompactionState {
   CompactionJobStats compaction_job_stats;
   uint64_t approx_size;
 
+  // Suspender of the priority thread pool task running this subcompaction.
+  yb::PriorityThreadPoolSuspender* suspender = nullptr;
+
   SubcompactionState(Compaction* c, Slice* _start, Slice* _end,
                      uint64_t size = 0)
       : compaction(c),
@@ -154,6 +161,7 @@ struct CompactionJob::SubcompactionState {
     num_output_records = std::move(o.num_output_records);
     compaction_job_stats = std::move(o.compaction_job_stats);
     approx_size = std::move(o.approx_size);
+    suspender = o.suspender;
     return *this;
   }
 
@@ -403,9 +411,12 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  const uint64_t max_file_size = cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl);
+  // Output file size is not limited for level 0 of universal compaction, so the number of
+  // subcompactions is limited only by max_subcompactions in this case.
+  uint64_t max_output_files = max_file_size == std::numeric_limits<uint64_t>::max()
+      ? std::numeric_limits<uint64_t>::max()
+      : static_cast<uint64_t>(std::ceil(sum / min_file_fill_percent / max_file_size));
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -426,7 +437,18 @@ void CompactionJob::GenSubcompactionBoundaries() {
         continue;
       }
       if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
+        Slice boundary = ExtractUserKey(ranges[i].range.limit);
+        if (db_options_.subcompaction_key_prefix_extractor) {
+          // Keys with the same prefix should be processed by the same subcompaction, so the
+          // boundary is moved to the start of the prefix. It is still at or before the limit of
+          // the range, so boundaries stay ordered, but could become duplicate.
+          boundary = (*db_options_.subcompaction_key_prefix_extractor)(boundary);
+          if (boundary.empty() || (!boundaries_.empty() &&
+                                   cfd_comparator->Compare(boundary, boundaries_.back()) <= 0)) {
+            continue;
+          }
+        }
+        boundaries_.emplace_back(boundary);
         sizes_.emplace_back(sum);
         subcompactions--;
         sum = 0;
@@ -439,6 +461,94 @@ void CompactionJob::GenSubcompactionBoundaries() {
   }
 }
 
+// Runs subcompactions 1...N-1 as tasks of the priority thread pool used for compactions and
+// flushes, so they are accounted by its limit on the number of running tasks instead of using
+// extra threads. Subcompactions that were not picked up by the pool yet when the compaction
+// thread finishes its own subcompaction are run by the compaction thread, so the compaction never
+// waits for a free slot in the pool.
+class CompactionJob::SubcompactionRunner
+    : public std::enable_shared_from_this<SubcompactionRunner> {
+ public:
+  SubcompactionRunner(CompactionJob* job, FileNumbersHolder* holder)
+      : job_(job), holder_(holder), claimed_(job->compact_->sub_compact_states.size()) {}
+
+  void Run(yb::PriorityThreadPool* thread_pool) {
+    const auto priority = job_->compact_->compaction->priority();
+    for (size_t i = 1; i < claimed_.size(); ++i) {
+      auto task = std::make_unique<Task>(shared_from_this(), i);
+      auto status = thread_pool->Submit(priority, &task);
+      if (!status.ok()) {
+        // Subcompactions that were not submitted are run by the current thread below.
+        RLOG(InfoLogLevel::WARN_LEVEL, job_->db_options_.info_log,
+            "[JOB %d] Failed to submit subcompaction: %s", job_->job_id_,
+            status.ToString().c_str());
+        break;
+      }
+    }
+
+    for (size_t i = 0; i < claimed_.size(); ++i) {
+      TryRun(i, job_->compact_->compaction->suspender());
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this] { return num_finished_ == claimed_.size(); });
+  }
+
+ private:
+  class Task : public yb::PriorityThreadPoolTask {
+   public:
+    Task(std::shared_ptr<SubcompactionRunner> runner, size_t index)
+        : runner_(std::move(runner)), index_(index) {}
+
+    void Run(const Status& status, yb::PriorityThreadPoolSuspender* suspender) override {
+      // If the task was aborted, the subcompaction is run by the compaction thread.
+      if (status.ok()) {
+        runner_->TryRun(index_, suspender);
+      }
+    }
+
+    bool ShouldRemoveWithKey(void* key) override {
+      return false;
+    }
+
+    std::string ToString() const override {
+      return yb::Format("{ subcompaction: $0 }", index_);
+    }
+
+   private:
+    std::shared_ptr<SubcompactionRunner> runner_;
+    const size_t index_;
+  };
+
+  // Runs subcompaction with the specified index in the current thread, unless it was already
+  // claimed by another thread.
+  void TryRun(size_t index, yb::PriorityThreadPoolSuspender* suspender) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (claimed_[index]) {
+        return;
+      }
+      claimed_[index] = true;
+    }
+    auto* sub_compact = &job_->compact_->sub_compact_states[index];
+    sub_compact->suspender = suspender;
+    job_->ProcessKeyValueCompaction(holder_, sub_compact);
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_finished_;
+    cond_.notify_all();
+  }
+
+  // job_ and holder_ are accessed only after claiming a subcompaction. All subcompactions are
+  // finished before Run returns, while tasks could outlive the job.
+  CompactionJob* const job_;
+  FileNumbersHolder* const holder_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::vector<bool> claimed_;
+  size_t num_finished_ = 0;
+};
+
 Result<FileNumbersHolder> CompactionJob::Run() {
   TEST_SYNC_POINT("CompactionJob::Run():Start");
   log_buffer_->FlushBufferToLog();
@@ -448,23 +558,31 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   assert(num_threads > 0);
   const uint64_t start_micros = env_->NowMicros();
 
-  // Launch a thread for each of subcompactions 1...num_threads-1
-  std::vector<std::thread> thread_pool;
-  thread_pool.reserve(num_threads - 1);
   FileNumbersHolder file_numbers_holder(file_numbers_provider_->CreateHolder());
   file_numbers_holder.Reserve(num_threads);
-  for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this, &file_numbers_holder,
-                             &compact_->sub_compact_states[i]);
+  for (auto& sub_compact : compact_->sub_compact_states) {
+    sub_compact.suspender = compact_->compaction->suspender();
   }
+  auto* priority_thread_pool = db_options_.priority_thread_pool_for_compactions_and_flushes;
+  if (num_threads > 1 && priority_thread_pool) {
+    std::make_shared<SubcompactionRunner>(this, &file_numbers_holder)->Run(priority_thread_pool);
+  } else {
+    // Launch a thread for each of subcompactions 1...num_threads-1
+    std::vector<std::thread> thread_pool;
+    thread_pool.reserve(num_threads - 1);
+    for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
+      thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this,
+                               &file_numbers_holder, &compact_->sub_compact_states[i]);
+    }
 
-  // Always schedule the first subcompaction (whether or not there are also
-  // others) in the current thread to be efficient with resources
-  ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
+    // Always schedule the first subcompaction (whether or not there are also
+    // others) in the current thread to be efficient with resources
+    ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
 
-  // Wait for all other threads (if there are any) to finish execution
-  for (auto& thread : thread_pool) {
-    thread.join();
+    // Wait for all other threads (if there are any) to finish execution
+    for (auto& thread : thread_pool) {
+      thread.join();
+    }
   }
 
   if (output_directory_ && !db_options_.disableDataSync) {
@@ -579,6 +697,7 @@ Status CompactionJob::Install(const MutableCFOptions& mutable_cf_options) {
 void CompactionJob::ProcessKeyValueCompaction(
     FileNumbersHolder* holder, SubcompactionState* sub_compact) {
   assert(sub_compact != nullptr);
+  const auto start_cpu_micros = GetThreadCpuTimeMicros();
   std::unique_ptr<InternalIterator> input(
       versions_->MakeInputIterator(sub_compact->compaction));
 
@@ -609,8 +728,13 @@ void CompactionJob::ProcessKeyValueCompaction(
 
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
-    // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    // filter. Each subcompaction has its own filter, so the largest value is kept.
+    auto frontier = compaction_filter->GetLargestUserFrontier();
+    if (frontier) {
+      std::lock_guard<std::mutex> lock(largest_user_frontier_mutex_);
+      UpdateUserFrontier(&largest_user_frontier_, std::move(frontier),
+                         UpdateUserValueType::kLargest);
+    }
   }
 
   MergeHelper merge(
@@ -750,6 +874,7 @@ void CompactionJob::ProcessKeyValueCompaction(
   if (compaction_filter) {
     compaction_filter->CompactionFinished();
   }
+  RecordTick(stats_, COMPACT_CPU_MICROS, GetThreadCpuTimeMicros() - start_cpu_micros);
 }
 
 void CompactionJob::RecordDroppedKeys(
@@ -921,9 +1046,26 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction outputs
   compaction->AddInputDeletions(compaction->edit());
 
+  // Outputs of parallel subcompactions to level 0 have disjoint key ranges, so they are marked as
+  // a single sorted run, identified by the smallest output file number.
+  uint64_t sorted_run_id = 0;
+  if (compaction->output_level() == 0 && compact_->NumOutputFiles() > 1) {
+    for (const auto& sub_compact : compact_->sub_compact_states) {
+      for (const auto& out : sub_compact.outputs) {
+        const auto number = out.meta.fd.GetNumber();
+        sorted_run_id = sorted_run_id == 0 ? number : std::min(sorted_run_id, number);
+      }
+    }
+  }
   for (const auto& sub_compact : compact_->sub_compact_states) {
     for (const auto& out : sub_compact.outputs) {
-      compaction->edit()->AddFile(compaction->output_level(), out.meta);
+      if (sorted_run_id == 0) {
+        compaction->edit()->AddFile(compaction->output_level(), out.meta);
+      } else {
+        FileMetaData meta = out.meta;
+        meta.sorted_run_id = sorted_run_id;
+        compaction->edit()->AddFile(compaction->output_level(), meta);
+      }
     }
   }
   if (largest_user_frontier_) {
@@ -996,7 +1138,7 @@ Status CompactionJob::OpenCompactionOutputFile(
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
       writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+          std::move(*writable_file), env_options_, sub_compact->suspender));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
@@ -30,6 +30,7 @@
 #include <deque>
 #include <functional>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -102,6 +103,7 @@ class CompactionJob {
 
  private:
   struct SubcompactionState;
+  class SubcompactionRunner;
 
   void AggregateStatistics();
   void GenSubcompactionBoundaries();
@@ -181,6 +183,8 @@ class CompactionJob {
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
 
+  // Protects largest_user_frontier_, that is updated by all subcompactions.
+  std::mutex largest_user_frontier_mutex_;
   UserFrontierPtr largest_user_frontier_;
 };
 
@@ -1180,7 +1180,28 @@ bool LevelCompactionPicker::PickCompactionBySize(VersionStorageInfo* vstorage,
 bool UniversalCompactionPicker::NeedsCompaction(
     const VersionStorageInfo* vstorage) const {
   const int kLevel0 = 0;
-  return vstorage->CompactionScore(kLevel0) >= 1;
+  if (vstorage->CompactionScore(kLevel0) >= 1) {
+    return true;
+  }
+  // Files that could be directly deleted, i.e. expired by TTL, should not wait until enough files
+  // are accumulated to trigger a regular compaction.
+  if (!ioptions_.compaction_file_filter_factory) {
+    return false;
+  }
+  const auto& files = vstorage->LevelFiles(kLevel0);
+  // The picked compaction creates its own filter, here we only check whether some file could be
+  // discarded.
+  auto file_filter =
+      ioptions_.compaction_file_filter_factory->CreateTentativeCompactionFileFilter(files);
+  if (!file_filter) {
+    return false;
+  }
+  for (FileMetaData* f : files) {
+    if (!f->being_compacted && file_filter->Filter(f) == FilterDecision::kDiscard) {
+      return true;
+    }
+  }
+  return false;
 }
 
 struct UniversalCompactionPicker::SortedRun {
@@ -1213,10 +1234,19 @@ struct UniversalCompactionPicker::SortedRun {
     return file ? file->delete_after_compaction() : false;
   }
 
+  // Adds level 0 files of this sorted run to files.
+  void AppendFiles(std::vector<FileMetaData*>* files) const {
+    files->push_back(file);
+    files->insert(files->end(), sibling_files.begin(), sibling_files.end());
+  }
+
   int level;
   // `file` Will be null for level > 0. For level = 0, the sorted run is
   // for this file.
   FileMetaData* file;
+  // For level = 0, other files of the same sorted run, produced by parallel subcompactions
+  // together with `file`.
+  std::vector<FileMetaData*> sibling_files;
   // For level > 0, `size` and `compensated_file_size` are sum of sizes all
   // files in the level. `being_compacted` should be the same for all files
   // in a non-zero level. Use the value here.
@@ -1273,6 +1303,15 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
     // Any files that can be directly removed during compaction can be included, even if they
     // exceed the "max file size for compaction."
     if (f->fd.GetTotalFileSize() <= max_file_size || f->delete_after_compaction()) {
+      auto* last = ret.back().empty() ? nullptr : &ret.back().back();
+      if (last && last->level == 0 && f->SameSortedRun(*last->file) &&
+          !f->delete_after_compaction() && !last->delete_after_compaction()) {
+        last->sibling_files.push_back(f);
+        last->size += f->fd.GetTotalFileSize();
+        last->compensated_file_size += f->compensated_file_size;
+        last->being_compacted = last->being_compacted || f->being_compacted;
+        continue;
+      }
       ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
           f->being_compacted);
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
@@ -1759,8 +1798,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      picking_sr.AppendFiles(&inputs[0].files);
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1950,8 +1988,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      picking_sr.AppendFiles(&inputs[0].files);
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
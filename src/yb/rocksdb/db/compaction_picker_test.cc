@@ -24,6 +24,7 @@
 
 #include <gtest/gtest.h>
 
+#include "yb/rocksdb/compaction_filter.h"
 #include "yb/rocksdb/db/compaction_picker.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/env.h"
@@ -482,6 +483,91 @@ TEST_F(CompactionPickerTest, CompactionUniversalPickForFilesBeingCompacted) {
   ASSERT_EQ(compaction->inputs(0)->size(), 2);
 }
 
+namespace {
+
+// Discards the file with the specified number.
+class DiscardFileFilter : public CompactionFileFilter {
+ public:
+  explicit DiscardFileFilter(uint64_t file_number) : file_number_(file_number) {}
+
+  FilterDecision Filter(const FileMetaData* file) override {
+    return file->fd.GetNumber() == file_number_ ? FilterDecision::kDiscard : FilterDecision::kKeep;
+  }
+
+  const char* Name() const override { return "DiscardFileFilter"; }
+
+ private:
+  uint64_t file_number_;
+};
+
+class DiscardFileFilterFactory : public CompactionFileFilterFactory {
+ public:
+  explicit DiscardFileFilterFactory(uint64_t file_number) : file_number_(file_number) {}
+
+  std::unique_ptr<CompactionFileFilter> CreateCompactionFileFilter(
+      const std::vector<FileMetaData*>& input_files) override {
+    ++num_created_filters_;
+    return std::make_unique<DiscardFileFilter>(file_number_);
+  }
+
+  std::unique_ptr<CompactionFileFilter> CreateTentativeCompactionFileFilter(
+      const std::vector<FileMetaData*>& input_files) override {
+    return std::make_unique<DiscardFileFilter>(file_number_);
+  }
+
+  const char* Name() const override { return "DiscardFileFilterFactory"; }
+
+  // Number of filters created for compactions, tentative filters are not counted.
+  int num_created_filters() const { return num_created_filters_; }
+
+ private:
+  uint64_t file_number_;
+  int num_created_filters_ = 0;
+};
+
+} // namespace
+
+// Tests that a file that could be directly deleted triggers compaction, even when the number of
+// files is below level0_file_num_compaction_trigger.
+TEST_F(CompactionPickerTest, NeedsCompactionUniversalDeletion) {
+  DiscardFileFilterFactory file_filter_factory(/* file_number = */ 1);
+  ioptions_.compaction_style = kCompactionStyleUniversal;
+  ioptions_.num_levels = 1;
+  mutable_cf_options_.level0_file_num_compaction_trigger = 3;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, icmp_.get());
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(/* level = */ 0, /* file number = */ 2, /* smallest = */ "200000",
+      /* largest = */ "200999", /* file_size = */ 1000000, /* path_id = */ 0,
+      /* smallest seq num = */ 200, /* largest seq num = */ 299);
+  UpdateVersionStorageInfo();
+  ASSERT_LT(vstorage_->CompactionScore(0), 1);
+  ASSERT_FALSE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+
+  Add(/* level = */ 0, /* file number = */ 1, /* smallest = */ "100000",
+      /* largest = */ "100999", /* file_size = */ 1000000, /* path_id = */ 0,
+      /* smallest seq num = */ 100, /* largest seq num = */ 199);
+  UpdateVersionStorageInfo();
+  ASSERT_LT(vstorage_->CompactionScore(0), 1);
+  ASSERT_FALSE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+
+  ioptions_.compaction_file_filter_factory = &file_filter_factory;
+  ASSERT_TRUE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  // Check for compaction should not create a compaction filter, that could commit history cutoff.
+  ASSERT_EQ(file_filter_factory.num_created_filters(), 0);
+
+  auto compaction = universal_compaction_picker.PickCompaction(
+      cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_);
+  ASSERT_NE(compaction, nullptr);
+  ASSERT_EQ(compaction->compaction_reason(), CompactionReason::kUniversalDirectDeletion);
+  ASSERT_EQ(compaction->inputs(0)->size(), 1);
+  ASSERT_TRUE(file_map_.at(1).first->being_compacted);
+
+  // File that is already being compacted does not trigger another compaction.
+  ASSERT_FALSE(universal_compaction_picker.NeedsCompaction(vstorage_.get()));
+  ioptions_.compaction_file_filter_factory = nullptr;
+}
+
 // Tests if the files can be trivially moved in multi level
 // universal compaction when allow_trivial_move option is set
 // In this test as the input files overlaps, they cannot
@@ -242,6 +242,7 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
         compaction_(manual_compaction->compaction.get()), priority_(CalcPriority()) {
     db_impl->mutex_.AssertHeld();
     SetFileAndByteCount();
+    compaction_->SetPriority(priority_);
   }
 
   CompactionTask(DBImpl* db_impl, std::unique_ptr<Compaction> compaction)
@@ -250,6 +251,7 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
         priority_(CalcPriority()) {
     db_impl->mutex_.AssertHeld();
     SetFileAndByteCount();
+    compaction_->SetPriority(priority_);
   }
 
   bool ShouldRemoveWithKey(void* key) override {
@@ -320,6 +322,7 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
     auto new_priority = CalcPriority();
     if (new_priority != priority_) {
       priority_ = new_priority;
+      compaction_->SetPriority(priority_);
       return true;
     }
     return false;
@@ -5061,6 +5064,8 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
     // 4. Merges are not okay
     // 5. YugaByte-specific user-specified sequence numbers are currently not compatible with
     //    parallel memtable writes.
+    // 6. Direct writer entries are inserted with a single sequence number reserved for them,
+    //    since the number of such entries is known only after they are written.
     //
     // Rules 1..3 are enforced by checking the options
     // during startup (CheckConcurrentWritesSupported), so if
@@ -5071,6 +5076,7 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
     bool parallel =
         db_options_.allow_concurrent_memtable_write && write_group.size() > 1;
     size_t total_count = 0;
+    size_t direct_writers = 0;
     uint64_t total_byte_size = 0;
     for (auto writer : write_group) {
       if (writer->CheckCallback(this)) {
@@ -5078,6 +5084,9 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
         total_byte_size = WriteBatchInternal::AppendedByteSize(
             total_byte_size, WriteBatchInternal::ByteSize(writer->batch));
         parallel = parallel && !writer->batch->HasMerge();
+        if (writer->batch->HasDirectWriter()) {
+          ++direct_writers;
+        }
       }
     }
 
@@ -5092,7 +5101,9 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
 #endif
 
     // Reserve sequence numbers for all individual updates in this batch group.
-    last_sequence += total_count;
+    // In the non-parallel case sequence numbers for direct writer entries are reserved after
+    // they are inserted.
+    last_sequence += total_count + (parallel ? direct_writers : 0);
 
     // Record statistics
     RecordTick(stats_, NUMBER_KEYS_WRITTEN, total_count);
@@ -37,12 +37,14 @@
 #endif
 
 #include "yb/rocksdb/db/db_test_util.h"
+#include "yb/rocksdb/db/memtable.h"
 #include "yb/rocksdb/port/stack_trace.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/db/version_set.h"
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/experimental.h"
+#include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/perf_context.h"
 #include "yb/rocksdb/perf_level.h"
@@ -50,6 +52,7 @@
 #include "yb/rocksdb/sst_file_writer.h"
 #include "yb/rocksdb/table_properties.h"
 #include "yb/rocksdb/wal_filter.h"
+#include "yb/rocksdb/write_batch.h"
 #include "yb/rocksdb/utilities/write_batch_with_index.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/file_util.h"
@@ -5367,6 +5370,150 @@ TEST_F(DBTest, ConcurrentMemtableNotSupported) {
   ASSERT_NOK(db_->CreateColumnFamily(cf_options, "name", &handle));
 }
 
+namespace {
+
+class TestDirectWriter : public DirectWriter {
+ public:
+  TestDirectWriter(int writer, int batch, int num_keys)
+      : writer_(writer), batch_(batch), num_keys_(num_keys) {}
+
+  static std::string Key(int writer, int batch, int key) {
+    return yb::Format("w$0b$1k$2", writer, batch, key);
+  }
+
+  CHECKED_STATUS Apply(DirectWriteHandler* handler) override {
+    for (int i = 0; i != num_keys_; ++i) {
+      auto key = Key(writer_, batch_, i);
+      Slice key_slice(key);
+      handler->Put(SliceParts(&key_slice, 1), SliceParts(&key_slice, 1));
+    }
+    return Status::OK();
+  }
+
+ private:
+  const int writer_;
+  const int batch_;
+  const int num_keys_;
+};
+
+} // namespace
+
+TEST_F(DBTest, ConcurrentDirectWriters) {
+  constexpr int kNumWriters = 8;
+  constexpr int kNumBatches = 100;
+  constexpr int kNumKeys = 10;
+
+  Options options = CurrentOptions();
+  options.allow_concurrent_memtable_write = true;
+  options.enable_write_thread_adaptive_yield = true;
+  options.memtable_factory = std::make_shared<SkipListFactory>(0, ConcurrentWrites::kTrue);
+  DestroyAndReopen(options);
+
+  const auto initial_sequence = db_->GetLatestSequenceNumber();
+  yb::TestThreadHolder workers;
+  for (int writer = 0; writer != kNumWriters; ++writer) {
+    workers.AddThread([this, writer] {
+      WriteOptions write_options;
+      write_options.disableWAL = true;
+      for (int batch = 0; batch != kNumBatches; ++batch) {
+        TestDirectWriter direct_writer(writer, batch, kNumKeys);
+        WriteBatch write_batch;
+        write_batch.SetDirectWriter(&direct_writer);
+        ASSERT_OK(db_->Write(write_options, &write_batch));
+      }
+    });
+  }
+  workers.JoinAll();
+
+  // At least one sequence number is consumed by every direct writer.
+  ASSERT_GE(db_->GetLatestSequenceNumber(), initial_sequence + kNumWriters * kNumBatches);
+  for (int writer = 0; writer != kNumWriters; ++writer) {
+    for (int batch = 0; batch != kNumBatches; ++batch) {
+      for (int i = 0; i != kNumKeys; ++i) {
+        const auto key = TestDirectWriter::Key(writer, batch, i);
+        ASSERT_EQ(Get(key), key);
+      }
+    }
+  }
+}
+
+TEST_F(DBTest, ImmutableMemTableErase) {
+  std::atomic<bool> flush_allowed{false};
+  std::atomic<uint64_t> checked_largest{0};
+  std::atomic<uint64_t> checked_erase_largest{0};
+  std::atomic<uint64_t> erased_memtable_largest{0};
+  Options options = CurrentOptions();
+  options.allow_immutable_memtable_erase = true;
+  options.memtable_factory = std::make_shared<SkipListFactory>(0, ConcurrentWrites::kFalse);
+  options.mem_table_flush_filter_factory = std::make_shared<std::function<MemTableFilter()>>(
+      [&] {
+    return [&](const MemTable& memtable) -> Result<bool> {
+      if (memtable.Frontiers()) {
+        checked_largest = static_cast<const test::TestUserFrontier&>(
+            memtable.Frontiers()->Largest()).Value();
+      }
+      if (memtable.EraseFrontiers()) {
+        checked_erase_largest = static_cast<const test::TestUserFrontier&>(
+            memtable.EraseFrontiers()->Largest()).Value();
+        erased_memtable_largest = checked_largest.load();
+      }
+      return flush_allowed.load();
+    };
+  });
+  DestroyAndReopen(options);
+
+  WriteOptions write_options;
+  write_options.disableWAL = true;
+  auto write = [this, &write_options](uint64_t op, const std::function<void(WriteBatch*)>& f) {
+    test::TestUserFrontiers frontiers(op, op);
+    WriteBatch batch;
+    f(&batch);
+    batch.SetFrontiers(&frontiers);
+    ASSERT_OK(db_->Write(write_options, &batch));
+  };
+  write(1, [](WriteBatch* batch) { batch->Put("key1", "value1"); });
+  write(2, [](WriteBatch* batch) { batch->Put("key2", "value2"); });
+
+  // Switch memtable, filter does not allow to flush it, so it stays immutable.
+  FlushOptions flush_options;
+  flush_options.wait = false;
+  ASSERT_OK(db_->Flush(flush_options));
+  ASSERT_OK(yb::WaitFor([this, &checked_largest] {
+    return checked_largest.load() == 2 && dbfull()->TEST_NumRunningFlushes() == 0;
+  }, std::chrono::seconds(10), "Flush filter check"));
+  ASSERT_EQ(0, NumTableFilesAtLevel(0));
+  uint64_t num_immutable = 0;
+  ASSERT_TRUE(db_->GetIntProperty(DB::Properties::kNumImmutableMemTable, &num_immutable));
+  ASSERT_EQ(1U, num_immutable);
+
+  // Key is erased from immutable memtable, without adding a deletion mark to the mutable one.
+  write(3, [](WriteBatch* batch) { batch->SingleDelete("key1"); });
+  uint64_t num_entries = 0;
+  ASSERT_TRUE(db_->GetIntProperty(DB::Properties::kNumEntriesActiveMemTable, &num_entries));
+  ASSERT_EQ(0U, num_entries);
+  ASSERT_EQ("NOT_FOUND", Get("key1"));
+  ASSERT_EQ("value2", Get("key2"));
+
+  // Without frontiers the deletion mark is added.
+  {
+    WriteBatch batch;
+    batch.SingleDelete("key2");
+    ASSERT_OK(db_->Write(write_options, &batch));
+  }
+  ASSERT_TRUE(db_->GetIntProperty(DB::Properties::kNumEntriesActiveMemTable, &num_entries));
+  ASSERT_EQ(1U, num_entries);
+  ASSERT_EQ("NOT_FOUND", Get("key2"));
+
+  // Frontiers of the erasing write are kept apart from the immutable memtable frontiers, so the
+  // flushed frontier does not jump over the writes of the mutable memtable.
+  flush_allowed = true;
+  ASSERT_OK(Flush());
+  ASSERT_EQ(3U, checked_erase_largest.load());
+  ASSERT_EQ(2U, erased_memtable_largest.load());
+  ASSERT_EQ("NOT_FOUND", Get("key1"));
+  ASSERT_EQ("NOT_FOUND", Get("key2"));
+}
+
 TEST_F(DBTest, SanitizeNumThreads) {
   for (int attempt = 0; attempt < 2; attempt++) {
     const size_t kTotalTasks = 8;
@@ -22,6 +22,7 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 #include "yb/rocksdb/db/db_test_util.h"
 #include "yb/rocksdb/port/stack_trace.h"
+#include "yb/rocksdb/table/data_block_boundaries.h"
 
 namespace rocksdb {
 
@@ -71,6 +72,97 @@ TEST_F(DBTest2, IteratorPropertyVersionNumber) {
   delete iter2;
   delete iter3;
 }
+
+namespace {
+
+// The test boundary values extractor uses the reversed user key as the string boundary value.
+// Palindromic keys make the string boundary value equal to the key itself.
+std::string PalindromicKey(int i) {
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%06d", i);
+  const std::string prefix = buffer;
+  return prefix + std::string(prefix.rbegin(), prefix.rend());
+}
+
+// Accepts all files and only data blocks whose string boundary values intersect the range.
+class StringRangeFileFilter : public ReadFileFilter {
+ public:
+  StringRangeFileFilter(std::string lower, std::string upper)
+      : lower_(std::move(lower)), upper_(std::move(upper)) {}
+
+  bool Filter(const FdWithBoundaries&) const override {
+    return true;
+  }
+
+  bool FilterDataBlock(const DataBlockBoundaries& block) const override {
+    const Slice* smallest = block.smallest.user_value_with_tag(test::TAG_STRING_VALUE);
+    const Slice* largest = block.largest.user_value_with_tag(test::TAG_STRING_VALUE);
+    if (smallest == nullptr || largest == nullptr) {
+      return true;
+    }
+    return smallest->compare(upper_) <= 0 && largest->compare(lower_) >= 0;
+  }
+
+ private:
+  std::string lower_;
+  std::string upper_;
+};
+
+} // namespace
+
+TEST_F(DBTest2, DataBlockBoundaries) {
+  constexpr int kNumKeys = 1000;
+  constexpr int kLowerKey = 400;
+  constexpr int kUpperKey = 500;
+
+  for (bool store_data_block_boundaries : {false, true}) {
+    Options options = CurrentOptions();
+    options.boundary_extractor = test::MakeBoundaryValuesExtractor();
+    options.statistics = rocksdb::CreateDBStatisticsForTests();
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 256;
+    table_options.store_data_block_boundaries = store_data_block_boundaries;
+    options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+    DestroyAndReopen(options);
+
+    for (int i = 0; i != kNumKeys; ++i) {
+      ASSERT_OK(Put(PalindromicKey(i), "value"));
+    }
+    ASSERT_OK(Flush());
+
+    const std::string lower = PalindromicKey(kLowerKey);
+    const std::string upper = PalindromicKey(kUpperKey);
+    ReadOptions read_options;
+    read_options.file_filter = std::make_shared<StringRangeFileFilter>(lower, upper);
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    int num_read = 0;
+    int num_matching = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++num_read;
+      if (iter->key().compare(lower) >= 0 && iter->key().compare(upper) <= 0) {
+        ++num_matching;
+      }
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kUpperKey - kLowerKey + 1, num_matching);
+
+    const auto num_filtered_blocks =
+        TestGetTickerCount(options, DATA_BLOCK_BOUNDARIES_FILTER_USEFUL);
+    if (store_data_block_boundaries) {
+      ASSERT_LT(num_read, kNumKeys);
+      ASSERT_GT(num_filtered_blocks, 0U);
+    } else {
+      ASSERT_EQ(kNumKeys, num_read);
+      ASSERT_EQ(0U, num_filtered_blocks);
+    }
+
+    // Seek into the middle of the range should find the same key as without the filter.
+    iter->Seek(PalindromicKey(kLowerKey + 10));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(PalindromicKey(kLowerKey + 10), iter->key().ToBuffer());
+  }
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
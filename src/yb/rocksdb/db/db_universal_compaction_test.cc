@@ -28,6 +28,8 @@
 #include "yb/rocksdb/util/file_util.h"
 #include "yb/rocksdb/util/sync_point.h"
 
+#include "yb/util/priority_thread_pool.h"
+
 namespace rocksdb {
 
 static std::string CompressibleString(Random* rnd, int len) {
@@ -1069,6 +1071,74 @@ TEST_P(DBTestUniversalCompactionWithParam, UniversalCompactionFourPaths) {
   Destroy(options);
 }
 
+// Table files moved from the second path to the first one, like remote bootstrap does, should
+// be found on reopen.
+TEST_P(DBTestUniversalCompactionWithParam, UniversalCompactionMovedPathFiles) {
+  Options options;
+  options.db_paths.emplace_back(dbname_, 300 * 1024);
+  options.db_paths.emplace_back(dbname_ + "_2", 1024 * 1024 * 1024);
+  options.memtable_factory.reset(
+      new SpecialSkipListFactory(KNumKeysByGenerateNewFile - 1));
+  options.compaction_style = kCompactionStyleUniversal;
+  options.compaction_options_universal.size_ratio = 5;
+  options.write_buffer_size = 110 << 10;  // 105KB
+  options.arena_block_size = 4 << 10;
+  options.level0_file_num_compaction_trigger = 2;
+  options.num_levels = 1;
+  options = CurrentOptions(options);
+
+  ASSERT_OK(DeleteRecursively(env_, options.db_paths[1].path));
+  Reopen(options);
+
+  Random rnd(301);
+  int key_idx = 0;
+  for (int num = 0; num < 4; num++) {
+    GenerateNewFile(&rnd, &key_idx);
+  }
+  ASSERT_GT(GetSstFileCount(options.db_paths[1].path), 0);
+
+  Close();
+  auto move_table_files = [this, &options] {
+    std::vector<std::string> files;
+    ASSERT_OK(env_->GetChildren(options.db_paths[1].path, &files));
+    for (const auto& file : files) {
+      uint64_t number;
+      FileType type;
+      if (ParseFileName(file, &number, &type) &&
+          (type == kTableFile || type == kTableSBlockFile)) {
+        ASSERT_OK(env_->RenameFile(
+            options.db_paths[1].path + "/" + file, options.db_paths[0].path + "/" + file));
+      }
+    }
+  };
+  ASSERT_NO_FATALS(move_table_files());
+  ASSERT_EQ(0, GetSstFileCount(options.db_paths[1].path));
+
+  auto verify = [this, key_idx] {
+    for (int i = 0; i < key_idx; i++) {
+      auto v = Get(Key(i));
+      ASSERT_NE(v, "NOT_FOUND");
+      ASSERT_TRUE(v.size() == 1 || v.size() == 990);
+    }
+  };
+
+  Reopen(options);
+  ASSERT_NO_FATALS(verify());
+  ASSERT_OK(Flush());
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_NO_FATALS(verify());
+
+  // Table files remain readable after the second path is dropped from options.
+  Close();
+  ASSERT_NO_FATALS(move_table_files());
+  auto single_path_options = options;
+  single_path_options.db_paths.resize(1);
+  Reopen(single_path_options);
+  ASSERT_NO_FATALS(verify());
+
+  Destroy(options);
+}
+
 TEST_P(DBTestUniversalCompactionWithParam, IncreaseUniversalCompactionNumLevels) {
   std::function<void(int)> verify_func = [&](int num_keys_in_db) {
     std::string keys_in_db;
@@ -1464,6 +1534,53 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+TEST_F(DBTestUniversalCompaction, SingleLevelSubcompactions) {
+  constexpr int kNumFiles = 4;
+  constexpr int kKeysPerFile = 1000;
+  constexpr int kValueSize = 1_KB;
+  constexpr int kMaxSubcompactions = 4;
+
+  yb::PriorityThreadPool thread_pool(2);
+  Options options;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.num_levels = 1;
+  options.write_buffer_size = 100_MB;
+  options.level0_file_num_compaction_trigger = 2;
+  options.max_subcompactions = kMaxSubcompactions;
+  options.priority_thread_pool_for_compactions_and_flushes = &thread_pool;
+  options = CurrentOptions(options);
+  DestroyAndReopen(options);
+  ASSERT_OK(dbfull()->SetOptions({{"disable_auto_compactions", "true"}}));
+
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int num = 0; num < kNumFiles; num++) {
+    for (int i = 0; i < kKeysPerFile; i++) {
+      values.push_back(RandomString(&rnd, kValueSize));
+      ASSERT_OK(Put(Key(num * kKeysPerFile + i), values.back()));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_EQ(NumTableFilesAtLevel(0), kNumFiles);
+
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  const auto num_output_files = NumTableFilesAtLevel(0);
+  ASSERT_GT(num_output_files, 1);
+  ASSERT_LE(num_output_files, kMaxSubcompactions);
+
+  // Outputs of subcompactions form a single sorted run, so they should not be compacted again.
+  ASSERT_OK(dbfull()->EnableAutoCompaction({dbfull()->DefaultColumnFamily()}));
+  ASSERT_OK(dbfull()->TEST_WaitForCompact());
+  ASSERT_EQ(NumTableFilesAtLevel(0), num_output_files);
+  ASSERT_EQ(NumSortedRuns(0), num_output_files);
+
+  for (size_t i = 0; i < values.size(); i++) {
+    ASSERT_EQ(Get(Key(static_cast<int>(i))), values[i]);
+  }
+
+  Close();
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
@@ -390,14 +390,15 @@ uint64_t MemTable::ApproximateSize(const Slice& start_ikey,
 void MemTable::Add(SequenceNumber seq, ValueType type, const SliceParts& key,
                    const SliceParts& value, bool allow_concurrent) {
   PreparedAdd prepared_add;
-  auto handle = PrepareAdd(seq, type, key, value, &prepared_add);
+  auto handle = PrepareAdd(seq, type, key, value, &prepared_add, allow_concurrent);
   ApplyPreparedAdd(&handle, 1, prepared_add, allow_concurrent);
 }
 
 KeyHandle MemTable::PrepareAdd(SequenceNumber s, ValueType type,
                                const SliceParts& key,
                                const SliceParts& value,
-                               PreparedAdd* prepared_add) {
+                               PreparedAdd* prepared_add,
+                               bool allow_concurrent) {
   // Format of an entry is concatenation of:
   //  key_size     : varint32 of internal_key.size()
   //  key bytes    : char[internal_key.size()]
@@ -423,7 +424,11 @@ KeyHandle MemTable::PrepareAdd(SequenceNumber s, ValueType type,
 
   if (prefix_bloom_) {
     assert(prefix_extractor_);
-    prefix_bloom_->Add(prefix_extractor_->Transform(key.TheOnlyPart()));
+    if (allow_concurrent) {
+      prefix_bloom_->AddConcurrently(prefix_extractor_->Transform(key.TheOnlyPart()));
+    } else {
+      prefix_bloom_->Add(prefix_extractor_->Transform(key.TheOnlyPart()));
+    }
   }
 
   if (!prepared_add->min_seq_no) {
@@ -491,7 +496,7 @@ void MemTable::ApplyPreparedAdd(
     while (
         (cur_earliest_seqno == kMaxSequenceNumber ||
              prepared_add.min_seq_no < cur_earliest_seqno) &&
-        !first_seqno_.compare_exchange_weak(cur_earliest_seqno, prepared_add.min_seq_no)) {
+        !earliest_seqno_.compare_exchange_weak(cur_earliest_seqno, prepared_add.min_seq_no)) {
     }
   }
 
@@ -582,6 +587,19 @@ bool MemTable::Erase(const Slice& user_key) {
   return false;
 }
 
+bool MemTable::EraseImmutable(const Slice& user_key, const UserFrontiers& frontiers) {
+  std::lock_guard<SpinMutex> l(immutable_erase_mutex_);
+  if (!immutable_erase_allowed_ || !Erase(user_key)) {
+    return false;
+  }
+  if (erase_frontiers_) {
+    erase_frontiers_->MergeFrontiers(frontiers);
+  } else {
+    erase_frontiers_ = frontiers.Clone();
+  }
+  return true;
+}
+
 // Callback from MemTable::Get()
 namespace {
 
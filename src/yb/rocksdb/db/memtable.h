@@ -197,7 +197,7 @@ class MemTable {
 
   KeyHandle PrepareAdd(
       SequenceNumber s, ValueType type, const SliceParts& key, const SliceParts& value,
-      PreparedAdd* prepared_add);
+      PreparedAdd* prepared_add, bool allow_concurrent = false);
 
   void ApplyPreparedAdd(
       const KeyHandle* handle, size_t count, const PreparedAdd& prepared_add,
@@ -241,6 +241,20 @@ class MemTable {
 
   bool Erase(const Slice& key);
 
+  // Erases the key from this memtable after it became immutable, and merges frontiers of the
+  // erasing write into EraseFrontiers, so flush filters take this write into account.
+  // Returns false without erasing anything if immutable erase is not allowed for this memtable.
+  //
+  // REQUIRES: external synchronization to prevent simultaneous erases from the same MemTable.
+  bool EraseImmutable(const Slice& key, const UserFrontiers& frontiers);
+
+  // Allows or disallows EraseImmutable. It is disallowed while the memtable is being picked for
+  // flush and never allowed again after it was picked.
+  void SetImmutableEraseAllowed(bool value) {
+    std::lock_guard<SpinMutex> l(immutable_erase_mutex_);
+    immutable_erase_allowed_ = value;
+  }
+
   // If prev_value for key exists, attempts to update it inplace.
   // else returns false
   // Pseudocode
@@ -368,6 +382,12 @@ class MemTable {
 
   const UserFrontiers* Frontiers() const { return frontiers_.get(); }
 
+  // Frontiers of the writes that erased keys from this memtable after it became immutable, or
+  // nullptr if there were no such writes. They are kept apart from Frontiers, because these writes
+  // are newer than the writes of the next memtable, and the flushed frontier must only grow.
+  // Could be read by the flush filter, since erase is not allowed while the filter is checked.
+  const UserFrontiers* EraseFrontiers() const { return erase_frontiers_.get(); }
+
   std::string ToString() const;
 
   bool FullyErased() const {
@@ -440,6 +460,10 @@ class MemTable {
 
   std::vector<char> erase_key_buffer_;
 
+  SpinMutex immutable_erase_mutex_;
+  bool immutable_erase_allowed_ = true;
+  std::unique_ptr<UserFrontiers> erase_frontiers_;
+
   // No copying allowed
   MemTable(const MemTable&) = delete;
   MemTable& operator=(const MemTable&) = delete;
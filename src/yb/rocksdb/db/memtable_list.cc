@@ -210,6 +210,15 @@ SequenceNumber MemTableListVersion::GetEarliestSequenceNumber(
   }
 }
 
+bool MemTableListVersion::EraseImmutable(const Slice& key, const UserFrontiers& frontiers) {
+  for (auto* memtable : memlist_) {
+    if (memtable->EraseImmutable(key, frontiers)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 // caller is responsible for referencing m
 void MemTableListVersion::Add(MemTable* m, autovector<MemTable*>* to_delete) {
   assert(refs_ == 1);  // only when refs_ == 1 is MemTableListVersion mutable
@@ -262,11 +271,14 @@ void MemTableList::PickMemtablesToFlush(autovector<MemTable*>* ret, const MemTab
   for (auto it = memlist.rbegin(); it != memlist.rend(); ++it) {
     MemTable* m = *it;
     if (!m->flush_in_progress_) {
+      // Memtable frontiers should not be changed by erase after they were checked by the filter.
+      m->SetImmutableEraseAllowed(false);
       if (filter) {
         Result<bool> filter_result = filter(*m);
         if (filter_result.ok()) {
           if (!filter_result.get()) {
             // The filter succeeded and said that this memtable cannot be flushed yet.
+            m->SetImmutableEraseAllowed(true);
             continue;
           }
         } else {
@@ -107,6 +107,10 @@ class MemTableListVersion {
   // History.
   SequenceNumber GetEarliestSequenceNumber(bool include_history = false) const;
 
+  // Erases the key from the most recent memtable in this list that contains it and that was not
+  // picked for flush yet. See MemTable::EraseImmutable.
+  bool EraseImmutable(const Slice& key, const UserFrontiers& frontiers);
+
   std::string ToString() const;
 
  private:
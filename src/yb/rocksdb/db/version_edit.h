@@ -111,6 +111,9 @@ struct FileMetaData {
   BoundaryValues smallest;     // The smallest values in this file
   BoundaryValues largest;      // The largest values in this file
   bool imported = false;       // Was this file imported from another DB.
+  // Non-zero for level-0 files that were produced by parallel subcompactions of the same
+  // compaction. Such files have disjoint key ranges and form a single sorted run.
+  uint64_t sorted_run_id = 0;
 
   // Needs to be disposed when refs becomes 0.
   Cache::Handle* table_reader_handle;
@@ -141,6 +144,11 @@ struct FileMetaData {
     base::subtle::Release_Store(&delete_after_compaction_, value ? 1 : 0);
   }
 
+  // Returns true if this file and rhs belong to the same sorted run of level 0.
+  bool SameSortedRun(const FileMetaData& rhs) const {
+    return sorted_run_id != 0 && sorted_run_id == rhs.sorted_run_id;
+  }
+
   FileMetaData();
 
   // REQUIRED: Keys must be given to the function in sorted order (it expects
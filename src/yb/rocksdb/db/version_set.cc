@@ -1246,11 +1246,15 @@ void VersionStorageInfo::ComputeCompactionScore(
       // overwrites/deletions).
       int num_sorted_runs = 0;
       uint64_t total_size = 0;
+      const FileMetaData* prev = nullptr;
       for (auto* f : files_[level]) {
         if (!f->being_compacted) {
           total_size += f->compensated_file_size;
-          num_sorted_runs++;
+          if (!prev || !f->SameSortedRun(*prev)) {
+            num_sorted_runs++;
+          }
         }
+        prev = f;
       }
       if (compaction_style_ == kCompactionStyleUniversal) {
         // For universal compaction, we use level0 score to indicate
@@ -1882,14 +1886,14 @@ void VersionStorageInfo::CalculateBaseBytes(const ImmutableCFOptions& ioptions,
                                             const MutableCFOptions& options) {
   // Special logic to set number of sorted runs.
   // It is to match the previous behavior when all files are in L0.
+  // Files produced by parallel subcompactions of the same compaction are counted as one sorted run.
   int num_l0_count = 0;
-  if (options.MaxFileSizeForCompaction() == std::numeric_limits<uint64_t>::max()) {
-    num_l0_count = static_cast<int>(files_[0].size());
-  } else {
-    for (const auto& file : files_[0]) {
-      if (file->fd.GetTotalFileSize() <= options.MaxFileSizeForCompaction()) {
-        ++num_l0_count;
-      }
+  const FileMetaData* prev = nullptr;
+  for (const auto& file : files_[0]) {
+    if (file->fd.GetTotalFileSize() <= options.MaxFileSizeForCompaction() &&
+        (!prev || !file->SameSortedRun(*prev))) {
+      ++num_l0_count;
+      prev = file;
     }
   }
   if (compaction_style_ == kCompactionStyleUniversal) {
@@ -2578,6 +2582,31 @@ class ManifestReader {
 
 } // namespace
 
+void VersionSet::UpdateTableFilePaths(VersionEdit* edit) {
+  const auto& db_paths = db_options_->db_paths;
+  for (auto& level_and_file : edit->new_files_) {
+    auto& fd = level_and_file.second.fd;
+    const auto number = fd.GetNumber();
+    const auto path_id = fd.GetPathId();
+    if (db_paths.size() == 1) {
+      if (path_id != 0) {
+        fd.packed_number_and_path_id = PackFileNumberAndPathId(number, 0);
+      }
+      continue;
+    }
+    if (path_id < db_paths.size() &&
+        env_->FileExists(MakeTableFileName(db_paths[path_id].path, number)).ok()) {
+      continue;
+    }
+    for (uint32_t p = 0; p != db_paths.size(); ++p) {
+      if (p != path_id && env_->FileExists(MakeTableFileName(db_paths[p].path, number)).ok()) {
+        fd.packed_number_and_path_id = PackFileNumberAndPathId(number, p);
+        break;
+      }
+    }
+  }
+}
+
 Status VersionSet::Recover(
     const std::vector<ColumnFamilyDescriptor>& column_families,
     bool read_only) {
@@ -2707,6 +2736,7 @@ Status VersionSet::Recover(
         // to builder
         auto builder = builders.find(edit.column_family_);
         assert(builder != builders.end());
+        UpdateTableFilePaths(&edit);
         builder->second->version_builder()->Apply(&edit);
       }
 
@@ -698,6 +698,12 @@ class VersionSet {
   // REQUIRED: this is only called during single-threaded recovery
   void MarkFileNumberUsedDuringRecovery(uint64_t number);
 
+  // Table files could be moved between db_paths outside of RocksDB, e.g. remote bootstrap and
+  // checkpoints place all of them in the first path, or db_paths could be reconfigured.
+  // Updates path ids of files added by the edit to paths where those files are actually located.
+  // REQUIRED: this is only called during single-threaded recovery
+  void UpdateTableFilePaths(VersionEdit* edit);
+
   // Return the log file number for the log file that is currently
   // being compacted, or zero if there is no such log file.
   uint64_t prev_log_number() const { return prev_log_number_; }
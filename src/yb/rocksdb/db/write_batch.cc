@@ -102,21 +102,23 @@ struct BatchContentClassifier : public WriteBatch::Handler {
   }
 };
 
+class MemTableInserter;
+
 class DirectWriteHandlerImpl : public DirectWriteHandler {
  public:
-  explicit DirectWriteHandlerImpl(MemTable* mem_table, SequenceNumber seq)
-      : mem_table_(mem_table), seq_(seq) {}
+  // When concurrent is true, other write batches are inserted into the same mem table in parallel.
+  // In this case all entries share the single sequence number reserved for the direct writer,
+  // because the number of entries is not known in advance. DocDB keys are unique within a batch,
+  // since they contain hybrid time and write id, so it does not affect the order of entries.
+  DirectWriteHandlerImpl(
+      MemTableInserter* inserter, MemTable* mem_table, SequenceNumber seq, bool concurrent)
+      : inserter_(inserter), mem_table_(mem_table), seq_(seq), concurrent_(concurrent) {}
 
   void Put(const SliceParts& key, const SliceParts& value) override {
     Add(ValueType::kTypeValue, key, value);
   }
 
-  void SingleDelete(const Slice& key) override {
-    if (mem_table_->Erase(key)) {
-      return;
-    }
-    Add(ValueType::kTypeSingleDeletion, SliceParts(&key, 1), SliceParts());
-  }
+  void SingleDelete(const Slice& key) override;
 
   size_t Complete() {
     if (keys_.empty()) {
@@ -129,18 +131,20 @@ class DirectWriteHandlerImpl : public DirectWriteHandler {
       return comparator->Compare(lhs_slice, rhs_slice) < 0;
     };
     std::sort(keys_.begin(), keys_.end(), compare);
-    mem_table_->ApplyPreparedAdd(keys_.data(), keys_.size(), prepared_add_, false);
+    mem_table_->ApplyPreparedAdd(keys_.data(), keys_.size(), prepared_add_, concurrent_);
     return keys_.size();
   }
 
  private:
   void Add(ValueType value_type, const SliceParts& key, const SliceParts& value) {
-    keys_.push_back(
-        mem_table_->PrepareAdd(seq_++, value_type, key, value, &prepared_add_));
+    keys_.push_back(mem_table_->PrepareAdd(
+        concurrent_ ? seq_ : seq_++, value_type, key, value, &prepared_add_, concurrent_));
   }
 
+  MemTableInserter* inserter_;
   MemTable* mem_table_;
   SequenceNumber seq_;
+  const bool concurrent_;
   PreparedAdd prepared_add_;
   boost::container::small_vector<KeyHandle, 128> keys_;
 };
@@ -658,6 +662,32 @@ class MemTableInserter : public WriteBatch::Handler {
     }
   }
 
+  ~MemTableInserter() {
+    if (super_version_) {
+      db_->ReturnAndCleanupSuperVersion(super_version_cfd_, super_version_);
+    }
+  }
+
+  MemTableInserter(const MemTableInserter&) = delete;
+  void operator=(const MemTableInserter&) = delete;
+
+  // Erases the key from immutable memtables of the current column family,
+  // see DBOptions::allow_immutable_memtable_erase.
+  bool EraseImmutable(const Slice& key) {
+    if (!frontiers_ || !db_ || insert_flags_.Test(InsertFlag::kConcurrentMemtableWrites) ||
+        !db_->GetDBOptions().allow_immutable_memtable_erase) {
+      return false;
+    }
+    auto* cfd = cf_mems_->current();
+    if (!super_version_) {
+      super_version_ = db_->GetAndRefSuperVersion(cfd);
+      super_version_cfd_ = cfd;
+    } else if (super_version_cfd_ != cfd) {
+      return false;
+    }
+    return super_version_->imm->EraseImmutable(key, *frontiers_);
+  }
+
   bool SeekToColumnFamily(uint32_t column_family_id, Status* s) {
     // If we are in a concurrent mode, it is the caller's responsibility
     // to clone the original ColumnFamilyMemTables so that each thread
@@ -756,9 +786,11 @@ class MemTableInserter : public WriteBatch::Handler {
       return seek_status;
     }
     MemTable* mem = cf_mems_->GetMemTable();
+    // In memory erase is supported by single writer mem table only.
     if ((delete_type == ValueType::kTypeSingleDeletion ||
          delete_type == ValueType::kTypeColumnFamilySingleDeletion) &&
-        mem->Erase(key)) {
+        !insert_flags_.Test(InsertFlag::kConcurrentMemtableWrites) &&
+        (mem->Erase(key) || EraseImmutable(key))) {
       return Status::OK();
     }
     auto* moptions = mem->GetMemTableOptions();
@@ -884,6 +916,7 @@ class MemTableInserter : public WriteBatch::Handler {
       return seek_status;
     }
     cf_mems_->GetMemTable()->UpdateFrontiers(frontiers);
+    frontiers_ = &frontiers;
     return Status::OK();
   }
 
@@ -904,8 +937,20 @@ class MemTableInserter : public WriteBatch::Handler {
   SequenceNumber CurrentSequenceNumber() {
     return sequence_;
   }
+
+  const UserFrontiers* frontiers_ = nullptr;
+  SuperVersion* super_version_ = nullptr;
+  ColumnFamilyData* super_version_cfd_ = nullptr;
 };
 
+void DirectWriteHandlerImpl::SingleDelete(const Slice& key) {
+  // In memory erase is supported by single writer mem table only.
+  if (!concurrent_ && (mem_table_->Erase(key) || inserter_->EraseImmutable(key))) {
+    return;
+  }
+  Add(ValueType::kTypeSingleDeletion, SliceParts(&key, 1), SliceParts());
+}
+
 }  // namespace
 
 // This function can only be called in these conditions:
@@ -979,7 +1024,8 @@ Result<size_t> DirectInsert(WriteBatch::Handler* handler, DirectWriter* writer)
     current = mems->current();
   }
   DirectWriteHandlerImpl direct_write_handler(
-      current->mem(), mem_table_inserter->sequence_);
+      mem_table_inserter, current->mem(), mem_table_inserter->sequence_,
+      mem_table_inserter->insert_flags_.Test(InsertFlag::kConcurrentMemtableWrites));
   RETURN_NOT_OK(writer->Apply(&direct_write_handler));
   auto result = direct_write_handler.Complete();
   mem_table_inserter->CheckMemtableFull();
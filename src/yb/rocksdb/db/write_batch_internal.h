@@ -119,6 +119,13 @@ class WriteBatchInternal {
   // Set the count for the number of entries in the batch.
   static void SetCount(WriteBatch* batch, uint32_t n);
 
+  // Return the number of sequence numbers that should be reserved for the batch when it is
+  // inserted into mem table concurrently with other batches. Entries added by direct writer
+  // share a single sequence number in this case.
+  static uint32_t ConcurrentSequenceCount(const WriteBatch* batch) {
+    return Count(batch) + (batch->HasDirectWriter() ? 1 : 0);
+  }
+
   // Return the seqeunce number for the start of this batch.
   static SequenceNumber Sequence(const WriteBatch* batch);
 
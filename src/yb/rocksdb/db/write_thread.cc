@@ -330,7 +330,7 @@ void WriteThread::LaunchParallelFollowers(ParallelGroup* pg,
   while (w != pg->last_writer) {
     // Writers that won't write don't get sequence allotment
     if (!w->CallbackFailed()) {
-      sequence += WriteBatchInternal::Count(w->batch);
+      sequence += WriteBatchInternal::ConcurrentSequenceCount(w->batch);
     }
     w = w->link_newer;
 
@@ -136,6 +136,8 @@ struct ImmutableCFOptions {
   std::shared_ptr<IteratorReplacer> iterator_replacer;
 
   CompactionFileFilterFactory* compaction_file_filter_factory;
+
+  BoundaryValuesExtractor* boundary_extractor;
 };
 
 }  // namespace rocksdb
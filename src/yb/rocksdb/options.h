@@ -168,9 +168,20 @@ struct CompressionOptions {
   int window_bits;
   int level;
   int strategy;
-  CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
-  CompressionOptions(int wbits, int _lev, int _strategy)
-      : window_bits(wbits), level(_lev), strategy(_strategy) {}
+  // Maximum size of the ZSTD dictionary trained for each SST file written by compaction, 0 disables
+  // dictionaries. The dictionary is trained from the first data blocks of the file, is used to
+  // compress the following data blocks and is stored in the file, so it is only worth it for files
+  // much larger than the training input.
+  uint32_t max_dict_bytes;
+  // Amount of data block contents used to train the dictionary. 0 means 100 * max_dict_bytes, as
+  // recommended by ZSTD.
+  uint32_t zstd_max_train_bytes;
+  CompressionOptions()
+      : window_bits(-14), level(-1), strategy(0), max_dict_bytes(0), zstd_max_train_bytes(0) {}
+  CompressionOptions(int wbits, int _lev, int _strategy, uint32_t _max_dict_bytes = 0,
+                     uint32_t _zstd_max_train_bytes = 0)
+      : window_bits(wbits), level(_lev), strategy(_strategy), max_dict_bytes(_max_dict_bytes),
+        zstd_max_train_bytes(_zstd_max_train_bytes) {}
 };
 
 enum UpdateStatus {    // Return status For inplace update callback
@@ -1337,9 +1348,23 @@ struct DBOptions {
   // Supported only for level0 of universal style compactions.
   std::shared_ptr<std::function<uint64_t()>> max_file_size_for_compaction;
 
+  // Function that returns the prefix of a user key, such that all keys with the same prefix are
+  // processed by the same subcompaction. Subcompaction boundaries are truncated to this prefix.
+  // If not set, boundaries could be placed between any pair of user keys.
+  std::shared_ptr<std::function<Slice(Slice)>> subcompaction_key_prefix_extractor;
+
   // Invoked after memtable switched.
   std::shared_ptr<std::function<MemTableFilter()>> mem_table_flush_filter_factory;
 
+  // If true, a single delete that does not find its key in the mutable memtable tries to erase
+  // it from immutable memtables that were not picked for flush yet, instead of adding a deletion
+  // mark. Frontiers of the erasing write batch are merged into MemTable::EraseFrontiers of the
+  // memtable the key was erased from, so mem_table_flush_filter_factory filters could take that
+  // write into account. The memtable frontiers, which become the flushed frontier, are not changed.
+  // Write batches without frontiers never erase from immutable memtables.
+  // Works only with memtables that support in memory erase and without concurrent memtable writes.
+  bool allow_immutable_memtable_erase = false;
+
   // A prefix for log messages, usually containing the tablet id.
   std::string log_prefix;
 
@@ -1401,10 +1426,16 @@ enum ReadTier {
 };
 
 struct FdWithBoundaries;
+struct DataBlockBoundaries;
 class ReadFileFilter {
  public:
   virtual bool Filter(const FdWithBoundaries&) const = 0;
 
+  // Returns false if the data block with specified boundaries does not contain keys that should be
+  // read. Only invoked for SST files written with
+  // BlockBasedTableOptions::store_data_block_boundaries.
+  virtual bool FilterDataBlock(const DataBlockBoundaries&) const { return true; }
+
  protected:
   virtual ~ReadFileFilter() {}
 };
@@ -0,0 +1,59 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+#ifndef YB_ROCKSDB_PERSISTENT_CACHE_H
+#define YB_ROCKSDB_PERSISTENT_CACHE_H
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "yb/rocksdb/status.h"
+
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+class Env;
+
+// Secondary cache of raw (possibly compressed) SST blocks, kept on a local fast device, e.g. NVMe.
+// Lookups are done after a miss in the block cache, before reading the block from the SST file.
+// It is safe to access the cache concurrently from multiple threads.
+class PersistentCache {
+ public:
+  virtual ~PersistentCache() {}
+
+  // Inserts a copy of data under the key. Existing entry for the key is kept as is.
+  virtual CHECKED_STATUS Insert(const Slice& key, const char* data, size_t size) = 0;
+
+  // Looks up the key. Returns NotFound if the key is not present in the cache, otherwise fills
+  // data and size with a copy of the cached value.
+  virtual CHECKED_STATUS Lookup(
+      const Slice& key, std::unique_ptr<char[]>* data, size_t* size) = 0;
+
+  // Returns the total size of the cached values, including the space occupied by records that
+  // were overwritten or evicted from the index but not yet reclaimed.
+  virtual size_t GetUsage() const = 0;
+};
+
+// Creates a file based persistent cache in the directory path, which is used exclusively by this
+// cache. Entries are appended to files of file_size bytes, and the oldest file is removed when the
+// total size exceeds capacity. Files left by a previous instance are loaded, so cached blocks
+// survive process restarts.
+extern CHECKED_STATUS NewFilePersistentCache(
+    Env* env, const std::string& path, size_t capacity, size_t file_size,
+    std::shared_ptr<PersistentCache>* cache);
+
+}  // namespace rocksdb
+
+#endif  // YB_ROCKSDB_PERSISTENT_CACHE_H
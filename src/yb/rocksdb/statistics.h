@@ -216,6 +216,28 @@ enum Tickers : uint32_t {
   COMPACTION_FILES_FILTERED,
   COMPACTION_FILES_NOT_FILTERED,
 
+  // # of data blocks skipped by a scan because of their boundary values.
+  DATA_BLOCK_BOUNDARIES_FILTER_USEFUL,
+
+  // # of Next() calls done by DocDB to avoid Seek().
+  NUMBER_DB_NEXT_TO_AVOID_SEEK,
+  // # of DocDB seeks that were completed using Next() calls only.
+  NUMBER_DB_SEEK_AVOIDED,
+  // # of DocDB seeks that were forced to do Seek() after trying Next() calls.
+  NUMBER_DB_SEEK_AFTER_NEXT,
+
+  // Thread CPU time spent processing keys during compaction. Divided by COMPACT_READ_BYTES gives
+  // compaction CPU cost per byte.
+  COMPACT_CPU_MICROS,
+
+  // # of blocks not admitted to the block cache by frequency based admission, because they are
+  // accessed less frequently than the blocks they would evict.
+  BLOCK_CACHE_ADMISSION_REJECTED,
+
+  // # of blocks found or not found in the persistent cache.
+  PERSISTENT_CACHE_HIT,
+  PERSISTENT_CACHE_MISS,
+
   // End of ticker enum.
   TICKER_ENUM_MAX,
 };
@@ -319,6 +341,19 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
 
     {COMPACTION_FILES_FILTERED, "rocksdb_compaction_files_filtered"},
     {COMPACTION_FILES_NOT_FILTERED, "rocksdb_compaction_files_not_filtered"},
+
+    {DATA_BLOCK_BOUNDARIES_FILTER_USEFUL, "rocksdb_data_block_boundaries_filter_useful"},
+
+    {NUMBER_DB_NEXT_TO_AVOID_SEEK, "rocksdb_number_db_next_to_avoid_seek"},
+    {NUMBER_DB_SEEK_AVOIDED, "rocksdb_number_db_seek_avoided"},
+    {NUMBER_DB_SEEK_AFTER_NEXT, "rocksdb_number_db_seek_after_next"},
+
+    {COMPACT_CPU_MICROS, "rocksdb_compact_cpu_micros"},
+
+    {BLOCK_CACHE_ADMISSION_REJECTED, "rocksdb_block_cache_admission_rejected"},
+
+    {PERSISTENT_CACHE_HIT, "rocksdb_persistent_cache_hit"},
+    {PERSISTENT_CACHE_MISS, "rocksdb_persistent_cache_miss"},
 };
 
 /**
@@ -36,6 +36,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/status.h"
 #include "yb/rocksdb/types.h"
@@ -46,6 +47,7 @@ namespace rocksdb {
 
 // -- Block-based Table
 class FlushBlockPolicyFactory;
+class PersistentCache;
 struct TableReaderOptions;
 struct TableBuilderOptions;
 class TableBuilder;
@@ -121,6 +123,20 @@ struct BlockBasedTableOptions {
   // If NULL, rocksdb will not use a compressed block cache.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
+  // If non-NULL and block_cache is set, use the specified cache for index and filter blocks, so
+  // they are not evicted by data blocks, e.g. during a large scan.
+  // If NULL, index and filter blocks are cached in block_cache.
+  std::shared_ptr<Cache> index_and_filter_block_cache = nullptr;
+
+  // If true, the top level data index is kept in the table reader for the lifetime of the table
+  // reader, even if cache_index_and_filter_blocks is set. Lower level index blocks of
+  // kMultiLevelBinarySearch index are still cached.
+  bool pin_top_level_index = false;
+
+  // If non-NULL, raw blocks read from SST files are also stored in this cache, which is usually
+  // located on a local fast device, and looked up there before reading from the SST file.
+  std::shared_ptr<PersistentCache> persistent_cache = nullptr;
+
   // Approximate size of user data packed per block, in bytes. Note that the
   // block size specified here corresponds to uncompressed data.  The
   // actual size of the unit read from disk may be smaller if
@@ -196,6 +212,23 @@ struct BlockBasedTableOptions {
   // Default: false
   bool skip_table_builder_flush = false;
 
+  // If true, user boundary values (see BoundaryValuesExtractor) of the keys stored in each data
+  // block are collected and written to a separate meta block. ReadFileFilter::FilterDataBlock uses
+  // them to skip data blocks that cannot contain matching keys.
+  // Has no effect when DBOptions::boundary_extractor is not set.
+  //
+  // Default: false
+  bool store_data_block_boundaries = false;
+
+  // If non-nullptr, data blocks are built with a hash index that maps user key prefixes returned
+  // by this transformer to the restart interval containing the first key with such prefix, and
+  // seeks inside data blocks use it instead of binary search over all restart points.
+  // Keys with the same prefix should be stored contiguously, e.g. the transformer could return
+  // the encoded DocKey. Blocks with hash index can't be read by versions without this feature.
+  //
+  // Default: nullptr
+  const FilterPolicy::KeyTransformer* data_block_hash_index_key_transformer = nullptr;
+
   // We currently have three versions:
   // 0 -- This version is currently written out by all RocksDB's versions by
   // default.  Can be read by really old RocksDB's. Doesn't support changing
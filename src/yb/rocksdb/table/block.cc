@@ -154,7 +154,9 @@ void BlockIter::Prev() {
 void BlockIter::Initialize(
     const Comparator* comparator, const char* data,
     const KeyValueEncodingFormat key_value_encoding_format, uint32_t restarts,
-    uint32_t num_restarts, BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index) {
+    uint32_t num_restarts, BlockHashIndex* hash_index, BlockPrefixIndex* prefix_index,
+    const DataBlockHashIndex* data_block_hash_index,
+    const FilterPolicy::KeyTransformer* hash_index_key_transformer) {
   DCHECK(data_ == nullptr); // Ensure it is called only once
   DCHECK_GT(num_restarts, 0); // Ensure the param is valid
 
@@ -167,6 +169,8 @@ void BlockIter::Initialize(
   restart_index_ = num_restarts_;
   hash_index_ = hash_index;
   prefix_index_ = prefix_index;
+  data_block_hash_index_ = data_block_hash_index;
+  hash_index_key_transformer_ = hash_index_key_transformer;
 }
 
 
@@ -179,9 +183,12 @@ void BlockIter::Seek(const Slice& target) {
   bool ok = false;
   if (prefix_index_) {
     ok = PrefixSeek(target, &index);
+  } else if (hash_index_) {
+    ok = HashSeek(target, &index);
+  } else if (data_block_hash_index_) {
+    ok = DataBlockHashSeek(target, &index);
   } else {
-    ok = hash_index_ ? HashSeek(target, &index)
-      : BinarySeek(target, 0, num_restarts_ - 1, &index);
+    ok = BinarySeek(target, 0, num_restarts_ - 1, &index);
   }
 
   if (!ok) {
@@ -477,6 +484,45 @@ bool BlockIter::HashSeek(const Slice& target, uint32_t* index) {
   return BinarySeek(target, left, right, index);
 }
 
+// Uses restart index found in the data block hash index as a hint. The hint is verified to point
+// to the restart interval that could contain the first key >= target: restart key should be <=
+// target and the next restart key should be > target. Otherwise falls back to binary search in
+// the part of the restart array that is known to contain the result.
+bool BlockIter::DataBlockHashSeek(const Slice& target, uint32_t* index) {
+  assert(data_block_hash_index_);
+  assert(hash_index_key_transformer_);
+  const auto prefix = hash_index_key_transformer_->Transform(ExtractUserKey(target));
+  const uint32_t restart_index =
+      prefix.empty() ? DataBlockHashIndex::kNoEntry : data_block_hash_index_->Lookup(prefix);
+  if (restart_index >= num_restarts_) {
+    // No entry, collision or out of range value.
+    return BinarySeek(target, 0, num_restarts_ - 1, index);
+  }
+
+  if (restart_index > 0) {
+    const int cmp = CompareBlockKey(restart_index, target);
+    if (!status_.ok()) {
+      return false;
+    }
+    if (cmp > 0) {
+      return BinarySeek(target, 0, restart_index - 1, index);
+    }
+  }
+
+  if (restart_index + 1 < num_restarts_) {
+    const int cmp = CompareBlockKey(restart_index + 1, target);
+    if (!status_.ok()) {
+      return false;
+    }
+    if (cmp <= 0) {
+      return BinarySeek(target, restart_index + 1, num_restarts_ - 1, index);
+    }
+  }
+
+  *index = restart_index;
+  return true;
+}
+
 bool BlockIter::PrefixSeek(const Slice& target, uint32_t* index) {
   assert(prefix_index_);
   uint32_t* block_ids = nullptr;
@@ -492,7 +538,7 @@ bool BlockIter::PrefixSeek(const Slice& target, uint32_t* index) {
 
 uint32_t Block::NumRestarts() const {
   assert(size_ >= kMinBlockSize);
-  return DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  return num_restarts_;
 }
 
 Block::Block(BlockContents&& contents)
@@ -501,20 +547,37 @@ Block::Block(BlockContents&& contents)
       size_(contents_.data.size()) {
   if (size_ < sizeof(uint32_t)) {
     size_ = 0;  // Error marker
-  } else {
-    restart_offset_ =
-        static_cast<uint32_t>(size_) - (1 + NumRestarts()) * sizeof(uint32_t);
-    if (restart_offset_ > size_ - sizeof(uint32_t)) {
-      // The size is too small for NumRestarts() and therefore
-      // restart_offset_ wrapped around.
+    return;
+  }
+  const auto num_restarts_and_flags = DecodeFixed32(data_ + size_ - sizeof(uint32_t));
+  num_restarts_ = num_restarts_and_flags & ~kDataBlockHashIndexFlag;
+  uint64_t trailer_size = (1 + static_cast<uint64_t>(num_restarts_)) * sizeof(uint32_t);
+  uint32_t num_hash_index_buckets = 0;
+  if (num_restarts_and_flags & kDataBlockHashIndexFlag) {
+    if (size_ < 2 * sizeof(uint32_t)) {
       size_ = 0;
+      return;
     }
+    num_hash_index_buckets = DecodeFixed32(data_ + size_ - 2 * sizeof(uint32_t));
+    trailer_size += sizeof(uint32_t) + num_hash_index_buckets;
+  }
+  if (trailer_size > size_) {
+    // The size is too small for NumRestarts() and hash index.
+    size_ = 0;
+    return;
+  }
+  restart_offset_ = static_cast<uint32_t>(size_ - trailer_size);
+  if (num_hash_index_buckets != 0) {
+    data_block_hash_index_.Initialize(
+        reinterpret_cast<const uint8_t*>(data_) + restart_offset_ +
+            num_restarts_ * sizeof(uint32_t),
+        num_hash_index_buckets);
   }
 }
 
 InternalIterator* Block::NewIterator(
     const Comparator* cmp, const KeyValueEncodingFormat key_value_encoding_format, BlockIter* iter,
-    bool total_order_seek) {
+    bool total_order_seek, const FilterPolicy::KeyTransformer* hash_index_key_transformer) {
   if (size_ < kMinBlockSize) {
     if (iter != nullptr) {
       iter->SetStatus(BadBlockContentsError());
@@ -536,13 +599,20 @@ InternalIterator* Block::NewIterator(
         total_order_seek ? nullptr : hash_index_.get();
     BlockPrefixIndex* prefix_index_ptr =
         total_order_seek ? nullptr : prefix_index_.get();
+    // Data block hash index does not change seek semantics, so it is used in total order seek mode
+    // as well.
+    const DataBlockHashIndex* data_block_hash_index_ptr =
+        hash_index_key_transformer && !data_block_hash_index_.empty() ? &data_block_hash_index_
+                                                                      : nullptr;
 
     if (iter != nullptr) {
       iter->Initialize(cmp, data_, key_value_encoding_format, restart_offset_, num_restarts,
-                    hash_index_ptr, prefix_index_ptr);
+                    hash_index_ptr, prefix_index_ptr, data_block_hash_index_ptr,
+                    hash_index_key_transformer);
     } else {
       iter = new BlockIter(cmp, data_, key_value_encoding_format, restart_offset_, num_restarts,
-                           hash_index_ptr, prefix_index_ptr);
+                           hash_index_ptr, prefix_index_ptr, data_block_hash_index_ptr,
+                           hash_index_key_transformer);
     }
   }
 
@@ -32,6 +32,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <glog/logging.h>
 
@@ -49,6 +50,7 @@
 #include "yb/rocksdb/table/block_based_table_factory.h"
 #include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/block_builder.h"
+#include "yb/rocksdb/table/data_block_boundaries.h"
 #include "yb/rocksdb/table/filter_block.h"
 #include "yb/rocksdb/table/fixed_size_filter_block.h"
 #include "yb/rocksdb/table/format.h"
@@ -107,10 +109,12 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
 }
 
 // format_version is the block format as defined in include/rocksdb/table.h
+// compression_dict is only used by ZSTD, other compression types ignore it.
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
-                    std::string* compressed_output) {
+                    std::string* compressed_output,
+                    const CompressionDict* compression_dict) {
   if (*type == kNoCompression) {
     return raw;
   }
@@ -163,7 +167,7 @@ Slice CompressBlock(const Slice& raw,
       break;     // fall back to no compression.
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
-                        compressed_output) &&
+                        compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -286,6 +290,9 @@ struct BlockBasedTableBuilder::Rep {
   IndexBuilder::IndexBlocks data_index_blocks;
   BlockHandle last_index_block_handle;
   std::unique_ptr<IndexBuilder> filter_index_builder;
+  // Collects boundary values of data blocks, when enabled by
+  // BlockBasedTableOptions::store_data_block_boundaries.
+  std::unique_ptr<DataBlockBoundariesBuilder> data_block_boundaries_builder;
 
   std::string last_key;
   std::string last_filter_key;
@@ -301,6 +308,14 @@ struct BlockBasedTableBuilder::Rep {
   std::string compressed_output;
   std::unique_ptr<FlushBlockPolicy> flush_block_policy;
 
+  // Dictionary used to compress data blocks, null until it is trained.
+  std::unique_ptr<CompressionDict> compression_dict;
+  // Contents of the first data blocks, collected to train compression_dict.
+  std::string compression_dict_samples;
+  std::vector<size_t> compression_dict_sample_sizes;
+  // Size of compression_dict_samples to start training at, 0 when dictionary is not used.
+  size_t compression_dict_train_bytes = 0;
+
   std::vector<std::unique_ptr<IntTblPropCollector>> table_properties_collectors;
 
   yb::MemTrackerPtr mem_tracker;
@@ -319,8 +334,39 @@ struct BlockBasedTableBuilder::Rep {
       const bool skip_filters);
 
   bool is_split_sst() const { return data_writer != metadata_writer; }
+
+  // Adds the data block to the dictionary training samples, and trains the dictionary when enough
+  // samples are collected.
+  void SampleForCompressionDict(const Slice& raw_block);
 };
 
+void BlockBasedTableBuilder::Rep::SampleForCompressionDict(const Slice& raw_block) {
+  if (compression_dict_train_bytes == 0) {
+    return;
+  }
+  const size_t sample_size = std::min(
+      raw_block.size(), compression_dict_train_bytes - compression_dict_samples.size());
+  compression_dict_samples.append(raw_block.cdata(), sample_size);
+  compression_dict_sample_sizes.push_back(sample_size);
+  if (compression_dict_samples.size() < compression_dict_train_bytes) {
+    return;
+  }
+  auto dict = ZSTD_TrainDictionary(
+      compression_dict_samples, compression_dict_sample_sizes, compression_opts.max_dict_bytes);
+  if (dict.empty()) {
+    RLOG(InfoLogLevel::WARN_LEVEL, ioptions.info_log,
+        "Failed to train compression dictionary from %" ROCKSDB_PRIszt " samples",
+        compression_dict_sample_sizes.size());
+  } else {
+    compression_dict = std::make_unique<CompressionDict>(
+        std::move(dict), ZSTD_Level(compression_opts));
+  }
+  // Train only once per file.
+  compression_dict_train_bytes = 0;
+  std::string().swap(compression_dict_samples);
+  std::vector<size_t>().swap(compression_dict_sample_sizes);
+}
+
 Status BlockBasedTableBuilder::BlockBasedTablePropertiesCollector::Finish(
     UserCollectedProperties* properties) {
   std::string val;
@@ -362,7 +408,8 @@ BlockBasedTableBuilder::Rep::Rep(
           _ioptions, table_options, filter_type)),
       data_block_builder(
           table_options.block_restart_interval,
-          table_options.data_block_key_value_encoding_format, table_options.use_delta_encoding),
+          table_options.data_block_key_value_encoding_format, table_options.use_delta_encoding,
+          table_options.data_block_hash_index_key_transformer),
       internal_prefix_transform(_ioptions.prefix_extractor),
       filter_key_transformer(table_opt.filter_policy ?
           table_opt.filter_policy->GetKeyTransformer() : nullptr),
@@ -385,6 +432,10 @@ BlockBasedTableBuilder::Rep::Rep(
     mem_tracker = yb::MemTracker::FindOrCreateTracker(
         "BlockBasedTableBuilder", _ioptions.mem_tracker);
   }
+  if (table_options.store_data_block_boundaries && _ioptions.boundary_extractor) {
+    data_block_boundaries_builder = std::make_unique<DataBlockBoundariesBuilder>(
+        _ioptions.boundary_extractor);
+  }
 
   metadata_writer = std::make_shared<FileWriterWithOffsetAndCachePrefix>();
   metadata_writer->writer = metadata_file;
@@ -401,6 +452,11 @@ BlockBasedTableBuilder::Rep::Rep(
   table_properties_collectors.emplace_back(new BlockBasedTablePropertiesCollector(
       this, table_options.index_type, table_options.whole_key_filtering,
       _ioptions.prefix_extractor != nullptr, table_options.data_block_key_value_encoding_format));
+  if (compression_type == kZSTDNotFinalCompression && compression_opts.max_dict_bytes > 0 &&
+      ZSTD_Supported()) {
+    compression_dict_train_bytes = compression_opts.zstd_max_train_bytes > 0
+        ? compression_opts.zstd_max_train_bytes : 100 * compression_opts.max_dict_bytes;
+  }
 }
 
 BlockBasedTableBuilder::BlockBasedTableBuilder(
@@ -481,6 +537,11 @@ void BlockBasedTableBuilder::Add(const Slice& key, const Slice& value) {
     }
   }
 
+  if (r->data_block_boundaries_builder) {
+    r->status = r->data_block_boundaries_builder->Add(key, value);
+    if (!ok()) return;
+  }
+
   r->last_key.assign(key.cdata(), key.size());
   r->data_block_builder.Add(key, value);
   r->props.num_entries++;
@@ -501,11 +562,18 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   size_t data_block_size = 0;
 
   if (!r->data_block_builder.empty()) {
-    data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
-        r->data_writer.get());
+    const Slice raw_block = r->data_block_builder.Finish();
+    r->SampleForCompressionDict(raw_block);
+    data_block_size = WriteBlock(raw_block, &r->data_pending_handle, r->data_writer.get(),
+        r->compression_dict.get());
+    r->data_block_builder.Reset();
   }
   if (!ok()) return;
 
+  if (r->data_block_boundaries_builder) {
+    r->data_block_boundaries_builder->FinishDataBlock(r->data_pending_handle.offset());
+  }
+
   if (!r->table_options.skip_table_builder_flush) {
     r->status = r->data_writer->writer->Flush();
   }
@@ -583,7 +651,8 @@ size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
 
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
     BlockHandle* handle,
-    FileWriterWithOffsetAndCachePrefix* writer_info) {
+    FileWriterWithOffsetAndCachePrefix* writer_info,
+    const CompressionDict* compression_dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -596,7 +665,8 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   if (raw_block_contents.size() < kCompressionSizeLimit) {
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, &r->compressed_output,
+                      compression_dict);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -743,6 +813,21 @@ Status BlockBasedTableBuilder::Finish() {
     meta_index_builder.Add(item.first, block_handle);
   }
 
+  if (ok() && r->compression_dict) {
+    BlockHandle compression_dict_handle;
+    WriteRawBlock(r->compression_dict->raw(), kNoCompression, &compression_dict_handle,
+        r->metadata_writer.get());
+    meta_index_builder.Add(block_based_table::kCompressionDictBlock, compression_dict_handle);
+  }
+
+  if (ok() && r->data_block_boundaries_builder) {
+    BlockHandle data_block_boundaries_handle;
+    WriteBlock(r->data_block_boundaries_builder->Finish(), &data_block_boundaries_handle,
+        r->metadata_writer.get());
+    meta_index_builder.Add(
+        block_based_table::kDataBlockBoundariesBlock, data_block_boundaries_handle);
+  }
+
   if (ok()) {
     if (r->filter_block_builder != nullptr) {
       // Add mapping from "<filter_block_prefix>.Name" to location of either filter block or
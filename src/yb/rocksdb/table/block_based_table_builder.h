@@ -40,6 +40,7 @@ namespace rocksdb {
 
 class BlockBuilder;
 class BlockHandle;
+class CompressionDict;
 class WritableFile;
 struct BlockBasedTableOptions;
 
@@ -114,8 +115,10 @@ class BlockBasedTableBuilder : public TableBuilder {
   size_t WriteBlock(BlockBuilder* block, BlockHandle* handle,
                     FileWriterWithOffsetAndCachePrefix* writer_info);
   // Directly write block content to the file. Returns number of bytes written to file.
+  // compression_dict is the dictionary to compress the block with, if any.
   size_t WriteBlock(const Slice& block_contents, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffsetAndCachePrefix* writer_info,
+      const CompressionDict* compression_dict = nullptr);
   size_t WriteRawBlock(const Slice& data, CompressionType, BlockHandle* handle,
       FileWriterWithOffsetAndCachePrefix* writer_info);
   Status InsertBlockInCache(const Slice& block_contents,
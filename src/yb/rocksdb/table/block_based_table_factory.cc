@@ -47,6 +47,7 @@ BlockBasedTableFactory::BlockBasedTableFactory(
   }
   if (table_options_.no_block_cache) {
     table_options_.block_cache.reset();
+    table_options_.index_and_filter_block_cache.reset();
   } else if (table_options_.block_cache == nullptr) {
     table_options_.block_cache = NewLRUCache(8 << 20);
   }
@@ -166,6 +167,21 @@ std::string BlockBasedTableFactory::GetPrintableTableOptions() const {
              table_options_.block_cache_compressed->GetCapacity());
     ret.append(buffer);
   }
+  snprintf(buffer, kBufferSize, "  index_and_filter_block_cache: %p\n",
+           table_options_.index_and_filter_block_cache.get());
+  ret.append(buffer);
+  if (table_options_.index_and_filter_block_cache) {
+    snprintf(buffer, kBufferSize,
+             "  index_and_filter_block_cache_size: %" ROCKSDB_PRIszt "\n",
+             table_options_.index_and_filter_block_cache->GetCapacity());
+    ret.append(buffer);
+  }
+  snprintf(buffer, kBufferSize, "  persistent_cache: %p\n",
+           table_options_.persistent_cache.get());
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  pin_top_level_index: %d\n",
+           table_options_.pin_top_level_index);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  block_size: %" ROCKSDB_PRIszt "\n",
            table_options_.block_size);
   ret.append(buffer);
@@ -26,6 +26,8 @@
 #include <string>
 #include <utility>
 
+#include <gflags/gflags.h>
+
 #include "yb/gutil/macros.h"
 
 #include "yb/rocksdb/cache.h"
@@ -43,6 +45,7 @@
 #include "yb/rocksdb/table/block_based_table_internal.h"
 #include "yb/rocksdb/table/block_hash_index.h"
 #include "yb/rocksdb/table/block_prefix_index.h"
+#include "yb/rocksdb/table/data_block_boundaries.h"
 #include "yb/rocksdb/table/filter_block.h"
 #include "yb/rocksdb/table/fixed_size_filter_block.h"
 #include "yb/rocksdb/table/format.h"
@@ -55,6 +58,7 @@
 #include "yb/rocksdb/table/two_level_iterator.h"
 #include "yb/rocksdb/table_properties.h"
 #include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/statistics.h"
@@ -64,10 +68,24 @@
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/stats/perf_step_timer.h"
 #include "yb/util/status_format.h"
 #include "yb/util/string_util.h"
 
+using namespace yb::size_literals;
+
+DEFINE_int32(rocksdb_scan_readahead_min_sequential_blocks, 2,
+             "Number of data blocks a table iterator has to read sequentially before it starts "
+             "readahead of the following data blocks. Non-positive value disables readahead.");
+DEFINE_int64(rocksdb_scan_readahead_max_size_bytes, 256_KB,
+             "Max size of readahead issued by a table iterator during sequential scan. Readahead "
+             "size starts from 8KB and doubles on each readahead until reaching this value.");
+DEFINE_int64(rocksdb_scan_bypass_block_cache_after_bytes, 0,
+             "If positive, a table iterator stops adding data blocks to the block cache after "
+             "sequentially reading this number of bytes of data blocks, so large scans do not "
+             "evict the working set from the block cache.");
+
 namespace rocksdb {
 
 extern const uint64_t kBlockBasedTableMagicNumber;
@@ -149,6 +167,11 @@ struct BlockBasedTable::FileReaderWithCachePrefix {
   // Similar prefix, but for compressed blocks cache:
   block_based_table::CacheKeyPrefixBuffer compressed_cache_key_prefix;
 
+  // Prefix for the persistent cache, it is generated from the file unique id only, since keys
+  // should be stable across process restarts.
+  block_based_table::CacheKeyPrefixBuffer persistent_cache_key_prefix;
+  PersistentCacheOptions persistent_cache_options;
+
   explicit FileReaderWithCachePrefix(unique_ptr<RandomAccessFileReader>&& _reader) :
       reader(std::move(_reader)) {}
 };
@@ -220,6 +243,13 @@ struct BlockBasedTable::Rep {
   unique_ptr<BlockEntryIteratorState> data_index_iterator_state;
   unique_ptr<IndexReader> filter_index_reader;
   unique_ptr<FilterBlockReader> filter;
+  // Boundary values of data blocks, present if the file was written with
+  // BlockBasedTableOptions::store_data_block_boundaries.
+  unique_ptr<DataBlockBoundariesReader> data_block_boundaries;
+  // Dictionary used to compress data blocks, see CompressionOptions::max_dict_bytes.
+  BlockContents compression_dict_block;
+  // Digested compression_dict_block, shared by all reads of this file.
+  unique_ptr<UncompressionDict> uncompression_dict;
 
   FilterType filter_type;
 
@@ -244,9 +274,16 @@ struct BlockBasedTable::Rep {
   yb::MemTrackerPtr mem_tracker;
 };
 
-// BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
-// to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
-// functions in order to check if prefix may match or to create a secondary iterator.
+namespace {
+
+constexpr size_t kInitialScanReadaheadSize = 8_KB;
+
+} // namespace
+
+// BlockEntryIteratorState is used as an adapter to BlockBasedTable. It is used by TwoLevelIterator
+// and MultiLevelIterator to call BlockBasedTable functions in order to check if prefix may match
+// or to create a secondary iterator. For data blocks it also tracks sequential reads of the
+// iterator in order to issue readahead of the following data blocks.
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -255,10 +292,18 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
       : TwoLevelIteratorState(table->rep_->ioptions.prefix_extractor != nullptr),
         table_(table),
         read_options_(read_options),
+        fill_cache_(read_options.fill_cache),
         skip_filters_(skip_filters),
         block_type_(block_type) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
+    if (block_type_ == BlockType::kData) {
+      if (read_options_.file_filter &&
+          !table_->DataBlockMayMatch(*read_options_.file_filter, index_value)) {
+        return NewEmptyInternalIterator();
+      }
+      TrackDataBlockRead(index_value);
+    }
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
   }
 
@@ -270,13 +315,69 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   }
 
  private:
+  // Detects sequential iteration over data blocks. Once the iterator has read enough blocks one
+  // after another, asks the data file to load the range following the current block in background,
+  // doubling the readahead size each time, and optionally stops filling the block cache.
+  void TrackDataBlockRead(const Slice& index_value) {
+    const auto min_sequential_blocks = FLAGS_rocksdb_scan_readahead_min_sequential_blocks;
+    const auto bypass_block_cache_after_bytes = FLAGS_rocksdb_scan_bypass_block_cache_after_bytes;
+    if (min_sequential_blocks <= 0 && bypass_block_cache_after_bytes <= 0) {
+      return;
+    }
+
+    BlockHandle handle;
+    Slice input = index_value;
+    if (!handle.DecodeFrom(&input).ok()) {
+      // Error will be reported by NewDataBlockIterator.
+      return;
+    }
+    const uint64_t block_end = handle.offset() + handle.size() + kBlockTrailerSize;
+    if (handle.offset() != next_block_offset_) {
+      num_sequential_blocks_ = 0;
+      sequential_bytes_ = 0;
+      readahead_size_ = kInitialScanReadaheadSize;
+      readahead_limit_ = 0;
+      read_options_.fill_cache = fill_cache_;
+    }
+    next_block_offset_ = block_end;
+    ++num_sequential_blocks_;
+    sequential_bytes_ += block_end - handle.offset();
+
+    if (bypass_block_cache_after_bytes > 0 &&
+        sequential_bytes_ > static_cast<uint64_t>(bypass_block_cache_after_bytes)) {
+      read_options_.fill_cache = false;
+    }
+
+    if (min_sequential_blocks <= 0 ||
+        num_sequential_blocks_ < static_cast<size_t>(min_sequential_blocks) ||
+        block_end + readahead_size_ / 2 <= readahead_limit_) {
+      return;
+    }
+    const uint64_t readahead_start = std::max(block_end, readahead_limit_);
+    readahead_limit_ = block_end + readahead_size_;
+    table_->GetBlockReader(block_type_)->reader->file()->Readahead(
+        readahead_start, readahead_limit_ - readahead_start);
+    readahead_size_ = std::max<size_t>(
+        std::min<size_t>(readahead_size_ * 2, FLAGS_rocksdb_scan_readahead_max_size_bytes),
+        readahead_size_);
+  }
+
   // Don't own table_. BlockEntryIteratorState should only be stored in iterators or in
   // corresponding BlockBasedTable. TableReader (superclass of BlockBasedTable) is only destroyed
   // after iterator is deleted.
   BlockBasedTable* const table_;
-  const ReadOptions read_options_;
+  // Not const, since fill_cache is turned off when the iterator bypasses the block cache.
+  ReadOptions read_options_;
+  const bool fill_cache_;
   const bool skip_filters_;
   const BlockType block_type_;
+
+  // The following fields are only used for data blocks, whose state is owned by a single iterator.
+  uint64_t next_block_offset_ = 0;
+  size_t num_sequential_blocks_ = 0;
+  uint64_t sequential_bytes_ = 0;
+  size_t readahead_size_ = kInitialScanReadaheadSize;
+  uint64_t readahead_limit_ = 0;
 };
 
 
@@ -312,6 +413,20 @@ void BlockBasedTable::SetupCacheKeyPrefix(Rep* rep,
         reader_with_cache_prefix->reader->file(),
         &reader_with_cache_prefix->compressed_cache_key_prefix);
   }
+  auto& persistent_prefix = reader_with_cache_prefix->persistent_cache_key_prefix;
+  persistent_prefix.size = 0;
+  if (rep->table_options.persistent_cache != nullptr) {
+    persistent_prefix.size =
+        reader_with_cache_prefix->reader->file()->GetUniqueId(persistent_prefix.data);
+  }
+  auto& persistent_options = reader_with_cache_prefix->persistent_cache_options;
+  if (persistent_prefix.size != 0) {
+    persistent_options.cache = rep->table_options.persistent_cache.get();
+    persistent_options.key_prefix = Slice(persistent_prefix.data, persistent_prefix.size);
+    persistent_options.statistics = rep->ioptions.statistics;
+  } else {
+    persistent_options = PersistentCacheOptions();
+  }
 }
 
 KeyValueEncodingFormat BlockBasedTable::GetKeyValueEncodingFormat(const BlockType block_type) {
@@ -324,6 +439,24 @@ KeyValueEncodingFormat BlockBasedTable::GetKeyValueEncodingFormat(const BlockTyp
   FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
 }
 
+Cache* BlockBasedTable::IndexAndFilterBlockCache() const {
+  const auto& table_options = rep_->table_options;
+  if (table_options.block_cache && table_options.index_and_filter_block_cache) {
+    return table_options.index_and_filter_block_cache.get();
+  }
+  return table_options.block_cache.get();
+}
+
+Cache* BlockBasedTable::GetBlockCache(BlockType block_type) const {
+  switch (block_type) {
+    case BlockType::kData:
+      return rep_->table_options.block_cache.get();
+    case BlockType::kIndex:
+      return IndexAndFilterBlockCache();
+  }
+  FATAL_INVALID_ENUM_VALUE(BlockType, block_type);
+}
+
 BlockBasedTable::FileReaderWithCachePrefix* BlockBasedTable::GetBlockReader(BlockType block_type) {
   switch (block_type) {
     case BlockType::kData:
@@ -354,7 +487,7 @@ bool BloomFilterAwareFileFilter::Filter(TableReader* reader) const {
       // Record that the bloom filter was useful.
       RecordTick(table->rep_->ioptions.statistics, BLOOM_FILTER_USEFUL);
     }
-    filter_entry.Release(table->rep_->table_options.block_cache.get());
+    filter_entry.Release(table->IndexAndFilterBlockCache());
     return use_file;
   } else {
     // For non fixed-size filters - take file into account. We are only using fixed-size bloom
@@ -427,9 +560,13 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   RETURN_NOT_OK(new_table->SetupFilter(meta_iter.get()));
 
+  RETURN_NOT_OK(new_table->ReadDataBlockBoundaries(meta_iter.get()));
+
+  RETURN_NOT_OK(new_table->ReadCompressionDict(meta_iter.get()));
+
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
     // Will use block cache for data index access?
-    if (table_options.cache_index_and_filter_blocks) {
+    if (table_options.cache_index_and_filter_blocks && !table_options.pin_top_level_index) {
       DCHECK_ONLY_NOTNULL(table_options.block_cache.get());
       // Hack: Call NewIndexIterator() to implicitly add index to the
       // block_cache
@@ -464,7 +601,7 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
         case FilterType::kBlockBasedFilter: {
           // Hack: Call GetFilter() to implicitly add filter to the block_cache
           auto filter_entry = new_table->GetFilter(kDefaultQueryId);
-          filter_entry.Release(table_options.block_cache.get());
+          filter_entry.Release(new_table->IndexAndFilterBlockCache());
           corrupted_filter_type = false;
           break;
         }
@@ -640,6 +777,61 @@ Status BlockBasedTable::SetupFilter(InternalIterator* meta_iter) {
   return Status::OK();
 }
 
+Status BlockBasedTable::ReadDataBlockBoundaries(InternalIterator* meta_iter) {
+  BlockHandle handle;
+  if (!FindMetaBlock(meta_iter, block_based_table::kDataBlockBoundariesBlock, &handle).ok()) {
+    return Status::OK();
+  }
+  BlockContents contents;
+  RETURN_NOT_OK(ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      handle, &contents, rep_->ioptions.env, rep_->mem_tracker, true /* do_uncompress */));
+  auto reader = std::make_unique<DataBlockBoundariesReader>();
+  RETURN_NOT_OK(reader->Init(std::move(contents)));
+  rep_->data_block_boundaries = std::move(reader);
+  return Status::OK();
+}
+
+Status BlockBasedTable::ReadCompressionDict(InternalIterator* meta_iter) {
+  BlockHandle handle;
+  if (!FindMetaBlock(meta_iter, block_based_table::kCompressionDictBlock, &handle).ok()) {
+    return Status::OK();
+  }
+  // The dictionary is written uncompressed.
+  RETURN_NOT_OK(ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      handle, &rep_->compression_dict_block, rep_->ioptions.env, rep_->mem_tracker,
+      false /* do_uncompress */));
+  rep_->uncompression_dict = std::make_unique<UncompressionDict>(
+      rep_->compression_dict_block.data);
+  return Status::OK();
+}
+
+const UncompressionDict* BlockBasedTable::CompressionDict() const {
+  return rep_->uncompression_dict.get();
+}
+
+bool BlockBasedTable::DataBlockMayMatch(const ReadFileFilter& filter, const Slice& index_value) {
+  if (!rep_->data_block_boundaries) {
+    return true;
+  }
+  BlockHandle handle;
+  Slice input = index_value;
+  if (!handle.DecodeFrom(&input).ok()) {
+    // Let NewDataBlockIterator report the error.
+    return true;
+  }
+  DataBlockBoundaries boundaries;
+  if (!rep_->data_block_boundaries->Find(handle.offset(), &boundaries)) {
+    return true;
+  }
+  if (filter.FilterDataBlock(boundaries)) {
+    return true;
+  }
+  RecordTick(rep_->ioptions.statistics, DATA_BLOCK_BOUNDARIES_FILTER_USEFUL);
+  return false;
+}
+
 void BlockBasedTable::SetDataFileReader(unique_ptr<RandomAccessFileReader> &&data_file) {
   rep_->data_reader_with_cache_prefix =
       std::make_shared<FileReaderWithCachePrefix>(std::move(data_file));
@@ -690,6 +882,9 @@ size_t BlockBasedTable::ApproximateMemoryUsage() const {
   if (rep_->filter_index_reader) {
     usage += rep_->filter_index_reader->ApproximateMemoryUsage();
   }
+  if (rep_->data_block_boundaries) {
+    usage += rep_->data_block_boundaries->ApproximateMemoryUsage();
+  }
   IndexReader* data_index_reader = rep_->data_index_reader.get(std::memory_order_relaxed);
   if (data_index_reader) {
     usage += data_index_reader->ApproximateMemoryUsage();
@@ -758,7 +953,8 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const UncompressionDict* compression_dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -802,7 +998,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, compression_dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -830,7 +1026,8 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    const UncompressionDict* compression_dict) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -839,7 +1036,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, compression_dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -993,7 +1190,7 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
 
   PERF_TIMER_GUARD(read_filter_block_nanos);
 
-  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache = IndexAndFilterBlockCache();
   if (rep_->filter_policy == nullptr /* do not use filter */ ||
       block_cache == nullptr /* no block cache at all */) {
     // If we get here, we have:
@@ -1089,10 +1286,11 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
   PERF_TIMER_GUARD(read_index_block_nanos);
 
   const bool no_io = read_options.read_tier == kBlockCacheTier;
-  Cache* const block_cache = rep_->table_options.block_cache.get();
+  Cache* const block_cache = IndexAndFilterBlockCache();
 
   if (block_cache && (rep_->data_index_load_mode == DataIndexLoadMode::USE_CACHE ||
-      rep_->table_options.cache_index_and_filter_blocks)) {
+      (rep_->table_options.cache_index_and_filter_blocks &&
+       !rep_->table_options.pin_top_level_index))) {
     char cache_key[block_based_table::kCacheKeyBufferSize];
     auto key = GetCacheKey(rep_->base_reader_with_cache_prefix->cache_key_prefix,
         rep_->footer.index_handle(), cache_key);
@@ -1154,7 +1352,7 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
   if (index_reader_result->cache_handle) {
     auto iter = new_iter ? new_iter : input_iter;
     iter->RegisterCleanup(
-        &ReleaseCachedEntry, rep_->table_options.block_cache.get(),
+        &ReleaseCachedEntry, IndexAndFilterBlockCache(),
         index_reader_result->cache_handle);
   }
 
@@ -1170,7 +1368,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   PERF_TIMER_GUARD(new_table_block_iter_nanos);
 
   const bool no_io = (ro.read_tier == kBlockCacheTier);
-  Cache* block_cache = rep_->table_options.block_cache.get();
+  Cache* block_cache = GetBlockCache(block_type);
   Cache* block_cache_compressed =
       rep_->table_options.block_cache_compressed.get();
   CachableEntry<Block> block;
@@ -1211,7 +1409,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, rep_->mem_tracker, CompressionDict());
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
@@ -1219,13 +1417,15 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            rep_->mem_tracker, block_cache_compressed == nullptr,
+            &reader->persistent_cache_options, CompressionDict());
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, rep_->mem_tracker,
+                                CompressionDict());
       }
     }
   }
@@ -1244,7 +1444,8 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        rep_->mem_tracker, true /* do_uncompress */, &reader->persistent_cache_options,
+        CompressionDict());
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1253,7 +1454,10 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   InternalIterator* iter;
   if (s.ok() && block.value != nullptr) {
     iter = block.value->NewIterator(
-        rep_->comparator.get(), GetKeyValueEncodingFormat(block_type), input_iter);
+        rep_->comparator.get(), GetKeyValueEncodingFormat(block_type), input_iter,
+        /* total_order_seek = */ true,
+        block_type == BlockType::kData ? rep_->table_options.data_block_hash_index_key_transformer
+                                       : nullptr);
     if (block.cache_handle != nullptr) {
       iter->RegisterCleanup(&ReleaseCachedEntry, block_cache,
           block.cache_handle);
@@ -1365,7 +1569,7 @@ bool BlockBasedTable::PrefixMayMatch(const Slice& internal_key) {
     RecordTick(statistics, BLOOM_FILTER_PREFIX_USEFUL);
   }
 
-  filter_entry.Release(rep_->table_options.block_cache.get());
+  filter_entry.Release(IndexAndFilterBlockCache());
   return may_match;
 }
 
@@ -1487,7 +1691,7 @@ Status BlockBasedTable::Get(const ReadOptions& read_options, const Slice& intern
     }
   }
 
-  filter_entry.Release(rep_->table_options.block_cache.get());
+  filter_entry.Release(IndexAndFilterBlockCache());
   return s;
 }
 
@@ -1554,7 +1758,7 @@ bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
   Slice ckey;
 
   s = GetDataBlockFromCache(cache_key, ckey, block_cache, nullptr, nullptr, options, &block,
-      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker);
+      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker, CompressionDict());
   assert(s.ok());
   bool in_cache = block.value != nullptr;
   if (in_cache) {
@@ -1917,7 +2121,7 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
 
   // TODO: remove this trick after https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
   auto se = yb::ScopeExit([this, &index_reader] {
-    index_reader.Release(rep_->table_options.block_cache.get());
+    index_reader.Release(IndexAndFilterBlockCache());
   });
 
   const auto index_middle_key = VERIFY_RESULT(index_reader.value->GetMiddleKey());
@@ -52,6 +52,7 @@ class InternalKeyComparator;
 class Iterator;
 class TableCache;
 class TableReader;
+class UncompressionDict;
 class WritableFile;
 struct BlockBasedTableOptions;
 struct EnvOptions;
@@ -251,7 +252,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* compression_dict);
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -266,7 +268,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      const UncompressionDict* compression_dict);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -291,6 +294,17 @@ class BlockBasedTable : public TableReader {
 
   CHECKED_STATUS SetupFilter(InternalIterator* meta_iter);
 
+  // Loads boundary values of data blocks, if they were stored in the file.
+  CHECKED_STATUS ReadDataBlockBoundaries(InternalIterator* meta_iter);
+
+  CHECKED_STATUS ReadCompressionDict(InternalIterator* meta_iter);
+
+  // Returns the dictionary used to compress data blocks, nullptr if there is no dictionary.
+  const UncompressionDict* CompressionDict() const;
+
+  // Returns false if the filter rejects the data block referenced by the index value.
+  bool DataBlockMayMatch(const ReadFileFilter& filter, const Slice& index_value);
+
   // Read the meta block from sst.
   static CHECKED_STATUS ReadMetaBlock(
       Rep* rep, std::unique_ptr<Block>* meta_block, std::unique_ptr<InternalIterator>* iter);
@@ -307,6 +321,12 @@ class BlockBasedTable : public TableReader {
   static void SetupCacheKeyPrefix(Rep* rep, FileReaderWithCachePrefix* reader_with_cache_prefix);
 
   FileReaderWithCachePrefix* GetBlockReader(BlockType block_type);
+
+  // Returns the cache used for the top level data index and filter blocks.
+  Cache* IndexAndFilterBlockCache() const;
+
+  // Returns the cache used for blocks of the specified type.
+  Cache* GetBlockCache(BlockType block_type) const;
   KeyValueEncodingFormat GetKeyValueEncodingFormat(BlockType block_type);
 
   explicit BlockBasedTable(Rep* rep) : rep_(rep) {}
@@ -44,6 +44,8 @@
 //     restarts: uint32[num_restarts]
 //     num_restarts: uint32
 // restarts[i] contains the offset within the block of the ith restart point.
+// Data blocks could also contain hash index between restarts and num_restarts, see
+// data_block_hash_index.h.
 
 #include "yb/rocksdb/table/block_builder.h"
 
@@ -54,6 +56,7 @@
 #include "yb/rocksdb/comparator.h"
 #include "yb/rocksdb/db/dbformat.h"
 #include "yb/rocksdb/table/block_builder_internal.h"
+#include "yb/rocksdb/table/data_block_hash_index.h"
 #include "yb/rocksdb/util/coding.h"
 
 #include "yb/util/string_util.h"
@@ -62,7 +65,8 @@ namespace rocksdb {
 
 BlockBuilder::BlockBuilder(
     int block_restart_interval, const KeyValueEncodingFormat key_value_encoding_format,
-    const bool use_delta_encoding)
+    const bool use_delta_encoding,
+    const FilterPolicy::KeyTransformer* hash_index_key_transformer)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
       key_value_encoding_format_(key_value_encoding_format),
@@ -71,8 +75,13 @@ BlockBuilder::BlockBuilder(
       finished_(false) {
   assert(block_restart_interval_ >= 1);
   restarts_.push_back(0);       // First restart point is at offset 0
+  if (hash_index_key_transformer) {
+    hash_index_builder_ = std::make_unique<DataBlockHashIndexBuilder>(hash_index_key_transformer);
+  }
 }
 
+BlockBuilder::~BlockBuilder() = default;
+
 void BlockBuilder::Reset() {
   buffer_.clear();
   restarts_.clear();
@@ -80,6 +89,9 @@ void BlockBuilder::Reset() {
   counter_ = 0;
   finished_ = false;
   last_key_.clear();
+  if (hash_index_builder_) {
+    hash_index_builder_->Reset();
+  }
 }
 
 size_t BlockBuilder::CurrentSizeEstimate() const {
@@ -88,6 +100,9 @@ size_t BlockBuilder::CurrentSizeEstimate() const {
     // Restarts haven't been flushed to buffer yet.
     size += restarts_.size() * sizeof(uint32_t) +    // Restart array.
             sizeof(uint32_t);                        // Restart array length.
+    if (hash_index_builder_) {
+      size += hash_index_builder_->EstimateSize();
+    }
   }
   return size;
 }
@@ -335,7 +350,12 @@ Slice BlockBuilder::Finish() {
   for (size_t i = 0; i < restarts_.size(); i++) {
     PutFixed32(&buffer_, restarts_[i]);
   }
-  PutFixed32(&buffer_, static_cast<uint32_t>(restarts_.size()));
+  auto num_restarts = static_cast<uint32_t>(restarts_.size());
+  if (hash_index_builder_ && hash_index_builder_->Valid()) {
+    hash_index_builder_->Finish(&buffer_);
+    num_restarts |= kDataBlockHashIndexFlag;
+  }
+  PutFixed32(&buffer_, num_restarts);
   finished_ = true;
   return Slice(buffer_);
 }
@@ -374,6 +394,10 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
     }
   }
 
+  if (hash_index_builder_) {
+    hash_index_builder_->Add(key, restarts_.size() - 1);
+  }
+
   DVLOG_WITH_FUNC(4) << "key: " << Slice(key).ToDebugHexString() << " size: " << key.size()
                     << " offset: " << buffer_.size() << " counter: " << counter_;
 
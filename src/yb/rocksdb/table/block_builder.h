@@ -25,22 +25,33 @@
 #define YB_ROCKSDB_TABLE_BLOCK_BUILDER_H
 
 #include <stdint.h>
+
+#include <memory>
 #include <vector>
 
+#include "yb/rocksdb/filter_policy.h"
 #include "yb/rocksdb/types.h"
 
 #include "yb/util/slice.h"
 
 namespace rocksdb {
 
+class DataBlockHashIndexBuilder;
+
 class BlockBuilder {
  public:
   BlockBuilder(const BlockBuilder&) = delete;
   void operator=(const BlockBuilder&) = delete;
 
+  // If hash_index_key_transformer is not null, the block is built with a hash index over key
+  // prefixes returned by it (see data_block_hash_index.h). Keys should be internal keys in this
+  // case.
   explicit BlockBuilder(int block_restart_interval,
                         KeyValueEncodingFormat key_value_encoding_format,
-                        bool use_delta_encoding = true);
+                        bool use_delta_encoding = true,
+                        const FilterPolicy::KeyTransformer* hash_index_key_transformer = nullptr);
+
+  ~BlockBuilder();
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -78,6 +89,7 @@ class BlockBuilder {
   int                   counter_;   // Number of entries emitted since restart
   bool                  finished_;  // Has Finish() been called?
   std::string           last_key_;
+  std::unique_ptr<DataBlockHashIndexBuilder> hash_index_builder_;
 };
 
 }  // namespace rocksdb
@@ -436,6 +436,160 @@ TEST_F(BlockTest, GetMiddleKey) {
   }
 }
 
+namespace {
+
+// Uses first kPrefixSize bytes of the user key as a prefix for data block hash index.
+class FixedPrefixKeyTransformer : public FilterPolicy::KeyTransformer {
+ public:
+  static constexpr size_t kPrefixSize = 6;
+
+  Slice Transform(Slice user_key) const override {
+    return user_key.size() < kPrefixSize ? Slice() : Slice(user_key.data(), kPrefixSize);
+  }
+};
+
+class CountingComparator : public Comparator {
+ public:
+  explicit CountingComparator(const Comparator* comparator) : comparator_(comparator) {}
+
+  int Compare(const Slice& a, const Slice& b) const override {
+    ++num_compares_;
+    return comparator_->Compare(a, b);
+  }
+
+  const char* Name() const override { return comparator_->Name(); }
+
+  void FindShortestSeparator(std::string* start, const Slice& limit) const override {
+    comparator_->FindShortestSeparator(start, limit);
+  }
+
+  void FindShortSuccessor(std::string* key) const override {
+    comparator_->FindShortSuccessor(key);
+  }
+
+  size_t num_compares() const { return num_compares_; }
+
+ private:
+  const Comparator* comparator_;
+  mutable size_t num_compares_ = 0;
+};
+
+std::string DataBlockUserKey(int prefix, int suffix) {
+  return StringPrintf("%06d%04d", prefix, suffix);
+}
+
+} // namespace
+
+TEST_F(BlockTest, DataBlockHashIndex) {
+  constexpr int kNumPrefixes = 200;
+  constexpr int kKeysPerPrefix = 3;
+  constexpr int kBlockRestartInterval = 4;
+  FixedPrefixKeyTransformer key_transformer;
+  InternalKeyComparator internal_comparator(BytewiseComparator());
+
+  for (auto key_value_encoding_format : kKeyValueEncodingFormatList) {
+    BlockBuilder plain_builder(kBlockRestartInterval, key_value_encoding_format);
+    BlockBuilder hash_builder(
+        kBlockRestartInterval, key_value_encoding_format, /* use_delta_encoding = */ true,
+        &key_transformer);
+    std::vector<std::string> keys;
+    // Only even prefixes are stored, so odd ones could be used to seek to absent prefixes.
+    for (int prefix = 0; prefix < 2 * kNumPrefixes; prefix += 2) {
+      for (int suffix = 0; suffix < kKeysPerPrefix; ++suffix) {
+        keys.push_back(InternalKey(DataBlockUserKey(prefix, suffix), 1, kTypeValue).Encode()
+                           .ToString());
+        plain_builder.Add(keys.back(), "v" + keys.back());
+        hash_builder.Add(keys.back(), "v" + keys.back());
+      }
+    }
+
+    BlockContents plain_contents;
+    plain_contents.data = plain_builder.Finish();
+    plain_contents.cachable = false;
+    Block plain_block(std::move(plain_contents));
+    BlockContents hash_contents;
+    hash_contents.data = hash_builder.Finish();
+    hash_contents.cachable = false;
+    Block hash_block(std::move(hash_contents));
+    ASSERT_EQ(plain_block.NumRestarts(), hash_block.NumRestarts());
+    ASSERT_GT(hash_block.size(), plain_block.size());
+
+    CountingComparator plain_comparator(&internal_comparator);
+    CountingComparator hash_comparator(&internal_comparator);
+    std::unique_ptr<InternalIterator> plain_iter(
+        plain_block.NewIterator(&plain_comparator, key_value_encoding_format));
+    std::unique_ptr<InternalIterator> hash_iter(hash_block.NewIterator(
+        &hash_comparator, key_value_encoding_format, /* iter = */ nullptr,
+        /* total_order_seek = */ true, &key_transformer));
+
+    std::vector<std::string> targets = keys;
+    for (int prefix = 0; prefix <= 2 * kNumPrefixes; ++prefix) {
+      targets.push_back(InternalKey(
+          DataBlockUserKey(prefix, 1).substr(0, FixedPrefixKeyTransformer::kPrefixSize),
+          kMaxSequenceNumber, kValueTypeForSeek).Encode().ToString());
+      targets.push_back(InternalKey(
+          DataBlockUserKey(prefix, kKeysPerPrefix), kMaxSequenceNumber, kValueTypeForSeek)
+              .Encode().ToString());
+    }
+
+    for (const auto& target : targets) {
+      plain_iter->Seek(target);
+      hash_iter->Seek(target);
+      ASSERT_OK(hash_iter->status());
+      ASSERT_EQ(plain_iter->Valid(), hash_iter->Valid());
+      if (plain_iter->Valid()) {
+        ASSERT_EQ(plain_iter->key(), hash_iter->key());
+        ASSERT_EQ(plain_iter->value(), hash_iter->value());
+      }
+    }
+    ASSERT_LT(hash_comparator.num_compares(), plain_comparator.num_compares());
+
+    // Iterator created without key transformer ignores hash index.
+    std::unique_ptr<InternalIterator> iter(
+        hash_block.NewIterator(&internal_comparator, key_value_encoding_format));
+    size_t count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_EQ(iter->key(), keys[count]);
+      ++count;
+    }
+    ASSERT_EQ(count, keys.size());
+    iter->Seek(keys[keys.size() / 2]);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), keys[keys.size() / 2]);
+  }
+}
+
+TEST_F(BlockTest, DataBlockHashIndexTooManyRestarts) {
+  FixedPrefixKeyTransformer key_transformer;
+  InternalKeyComparator internal_comparator(BytewiseComparator());
+  const auto key_value_encoding_format = KeyValueEncodingFormat::kKeyDeltaEncodingSharedPrefix;
+  BlockBuilder plain_builder(1, key_value_encoding_format);
+  BlockBuilder hash_builder(
+      1, key_value_encoding_format, /* use_delta_encoding = */ true, &key_transformer);
+  std::vector<std::string> keys;
+  for (int prefix = 0; prefix < 300; ++prefix) {
+    keys.push_back(InternalKey(DataBlockUserKey(prefix, 0), 1, kTypeValue).Encode().ToString());
+    plain_builder.Add(keys.back(), "v");
+    hash_builder.Add(keys.back(), "v");
+  }
+  // Restart index does not fit into the bucket, so the block is written without hash index.
+  const auto raw_block = hash_builder.Finish();
+  ASSERT_EQ(plain_builder.Finish(), raw_block);
+
+  BlockContents contents;
+  contents.data = raw_block;
+  contents.cachable = false;
+  Block block(std::move(contents));
+  std::unique_ptr<InternalIterator> iter(block.NewIterator(
+      &internal_comparator, key_value_encoding_format, /* iter = */ nullptr,
+      /* total_order_seek = */ true, &key_transformer));
+  for (const auto& key : keys) {
+    iter->Seek(key);
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), key);
+  }
+}
+
 TEST_F(BlockTest, EncodeThreeSharedPartsSizes) {
   constexpr auto kNumIters = 100000;
 
@@ -0,0 +1,157 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/data_block_boundaries.h"
+
+#include <algorithm>
+
+#include <glog/logging.h>
+
+#include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/util/coding.h"
+
+#include "yb/util/status_format.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Updates values with the values extracted from a new key of the block. Values whose tag is not
+// present in the new key are removed, so remaining values cover every key of the block.
+void UpdateBlockValues(const UserBoundaryValues& key_values,
+                       UpdateUserValueType type,
+                       UserBoundaryValues* values) {
+  const int compare_sign = static_cast<int>(type);
+  size_t kept = 0;
+  for (size_t i = 0; i != values->size(); ++i) {
+    auto& value = (*values)[i];
+    auto key_value = UserValueWithTag(key_values, value->Tag());
+    if (!key_value) {
+      continue;
+    }
+    if (value->CompareTo(*key_value) * compare_sign > 0) {
+      value = std::move(key_value);
+    }
+    if (kept != i) {
+      (*values)[kept] = std::move(value);
+    }
+    ++kept;
+  }
+  values->erase(values->begin() + kept, values->end());
+}
+
+} // namespace
+
+DataBlockBoundariesBuilder::DataBlockBoundariesBuilder(BoundaryValuesExtractor* extractor)
+    : extractor_(extractor) {
+  DCHECK_ONLY_NOTNULL(extractor_);
+}
+
+Status DataBlockBoundariesBuilder::Add(const Slice& internal_key, const Slice& value) {
+  key_values_.clear();
+  RETURN_NOT_OK(extractor_->Extract(ExtractUserKey(internal_key), value, &key_values_));
+  if (block_empty_) {
+    smallest_.assign(key_values_.begin(), key_values_.end());
+    largest_.assign(key_values_.begin(), key_values_.end());
+    block_empty_ = false;
+    return Status::OK();
+  }
+  UpdateBlockValues(key_values_, UpdateUserValueType::kSmallest, &smallest_);
+  UpdateBlockValues(key_values_, UpdateUserValueType::kLargest, &largest_);
+  return Status::OK();
+}
+
+void DataBlockBoundariesBuilder::FinishDataBlock(uint64_t block_offset) {
+  if (block_empty_) {
+    return;
+  }
+  DCHECK_EQ(smallest_.size(), largest_.size());
+  if (!smallest_.empty()) {
+    PutVarint64(&buffer_, block_offset);
+    PutVarint32(&buffer_, static_cast<uint32_t>(smallest_.size()));
+    for (size_t i = 0; i != smallest_.size(); ++i) {
+      DCHECK_EQ(smallest_[i]->Tag(), largest_[i]->Tag());
+      PutVarint32(&buffer_, smallest_[i]->Tag());
+      PutLengthPrefixedSlice(&buffer_, smallest_[i]->Encode());
+      PutLengthPrefixedSlice(&buffer_, largest_[i]->Encode());
+    }
+  }
+  smallest_.clear();
+  largest_.clear();
+  block_empty_ = true;
+}
+
+Status DataBlockBoundariesReader::Init(BlockContents contents) {
+  contents_ = std::move(contents);
+  blocks_.clear();
+  smallest_values_.clear();
+  largest_values_.clear();
+  Slice input = contents_.data;
+  while (!input.empty()) {
+    uint64_t block_offset;
+    uint32_t num_values;
+    if (!GetVarint64(&input, &block_offset) || !GetVarint32(&input, &num_values)) {
+      return STATUS(Corruption, "Bad data block boundaries header");
+    }
+    if (!blocks_.empty() && blocks_.back().offset >= block_offset) {
+      return STATUS_FORMAT(
+          Corruption, "Data block boundaries are not ordered: $0 after $1",
+          block_offset, blocks_.back().offset);
+    }
+    blocks_.push_back(BlockEntry {
+      .offset = block_offset,
+      .first_value = smallest_values_.size(),
+      .num_values = num_values,
+    });
+    for (uint32_t i = 0; i != num_values; ++i) {
+      uint32_t tag;
+      Slice smallest, largest;
+      if (!GetVarint32(&input, &tag) || !GetLengthPrefixedSlice(&input, &smallest) ||
+          !GetLengthPrefixedSlice(&input, &largest)) {
+        return STATUS_FORMAT(
+            Corruption, "Bad boundary value $0 of data block at $1", i, block_offset);
+      }
+      smallest_values_.emplace_back(tag, smallest);
+      largest_values_.emplace_back(tag, largest);
+    }
+  }
+  blocks_.shrink_to_fit();
+  smallest_values_.shrink_to_fit();
+  largest_values_.shrink_to_fit();
+  return Status::OK();
+}
+
+bool DataBlockBoundariesReader::Find(
+    uint64_t block_offset, DataBlockBoundaries* boundaries) const {
+  auto it = std::lower_bound(
+      blocks_.begin(), blocks_.end(), block_offset,
+      [](const BlockEntry& lhs, uint64_t rhs) {
+    return lhs.offset < rhs;
+  });
+  if (it == blocks_.end() || it->offset != block_offset) {
+    return false;
+  }
+  boundaries->smallest.values = smallest_values_.data() + it->first_value;
+  boundaries->smallest.num_values = it->num_values;
+  boundaries->largest.values = largest_values_.data() + it->first_value;
+  boundaries->largest.num_values = it->num_values;
+  return true;
+}
+
+size_t DataBlockBoundariesReader::ApproximateMemoryUsage() const {
+  return contents_.data.size() + blocks_.capacity() * sizeof(BlockEntry) +
+         (smallest_values_.capacity() + largest_values_.capacity()) *
+             sizeof(std::pair<UserBoundaryTag, Slice>);
+}
+
+} // namespace rocksdb
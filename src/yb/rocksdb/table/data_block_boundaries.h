@@ -0,0 +1,123 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_TABLE_DATA_BLOCK_BOUNDARIES_H
+#define YB_ROCKSDB_TABLE_DATA_BLOCK_BOUNDARIES_H
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "yb/rocksdb/metadata.h"
+#include "yb/rocksdb/table/format.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status_fwd.h"
+
+namespace rocksdb {
+
+class BoundaryValuesExtractor;
+
+namespace block_based_table {
+
+// Name of the meta block that stores user boundary values of data blocks.
+constexpr char kDataBlockBoundariesBlock[] = "yb.data_block_boundaries";
+
+} // namespace block_based_table
+
+// Encoded user boundary values of keys stored in a data block. Points to data owned by
+// DataBlockBoundariesReader.
+struct DataBlockUserValues {
+  const std::pair<UserBoundaryTag, Slice>* values = nullptr;
+  size_t num_values = 0;
+
+  const Slice* user_value_with_tag(UserBoundaryTag tag) const {
+    for (size_t i = 0; i != num_values; ++i) {
+      if (values[i].first == tag) {
+        return &values[i].second;
+      }
+    }
+    return nullptr;
+  }
+};
+
+// Smallest and largest user boundary values of a data block. A user value is only present if it
+// was extracted from every key stored in the block.
+struct DataBlockBoundaries {
+  DataBlockUserValues smallest;
+  DataBlockUserValues largest;
+};
+
+// Collects user boundary values of data blocks while SST file is being built.
+// The meta block is a sequence of entries, one per data block that has any boundary values:
+//   varint64 offset of the data block
+//   varint32 number of user values
+//   for each user value:
+//     varint32                 tag
+//     length prefixed slice    smallest encoded value
+//     length prefixed slice    largest encoded value
+class DataBlockBoundariesBuilder {
+ public:
+  explicit DataBlockBoundariesBuilder(BoundaryValuesExtractor* extractor);
+
+  // Updates boundaries of the current data block with the key being added to it.
+  CHECKED_STATUS Add(const Slice& internal_key, const Slice& value);
+
+  // Stores boundaries of the current data block, that was written at specified offset, and starts
+  // collecting boundaries of the next one.
+  void FinishDataBlock(uint64_t block_offset);
+
+  // Returns contents of the meta block.
+  const std::string& Finish() const { return buffer_; }
+
+ private:
+  BoundaryValuesExtractor* const extractor_;
+  bool block_empty_ = true;
+  boost::container::small_vector<UserBoundaryValuePtr, 10> key_values_;
+  boost::container::small_vector<UserBoundaryValuePtr, 10> smallest_;
+  boost::container::small_vector<UserBoundaryValuePtr, 10> largest_;
+  std::string buffer_;
+};
+
+// Provides access to boundaries of the data blocks stored in the meta block.
+class DataBlockBoundariesReader {
+ public:
+  // Parses the meta block contents, the reader takes ownership of them.
+  CHECKED_STATUS Init(BlockContents contents);
+
+  // Fills boundaries of the data block at specified offset. Returns false if they were not stored.
+  bool Find(uint64_t block_offset, DataBlockBoundaries* boundaries) const;
+
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  struct BlockEntry {
+    uint64_t offset;
+    size_t first_value;
+    size_t num_values;
+  };
+
+  BlockContents contents_;
+  std::vector<BlockEntry> blocks_;
+  // Values of all blocks, the values of a single block are stored contiguously.
+  std::vector<std::pair<UserBoundaryTag, Slice>> smallest_values_;
+  std::vector<std::pair<UserBoundaryTag, Slice>> largest_values_;
+};
+
+} // namespace rocksdb
+
+#endif // YB_ROCKSDB_TABLE_DATA_BLOCK_BOUNDARIES_H
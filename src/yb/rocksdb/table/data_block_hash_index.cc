@@ -0,0 +1,103 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/table/data_block_hash_index.h"
+
+#include <algorithm>
+
+#include <glog/logging.h>
+
+#include "yb/rocksdb/db/dbformat.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/hash.h"
+
+namespace rocksdb {
+
+namespace {
+
+// Ratio of the number of distinct prefixes to the number of buckets.
+constexpr double kUtilRatio = 0.75;
+
+constexpr uint32_t kHashSeed = 0x7c2a5f31;
+
+inline uint32_t PrefixHash(const Slice& prefix) {
+  return Hash(prefix.cdata(), prefix.size(), kHashSeed);
+}
+
+} // namespace
+
+uint8_t DataBlockHashIndex::Lookup(const Slice& prefix) const {
+  DCHECK_GT(num_buckets_, 0);
+  return buckets_[PrefixHash(prefix) % num_buckets_];
+}
+
+DataBlockHashIndexBuilder::DataBlockHashIndexBuilder(
+    const FilterPolicy::KeyTransformer* key_transformer)
+    : key_transformer_(key_transformer) {
+  DCHECK_ONLY_NOTNULL(key_transformer_);
+}
+
+void DataBlockHashIndexBuilder::Add(const Slice& internal_key, size_t restart_index) {
+  if (!valid_) {
+    return;
+  }
+  const auto prefix = key_transformer_->Transform(ExtractUserKey(internal_key));
+  if (prefix.empty()) {
+    // Keys without prefix are not indexed, seek to them falls back to binary search.
+    last_prefix_.clear();
+    return;
+  }
+  if (prefix == Slice(last_prefix_)) {
+    return;
+  }
+  if (restart_index > DataBlockHashIndex::kMaxRestartIndex) {
+    valid_ = false;
+    return;
+  }
+  hashes_.emplace_back(PrefixHash(prefix), static_cast<uint8_t>(restart_index));
+  last_prefix_.assign(prefix.cdata(), prefix.size());
+}
+
+uint32_t DataBlockHashIndexBuilder::NumBuckets() const {
+  return std::max<uint32_t>(static_cast<uint32_t>(hashes_.size() / kUtilRatio), 1);
+}
+
+size_t DataBlockHashIndexBuilder::EstimateSize() const {
+  return Valid() ? NumBuckets() + sizeof(uint32_t) : 0;
+}
+
+void DataBlockHashIndexBuilder::Finish(std::string* buffer) const {
+  DCHECK(Valid());
+  const auto num_buckets = NumBuckets();
+  const auto buckets_start = buffer->size();
+  buffer->resize(buckets_start + num_buckets, DataBlockHashIndex::kNoEntry);
+  auto* buckets = reinterpret_cast<uint8_t*>(&(*buffer)[buckets_start]);
+  for (const auto& hash_and_restart : hashes_) {
+    auto& bucket = buckets[hash_and_restart.first % num_buckets];
+    if (bucket == DataBlockHashIndex::kNoEntry) {
+      bucket = hash_and_restart.second;
+    } else if (bucket != hash_and_restart.second) {
+      // Prefixes starting in the same restart interval could share a bucket.
+      bucket = DataBlockHashIndex::kCollision;
+    }
+  }
+  PutFixed32(buffer, num_buckets);
+}
+
+void DataBlockHashIndexBuilder::Reset() {
+  valid_ = true;
+  last_prefix_.clear();
+  hashes_.clear();
+}
+
+} // namespace rocksdb
@@ -0,0 +1,99 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
+#define YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "yb/rocksdb/filter_policy.h"
+
+#include "yb/util/slice.h"
+
+namespace rocksdb {
+
+// Data block hash index maps key prefixes (as returned by the key transformer, for DocDB it is
+// the encoded DocKey) to the index of the restart interval that contains the first key with this
+// prefix. It allows a seek inside the data block to go directly to the right restart interval
+// instead of doing binary search over the restart array.
+//
+// The index is stored right after the restart array of the data block:
+//   buckets: uint8[num_buckets]
+//   num_buckets: uint32
+//   num_restarts: uint32 with kDataBlockHashIndexFlag set
+//
+// Each bucket contains either restart index, kNoEntry or kCollision. Index lookup result is only
+// a hint, the block iterator verifies it against restart keys, so hash collisions with prefixes
+// that are not present in the block do not affect correctness.
+
+// Set in the num_restarts field of the block trailer when the block has a hash index.
+constexpr uint32_t kDataBlockHashIndexFlag = 1U << 31;
+
+class DataBlockHashIndex {
+ public:
+  static constexpr uint8_t kNoEntry = 255;
+  static constexpr uint8_t kCollision = 254;
+  // Blocks with more restart points are stored without hash index.
+  static constexpr uint8_t kMaxRestartIndex = 253;
+
+  void Initialize(const uint8_t* buckets, uint32_t num_buckets) {
+    buckets_ = buckets;
+    num_buckets_ = num_buckets;
+  }
+
+  bool empty() const { return num_buckets_ == 0; }
+
+  // Returns restart index stored for the key prefix, kNoEntry or kCollision.
+  uint8_t Lookup(const Slice& prefix) const;
+
+ private:
+  const uint8_t* buckets_ = nullptr;
+  uint32_t num_buckets_ = 0;
+};
+
+class DataBlockHashIndexBuilder {
+ public:
+  explicit DataBlockHashIndexBuilder(const FilterPolicy::KeyTransformer* key_transformer);
+
+  // Adds internal key that is stored in the restart interval with specified index.
+  // Keys should be added in the order they are stored in the block.
+  void Add(const Slice& internal_key, size_t restart_index);
+
+  // Whether the hash index should be written for the current block.
+  bool Valid() const { return valid_ && !hashes_.empty(); }
+
+  // Returns estimated size of the hash index, or 0 if index is not going to be written.
+  size_t EstimateSize() const;
+
+  // Appends hash index to the buffer. Should only be called when Valid() is true.
+  void Finish(std::string* buffer) const;
+
+  void Reset();
+
+ private:
+  uint32_t NumBuckets() const;
+
+  const FilterPolicy::KeyTransformer* const key_transformer_;
+  bool valid_ = true;
+  std::string last_prefix_;
+  // Hashes of distinct prefixes with restart index of their first key.
+  std::vector<std::pair<uint32_t, uint8_t>> hashes_;
+};
+
+} // namespace rocksdb
+
+#endif // YB_ROCKSDB_TABLE_DATA_BLOCK_HASH_INDEX_H
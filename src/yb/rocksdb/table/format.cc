@@ -28,15 +28,18 @@
 #include <string>
 
 #include "yb/rocksdb/env.h"
+#include "yb/rocksdb/persistent_cache.h"
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/compression.h"
 #include "yb/rocksdb/util/crc32c.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
+#include "yb/rocksdb/util/statistics.h"
 #include "yb/rocksdb/util/xxhash.h"
 
 #include "yb/util/debug-util.h"
 #include "yb/util/env.h"
+#include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/result.h"
 #include "yb/util/stats/perf_step_timer.h"
@@ -445,10 +448,39 @@ BlockContents::BlockContents(
 Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
                          const ReadOptions& options, const BlockHandle& handle,
                          BlockContents* contents, Env* env,
-                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested) {
+                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                         const PersistentCacheOptions* persistent_cache_options,
+                         const UncompressionDict* compression_dict) {
   Status status;
   Slice slice;
   size_t n = static_cast<size_t>(handle.size());
+
+  std::string persistent_cache_key;
+  if (persistent_cache_options && persistent_cache_options->cache) {
+    persistent_cache_key = persistent_cache_options->key_prefix.ToBuffer();
+    PutVarint64(&persistent_cache_key, handle.offset());
+    PutVarint64(&persistent_cache_key, handle.size());
+    std::unique_ptr<char[]> cached_block;
+    size_t cached_size = 0;
+    if (persistent_cache_options->cache->Lookup(
+            persistent_cache_key, &cached_block, &cached_size).ok()) {
+      // Always verify checksum, since the block could be stored by a previous process.
+      if (cached_size == n + kBlockTrailerSize &&
+          VerifyBlockChecksum(file, footer, handle, cached_block.get(), n).ok()) {
+        RecordTick(persistent_cache_options->statistics, PERSISTENT_CACHE_HIT);
+        auto compression_type = static_cast<rocksdb::CompressionType>(cached_block[n]);
+        if (decompression_requested && compression_type != kNoCompression) {
+          PERF_TIMER_GUARD(block_decompress_time);
+          return UncompressBlockContents(
+              cached_block.get(), n, contents, footer.version(), mem_tracker, compression_dict);
+        }
+        *contents = BlockContents(
+            std::move(cached_block), n, true, compression_type, mem_tracker);
+        return Status::OK();
+      }
+    }
+    RecordTick(persistent_cache_options->statistics, PERSISTENT_CACHE_MISS);
+  }
   std::unique_ptr<char[]> heap_buf;
   char stack_buf[DefaultStackBufferSize];
   char* used_buf = nullptr;
@@ -471,12 +503,22 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
     return status;
   }
 
+  if (!persistent_cache_key.empty() && options.fill_cache) {
+    auto insert_status = persistent_cache_options->cache->Insert(
+        persistent_cache_key, slice.cdata(), n + kBlockTrailerSize);
+    if (!insert_status.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 10) << "Failed to add block to persistent cache: "
+                                       << insert_status;
+    }
+  }
+
   PERF_TIMER_GUARD(block_decompress_time);
 
   compression_type = static_cast<rocksdb::CompressionType>(slice.data()[n]);
 
   if (decompression_requested && compression_type != kNoCompression) {
-    return UncompressBlockContents(slice.cdata(), n, contents, footer.version(), mem_tracker);
+    return UncompressBlockContents(
+        slice.cdata(), n, contents, footer.version(), mem_tracker, compression_dict);
   }
 
   if (slice.cdata() != used_buf) {
@@ -503,7 +545,8 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
 Status UncompressBlockContents(const char* data, size_t n,
                                BlockContents* contents,
                                uint32_t format_version,
-                               const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+                               const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                               const UncompressionDict* compression_dict) {
   std::unique_ptr<char[]> ubuf;
   int decompress_size = 0;
   assert(data[n] != kNoCompression);
@@ -572,7 +615,7 @@ Status UncompressBlockContents(const char* data, size_t n,
       break;
     case kZSTDNotFinalCompression:
       ubuf =
-          std::unique_ptr<char[]>(ZSTD_Uncompress(data, n, &decompress_size));
+          std::unique_ptr<char[]>(ZSTD_Uncompress(data, n, &decompress_size, compression_dict));
       if (!ubuf) {
         static char zstd_corrupt_msg[] =
             "ZSTD not supported or corrupted ZSTD compressed block contents";
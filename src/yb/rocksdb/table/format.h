@@ -40,6 +40,9 @@ class MemTracker;
 namespace rocksdb {
 
 class Block;
+class PersistentCache;
+class Statistics;
+class UncompressionDict;
 struct ReadOptions;
 
 // the length of the magic number in bytes.
@@ -248,15 +251,28 @@ struct BlockContents {
   BlockContents& operator=(BlockContents&& other) = default;
 };
 
+// Secondary cache of raw blocks, that is checked before reading the block from the file.
+struct PersistentCacheOptions {
+  PersistentCache* cache = nullptr;
+  // Prefix of block keys, that is unique for the file and stable across process restarts.
+  Slice key_prefix;
+  Statistics* statistics = nullptr;
+};
+
 // Read the block identified by "handle" from "file".  On failure
 // return non-OK.  On success fill *result and return OK.
+// If persistent_cache_options is specified, the raw block is looked up in the persistent cache
+// first, and added to it after reading from the file when options.fill_cache is set.
+// compression_dict is the dictionary stored in the file, if any, used to uncompress the block.
 extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const Footer& footer,
                                 const ReadOptions& options,
                                 const BlockHandle& handle,
                                 BlockContents* contents, Env* env,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
-                                bool do_uncompress);
+                                bool do_uncompress,
+                                const PersistentCacheOptions* persistent_cache_options = nullptr,
+                                const UncompressionDict* compression_dict = nullptr);
 
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -265,10 +281,13 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
 // free this buffer.
 // For description of compress_format_version and possible values, see
 // util/compression.h
+// compression_dict is the dictionary the block could be compressed with, it is ignored by
+// compression types that do not support dictionaries.
 extern Status UncompressBlockContents(const char* data, size_t n,
                                       BlockContents* contents,
                                       uint32_t compress_format_version,
-                                      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+                                      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                      const UncompressionDict* compression_dict = nullptr);
 
 // Implementation details follow.  Clients should ignore,
 
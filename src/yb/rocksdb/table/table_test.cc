@@ -66,6 +66,7 @@
 #include "yb/rocksdb/util/testutil.h"
 
 #include "yb/util/enums.h"
+#include "yb/util/format.h"
 #include "yb/util/string_util.h"
 #include "yb/util/test_macros.h"
 
@@ -307,7 +308,7 @@ class TableConstructor: public Constructor {
                             internal_comparator,
                             int_tbl_prop_collector_factories,
                             options.compression,
-                            CompressionOptions(),
+                            options.compression_opts,
                             /* skip_filters */ false),
         TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
         file_writer_.get()));
@@ -336,8 +337,8 @@ class TableConstructor: public Constructor {
 
     // Open the table
     uniq_id_ = cur_uniq_id_++;
-    file_reader_.reset(test::GetRandomAccessFileReader(new test::StringSource(
-        GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads)));
+    source_ = new test::StringSource(GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads);
+    file_reader_.reset(test::GetRandomAccessFileReader(source_));
     return ioptions.table_factory->NewTableReader(
         TableReaderOptions(ioptions, soptions, internal_comparator),
         std::move(file_reader_), GetSink()->contents().size(), &table_reader_);
@@ -358,8 +359,8 @@ class TableConstructor: public Constructor {
   }
 
   virtual Status Reopen(const ImmutableCFOptions& ioptions) {
-    file_reader_.reset(test::GetRandomAccessFileReader(new test::StringSource(
-        GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads)));
+    source_ = new test::StringSource(GetSink()->contents(), uniq_id_, ioptions.allow_mmap_reads);
+    file_reader_.reset(test::GetRandomAccessFileReader(source_));
     return ioptions.table_factory->NewTableReader(
         TableReaderOptions(ioptions, soptions, last_internal_key_),
         std::move(file_reader_), GetSink()->contents().size(), &table_reader_);
@@ -369,6 +370,11 @@ class TableConstructor: public Constructor {
     return table_reader_.get();
   }
 
+  // Source of the table file, owned by the table reader.
+  test::StringSource* source() const {
+    return source_;
+  }
+
   bool AnywayDeleteIterator() const override {
     return convert_to_internal_key_;
   }
@@ -382,6 +388,7 @@ class TableConstructor: public Constructor {
  private:
   void Reset() {
     uniq_id_ = 0;
+    source_ = nullptr;
     table_reader_.reset();
     file_writer_.reset();
     file_reader_.reset();
@@ -395,6 +402,7 @@ class TableConstructor: public Constructor {
   unique_ptr<WritableFileWriter> file_writer_;
   unique_ptr<RandomAccessFileReader> file_reader_;
   unique_ptr<TableReader> table_reader_;
+  test::StringSource* source_ = nullptr;
   bool convert_to_internal_key_;
 
   TableConstructor();
@@ -1587,6 +1595,46 @@ TEST_F(BlockBasedTableTest, NumBlockStat) {
             c.GetTableReader()->GetTableProperties()->num_data_blocks);
 }
 
+TEST_F(BlockBasedTableTest, ScanReadahead) {
+  Random rnd(test::RandomSeed());
+  TableConstructor c(BytewiseComparator());
+  Options options;
+  options.compression = kNoCompression;
+  BlockBasedTableOptions table_options;
+  table_options.block_restart_interval = 1;
+  table_options.block_size = 1000;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  constexpr int kNumKeys = 100;
+  for (int i = 0; i < kNumKeys; ++i) {
+    // Each block holds roughly one key/value pair.
+    c.Add(RandomString(&rnd, 900), "val");
+  }
+
+  std::vector<std::string> ks;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &ks, &kvmap);
+
+  // Seeks to distant blocks are not sequential reads.
+  unique_ptr<InternalIterator> iter(c.NewIterator());
+  for (size_t i = 0; i < ks.size(); i += 10) {
+    iter->Seek(ks[i]);
+    ASSERT_TRUE(iter->Valid());
+  }
+  ASSERT_EQ(0, c.source()->total_readaheads());
+
+  int num_keys = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    ++num_keys;
+  }
+  ASSERT_EQ(kNumKeys, num_keys);
+  // Readahead grows, so it is issued much less often than data blocks are read.
+  ASSERT_GT(c.source()->total_readaheads(), 0);
+  ASSERT_LT(c.source()->total_readaheads(), kNumKeys / 4);
+}
+
 // A simple tool that takes the snapshot of block cache statistics.
 class BlockCachePropertiesSnapshot {
  public:
@@ -1696,6 +1744,92 @@ TEST_F(BlockBasedTableTest, BlockCacheDisabledTest) {
   ASSERT_TRUE(reader->TEST_index_reader_loaded());
 }
 
+TEST_F(BlockBasedTableTest, IndexAndFilterBlockCache) {
+  Options options;
+  options.create_if_missing = true;
+  options.statistics = CreateDBStatisticsForTests();
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1024 * 1024);
+  table_options.index_and_filter_block_cache = NewLRUCache(1024 * 1024);
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.block_size = 64;
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+
+  TableConstructor c(BytewiseComparator());
+  for (int i = 0; i != 100; ++i) {
+    c.Add("key" + std::to_string(1000 + i), std::string(100, 'v'));
+  }
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+  auto* reader = dynamic_cast<BlockBasedTable*>(c.GetTableReader());
+  ASSERT_FALSE(reader->TEST_index_reader_loaded());
+
+  const auto data_usage_before = table_options.block_cache->GetUsage();
+  const auto index_usage_before = table_options.index_and_filter_block_cache->GetUsage();
+  {
+    unique_ptr<InternalIterator> iter(c.NewIterator());
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++count;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(count, 100);
+  }
+  // Index block went to the dedicated cache, data blocks to block_cache.
+  ASSERT_GT(table_options.index_and_filter_block_cache->GetUsage(), index_usage_before);
+  ASSERT_GT(table_options.block_cache->GetUsage(), data_usage_before);
+  const auto index_hits = options.statistics->getTickerCount(BLOCK_CACHE_INDEX_HIT);
+  const auto index_misses = options.statistics->getTickerCount(BLOCK_CACHE_INDEX_MISS);
+  ASSERT_GT(index_misses, 0);
+
+  // Evicting all data blocks does not drop the index block.
+  const auto index_usage = table_options.index_and_filter_block_cache->GetUsage();
+  table_options.block_cache->SetCapacity(0);
+  ASSERT_EQ(table_options.index_and_filter_block_cache->GetUsage(), index_usage);
+  {
+    unique_ptr<InternalIterator> iter(c.NewIterator());
+    iter->SeekToFirst();
+    ASSERT_TRUE(iter->Valid());
+  }
+  ASSERT_GT(options.statistics->getTickerCount(BLOCK_CACHE_INDEX_HIT), index_hits);
+  ASSERT_EQ(options.statistics->getTickerCount(BLOCK_CACHE_INDEX_MISS), index_misses);
+}
+
+TEST_F(BlockBasedTableTest, PinTopLevelIndex) {
+  Options options;
+  options.create_if_missing = true;
+  options.statistics = CreateDBStatisticsForTests();
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1024 * 1024);
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.pin_top_level_index = true;
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+
+  TableConstructor c(BytewiseComparator());
+  c.Add("key", "value");
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+  auto* reader = dynamic_cast<BlockBasedTable*>(c.GetTableReader());
+  ASSERT_FALSE(reader->TEST_filter_block_preloaded());
+  ASSERT_FALSE(reader->TEST_index_reader_loaded());
+
+  {
+    unique_ptr<InternalIterator> iter(c.NewIterator());
+    iter->SeekToFirst();
+    ASSERT_TRUE(iter->Valid());
+  }
+  // Data index is kept in the table reader instead of the block cache.
+  ASSERT_TRUE(reader->TEST_index_reader_loaded());
+  BlockCachePropertiesSnapshot props(options.statistics.get());
+  props.AssertIndexBlockStat(0, 0);
+}
+
 // Due to the difficulities of the intersaction between statistics, this test
 // only tests the case when "index block is put to block cache"
 TEST_F(BlockBasedTableTest, FilterBlockInBlockCache) {
@@ -2186,6 +2320,56 @@ TEST_F(GeneralTableTest, ApproximateOffsetOfCompressed) {
   }
 }
 
+TEST_F(GeneralTableTest, CompressionDictionary) {
+  if (!ZSTD_Supported()) {
+    fprintf(stderr, "skipping zstd compression dictionary test\n");
+    return;
+  }
+  constexpr int kNumKeys = 2000;
+  uint64_t table_size_without_dict = 0;
+  for (uint32_t max_dict_bytes : {0, 4096}) {
+    Random rnd(301);
+    TableConstructor c(BytewiseComparator());
+    for (int i = 0; i != kNumKeys; ++i) {
+      char key[16];
+      snprintf(key, sizeof(key), "k%06d", i);
+      // JSON like values, that have a lot in common across blocks but little within a block.
+      c.Add(key, yb::Format(
+          R"({"id": $0, "name": "user$1", "email": "user$1@example.com", "status": "active"})",
+          i, rnd.Uniform(1000000)));
+    }
+    std::vector<std::string> keys;
+    stl_wrappers::KVMap kvmap;
+    Options options;
+    options.compression = kZSTDNotFinalCompression;
+    options.compression_opts.max_dict_bytes = max_dict_bytes;
+    options.compression_opts.zstd_max_train_bytes = 32 * 1024;
+    BlockBasedTableOptions table_options;
+    table_options.block_size = 1024;
+    const ImmutableCFOptions ioptions(options);
+    c.Finish(options, ioptions, table_options,
+             GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+
+    // Blocks compressed before and after the dictionary was trained are readable.
+    unique_ptr<InternalIterator> iter(c.NewIterator());
+    auto expected = kvmap.begin();
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected) {
+      ASSERT_NE(expected, kvmap.end());
+      ASSERT_EQ(expected->first, iter->key().ToString());
+      ASSERT_EQ(expected->second, iter->value().ToString());
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(expected, kvmap.end());
+
+    const uint64_t table_size = c.ApproximateOffsetOf("xyz");
+    if (max_dict_bytes == 0) {
+      table_size_without_dict = table_size;
+    } else {
+      ASSERT_LT(table_size, table_size_without_dict);
+    }
+  }
+}
+
 TEST_F(HarnessTest, Randomized) {
 #if defined(THREAD_SANITIZER)
   static constexpr int kMaxNumEntries = 200;
@@ -24,6 +24,9 @@
 #include <assert.h>
 #include <stdio.h>
 
+#include <atomic>
+#include <memory>
+
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/port/port.h"
 #include "yb/rocksdb/statistics.h"
@@ -46,6 +49,10 @@ DEFINE_bool(cache_overflow_single_touch, true,
             "Whether to enable overflow of single touch cache into the multi touch cache "
             "allocation");
 
+DEFINE_int64(cache_admission_sketch_entry_charge, 32 * 1024,
+             "Expected average charge of a cache entry, used to size the frequency sketch of "
+             "caches with frequency based admission.");
+
 namespace rocksdb {
 
 Cache::~Cache() {
@@ -373,6 +380,79 @@ class LRUHandleDeleter {
   autovector<LRUHandle*> handles_;
 };
 
+// Approximate counter of key access frequencies used for TinyLFU admission. It is a count-min
+// sketch with saturating 4-bit counters. All counters are halved each time the number of recorded
+// accesses reaches the sample size, so the sketch reflects recent frequencies.
+// Increment and Frequency are lock-free and could be called concurrently.
+class FrequencySketch {
+ public:
+  explicit FrequencySketch(size_t capacity) {
+    size_t num_counters = kMinCounters;
+    const auto expected_entries =
+        capacity / std::max<int64_t>(FLAGS_cache_admission_sketch_entry_charge, 1);
+    while (num_counters < expected_entries && num_counters < kMaxCounters) {
+      num_counters <<= 1;
+    }
+    mask_ = num_counters - 1;
+    sample_size_ = num_counters * kSampleSizeMultiplier;
+    counters_.reset(new std::atomic<uint8_t>[num_counters]);
+    for (size_t i = 0; i != num_counters; ++i) {
+      counters_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void Increment(uint32_t hash) {
+    for (size_t i = 0; i != kNumHashes; ++i) {
+      auto& counter = counters_[Index(hash, i)];
+      auto value = counter.load(std::memory_order_relaxed);
+      if (value < kMaxCount) {
+        // Lost increments because of concurrent updates are acceptable for an estimate.
+        counter.compare_exchange_weak(value, value + 1, std::memory_order_relaxed);
+      }
+    }
+    if (additions_.fetch_add(1, std::memory_order_relaxed) + 1 == sample_size_) {
+      for (size_t i = 0; i <= mask_; ++i) {
+        counters_[i].store(counters_[i].load(std::memory_order_relaxed) >> 1,
+                           std::memory_order_relaxed);
+      }
+      additions_.fetch_sub(sample_size_ / 2, std::memory_order_relaxed);
+    }
+  }
+
+  uint8_t Frequency(uint32_t hash) const {
+    uint8_t result = kMaxCount;
+    for (size_t i = 0; i != kNumHashes; ++i) {
+      result = std::min(result, counters_[Index(hash, i)].load(std::memory_order_relaxed));
+    }
+    return result;
+  }
+
+ private:
+  static constexpr size_t kNumHashes = 4;
+  static constexpr uint8_t kMaxCount = 15;
+  static constexpr size_t kMinCounters = 1ULL << 14;
+  static constexpr size_t kMaxCounters = 1ULL << 26;
+  static constexpr size_t kSampleSizeMultiplier = 10;
+
+  size_t Index(uint32_t hash, size_t i) const {
+    static constexpr uint64_t kSeeds[kNumHashes] = {
+        0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL,
+        0xcbf29ce484222325ULL };
+    return ((hash + 1) * kSeeds[i] >> 32) & mask_;
+  }
+
+  size_t mask_;
+  size_t sample_size_;
+  std::unique_ptr<std::atomic<uint8_t>[]> counters_;
+  std::atomic<size_t> additions_{0};
+};
+
+constexpr size_t FrequencySketch::kNumHashes;
+constexpr uint8_t FrequencySketch::kMaxCount;
+constexpr size_t FrequencySketch::kMinCounters;
+constexpr size_t FrequencySketch::kMaxCounters;
+constexpr size_t FrequencySketch::kSampleSizeMultiplier;
+
 // A single shard of sharded cache.
 class LRUCache {
  public:
@@ -392,6 +472,11 @@ class LRUCache {
   // Set the flag to reject insertion if cache if full.
   void SetStrictCapacityLimit(bool strict_capacity_limit);
 
+  // Set the sketch used for frequency based admission, nullptr disables admission filtering.
+  void SetAdmissionSketch(const FrequencySketch* sketch) {
+    admission_sketch_ = sketch;
+  }
+
   // Like Cache methods, but with an extra "hash" parameter.
   Status Insert(const Slice& key, uint32_t hash, const QueryId query_id,
                 void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
@@ -456,6 +541,11 @@ class LRUCache {
   // Checks if the corresponding subcache contains space.
   bool HasFreeSpace(const SubCacheType subcache_type);
 
+  // Returns false if the new entry should not be admitted to the subcache, because it is accessed
+  // less frequently than the entry that would be evicted for it. Replacement of an existing entry
+  // is always admitted.
+  bool Admit(LRUHandle* e, SubCacheType subcache_type);
+
   size_t TotalUsage() const {
     return single_touch_sub_cache_.Usage() + multi_touch_sub_cache_.Usage();
   }
@@ -470,6 +560,8 @@ class LRUCache {
 
   HandleTable table_;
 
+  const FrequencySketch* admission_sketch_ = nullptr;
+
   shared_ptr<yb::CacheMetrics> metrics_;
 };
 
@@ -651,6 +743,19 @@ bool LRUCache::HasFreeSpace(const SubCacheType subcache_type) {
   FATAL_INVALID_ENUM_VALUE(SubCacheType, subcache_type);
 }
 
+bool LRUCache::Admit(LRUHandle* e, SubCacheType subcache_type) {
+  if (admission_sketch_ == nullptr) {
+    return true;
+  }
+  LRUSubCache* sub_cache = GetSubCache(subcache_type);
+  if (sub_cache->Usage() + e->charge <= GetSubCacheCapacity(subcache_type) ||
+      sub_cache->IsLRUEmpty() || table_.Lookup(e->key(), e->hash) != nullptr) {
+    return true;
+  }
+  const LRUHandle* victim = sub_cache->LRU_Head().next;
+  return admission_sketch_->Frequency(e->hash) >= admission_sketch_->Frequency(victim->hash);
+}
+
 void LRUCache::Release(Cache::Handle* handle) {
   if (handle == nullptr) {
     return;
@@ -744,10 +849,23 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
     } else {
       subcache_type = table_.GetSubCacheTypeCandidate(e);
     }
-    EvictFromLRU(charge, &last_reference_list, subcache_type);
+    const bool rejected = !Admit(e, subcache_type);
+    if (!rejected) {
+      EvictFromLRU(charge, &last_reference_list, subcache_type);
+    }
     LRUSubCache* sub_cache = GetSubCache(subcache_type);
-    // If the cache no longer has any more space in the given pool.
-    if (strict_capacity_limit_ &&
+    if (rejected) {
+      // The entry is not added to the hash table, the same way as if it was inserted and erased
+      // right away. So the returned handle is still valid until released.
+      e->in_cache = false;
+      if (Unref(e)) {
+        last_reference_list.Add(e);
+      } else {
+        sub_cache->IncrementUsage(charge);
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      s = Status::OK();
+    } else if (strict_capacity_limit_ &&
         sub_cache->Usage() - sub_cache->LRU_Usage() + charge > GetSubCacheCapacity(subcache_type)) {
       if (handle == nullptr) {
         last_reference_list.Add(e);
@@ -787,7 +905,9 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
       s = Status::OK();
     }
     if (statistics != nullptr) {
-      if (s.ok()) {
+      if (rejected) {
+        RecordTick(statistics, BLOCK_CACHE_ADMISSION_REJECTED);
+      } else if (s.ok()) {
         RecordTick(statistics, BLOCK_CACHE_ADD);
         RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
         if (subcache_type == SubCacheType::SINGLE_TOUCH) {
@@ -849,6 +969,8 @@ class ShardedLRUCache : public Cache {
   size_t num_shard_bits_;
   size_t capacity_;
   bool strict_capacity_limit_;
+  // Access frequencies of keys, when entries are admitted based on frequency.
+  std::unique_ptr<FrequencySketch> admission_sketch_;
   shared_ptr<yb::CacheMetrics> metrics_;
 
   static inline uint32_t HashSlice(const Slice& s) {
@@ -866,16 +988,20 @@ class ShardedLRUCache : public Cache {
 
  public:
   ShardedLRUCache(size_t capacity, int num_shard_bits,
-                  bool strict_capacity_limit)
+                  bool strict_capacity_limit, CacheAdmissionPolicy admission_policy)
       : last_id_(0),
         num_shard_bits_(num_shard_bits),
         capacity_(capacity),
         strict_capacity_limit_(strict_capacity_limit),
         metrics_(nullptr) {
+    if (admission_policy == CacheAdmissionPolicy::kFrequency) {
+      admission_sketch_ = std::make_unique<FrequencySketch>(capacity);
+    }
     int num_shards = 1 << num_shard_bits_;
     shards_ = new LRUCache[num_shards];
     const size_t per_shard = (capacity + (num_shards - 1)) / num_shards;
     for (int s = 0; s < num_shards; s++) {
+      shards_[s].SetAdmissionSketch(admission_sketch_.get());
       shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
       shards_[s].SetCapacity(per_shard);
     }
@@ -926,6 +1052,11 @@ class ShardedLRUCache : public Cache {
       return nullptr;
     }
     const uint32_t hash = HashSlice(key);
+    if (admission_sketch_) {
+      // Record both hits and misses, so a block that is inserted after a miss has a chance to
+      // be admitted when it is accessed again.
+      admission_sketch_->Increment(hash);
+    }
     return shards_[Shard(hash)].Lookup(key, hash, query_id, statistics);
   }
 
@@ -1026,11 +1157,18 @@ shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits) {
 
 shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                               bool strict_capacity_limit) {
+  return NewLRUCache(capacity, num_shard_bits, strict_capacity_limit,
+                     CacheAdmissionPolicy::kAlways);
+}
+
+shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
+                              bool strict_capacity_limit,
+                              CacheAdmissionPolicy admission_policy) {
   if (num_shard_bits >= 20) {
     return nullptr;  // the cache cannot be sharded into too many fine pieces
   }
   return std::make_shared<ShardedLRUCache>(capacity, num_shard_bits,
-                                           strict_capacity_limit);
+                                           strict_capacity_limit, admission_policy);
 }
 
 }  // namespace rocksdb
@@ -34,6 +34,8 @@ int main() {
 #include <stdio.h>
 #include <gflags/gflags.h>
 
+#include <atomic>
+
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/env.h"
@@ -60,6 +62,11 @@ DEFINE_int32(lookup_percent, 50,
              "Ratio of lookup to total workload (expressed as a percentage)");
 DEFINE_int32(erase_percent, 10,
              "Ratio of erase to total workload (expressed as a percentage)");
+DEFINE_int32(scan_percent, 0,
+             "Ratio of scan operations, i.e. lookup and insert of a key that was never accessed "
+             "before, to total workload (expressed as a percentage)");
+DEFINE_bool(frequency_admission, false,
+            "Use frequency based admission (TinyLFU) instead of always admitting new entries");
 
 namespace rocksdb {
 
@@ -145,7 +152,9 @@ struct ThreadState {
 class CacheBench {
  public:
   CacheBench() :
-      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits)),
+      cache_(NewLRUCache(FLAGS_cache_size, FLAGS_num_shard_bits, false /* strict */,
+                         FLAGS_frequency_admission ? CacheAdmissionPolicy::kFrequency
+                                                   : CacheAdmissionPolicy::kAlways)),
       num_threads_(FLAGS_threads) {}
 
   ~CacheBench() {}
@@ -194,6 +203,9 @@ class CacheBench {
       uint32_t qps = static_cast<uint32_t>(
           static_cast<double>(FLAGS_threads * FLAGS_ops_per_thread) / elapsed);
       fprintf(stdout, "Complete in %.3f s; QPS = %u\n", elapsed, qps);
+      const uint64_t lookups = lookups_.load(std::memory_order_relaxed);
+      fprintf(stdout, "Lookup hit ratio: %.4f\n",
+              lookups ? static_cast<double>(hits_.load(std::memory_order_relaxed)) / lookups : 0.0);
     }
     return true;
   }
@@ -201,6 +213,8 @@ class CacheBench {
  private:
   std::shared_ptr<Cache> cache_;
   uint32_t num_threads_;
+  std::atomic<uint64_t> lookups_{0};
+  std::atomic<uint64_t> hits_{0};
 
   static void ThreadBody(void* v) {
     ThreadState* thread = reinterpret_cast<ThreadState*>(v);
@@ -228,7 +242,20 @@ class CacheBench {
   }
 
   void OperateCache(ThreadState* thread) {
+    // Keys of scan operations are above max_key, so they are never accessed by other operations.
+    uint64_t scan_key = FLAGS_max_key + thread->tid * FLAGS_ops_per_thread;
     for (uint64_t i = 0; i < FLAGS_ops_per_thread; i++) {
+      if (static_cast<int32_t>(thread->rnd.Uniform(100)) < FLAGS_scan_percent) {
+        Slice key(reinterpret_cast<char*>(&scan_key), 8);
+        auto handle = cache_->Lookup(key);
+        if (handle) {
+          cache_->Release(handle);
+        } else {
+          cache_->Insert(key, new char[10], 1, &deleter);
+        }
+        ++scan_key;
+        continue;
+      }
       uint64_t rand_key = thread->rnd.Next() % FLAGS_max_key;
       // Cast uint64* to be char*, data would be copied to cache
       Slice key(reinterpret_cast<char*>(&rand_key), 8);
@@ -240,7 +267,9 @@ class CacheBench {
                  prob_op < FLAGS_lookup_percent) {
         // do lookup
         auto handle = cache_->Lookup(key);
+        lookups_.fetch_add(1, std::memory_order_relaxed);
         if (handle) {
+          hits_.fetch_add(1, std::memory_order_relaxed);
           cache_->Release(handle);
         }
       } else if (prob_op -= FLAGS_lookup_percent &&
@@ -261,6 +290,8 @@ class CacheBench {
     printf("Insert percentage   : %d%%\n", FLAGS_insert_percent);
     printf("Lookup percentage   : %d%%\n", FLAGS_lookup_percent);
     printf("Erase percentage    : %d%%\n", FLAGS_erase_percent);
+    printf("Scan percentage     : %d%%\n", FLAGS_scan_percent);
+    printf("Frequency admission : %d\n", FLAGS_frequency_admission);
     printf("----------------------------\n");
   }
 };
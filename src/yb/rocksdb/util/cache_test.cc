@@ -637,6 +637,53 @@ TEST_F(CacheTest, OverCapacity) {
   }
 }
 
+TEST_F(CacheTest, FrequencyAdmission) {
+  constexpr int kHotKeys = 100;
+  constexpr int kScanKeys = 1000;
+  // Returns number of hot keys that are still in the cache after a scan over a lot of new keys.
+  auto hot_keys_after_scan = [this](const std::shared_ptr<Cache>& cache) {
+    for (int i = 0; i != kHotKeys; ++i) {
+      EXPECT_OK(Insert(cache, i, i));
+    }
+    for (int j = 0; j != 3; ++j) {
+      for (int i = 0; i != kHotKeys; ++i) {
+        EXPECT_EQ(Lookup(cache, i), i);
+      }
+    }
+    for (int i = kHotKeys; i != kHotKeys + kScanKeys; ++i) {
+      EXPECT_EQ(Lookup(cache, i), -1);
+      EXPECT_OK(Insert(cache, i, i));
+    }
+    int result = 0;
+    for (int i = 0; i != kHotKeys; ++i) {
+      if (Lookup(cache, i) == i) {
+        ++result;
+      }
+    }
+    return result;
+  };
+
+  ASSERT_EQ(hot_keys_after_scan(NewLRUCache(kHotKeys, 0)), 0);
+
+  auto cache = NewLRUCache(kHotKeys, 0, false, CacheAdmissionPolicy::kFrequency);
+  ASSERT_GE(hot_keys_after_scan(cache), kHotKeys * 9 / 10);
+  ASSERT_LE(cache->GetUsage(), kHotKeys);
+
+  // Rejected entry is still accessible through the returned handle.
+  deleted_keys_.clear();
+  Cache::Handle* handle = nullptr;
+  const int kRejectedKey = kHotKeys + kScanKeys;
+  ASSERT_OK(cache->Insert(EncodeKey(kRejectedKey), kTestQueryId, EncodeValue(kRejectedKey), 1,
+                          &CacheTest::Deleter, &handle));
+  ASSERT_NE(handle, nullptr);
+  ASSERT_EQ(DecodeValue(cache->Value(handle)), kRejectedKey);
+  ASSERT_EQ(Lookup(cache, kRejectedKey), -1);
+  cache->Release(handle);
+  ASSERT_EQ(deleted_keys_.size(), 1U);
+  ASSERT_EQ(deleted_keys_[0], kRejectedKey);
+  ASSERT_LE(cache->GetUsage(), kHotKeys);
+}
+
 namespace {
 std::vector<std::pair<int, int>> callback_state;
 void callback(void* entry, size_t charge) {
@@ -25,7 +25,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
@@ -48,6 +50,7 @@
 #endif
 
 #if defined(ZSTD)
+#include <zdict.h>
 #include <zstd.h>
 #endif
 
@@ -620,8 +623,88 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
   return false;
 }
 
+// Compression level used when CompressionOptions::level is negative, i.e. the zlib default of -1.
+// Negative levels mean "fast" modes with low compression ratio for ZSTD.
+constexpr int kZSTDDefaultLevel = 3;
+
+inline int ZSTD_Level(const CompressionOptions& opts) {
+  return opts.level < 0 ? kZSTDDefaultLevel : opts.level;
+}
+
+// Dictionary trained by ZSTD_TrainDictionary, used to compress the data blocks of a file.
+// The dictionary is digested once, instead of once per compressed block.
+class CompressionDict {
+ public:
+  CompressionDict(std::string dict, int level) : dict_(std::move(dict)) {
+#ifdef ZSTD
+    cdict_ = ZSTD_createCDict(dict_.data(), dict_.size(), level);
+#endif
+  }
+
+  ~CompressionDict() {
+#ifdef ZSTD
+    ZSTD_freeCDict(cdict_);
+#endif
+  }
+
+  CompressionDict(const CompressionDict&) = delete;
+  void operator=(const CompressionDict&) = delete;
+
+  // Raw dictionary, as it is stored in the file.
+  Slice raw() const {
+    return dict_;
+  }
+
+#ifdef ZSTD
+  const ZSTD_CDict* zstd_cdict() const {
+    return cdict_;
+  }
+#endif
+
+ private:
+  std::string dict_;
+#ifdef ZSTD
+  ZSTD_CDict* cdict_ = nullptr;
+#endif
+};
+
+// Dictionary loaded from a file, used to uncompress its data blocks. The dictionary is digested
+// once when the file is opened, instead of once per uncompressed block. The raw dictionary must
+// outlive this object.
+class UncompressionDict {
+ public:
+  explicit UncompressionDict(const Slice& dict) {
+#ifdef ZSTD
+    ddict_ = ZSTD_createDDict(dict.data(), dict.size());
+#endif
+  }
+
+  ~UncompressionDict() {
+#ifdef ZSTD
+    ZSTD_freeDDict(ddict_);
+#endif
+  }
+
+  UncompressionDict(const UncompressionDict&) = delete;
+  void operator=(const UncompressionDict&) = delete;
+
+#ifdef ZSTD
+  const ZSTD_DDict* zstd_ddict() const {
+    return ddict_;
+  }
+#endif
+
+ private:
+#ifdef ZSTD
+  ZSTD_DDict* ddict_ = nullptr;
+#endif
+};
+
+// compression_dict is an optional dictionary trained by ZSTD_TrainDictionary. Blocks compressed
+// with a dictionary could only be uncompressed with the same dictionary.
 inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
-                          size_t length, ::std::string* output) {
+                          size_t length, ::std::string* output,
+                          const CompressionDict* compression_dict = nullptr) {
 #ifdef ZSTD
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -633,9 +716,18 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 
   size_t compressBound = ZSTD_compressBound(length);
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  size_t outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
-                                input, length, opts.level);
-  if (outlen == 0) {
+  size_t outlen;
+  if (compression_dict == nullptr || compression_dict->zstd_cdict() == nullptr) {
+    outlen = ZSTD_compress(
+        &(*output)[output_header_len], compressBound, input, length, ZSTD_Level(opts));
+  } else {
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    outlen = ZSTD_compress_usingCDict(
+        context, &(*output)[output_header_len], compressBound, input, length,
+        compression_dict->zstd_cdict());
+    ZSTD_freeCCtx(context);
+  }
+  if (outlen == 0 || ZSTD_isError(outlen)) {
     return false;
   }
   output->resize(output_header_len + outlen);
@@ -644,8 +736,11 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
   return false;
 }
 
+// Blocks compressed without a dictionary could also be uncompressed when compression_dict is
+// specified, so the same dictionary could be passed for all blocks of a file.
 inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
-                             int* decompress_size) {
+                             int* decompress_size,
+                             const UncompressionDict* compression_dict = nullptr) {
 #ifdef ZSTD
   uint32_t output_len = 0;
   if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
@@ -653,14 +748,46 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
     return nullptr;
   }
 
-  char* output = new char[output_len];
-  size_t actual_output_length =
-      ZSTD_decompress(output, output_len, input_data, input_length);
-  assert(actual_output_length == output_len);
+  std::unique_ptr<char[]> output(new char[output_len]);
+  size_t actual_output_length;
+  // Frames without a dictionary id were compressed before the dictionary was trained.
+  if (compression_dict == nullptr || compression_dict->zstd_ddict() == nullptr ||
+      ZSTD_getDictID_fromFrame(input_data, input_length) == 0) {
+    actual_output_length = ZSTD_decompress(output.get(), output_len, input_data, input_length);
+  } else {
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    actual_output_length = ZSTD_decompress_usingDDict(
+        context, output.get(), output_len, input_data, input_length,
+        compression_dict->zstd_ddict());
+    ZSTD_freeDCtx(context);
+  }
+  if (ZSTD_isError(actual_output_length) || actual_output_length != output_len) {
+    return nullptr;
+  }
   *decompress_size = static_cast<int>(actual_output_length);
-  return output;
+  return output.release();
 #endif
   return nullptr;
 }
 
+// Trains a ZSTD dictionary of up to max_dict_bytes from the samples concatenated in samples, where
+// sample_sizes contains the size of each sample. Returns an empty string when ZSTD is not supported
+// or the training failed, e.g. because there are too few samples.
+inline std::string ZSTD_TrainDictionary(const std::string& samples,
+                                        const std::vector<size_t>& sample_sizes,
+                                        size_t max_dict_bytes) {
+#ifdef ZSTD
+  std::string dict(max_dict_bytes, '\0');
+  size_t dict_size = ZDICT_trainFromBuffer(
+      &dict[0], max_dict_bytes, samples.data(), sample_sizes.data(),
+      static_cast<unsigned>(sample_sizes.size()));
+  if (ZDICT_isError(dict_size)) {
+    return std::string();
+  }
+  dict.resize(dict_size);
+  return dict;
+#endif
+  return std::string();
+}
+
 }  // namespace rocksdb
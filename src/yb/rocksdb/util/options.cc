@@ -95,7 +95,8 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       mem_tracker(options.mem_tracker),
       block_based_table_mem_tracker(options.block_based_table_mem_tracker),
       iterator_replacer(options.iterator_replacer),
-      compaction_file_filter_factory(options.compaction_file_filter_factory.get()) {}
+      compaction_file_filter_factory(options.compaction_file_filter_factory.get()),
+      boundary_extractor(options.boundary_extractor.get()) {}
 
 ColumnFamilyOptions::ColumnFamilyOptions()
     : comparator(BytewiseComparator()),
@@ -416,6 +417,8 @@ void DBOptions::Dump(Logger* log) const {
       RHEADER(log, "                               Options.row_cache: None");
     }
   RHEADER(log, "                           Options.initial_seqno: %" PRIu64, initial_seqno);
+  RHEADER(log, "          Options.allow_immutable_memtable_erase: %d",
+      allow_immutable_memtable_erase);
 #ifndef ROCKSDB_LITE
   RHEADER(log, "       Options.wal_filter: %s",
       wal_filter ? wal_filter->Name() : "None");
@@ -459,6 +462,8 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       compression_opts.level);
   RHEADER(log, "              Options.compression_opts.strategy: %d",
       compression_opts.strategy);
+  RHEADER(log, "        Options.compression_opts.max_dict_bytes: %" PRIu32,
+      compression_opts.max_dict_bytes);
   RHEADER(log, "     Options.level0_file_num_compaction_trigger: %d",
       level0_file_num_compaction_trigger);
   RHEADER(log, "         Options.level0_slowdown_writes_trigger: %d",
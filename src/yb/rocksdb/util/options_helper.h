@@ -341,6 +341,9 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
     {"initial_seqno",
      {offsetof(struct DBOptions, initial_seqno), OptionType::kUInt64T,
       OptionVerificationType::kNormal}},
+    {"allow_immutable_memtable_erase",
+     {offsetof(struct DBOptions, allow_immutable_memtable_erase), OptionType::kBoolean,
+      OptionVerificationType::kNormal}},
     {"max_file_size_for_compaction",
      {offsetof(struct DBOptions, max_file_size_for_compaction),
       OptionType::kUInt64T, OptionVerificationType::kNormal}},
@@ -515,6 +518,8 @@ static std::unordered_map<std::string,
     /* currently not supported
       std::shared_ptr<Cache> block_cache = nullptr;
       std::shared_ptr<Cache> block_cache_compressed = nullptr;
+      std::shared_ptr<Cache> index_and_filter_block_cache = nullptr;
+      std::shared_ptr<PersistentCache> persistent_cache = nullptr;
      */
     {"flush_block_policy_factory",
      {offsetof(struct BlockBasedTableOptions, flush_block_policy_factory),
@@ -522,6 +527,9 @@ static std::unordered_map<std::string,
     {"cache_index_and_filter_blocks",
      {offsetof(struct BlockBasedTableOptions, cache_index_and_filter_blocks),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"pin_top_level_index",
+     {offsetof(struct BlockBasedTableOptions, pin_top_level_index),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
     {"index_type",
      {offsetof(struct BlockBasedTableOptions, index_type),
       OptionType::kBlockBasedTableIndexType, OptionVerificationType::kNormal}},
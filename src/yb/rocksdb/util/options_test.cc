@@ -1694,6 +1694,7 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "access_hint_on_compaction_start=NONE;"
       "max_file_size_for_compaction=123;"
       "initial_seqno=432;"
+      "allow_immutable_memtable_erase=true;"
       "num_reserved_small_compaction_threads=-1;"
       "compaction_size_threshold_bytes=18446744073709551615;"
       "info_log_level=DEBUG_LEVEL;";
@@ -1931,6 +1932,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, wal_filter),
       BLACKLIST_ENTRY(DBOptions, boundary_extractor),
       BLACKLIST_ENTRY(DBOptions, max_file_size_for_compaction),
+      BLACKLIST_ENTRY(DBOptions, subcompaction_key_prefix_extractor),
       BLACKLIST_ENTRY(DBOptions, mem_table_flush_filter_factory),
       BLACKLIST_ENTRY(DBOptions, log_prefix),
       BLACKLIST_ENTRY(DBOptions, mem_tracker),
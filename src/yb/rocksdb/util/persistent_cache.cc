@@ -0,0 +1,398 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rocksdb/persistent_cache.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <glog/logging.h>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/util/coding.h"
+#include "yb/rocksdb/util/crc32c.h"
+
+#include "yb/util/format.h"
+#include "yb/util/status_format.h"
+#include "yb/util/status_log.h"
+
+namespace rocksdb {
+
+namespace {
+
+const char* const kFileSuffix = ".pcache";
+
+// Each record has the following format:
+// masked crc32c of the rest of the record: fixed32
+// key size: fixed32
+// value size: fixed32
+// key
+// value
+constexpr size_t kRecordHeaderSize = 3 * sizeof(uint32_t);
+
+std::string CacheFileName(const std::string& path, uint64_t number) {
+  return Format("$0/$1$2", path, number, kFileSuffix);
+}
+
+// Returns false if name is not a name of the cache file.
+bool ParseCacheFileName(const std::string& name, uint64_t* number) {
+  const size_t suffix_len = strlen(kFileSuffix);
+  if (name.size() <= suffix_len ||
+      name.compare(name.size() - suffix_len, suffix_len, kFileSuffix) != 0) {
+    return false;
+  }
+  uint64_t result = 0;
+  for (size_t i = 0; i != name.size() - suffix_len; ++i) {
+    if (!isdigit(name[i])) {
+      return false;
+    }
+    result = result * 10 + (name[i] - '0');
+  }
+  *number = result;
+  return true;
+}
+
+class FilePersistentCache : public PersistentCache {
+ public:
+  FilePersistentCache(Env* env, std::string path, size_t capacity, size_t file_size)
+      : env_(env), path_(std::move(path)), capacity_(capacity), file_size_(file_size) {}
+
+  ~FilePersistentCache() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // Store the last file, so its entries survive restart.
+      SealCurrentFile();
+      closing_ = true;
+    }
+    write_cond_.notify_one();
+    // The write thread writes all sealed files before exiting.
+    if (write_thread_.joinable()) {
+      write_thread_.join();
+    }
+  }
+
+  CHECKED_STATUS Open() {
+    RETURN_NOT_OK(env_->CreateDirIfMissing(path_));
+    std::vector<std::string> children;
+    RETURN_NOT_OK(env_->GetChildren(path_, &children));
+    std::vector<uint64_t> numbers;
+    for (const auto& child : children) {
+      uint64_t number;
+      if (ParseCacheFileName(child, &number)) {
+        numbers.push_back(number);
+      }
+    }
+    std::sort(numbers.begin(), numbers.end());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto number : numbers) {
+      auto status = LoadFile(number);
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to load persistent cache file " << CacheFileName(path_, number)
+                     << ": " << status;
+        WARN_NOT_OK(env_->DeleteFile(CacheFileName(path_, number)),
+                    "Failed to delete persistent cache file");
+      }
+      next_file_number_ = std::max(next_file_number_, number + 1);
+    }
+    EvictIfNeeded();
+    current_file_number_ = next_file_number_++;
+    write_thread_ = std::thread(&FilePersistentCache::WriteSealedFiles, this);
+    LOG(INFO) << "Opened persistent cache at " << path_ << ", entries: " << index_.size()
+              << ", usage: " << usage_;
+    return Status::OK();
+  }
+
+  CHECKED_STATUS Insert(const Slice& key, const char* data, size_t size) override {
+    bool sealed = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (index_.count(key.ToBuffer())) {
+        return Status::OK();
+      }
+      const size_t record_size = kRecordHeaderSize + key.size() + size;
+      const size_t offset = buffer_.size();
+      buffer_.resize(offset + kRecordHeaderSize);
+      EncodeFixed32(&buffer_[offset + sizeof(uint32_t)], static_cast<uint32_t>(key.size()));
+      EncodeFixed32(&buffer_[offset + 2 * sizeof(uint32_t)], static_cast<uint32_t>(size));
+      buffer_.append(key.cdata(), key.size());
+      buffer_.append(data, size);
+      EncodeFixed32(&buffer_[offset], crc32c::Mask(crc32c::Value(
+          buffer_.data() + offset + sizeof(uint32_t), record_size - sizeof(uint32_t))));
+      AddToIndex(key.ToBuffer(), current_file_number_, offset, record_size);
+      usage_ += record_size;
+      if (buffer_.size() >= file_size_) {
+        sealed = SealCurrentFile();
+      }
+      EvictIfNeeded();
+    }
+    if (sealed) {
+      write_cond_.notify_one();
+    }
+    return Status::OK();
+  }
+
+  CHECKED_STATUS Lookup(const Slice& key, std::unique_ptr<char[]>* data, size_t* size) override {
+    Location location;
+    std::shared_ptr<const std::string> buffer;
+    std::shared_ptr<RandomAccessFile> reader;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(key.ToBuffer());
+      if (it == index_.end()) {
+        return STATUS(NotFound, "");
+      }
+      location = it->second;
+      if (location.file_number == current_file_number_) {
+        return ParseRecord(key, Slice(buffer_.data() + location.offset, location.size), data, size);
+      }
+      auto file_it = files_.find(location.file_number);
+      DCHECK(file_it != files_.end());
+      buffer = file_it->second.buffer;
+      reader = file_it->second.reader;
+    }
+
+    if (buffer) {
+      return ParseRecord(key, Slice(buffer->data() + location.offset, location.size), data, size);
+    }
+    std::unique_ptr<uint8_t[]> scratch(new uint8_t[location.size]);
+    Slice record;
+    RETURN_NOT_OK(reader->Read(location.offset, location.size, &record, scratch.get()));
+    auto status = ParseRecord(key, record, data, size);
+    if (!status.ok()) {
+      LOG(WARNING) << "Corrupted persistent cache record in " << reader->filename() << ": "
+                   << status;
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = index_.find(key.ToBuffer());
+      if (it != index_.end() && it->second.file_number == location.file_number) {
+        index_.erase(it);
+      }
+      return STATUS(NotFound, "");
+    }
+    return Status::OK();
+  }
+
+  size_t GetUsage() const override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return usage_;
+  }
+
+ private:
+  struct Location {
+    uint64_t file_number;
+    size_t offset;
+    size_t size;
+  };
+
+  struct CacheFile {
+    // Content of the file, while it is not written to disk yet.
+    std::shared_ptr<const std::string> buffer;
+    std::shared_ptr<RandomAccessFile> reader;
+    size_t size = 0;
+    // Keys of records stored in this file.
+    std::vector<std::string> keys;
+  };
+
+  // Verifies record checksum and key, then copies the value.
+  static CHECKED_STATUS ParseRecord(
+      const Slice& key, const Slice& record, std::unique_ptr<char[]>* data, size_t* size) {
+    if (record.size() < kRecordHeaderSize) {
+      return STATUS_FORMAT(Corruption, "Truncated record: $0", record.size());
+    }
+    const auto expected_crc = crc32c::Unmask(DecodeFixed32(record.cdata()));
+    const auto actual_crc = crc32c::Value(
+        record.cdata() + sizeof(uint32_t), record.size() - sizeof(uint32_t));
+    if (expected_crc != actual_crc) {
+      return STATUS(Corruption, "Record checksum mismatch");
+    }
+    const size_t key_size = DecodeFixed32(record.cdata() + sizeof(uint32_t));
+    const size_t value_size = DecodeFixed32(record.cdata() + 2 * sizeof(uint32_t));
+    if (kRecordHeaderSize + key_size + value_size != record.size() ||
+        Slice(record.cdata() + kRecordHeaderSize, key_size) != key) {
+      return STATUS(Corruption, "Record key mismatch");
+    }
+    data->reset(new char[value_size]);
+    memcpy(data->get(), record.cdata() + kRecordHeaderSize + key_size, value_size);
+    *size = value_size;
+    return Status::OK();
+  }
+
+  CHECKED_STATUS WriteFile(uint64_t number, const std::string& buffer) {
+    return WriteStringToFile(env_, buffer, CacheFileName(path_, number), true /* should_sync */);
+  }
+
+  // Body of write_thread_. Writes sealed files to disk in the order they were sealed, so the
+  // threads inserting and looking up blocks never wait for disk writes. The sealed file is served
+  // from memory until it is written.
+  void WriteSealedFiles() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      write_cond_.wait(lock, [this] { return closing_ || !sealed_files_.empty(); });
+      if (sealed_files_.empty()) {
+        return;
+      }
+      const auto number = sealed_files_.front();
+      sealed_files_.pop_front();
+      auto it = files_.find(number);
+      if (it == files_.end()) {
+        // Evicted before it was written.
+        continue;
+      }
+      auto buffer = it->second.buffer;
+      lock.unlock();
+
+      auto status = WriteFile(number, *buffer);
+      std::unique_ptr<RandomAccessFile> reader;
+      if (status.ok()) {
+        status = env_->NewRandomAccessFile(CacheFileName(path_, number), &reader, EnvOptions());
+      }
+      WARN_NOT_OK(status, "Failed to write persistent cache file");
+
+      lock.lock();
+      it = files_.find(number);
+      if (it == files_.end()) {
+        // Evicted while it was written.
+        reader.reset();
+        WARN_NOT_OK(env_->DeleteFile(CacheFileName(path_, number)),
+                    "Failed to delete persistent cache file");
+      } else if (!status.ok()) {
+        it->second.buffer.reset();
+        RemoveFile(it);
+      } else {
+        it->second.reader = std::move(reader);
+        it->second.buffer.reset();
+      }
+    }
+  }
+
+  // Parses records of the existing file and adds them to the index. Stops at the first corrupted
+  // record, which is expected if the process crashed while writing the file.
+  CHECKED_STATUS LoadFile(uint64_t number) {
+    const auto file_name = CacheFileName(path_, number);
+    std::string content;
+    RETURN_NOT_OK(ReadFileToString(env_, file_name, &content));
+    std::unique_ptr<RandomAccessFile> reader;
+    RETURN_NOT_OK(env_->NewRandomAccessFile(file_name, &reader, EnvOptions()));
+    auto& file = files_[number];
+    file.reader = std::move(reader);
+    size_t offset = 0;
+    while (offset + kRecordHeaderSize <= content.size()) {
+      const size_t key_size = DecodeFixed32(content.data() + offset + sizeof(uint32_t));
+      const size_t value_size = DecodeFixed32(content.data() + offset + 2 * sizeof(uint32_t));
+      const size_t record_size = kRecordHeaderSize + key_size + value_size;
+      if (offset + record_size > content.size()) {
+        break;
+      }
+      const auto expected_crc = crc32c::Unmask(DecodeFixed32(content.data() + offset));
+      if (expected_crc != crc32c::Value(content.data() + offset + sizeof(uint32_t),
+                                        record_size - sizeof(uint32_t))) {
+        break;
+      }
+      std::string key(content.data() + offset + kRecordHeaderSize, key_size);
+      AddToIndex(std::move(key), number, offset, record_size);
+      offset += record_size;
+    }
+    if (offset != content.size()) {
+      LOG(WARNING) << "Persistent cache file " << file_name << " is truncated from "
+                   << content.size() << " to " << offset << " bytes";
+    }
+    usage_ += file.size;
+    return Status::OK();
+  }
+
+  void AddToIndex(std::string key, uint64_t file_number, size_t offset, size_t record_size) {
+    auto& location = index_[key];
+    location = Location{file_number, offset, record_size};
+    auto& file = files_[file_number];
+    file.keys.push_back(std::move(key));
+    file.size += record_size;
+  }
+
+  // Moves the content of the current file to files_ and queues it for write_thread_.
+  // Returns false if the current file is empty.
+  bool SealCurrentFile() {
+    if (buffer_.empty()) {
+      return false;
+    }
+    files_[current_file_number_].buffer = std::make_shared<const std::string>(std::move(buffer_));
+    buffer_.clear();
+    sealed_files_.push_back(current_file_number_);
+    current_file_number_ = next_file_number_++;
+    return true;
+  }
+
+  // Removes the oldest files while usage exceeds the capacity.
+  void EvictIfNeeded() {
+    while (usage_ > capacity_ && !files_.empty() &&
+           files_.begin()->first != current_file_number_) {
+      RemoveFile(files_.begin());
+    }
+  }
+
+  void RemoveFile(std::map<uint64_t, CacheFile>::iterator it) {
+    for (const auto& key : it->second.keys) {
+      auto index_it = index_.find(key);
+      if (index_it != index_.end() && index_it->second.file_number == it->first) {
+        index_.erase(index_it);
+      }
+    }
+    usage_ -= std::min(usage_, it->second.size);
+    // A file that is not written yet is deleted by the thread writing it.
+    if (!it->second.buffer) {
+      WARN_NOT_OK(env_->DeleteFile(CacheFileName(path_, it->first)),
+                  "Failed to delete persistent cache file");
+    }
+    files_.erase(it);
+  }
+
+  Env* const env_;
+  const std::string path_;
+  const size_t capacity_;
+  const size_t file_size_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, Location> index_;
+  std::map<uint64_t, CacheFile> files_;
+  // Content of the file that is being filled.
+  std::string buffer_;
+  uint64_t current_file_number_ = 0;
+  uint64_t next_file_number_ = 1;
+  size_t usage_ = 0;
+  // Numbers of sealed files that are not written to disk yet, in the order they were sealed.
+  std::deque<uint64_t> sealed_files_;
+  bool closing_ = false;
+  std::condition_variable write_cond_;
+  std::thread write_thread_;
+};
+
+} // namespace
+
+Status NewFilePersistentCache(
+    Env* env, const std::string& path, size_t capacity, size_t file_size,
+    std::shared_ptr<PersistentCache>* cache) {
+  auto result = std::make_shared<FilePersistentCache>(env, path, capacity, file_size);
+  RETURN_NOT_OK(result->Open());
+  *cache = std::move(result);
+  return Status::OK();
+}
+
+}  // namespace rocksdb
@@ -0,0 +1,125 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+
+#include "yb/rocksdb/env.h"
+#include "yb/rocksdb/persistent_cache.h"
+#include "yb/rocksdb/util/file_util.h"
+#include "yb/rocksdb/util/testharness.h"
+#include "yb/rocksdb/util/testutil.h"
+
+#include "yb/util/test_macros.h"
+
+namespace rocksdb {
+
+class PersistentCacheTest : public RocksDBTest {
+ public:
+  PersistentCacheTest() : env_(Env::Default()) {
+    path_ = test::TmpDir(env_) + "/persistent_cache";
+    EXPECT_OK(DeleteRecursively(env_, path_));
+  }
+
+  ~PersistentCacheTest() {
+    cache_.reset();
+    EXPECT_OK(DeleteRecursively(env_, path_));
+  }
+
+ protected:
+  void Open(size_t capacity, size_t file_size) {
+    cache_.reset();
+    ASSERT_OK(NewFilePersistentCache(env_, path_, capacity, file_size, &cache_));
+  }
+
+  static std::string Key(int i) {
+    return "key" + std::to_string(i);
+  }
+
+  static std::string Value(int i) {
+    return std::string(100, static_cast<char>('a' + i % 26)) + std::to_string(i);
+  }
+
+  void Insert(int i) {
+    const auto value = Value(i);
+    ASSERT_OK(cache_->Insert(Key(i), value.data(), value.size()));
+  }
+
+  // Returns true if the key is present with the expected value.
+  bool Lookup(int i) {
+    std::unique_ptr<char[]> data;
+    size_t size = 0;
+    auto status = cache_->Lookup(Key(i), &data, &size);
+    if (status.IsNotFound()) {
+      return false;
+    }
+    EXPECT_OK(status);
+    EXPECT_EQ(std::string(data.get(), size), Value(i));
+    return true;
+  }
+
+  Env* env_;
+  std::string path_;
+  std::shared_ptr<PersistentCache> cache_;
+};
+
+TEST_F(PersistentCacheTest, InsertLookupAndRestart) {
+  constexpr int kNumEntries = 100;
+  Open(1024 * 1024, 4096);
+  for (int i = 0; i != kNumEntries; ++i) {
+    ASSERT_FALSE(Lookup(i));
+    Insert(i);
+    ASSERT_TRUE(Lookup(i));
+  }
+  for (int i = 0; i != kNumEntries; ++i) {
+    ASSERT_TRUE(Lookup(i));
+  }
+  const auto usage = cache_->GetUsage();
+  ASSERT_GT(usage, 0);
+
+  // Entries, including ones in the file that was not sealed yet, survive restart.
+  Open(1024 * 1024, 4096);
+  ASSERT_EQ(cache_->GetUsage(), usage);
+  for (int i = 0; i != kNumEntries; ++i) {
+    ASSERT_TRUE(Lookup(i));
+  }
+  ASSERT_FALSE(Lookup(kNumEntries));
+}
+
+TEST_F(PersistentCacheTest, Eviction) {
+  constexpr size_t kCapacity = 10 * 1024;
+  constexpr size_t kFileSize = 2 * 1024;
+  constexpr int kNumEntries = 200;
+  Open(kCapacity, kFileSize);
+  for (int i = 0; i != kNumEntries; ++i) {
+    Insert(i);
+    ASSERT_LE(cache_->GetUsage(), kCapacity + kFileSize);
+  }
+  // The oldest entries are evicted, the most recent ones are still present.
+  ASSERT_FALSE(Lookup(0));
+  for (int i = kNumEntries - 10; i != kNumEntries; ++i) {
+    ASSERT_TRUE(Lookup(i));
+  }
+
+  // Evicted files are removed from disk.
+  Open(kCapacity, kFileSize);
+  ASSERT_LE(cache_->GetUsage(), kCapacity + kFileSize);
+  ASSERT_FALSE(Lookup(0));
+  ASSERT_TRUE(Lookup(kNumEntries - 1));
+}
+
+} // namespace rocksdb
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
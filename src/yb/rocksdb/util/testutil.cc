@@ -303,11 +303,6 @@ void RandomInitCFOptions(ColumnFamilyOptions* cf_opt, Random* rnd) {
 
 namespace {
 
-enum TestBoundaryUserValueTag {
-  TAG_INT_VALUE,
-  TAG_STRING_VALUE,
-};
-
 Slice EncodeValue(const int64_t &value) {
   return Slice(reinterpret_cast<const char *>(&value), sizeof(value));
 }
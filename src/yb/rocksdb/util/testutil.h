@@ -287,16 +287,23 @@ class StringSource: public RandomAccessFile {
 
   size_t memory_footprint() const override { LOG(FATAL) << "Not supported"; }
 
+  void Readahead(uint64_t offset, size_t n) const override {
+    total_readaheads_++;
+  }
+
   int total_reads() const { return total_reads_; }
 
   void set_total_reads(int tr) { total_reads_ = tr; }
 
+  int total_readaheads() const { return total_readaheads_; }
+
  private:
   std::string filename_ = "StringSource";
   std::string contents_;
   uint64_t uniq_id_;
   bool mmap_;
   mutable int total_reads_;
+  mutable int total_readaheads_ = 0;
 };
 
 class NullLogger : public Logger {
@@ -675,6 +682,13 @@ TableFactory* RandomTableFactory(Random* rnd, int pre_defined = -1);
 
 std::string RandomName(Random* rnd, const size_t len);
 
+// Tags of the user values provided by the boundary values extractor created by
+// MakeBoundaryValuesExtractor. The string value is the reversed user key.
+enum TestBoundaryUserValueTag {
+  TAG_INT_VALUE,
+  TAG_STRING_VALUE,
+};
+
 std::shared_ptr<BoundaryValuesExtractor> MakeBoundaryValuesExtractor();
 UserBoundaryValuePtr MakeIntBoundaryValue(int64_t value);
 UserBoundaryValuePtr MakeStringBoundaryValue(std::string value);
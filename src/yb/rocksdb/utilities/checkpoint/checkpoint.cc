@@ -32,6 +32,7 @@
 #include <inttypes.h>
 #include <algorithm>
 #include <string>
+#include <unordered_set>
 #include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/wal_manager.h"
 #include "yb/rocksdb/db.h"
@@ -46,10 +47,26 @@
 namespace rocksdb {
 namespace checkpoint {
 
+namespace {
+
+// Returns directory of the specified live table file, that could be located in any of db_paths.
+std::string TableFileDir(DB* db, const std::string& fname) {
+  const auto& db_paths = db->GetOptions().db_paths;
+  for (size_t i = 1; i < db_paths.size(); ++i) {
+    if (db->GetCheckpointEnv()->FileExists(db_paths[i].path + fname).ok()) {
+      return db_paths[i].path;
+    }
+  }
+  return db->GetName();
+}
+
+} // namespace
+
 // Builds an openable snapshot of RocksDB on the same disk, which
 // accepts an output directory on the same disk, and under the directory
 // (1) hard-linked SST files pointing to existing live SST files
 // SST files will be copied if output directory is on a different filesystem
+// SST files located in any of db_paths are placed directly in the output directory
 // (2) a copied manifest files and other files
 // The directory should not already exist and will be created by this API.
 // The directory will be an absolute path
@@ -61,6 +78,8 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
   uint64_t manifest_file_size = 0;
   uint64_t sequence_number = db->GetLatestSequenceNumber();
   bool same_fs = true;
+  // Source directories of table files, that are not on the same filesystem with checkpoint.
+  std::unordered_set<std::string> cross_fs_table_dirs;
   VectorLogPtr live_wal_files;
   bool delete_checkpoint_dir = false;
 
@@ -117,19 +136,25 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     // * if it's kDescriptorFile, limit the size to manifest_file_size
     // * always copy if cross-device link
     bool is_table_file = type == kTableFile || type == kTableSBlockFile;
-    if (is_table_file && same_fs) {
+    const std::string src_dir = is_table_file ? TableFileDir(db, src_fname) : db->GetName();
+    bool link_failed = !is_table_file || cross_fs_table_dirs.count(src_dir);
+    if (!link_failed) {
       RLOG(db->GetOptions().info_log, "Hard Linking %s", src_fname.c_str());
-      s = db->GetCheckpointEnv()->LinkFile(db->GetName() + src_fname,
+      s = db->GetCheckpointEnv()->LinkFile(src_dir + src_fname,
                                  full_private_path + src_fname);
       if (s.IsNotSupported()) {
-        same_fs = false;
+        cross_fs_table_dirs.insert(src_dir);
+        if (src_dir == db->GetName()) {
+          same_fs = false;
+        }
+        link_failed = true;
         s = Status::OK();
       }
     }
-    if (!is_table_file || !same_fs) {
+    if (link_failed) {
       RLOG(db->GetOptions().info_log, "Copying %s", src_fname.c_str());
       std::string dest_name = full_private_path + src_fname;
-      s = CopyFile(db->GetCheckpointEnv(), db->GetName() + src_fname, dest_name,
+      s = CopyFile(db->GetCheckpointEnv(), src_dir + src_fname, dest_name,
                    type == kDescriptorFile ? manifest_file_size : 0);
     }
   }
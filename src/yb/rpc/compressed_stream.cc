@@ -27,7 +27,10 @@
 #include "yb/rpc/outbound_data.h"
 #include "yb/rpc/refined_stream.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
 #include "yb/util/result.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
@@ -37,6 +40,37 @@ using namespace std::literals;
 DEFINE_int32(stream_compression_algo, 0, "Algorithm used for stream compression. "
                                          "0 - no compression, 1 - gzip, 2 - snappy, 3 - lz4.");
 
+DEFINE_int32(stream_compression_min_rtt_us, 0,
+             "Outbound connections whose round trip time, measured when the connection is "
+             "established, is less than this value are not compressed. So compression could be "
+             "used only for cross region links. 0 - compress all connections.");
+TAG_FLAG(stream_compression_min_rtt_us, advanced);
+TAG_FLAG(stream_compression_min_rtt_us, runtime);
+
+DEFINE_int32(stream_compression_min_message_size, 0,
+             "Messages smaller than this size are sent over gzip compressed stream without "
+             "compression. Snappy and lz4 are fast enough to always compress.");
+TAG_FLAG(stream_compression_min_message_size, advanced);
+TAG_FLAG(stream_compression_min_message_size, runtime);
+
+DEFINE_double(stream_compression_incompressible_ratio, 0.95,
+              "When recent messages of gzip compressed stream are compressed to more than this "
+              "fraction of their size, following messages are sent without compression. Every "
+              "few messages are still compressed to detect when payload becomes compressible.");
+TAG_FLAG(stream_compression_incompressible_ratio, advanced);
+TAG_FLAG(stream_compression_incompressible_ratio, runtime);
+
+METRIC_DEFINE_counter(
+    server, rpc_zlib_compression_bytes_saved, "Bytes saved by gzip RPC compression",
+    yb::MetricUnit::kBytes, "Difference between size of sent data and its gzip compressed size.");
+METRIC_DEFINE_counter(
+    server, rpc_snappy_compression_bytes_saved, "Bytes saved by snappy RPC compression",
+    yb::MetricUnit::kBytes,
+    "Difference between size of sent data and its snappy compressed size.");
+METRIC_DEFINE_counter(
+    server, rpc_lz4_compression_bytes_saved, "Bytes saved by lz4 RPC compression",
+    yb::MetricUnit::kBytes, "Difference between size of sent data and its lz4 compressed size.");
+
 namespace yb {
 namespace rpc {
 
@@ -46,6 +80,13 @@ namespace {
 
 class Compressor {
  public:
+  Compressor(const scoped_refptr<MetricEntity>& metric_entity,
+             const CounterPrototype& bytes_saved_prototype) {
+    if (metric_entity) {
+      bytes_saved_ = bytes_saved_prototype.Instantiate(metric_entity);
+    }
+  }
+
   virtual std::string ToString() const = 0;
 
   // Initialize compressor, required since we don't use exceptions to return error from ctor.
@@ -62,6 +103,16 @@ class Compressor {
   virtual OutboundDataPtr ConnectionHeader() = 0;
 
   virtual ~Compressor() = default;
+
+ protected:
+  void Compressed(size_t input_size, size_t output_size) {
+    if (bytes_saved_ && output_size < input_size) {
+      bytes_saved_->IncrementBy(input_size - output_size);
+    }
+  }
+
+ private:
+  scoped_refptr<Counter> bytes_saved_;
 };
 
 size_t EntrySize(const RefCntBuffer& buffer) {
@@ -135,7 +186,8 @@ class ZlibCompressor : public Compressor {
   static const char kId = 'G';
   static const int kIndex = 1;
 
-  explicit ZlibCompressor(MemTrackerPtr mem_tracker) {
+  ZlibCompressor(MemTrackerPtr mem_tracker, const scoped_refptr<MetricEntity>& metric_entity)
+      : Compressor(metric_entity, METRIC_rpc_zlib_compression_bytes_saved) {
   }
 
   ~ZlibCompressor() {
@@ -178,10 +230,22 @@ class ZlibCompressor : public Compressor {
 
   CHECKED_STATUS Compress(
       const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data) override {
-    RefCntBuffer output(deflateBound(&deflate_stream_, TotalLen(input)));
+    auto input_size = TotalLen(input);
+    auto level = ChooseLevel(input_size);
+    // Reserve space for data flushed by deflateParams, when compression level is changed.
+    RefCntBuffer output(
+        deflateBound(&deflate_stream_, input_size) + (level != level_ ? kParamsFlushReserve : 0));
     deflate_stream_.avail_out = static_cast<unsigned int>(output.size());
     deflate_stream_.next_out = output.udata();
 
+    if (level != level_) {
+      auto res = deflateParams(&deflate_stream_, level, Z_DEFAULT_STRATEGY);
+      if (res != Z_OK) {
+        return STATUS_FORMAT(RuntimeError, "Failed to change compression level: $0", res);
+      }
+      level_ = level;
+    }
+
     for (auto it = input.begin(); it != input.end();) {
       const auto& buf = *it++;
       deflate_stream_.next_in = const_cast<Bytef*>(buf.udata());
@@ -207,6 +271,11 @@ class ZlibCompressor : public Compressor {
     }
 
     output.Shrink(deflate_stream_.next_out - output.udata());
+    if (level != Z_NO_COMPRESSION && input_size != 0) {
+      auto ratio = static_cast<double>(output.size()) / input_size;
+      recent_ratio_ = recent_ratio_ < 0 ? ratio : (recent_ratio_ + ratio) / 2;
+    }
+    Compressed(input_size, output.size());
 
     // Send compressed data to underlying stream.
     return stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
@@ -232,10 +301,31 @@ class ZlibCompressor : public Compressor {
   }
 
  private:
+  // Incompressible stream compresses each kProbeInterval-th message, to detect when payload
+  // becomes compressible.
+  static constexpr size_t kProbeInterval = 16;
+  static constexpr size_t kParamsFlushReserve = 64;
+
+  int ChooseLevel(size_t input_size) {
+    if (static_cast<int64_t>(input_size) < FLAGS_stream_compression_min_message_size) {
+      return Z_NO_COMPRESSION;
+    }
+    if (recent_ratio_ > FLAGS_stream_compression_incompressible_ratio &&
+        ++messages_since_probe_ < kProbeInterval) {
+      return Z_NO_COMPRESSION;
+    }
+    messages_since_probe_ = 0;
+    return Z_DEFAULT_COMPRESSION;
+  }
+
   z_stream deflate_stream_;
   z_stream inflate_stream_;
   bool deflate_inited_ = false;
   bool inflate_inited_ = false;
+  int level_ = Z_DEFAULT_COMPRESSION;
+  // Compressed to original size ratio of recent compressed messages, negative if unknown.
+  double recent_ratio_ = -1;
+  size_t messages_since_probe_ = 0;
 };
 
 // Source implementation that provides input from range of buffers.
@@ -379,7 +469,8 @@ class SnappyCompressor : public Compressor {
   static constexpr int kIndex = 2;
   static constexpr size_t kHeaderLen = kSnappyHeaderLen;
 
-  explicit SnappyCompressor(MemTrackerPtr mem_tracker) {
+  SnappyCompressor(MemTrackerPtr mem_tracker, const scoped_refptr<MetricEntity>& metric_entity)
+      : Compressor(metric_entity, METRIC_rpc_snappy_compression_bytes_saved) {
   }
 
   ~SnappyCompressor() {
@@ -401,6 +492,8 @@ class SnappyCompressor : public Compressor {
       const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data) override {
     RangeSource<SmallRefCntBuffers::const_iterator> source(input.begin(), input.end());
     auto input_size = source.Available();
+    auto total_input_size = input_size;
+    size_t total_output_size = 0;
     bool stop = false;
     while (!stop) {
       // Split input into chunks of size kSnappyMaxChunkSize or less.
@@ -416,12 +509,14 @@ class SnappyCompressor : public Compressor {
       auto compressed_len = snappy::Compress(&source, &sink);
       BigEndian::Store16(output.data(), compressed_len);
       output.Shrink(kHeaderLen + compressed_len);
+      total_output_size += output.size();
       RETURN_NOT_OK(stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
           std::move(output),
           // We processed last buffer, attach data to it, so it will be notified when this buffer
           // is transferred.
           stop ? std::move(data) : nullptr)));
     }
+    Compressed(total_input_size, total_output_size);
     return Status::OK();
   }
 
@@ -663,7 +758,8 @@ class LZ4Compressor : public Compressor {
   static constexpr int kIndex = 3;
   static constexpr size_t kHeaderLen = kLZ4HeaderLen;
 
-  explicit LZ4Compressor(MemTrackerPtr mem_tracker) {
+  LZ4Compressor(MemTrackerPtr mem_tracker, const scoped_refptr<MetricEntity>& metric_entity)
+      : Compressor(metric_entity, METRIC_rpc_lz4_compression_bytes_saved) {
     if (mem_tracker) {
       consumption_ = ScopedTrackedConsumption(std::move(mem_tracker), 2 * kLZ4BufferSize);
     }
@@ -683,6 +779,7 @@ class LZ4Compressor : public Compressor {
 
   CHECKED_STATUS Compress(
       const SmallRefCntBuffers& input, RefinedStream* stream, OutboundDataPtr data) override {
+    size_t total_output_size = 0;
     // Increment iterator in loop body to be able to check whether it is last iteration or not.
     for (auto input_it = input.begin(); input_it != input.end();) {
       Slice input_slice = input_it->AsSlice();
@@ -704,6 +801,7 @@ class LZ4Compressor : public Compressor {
         }
         BigEndian::Store16(output.data(), res);
         output.Shrink(kHeaderLen + res);
+        total_output_size += output.size();
         RETURN_NOT_OK(stream->SendToLower(std::make_shared<SingleBufferOutboundData>(
             std::move(output),
             // We processed last buffer, attach data to it, so it will be notified when this buffer
@@ -711,6 +809,7 @@ class LZ4Compressor : public Compressor {
             input_slice.empty() && input_it == input.end() ? std::move(data) : nullptr)));
       }
     }
+    Compressed(TotalLen(input), total_output_size);
 
     return Status::OK();
   }
@@ -733,9 +832,11 @@ class LZ4Compressor : public Compressor {
 
 #define YB_CREATE_COMPRESSOR_CASE(r, data, name) \
   case BOOST_PP_CAT(name, Compressor)::data: \
-      return std::make_unique<BOOST_PP_CAT(name, Compressor)>(std::move(mem_tracker));
+      return std::make_unique<BOOST_PP_CAT(name, Compressor)>( \
+          std::move(mem_tracker), metric_entity);
 
-std::unique_ptr<Compressor> CreateCompressor(char sign, MemTrackerPtr mem_tracker) {
+std::unique_ptr<Compressor> CreateCompressor(
+    char sign, MemTrackerPtr mem_tracker, const scoped_refptr<MetricEntity>& metric_entity) {
   switch (sign) {
 BOOST_PP_SEQ_FOR_EACH(YB_CREATE_COMPRESSOR_CASE, kId, YB_COMPRESSION_ALGORITHMS)
     default:
@@ -743,7 +844,8 @@ BOOST_PP_SEQ_FOR_EACH(YB_CREATE_COMPRESSOR_CASE, kId, YB_COMPRESSION_ALGORITHMS)
   }
 }
 
-std::unique_ptr<Compressor> CreateOutboundCompressor(MemTrackerPtr mem_tracker) {
+std::unique_ptr<Compressor> CreateOutboundCompressor(
+    MemTrackerPtr mem_tracker, const scoped_refptr<MetricEntity>& metric_entity) {
   auto algo = FLAGS_stream_compression_algo;
   if (!algo) {
     return nullptr;
@@ -758,7 +860,8 @@ BOOST_PP_SEQ_FOR_EACH(YB_CREATE_COMPRESSOR_CASE, kIndex, YB_COMPRESSION_ALGORITH
 
 class CompressedRefiner : public StreamRefiner {
  public:
-  CompressedRefiner() = default;
+  explicit CompressedRefiner(const scoped_refptr<MetricEntity>& metric_entity)
+      : metric_entity_(metric_entity) {}
 
  private:
   void Start(RefinedStream* stream) override {
@@ -777,7 +880,7 @@ class CompressedRefiner : public StreamRefiner {
 
     const auto* bytes = static_cast<const uint8_t*>(data[0].iov_base);
     if (bytes[0] == 'Y' && bytes[1] == 'B') {
-      compressor_ = CreateCompressor(bytes[2], stream_->buffer_tracker());
+      compressor_ = CreateCompressor(bytes[2], stream_->buffer_tracker(), metric_entity_);
       if (compressor_) {
         RETURN_NOT_OK(compressor_->Init());
         RETURN_NOT_OK(stream_->StartHandshake());
@@ -798,7 +901,9 @@ class CompressedRefiner : public StreamRefiner {
 
   CHECKED_STATUS Handshake() override {
     if (stream_->local_side() == LocalSide::kClient) {
-      compressor_ = CreateOutboundCompressor(stream_->buffer_tracker());
+      if (ShouldCompress()) {
+        compressor_ = CreateOutboundCompressor(stream_->buffer_tracker(), metric_entity_);
+      }
       if (!compressor_) {
         return stream_->Established(RefinedStreamState::kDisabled);
       }
@@ -827,6 +932,22 @@ class CompressedRefiner : public StreamRefiner {
     return stream_->LogPrefix();
   }
 
+  // Low latency links usually have enough bandwidth, so compression would only add CPU overhead.
+  bool ShouldCompress() {
+    auto min_rtt_us = FLAGS_stream_compression_min_rtt_us;
+    if (min_rtt_us <= 0) {
+      return true;
+    }
+    auto rtt = stream_->RoundTripTime();
+    if (!rtt.ok()) {
+      VLOG_WITH_PREFIX(2) << "Failed to get round trip time: " << rtt.status();
+      return true;
+    }
+    VLOG_WITH_PREFIX(4) << "Round trip time: " << *rtt;
+    return rtt->ToMicroseconds() >= min_rtt_us;
+  }
+
+  scoped_refptr<MetricEntity> metric_entity_;
   RefinedStream* stream_ = nullptr;
   std::unique_ptr<Compressor> compressor_ = nullptr;
 };
@@ -842,7 +963,7 @@ StreamFactoryPtr CompressedStreamFactory(
     StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker) {
   return std::make_shared<RefinedStreamFactory>(
       std::move(lower_layer_factory), buffer_tracker, [](const StreamCreateData& data) {
-    return std::make_unique<CompressedRefiner>();
+    return std::make_unique<CompressedRefiner>(data.metric_entity);
   });
 }
 
@@ -158,6 +158,10 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // it gets handled.
   MonoDelta GetTimeInQueue() const;
 
+  MonoTime ReceiveTime() const {
+    return timing_.time_received;
+  }
+
   ThreadPoolTask* BindTask(InboundCallHandler* handler);
 
   void ResetCallProcessedListener() {
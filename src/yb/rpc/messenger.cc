@@ -93,6 +93,24 @@ DEFINE_int64(outbound_rpc_memory_limit, 0, "Outbound RPC memory limit");
 DEFINE_int32(rpc_queue_limit, 10000, "Queue limit for rpc server");
 DEFINE_int32(rpc_workers_limit, 1024, "Workers limit for rpc server");
 
+DEFINE_bool(rpc_sharded_thread_pools, false,
+            "Split RPC worker thread pools into one shard per reactor. Calls received by a reactor "
+            "are queued to and handled by workers of its own shard, instead of a single queue "
+            "shared by all reactors. Idle workers of other shards take calls over when all "
+            "workers of the shard are busy.");
+TAG_FLAG(rpc_sharded_thread_pools, advanced);
+
+DEFINE_bool(rpc_pin_threads_to_cpus, false,
+            "Pin each reactor thread, and workers of its thread pool shard when "
+            "rpc_sharded_thread_pools is set, to the CPU with the same index.");
+TAG_FLAG(rpc_pin_threads_to_cpus, advanced);
+
+DEFINE_bool(rpc_thread_pool_work_stealing, false,
+            "Tasks submitted by an RPC worker, e.g. callbacks, go to a local queue of this worker "
+            "instead of the shared queue, and idle workers steal tasks from local queues of "
+            "other workers.");
+TAG_FLAG(rpc_thread_pool_work_stealing, advanced);
+
 DEFINE_int32(socket_receive_buffer_size, 0, "Socket receive buffer size, 0 to use default");
 
 namespace yb {
@@ -393,9 +411,9 @@ rpc::ThreadPool& Messenger::ThreadPool(ServicePriority priority) {
       if (high_priority_thread_pool) {
         return *high_priority_thread_pool;
       }
-      const ThreadPoolOptions& options = normal_thread_pool_->options();
-      high_priority_thread_pool_.reset(new rpc::ThreadPool(
-          name_ + "-high-pri", options.queue_limit, options.max_workers));
+      ThreadPoolOptions options = normal_thread_pool_->options();
+      options.name = name_ + "-high-pri";
+      high_priority_thread_pool_.reset(new rpc::ThreadPool(std::move(options)));
       return *high_priority_thread_pool_.get();
   }
   FATAL_INVALID_ENUM_VALUE(ServicePriority, priority);
@@ -551,7 +569,11 @@ Messenger::Messenger(const MessengerBuilder &bld)
       metric_entity_(bld.metric_entity_),
       io_thread_pool_(name_, FLAGS_io_thread_pool_size),
       scheduler_(&io_thread_pool_.io_service()),
-      normal_thread_pool_(new rpc::ThreadPool(name_, bld.queue_limit_, bld.workers_limit_)),
+      normal_thread_pool_(new rpc::ThreadPool(
+          name_, bld.queue_limit_, bld.workers_limit_,
+          FLAGS_rpc_sharded_thread_pools ? static_cast<size_t>(bld.num_reactors_) : 1,
+          FLAGS_rpc_sharded_thread_pools && FLAGS_rpc_pin_threads_to_cpus,
+          FLAGS_rpc_thread_pool_work_stealing)),
       resolver_(new DnsResolver(&io_thread_pool_.io_service())),
       rpc_metrics_(std::make_shared<RpcMetrics>(bld.metric_entity_)),
       num_connections_to_server_(bld.num_connections_to_server_) {
@@ -42,6 +42,8 @@ using std::shared_ptr;
 using namespace std::literals;
 using namespace std::placeholders;
 
+DECLARE_int32(rpc_reactor_busy_poll_us);
+
 namespace yb {
 namespace rpc {
 
@@ -123,5 +125,26 @@ TEST_F(ReactorTest, TestReschedulesOnSameReactorThread) {
   latch_.Wait();
 }
 
+TEST_F(ReactorTest, TestBusyPoll) {
+  constexpr int kNumTasks = 20;
+  FLAGS_rpc_reactor_busy_poll_us = 1000;
+  AutoShutdownMessengerHolder messenger(
+      CreateMessenger("busy_poll_messenger", MakeMessengerOptions()).release());
+
+  // Tasks are spread wider than the busy poll interval, so some of them are handled while the
+  // reactor spins and others after it blocks in epoll.
+  latch_.Reset(kNumTasks);
+  for (int i = 0; i != kNumTasks; ++i) {
+    auto task_id = messenger->ScheduleOnReactor(
+        std::bind(&ReactorTest::ScheduledTask, this, _1, Status::OK()), i * 2ms,
+        SOURCE_LOCATION(), nullptr /* messenger */);
+    ASSERT_EQ(task_id, 0);
+  }
+  latch_.Wait();
+
+  // Busy polling reactor should stop on shutdown.
+  messenger->Shutdown();
+}
+
 } // namespace rpc
 } // namespace yb
@@ -49,6 +49,7 @@
 
 #include "yb/gutil/ref_counted.h"
 #include "yb/gutil/stringprintf.h"
+#include "yb/gutil/sysinfo.h"
 
 #include "yb/rpc/connection.h"
 #include "yb/rpc/connection_context.h"
@@ -56,14 +57,17 @@
 #include "yb/rpc/rpc_controller.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/server_event.h"
+#include "yb/rpc/thread_pool.h"
 
 #include "yb/util/atomic.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/errno.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/metric_entity.h"
+#include "yb/util/metrics.h"
 #include "yb/util/monotime.h"
 #include "yb/util/net/socket.h"
 #include "yb/util/scope_exit.h"
@@ -79,10 +83,24 @@ using namespace std::literals;
 
 DEFINE_uint64(rpc_read_buffer_size, 0,
               "RPC connection read buffer size. 0 to auto detect.");
+DEFINE_int32(rpc_reactor_busy_poll_us, 0,
+             "If positive, a reactor thread keeps polling for events without blocking for this "
+             "number of microseconds after the last handled event, before it sleeps in epoll. "
+             "Lowers the latency of waking up for the next call at the cost of CPU.");
+TAG_FLAG(rpc_reactor_busy_poll_us, advanced);
+DECLARE_bool(rpc_pin_threads_to_cpus);
 DECLARE_string(local_ip_for_outbound_sockets);
 DECLARE_int32(num_connections_to_server);
 DECLARE_int32(socket_receive_buffer_size);
 
+METRIC_DEFINE_simple_counter(
+    server, rpc_reactor_busy_poll_work_time,
+    "Time reactors in busy poll mode spent handling events", yb::MetricUnit::kMicroseconds);
+METRIC_DEFINE_simple_counter(
+    server, rpc_reactor_busy_poll_spin_time,
+    "Time reactors in busy poll mode spent polling without handling events",
+    yb::MetricUnit::kMicroseconds);
+
 namespace yb {
 namespace rpc {
 
@@ -135,6 +153,7 @@ Reactor::Reactor(Messenger* messenger,
                  int index,
                  const MessengerBuilder &bld)
     : messenger_(messenger),
+      index_(index),
       name_(StringPrintf("%s_R%03d", messenger->name().c_str(), index)),
       log_prefix_(name_ + ": "),
       loop_(kDefaultLibEvFlags),
@@ -175,6 +194,13 @@ Status Reactor::Init() {
   timer_.start(ToSeconds(coarse_timer_granularity_),
                ToSeconds(coarse_timer_granularity_));
 
+  if (FLAGS_rpc_reactor_busy_poll_us > 0 && messenger_->metric_entity()) {
+    busy_poll_work_time_metric_ =
+        METRIC_rpc_reactor_busy_poll_work_time.Instantiate(messenger_->metric_entity());
+    busy_poll_spin_time_metric_ =
+        METRIC_rpc_reactor_busy_poll_spin_time.Instantiate(messenger_->metric_entity());
+  }
+
   // Create Reactor thread.
   const std::string group_name = messenger_->name() + "_reactor";
   return yb::Thread::Create(group_name, group_name, &Reactor::RunThread, this, &thread_);
@@ -437,6 +463,18 @@ void Reactor::TimerHandler(ev::timer &watcher, int revents) {
   cur_time_ = now;
 
   ScanIdleConnections();
+  UpdateBusyPollMetrics();
+}
+
+void Reactor::UpdateBusyPollMetrics() {
+  if (busy_poll_work_time_metric_ && busy_poll_work_time_ != MonoDelta::kZero) {
+    busy_poll_work_time_metric_->IncrementBy(busy_poll_work_time_.ToMicroseconds());
+  }
+  if (busy_poll_spin_time_metric_ && busy_poll_spin_time_ != MonoDelta::kZero) {
+    busy_poll_spin_time_metric_->IncrementBy(busy_poll_spin_time_.ToMicroseconds());
+  }
+  busy_poll_work_time_ = MonoDelta::kZero;
+  busy_poll_spin_time_ = MonoDelta::kZero;
 }
 
 void Reactor::ScanIdleConnections() {
@@ -494,11 +532,50 @@ bool Reactor::IsCurrentThreadOrStartedClosing() const {
 void Reactor::RunThread() {
   ThreadRestrictions::SetWaitAllowed(false);
   ThreadRestrictions::SetIOAllowed(false);
+  // Calls received by this reactor are handled by the matching shard of sharded thread pools.
+  ThreadPool::SetCurrentThreadShard(index_);
+  if (FLAGS_rpc_pin_threads_to_cpus) {
+    WARN_NOT_OK(PinCurrentThreadToCpu(index_ % base::NumCPUs()), "Failed to pin reactor");
+  }
   DVLOG_WITH_PREFIX(6) << "Calling Reactor::RunThread()...";
-  loop_.run(/* flags */ 0);
+  if (FLAGS_rpc_reactor_busy_poll_us > 0) {
+    RunBusyPollLoop();
+  } else {
+    loop_.run(/* flags */ 0);
+  }
   VLOG_WITH_PREFIX(1) << "thread exiting.";
 }
 
+void Reactor::RunBusyPollLoop() {
+  const auto busy_poll_interval = MonoDelta::FromMicroseconds(FLAGS_rpc_reactor_busy_poll_us);
+  ev_set_userdata(loop_.raw_loop, this);
+  ev_set_invoke_pending_cb(loop_.raw_loop, &Reactor::InvokePendingCallback);
+
+  last_event_time_ = MonoTime::Now();
+  // CheckReadyToStop marks the reactor as closed before breaking the loop.
+  while (state_.load(std::memory_order_acquire) != ReactorState::kClosed) {
+    auto start = MonoTime::Now();
+    if (start - last_event_time_ >= busy_poll_interval) {
+      loop_.run(ev::ONCE);
+      continue;
+    }
+    auto work_time_before = busy_poll_work_time_;
+    loop_.run(ev::NOWAIT);
+    busy_poll_spin_time_ += (MonoTime::Now() - start) - (busy_poll_work_time_ - work_time_before);
+  }
+}
+
+void Reactor::InvokePendingCallback(struct ev_loop* loop) {
+  if (ev_pending_count(loop) == 0) {
+    return;
+  }
+  auto* reactor = static_cast<Reactor*>(ev_userdata(loop));
+  auto start = MonoTime::Now();
+  ev_invoke_pending(loop);
+  reactor->last_event_time_ = MonoTime::Now();
+  reactor->busy_poll_work_time_ += reactor->last_event_time_ - start;
+}
+
 namespace {
 
 Result<Socket> CreateClientSocket(const Endpoint& remote) {
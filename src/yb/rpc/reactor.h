@@ -63,6 +63,7 @@
 #include "yb/util/condition_variable.h"
 #include "yb/util/countdown_latch.h"
 #include "yb/util/locks.h"
+#include "yb/util/metrics_fwd.h"
 #include "yb/util/monotime.h"
 #include "yb/util/mutex.h"
 #include "yb/util/net/socket.h"
@@ -326,6 +327,16 @@ class Reactor {
   // libev callback for handling timer events in our epoll thread.
   void TimerHandler(ev::timer &watcher, int revents); // NOLINT
 
+  // Runs the event loop, spinning for rpc_reactor_busy_poll_us after the last handled event
+  // before blocking in epoll.
+  void RunBusyPollLoop();
+
+  // libev callback that invokes pending watchers in busy poll mode, measuring time spent on them.
+  static void InvokePendingCallback(struct ev_loop* loop);
+
+  // Flushes busy poll times accumulated by the reactor thread to metrics.
+  void UpdateBusyPollMetrics();
+
   // This may be called from another thread.
   const std::string &name() const { return name_; }
 
@@ -445,6 +456,9 @@ class Reactor {
   // parent messenger
   Messenger* const messenger_;
 
+  // Index of the reactor in the messenger.
+  const int index_;
+
   const std::string name_;
 
   const std::string log_prefix_;
@@ -523,6 +537,14 @@ class Reactor {
 
   // Number of outbound connections to create per each destination server address.
   int num_connections_to_server_;
+
+  // Busy poll state, only accessed in the reactor thread.
+  MonoTime last_event_time_;
+  MonoDelta busy_poll_work_time_ = MonoDelta::kZero;
+  MonoDelta busy_poll_spin_time_ = MonoDelta::kZero;
+
+  scoped_refptr<Counter> busy_poll_work_time_metric_;
+  scoped_refptr<Counter> busy_poll_spin_time_metric_;
 };
 
 }  // namespace rpc
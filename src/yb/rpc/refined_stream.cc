@@ -16,6 +16,7 @@
 #include "yb/rpc/rpc_util.h"
 
 #include "yb/util/logging.h"
+#include "yb/util/monotime.h"
 #include "yb/util/result.h"
 #include "yb/util/status_format.h"
 
@@ -57,6 +58,10 @@ const Endpoint& RefinedStream::Remote() const {
   return lower_stream_->Remote();
 }
 
+Result<MonoDelta> RefinedStream::RoundTripTime() const {
+  return lower_stream_->RoundTripTime();
+}
+
 const Endpoint& RefinedStream::Local() const {
   return lower_stream_->Local();
 }
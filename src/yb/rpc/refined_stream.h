@@ -58,6 +58,7 @@ class RefinedStream : public Stream, public StreamContext {
   void DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) override;
   const Endpoint& Remote() const override;
   const Endpoint& Local() const override;
+  Result<MonoDelta> RoundTripTime() const override;
   CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
   void Shutdown(const Status& status) override;
   Result<size_t> Send(OutboundDataPtr data) override;
@@ -79,6 +79,7 @@ METRIC_DECLARE_histogram(rpc_incoming_queue_time);
 METRIC_DECLARE_counter(tcp_bytes_sent);
 METRIC_DECLARE_counter(tcp_bytes_received);
 METRIC_DECLARE_counter(rpcs_timed_out_early_in_queue);
+METRIC_DECLARE_counter(rpc_secure_stream_ssl_writes);
 
 DEFINE_int32(rpc_test_connection_keepalive_num_iterations, 1,
   "Number of iterations in TestRpc.TestConnectionKeepalive");
@@ -89,6 +90,8 @@ DECLARE_bool(enable_rpc_keepalive);
 DECLARE_int32(num_connections_to_server);
 DECLARE_int64(rpc_throttle_threshold_bytes);
 DECLARE_int32(stream_compression_algo);
+DECLARE_int32(stream_compression_min_message_size);
+DECLARE_int32(stream_compression_min_rtt_us);
 DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_string(vmodule);
 DECLARE_uint64(rpc_connection_timeout_ms);
@@ -1210,6 +1213,33 @@ TEST_F(TestRpcSecure, CantAllocateReadBuffer) {
   RunSecureTest(&TestCantAllocateReadBuffer, SetupServerForTestCantAllocateReadBuffer());
 }
 
+// Check that small buffers of a message are encrypted with a single SSL_write.
+TEST_F(TestRpcSecure, CoalesceSmallBuffers) {
+  TestServer server(CreateSecureMessenger("TestServer", kDefaultServerMessengerOptions));
+  ASSERT_OK(server.RegisterService(std::make_unique<GenericCalculatorService>(metric_entity())));
+  ASSERT_OK(server.Start());
+
+  auto client_messenger = rpc::CreateAutoShutdownMessengerHolder(CreateSecureMessenger("Client"));
+  Proxy proxy(
+      client_messenger.get(), HostPort::FromBoundEndpoint(server.bound_endpoint()),
+      SecureStreamProtocol());
+
+  // Establish the connection.
+  ASSERT_NO_FATALS(DoTestSidecar(&proxy, {123, 456}));
+
+  auto ssl_writes = ASSERT_RESULT(GetCounter(metric_entity(), METRIC_rpc_secure_stream_ssl_writes));
+  auto ssl_writes_before = ssl_writes->value();
+  constexpr int kCalls = 10;
+  for (int i = 0; i != kCalls; ++i) {
+    ASSERT_NO_FATALS(DoTestSidecar(&proxy, {123, 456}));
+  }
+  // Request is sent as a single buffer. Response header and its sidecars buffer should be
+  // coalesced.
+  ASSERT_EQ(ssl_writes->value() - ssl_writes_before, 2 * kCalls);
+
+  server.Shutdown();
+}
+
 class TestRpcCompression : public RpcTestBase, public testing::WithParamInterface<int> {
  public:
   void SetUp() override {
@@ -1258,6 +1288,25 @@ TEST_P(TestRpcCompression, ConcurrentOps) {
   RunCompressionTest(&TestConcurrentOps);
 }
 
+TEST_P(TestRpcCompression, BypassSmallMessages) {
+  // Mix of messages that are sent with and without compression over the same stream.
+  FLAGS_stream_compression_min_message_size = 8_KB;
+  RunCompressionTest([](CalculatorServiceProxy* proxy) {
+    TestManyOps(proxy);
+    TestBigOp(proxy);
+    TestSimple(proxy);
+  });
+}
+
+TEST_P(TestRpcCompression, LowLatencyConnection) {
+  // Loopback round trip time is way below one second, so connections should not be compressed.
+  FLAGS_stream_compression_min_rtt_us = 1000000;
+  RunCompressionTest([](CalculatorServiceProxy* proxy) {
+    TestSimple(proxy);
+    TestBigOp(proxy);
+  });
+}
+
 TEST_P(TestRpcCompression, CantAllocateReadBuffer) {
   RunCompressionTest(&TestCantAllocateReadBuffer, SetupServerForTestCantAllocateReadBuffer());
 }
@@ -60,7 +60,10 @@
 #include "yb/util/user.h"
 
 DEFINE_bool(is_panic_test_child, false, "Used by TestRpcPanic");
+DECLARE_bool(rpc_enable_priority_queues);
 DECLARE_bool(socket_inject_short_recvs);
+DECLARE_int64(rpc_max_queue_latency_ms);
+DECLARE_string(rpc_high_priority_methods);
 DECLARE_int32(rpc_slow_query_threshold_ms);
 DECLARE_int32(TEST_delay_connect_ms);
 
@@ -545,6 +548,76 @@ TEST_F(RpcStubTest, TestDontHandleTimedOutCalls) {
   ASSERT_EQ(1, timed_out_in_queue->value());
 }
 
+class RpcStubPriorityTest : public RpcStubTest {
+ public:
+  void SetUp() override {
+    FLAGS_rpc_enable_priority_queues = true;
+    FLAGS_rpc_high_priority_methods = "Add";
+    RpcStubTest::SetUp();
+  }
+
+ protected:
+  // Sends enough sleep calls to keep the worker threads busy for a few seconds.
+  void OccupyWorkers(std::vector<std::unique_ptr<AsyncSleep>>* sleeps, CountDownLatch* latch) {
+    CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
+    for (size_t i = 0; i != sleeps->size(); ++i) {
+      auto& sleep = (*sleeps)[i];
+      sleep = std::make_unique<AsyncSleep>();
+      sleep->rpc.set_timeout(30s);
+      sleep->req.set_sleep_micros(500 * 1000);
+      p.SleepAsync(sleep->req, &sleep->resp, &sleep->rpc, [latch]() { latch->CountDown(); });
+    }
+  }
+};
+
+TEST_F(RpcStubPriorityTest, HighPriorityCallOvertakesQueue) {
+  std::vector<std::unique_ptr<AsyncSleep>> sleeps(client_messenger_->max_concurrent_requests() * 8);
+  CountDownLatch latch(sleeps.size());
+  OccupyWorkers(&sleeps, &latch);
+
+  // Sleep calls queued in FIFO order would keep the queue busy for about 4 seconds, but the high
+  // priority call waits only until the first worker is free.
+  CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
+  RpcController controller;
+  controller.set_timeout(2s);
+  rpc_test::AddRequestPB req;
+  req.set_x(10);
+  req.set_y(20);
+  rpc_test::AddResponsePB resp;
+  ASSERT_OK(p.Add(req, &resp, &controller));
+  ASSERT_EQ(30, resp.result());
+
+  latch.Wait();
+}
+
+TEST_F(RpcStubPriorityTest, ShedByQueueLatency) {
+  FLAGS_rpc_max_queue_latency_ms = 100;
+  std::vector<std::unique_ptr<AsyncSleep>> sleeps(client_messenger_->max_concurrent_requests() * 8);
+  CountDownLatch latch(sleeps.size());
+  OccupyWorkers(&sleeps, &latch);
+  std::this_thread::sleep_for(300ms);
+
+  CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
+  RpcController controller;
+  controller.set_timeout(10s);
+  SleepRequestPB req;
+  req.set_sleep_micros(1000);
+  SleepResponsePB resp;
+  auto status = p.Sleep(req, &resp, &controller);
+  ASSERT_NOK(status);
+  ASSERT_STR_CONTAINS(status.ToString(), "wait in the queue longer than");
+
+  // High priority calls are not shed.
+  controller.Reset();
+  rpc_test::AddRequestPB add_req;
+  add_req.set_x(1);
+  add_req.set_y(2);
+  rpc_test::AddResponsePB add_resp;
+  ASSERT_OK(p.Add(add_req, &add_resp, &controller));
+
+  latch.Wait();
+}
+
 TEST_F(RpcStubTest, TestDumpCallsInFlight) {
   CountDownLatch latch(1);
   CalculatorServiceProxy p(proxy_cache_.get(), server_hostport_);
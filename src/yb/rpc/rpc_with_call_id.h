@@ -45,6 +45,12 @@ class ConnectionContextWithCallId : public ConnectionContextBase {
     return processed_call_count_.load(std::memory_order_acquire);
   }
 
+  // Number of calls received on this connection that are not processed yet. Should be invoked
+  // from the reactor thread of the connection.
+  size_t NumCallsBeingHandled() const {
+    return calls_being_handled_.size();
+  }
+
  private:
   virtual uint64_t ExtractCallId(InboundCall* call) = 0;
   void ListenIdle(IdleListener listener) override { idle_listener_ = std::move(listener); }
@@ -15,6 +15,8 @@
 
 #include "yb/rpc/rpc_with_queue.h"
 
+#include <utility>
+
 #include "yb/gutil/casts.h"
 
 #include "yb/rpc/connection.h"
@@ -105,7 +107,7 @@ void ConnectionContextWithQueue::CallProcessed(InboundCall* call) {
     idle_listener_();
   }
 
-  if (!could_enqueue && can_enqueue()) {
+  if ((!could_enqueue && can_enqueue()) || std::exchange(calls_deferred_, false)) {
     call->connection()->ParseReceived();
   }
 }
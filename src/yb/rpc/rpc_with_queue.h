@@ -82,6 +82,17 @@ class ConnectionContextWithQueue : public ConnectionContextBase {
 
   void Enqueue(std::shared_ptr<QueueableInboundCall> call);
 
+  // Whether a call enqueued now would have to wait for calls that are already being processed.
+  bool all_call_slots_busy() const {
+    return calls_queue_.size() >= max_concurrent_calls_;
+  }
+
+  // Notifies that received data was left unparsed because all call slots are busy, so it should
+  // be parsed again when the next call is processed.
+  void CallsDeferred() {
+    calls_deferred_ = true;
+  }
+
   uint64_t ProcessedCallCount() override {
     return processed_call_count_.load(std::memory_order_acquire);
   }
@@ -103,6 +114,7 @@ class ConnectionContextWithQueue : public ConnectionContextBase {
   const size_t max_queued_bytes_;
   size_t replies_being_sent_ = 0;
   size_t queued_bytes_ = 0;
+  bool calls_deferred_ = false;
 
   // Calls that are being processed by this connection/context.
   // At the top or queue there are replies_being_sent_ calls, for which we are sending reply.
@@ -28,8 +28,12 @@
 
 #include "yb/util/enums.h"
 #include "yb/util/errno.h"
+#include "yb/util/faststring.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
 
 using namespace std::literals;
@@ -48,6 +52,18 @@ DEFINE_string(cipher_list, "",
 DEFINE_string(ciphersuites, "",
               "Define the available TLSv1.3 ciphersuites.");
 
+DEFINE_uint64(secure_stream_bio_buffer_size, 0,
+              "Size of buffers used to pass encrypted data between OpenSSL and the connection. "
+              "Bigger buffers let big messages be encrypted and sent in fewer steps, but are "
+              "allocated for every secure connection. 0 means the OpenSSL default of 17KB.");
+TAG_FLAG(secure_stream_bio_buffer_size, advanced);
+
+METRIC_DEFINE_counter(
+    server, rpc_secure_stream_ssl_writes, "Secure RPC stream SSL writes",
+    yb::MetricUnit::kOperations,
+    "Number of SSL_write calls made by secure RPC streams. Small buffers of a sent message are "
+    "passed to a single call.");
+
 #define YB_RPC_SSL_TYPE_DEFINE(name) \
   void BOOST_PP_CAT(name, Free)::operator()(name* value) const { \
     BOOST_PP_CAT(name, _free)(value); \
@@ -362,7 +378,11 @@ namespace {
 class SecureRefiner : public StreamRefiner {
  public:
   SecureRefiner(const SecureContext& context, const StreamCreateData& data)
-    : secure_context_(context), remote_hostname_(data.remote_hostname) {
+    : secure_context_(context), remote_hostname_(data.remote_hostname),
+      mem_tracker_(data.mem_tracker) {
+    if (data.metric_entity) {
+      ssl_writes_ = METRIC_rpc_secure_stream_ssl_writes.Instantiate(data.metric_entity);
+    }
   }
 
  private:
@@ -391,6 +411,8 @@ class SecureRefiner : public StreamRefiner {
   bool MatchUid(X509* cert, GENERAL_NAMES* gens);
   bool MatchUidEntry(const Slice& value, const char* name);
   Result<bool> WriteEncrypted(OutboundDataPtr data);
+  CHECKED_STATUS WriteToSsl(Slice slice);
+  CHECKED_STATUS FlushCoalesced();
   void DecryptReceived();
 
   CHECKED_STATUS Established(RefinedStreamState state) {
@@ -406,44 +428,86 @@ class SecureRefiner : public StreamRefiner {
 
   const SecureContext& secure_context_;
   const std::string remote_hostname_;
+  MemTrackerPtr mem_tracker_;
+  scoped_refptr<Counter> ssl_writes_;
   RefinedStream* stream_ = nullptr;
   std::vector<std::string> certificate_entries_;
 
   BIOPtr bio_;
   detail::SSLPtr ssl_;
   Status verification_status_;
+
+  // Small buffers of the message being sent, accumulated to be encrypted into a single record.
+  faststring coalesced_;
+
+  // Memory of the BIO pair buffers.
+  ScopedTrackedConsumption bio_consumption_;
 };
 
+namespace {
+
+// Buffers smaller than this, like call headers, are coalesced instead of being encrypted into
+// separate records, which have fixed overhead.
+constexpr size_t kMaxCoalescedBufferSize = 4_KB;
+// Max TLS record plain text size.
+constexpr size_t kMaxCoalescedSize = 16_KB;
+
+} // namespace
+
 Status SecureRefiner::Send(OutboundDataPtr data) {
   boost::container::small_vector<RefCntBuffer, 10> queue;
   data->Serialize(&queue);
   for (const auto& buf : queue) {
-    Slice slice(buf.data(), buf.size());
-    for (;;) {
-      int slice_size = narrow_cast<int>(slice.size());
-      auto len = SSL_write(ssl_.get(), slice.data(), slice_size);
-      if (len == slice_size) {
-        break;
-      }
-      auto error = len <= 0 ? SSL_get_error(ssl_.get(), len) : SSL_ERROR_NONE;
-      VLOG_WITH_PREFIX(4) << "SSL_write was not full: " << slice.size() << ", written: " << len
-                          << ", error: " << error;
-      if (error != SSL_ERROR_NONE) {
-        if (error != SSL_ERROR_WANT_WRITE || !VERIFY_RESULT(WriteEncrypted(nullptr))) {
-          return STATUS_FORMAT(
-              NetworkError, "SSL write failed: $0 ($1)", SSLErrorMessage(error), error);
-        }
-      } else {
-        RETURN_NOT_OK(WriteEncrypted(nullptr));
-      }
-      if (len > 0) {
-        slice.remove_prefix(len);
+    if (buf.size() < kMaxCoalescedBufferSize) {
+      if (coalesced_.size() + buf.size() > kMaxCoalescedSize) {
+        RETURN_NOT_OK(FlushCoalesced());
       }
+      coalesced_.append(buf.data(), buf.size());
+      continue;
     }
+    RETURN_NOT_OK(FlushCoalesced());
+    RETURN_NOT_OK(WriteToSsl(buf.AsSlice()));
   }
+  RETURN_NOT_OK(FlushCoalesced());
   return ResultToStatus(WriteEncrypted(std::move(data)));
 }
 
+Status SecureRefiner::FlushCoalesced() {
+  if (coalesced_.size() == 0) {
+    return Status::OK();
+  }
+  auto status = WriteToSsl(Slice(coalesced_.data(), coalesced_.size()));
+  coalesced_.clear();
+  return status;
+}
+
+Status SecureRefiner::WriteToSsl(Slice slice) {
+  for (;;) {
+    int slice_size = narrow_cast<int>(slice.size());
+    auto len = SSL_write(ssl_.get(), slice.data(), slice_size);
+    if (ssl_writes_) {
+      ssl_writes_->Increment();
+    }
+    if (len == slice_size) {
+      return Status::OK();
+    }
+    auto error = len <= 0 ? SSL_get_error(ssl_.get(), len) : SSL_ERROR_NONE;
+    VLOG_WITH_PREFIX(4) << "SSL_write was not full: " << slice.size() << ", written: " << len
+                        << ", error: " << error;
+    if (error != SSL_ERROR_NONE) {
+      if (error != SSL_ERROR_WANT_WRITE || !VERIFY_RESULT(WriteEncrypted(nullptr))) {
+        return STATUS_FORMAT(
+            NetworkError, "SSL write failed: $0 ($1)", SSLErrorMessage(error), error);
+      }
+    } else {
+      RETURN_NOT_OK(WriteEncrypted(nullptr));
+    }
+    if (len > 0) {
+      slice.remove_prefix(len);
+    }
+  }
+}
+
 Result<bool> SecureRefiner::WriteEncrypted(OutboundDataPtr data) {
   auto pending = BIO_ctrl_pending(bio_.get());
   if (pending == 0) {
@@ -614,9 +678,14 @@ Status SecureRefiner::Init() {
 
   BIO* int_bio = nullptr;
   BIO* temp_bio = nullptr;
-  BIO_new_bio_pair(&int_bio, 0, &temp_bio, 0);
+  auto bio_buffer_size = narrow_cast<size_t>(FLAGS_secure_stream_bio_buffer_size);
+  BIO_new_bio_pair(&int_bio, bio_buffer_size, &temp_bio, bio_buffer_size);
   SSL_set_bio(ssl_.get(), int_bio, int_bio);
   bio_.reset(temp_bio);
+  if (mem_tracker_) {
+    bio_consumption_ = ScopedTrackedConsumption(
+        mem_tracker_, BIO_get_write_buf_size(int_bio, 0) + BIO_get_write_buf_size(temp_bio, 0));
+  }
 
   int verify_mode = SSL_VERIFY_PEER;
   if (secure_context_.require_client_certificate()) {
@@ -35,8 +35,10 @@
 #include <pthread.h>
 #include <sys/types.h>
 
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <queue>
 #include <string>
 #include <vector>
@@ -48,13 +50,16 @@
 
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/ref_counted.h"
+#include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/gutil/thread_annotations.h"
 
 #include "yb/rpc/inbound_call.h"
 #include "yb/rpc/scheduler.h"
 #include "yb/rpc/service_if.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/enums.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/lockfree.h"
 #include "yb/util/logging.h"
@@ -84,6 +89,31 @@ DEFINE_test_flag(bool, enable_backpressure_mode_for_testing, false,
             "For testing purposes. Enables the rpc's to be considered timed out in the queue even "
             "when we have not had any backpressure in the recent past.");
 
+DEFINE_bool(rpc_enable_priority_queues, false,
+            "Queue calls of each service in separate bounded queues per priority class, so calls "
+            "of higher priority are handled first.");
+TAG_FLAG(rpc_enable_priority_queues, advanced);
+TAG_FLAG(rpc_enable_priority_queues, runtime);
+
+DEFINE_string(rpc_high_priority_methods,
+              "UpdateConsensus,MultiRaftUpdateConsensus,RequestConsensusVote,RunLeaderElection,"
+              "LeaderElectionLost,LeaderStepDown,Ping",
+              "Comma separated list of RPC methods that are queued with high priority, when "
+              "rpc_enable_priority_queues is set.");
+TAG_FLAG(rpc_high_priority_methods, advanced);
+
+DEFINE_string(rpc_low_priority_methods, "",
+              "Comma separated list of RPC methods that are queued with low priority, when "
+              "rpc_enable_priority_queues is set.");
+TAG_FLAG(rpc_low_priority_methods, advanced);
+
+DEFINE_int64(rpc_max_queue_latency_ms, 0,
+             "When rpc_enable_priority_queues is set, new calls of normal and low priority are "
+             "rejected as server too busy, while the oldest call of their class waits in the queue "
+             "longer than this. 0 - disabled.");
+TAG_FLAG(rpc_max_queue_latency_ms, advanced);
+TAG_FLAG(rpc_max_queue_latency_ms, runtime);
+
 METRIC_DEFINE_coarse_histogram(server, rpc_incoming_queue_time,
                         "RPC Queue Time",
                         yb::MetricUnit::kMicroseconds,
@@ -109,6 +139,12 @@ METRIC_DEFINE_counter(server, rpcs_queue_overflow,
                       "Number of RPCs dropped because the service queue "
                       "was full.");
 
+METRIC_DEFINE_counter(server, rpcs_shed_by_queue_latency,
+                      "RPCs Shed By Queue Latency",
+                      yb::MetricUnit::kRequests,
+                      "Number of RPCs rejected because calls of the same priority class waited "
+                      "in the service queue longer than rpc_max_queue_latency_ms.");
+
 namespace yb {
 namespace rpc {
 
@@ -117,6 +153,21 @@ namespace {
 const CoarseDuration kTimeoutCheckGranularity = 100ms;
 const char* const kTimedOutInQueue = "Call waited in the queue past deadline";
 
+YB_DEFINE_ENUM(CallPriority, (kHigh)(kNormal)(kLow));
+
+std::vector<std::string> ParseMethods(const std::string& methods) {
+  return strings::Split(methods, ",", strings::SkipEmpty());
+}
+
+bool ContainsMethod(const std::vector<std::string>& methods, const Slice& method) {
+  for (const auto& entry : methods) {
+    if (method == entry) {
+      return true;
+    }
+  }
+  return false;
+}
+
 } // namespace
 
 class ServicePoolImpl final : public InboundCallHandler {
@@ -135,8 +186,15 @@ class ServicePoolImpl final : public InboundCallHandler {
         rpcs_timed_out_early_in_queue_(
             METRIC_rpcs_timed_out_early_in_queue.Instantiate(entity)),
         rpcs_queue_overflow_(METRIC_rpcs_queue_overflow.Instantiate(entity)),
+        rpcs_shed_by_queue_latency_(METRIC_rpcs_shed_by_queue_latency.Instantiate(entity)),
+        high_priority_methods_(ParseMethods(FLAGS_rpc_high_priority_methods)),
+        low_priority_methods_(ParseMethods(FLAGS_rpc_low_priority_methods)),
         check_timeout_strand_(scheduler->io_service()),
         log_prefix_(Format("$0: ", service_->service_name())) {
+          for (auto priority : kCallPriorityList) {
+            priority_queues_.emplace_back(
+                std::make_unique<PriorityQueue>(this, priority, max_queued_calls_));
+          }
 
           // Create per service counter for rpcs_in_queue_.
           auto id = Format("rpcs_in_queue_$0", service_->service_name());
@@ -184,10 +242,25 @@ class ServicePoolImpl final : public InboundCallHandler {
   void Enqueue(const InboundCallPtr& call) {
     TRACE_TO(call->trace(), "Inserting onto call queue");
 
-    auto task = call->BindTask(this);
-    if (!task) {
-      Overflow(call, "service", queued_calls_.load(std::memory_order_relaxed));
-      return;
+    PriorityQueue* priority_queue = nullptr;
+    ThreadPoolTask* task;
+    if (GetAtomicFlag(&FLAGS_rpc_enable_priority_queues)) {
+      priority_queue = priority_queues_[to_underlying(GetPriority(*call))].get();
+      if (priority_queue->ShouldShed()) {
+        Shed(call, priority_queue->priority());
+        return;
+      }
+      task = call->BindTask(priority_queue);
+      if (!task) {
+        Overflow(call, ToCString(priority_queue->priority()), priority_queue->queued_calls());
+        return;
+      }
+    } else {
+      task = call->BindTask(this);
+      if (!task) {
+        Overflow(call, "service", queued_calls_.load(std::memory_order_relaxed));
+        return;
+      }
     }
 
     auto call_deadline = call->GetClientDeadline();
@@ -196,6 +269,10 @@ class ServicePoolImpl final : public InboundCallHandler {
       ScheduleCheckTimeout(call_deadline);
     }
 
+    if (priority_queue) {
+      std::lock_guard<std::mutex> lock(priority_queues_mutex_);
+      priority_queue->Push(call);
+    }
     thread_pool_.Enqueue(task);
   }
 
@@ -224,12 +301,21 @@ class ServicePoolImpl final : public InboundCallHandler {
             call->remote_address(),
             type,
             limit);
-    YB_LOG_EVERY_N_SECS(WARNING, 3) << LogPrefix() << err_msg;
-    const auto response_status = STATUS(ServiceUnavailable, err_msg);
     rpcs_queue_overflow_->Increment();
-    call->RespondFailure(ErrorStatusPB::ERROR_SERVER_TOO_BUSY, response_status);
-    last_backpressure_at_.store(
-        CoarseMonoClock::Now().time_since_epoch(), std::memory_order_release);
+    RespondTooBusy(call, err_msg);
+  }
+
+  void Shed(const InboundCallPtr& call, CallPriority priority) {
+    const auto err_msg =
+        Format("$0 request on $1 from $2 dropped due to backpressure. "
+                   "Calls of $3 priority wait in the queue longer than $4ms.",
+            call->method_name().ToBuffer(),
+            service_->service_name(),
+            call->remote_address(),
+            priority,
+            FLAGS_rpc_max_queue_latency_ms);
+    rpcs_shed_by_queue_latency_->Increment();
+    RespondTooBusy(call, err_msg);
   }
 
   void Failure(const InboundCallPtr& call, const Status& status) override {
@@ -281,6 +367,131 @@ class ServicePoolImpl final : public InboundCallHandler {
   }
 
  private:
+  // Bounded queue of calls of the same priority class.
+  //
+  // Call tasks bound to the priority queue are submitted to the thread pool as usual, but each
+  // task handles the highest priority queued call, instead of the call it was bound to.
+  // Since a task is submitted for every pushed call, each task always finds a call to handle.
+  class PriorityQueue : public InboundCallHandler {
+   public:
+    PriorityQueue(ServicePoolImpl* pool, CallPriority priority, size_t max_queued_calls)
+        : pool_(*pool), priority_(priority), max_queued_calls_(max_queued_calls) {}
+
+    CallPriority priority() const {
+      return priority_;
+    }
+
+    size_t queued_calls() const {
+      return queued_calls_.load(std::memory_order_relaxed);
+    }
+
+    void Handle(InboundCallPtr call) override {
+      auto next_call = pool_.PopCall(/* highest_priority= */ true);
+      if (next_call) {
+        pool_.Handle(std::move(next_call));
+      }
+    }
+
+    void Failure(const InboundCallPtr& call, const Status& status) override {
+      // Task was rejected by the thread pool, so shed the least important call.
+      auto next_call = pool_.PopCall(/* highest_priority= */ false);
+      if (next_call) {
+        pool_.Failure(next_call, status);
+      }
+    }
+
+    bool CallQueued() override {
+      auto queued_calls = queued_calls_.fetch_add(1, std::memory_order_acq_rel);
+      if (queued_calls >= max_queued_calls_) {
+        queued_calls_.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+      }
+      pool_.rpcs_in_queue_->Increment();
+      return true;
+    }
+
+    void CallDequeued() override {
+      queued_calls_.fetch_sub(1, std::memory_order_relaxed);
+      pool_.rpcs_in_queue_->Decrement();
+    }
+
+    // Whether new calls of this class should be rejected, because queued calls wait too long.
+    bool ShouldShed() {
+      auto max_latency_ms = GetAtomicFlag(&FLAGS_rpc_max_queue_latency_ms);
+      if (max_latency_ms <= 0 || priority_ == CallPriority::kHigh) {
+        return false;
+      }
+      MonoTime oldest;
+      {
+        std::lock_guard<std::mutex> lock(pool_.priority_queues_mutex_);
+        if (calls_.empty()) {
+          return false;
+        }
+        oldest = calls_.front()->ReceiveTime();
+      }
+      return MonoTime::Now().GetDeltaSince(oldest).ToMilliseconds() > max_latency_ms;
+    }
+
+    void Push(InboundCallPtr call) REQUIRES(pool_.priority_queues_mutex_) {
+      calls_.push_back(std::move(call));
+    }
+
+    InboundCallPtr Pop() REQUIRES(pool_.priority_queues_mutex_) {
+      if (calls_.empty()) {
+        return nullptr;
+      }
+      auto result = std::move(calls_.front());
+      calls_.pop_front();
+      return result;
+    }
+
+   private:
+    ServicePoolImpl& pool_;
+    const CallPriority priority_;
+    const size_t max_queued_calls_;
+    std::atomic<size_t> queued_calls_{0};
+    std::deque<InboundCallPtr> calls_;
+  };
+
+  CallPriority GetPriority(const InboundCall& call) const {
+    auto method = call.method_name();
+    if (ContainsMethod(high_priority_methods_, method)) {
+      return CallPriority::kHigh;
+    }
+    if (ContainsMethod(low_priority_methods_, method)) {
+      return CallPriority::kLow;
+    }
+    return CallPriority::kNormal;
+  }
+
+  InboundCallPtr PopCall(bool highest_priority) {
+    std::lock_guard<std::mutex> lock(priority_queues_mutex_);
+    if (highest_priority) {
+      for (const auto& queue : priority_queues_) {
+        auto call = queue->Pop();
+        if (call) {
+          return call;
+        }
+      }
+    } else {
+      for (auto it = priority_queues_.rbegin(); it != priority_queues_.rend(); ++it) {
+        auto call = (**it).Pop();
+        if (call) {
+          return call;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  void RespondTooBusy(const InboundCallPtr& call, const std::string& err_msg) {
+    YB_LOG_EVERY_N_SECS(WARNING, 3) << LogPrefix() << err_msg;
+    const auto response_status = STATUS(ServiceUnavailable, err_msg);
+    call->RespondFailure(ErrorStatusPB::ERROR_SERVER_TOO_BUSY, response_status);
+    last_backpressure_at_.store(
+        CoarseMonoClock::Now().time_since_epoch(), std::memory_order_release);
+  }
+
   void TimedOut(InboundCall* call, const char* error_message, Counter* metric) {
     if (call->RespondTimedOutIfPending(error_message)) {
       metric->Increment();
@@ -414,7 +625,14 @@ class ServicePoolImpl final : public InboundCallHandler {
   scoped_refptr<Counter> rpcs_timed_out_in_queue_;
   scoped_refptr<Counter> rpcs_timed_out_early_in_queue_;
   scoped_refptr<Counter> rpcs_queue_overflow_;
+  scoped_refptr<Counter> rpcs_shed_by_queue_latency_;
   scoped_refptr<AtomicGauge<int64_t>> rpcs_in_queue_;
+
+  const std::vector<std::string> high_priority_methods_;
+  const std::vector<std::string> low_priority_methods_;
+  std::mutex priority_queues_mutex_;
+  // Indexed by CallPriority, from the highest priority to the lowest.
+  std::vector<std::unique_ptr<PriorityQueue>> priority_queues_;
   // Have to use CoarseDuration here, since CoarseTimePoint does not work with clang + libstdc++
   std::atomic<CoarseDuration> last_backpressure_at_{CoarseTimePoint().time_since_epoch()};
   std::atomic<int64_t> queued_calls_{0};
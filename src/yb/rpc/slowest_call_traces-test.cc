@@ -0,0 +1,55 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/rpc/slowest_call_traces.h"
+
+#include "yb/util/format.h"
+#include "yb/util/test_util.h"
+
+DECLARE_int32(rpc_slowest_traces_per_method);
+DECLARE_int32(rpc_slowest_traces_min_ms);
+
+namespace yb {
+namespace rpc {
+
+class SlowestCallTracesTest : public YBTest {
+};
+
+TEST_F(SlowestCallTracesTest, KeepsSlowest) {
+  FLAGS_rpc_slowest_traces_per_method = 2;
+  FLAGS_rpc_slowest_traces_min_ms = 10;
+  ASSERT_FALSE(SlowestCallTraces::ShouldRecord(5));
+  ASSERT_TRUE(SlowestCallTraces::ShouldRecord(10));
+
+  SlowestCallTraces traces;
+  for (int64_t duration_ms : {20, 50, 10, 30, 40}) {
+    traces.Record("Service.Method", duration_ms, Format("call $0", duration_ms), nullptr);
+  }
+  traces.Record("Service.OtherMethod", 15, "other call", nullptr);
+
+  auto result = traces.Get();
+  ASSERT_EQ(2U, result.size());
+  const auto& entries = result["Service.Method"];
+  ASSERT_EQ(2U, entries.size());
+  ASSERT_EQ(50, entries[0].duration_ms);
+  ASSERT_EQ(40, entries[1].duration_ms);
+  ASSERT_EQ("call 40", entries[1].call);
+  ASSERT_EQ(1U, result["Service.OtherMethod"].size());
+
+  FLAGS_rpc_slowest_traces_per_method = 0;
+  ASSERT_FALSE(SlowestCallTraces::ShouldRecord(100));
+}
+
+} // namespace rpc
+} // namespace yb
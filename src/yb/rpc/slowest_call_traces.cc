@@ -0,0 +1,113 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/rpc/slowest_call_traces.h"
+
+#include <algorithm>
+
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
+
+using namespace std::literals;
+
+DEFINE_int32(rpc_slowest_traces_per_method, 3,
+             "Number of slowest inbound calls of each method, whose traces are retained in each "
+             "time window and shown at /slowest-rpcz. 0 to disable.");
+TAG_FLAG(rpc_slowest_traces_per_method, advanced);
+TAG_FLAG(rpc_slowest_traces_per_method, runtime);
+
+DEFINE_int32(rpc_slowest_traces_window_sec, 60,
+             "Length of the time window in which traces of the slowest inbound calls are "
+             "retained.");
+TAG_FLAG(rpc_slowest_traces_window_sec, advanced);
+TAG_FLAG(rpc_slowest_traces_window_sec, runtime);
+
+DEFINE_int32(rpc_slowest_traces_min_ms, 50,
+             "Only traces of inbound calls that took at least this number of ms are retained as "
+             "slowest calls.");
+TAG_FLAG(rpc_slowest_traces_min_ms, advanced);
+TAG_FLAG(rpc_slowest_traces_min_ms, runtime);
+
+namespace yb {
+namespace rpc {
+
+SlowestCallTraces& SlowestCallTraces::Instance() {
+  static SlowestCallTraces instance;
+  return instance;
+}
+
+bool SlowestCallTraces::ShouldRecord(int64_t duration_ms) {
+  return GetAtomicFlag(&FLAGS_rpc_slowest_traces_per_method) > 0 &&
+         duration_ms >= GetAtomicFlag(&FLAGS_rpc_slowest_traces_min_ms);
+}
+
+void SlowestCallTraces::Record(
+    const std::string& method, int64_t duration_ms, std::string call,
+    const scoped_refptr<Trace>& trace) {
+  auto now = CoarseMonoClock::now();
+  auto window = GetAtomicFlag(&FLAGS_rpc_slowest_traces_window_sec) * 1s;
+  size_t max_entries = std::max(GetAtomicFlag(&FLAGS_rpc_slowest_traces_per_method), 0);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& windows = methods_[method];
+  if (now - windows.window_start >= window) {
+    // Previous window is kept only if it is adjacent to the new one.
+    if (now - windows.window_start < 2 * window) {
+      windows.previous = std::move(windows.current);
+    } else {
+      windows.previous.clear();
+    }
+    windows.current.clear();
+    windows.window_start = now;
+  }
+
+  auto& entries = windows.current;
+  if (entries.size() < max_entries) {
+    entries.push_back(Entry{duration_ms, std::move(call), trace});
+    return;
+  }
+  auto fastest = std::min_element(
+      entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+    return lhs.duration_ms < rhs.duration_ms;
+  });
+  if (fastest != entries.end() && fastest->duration_ms < duration_ms) {
+    *fastest = Entry{duration_ms, std::move(call), trace};
+  }
+}
+
+std::map<std::string, std::vector<SlowestCallTraces::Entry>> SlowestCallTraces::Get() {
+  std::map<std::string, std::vector<Entry>> result;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& method_and_windows : methods_) {
+      const auto& windows = method_and_windows.second;
+      if (windows.current.empty() && windows.previous.empty()) {
+        continue;
+      }
+      auto& entries = result[method_and_windows.first];
+      entries.insert(entries.end(), windows.current.begin(), windows.current.end());
+      entries.insert(entries.end(), windows.previous.begin(), windows.previous.end());
+    }
+  }
+  for (auto& method_and_entries : result) {
+    auto& entries = method_and_entries.second;
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+      return lhs.duration_ms > rhs.duration_ms;
+    });
+  }
+  return result;
+}
+
+} // namespace rpc
+} // namespace yb
@@ -0,0 +1,74 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#ifndef YB_RPC_SLOWEST_CALL_TRACES_H
+#define YB_RPC_SLOWEST_CALL_TRACES_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/gutil/ref_counted.h"
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/trace.h"
+
+namespace yb {
+namespace rpc {
+
+// Retains traces of the slowest inbound calls of each remote method, so traces of tail latency
+// outliers are available after the fact, without enabling trace dumps for all calls.
+//
+// Calls are tracked in time windows of rpc_slowest_traces_window_sec, up to
+// rpc_slowest_traces_per_method calls per method in each window. Entries of the previous window
+// are kept until the next window starts. Only calls that took at least rpc_slowest_traces_min_ms
+// are considered, so the common path is a single comparison. Thread safe.
+class SlowestCallTraces {
+ public:
+  struct Entry {
+    int64_t duration_ms;
+    std::string call;
+    scoped_refptr<Trace> trace;
+  };
+
+  static SlowestCallTraces& Instance();
+
+  // Returns true if a call that took specified time should be passed to Record.
+  static bool ShouldRecord(int64_t duration_ms);
+
+  void Record(
+      const std::string& method, int64_t duration_ms, std::string call,
+      const scoped_refptr<Trace>& trace);
+
+  // Returns retained entries of the current and previous windows by method, slowest first.
+  std::map<std::string, std::vector<Entry>> Get();
+
+ private:
+  struct MethodWindows {
+    CoarseTimePoint window_start;
+    std::vector<Entry> current;
+    std::vector<Entry> previous;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, MethodWindows> methods_ GUARDED_BY(mutex_);
+};
+
+} // namespace rpc
+} // namespace yb
+
+#endif // YB_RPC_SLOWEST_CALL_TRACES_H
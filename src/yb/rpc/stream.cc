@@ -14,6 +14,9 @@
 #include "yb/rpc/stream.h"
 
 #include "yb/util/format.h"
+#include "yb/util/monotime.h"
+#include "yb/util/result.h"
+#include "yb/util/status_format.h"
 
 namespace yb {
 namespace rpc {
@@ -22,5 +25,9 @@ std::string Stream::ToString() const {
   return Format("{ local: $0 remote: $1 }", Local(), Remote());
 }
 
+Result<MonoDelta> Stream::RoundTripTime() const {
+  return STATUS_FORMAT(NotSupported, "Round trip time is not available for $0", ToString());
+}
+
 }  // namespace rpc
 }  // namespace yb
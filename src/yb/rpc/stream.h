@@ -118,6 +118,9 @@ class Stream {
   // The address of the local end of the connection.
   virtual const Endpoint& Local() const = 0;
 
+  // Round trip time of the connection, as estimated by the transport.
+  virtual Result<MonoDelta> RoundTripTime() const;
+
   virtual std::string ToString() const;
 
   const std::string& LogPrefix() {
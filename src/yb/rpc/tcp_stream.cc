@@ -22,6 +22,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/memory/memory_usage.h"
 #include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
 #include "yb/util/result.h"
 #include "yb/util/status_log.h"
 #include "yb/util/string_util.h"
@@ -29,6 +30,12 @@
 using namespace std::literals;
 
 DECLARE_uint64(rpc_connection_timeout_ms);
+DEFINE_int32(rpc_socket_busy_poll_us, 0,
+             "If positive, sets SO_BUSY_POLL on RPC sockets, so the kernel busy polls the device "
+             "queue for this number of microseconds on reads that would block. Usually combined "
+             "with rpc_reactor_busy_poll_us.");
+TAG_FLAG(rpc_socket_busy_poll_us, advanced);
+
 DEFINE_test_flag(int32, delay_connect_ms, 0,
                  "Delay connect in tests for specified amount of milliseconds.");
 
@@ -75,6 +82,9 @@ Status TcpStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context
   connected_ = !connect;
 
   RETURN_NOT_OK(socket_.SetNoDelay(true));
+  if (FLAGS_rpc_socket_busy_poll_us > 0) {
+    WARN_NOT_OK(socket_.SetBusyPoll(FLAGS_rpc_socket_busy_poll_us), "Failed to set busy poll");
+  }
   // These timeouts don't affect non-blocking sockets:
   RETURN_NOT_OK(socket_.SetSendTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
   RETURN_NOT_OK(socket_.SetRecvTimeout(FLAGS_rpc_connection_timeout_ms * 1ms));
@@ -488,6 +498,10 @@ void TcpStream::Cancelled(size_t handle) {
   entry.ClearBytes();
 }
 
+Result<MonoDelta> TcpStream::RoundTripTime() const {
+  return socket_.GetRoundTripTime();
+}
+
 void TcpStream::DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) {
   auto call_in_flight = resp->add_calls_in_flight();
   uint64_t sending_bytes = 0;
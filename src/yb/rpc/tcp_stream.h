@@ -85,6 +85,7 @@ class TcpStream : public Stream {
 
   const Endpoint& Remote() const override { return remote_; }
   const Endpoint& Local() const override { return local_; }
+  Result<MonoDelta> RoundTripTime() const override;
 
   const Protocol* GetProtocol() override {
     return StaticProtocol();
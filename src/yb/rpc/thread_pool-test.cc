@@ -149,6 +149,107 @@ TEST_F(ThreadPoolTest, TestMultiProducers) {
   }
 }
 
+TEST_F(ThreadPoolTest, TestShardedMultiProducers) {
+  constexpr size_t kTotalTasks = 10000;
+  constexpr size_t kTotalWorkers = 8;
+  constexpr size_t kProducers = 4;
+  ThreadPool pool("test", kTotalTasks, kTotalWorkers, kProducers /* num_shards */);
+
+  CountDownLatch latch(kTotalTasks);
+  std::vector<TestTask> tasks(kTotalTasks);
+  std::vector<std::thread> threads;
+  size_t begin = 0;
+  for (size_t i = 0; i != kProducers; ++i) {
+    size_t end = kTotalTasks * (i + 1) / kProducers;
+    threads.emplace_back([&pool, &latch, &tasks, begin, end, shard = i] {
+      CDSAttacher attacher;
+      ThreadPool::SetCurrentThreadShard(shard);
+      for (size_t i = begin; i != end; ++i) {
+        tasks[i].SetLatch(&latch);
+        ASSERT_TRUE(pool.Enqueue(&tasks[i]));
+      }
+    });
+    begin = end;
+  }
+  latch.Wait();
+  for (auto& task : tasks) {
+    ASSERT_TRUE(task.IsCompleted());
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Test that a task is handled by a worker of another shard, when all workers of its own shard are
+// busy.
+TEST_F(ThreadPoolTest, TestShardedSteal) {
+  constexpr size_t kTotalTasks = 10;
+  constexpr size_t kNumShards = 2;
+  ThreadPool pool("test", kTotalTasks, kNumShards /* max_workers */, kNumShards);
+
+  // Start the only worker of the second shard.
+  ThreadPool::SetCurrentThreadShard(1);
+  {
+    CountDownLatch latch(1);
+    TestTask task;
+    task.SetLatch(&latch);
+    ASSERT_TRUE(pool.Enqueue(&task));
+    latch.Wait();
+  }
+
+  // Block the only worker of the first shard.
+  ThreadPool::SetCurrentThreadShard(0);
+  CountDownLatch blocker_started(1);
+  CountDownLatch release_blocker(1);
+  CountDownLatch blocker_done(1);
+  pool.EnqueueFunctor([&blocker_started, &release_blocker, &blocker_done] {
+    blocker_started.CountDown();
+    release_blocker.Wait();
+    blocker_done.CountDown();
+  });
+  blocker_started.Wait();
+
+  CountDownLatch latch(1);
+  TestTask task;
+  task.SetLatch(&latch);
+  ASSERT_TRUE(pool.Enqueue(&task));
+  ASSERT_TRUE(latch.WaitFor(10s));
+  ASSERT_TRUE(task.IsCompleted());
+
+  release_blocker.CountDown();
+  blocker_done.Wait();
+}
+
+// Compares shared queue and work stealing pools on many short tasks, most of which are submitted
+// from workers.
+TEST_F(ThreadPoolTest, TestWorkStealingManyShortTasks) {
+  constexpr size_t kRootTasks = RegularBuildVsSanitizers(1000, 100);
+  constexpr size_t kChildTasksPerRoot = 100;
+  constexpr size_t kTotalTasks = kRootTasks * (kChildTasksPerRoot + 1);
+  constexpr size_t kTotalWorkers = 8;
+
+  for (bool work_stealing : {false, true}) {
+    ThreadPool pool(
+        "test", kTotalTasks, kTotalWorkers, 1 /* num_shards */, false /* pin_workers */,
+        work_stealing);
+    CountDownLatch latch(kTotalTasks);
+    auto start = MonoTime::Now();
+    for (size_t i = 0; i != kRootTasks; ++i) {
+      pool.EnqueueFunctor([&pool, &latch] {
+        for (size_t j = 0; j != kChildTasksPerRoot; ++j) {
+          pool.EnqueueFunctor([&latch] {
+            latch.CountDown();
+          });
+        }
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+    LOG(INFO) << "Work stealing: " << work_stealing << ", " << kTotalTasks << " tasks took "
+              << MonoTime::Now() - start;
+  }
+}
+
 TEST_F(ThreadPoolTest, TestQueueOverflow) {
   constexpr size_t kTotalTasks = 10000;
   constexpr size_t kTotalWorkers = 4;
@@ -15,14 +15,21 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include <algorithm>
 #include <condition_variable>
+#include <limits>
 #include <mutex>
+#include <vector>
 
 #include <cds/container/basket_queue.h>
 #include <cds/gc/dhp.h>
 
+#include "yb/gutil/casts.h"
+#include "yb/gutil/sysinfo.h"
+
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_format.h"
+#include "yb/util/status_log.h"
 #include "yb/util/thread.h"
 
 namespace yb {
@@ -35,40 +42,109 @@ class Worker;
 typedef cds::container::BasketQueue<cds::gc::DHP, ThreadPoolTask*> TaskQueue;
 typedef cds::container::BasketQueue<cds::gc::DHP, Worker*> WaitingWorkers;
 
-struct ThreadPoolShare {
-  ThreadPoolOptions options;
+struct ThreadPoolShard {
   TaskQueue task_queue;
   WaitingWorkers waiting_workers;
+  std::atomic<size_t> created_workers = {0};
+  size_t max_workers = 0;
+};
+
+struct ThreadPoolShare {
+  ThreadPoolOptions options;
+  std::vector<std::unique_ptr<ThreadPoolShard>> shards;
+
+  // Started workers, used to steal tasks from their local queues in work stealing mode.
+  std::unique_ptr<std::atomic<Worker*>[]> workers;
+  size_t max_workers = 0;
+  std::atomic<size_t> num_workers = {0};
 
   explicit ThreadPoolShare(ThreadPoolOptions o)
-      : options(std::move(o)) {}
+      : options(std::move(o)) {
+    const auto num_shards = std::max<size_t>(options.num_shards, 1);
+    for (size_t i = 0; i != num_shards; ++i) {
+      shards.push_back(std::make_unique<ThreadPoolShard>());
+      shards.back()->max_workers = std::max<size_t>(options.max_workers / num_shards, 1);
+      max_workers += shards.back()->max_workers;
+    }
+    if (options.work_stealing) {
+      workers.reset(new std::atomic<Worker*>[max_workers]);
+      for (size_t i = 0; i != max_workers; ++i) {
+        workers[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+  }
 };
 
 namespace {
 
 const std::string kRpcThreadCategory = "rpc_thread_pool";
+constexpr size_t kUnknownShard = std::numeric_limits<size_t>::max();
+
+thread_local size_t current_thread_shard = kUnknownShard;
+thread_local Worker* current_worker = nullptr;
+
+size_t CurrentThreadShard(size_t num_shards) {
+  if (num_shards == 1) {
+    return 0;
+  }
+  if (current_thread_shard == kUnknownShard) {
+    static std::atomic<size_t> next_shard = {0};
+    current_thread_shard = next_shard.fetch_add(1, std::memory_order_relaxed);
+  }
+  return current_thread_shard % num_shards;
+}
 
 } // namespace
 
 class Worker {
  public:
-  explicit Worker(ThreadPoolShare* share)
-      : share_(share) {
+  Worker(ThreadPoolShare* share, size_t shard_index)
+      : share_(share), shard_index_(shard_index), shard_(*share->shards[shard_index]) {
   }
 
   CHECKED_STATUS Start(size_t index) {
-    auto name = strings::Substitute("rpc_tp_$0_$1", share_->options.name, index);
+    auto name = share_->shards.size() == 1
+        ? strings::Substitute("rpc_tp_$0_$1", share_->options.name, index)
+        : strings::Substitute("rpc_tp_$0_$1_$2", share_->options.name, shard_index_, index);
     return yb::Thread::Create(kRpcThreadCategory, name, &Worker::Execute, this, &thread_);
   }
 
   ~Worker() {
+    Join();
+  }
+
+  Worker(const Worker& worker) = delete;
+  void operator=(const Worker& worker) = delete;
+
+  void Join() {
     if (thread_) {
       thread_->Join();
+      thread_.reset();
     }
   }
 
-  Worker(const Worker& worker) = delete;
-  void operator=(const Worker& worker) = delete;
+  ThreadPoolShare* share() const {
+    return share_;
+  }
+
+  // Tasks submitted by the worker of work stealing pool are pushed to its local queue, so they
+  // are usually executed by the same worker, without touching queues shared with other workers.
+  void PushLocal(ThreadPoolTask* task) {
+    bool added = local_queue_.push(task);
+    DCHECK(added); // BasketQueue always succeed.
+  }
+
+  bool StealTask(ThreadPoolTask** task) {
+    return local_queue_.pop(*task);
+  }
+
+  // Should be invoked after the worker thread is joined.
+  void AbortLocalTasks(const Status& status) {
+    ThreadPoolTask* task = nullptr;
+    while (local_queue_.pop(task)) {
+      task->Done(status);
+    }
+  }
 
   void Stop() {
     stop_requested_ = true;
@@ -98,6 +174,13 @@ class Worker {
   // does not have free hands (worker queue empty)
   void Execute() {
     Thread::current_thread()->SetUserData(share_);
+    current_worker = this;
+    // Tasks submitted by the worker itself go to its own shard.
+    current_thread_shard = shard_index_;
+    if (share_->options.pin_workers) {
+      WARN_NOT_OK(PinCurrentThreadToCpu(narrow_cast<int>(shard_index_ % base::NumCPUs())),
+                  "Failed to pin worker");
+    }
     while (!stop_requested_) {
       ThreadPoolTask* task = nullptr;
       if (PopTask(&task)) {
@@ -107,10 +190,34 @@ class Worker {
     }
   }
 
+  // Pops task from the own local queue and shard, and when they are empty steals a task from
+  // other shards and other workers.
+  bool TryPopTask(ThreadPoolTask** task) {
+    if (local_queue_.pop(*task) || shard_.task_queue.pop(*task)) {
+      return true;
+    }
+    const auto num_shards = share_->shards.size();
+    for (size_t i = 1; i < num_shards; ++i) {
+      if (share_->shards[(shard_index_ + i) % num_shards]->task_queue.pop(*task)) {
+        return true;
+      }
+    }
+    if (share_->workers) {
+      const auto num_workers = share_->num_workers.load(std::memory_order_acquire);
+      for (size_t i = 0; i != num_workers; ++i) {
+        auto* victim = share_->workers[i].load(std::memory_order_acquire);
+        if (victim != this && victim->StealTask(task)) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
   bool PopTask(ThreadPoolTask** task) {
     // First of all we try to get already queued task, w/o locking.
     // If there is no task, so we could go to waiting state.
-    if (share_->task_queue.pop(*task)) {
+    if (TryPopTask(task)) {
       return true;
     }
     std::unique_lock<std::mutex> lock(mutex_);
@@ -126,7 +233,7 @@ class Worker {
       // the worker queue. So worker queue could be empty in this case, and nobody was notified
       // about new task. So we check there for this case. This technique is similar to
       // double check.
-      if (share_->task_queue.pop(*task)) {
+      if (TryPopTask(task)) {
         return true;
       }
 
@@ -134,7 +241,7 @@ class Worker {
 
       // Sometimes another worker could steal task before we wake up. In this case we will
       // just enqueue ourselves back.
-      if (share_->task_queue.pop(*task)) {
+      if (TryPopTask(task)) {
         return true;
       }
     }
@@ -143,13 +250,16 @@ class Worker {
 
   void AddToWaitingWorkers() {
     if (!added_to_waiting_workers_) {
-      auto pushed = share_->waiting_workers.push(this);
+      auto pushed = shard_.waiting_workers.push(this);
       DCHECK(pushed); // BasketQueue always succeed.
       added_to_waiting_workers_ = true;
     }
   }
 
   ThreadPoolShare* share_;
+  const size_t shard_index_;
+  ThreadPoolShard& shard_;
+  TaskQueue local_queue_;
   scoped_refptr<yb::Thread> thread_;
   std::mutex mutex_;
   std::condition_variable cond_;
@@ -182,27 +292,35 @@ class ThreadPool::Impl {
       task->Done(shutdown_status_);
       return false;
     }
-    bool added = share_.task_queue.push(task);
-    DCHECK(added); // BasketQueue always succeed.
-    Worker* worker = nullptr;
-    while (share_.waiting_workers.pop(worker)) {
-      if (worker->Notify()) {
-        --adding_;
-        return true;
-      }
+    const auto shard_index = CurrentThreadShard(share_.shards.size());
+    auto& shard = *share_.shards[shard_index];
+    if (share_.workers && current_worker && current_worker->share() == &share_) {
+      current_worker->PushLocal(task);
+    } else {
+      bool added = shard.task_queue.push(task);
+      DCHECK(added); // BasketQueue always succeed.
+    }
+    if (NotifyWaitingWorker(&shard)) {
+      --adding_;
+      return true;
     }
     --adding_;
 
-    // We increment created_workers_ every time, the first max_worker increments would produce
+    // We increment created_workers every time, the first max_worker increments would produce
     // a new worker. And after that, we will just increment it doing nothing after that.
     // So we could be lock free here.
-    auto index = created_workers_++;
-    if (index < share_.options.max_workers) {
+    auto index = shard.created_workers++;
+    if (index < shard.max_workers) {
       std::lock_guard<std::mutex> lock(mutex_);
       if (!closing_) {
-        auto new_worker = std::make_unique<Worker>(&share_);
-        auto status = new_worker->Start(workers_.size());
+        auto new_worker = std::make_unique<Worker>(&share_, shard_index);
+        auto status = new_worker->Start(index);
         if (status.ok()) {
+          if (share_.workers) {
+            auto num_workers = share_.num_workers.load(std::memory_order_relaxed);
+            share_.workers[num_workers].store(new_worker.get(), std::memory_order_release);
+            share_.num_workers.store(num_workers + 1, std::memory_order_release);
+          }
           workers_.push_back(std::move(new_worker));
         } else if (workers_.empty()) {
           LOG(FATAL) << "Unable to start first worker: " << status;
@@ -210,19 +328,40 @@ class ThreadPool::Impl {
           LOG(WARNING) << "Unable to start worker: " << status;
         }
       }
-    } else {
-      --created_workers_;
+      return true;
+    }
+    --shard.created_workers;
+
+    // All workers of the shard are busy, wake up an idle worker of another shard to steal the task.
+    for (size_t i = 1; i < share_.shards.size(); ++i) {
+      if (NotifyWaitingWorker(share_.shards[(shard_index + i) % share_.shards.size()].get())) {
+        break;
+      }
     }
     return true;
   }
 
+  bool NotifyWaitingWorker(ThreadPoolShard* shard) {
+    Worker* worker = nullptr;
+    while (shard->waiting_workers.pop(worker)) {
+      if (worker->Notify()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   void Shutdown() {
     // Block creating new workers.
-    created_workers_ += share_.options.max_workers;
+    for (auto& shard : share_.shards) {
+      shard->created_workers += shard->max_workers;
+    }
     {
       std::lock_guard<std::mutex> lock(mutex_);
       if (closing_) {
-        CHECK(share_.task_queue.empty());
+        for (auto& shard : share_.shards) {
+          CHECK(shard->task_queue.empty());
+        }
         CHECK(workers_.empty());
         return;
       }
@@ -239,10 +378,16 @@ class ThreadPool::Impl {
     while (adding_ != 0) {
       std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
+    for (auto& worker : workers_) {
+      worker->Join();
+      worker->AbortLocalTasks(shutdown_status_);
+    }
     workers_.clear();
     ThreadPoolTask* task = nullptr;
-    while (share_.task_queue.pop(task)) {
-      task->Done(shutdown_status_);
+    for (auto& shard : share_.shards) {
+      while (shard->task_queue.pop(task)) {
+        task->Done(shutdown_status_);
+      }
     }
   }
 
@@ -253,7 +398,6 @@ class ThreadPool::Impl {
  private:
   ThreadPoolShare share_;
   std::vector<std::unique_ptr<Worker>> workers_;
-  std::atomic<size_t> created_workers_ = {0};
   std::mutex mutex_;
   std::atomic<bool> closing_ = {false};
   std::atomic<size_t> adding_ = {0};
@@ -285,6 +429,10 @@ bool ThreadPool::IsCurrentThreadRpcWorker() {
   return thread != nullptr && thread->category() == kRpcThreadCategory;
 }
 
+void ThreadPool::SetCurrentThreadShard(size_t shard) {
+  current_thread_shard = shard;
+}
+
 bool ThreadPool::Enqueue(ThreadPoolTask* task) {
   return impl_->Enqueue(task);
 }
@@ -76,9 +76,17 @@ struct ThreadPoolOptions {
   std::string name;
   size_t queue_limit;
   size_t max_workers;
+  // Tasks and workers are split into this number of shards, see ThreadPool::SetCurrentThreadShard.
+  size_t num_shards = 1;
+  // Pin workers of each shard to the CPU with the same index.
+  bool pin_workers = false;
+  // Tasks submitted from a worker go to its local queue, idle workers steal tasks from local
+  // queues of other workers. Tasks submitted from other threads go to the shard queue.
+  bool work_stealing = false;
 
   std::string ToString() const {
-    return YB_STRUCT_TO_STRING(name, queue_limit, max_workers);
+    return YB_STRUCT_TO_STRING(
+        name, queue_limit, max_workers, num_shards, pin_workers, work_stealing);
   }
 };
 
@@ -115,6 +123,11 @@ class ThreadPool {
 
   static bool IsCurrentThreadRpcWorker();
 
+  // Tasks enqueued from the current thread go to the specified shard of sharded pools, and are
+  // handled by workers of this shard unless all of them are busy. Threads that did not set the
+  // shard are spread over shards.
+  static void SetCurrentThreadShard(size_t shard);
+
   bool Owns(Thread* thread);
   bool OwnsThisThread();
 
@@ -26,6 +26,7 @@
 #include "yb/rpc/rpc_context.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 #include "yb/rpc/serialization.h"
+#include "yb/rpc/slowest_call_traces.h"
 
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/flag_tags.h"
@@ -384,6 +385,11 @@ void YBInboundCall::LogTrace() const {
   MonoTime now = MonoTime::Now();
   auto total_time = now.GetDeltaSince(timing_.time_received).ToMilliseconds();
 
+  if (SlowestCallTraces::ShouldRecord(total_time)) {
+    SlowestCallTraces::Instance().Record(
+        header_.RemoteMethodAsString(), total_time, ToString(), trace_);
+  }
+
   if (header_.timeout_ms > 0) {
     double log_threshold = header_.timeout_ms * 0.75f;
     if (total_time > log_threshold) {
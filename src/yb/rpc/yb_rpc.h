@@ -181,10 +181,6 @@ class YBInboundCall : public InboundCall {
 
   CoarseTimePoint GetClientDeadline() const override;
 
-  MonoTime ReceiveTime() const {
-    return timing_.time_received;
-  }
-
   virtual CHECKED_STATUS ParseParam(RpcCallParams* params);
 
   size_t ObjectSize() const override { return sizeof(*this); }
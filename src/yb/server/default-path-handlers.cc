@@ -79,6 +79,7 @@
 #include "yb/util/status_log.h"
 #include "yb/util/version_info.h"
 #include "yb/util/version_info.pb.h"
+#include "yb/util/wait_state.h"
 
 DEFINE_uint64(web_log_bytes, 1024 * 1024,
     "The maximum number of bytes to display on the debug webserver's log page");
@@ -356,6 +357,23 @@ static void HandleGetVersionInfo(
 
 } // anonymous namespace
 
+// Registered to handle "/wait-events", prints out threads that are blocked on each wait event at
+// the moment, and cumulative wait statistics.
+static void WaitEventsHandler(const Webserver::WebRequest& req, Webserver::WebResponse* resp) {
+  std::stringstream *output = &resp->output;
+  *output << "<h1>Wait events</h1>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Event</th><th>Waiting now</th><th>Total waits</th>"
+      "<th>Total wait time (ms)</th></tr>\n";
+  for (auto event : kWaitEventList) {
+    auto stats = GetWaitEventStats(event);
+    *output << Format("  <tr><td>$0</td><td>$1</td><td>$2</td><td>$3</td></tr>\n",
+                      ToCString(event), stats.num_waiting, stats.total_waits,
+                      stats.total_wait_us / 1000);
+  }
+  *output << "</table>\n";
+}
+
 void AddDefaultPathHandlers(Webserver* webserver) {
   webserver->RegisterPathHandler("/logs", "Logs", LogsHandler, true, false);
   webserver->RegisterPathHandler("/varz", "Flags", FlagsHandler, true, false);
@@ -363,6 +381,7 @@ void AddDefaultPathHandlers(Webserver* webserver) {
   webserver->RegisterPathHandler("/memz", "Memory (total)", MemUsageHandler, true, false);
   webserver->RegisterPathHandler("/mem-trackers", "Memory (detail)",
                                  MemTrackersHandler, true, false);
+  webserver->RegisterPathHandler("/wait-events", "Wait Events", WaitEventsHandler, true, false);
   webserver->RegisterPathHandler("/api/v1/version-info", "Build Version Info",
                                  HandleGetVersionInfo, false, false);
 
@@ -41,6 +41,7 @@
 #include "yb/util/monotime.h"
 #include "yb/util/random.h"
 #include "yb/util/random_util.h"
+#include "yb/util/test_thread_holder.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
 
@@ -174,6 +175,32 @@ void HybridClockTest::RunMultiThreadedTest(int num_reads_per_update) {
   }
 }
 
+// Measures throughput of concurrent HybridClock::Now calls, that are performed several times
+// per read and write.
+TEST_F(HybridClockTest, ConcurrentNowPerformance) {
+  constexpr int kNumThreads = 8;
+  constexpr int kCallsPerThread = 1000000;
+
+  TestThreadHolder thread_holder;
+  auto start = MonoTime::Now();
+  for (int i = 0; i != kNumThreads; ++i) {
+    thread_holder.AddThread([this] {
+      HybridTime prev = HybridTime::kMin;
+      for (int j = 0; j != kCallsPerThread; ++j) {
+        auto now = clock_->Now();
+        ASSERT_GT(now, prev);
+        prev = now;
+      }
+    });
+  }
+  thread_holder.JoinAll();
+  auto elapsed = MonoTime::Now() - start;
+
+  LOG(INFO) << kNumThreads << " threads performed " << kCallsPerThread << " calls each in "
+            << elapsed << ", " << elapsed.ToNanoseconds() / kCallsPerThread
+            << " ns per call in each thread";
+}
+
 TEST_F(HybridClockTest, CompareHybridClocksToDelta) {
   EXPECT_EQ(1, HybridClock::CompareHybridClocksToDelta(
       HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, 10),
@@ -66,10 +66,14 @@ METRIC_DEFINE_gauge_int64(server, hybrid_clock_skew,
                            "Server clock skew.");
 
 DEFINE_string(time_source, "",
-              "The clock source that HybridClock should use (for tests only). "
-              "Leave empty for WallClock, other values depend on added clock providers and "
-              "specific for appropriate tests, that adds them.");
-TAG_FLAG(time_source, hidden);
+              "The clock source that HybridClock should use. "
+              "Leave empty for WallClock, that bounds clock uncertainty by max_clock_skew_usec. "
+              "Use ntp for the clock that bounds it by the error reported by the kernel, which is "
+              "maintained by a time synchronization daemon such as chrony, so read uncertainty "
+              "windows follow the measured error instead of the configured worst case. "
+              "All servers of the cluster should use the same time source. "
+              "Other values depend on added clock providers and are specific for tests.");
+TAG_FLAG(time_source, advanced);
 
 DEFINE_bool(fail_on_out_of_range_clock_skew, true,
             "In case transactional tables are present, crash the process if clock skew greater "
@@ -66,6 +66,7 @@
 #include "yb/util/spinlock_profiling.h"
 #include "yb/util/status.h"
 #include "yb/util/status_log.h"
+#include "yb/util/thread.h"
 
 DECLARE_bool(enable_process_lifetime_heap_profiling);
 DECLARE_string(heap_profile_path);
@@ -136,9 +137,39 @@ static void PprofHeapHandler(const Webserver::WebRequest& req,
 #endif
 }
 
+// pprof asks for the url /pprof/heap_sample to get the sampled profile of memory that is currently
+// allocated. Unlike /pprof/heap it does not start a profiler, but returns allocations that tcmalloc
+// samples all the time, so it is cheap enough to be collected periodically from every node.
+// Sampling is enabled by the TCMALLOC_SAMPLE_PARAMETER environment variable.
+static void PprofHeapSampleHandler(const Webserver::WebRequest& req,
+                                   Webserver::WebResponse* resp) {
+  std::stringstream *output = &resp->output;
+#ifndef TCMALLOC_ENABLED
+  (*output) << "Heap sampling is not available without tcmalloc.";
+#else
+  string heap_sample;
+  MallocExtension::instance()->GetHeapSample(&heap_sample);
+  (*output) << heap_sample;
+#endif
+}
+
+#ifdef TCMALLOC_ENABLED
+namespace {
+
+// Invoked by the profiler from the SIGPROF handler, so it should be async signal safe.
+int FilterThreadByCategory(void* arg) {
+  auto thread = Thread::current_thread();
+  return thread && thread->category() == *static_cast<const string*>(arg);
+}
+
+} // namespace
+#endif
+
 // pprof asks for the url /pprof/profile?seconds=XX to get cpu-profiling information.
 // The server should respond by calling ProfilerStart(), continuing to do its work,
 // and then, XX seconds later, calling ProfilerStop().
+// Optional thread_category=XX argument limits the profile to threads of the specified category,
+// as listed by /threadz, e.g. rpc_thread_pool or raft.
 static void PprofCpuProfileHandler(const Webserver::WebRequest& req,
                                   Webserver::WebResponse* resp) {
   std::stringstream *output = &resp->output;
@@ -150,14 +181,24 @@ static void PprofCpuProfileHandler(const Webserver::WebRequest& req,
   if (it != req.parsed_args.end()) {
     seconds = atoi(it->second.c_str());
   }
+  const string thread_category = FindWithDefault(req.parsed_args, "thread_category", "");
   // Build a temporary file name that is hopefully unique.
   string tmp_prof_file_name = strings::Substitute("/tmp/yb_cpu_profile.$0.$1", getpid(), rand());
 
   LOG(INFO) << "Starting a cpu profile:"
             << " profiler file name=" << tmp_prof_file_name
-            << " seconds=" << seconds;
+            << " seconds=" << seconds
+            << " thread category=" << thread_category;
 
-  ProfilerStart(tmp_prof_file_name.c_str());
+  ProfilerOptions options{};
+  if (!thread_category.empty()) {
+    options.filter_in_thread = &FilterThreadByCategory;
+    options.filter_in_thread_arg = const_cast<string*>(&thread_category);
+  }
+  if (!ProfilerStartWithOptions(tmp_prof_file_name.c_str(), &options)) {
+    (*output) << "Unable to start cpu profile, another profile is probably running";
+    return;
+  }
   SleepFor(MonoDelta::FromSeconds(seconds));
   ProfilerStop();
   ifstream prof_file(tmp_prof_file_name.c_str(), std::ios::in);
@@ -275,6 +316,7 @@ void AddPprofPathHandlers(Webserver* webserver) {
   // https://gperftools.googlecode.com/svn/trunk/doc/pprof_remote_servers.html
   webserver->RegisterPathHandler("/pprof/cmdline", "", PprofCmdLineHandler, false, false);
   webserver->RegisterPathHandler("/pprof/heap", "", PprofHeapHandler, false, false);
+  webserver->RegisterPathHandler("/pprof/heap_sample", "", PprofHeapSampleHandler, false, false);
   webserver->RegisterPathHandler("/pprof/growth", "", PprofGrowthHandler, false, false);
   webserver->RegisterPathHandler("/pprof/profile", "", PprofCpuProfileHandler, false, false);
   webserver->RegisterPathHandler("/pprof/symbol", "", PprofSymbolHandler, false, false);
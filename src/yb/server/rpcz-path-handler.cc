@@ -37,6 +37,7 @@
 
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc_introspection.pb.h"
+#include "yb/rpc/slowest_call_traces.h"
 #include "yb/server/webserver.h"
 #include "yb/util/jsonwriter.h"
 #include "yb/util/status_log.h"
@@ -78,11 +79,34 @@ void RpczPathHandler(Messenger* messenger,
   writer.Protobuf(dump_resp);
 }
 
+void SlowestRpczPathHandler(const Webserver::WebRequest& req, Webserver::WebResponse* resp) {
+  JsonWriter writer(&resp->output, JsonWriter::PRETTY);
+  writer.StartObject();
+  for (const auto& method_and_entries : rpc::SlowestCallTraces::Instance().Get()) {
+    writer.String(method_and_entries.first);
+    writer.StartArray();
+    for (const auto& entry : method_and_entries.second) {
+      writer.StartObject();
+      writer.String("duration_ms");
+      writer.Int64(entry.duration_ms);
+      writer.String("call");
+      writer.String(entry.call);
+      writer.String("trace");
+      writer.String(entry.trace ? entry.trace->DumpToString(true) : std::string());
+      writer.EndObject();
+    }
+    writer.EndArray();
+  }
+  writer.EndObject();
+}
+
 } // anonymous namespace
 
 void AddRpczPathHandlers(Messenger* messenger, Webserver* webserver) {
   webserver->RegisterPathHandler(
       "/rpcz", "RPCs", std::bind(RpczPathHandler, messenger, _1, _2), false, false);
+  webserver->RegisterPathHandler(
+      "/slowest-rpcz", "Slowest RPCs", SlowestRpczPathHandler, false, false);
 }
 
 } // namespace yb
@@ -37,10 +37,11 @@ Status AbstractTablet::HandleQLReadRequest(CoarseTimePoint deadline,
                                            const ReadHybridTime& read_time,
                                            const QLReadRequestPB& ql_read_request,
                                            const TransactionOperationContext& txn_op_context,
-                                           QLReadRequestResult* result) {
+                                           QLReadRequestResult* result,
+                                           docdb::QLRowCache* row_cache) {
 
   // TODO(Robert): verify that all key column values are provided
-  docdb::QLReadOperation doc_op(ql_read_request, txn_op_context);
+  docdb::QLReadOperation doc_op(ql_read_request, txn_op_context, row_cache);
 
   // Form a schema of columns that are referenced by this query.
   const SchemaPtr schema = GetSchema();
@@ -84,10 +85,11 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
                                               bool is_explicit_request_read_time,
                                               const PgsqlReadRequestPB& pgsql_read_request,
                                               const TransactionOperationContext& txn_op_context,
+                                              ThreadPool* read_pool,
                                               PgsqlReadRequestResult* result,
                                               size_t* num_rows_read) {
 
-  docdb::PgsqlReadOperation doc_op(pgsql_read_request, txn_op_context);
+  docdb::PgsqlReadOperation doc_op(pgsql_read_request, txn_op_context, read_pool);
 
   // Form a schema of columns that are referenced by this query.
   const SchemaPtr schema = GetSchema(pgsql_read_request.table_id());
@@ -25,6 +25,9 @@
 #include "yb/util/result.h"
 
 namespace yb {
+
+class ThreadPool;
+
 namespace tablet {
 
 class TabletRetentionPolicy;
@@ -107,7 +110,8 @@ class AbstractTablet {
       const ReadHybridTime& read_time,
       const QLReadRequestPB& ql_read_request,
       const TransactionOperationContext& txn_op_context,
-      QLReadRequestResult* result);
+      QLReadRequestResult* result,
+      docdb::QLRowCache* row_cache = nullptr);
 
   virtual CHECKED_STATUS CreatePagingStateForRead(const PgsqlReadRequestPB& pgsql_read_request,
                                                   const size_t row_count,
@@ -118,6 +122,7 @@ class AbstractTablet {
                                         bool is_explicit_request_read_time,
                                         const PgsqlReadRequestPB& pgsql_read_request,
                                         const TransactionOperationContext& txn_op_context,
+                                        ThreadPool* read_pool,
                                         PgsqlReadRequestResult* result,
                                         size_t* num_rows_read);
 
@@ -328,6 +328,30 @@ TEST_F(MvccTest, RandomWithHTLease) {
   RunRandomizedTest(true);
 }
 
+TEST_F(MvccTest, SafeTimeWithOlderLease) {
+  HybridTime ht1 = manager_.AddLeaderPending(OpId(1, 1));
+  HybridTime ht2 = manager_.AddLeaderPending(OpId(1, 2));
+  auto time = clock_->Now();
+  FixedHybridTimeLease ht_lease {
+    .time = time,
+    .lease = time,
+  };
+  ASSERT_EQ(ht1.Decremented(), manager_.SafeTime(ht_lease));
+
+  manager_.Replicated(ht1, OpId(1, 1));
+  ASSERT_EQ(ht2.Decremented(), manager_.SafeTime(ht_lease));
+
+  // Safe time should not go backwards when an older lease is passed.
+  FixedHybridTimeLease older_ht_lease {
+    .time = ht1,
+    .lease = ht1,
+  };
+  ASSERT_EQ(ht2.Decremented(), manager_.SafeTime(older_ht_lease));
+
+  manager_.Replicated(ht2, OpId(1, 2));
+  ASSERT_GE(manager_.SafeTime(older_ht_lease), ht2);
+}
+
 TEST_F(MvccTest, WaitForSafeTime) {
   constexpr uint64_t kLease = 10;
   constexpr uint64_t kDelta = 10;
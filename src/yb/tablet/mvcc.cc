@@ -43,6 +43,8 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/wait_state.h"
 
 using namespace std::literals;
 
@@ -150,6 +152,29 @@ struct SafeTimeForFollowerTraceItem {
   }
 };
 
+// Waits until predicate is satisfied or deadline happens, returns false in the latter case.
+// Time spent waiting is recorded to wait_latency, if it is set.
+template <class Predicate>
+bool WaitForSafeTime(
+    std::condition_variable* cond, std::unique_lock<std::mutex>* lock, CoarseTimePoint deadline,
+    Histogram* wait_latency, const Predicate& predicate) {
+  if (predicate()) {
+    return true;
+  }
+  ScopedWaitEvent wait_event(WaitEvent::kSafeTime);
+  auto start = CoarseMonoClock::now();
+  bool result = true;
+  if (deadline == CoarseTimePoint::max()) {
+    cond->wait(*lock, predicate);
+  } else {
+    result = cond->wait_until(*lock, deadline, predicate);
+  }
+  if (wait_latency) {
+    wait_latency->Increment(MonoDelta(CoarseMonoClock::now() - start).ToMicroseconds());
+  }
+  return result;
+}
+
 struct LastReplicatedHybridTimeTraceItem {
   HybridTime last_replicated;
 
@@ -200,10 +225,12 @@ class MvccManager::MvccOpTrace {
   ~MvccOpTrace() = default;
 
   void Add(TraceItemVariant v) {
+    std::lock_guard<std::mutex> lock(mutex_);
     items_.push_back(std::move(v));
   }
 
   void DumpTrace(ostream* out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
     if (items_.empty()) {
       *out << "No MVCC operations" << std::endl;
       return;
@@ -217,6 +244,7 @@ class MvccManager::MvccOpTrace {
   }
 
  private:
+  mutable std::mutex mutex_;
   boost::circular_buffer_space_optimized<TraceItemVariant, std::allocator<TraceItemVariant>> items_;
 };
 
@@ -271,6 +299,7 @@ void MvccManager::Replicated(HybridTime ht, const OpId& op_id) {
              (QueueItem{ .hybrid_time = ht, .op_id = op_id })) << InvariantViolationLogPrefix();
     queue_.pop_front();
     last_replicated_ = ht;
+    PublishSafeTime();
   }
   cond_.notify_all();
 }
@@ -288,6 +317,7 @@ void MvccManager::Aborted(HybridTime ht, const OpId& op_id) {
              (QueueItem{ .hybrid_time = ht, .op_id = op_id }))
         << InvariantViolationLogPrefix() << "It is allowed to abort only last operation";
     queue_.pop_back();
+    PublishSafeTime();
   }
   cond_.notify_all();
 }
@@ -403,6 +433,32 @@ void MvccManager::AddPending(HybridTime ht, const OpId& op_id, bool is_follower_
     .hybrid_time = ht,
     .op_id = op_id,
   });
+  if (queue_.size() == 1) {
+    PublishSafeTime();
+  }
+}
+
+void MvccManager::PublishSafeTime() {
+  auto safe_time = queue_.empty()
+      ? HybridTime::kInvalid : std::max(queue_.front().hybrid_time.Decremented(), last_replicated_);
+  published_safe_time_.store(safe_time.ToUint64(), std::memory_order_release);
+}
+
+HybridTime MvccManager::PublishedSafeTime(
+    HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const {
+  // Operations added after the published value was loaded get hybrid time after the last
+  // operation in queue, so the published value is still safe even if the queue has changed.
+  HybridTime result(published_safe_time_.load(std::memory_order_acquire));
+  if (!result.is_valid() || result < min_allowed) {
+    return HybridTime::kInvalid;
+  }
+  if (!ht_lease.empty()) {
+    if (result > ht_lease.lease) {
+      return HybridTime::kInvalid;
+    }
+    UpdateAtomicMax(&max_published_safe_time_returned_with_lease_, result.ToUint64());
+  }
+  return result;
 }
 
 void MvccManager::SetLastReplicated(HybridTime ht) {
@@ -414,6 +470,7 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
       op_trace_->Add(SetLastReplicatedTraceItem { .ht = ht });
     }
     last_replicated_ = ht;
+    PublishSafeTime();
   }
   cond_.notify_all();
 }
@@ -487,6 +544,10 @@ void MvccManager::SetLeaderOnlyMode(bool leader_only) {
   leader_only_mode_ = leader_only;
 }
 
+void MvccManager::SetSafeTimeWaitHistogram(scoped_refptr<Histogram> wait_latency) {
+  safe_time_wait_latency_ = std::move(wait_latency);
+}
+
 // NO_THREAD_SAFETY_ANALYSIS because this analysis does not work with unique_lock.
 HybridTime MvccManager::SafeTimeForFollower(
     HybridTime min_allowed, CoarseTimePoint deadline) const NO_THREAD_SAFETY_ANALYSIS {
@@ -516,9 +577,7 @@ HybridTime MvccManager::SafeTimeForFollower(
     }
     return result.safe_time >= min_allowed;
   };
-  if (deadline == CoarseTimePoint::max()) {
-    cond_.wait(lock, predicate);
-  } else if (!cond_.wait_until(lock, deadline, predicate)) {
+  if (!WaitForSafeTime(&cond_, &lock, deadline, safe_time_wait_latency_.get(), predicate)) {
     return HybridTime::kInvalid;
   }
   VLOG_WITH_PREFIX(1) << "SafeTimeForFollower(" << min_allowed
@@ -544,8 +603,11 @@ HybridTime MvccManager::SafeTime(
     HybridTime min_allowed,
     CoarseTimePoint deadline,
     const FixedHybridTimeLease& ht_lease) const NO_THREAD_SAFETY_ANALYSIS {
-  std::unique_lock<std::mutex> lock(mutex_);
-  auto safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
+  auto safe_time = PublishedSafeTime(min_allowed, ht_lease);
+  if (!safe_time) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
+  }
   if (op_trace_) {
     op_trace_->Add(SafeTimeTraceItem {
       .min_allowed = min_allowed,
@@ -573,12 +635,19 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
     LOG_IF_WITH_PREFIX(DFATAL, !ht_lease.time.is_valid()) << "Bad ht lease: " << ht_lease;
   }
 
+  // Safe time returned by PublishedSafeTime with lease is tracked separately, but should be also
+  // respected here.
+  const auto max_safe_time_returned_with_lease = std::max(
+      max_safe_time_returned_with_lease_.safe_time,
+      HybridTime(max_published_safe_time_returned_with_lease_.load(std::memory_order_acquire)));
+
   HybridTime result;
   SafeTimeSource source = SafeTimeSource::kUnknown;
-  auto predicate = [this, &result, &source, min_allowed, ht_lease, has_lease] {
+  auto predicate = [this, &result, &source, min_allowed, ht_lease, has_lease,
+                    max_safe_time_returned_with_lease] {
     if (queue_.empty()) {
       result = ht_lease.time.is_valid()
-          ? std::max(max_safe_time_returned_with_lease_.safe_time, ht_lease.time)
+          ? std::max(max_safe_time_returned_with_lease, ht_lease.time)
           : clock_->Now();
       source = SafeTimeSource::kNow;
       VLOG_WITH_PREFIX(2) << "DoGetSafeTime, Now: " << result;
@@ -589,7 +658,7 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
     }
 
     if (has_lease) {
-      auto used_lease = std::max({ht_lease.lease, max_safe_time_returned_with_lease_.safe_time});
+      auto used_lease = std::max({ht_lease.lease, max_safe_time_returned_with_lease});
       if (result > used_lease) {
         result = used_lease;
         source = SafeTimeSource::kHybridTimeLease;
@@ -605,9 +674,7 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
 
   // In the case of an empty queue, the safe hybrid time to read at is only limited by hybrid time
   // ht_lease, which is by definition higher than min_allowed, so we would not get blocked.
-  if (deadline == CoarseTimePoint::max()) {
-    cond_.wait(*lock, predicate);
-  } else if (!cond_.wait_until(*lock, deadline, predicate)) {
+  if (!WaitForSafeTime(&cond_, lock, deadline, safe_time_wait_latency_.get(), predicate)) {
     return HybridTime::kInvalid;
   }
   VLOG_WITH_PREFIX_AND_FUNC(1)
@@ -645,14 +712,11 @@ HybridTime MvccManager::LastReplicatedHybridTime() const {
   return last_replicated_;
 }
 
-// Using NO_THREAD_SAFETY_ANALYSIS here because we're only reading op_trace_ here and it is set
-// in the constructor.
 MvccManager::InvariantViolationLoggingHelper MvccManager::InvariantViolationLogPrefix() const {
   return { prefix_, op_trace_.get() };
 }
 
-// Ditto regarding NO_THREAD_SAFETY_ANALYSIS.
-void MvccManager::TEST_DumpTrace(std::ostream* out) NO_THREAD_SAFETY_ANALYSIS {
+void MvccManager::TEST_DumpTrace(std::ostream* out) {
   if (op_trace_)
     op_trace_->DumpTrace(out);
 }
@@ -32,6 +32,7 @@
 #ifndef YB_TABLET_MVCC_H_
 #define YB_TABLET_MVCC_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <vector>
@@ -42,6 +43,7 @@
 
 #include "yb/util/enums.h"
 #include "yb/util/math_util.h"
+#include "yb/util/metrics_fwd.h"
 #include "yb/util/opid.h"
 
 namespace yb {
@@ -80,6 +82,9 @@ inline std::ostream& operator<<(std::ostream& out, const FixedHybridTimeLease& h
 // methods.
 // Operations could be replicated only in the same order as they were added.
 // Time of newly added operation should be after time of all previously added operations.
+//
+// While there are tracked operations, safe time is determined by the first operation in queue.
+// It is published by writers, so SafeTime could return it without acquiring the mutex.
 class MvccManager {
  public:
   // `prefix` is used for logging.
@@ -90,6 +95,9 @@ class MvccManager {
   // there are no heartbeats to update internal propagated_safe_time_ correctly.
   void SetLeaderOnlyMode(bool leader_only) EXCLUDES(mutex_);
 
+  // Sets histogram to track time spent waiting for safe time to reach min_allowed.
+  void SetSafeTimeWaitHistogram(scoped_refptr<Histogram> wait_latency);
+
   // Sets time of last replicated operation, used after bootstrap.
   void SetLastReplicated(HybridTime ht) EXCLUDES(mutex_);
 
@@ -157,6 +165,15 @@ class MvccManager {
                            const FixedHybridTimeLease& ht_lease,
                            std::unique_lock<std::mutex>* lock) const REQUIRES(mutex_);
 
+  // Returns safe time published by writers, without acquiring the mutex. Returns invalid hybrid
+  // time when the published value is not available or does not satisfy provided requirements,
+  // in this case safe time should be calculated under the mutex.
+  HybridTime PublishedSafeTime(HybridTime min_allowed, const FixedHybridTimeLease& ht_lease) const;
+
+  // Publishes safe time determined by the queue, should be invoked after each change of queue_
+  // or last_replicated_.
+  void PublishSafeTime() REQUIRES(mutex_);
+
   const std::string& LogPrefix() const { return prefix_; }
 
   struct InvariantViolationLoggingHelper;
@@ -212,7 +229,19 @@ class MvccManager {
   mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
 
-  std::unique_ptr<MvccOpTrace> op_trace_ GUARDED_BY(mutex_);
+  // Max of the safe time, determined by the first operation in queue, and last_replicated_.
+  // Invalid when queue is empty, since safe time depends on the current time in this case.
+  std::atomic<HybridTimeRepr> published_safe_time_{kInvalidHybridTimeValue};
+
+  // Max published safe time returned with lease. Safe time calculated under the mutex should not
+  // be less than it, as for max_safe_time_returned_with_lease_.
+  mutable std::atomic<HybridTimeRepr> max_published_safe_time_returned_with_lease_{
+      kMinHybridTimeValue};
+
+  scoped_refptr<Histogram> safe_time_wait_latency_;
+
+  // Internally synchronized, because it is also used by SafeTime without acquiring the mutex.
+  std::unique_ptr<MvccOpTrace> op_trace_;
 };
 
 }  // namespace tablet
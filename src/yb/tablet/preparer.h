@@ -38,6 +38,11 @@ class PreparerImpl;
 // leader-side transactions, submits them for replication to the consensus in batches. This is
 // useful because we have a "fat lock" in the consensus.
 // Preparer does not manage a thread but only submits to a token in a thread pool.
+//
+// Heavy preparation of writes, i.e. key lock acquisition, doc path computation and conflict
+// resolution, is performed by WriteQuery before the operation is submitted, so it already runs in
+// parallel for concurrent writes. Operation::Prepare for operations that could be batched is
+// trivial, so the preparer thread is mostly busy with preserving the replication order.
 class Preparer {
  public:
   explicit Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool);
@@ -13,10 +13,22 @@
 
 #include "yb/tablet/remove_intents_task.h"
 
+#include <algorithm>
+
+#include <gflags/gflags.h>
+
 #include "yb/tablet/running_transaction.h"
 #include "yb/tablet/transaction_participant_context.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 
+DEFINE_int32(max_transactions_in_remove_intents_batch, 64,
+             "Max number of finished transactions whose intents are removed by a single remove "
+             "intents task, using the same intents write batch. 1 means that intents of each "
+             "transaction are removed separately.");
+TAG_FLAG(max_transactions_in_remove_intents_batch, advanced);
+TAG_FLAG(max_transactions_in_remove_intents_batch, runtime);
+
 namespace yb {
 namespace tablet {
 
@@ -40,15 +52,24 @@ bool RemoveIntentsTask::Prepare(RunningTransactionPtr transaction) {
 }
 
 void RemoveIntentsTask::Run() {
-  VLOG_WITH_PREFIX(2) << "Remove intents";
+  // Transactions are queued before their tasks are enqueued, so when some task takes intents of
+  // other transactions, their own tasks find nothing to do.
+  auto ids = running_transaction_context_.TakeIntentsToRemove(
+      std::max(FLAGS_max_transactions_in_remove_intents_batch, 1));
+  if (ids.empty()) {
+    VLOG_WITH_PREFIX(2) << "Intents of " << id_ << " already removed";
+    return;
+  }
+
+  VLOG_WITH_PREFIX(2) << "Remove intents of " << ids.size() << " transactions";
 
   RemoveIntentsData data;
   auto status = participant_context_.GetLastReplicatedData(&data);
   if (status.ok()) {
-    status = applier_.RemoveIntents(data, id_);
+    status = applier_.RemoveIntents(data, ids);
   }
   LOG_IF_WITH_PREFIX(WARNING, !status.ok())
-      << "Failed to remove intents of aborted transaction: " << status;
+      << "Failed to remove intents of " << ids.size() << " transactions: " << status;
   VLOG_WITH_PREFIX(2) << "Removed intents";
 }
 
@@ -18,6 +18,7 @@
 #include "yb/common/hybrid_time.h"
 #include "yb/common/pgsql_error.h"
 
+#include "yb/tablet/shared_transaction_status_cache.h"
 #include "yb/tablet/transaction_participant_context.h"
 
 #include "yb/tserver/tserver_service.pb.h"
@@ -114,6 +115,22 @@ void RunningTransaction::RequestStatusAt(const StatusRequest& request,
       return;
     }
   }
+  auto shared_commit_data = context_.shared_status_cache_
+      ? context_.shared_status_cache_->Lookup(id()) : boost::none;
+  if (shared_commit_data) {
+    VLOG_WITH_PREFIX(4) << "Committed at " << shared_commit_data->commit_ht
+                        << " according to shared status cache";
+    UpdateStatus(TransactionStatus::COMMITTED, shared_commit_data->commit_ht, HybridTime(),
+                 shared_commit_data->aborted_subtxn_set);
+    auto transaction_status = GetStatusAt(
+        request.global_limit_ht, shared_commit_data->commit_ht, TransactionStatus::COMMITTED);
+    lock->unlock();
+    request.callback(TransactionStatusResult{
+        *transaction_status, shared_commit_data->commit_ht,
+        transaction_status == TransactionStatus::COMMITTED
+            ? shared_commit_data->aborted_subtxn_set : AbortedSubTransactionSet()});
+    return;
+  }
   bool was_empty = status_waiters_.empty();
   status_waiters_.push_back(request);
   if (!was_empty) {
@@ -184,6 +201,7 @@ std::string RunningTransaction::ToString() const {
 
 void RunningTransaction::ScheduleRemoveIntents(const RunningTransactionPtr& shared_self) {
   if (remove_intents_task_.Prepare(shared_self)) {
+    context_.QueueIntentsToRemove(id());
     context_.participant_context_.StrandEnqueue(&remove_intents_task_);
     VLOG_WITH_PREFIX(1) << "Intents should be removed asynchronously";
   }
@@ -343,6 +361,10 @@ void RunningTransaction::DoStatusReceived(const Status& status,
     time_of_status = last_known_status_hybrid_time_;
     transaction_status = last_known_status_;
     aborted_subtxn_set = local_commit_aborted_subtxn_set_;
+    if (transaction_status == TransactionStatus::COMMITTED && context_.shared_status_cache_) {
+      context_.shared_status_cache_->Committed(
+          id(), CommitMetadata{time_of_status, aborted_subtxn_set});
+    }
 
     status_waiters = ExtractFinishedStatusWaitersUnlocked(
         serial_no, time_of_status, transaction_status);
@@ -16,6 +16,7 @@
 
 #include <stdint.h>
 
+#include <deque>
 #include <functional>
 #include <mutex>
 #include <type_traits>
@@ -66,8 +67,10 @@ YB_DEFINE_ENUM(RemoveReason,
 class RunningTransactionContext {
  public:
   RunningTransactionContext(TransactionParticipantContext* participant_context,
-                            TransactionIntentApplier* applier)
-      : participant_context_(*participant_context), applier_(*applier) {
+                            TransactionIntentApplier* applier,
+                            SharedTransactionStatusCache* shared_status_cache)
+      : participant_context_(*participant_context), applier_(*applier),
+        shared_status_cache_(shared_status_cache) {
   }
 
   virtual ~RunningTransactionContext() {}
@@ -90,15 +93,39 @@ class RunningTransactionContext {
 
   virtual bool Closing() const = 0;
 
+  // Queues transaction, whose intents should be removed. Intents of queued transactions are
+  // removed in batches by RemoveIntentsTask, so a single intents write batch covers multiple
+  // transactions that finished close to each other.
+  void QueueIntentsToRemove(const TransactionId& id) {
+    std::lock_guard<std::mutex> lock(remove_intents_mutex_);
+    intents_to_remove_.push_back(id);
+  }
+
+  // Takes up to max_size transactions from the remove intents queue, in the order they were queued.
+  TransactionIdSet TakeIntentsToRemove(size_t max_size) {
+    TransactionIdSet result;
+    std::lock_guard<std::mutex> lock(remove_intents_mutex_);
+    while (!intents_to_remove_.empty() && result.size() < max_size) {
+      result.insert(intents_to_remove_.front());
+      intents_to_remove_.pop_front();
+    }
+    return result;
+  }
+
  protected:
   friend class RunningTransaction;
 
   rpc::Rpcs rpcs_;
   TransactionParticipantContext& participant_context_;
   TransactionIntentApplier& applier_;
+  // Cache of transaction statuses shared by all tablets of the tablet server, could be null.
+  SharedTransactionStatusCache* const shared_status_cache_;
   int64_t request_serial_ = 0;
   std::mutex mutex_;
 
+  std::mutex remove_intents_mutex_;
+  std::deque<TransactionId> intents_to_remove_;
+
   // Used only in tests.
   Delayer delayer_;
 };
@@ -0,0 +1,81 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <thread>
+
+#include "yb/tablet/shared_transaction_status_cache.h"
+
+#include "yb/util/test_util.h"
+
+using namespace std::literals;
+
+namespace yb {
+namespace tablet {
+
+class SharedTransactionStatusCacheTest : public YBTest {
+};
+
+TEST_F(SharedTransactionStatusCacheTest, Simple) {
+  SharedTransactionStatusCache cache(1000, 1h);
+  auto id = TransactionId::GenerateRandom();
+  ASSERT_FALSE(cache.Lookup(id));
+
+  AbortedSubTransactionSet aborted;
+  ASSERT_OK(aborted.SetRange(2, 2));
+  cache.Committed(id, CommitMetadata{HybridTime(1000), aborted});
+  auto commit_data = cache.Lookup(id);
+  ASSERT_TRUE(commit_data);
+  ASSERT_EQ(commit_data->commit_ht, HybridTime(1000));
+  ASSERT_TRUE(commit_data->aborted_subtxn_set.Test(2));
+  ASSERT_FALSE(cache.Lookup(TransactionId::GenerateRandom()));
+
+  // Commit data of a transaction is final, so repeated notification does not change it.
+  cache.Committed(id, CommitMetadata{HybridTime(1000), aborted});
+  ASSERT_EQ(cache.TEST_size(), 1U);
+}
+
+TEST_F(SharedTransactionStatusCacheTest, Capacity) {
+  constexpr size_t kCapacity = 160;
+  constexpr size_t kTransactions = kCapacity * 10;
+  SharedTransactionStatusCache cache(kCapacity, 1h);
+  std::vector<TransactionId> ids;
+  for (size_t i = 0; i != kTransactions; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+    cache.Committed(ids.back(), CommitMetadata{HybridTime(i + 1), AbortedSubTransactionSet()});
+    ASSERT_LE(cache.TEST_size(), kCapacity);
+  }
+  // The most recently committed transaction is never evicted.
+  auto commit_data = cache.Lookup(ids.back());
+  ASSERT_TRUE(commit_data);
+  ASSERT_EQ(commit_data->commit_ht, HybridTime(kTransactions));
+
+  size_t found = 0;
+  for (const auto& id : ids) {
+    found += cache.Lookup(id) ? 1 : 0;
+  }
+  ASSERT_LE(found, kCapacity);
+  ASSERT_GT(found, 0U);
+}
+
+TEST_F(SharedTransactionStatusCacheTest, Expiration) {
+  SharedTransactionStatusCache cache(1000, 100ms);
+  auto id = TransactionId::GenerateRandom();
+  cache.Committed(id, CommitMetadata{HybridTime(1000), AbortedSubTransactionSet()});
+  ASSERT_TRUE(cache.Lookup(id));
+  std::this_thread::sleep_for(200ms);
+  ASSERT_FALSE(cache.Lookup(id));
+  ASSERT_EQ(cache.TEST_size(), 0U);
+}
+
+} // namespace tablet
+} // namespace yb
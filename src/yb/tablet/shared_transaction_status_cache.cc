@@ -0,0 +1,146 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/shared_transaction_status_cache.h"
+
+#include <algorithm>
+#include <array>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Number of independently locked parts of the cache. Transaction ids are random, so they are
+// evenly distributed between shards.
+constexpr size_t kNumShards = 16;
+
+struct CacheEntry {
+  TransactionId id;
+  CommitMetadata commit_data;
+  CoarseTimePoint expiration;
+};
+
+class CacheShard {
+ public:
+  CacheShard(size_t capacity, MonoDelta ttl) : capacity_(capacity), ttl_(ttl) {}
+
+  void Committed(const TransactionId& id, const CommitMetadata& commit_data) {
+    auto expiration = CoarseMonoClock::now() + ttl_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& index = entries_.get<IdTag>();
+    auto it = index.find(id);
+    if (it != index.end()) {
+      // Commit data of transaction does not change, so we only have to refresh expiration.
+      index.modify(it, [expiration](CacheEntry& entry) { entry.expiration = expiration; });
+      entries_.relocate(entries_.end(), entries_.project<0>(it));
+      return;
+    }
+    entries_.push_back(CacheEntry{id, commit_data, expiration});
+    while (entries_.size() > capacity_) {
+      entries_.pop_front();
+    }
+  }
+
+  boost::optional<CommitMetadata> Lookup(const TransactionId& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& index = entries_.get<IdTag>();
+    auto it = index.find(id);
+    if (it == index.end()) {
+      return boost::none;
+    }
+    if (it->expiration <= CoarseMonoClock::now()) {
+      index.erase(it);
+      return boost::none;
+    }
+    return it->commit_data;
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  class IdTag;
+
+  typedef boost::multi_index_container<CacheEntry,
+      boost::multi_index::indexed_by <
+          boost::multi_index::sequenced <>,
+          boost::multi_index::hashed_unique <
+              boost::multi_index::tag<IdTag>,
+              boost::multi_index::member<CacheEntry, TransactionId, &CacheEntry::id>,
+              TransactionIdHash>
+      >
+  > Entries;
+
+  const size_t capacity_;
+  const MonoDelta ttl_;
+  std::mutex mutex_;
+  Entries entries_;
+};
+
+} // namespace
+
+class SharedTransactionStatusCache::Impl {
+ public:
+  Impl(size_t capacity, MonoDelta ttl) {
+    const auto shard_capacity = std::max<size_t>((capacity + kNumShards - 1) / kNumShards, 1);
+    for (auto& shard : shards_) {
+      shard = std::make_unique<CacheShard>(shard_capacity, ttl);
+    }
+  }
+
+  CacheShard& ShardFor(const TransactionId& id) {
+    return *shards_[TransactionIdHash()(id) % kNumShards];
+  }
+
+  size_t size() {
+    size_t result = 0;
+    for (auto& shard : shards_) {
+      result += shard->size();
+    }
+    return result;
+  }
+
+ private:
+  std::array<std::unique_ptr<CacheShard>, kNumShards> shards_;
+};
+
+SharedTransactionStatusCache::SharedTransactionStatusCache(size_t capacity, MonoDelta ttl)
+    : impl_(new Impl(capacity, ttl)) {
+}
+
+SharedTransactionStatusCache::~SharedTransactionStatusCache() {
+}
+
+void SharedTransactionStatusCache::Committed(
+    const TransactionId& id, const CommitMetadata& commit_data) {
+  impl_->ShardFor(id).Committed(id, commit_data);
+}
+
+boost::optional<CommitMetadata> SharedTransactionStatusCache::Lookup(const TransactionId& id) {
+  return impl_->ShardFor(id).Lookup(id);
+}
+
+size_t SharedTransactionStatusCache::TEST_size() {
+  return impl_->size();
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,62 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_SHARED_TRANSACTION_STATUS_CACHE_H
+#define YB_TABLET_SHARED_TRANSACTION_STATUS_CACHE_H
+
+#include <memory>
+#include <mutex>
+
+#include <boost/optional/optional.hpp>
+
+#include "yb/common/transaction.h"
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tablet {
+
+// Caches commit data of transactions, shared by all tablets of a tablet server.
+// It is fed by transactions applied by local tablets and by status replies of transaction
+// coordinators, and consulted by participants before requesting transaction status from the
+// coordinator. So a transaction that touches many tablets of the same tablet server is resolved
+// once, instead of once per tablet.
+//
+// Only committed transactions are cached. Coordinator replies ABORTED for transactions it does not
+// know, including committed transactions whose status record was already removed, so aborted
+// status could not be shared between tablets.
+//
+// Capacity is bounded, the oldest entries are evicted first. Entries also expire after ttl.
+// Thread safe.
+class SharedTransactionStatusCache {
+ public:
+  SharedTransactionStatusCache(size_t capacity, MonoDelta ttl);
+  ~SharedTransactionStatusCache();
+
+  // Remembers that transaction was committed with specified commit data.
+  void Committed(const TransactionId& id, const CommitMetadata& commit_data);
+
+  // Returns commit data of the transaction, if it is known to be committed.
+  boost::optional<CommitMetadata> Lookup(const TransactionId& id);
+
+  size_t TEST_size();
+
+ private:
+  class Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_SHARED_TRANSACTION_STATUS_CACHE_H
@@ -32,6 +32,9 @@
 
 #include "yb/tablet/tablet.h"
 
+#include <algorithm>
+#include <deque>
+
 #include <boost/container/static_vector.hpp>
 
 #include "yb/client/client.h"
@@ -59,6 +62,7 @@
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/doc_write_batch.h"
 #include "yb/docdb/docdb.h"
@@ -66,14 +70,20 @@
 #include "yb/docdb/docdb_compaction_filter_intents.h"
 #include "yb/docdb/docdb_debug.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
+#include "yb/docdb/intent_keys_filter.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
+#include "yb/docdb/ql_row_cache.h"
 #include "yb/docdb/redis_operation.h"
 #include "yb/docdb/rocksdb_writer.h"
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
 
 #include "yb/gutil/casts.h"
+#include "yb/gutil/endian.h"
 
 #include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/utilities/checkpoint.h"
 
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -158,6 +168,13 @@ DEFINE_int32(num_raft_ops_to_force_idle_intents_db_to_flush, 1000,
 DEFINE_bool(delete_intents_sst_files, true,
             "Delete whole intents .SST files when possible.");
 
+DEFINE_bool(erase_intents_from_immutable_memtables, false,
+            "Erase removed intents from intents memtables that were switched but not flushed yet, "
+            "instead of writing deletion marks. Such memtables are waiting for the regular DB "
+            "flush, so intents of transactions that finish meanwhile never reach intents SST "
+            "files.");
+TAG_FLAG(erase_intents_from_immutable_memtables, advanced);
+
 DEFINE_uint64(backfill_index_write_batch_size, 128, "The batch size for backfilling the index.");
 TAG_FLAG(backfill_index_write_batch_size, advanced);
 TAG_FLAG(backfill_index_write_batch_size, runtime);
@@ -169,6 +186,27 @@ DEFINE_int32(backfill_index_rate_rows_per_sec, 0, "Rate of at which the "
 TAG_FLAG(backfill_index_rate_rows_per_sec, advanced);
 TAG_FLAG(backfill_index_rate_rows_per_sec, runtime);
 
+DEFINE_int64(ql_row_cache_size_bytes, 0,
+             "Size of per-tablet cache of rows returned by YCQL point reads of non-transactional "
+             "tables. 0 disables the cache.");
+TAG_FLAG(ql_row_cache_size_bytes, advanced);
+
+DEFINE_bool(enable_intent_keys_filter, true,
+            "Keep per-tablet in-memory filter of keys that have intents, so conflict resolution "
+            "does not seek the intents DB for keys that definitely have no intents.");
+TAG_FLAG(enable_intent_keys_filter, advanced);
+
+DEFINE_uint64(intent_keys_filter_num_counters, 64 * 1024,
+              "Number of 2 byte counters in the per-tablet intent keys filter.");
+TAG_FLAG(intent_keys_filter_num_counters, advanced);
+
+DEFINE_uint64(rocksdb_cold_tier_min_file_size_bytes, 4ULL << 30,
+              "Compactions of the regular DB that are expected to produce files of at least this "
+              "size write them to the cold data directory of the tablet, when it has one. Smaller "
+              "files, which are also the most recently written ones, stay on the primary data "
+              "directory.");
+TAG_FLAG(rocksdb_cold_tier_min_file_size_bytes, advanced);
+
 DEFINE_uint64(verify_index_read_batch_size, 128, "The batch size for reading the index.");
 TAG_FLAG(verify_index_read_batch_size, advanced);
 TAG_FLAG(verify_index_read_batch_size, runtime);
@@ -221,6 +259,12 @@ DEFINE_bool(tablet_enable_ttl_file_filter, false,
             "Enables compaction to directly delete files that have expired based on TTL, "
             "rather than removing them via the normal compaction process.");
 
+DEFINE_bool(regular_tablets_concurrent_memtable_write, false,
+            "Allow write batches that are grouped together by the regular RocksDB write thread to "
+            "be inserted into the mem table concurrently. Not applicable to the intents DB, "
+            "since it relies on in memory erase, that is supported by single writer mem table "
+            "only.");
+
 DEFINE_test_flag(int32, slowdown_backfill_by_ms, 0,
                  "If set > 0, slows down the backfill process by this amount.");
 
@@ -257,7 +301,10 @@ DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
+DECLARE_int32(txn_max_apply_batch_records);
 DECLARE_string(regular_tablets_data_block_key_value_encoding);
+DECLARE_bool(regular_tablets_store_data_block_boundaries);
+DECLARE_bool(regular_tablets_data_block_hash_index);
 
 DEFINE_test_flag(uint64, inject_sleep_before_applying_intents_ms, 0,
                  "Sleep before applying intents to docdb after transaction commit");
@@ -413,6 +460,8 @@ Tablet::Tablet(const TabletInitData& data)
              : rocksdb::CreateDBStatistics(table_metrics_entity_, nullptr, true));
 
     metrics_.reset(new TabletMetrics(table_metrics_entity_, tablet_metrics_entity_));
+    shared_lock_manager_.SetWaitLatencyHistogram(metrics_->key_lock_wait_latency);
+    mvcc_.SetSafeTimeWaitHistogram(metrics_->safe_time_wait_latency);
 
     mem_tracker_->SetMetricEntity(tablet_metrics_entity_);
   }
@@ -423,11 +472,17 @@ Tablet::Tablet(const TabletInitData& data)
   if (transactional) {
     server::HybridClock::EnableClockSkewControl();
   }
+  if (FLAGS_ql_row_cache_size_bytes > 0 && table_type_ == TableType::YQL_TABLE_TYPE &&
+      !transactional && !is_sys_catalog_) {
+    ql_row_cache_ = std::make_unique<docdb::QLRowCache>(
+        FLAGS_ql_row_cache_size_bytes, mem_tracker_);
+  }
   if (txns_enabled_ &&
       data.transaction_participant_context &&
       (is_sys_catalog_ || transactional)) {
     transaction_participant_ = std::make_unique<TransactionParticipant>(
-        data.transaction_participant_context, this, tablet_metrics_entity_);
+        data.transaction_participant_context, this,
+        data.tablet_options.transaction_status_cache.get(), tablet_metrics_entity_);
     // Create transaction manager for secondary index update.
     if (has_index) {
       transaction_manager_ = std::make_unique<client::TransactionManager>(
@@ -460,6 +515,8 @@ Tablet::Tablet(const TabletInitData& data)
 
   snapshot_coordinator_ = data.snapshot_coordinator;
 
+  read_pool_ = data.read_pool;
+
   if (metadata_->tablet_data_state() == TabletDataState::TABLET_DATA_SPLIT_COMPLETED) {
     SplitDone();
   }
@@ -562,8 +619,16 @@ Result<bool> Tablet::IntentsDbFlushFilter(const rocksdb::MemTable& memtable) {
 
   auto frontiers = memtable.Frontiers();
   if (frontiers) {
-    const auto& intents_largest =
-        down_cast<const docdb::ConsensusFrontier&>(frontiers->Largest());
+    auto intents_largest_index =
+        down_cast<const docdb::ConsensusFrontier&>(frontiers->Largest()).op_id().index;
+    // Intents erased from this memtable were removed by newer writes, so the regular DB should
+    // also flush those writes before the erase is persisted.
+    auto erase_frontiers = memtable.EraseFrontiers();
+    if (erase_frontiers) {
+      intents_largest_index = std::max(
+          intents_largest_index,
+          down_cast<const docdb::ConsensusFrontier&>(erase_frontiers->Largest()).op_id().index);
+    }
 
     // We allow to flush intents DB only after regular DB.
     // Otherwise we could lose applied intents when corresponding regular records were not
@@ -572,7 +637,7 @@ Result<bool> Tablet::IntentsDbFlushFilter(const rocksdb::MemTable& memtable) {
     if (regular_flushed_frontier) {
       const auto& regular_flushed_largest =
           static_cast<const docdb::ConsensusFrontier&>(*regular_flushed_frontier);
-      if (regular_flushed_largest.op_id().index >= intents_largest.op_id().index) {
+      if (regular_flushed_largest.op_id().index >= intents_largest_index) {
         VLOG_WITH_PREFIX(4) << __func__ << ", regular already flushed";
         return true;
       }
@@ -636,6 +701,11 @@ Status Tablet::OpenKeyValueTablet() {
   static const std::string kRegularDB = "RegularDB"s;
   static const std::string kIntentsDB = "IntentsDB"s;
 
+  // Tablet data could be replaced, e.g. by truncate or snapshot restore.
+  if (ql_row_cache_) {
+    ql_row_cache_->Clear();
+  }
+
   rocksdb::BlockBasedTableOptions table_options;
   if (!metadata()->primary_table_info()->index_info || metadata()->colocated()) {
     // This tablet is not dedicated to the index table, so it should be effective to use
@@ -645,6 +715,10 @@ Status Tablet::OpenKeyValueTablet() {
         VERIFY_RESULT(docdb::GetConfiguredKeyValueEncodingFormat(
             FLAGS_regular_tablets_data_block_key_value_encoding));
   }
+  table_options.store_data_block_boundaries = FLAGS_regular_tablets_store_data_block_boundaries;
+  if (FLAGS_regular_tablets_data_block_hash_index) {
+    table_options.data_block_hash_index_key_transformer = docdb::DocKeyExtractor();
+  }
   rocksdb::Options rocksdb_options;
   InitRocksDBOptions(
       &rocksdb_options, LogPrefix(docdb::StorageDbType::kRegular), std::move(table_options));
@@ -692,11 +766,32 @@ Status Tablet::OpenKeyValueTablet() {
   rocksdb_options.level0_stop_writes_trigger = std::numeric_limits<int>::max();
 
   rocksdb::Options regular_rocksdb_options(rocksdb_options);
+  // Files of the split parent that don't have keys of this tablet are dropped by compactions
+  // without being read.
+  if (key_bounds_.IsInitialized()) {
+    regular_rocksdb_options.compaction_file_filter_factory =
+        std::make_shared<docdb::DocDBCompactionFileFilterFactory>(
+            FLAGS_tablet_enable_ttl_file_filter ? retention_policy_ : nullptr, clock(),
+            &key_bounds_);
+  }
+  if (FLAGS_regular_tablets_concurrent_memtable_write) {
+    regular_rocksdb_options.allow_concurrent_memtable_write = true;
+    regular_rocksdb_options.enable_write_thread_adaptive_yield = true;
+    regular_rocksdb_options.memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
+        0 /* lookahead */, rocksdb::ConcurrentWrites::kTrue);
+  }
   regular_rocksdb_options.listeners.push_back(
       std::make_shared<RegularRocksDbListener>(this, regular_rocksdb_options.log_prefix));
 
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
+  const auto& cold_db_dir = metadata()->cold_rocksdb_dir();
+  if (!cold_db_dir.empty()) {
+    RETURN_NOT_OK_PREPEND(
+        metadata()->fs_manager()->CreateDirIfMissingAndSync(DirName(cold_db_dir)),
+        Format("Failed to create RocksDB cold table directory $0", DirName(cold_db_dir)));
+    AddColdTierDbPath(&regular_rocksdb_options);
+  }
 
   LOG(INFO) << "Opening RocksDB at: " << db_dir;
   rocksdb::DB* db = nullptr;
@@ -720,6 +815,8 @@ Status Tablet::OpenKeyValueTablet() {
     intents_rocksdb_options.mem_table_flush_filter_factory = MakeMemTableFlushFilterFactory([this] {
       return std::bind(&Tablet::IntentsDbFlushFilter, this, _1);
     });
+    intents_rocksdb_options.allow_immutable_memtable_erase =
+        FLAGS_erase_intents_from_immutable_memtables;
 
     intents_rocksdb_options.compaction_filter_factory =
         FLAGS_tablet_do_compaction_cleanup_for_intents ?
@@ -742,6 +839,14 @@ Status Tablet::OpenKeyValueTablet() {
         rocksdb::DB::Open(intents_rocksdb_options, db_dir + kIntentsDBSuffix, &intents_db));
     intents_db_.reset(intents_db);
     intents_db_->ListenFilesChanged(std::bind(&Tablet::CleanupIntentFiles, this));
+
+    if (FLAGS_enable_intent_keys_filter) {
+      if (!intent_keys_filter_) {
+        intent_keys_filter_ = std::make_unique<docdb::IntentKeysFilter>(
+            FLAGS_intent_keys_filter_num_counters);
+      }
+      RETURN_NOT_OK(intent_keys_filter_->Load(intents_db_.get()));
+    }
   }
 
   ql_storage_.reset(new docdb::QLRocksDBStorage(doc_db()));
@@ -1056,9 +1161,14 @@ Status Tablet::CompleteShutdownRocksDBs(
   if (destroy) {
     InitRocksDBOptions(&rocksdb_options, LogPrefix());
   }
+  // Regular DB files could also be located in the cold data directory.
+  rocksdb::Options regular_rocksdb_options(rocksdb_options);
+  if (destroy) {
+    AddColdTierDbPath(&regular_rocksdb_options);
+  }
 
   Status intents_status = ResetRocksDB(destroy, rocksdb_options, &intents_db_);
-  Status regular_status = ResetRocksDB(destroy, rocksdb_options, &regular_db_);
+  Status regular_status = ResetRocksDB(destroy, regular_rocksdb_options, &regular_db_);
   key_bounds_ = docdb::KeyBounds();
   // Reset rocksdb_shutdown_requested_ to the initial state like RocksDBs were never opened,
   // so we don't have to reset it on RocksDB open (we potentially can have several places in the
@@ -1115,8 +1225,18 @@ Result<std::unique_ptr<docdb::YQLRowwiseIteratorIf>> Tablet::NewRowIterator(
   return NewRowIterator(*table_info->schema, {}, table_id);
 }
 
+void Tablet::SetWitness(bool value) {
+  if (witness_.exchange(value, std::memory_order_acq_rel) != value) {
+    LOG_WITH_PREFIX(INFO) << (value ? "Became" : "Is not") << " a witness";
+  }
+}
+
 Status Tablet::ApplyRowOperations(
     WriteOperation* operation, AlreadyAppliedToRegularDB already_applied_to_regular_db) {
+  if (is_witness()) {
+    // Witness keeps written data in the WAL only.
+    return Status::OK();
+  }
   const auto& write_request =
       operation->consensus_round() && operation->consensus_round()->replicate_msg()
           // Online case.
@@ -1197,10 +1317,19 @@ Status Tablet::WriteTransactionalBatch(
   if (store_metadata) {
     writer.SetMetadataToStore(&put_batch.transaction());
   }
+  writer.SetIntentKeysFilter(intent_keys_filter_.get());
   rocksdb::WriteBatch write_batch;
   write_batch.SetDirectWriter(&writer);
   RequestScope request_scope(transaction_participant_.get());
 
+  if (!put_batch.write_pairs().empty()) {
+    auto min_max_key = std::minmax_element(
+        put_batch.write_pairs().begin(), put_batch.write_pairs().end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.key() < rhs.key(); });
+    transaction_participant()->RegisterIntentsKeyRange(
+        min_max_key.first->key(), min_max_key.second->key());
+  }
+
   WriteToRocksDB(frontiers, &write_batch, StorageDbType::kIntents);
 
   last_batch_data.hybrid_time = hybrid_time;
@@ -1251,6 +1380,10 @@ Status Tablet::ApplyKeyValueRowOperations(
       WriteToRocksDB(frontiers, &regular_write_batch, StorageDbType::kRegular);
     }
 
+    if (ql_row_cache_) {
+      InvalidateQLRowCache(put_batch, hybrid_time);
+    }
+
     if (snapshot_coordinator_) {
       for (const auto& pair : put_batch.write_pairs()) {
         WARN_NOT_OK(snapshot_coordinator_->ApplyWritePair(pair.key(), pair.value()),
@@ -1262,6 +1395,25 @@ Status Tablet::ApplyKeyValueRowOperations(
   return Status::OK();
 }
 
+void Tablet::InvalidateQLRowCache(
+    const docdb::KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time) {
+  if (!put_batch.apply_external_transactions().empty()) {
+    ql_row_cache_->Clear();
+    return;
+  }
+  for (const auto& pair : put_batch.write_pairs()) {
+    const auto& key = pair.key();
+    if (key.size() < 1 + sizeof(uint16_t) || key[0] != docdb::ValueTypeAsChar::kUInt16Hash) {
+      ql_row_cache_->Clear();
+      return;
+    }
+    MonoDelta ttl;
+    const bool has_ttl = !docdb::Value::DecodeTTL(pair.value(), &ttl).ok() ||
+                         !ttl.Equals(docdb::Value::kMaxTtl);
+    ql_row_cache_->Invalidate(BigEndian::Load16(key.data() + 1), hybrid_time, has_ttl);
+  }
+}
+
 void Tablet::WriteToRocksDB(
     const rocksdb::UserFrontiers* frontiers,
     rocksdb::WriteBatch* write_batch,
@@ -1363,7 +1515,7 @@ Status Tablet::HandleQLReadRequest(
       CreateTransactionOperationContext(transaction_metadata, /* is_ysql_catalog_table */ false);
   RETURN_NOT_OK(txn_op_ctx);
   return AbstractTablet::HandleQLReadRequest(
-      deadline, read_time, ql_read_request, *txn_op_ctx, result);
+      deadline, read_time, ql_read_request, *txn_op_ctx, result, ql_row_cache_.get());
 }
 
 CHECKED_STATUS Tablet::CreatePagingStateForRead(const QLReadRequestPB& ql_read_request,
@@ -1449,7 +1601,7 @@ Status Tablet::HandlePgsqlReadRequest(
   RETURN_NOT_OK(txn_op_ctx);
   return AbstractTablet::HandlePgsqlReadRequest(
       deadline, read_time, is_explicit_request_read_time,
-      pgsql_read_request, *txn_op_ctx, result, num_rows_read);
+      pgsql_read_request, *txn_op_ctx, read_pool_, result, num_rows_read);
 }
 
 // Returns true if the query can be satisfied by rows present in current tablet.
@@ -1682,7 +1834,11 @@ Status Tablet::WaitForFlush() {
 
 Status Tablet::ImportData(const std::string& source_dir) {
   // We import only regular records, so don't have to deal with intents here.
-  return regular_db_->Import(source_dir);
+  RETURN_NOT_OK(regular_db_->Import(source_dir));
+  if (ql_row_cache_) {
+    ql_row_cache_->Clear();
+  }
+  return Status::OK();
 }
 
 // We apply intents by iterating over whole transaction reverse index.
@@ -1697,6 +1853,10 @@ Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApply
   // transaction is done properly in the rare situation where the committed transaction's intents
   // are still in intents db and not yet in regular db.
   AtomicFlagSleepMs(&FLAGS_TEST_inject_sleep_before_applying_intents_ms);
+  if (is_witness()) {
+    // Witness does not write intents, so there is nothing to apply.
+    return docdb::ApplyTransactionState();
+  }
   docdb::ApplyIntentsContext context(
       data.transaction_id, data.apply_state, data.aborted, data.commit_ht, data.log_ht,
       &key_bounds_, intents_db_.get());
@@ -1709,41 +1869,91 @@ Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApply
   docdb::ConsensusFrontiers frontiers;
   auto frontiers_ptr = data.op_id.empty() ? nullptr : InitFrontiers(data, &frontiers);
   WriteToRocksDB(frontiers_ptr, &regular_write_batch, StorageDbType::kRegular);
+  // Tablets with row cache could only receive intents of external transactions, so it is
+  // cheaper to drop the whole cache than to track keys written by apply.
+  if (ql_row_cache_) {
+    ql_row_cache_->Clear();
+  }
   return context.apply_state();
 }
 
+namespace {
+
+// Applies intents writers of multiple transactions to the same write batch.
+class RemoveIntentsBatchWriter : public rocksdb::DirectWriter {
+ public:
+  explicit RemoveIntentsBatchWriter(std::deque<docdb::IntentsWriter>* writers)
+      : writers_(*writers) {}
+
+  CHECKED_STATUS Apply(rocksdb::DirectWriteHandler* handler) override {
+    for (auto& writer : writers_) {
+      RETURN_NOT_OK(writer.Apply(handler));
+    }
+    return Status::OK();
+  }
+
+ private:
+  std::deque<docdb::IntentsWriter>& writers_;
+};
+
+} // namespace
+
+// Intents of all passed transactions are removed using a single write batch, so transactions that
+// finished close to each other cost one intents DB write. Transactions that have more intents than
+// could be removed in one batch are continued in the following batches.
 template <class Ids>
 CHECKED_STATUS Tablet::RemoveIntentsImpl(const RemoveIntentsData& data, const Ids& ids) {
+  if (is_witness()) {
+    // Witness does not write intents, so there is nothing to remove.
+    return Status::OK();
+  }
   auto scoped_read_operation = CreateNonAbortableScopedRWOperation();
   RETURN_NOT_OK(scoped_read_operation);
 
-  rocksdb::WriteBatch intents_write_batch;
+  std::vector<std::pair<TransactionId, docdb::ApplyTransactionState>> pending;
   for (const auto& id : ids) {
-    boost::optional<docdb::ApplyTransactionState> apply_state;
-    for (;;) {
-      docdb::RemoveIntentsContext context(id);
-      docdb::IntentsWriter writer(
-          apply_state ? apply_state->key : Slice(), intents_db_.get(), &context);
-      intents_write_batch.SetDirectWriter(&writer);
-      docdb::ConsensusFrontiers frontiers;
-      auto frontiers_ptr = InitFrontiers(data, &frontiers);
-      WriteToRocksDB(frontiers_ptr, &intents_write_batch, StorageDbType::kIntents);
-
-      if (!context.apply_state().active()) {
-        break;
+    pending.emplace_back(id, docdb::ApplyTransactionState());
+  }
+
+  rocksdb::WriteBatch intents_write_batch;
+  while (!pending.empty()) {
+    // Writers keep pointers to contexts, so we use containers that don't move their elements.
+    std::deque<docdb::RemoveIntentsContext> contexts;
+    std::deque<docdb::IntentsWriter> writers;
+    // All transactions removed by this write batch share a single records limit, so the batch
+    // stays within txn_max_apply_batch_records.
+    int64_t left_records = FLAGS_txn_max_apply_batch_records;
+    for (const auto& id_and_state : pending) {
+      contexts.emplace_back(id_and_state.first, intent_keys_filter_.get(), &left_records);
+      writers.emplace_back(id_and_state.second.key, intents_db_.get(), &contexts.back());
+    }
+    RemoveIntentsBatchWriter writer(&writers);
+    intents_write_batch.SetDirectWriter(&writer);
+    docdb::ConsensusFrontiers frontiers;
+    auto frontiers_ptr = InitFrontiers(data, &frontiers);
+    WriteToRocksDB(frontiers_ptr, &intents_write_batch, StorageDbType::kIntents);
+
+    size_t still_active = 0;
+    for (size_t i = 0; i != pending.size(); ++i) {
+      if (contexts[i].apply_state().active()) {
+        pending[still_active].first = pending[i].first;
+        pending[still_active].second = std::move(contexts[i].apply_state());
+        ++still_active;
       }
+    }
+    pending.resize(still_active);
+    if (pending.empty()) {
+      break;
+    }
 
-      apply_state = std::move(context.apply_state());
-      intents_write_batch.Clear();
+    intents_write_batch.Clear();
 
-      AtomicFlagSleepMs(&FLAGS_apply_intents_task_injected_delay_ms);
-    }
+    AtomicFlagSleepMs(&FLAGS_apply_intents_task_injected_delay_ms);
   }
 
   return Status::OK();
 }
 
-
 Status Tablet::RemoveIntents(const RemoveIntentsData& data, const TransactionId& id) {
   return RemoveIntentsImpl(data, std::initializer_list<TransactionId>{id});
 }
@@ -3162,7 +3372,13 @@ Status Tablet::ForceFullRocksDBCompact() {
   RETURN_NOT_OK(scoped_operation);
 
   if (regular_db_) {
-    RETURN_NOT_OK(docdb::ForceRocksDBCompact(regular_db_.get()));
+    // Output of a full compaction is a single file with all the data, so place it in the cold
+    // tier if it is large enough.
+    const bool to_cold_tier =
+        !metadata_->cold_rocksdb_dir().empty() &&
+        regular_db_->GetCurrentVersionSstFilesSize() >= FLAGS_rocksdb_cold_tier_min_file_size_bytes;
+    const uint32_t target_path_id = to_cold_tier ? 1 : 0;
+    RETURN_NOT_OK(docdb::ForceRocksDBCompact(regular_db_.get(), target_path_id));
   }
   if (intents_db_) {
     RETURN_NOT_OK_PREPEND(
@@ -3279,6 +3495,29 @@ std::pair<int, int> Tablet::GetNumMemtables() const {
   return std::make_pair(intents_num_memtables, regular_num_memtables);
 }
 
+std::pair<uint64_t, uint64_t> Tablet::GetMutableMemtablesSize() const {
+  uint64_t intents_size = 0;
+  uint64_t regular_size = 0;
+
+  {
+    auto scoped_operation = CreateNonAbortableScopedRWOperation();
+    if (!scoped_operation.ok()) {
+      return std::make_pair(0, 0);
+    }
+    std::lock_guard<rw_spinlock> lock(component_lock_);
+    if (intents_db_) {
+      intents_db_->GetIntProperty(
+          rocksdb::DB::Properties::kCurSizeActiveMemTable, &intents_size);
+    }
+    if (regular_db_) {
+      regular_db_->GetIntProperty(
+          rocksdb::DB::Properties::kCurSizeActiveMemTable, &regular_size);
+    }
+  }
+
+  return std::make_pair(intents_size, regular_size);
+}
+
 // ------------------------------------------------------------------------------------------------
 
 Result<TransactionOperationContext> Tablet::CreateTransactionOperationContext(
@@ -3449,6 +3688,24 @@ void Tablet::ListenNumSSTFilesChanged(std::function<void()> listener) {
   num_sst_files_changed_listener_ = std::move(listener);
 }
 
+void Tablet::AddColdTierDbPath(rocksdb::Options* options) {
+  const auto& cold_dir = metadata_->cold_rocksdb_dir();
+  if (cold_dir.empty()) {
+    return;
+  }
+  // Universal compaction places its output in the first path whose target size exceeds both the
+  // output file size and the expected size of files accumulated before it is compacted again,
+  // i.e. output_size * (1 + (100 - size_ratio) / 100). So pick the target size of the primary
+  // path, so that files larger than the threshold go to the cold path.
+  const uint64_t size_ratio =
+      std::min<uint64_t>(options->compaction_options_universal.size_ratio, 100);
+  const uint64_t hot_target_size =
+      FLAGS_rocksdb_cold_tier_min_file_size_bytes / 100 * (200 - size_ratio);
+  options->db_paths.clear();
+  options->db_paths.emplace_back(metadata_->rocksdb_dir(), hot_target_size);
+  options->db_paths.emplace_back(cold_dir, std::numeric_limits<uint64_t>::max());
+}
+
 void Tablet::InitRocksDBOptions(
     rocksdb::Options* options, const std::string& log_prefix,
     rocksdb::BlockBasedTableOptions table_options) {
@@ -320,6 +320,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       rocksdb::WriteBatch* write_batch,
       docdb::StorageDbType storage_db_type);
 
+  // Invalidates row cache entries affected by non-transactional write applied at hybrid_time.
+  void InvalidateQLRowCache(const docdb::KeyValueWriteBatchPB& put_batch, HybridTime hybrid_time);
+
   //------------------------------------------------------------------------------------------------
   // Redis Request Processing.
   // Takes a Redis WriteRequestPB as input with its redis_write_batch.
@@ -553,7 +556,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS ForceFullRocksDBCompact();
 
-  docdb::DocDB doc_db() const { return { regular_db_.get(), intents_db_.get(), &key_bounds_ }; }
+  docdb::DocDB doc_db() const {
+    return { regular_db_.get(), intents_db_.get(), &key_bounds_, intent_keys_filter_.get() };
+  }
 
   // Returns approximate middle key for tablet split:
   // - for hash-based partitions: encoded hash code in order to split by hash code.
@@ -587,6 +592,9 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // Returns the number of memtables in intents and regular db-s.
   std::pair<int, int> GetNumMemtables() const;
 
+  // Returns the size of mutable memtables in intents and regular db-s, in bytes.
+  std::pair<uint64_t, uint64_t> GetMutableMemtablesSize() const;
+
   void SetHybridTimeLeaseProvider(HybridTimeLeaseProvider provider) {
     ht_lease_provider_ = std::move(provider);
   }
@@ -644,6 +652,14 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   bool is_sys_catalog() const { return is_sys_catalog_; }
   bool IsTransactionalRequest(bool is_ysql_request) const override;
 
+  // Witness replica keeps only the WAL, so writes are not applied to DocDB and reads are not
+  // served. Updated when the committed raft config changes.
+  void SetWitness(bool value);
+
+  bool is_witness() const {
+    return witness_.load(std::memory_order_acquire);
+  }
+
   void SetCleanupPool(ThreadPool* thread_pool);
 
   TabletSnapshots& snapshots() {
@@ -674,6 +690,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       rocksdb::Options* options, const std::string& log_prefix,
       rocksdb::BlockBasedTableOptions table_options = rocksdb::BlockBasedTableOptions());
 
+  // Adds the cold data directory of the tablet to db_paths of the regular DB options, if the
+  // tablet has one.
+  void AddColdTierDbPath(rocksdb::Options* options);
+
   TabletRetentionPolicy* RetentionPolicy() override {
     return retention_policy_.get();
   }
@@ -874,11 +894,17 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   std::unique_ptr<rocksdb::DB> intents_db_;
   std::atomic<bool> rocksdb_shutdown_requested_{false};
 
+  // Filter of keys that have intents in intents_db_, null when enable_intent_keys_filter is off.
+  std::unique_ptr<docdb::IntentKeysFilter> intent_keys_filter_;
+
   // Optional key bounds (see docdb::KeyBounds) served by this tablet.
   docdb::KeyBounds key_bounds_;
 
   std::unique_ptr<docdb::YQLStorageIf> ql_storage_;
 
+  // Cache of rows returned by YCQL point reads, created only when ql_row_cache_size_bytes is set.
+  std::unique_ptr<docdb::QLRowCache> ql_row_cache_;
+
   // This is for docdb fine-grained locking.
   docdb::SharedLockManager shared_lock_manager_;
 
@@ -970,12 +996,16 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   IsSysCatalogTablet is_sys_catalog_;
   TransactionsEnabled txns_enabled_;
 
+  std::atomic<bool> witness_{false};
+
   std::unique_ptr<ThreadPoolToken> cleanup_intent_files_token_;
 
   std::unique_ptr<TabletSnapshots> snapshots_;
 
   SnapshotCoordinator* snapshot_coordinator_ = nullptr;
 
+  ThreadPool* read_pool_ = nullptr;
+
   docdb::YQLRowwiseIteratorIf* cdc_iterator_ = nullptr;
 
   mutable std::mutex control_path_mutex_;
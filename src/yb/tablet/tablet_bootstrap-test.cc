@@ -57,6 +57,7 @@
 
 DECLARE_bool(skip_flushed_entries);
 DECLARE_int32(retryable_request_timeout_secs);
+DECLARE_bool(tablet_bootstrap_read_ahead);
 
 using std::shared_ptr;
 using std::string;
@@ -267,6 +268,35 @@ class BootstrapTest : public LogTestBase {
     }
   }
 
+  // Writes rows into several log segments and checks that bootstrap replays all of them.
+  void TestMultiSegmentBootstrap(bool read_ahead) {
+    constexpr int kNumSegments = 5;
+    constexpr int kRowsPerSegment = 3;
+
+    FLAGS_tablet_bootstrap_read_ahead = read_ahead;
+    BuildLog();
+    int key = 0;
+    for (int segment = 0; segment != kNumSegments; ++segment) {
+      if (segment != 0) {
+        ASSERT_OK(RollLog());
+      }
+      for (int i = 0; i != kRowsPerSegment; ++i, ++key) {
+        const auto op_id = MakeOpId(1, current_index_++);
+        AppendReplicateBatch(op_id, op_id, {TupleForAppend(key, segment, "value")});
+      }
+    }
+
+    TabletPtr tablet;
+    ConsensusBootstrapInfo boot_info;
+    ASSERT_OK(BootstrapTestTablet(&tablet, &boot_info));
+    ASSERT_EQ(boot_info.last_id.index(), current_index_ - 1);
+    ASSERT_TRUE(boot_info.orphaned_replicates.empty());
+
+    vector<string> results;
+    IterateTabletRows(tablet.get(), &results);
+    ASSERT_EQ(static_cast<size_t>(kNumSegments * kRowsPerSegment), results.size());
+  }
+
   std::shared_ptr<BootstrapTestHooksImpl> test_hooks_;
 };
 
@@ -287,6 +317,15 @@ TEST_F(BootstrapTest, TestBootstrap) {
   IterateTabletRows(tablet.get(), &results);
 }
 
+// Tests that bootstrap replays all log segments when the next segment is read in background.
+TEST_F(BootstrapTest, MultiSegmentReadAhead) {
+  TestMultiSegmentBootstrap(/* read_ahead= */ true);
+}
+
+TEST_F(BootstrapTest, MultiSegmentNoReadAhead) {
+  TestMultiSegmentBootstrap(/* read_ahead= */ false);
+}
+
 // Tests attempting a local bootstrap of a tablet that was in the middle of a remote bootstrap
 // before "crashing".
 TEST_F(BootstrapTest, TestIncompleteRemoteBootstrap) {
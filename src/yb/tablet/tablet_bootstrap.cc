@@ -52,6 +52,7 @@
 #include "yb/consensus/log_reader.h"
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
+#include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
 
 #include "yb/docdb/consensus_frontier.h"
@@ -97,6 +98,7 @@
 #include "yb/util/status.h"
 #include "yb/util/status_format.h"
 #include "yb/util/stopwatch.h"
+#include "yb/util/thread.h"
 
 DEFINE_bool(skip_remove_old_recovery_dir, false,
             "Skip removing WAL recovery dir after startup. (useful for debugging)");
@@ -125,6 +127,11 @@ DEFINE_bool(skip_flushed_entries, true,
 
 DECLARE_int32(retryable_request_timeout_secs);
 
+DEFINE_bool(tablet_bootstrap_read_ahead, true,
+            "Whether tablet bootstrap should read and decode the next log segment in background "
+            "while replaying the current one.");
+TAG_FLAG(tablet_bootstrap_read_ahead, advanced);
+
 DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
               "The segment size for transaction status tablet log roll-overs, in bytes.");
 DEFINE_test_flag(int32, tablet_bootstrap_delay_ms, 0,
@@ -470,6 +477,62 @@ bool WriteOpHasTransaction(const ReplicateMsg& replicate) {
   return false;
 }
 
+// Reads and decodes a log segment on a separate thread, so it could overlap with replay of the
+// previous segment. Falls back to reading in the calling thread if the thread cannot be started.
+class SegmentReadAhead {
+ public:
+  SegmentReadAhead() = default;
+
+  ~SegmentReadAhead() {
+    Reset();
+  }
+
+  void Start(const scoped_refptr<ReadableLogSegment>& segment) {
+    Reset();
+    segment_ = segment;
+    auto status = Thread::Create(
+        "tablet_bootstrap", "read_ahead", &SegmentReadAhead::Execute, this, &thread_);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to start read ahead of " << segment->path() << ": " << status;
+      thread_ = nullptr;
+    }
+  }
+
+  bool active() const {
+    return segment_ != nullptr;
+  }
+
+  log::ReadEntriesResult Get() {
+    if (thread_) {
+      thread_->Join();
+      thread_ = nullptr;
+    } else {
+      Execute();
+    }
+    segment_ = nullptr;
+    return std::move(result_);
+  }
+
+ private:
+  void Execute() {
+    result_ = segment_->ReadEntries();
+  }
+
+  void Reset() {
+    if (thread_) {
+      thread_->Join();
+      thread_ = nullptr;
+    }
+    segment_ = nullptr;
+  }
+
+  scoped_refptr<ReadableLogSegment> segment_;
+  scoped_refptr<Thread> thread_;
+  log::ReadEntriesResult result_;
+
+  DISALLOW_COPY_AND_ASSIGN(SegmentReadAhead);
+};
+
 }  // anonymous namespace
 
 YB_STRONGLY_TYPED_BOOL(NeedsRecovery);
@@ -623,6 +686,9 @@ class TabletBootstrap {
     CleanupSnapshots();
 
     auto tablet = std::make_shared<Tablet>(data_.tablet_init_data);
+    // Witness does not apply replayed writes as well.
+    tablet->SetWitness(consensus::IsRaftConfigWitness(
+        meta_->fs_manager()->uuid(), cmeta_->committed_config()));
     // Doing nothing for now except opening a tablet locally.
     LOG_TIMING_PREFIX(INFO, LogPrefix(), "opening tablet") {
       RETURN_NOT_OK(tablet->Open());
@@ -1265,10 +1331,18 @@ class TabletBootstrap {
     yb::OpId last_committed_op_id;
     yb::OpId last_read_entry_op_id;
     RestartSafeCoarseTimePoint last_entry_time;
+    // Read, CRC check and decoding of the next segment overlap with replay of the current one.
+    // SegmentReadAhead destructor waits for the read to complete, so it is safe to return at any
+    // point.
+    const bool read_ahead = FLAGS_tablet_bootstrap_read_ahead;
+    SegmentReadAhead next_read;
     for (; iter != segments.end(); ++iter) {
       const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-      auto read_result = segment->ReadEntries();
+      auto read_result = next_read.active() ? next_read.Get() : segment->ReadEntries();
+      if (read_ahead && iter + 1 != segments.end()) {
+        next_read.Start(*(iter + 1));
+      }
       last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
       if (!read_result.entries.empty()) {
         last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
@@ -46,6 +46,7 @@ typedef std::shared_ptr<TabletPeer> TabletPeerPtr;
 class ChangeMetadataOperation;
 class Operation;
 class OperationFilter;
+class SharedTransactionStatusCache;
 class SnapshotCoordinator;
 class SnapshotOperation;
 class SplitOperation;
@@ -61,6 +62,7 @@ class TransactionStatePB;
 class TruncateOperation;
 class TruncatePB;
 class UpdateTxnOperation;
+class WaitQueue;
 class WriteOperation;
 class WriteQuery;
 class WriteQueryContext;
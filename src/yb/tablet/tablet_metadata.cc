@@ -214,6 +214,7 @@ Status KvStoreInfo::LoadFromPB(const KvStoreInfoPB& pb,
   kv_store_id = KvStoreId(pb.kv_store_id());
   if (local_superblock) {
     rocksdb_dir = pb.rocksdb_dir();
+    cold_rocksdb_dir = pb.cold_rocksdb_dir();
   }
   lower_bound_key = pb.lower_bound_key();
   upper_bound_key = pb.upper_bound_key();
@@ -229,6 +230,11 @@ Status KvStoreInfo::LoadFromPB(const KvStoreInfoPB& pb,
 void KvStoreInfo::ToPB(const TableId& primary_table_id, KvStoreInfoPB* pb) const {
   pb->set_kv_store_id(kv_store_id.ToString());
   pb->set_rocksdb_dir(rocksdb_dir);
+  if (cold_rocksdb_dir.empty()) {
+    pb->clear_cold_rocksdb_dir();
+  } else {
+    pb->set_cold_rocksdb_dir(cold_rocksdb_dir);
+  }
   if (lower_bound_key.empty()) {
     pb->clear_lower_bound_key();
   } else {
@@ -269,7 +275,7 @@ std::string MakeTabletDirName(const TabletId& tablet_id) {
 
 Result<RaftGroupMetadataPtr> RaftGroupMetadata::CreateNew(
     const RaftGroupMetadataData& data, const std::string& data_root_dir,
-    const std::string& wal_root_dir) {
+    const std::string& wal_root_dir, const std::string& cold_data_root_dir) {
   auto* fs_manager = data.fs_manager;
   // Verify that no existing Raft group exists with the same ID.
   if (fs_manager->env()->FileExists(fs_manager->GetRaftGroupMetadataPath(data.raft_group_id))) {
@@ -298,6 +304,10 @@ Result<RaftGroupMetadataPtr> RaftGroupMetadata::CreateNew(
       data_top_dir, FsManager::kRocksDBDirName, table_dir_name, tablet_dir_name);
 
   RaftGroupMetadataPtr ret(new RaftGroupMetadata(data, rocksdb_dir, wal_dir));
+  if (!cold_data_root_dir.empty()) {
+    ret->kv_store_.cold_rocksdb_dir = JoinPathSegments(
+        cold_data_root_dir, FsManager::kRocksDBDirName, table_dir_name, tablet_dir_name);
+  }
   RETURN_NOT_OK(ret->Flush());
   return ret;
 }
@@ -406,6 +416,13 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb data directory " << rocksdb_dir;
   }
 
+  const auto& cold_rocksdb_dir = this->cold_rocksdb_dir();
+  if (!cold_rocksdb_dir.empty() && fs_manager_->env()->FileExists(cold_rocksdb_dir)) {
+    auto s = fs_manager_->env()->DeleteRecursively(cold_rocksdb_dir);
+    LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb cold data directory "
+                             << cold_rocksdb_dir;
+  }
+
   const auto intents_dir = this->intents_rocksdb_dir();
   if (fs_manager_->env()->FileExists(intents_dir)) {
     status = rocksdb::DestroyDB(intents_dir, rocksdb_options);
@@ -446,9 +463,11 @@ bool RaftGroupMetadata::IsTombstonedWithNoRocksDBData() const {
   std::lock_guard<MutexType> lock(data_mutex_);
   const auto& rocksdb_dir = kv_store_.rocksdb_dir;
   const auto intents_dir = rocksdb_dir + kIntentsDBSuffix;
+  const auto& cold_rocksdb_dir = kv_store_.cold_rocksdb_dir;
   return tablet_data_state_ == TABLET_DATA_TOMBSTONED &&
       !fs_manager_->env()->FileExists(rocksdb_dir) &&
-      !fs_manager_->env()->FileExists(intents_dir);
+      !fs_manager_->env()->FileExists(intents_dir) &&
+      (cold_rocksdb_dir.empty() || !fs_manager_->env()->FileExists(cold_rocksdb_dir));
 }
 
 Status RaftGroupMetadata::DeleteSuperBlock() {
@@ -800,6 +819,15 @@ string RaftGroupMetadata::data_root_dir() const {
   }
 }
 
+string RaftGroupMetadata::cold_data_root_dir() const {
+  const auto& cold_rocksdb_dir = kv_store_.cold_rocksdb_dir;
+  if (cold_rocksdb_dir.empty()) {
+    return "";
+  }
+  // cold_rocksdb_dir is always <cold data root>/rocksdb/table-<id>/tablet-<id>.
+  return DirName(DirName(DirName(cold_rocksdb_dir)));
+}
+
 string RaftGroupMetadata::wal_root_dir() const {
   std::string wal_dir = this->wal_dir();
 
@@ -1007,6 +1035,10 @@ Result<RaftGroupMetadataPtr> RaftGroupMetadata::CreateSubtabletMetadata(
   metadata->kv_store_.lower_bound_key = lower_bound_key;
   metadata->kv_store_.upper_bound_key = upper_bound_key;
   metadata->kv_store_.rocksdb_dir = GetSubRaftGroupDataDir(raft_group_id);
+  if (!kv_store_.cold_rocksdb_dir.empty()) {
+    metadata->kv_store_.cold_rocksdb_dir = JoinPathSegments(
+        DirName(kv_store_.cold_rocksdb_dir), MakeTabletDirName(raft_group_id));
+  }
   metadata->kv_store_.has_been_fully_compacted = false;
   *metadata->partition_ = partition;
   metadata->state_ = kInitialized;
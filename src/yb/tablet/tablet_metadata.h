@@ -149,6 +149,10 @@ struct KvStoreInfo {
   // `rocksdb_dir + kIntentsDBSuffix` path.
   std::string rocksdb_dir;
 
+  // The directory on the cold storage tier for large SST files of the regular RocksDB. Empty if
+  // all files are stored in rocksdb_dir.
+  std::string cold_rocksdb_dir;
+
   // Optional inclusive lower bound and exclusive upper bound for keys served by this KV-store.
   // See docdb::KeyBounds.
   std::string lower_bound_key;
@@ -186,9 +190,11 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   // data_root_dir and wal_root_dir dictates which disk this Raft group will
   // use in the respective directories.
   // If empty string is passed in, it will be randomly chosen.
+  // If cold_data_root_dir is not empty, large SST files of the regular DB are stored there.
   static Result<RaftGroupMetadataPtr> CreateNew(
       const RaftGroupMetadataData& data, const std::string& data_root_dir = std::string(),
-      const std::string& wal_root_dir = std::string());
+      const std::string& wal_root_dir = std::string(),
+      const std::string& cold_data_root_dir = std::string());
 
   // Load existing metadata from disk.
   static Result<RaftGroupMetadataPtr> Load(FsManager* fs_manager, const RaftGroupId& raft_group_id);
@@ -257,6 +263,7 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   const std::string& rocksdb_dir() const { return kv_store_.rocksdb_dir; }
   std::string intents_rocksdb_dir() const { return kv_store_.rocksdb_dir + kIntentsDBSuffix; }
   std::string snapshots_dir() const { return kv_store_.rocksdb_dir + kSnapshotsDirSuffix; }
+  const std::string& cold_rocksdb_dir() const { return kv_store_.cold_rocksdb_dir; }
 
   const std::string& lower_bound_key() const { return kv_store_.lower_bound_key; }
   const std::string& upper_bound_key() const { return kv_store_.upper_bound_key; }
@@ -308,6 +315,9 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
   // TODO(#79): rework when we have more than one KV-store (and data roots) per Raft group.
   std::string data_root_dir() const;
 
+  // Returns the cold tier data root dir for this Raft group, empty if it does not use cold tier.
+  std::string cold_data_root_dir() const;
+
   // Returns the WAL root dir for this Raft group, for example:
   // /mnt/d0/yb-data/tserver/wals
   std::string wal_root_dir() const;
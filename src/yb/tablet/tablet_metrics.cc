@@ -70,6 +70,14 @@ METRIC_DEFINE_coarse_histogram(
     table, write_lock_latency, "Write lock latency", yb::MetricUnit::kMicroseconds,
     "Time taken to acquire key locks for a write operation");
 
+METRIC_DEFINE_coarse_histogram(
+    tablet, key_lock_wait_latency, "Key lock wait latency", yb::MetricUnit::kMicroseconds,
+    "Time spent waiting for conflicting key locks to be released by a write operation");
+
+METRIC_DEFINE_coarse_histogram(
+    tablet, safe_time_wait_latency, "Safe time wait latency", yb::MetricUnit::kMicroseconds,
+    "Time spent waiting for safe time to reach the requested read time");
+
 METRIC_DEFINE_gauge_uint32(tablet, compact_rs_running,
   "RowSet Compactions Running",
   yb::MetricUnit::kMaintenanceOperations,
@@ -125,6 +133,16 @@ METRIC_DEFINE_counter(tablet, pgsql_consistent_prefix_read_rows,
                       yb::MetricUnit::kRequests,
                       "Number of pgsql rows read as part of a consistent prefix request");
 
+METRIC_DEFINE_coarse_histogram(
+    tablet, follower_read_staleness, "Follower read staleness", yb::MetricUnit::kMicroseconds,
+    "Staleness of the safe time of the follower at the moment it accepted a read");
+
+METRIC_DEFINE_counter(tablet, stale_follower_read_rejections,
+                      "Stale Follower Read Rejections",
+                      yb::MetricUnit::kRequests,
+                      "Number of reads rejected by the follower, because it is staler than the "
+                      "requested bound");
+
 METRIC_DEFINE_counter(tablet, tablet_data_corruptions,
   "Tablet Data Corruption Detections",
   yb::MetricUnit::kUnits,
@@ -142,7 +160,10 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& table_entity,
     MINIT(table_entity, redis_read_latency),
     MINIT(table_entity, ql_read_latency),
     MINIT(table_entity, write_lock_latency),
+    MINIT(tablet_entity, key_lock_wait_latency),
+    MINIT(tablet_entity, safe_time_wait_latency),
     MINIT(table_entity, write_op_duration_client_propagated_consistency),
+    MINIT(tablet_entity, follower_read_staleness),
     MINIT(tablet_entity, not_leader_rejections),
     MINIT(tablet_entity, leader_memory_pressure_rejections),
     MINIT(tablet_entity, majority_sst_files_rejections),
@@ -151,6 +172,7 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& table_entity,
     MINIT(tablet_entity, restart_read_requests),
     MINIT(tablet_entity, consistent_prefix_read_requests),
     MINIT(tablet_entity, pgsql_consistent_prefix_read_rows),
+    MINIT(tablet_entity, stale_follower_read_rejections),
     MINIT(tablet_entity, tablet_data_corruptions),
     MINIT(tablet_entity, rows_inserted) {
 }
@@ -33,6 +33,7 @@ namespace rocksdb {
 class Cache;
 class EventListener;
 class MemoryMonitor;
+class PersistentCache;
 class Env;
 }
 
@@ -42,6 +43,7 @@ class Env;
 class MemTracker;
 class MetricRegistry;
 class MetricEntity;
+class ThreadPool;
 
 namespace tablet {
 
@@ -50,11 +52,17 @@ YB_STRONGLY_TYPED_BOOL(IsDropTable);
 // Common for all tablets within TabletManager.
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Separate cache for index and filter blocks, nullptr when they are cached in block_cache.
+  std::shared_ptr<rocksdb::Cache> index_and_filter_block_cache;
+  // Cache of raw SST blocks on local storage, nullptr when disabled.
+  std::shared_ptr<rocksdb::PersistentCache> persistent_cache;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
   std::shared_ptr<rocksdb::RateLimiter> rate_limiter;
+  // Statuses of transactions shared by all tablets, nullptr when disabled.
+  std::shared_ptr<SharedTransactionStatusCache> transaction_status_cache;
   scoped_refptr<MetricEntity> ServerMetricEntity;
 };
 
@@ -76,6 +84,8 @@ struct TabletInitData {
   SnapshotCoordinator* snapshot_coordinator = nullptr;
   TabletSplitter* tablet_splitter = nullptr;
   std::function<HybridTime(RaftGroupMetadata*)> allowed_history_cutoff_provider;
+  // Pool used to scan parts of a large read request in parallel.
+  ThreadPool* read_pool = nullptr;
 };
 
 } // namespace tablet
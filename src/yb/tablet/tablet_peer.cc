@@ -47,6 +47,7 @@
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
+#include "yb/consensus/quorum_util.h"
 #include "yb/consensus/raft_consensus.h"
 #include "yb/consensus/retryable_requests.h"
 #include "yb/consensus/state_change_context.h"
@@ -85,6 +86,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/logging.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
@@ -264,6 +266,8 @@ Status TabletPeer::InitTabletPeer(
 
     if (retryable_requests) {
       retryable_requests->SetMetricEntity(tablet->GetTabletMetricsEntity());
+      retryable_requests->SetMemTracker(
+          MemTracker::FindOrCreateTracker("RetryableRequests", tablet->mem_tracker()));
     }
 
     consensus_ = RaftConsensus::Create(
@@ -378,6 +382,7 @@ void TabletPeer::MajorityReplicated() {
 
 void TabletPeer::ChangeConfigReplicated(const RaftConfigPB& config) {
   tablet_->mvcc_manager()->SetLeaderOnlyMode(config.peers_size() == 1);
+  tablet_->SetWitness(consensus::IsRaftConfigWitness(permanent_uuid(), config));
 }
 
 uint64_t TabletPeer::NumSSTFiles() {
@@ -938,7 +943,18 @@ Result<int64_t> TabletPeer::GetEarliestNeededLogIndex(std::string* details) cons
     *details += Format("Last committed op id: $0\n", last_committed_op_id);
   }
 
-  if (tablet_->table_type() != TableType::TRANSACTION_STATUS_TABLE_TYPE) {
+  if (tablet_->is_witness()) {
+    // Witness does not write to RocksDB, so flushed op ids do not hold its WAL. But while it is
+    // the leader, full replicas catch up from its WAL, and it could not remote bootstrap them. So
+    // keep the operations that were not applied by all peers yet.
+    if (consensus_->role() == PeerRole::LEADER) {
+      auto all_applied_op_id = consensus_->GetAllAppliedOpId();
+      min_index = std::min(min_index, all_applied_op_id.index);
+      if (details) {
+        *details += Format("All applied op id: $0\n", all_applied_op_id);
+      }
+    }
+  } else if (tablet_->table_type() != TableType::TRANSACTION_STATUS_TABLE_TYPE) {
     tablet_->FlushIntentsDbIfNecessary(latest_log_entry_op_id);
     auto max_persistent_op_id = VERIFY_RESULT(
         tablet_->MaxPersistentOpId(true /* invalid_if_no_new_data */));
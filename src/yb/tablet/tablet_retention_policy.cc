@@ -85,14 +85,34 @@ HistoryRetentionDirective TabletRetentionPolicy::GetRetentionDirective() {
   HybridTime history_cutoff;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (FLAGS_enable_history_cutoff_propagation) {
-      history_cutoff = SanitizeHistoryCutoff(committed_history_cutoff_);
-    } else {
-      history_cutoff = EffectiveHistoryCutoff();
+    history_cutoff = ProposedHistoryCutoff();
+    if (!FLAGS_enable_history_cutoff_propagation) {
       committed_history_cutoff_ = std::max(history_cutoff, committed_history_cutoff_);
     }
   }
 
+  return MakeRetentionDirective(history_cutoff);
+}
+
+HistoryRetentionDirective TabletRetentionPolicy::ProposedRetentionDirective() {
+  HybridTime history_cutoff;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    history_cutoff = ProposedHistoryCutoff();
+  }
+
+  return MakeRetentionDirective(history_cutoff);
+}
+
+HybridTime TabletRetentionPolicy::ProposedHistoryCutoff() {
+  if (FLAGS_enable_history_cutoff_propagation) {
+    return SanitizeHistoryCutoff(committed_history_cutoff_);
+  }
+  return EffectiveHistoryCutoff();
+}
+
+HistoryRetentionDirective TabletRetentionPolicy::MakeRetentionDirective(
+    HybridTime history_cutoff) {
   auto deleted_before_history_cutoff = std::make_shared<docdb::ColumnIds>();
   for (const auto& deleted_col : *metadata_.deleted_cols()) {
     if (deleted_col.ht < history_cutoff) {
@@ -34,6 +34,8 @@ class TabletRetentionPolicy : public docdb::HistoryRetentionPolicy {
 
   docdb::HistoryRetentionDirective GetRetentionDirective() override;
 
+  docdb::HistoryRetentionDirective ProposedRetentionDirective() override;
+
   // Tries to update history cutoff to proposed value, not allowing it to decrease.
   // Returns new committed history cutoff value.
   HybridTime UpdateCommittedHistoryCutoff(HybridTime new_value);
@@ -54,8 +56,12 @@ class TabletRetentionPolicy : public docdb::HistoryRetentionPolicy {
 
  private:
   bool ShouldRetainDeleteMarkersInMajorCompaction() const;
+  docdb::HistoryRetentionDirective MakeRetentionDirective(HybridTime history_cutoff);
   HybridTime EffectiveHistoryCutoff() REQUIRES(mutex_);
 
+  // History cutoff that GetRetentionDirective would use now.
+  HybridTime ProposedHistoryCutoff() REQUIRES(mutex_);
+
   // Check proposed history cutoff against other restrictions (for instance min reading timestamp),
   // and returns most close value that satisfies them.
   HybridTime SanitizeHistoryCutoff(HybridTime proposed_history_cutoff) REQUIRES(mutex_);
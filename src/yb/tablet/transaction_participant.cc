@@ -41,9 +41,11 @@
 #include "yb/tablet/remove_intents_task.h"
 #include "yb/tablet/running_transaction.h"
 #include "yb/tablet/running_transaction_context.h"
+#include "yb/tablet/shared_transaction_status_cache.h"
 #include "yb/tablet/transaction_loader.h"
 #include "yb/tablet/transaction_participant_context.h"
 #include "yb/tablet/transaction_status_resolver.h"
+#include "yb/tablet/wait_queue.h"
 
 #include "yb/tserver/tserver_service.pb.h"
 
@@ -121,10 +123,12 @@ class TransactionParticipant::Impl
     : public RunningTransactionContext, public TransactionLoaderContext {
  public:
   Impl(TransactionParticipantContext* context, TransactionIntentApplier* applier,
+       SharedTransactionStatusCache* shared_status_cache,
        const scoped_refptr<MetricEntity>& entity)
-      : RunningTransactionContext(context, applier),
+      : RunningTransactionContext(context, applier, shared_status_cache),
         log_prefix_(context->LogPrefix()),
         loader_(this, entity),
+        wait_queue_(context, entity),
         poller_(log_prefix_, std::bind(&Impl::Poll, this)) {
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
@@ -147,6 +151,7 @@ class TransactionParticipant::Impl
     }
 
     poller_.Shutdown();
+    wait_queue_.StartShutdown();
 
     if (start_latch_.count()) {
       start_latch_.CountDown();
@@ -530,6 +535,12 @@ class TransactionParticipant::Impl
         transactions_.modify(lock_and_iterator.iterator, [&data](auto& txn) {
           txn->SetLocalCommitData(data.commit_ht, data.aborted);
         });
+        if (shared_status_cache_) {
+          // Other tablets of this tablet server, that participate in the same transaction, could
+          // use commit data without asking the coordinator.
+          shared_status_cache_->Committed(
+              data.transaction_id, CommitMetadata{data.commit_ht, data.aborted});
+        }
 
         LOG_IF_WITH_PREFIX(DFATAL, data.log_ht < last_safe_time_)
             << "Apply transaction before last safe time " << data.transaction_id
@@ -689,6 +700,10 @@ class TransactionParticipant::Impl
     return &participant_context_;
   }
 
+  WaitQueue* wait_queue() {
+    return &wait_queue_;
+  }
+
   HybridTime MinRunningHybridTime() {
     auto result = min_running_ht_.load(std::memory_order_acquire);
     if (result == HybridTime::kMax || result == HybridTime::kInvalid) {
@@ -731,6 +746,38 @@ class TransactionParticipant::Impl
     return result;
   }
 
+  bool MayHaveIntentsWithPrefix(const Slice& key_prefix) {
+    std::lock_guard<std::mutex> lock(intents_key_range_mutex_);
+    if (intents_key_range_unbounded_) {
+      return true;
+    }
+    if (intents_min_key_.empty()) {
+      return false;
+    }
+    // There is a key starting with key_prefix in [min, max] iff max is not less than key_prefix and
+    // min is less than key_prefix or starts with it.
+    return Slice(intents_max_key_).compare(key_prefix) >= 0 &&
+           (Slice(intents_min_key_).compare(key_prefix) < 0 ||
+            Slice(intents_min_key_).starts_with(key_prefix));
+  }
+
+  void RegisterIntentsKeyRange(const Slice& min_key, const Slice& max_key) {
+    std::lock_guard<std::mutex> lock(intents_key_range_mutex_);
+    if (intents_key_range_unbounded_) {
+      return;
+    }
+    if (min_key.empty()) {
+      intents_key_range_unbounded_ = true;
+      return;
+    }
+    if (intents_min_key_.empty() || min_key.compare(intents_min_key_) < 0) {
+      intents_min_key_.assign(min_key.cdata(), min_key.size());
+    }
+    if (intents_max_key_.empty() || max_key.compare(intents_max_key_) > 0) {
+      intents_max_key_.assign(max_key.cdata(), max_key.size());
+    }
+  }
+
   void WaitMinRunningHybridTime(HybridTime ht) {
     MinRunningNotifier min_running_notifier(&applier_);
     std::unique_lock<std::mutex> lock(mutex_);
@@ -1027,6 +1074,7 @@ class TransactionParticipant::Impl
 
     if (transactions_.empty()) {
       min_running_ht_.store(HybridTime::kMax, std::memory_order_release);
+      ResetIntentsKeyRange();
       CheckMinRunningHybridTimeSatisfiedUnlocked(min_running_notifier);
       return;
     }
@@ -1042,6 +1090,15 @@ class TransactionParticipant::Impl
     }
   }
 
+  // Intents of removed transactions don't have to be taken into account by readers, so the range
+  // is collected from scratch when there are no running transactions.
+  void ResetIntentsKeyRange() {
+    std::lock_guard<std::mutex> lock(intents_key_range_mutex_);
+    intents_key_range_unbounded_ = false;
+    intents_min_key_.clear();
+    intents_max_key_.clear();
+  }
+
   void EnqueueRemoveUnlocked(
       const TransactionId& id, RemoveReason reason,
       MinRunningNotifier* min_running_notifier) REQUIRES(mutex_) override {
@@ -1123,6 +1180,9 @@ class TransactionParticipant::Impl
       const Transactions::iterator& it, RemoveReason reason,
       MinRunningNotifier* min_running_notifier) REQUIRES(mutex_) {
     TransactionId txn_id = (**it).id();
+    // Transaction is committed or aborted at this point, so writes waiting for it could retry
+    // conflict resolution, even if its removal is postponed.
+    wait_queue_.SignalFinished(txn_id);
     RemoveIntentsData checkpoint;
     auto itr = transactions_.find(txn_id);
     OpId op_id = (**itr).GetOpId();
@@ -1415,6 +1475,7 @@ class TransactionParticipant::Impl
       CleanTransactionsQueue(&graceful_cleanup_queue_, &min_running_notifier);
     }
     CleanupStatusResolvers();
+    wait_queue_.Poll(CoarseMonoClock::now());
   }
 
   void CheckForAbortedTransactions() REQUIRES(mutex_) {
@@ -1551,6 +1612,13 @@ class TransactionParticipant::Impl
   CountDownLatch start_latch_{1};
 
   std::atomic<HybridTime> min_running_ht_{HybridTime::kInvalid};
+
+  // Range of keys of intents written by running transactions. Unbounded until the first time there
+  // are no running transactions, because intents loaded during bootstrap are not tracked.
+  std::mutex intents_key_range_mutex_;
+  bool intents_key_range_unbounded_ GUARDED_BY(intents_key_range_mutex_) = true;
+  std::string intents_min_key_ GUARDED_BY(intents_key_range_mutex_);
+  std::string intents_max_key_ GUARDED_BY(intents_key_range_mutex_);
   std::atomic<CoarseTimePoint> next_check_min_running_{CoarseTimePoint()};
   HybridTime waiting_for_min_running_ht_ = HybridTime::kMax;
   std::atomic<bool> shutdown_done_{false};
@@ -1559,13 +1627,16 @@ class TransactionParticipant::Impl
 
   LRUCache<TransactionId> cleanup_cache_{FLAGS_transactions_cleanup_cache_size};
 
+  WaitQueue wait_queue_;
+
   rpc::Poller poller_;
 };
 
 TransactionParticipant::TransactionParticipant(
     TransactionParticipantContext* context, TransactionIntentApplier* applier,
+    SharedTransactionStatusCache* shared_status_cache,
     const scoped_refptr<MetricEntity>& entity)
-    : impl_(new Impl(context, applier, entity)) {
+    : impl_(new Impl(context, applier, shared_status_cache, entity)) {
 }
 
 TransactionParticipant::~TransactionParticipant() {
@@ -1666,10 +1737,22 @@ TransactionParticipantContext* TransactionParticipant::context() const {
   return impl_->participant_context();
 }
 
+WaitQueue* TransactionParticipant::wait_queue() const {
+  return impl_->wait_queue();
+}
+
 HybridTime TransactionParticipant::MinRunningHybridTime() const {
   return impl_->MinRunningHybridTime();
 }
 
+bool TransactionParticipant::MayHaveIntentsWithPrefix(const Slice& key_prefix) const {
+  return impl_->MayHaveIntentsWithPrefix(key_prefix);
+}
+
+void TransactionParticipant::RegisterIntentsKeyRange(const Slice& min_key, const Slice& max_key) {
+  impl_->RegisterIntentsKeyRange(min_key, max_key);
+}
+
 void TransactionParticipant::WaitMinRunningHybridTime(HybridTime ht) {
   impl_->WaitMinRunningHybridTime(ht);
 }
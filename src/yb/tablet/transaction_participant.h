@@ -110,6 +110,7 @@ class TransactionParticipant : public TransactionStatusManager {
  public:
   TransactionParticipant(
       TransactionParticipantContext* context, TransactionIntentApplier* applier,
+      SharedTransactionStatusCache* shared_status_cache,
       const scoped_refptr<MetricEntity>& entity);
   virtual ~TransactionParticipant();
 
@@ -177,8 +178,16 @@ class TransactionParticipant : public TransactionStatusManager {
 
   TransactionParticipantContext* context() const;
 
+  // Queue of writes waiting for conflicting transactions of this participant to finish.
+  WaitQueue* wait_queue() const;
+
   HybridTime MinRunningHybridTime() const override;
 
+  bool MayHaveIntentsWithPrefix(const Slice& key_prefix) const override;
+
+  // Should be invoked before writing intents with keys in [min_key, max_key] range.
+  void RegisterIntentsKeyRange(const Slice& min_key, const Slice& max_key);
+
   Result<HybridTime> WaitForSafeTime(HybridTime safe_time, CoarseTimePoint deadline) override;
 
   // When minimal start hybrid time of running transaction will be at least `ht` applier
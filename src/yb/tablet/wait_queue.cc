@@ -0,0 +1,295 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/wait_queue.h"
+
+#include <algorithm>
+
+#include "yb/rpc/thread_pool.h"
+
+#include "yb/tablet/transaction_participant_context.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/status_format.h"
+
+using namespace std::literals;
+
+DEFINE_bool(enable_wait_queues, false,
+            "Transactional writes that conflict with pending transactions wait for them to finish, "
+            "instead of aborting one of the conflicting transactions right away.");
+TAG_FLAG(enable_wait_queues, advanced);
+TAG_FLAG(enable_wait_queues, runtime);
+
+DEFINE_int32(wait_queue_max_wait_ms, 1000,
+             "Max time that a write could wait for conflicting transactions. After that conflicts "
+             "are resolved by transaction priority, which also breaks deadlocks that span "
+             "multiple tablets.");
+TAG_FLAG(wait_queue_max_wait_ms, advanced);
+TAG_FLAG(wait_queue_max_wait_ms, runtime);
+
+METRIC_DEFINE_coarse_histogram(
+    tablet, wait_queue_wait_time, "Time spent by writes waiting for conflicting transactions",
+    yb::MetricUnit::kMicroseconds,
+    "Time spent by writes in the wait queue, waiting for conflicting transactions to finish.");
+METRIC_DEFINE_simple_gauge_uint64(
+    tablet, wait_queue_waiters, "Number of writes waiting for conflicting transactions",
+    yb::MetricUnit::kOperations);
+METRIC_DEFINE_simple_counter(
+    tablet, wait_queue_deadlocks, "Number of deadlocks detected by the wait queue",
+    yb::MetricUnit::kOperations);
+METRIC_DEFINE_simple_counter(
+    tablet, wait_queue_expired_waits,
+    "Number of writes that stopped waiting for conflicting transactions because of timeout",
+    yb::MetricUnit::kOperations);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Number of last finished transactions remembered to check blockers of new waiters against.
+constexpr size_t kMaxRecentlyFinished = 1024;
+
+class WaitDoneTask : public rpc::ThreadPoolTask {
+ public:
+  WaitDoneTask(WaitQueue::WaitDoneCallback callback, const Status& status)
+      : callback_(std::move(callback)), status_(status) {}
+
+  void Run() override {
+    callback_(status_);
+  }
+
+  void Done(const Status& status) override {
+    // Task was not executed, so we pass failure to the waiter.
+    if (!status.ok()) {
+      callback_(status);
+    }
+    delete this;
+  }
+
+ private:
+  virtual ~WaitDoneTask() = default;
+
+  WaitQueue::WaitDoneCallback callback_;
+  Status status_;
+};
+
+} // namespace
+
+struct WaitQueue::Waiter {
+  TransactionId id;
+  std::vector<TransactionId> blockers;
+  CoarseTimePoint start_time;
+  CoarseTimePoint expiration;
+  WaitDoneCallback callback;
+};
+
+WaitQueue::WaitQueue(
+    TransactionParticipantContext* context, const scoped_refptr<MetricEntity>& entity)
+    : context_(*context),
+      wait_time_(METRIC_wait_queue_wait_time.Instantiate(entity)),
+      num_waiters_(METRIC_wait_queue_waiters.Instantiate(entity, 0)),
+      deadlocks_(METRIC_wait_queue_deadlocks.Instantiate(entity)),
+      expired_waits_(METRIC_wait_queue_expired_waits.Instantiate(entity)) {
+}
+
+WaitQueue::~WaitQueue() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  LOG_IF_WITH_PREFIX(DFATAL, !waiters_by_id_.empty())
+      << "Destroying wait queue with " << waiters_by_id_.size() << " waiters";
+}
+
+uint64_t WaitQueue::finished_generation() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return finished_generation_;
+}
+
+void WaitQueue::WaitOn(
+    const TransactionId& waiter_id, std::vector<TransactionId> blockers,
+    uint64_t finished_generation, CoarseTimePoint deadline, WaitDoneCallback callback) {
+  auto now = CoarseMonoClock::now();
+  auto waiter = std::make_shared<Waiter>();
+  waiter->id = waiter_id;
+  waiter->blockers = std::move(blockers);
+  waiter->start_time = now;
+  waiter->expiration = std::min(
+      deadline, now + 1ms * GetAtomicFlag(&FLAGS_wait_queue_max_wait_ms));
+  waiter->callback = std::move(callback);
+
+  Status status;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closing_) {
+      status = STATUS(Aborted, "Wait queue is shutting down");
+    } else if (BlockerFinishedSince(waiter->blockers, finished_generation)) {
+      // Retry conflict resolution right away, nothing would wake up this waiter otherwise.
+      VLOG_WITH_PREFIX(4) << "Blockers of " << waiter->id << " finished before wait";
+    } else if (HasCycle(waiter->id, waiter->blockers)) {
+      deadlocks_->Increment();
+      status = STATUS_FORMAT(
+          TimedOut, "Deadlock detected, $0 waits for $1", waiter->id, waiter->blockers);
+    } else {
+      VLOG_WITH_PREFIX(4) << waiter->id << " waits for " << AsString(waiter->blockers);
+      for (const auto& blocker : waiter->blockers) {
+        waiters_by_blocker_.emplace(blocker, waiter);
+      }
+      waiters_by_id_.emplace(waiter->id, waiter);
+      num_waiters_->set_value(waiters_by_id_.size());
+      return;
+    }
+  }
+
+  VLOG_WITH_PREFIX(4) << "Not waiting: " << status;
+  InvokeCallback(waiter, status);
+}
+
+bool WaitQueue::HasCycle(const TransactionId& waiter, const std::vector<TransactionId>& blockers) {
+  std::vector<TransactionId> queue(blockers.begin(), blockers.end());
+  TransactionIdSet visited(blockers.begin(), blockers.end());
+  while (!queue.empty()) {
+    auto id = queue.back();
+    queue.pop_back();
+    if (id == waiter) {
+      return true;
+    }
+    auto range = waiters_by_id_.equal_range(id);
+    for (auto it = range.first; it != range.second; ++it) {
+      for (const auto& blocker : it->second->blockers) {
+        if (visited.insert(blocker).second) {
+          queue.push_back(blocker);
+        }
+      }
+    }
+  }
+  return false;
+}
+
+bool WaitQueue::BlockerFinishedSince(
+    const std::vector<TransactionId>& blockers, uint64_t generation) {
+  if (generation >= finished_generation_) {
+    return false;
+  }
+  auto num_finished = finished_generation_ - generation;
+  if (num_finished > recently_finished_.size()) {
+    // Finished transactions are no longer remembered, so consider that a blocker could be there.
+    return true;
+  }
+  for (auto it = recently_finished_.end() - num_finished; it != recently_finished_.end(); ++it) {
+    if (std::find(blockers.begin(), blockers.end(), *it) != blockers.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void WaitQueue::RemoveUnlocked(const WaiterPtr& waiter) {
+  for (const auto& blocker : waiter->blockers) {
+    auto range = waiters_by_blocker_.equal_range(blocker);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == waiter) {
+        waiters_by_blocker_.erase(it);
+        break;
+      }
+    }
+  }
+  auto range = waiters_by_id_.equal_range(waiter->id);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second == waiter) {
+      waiters_by_id_.erase(it);
+      break;
+    }
+  }
+  num_waiters_->set_value(waiters_by_id_.size());
+}
+
+void WaitQueue::SignalFinished(const TransactionId& id) {
+  std::vector<WaiterPtr> woken_up;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++finished_generation_;
+    recently_finished_.push_back(id);
+    if (recently_finished_.size() > kMaxRecentlyFinished) {
+      recently_finished_.pop_front();
+    }
+    auto range = waiters_by_blocker_.equal_range(id);
+    for (auto it = range.first; it != range.second; ++it) {
+      woken_up.push_back(it->second);
+    }
+    for (const auto& waiter : woken_up) {
+      RemoveUnlocked(waiter);
+    }
+  }
+
+  for (const auto& waiter : woken_up) {
+    VLOG_WITH_PREFIX(4) << waiter->id << " woken up by " << id;
+    InvokeCallback(waiter, Status::OK());
+  }
+}
+
+void WaitQueue::Poll(CoarseTimePoint now) {
+  std::vector<WaiterPtr> expired;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& id_and_waiter : waiters_by_id_) {
+      if (id_and_waiter.second->expiration <= now) {
+        expired.push_back(id_and_waiter.second);
+      }
+    }
+    for (const auto& waiter : expired) {
+      RemoveUnlocked(waiter);
+    }
+  }
+
+  for (const auto& waiter : expired) {
+    expired_waits_->Increment();
+    InvokeCallback(waiter, STATUS_FORMAT(
+        TimedOut, "$0 waited too long for $1", waiter->id, waiter->blockers));
+  }
+}
+
+void WaitQueue::StartShutdown() {
+  std::vector<WaiterPtr> waiters;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closing_ = true;
+    for (const auto& id_and_waiter : waiters_by_id_) {
+      waiters.push_back(id_and_waiter.second);
+    }
+    waiters_by_blocker_.clear();
+    waiters_by_id_.clear();
+    num_waiters_->set_value(0);
+  }
+
+  for (const auto& waiter : waiters) {
+    InvokeCallback(waiter, STATUS(Aborted, "Wait queue is shutting down"));
+  }
+}
+
+void WaitQueue::InvokeCallback(const WaiterPtr& waiter, const Status& status) {
+  wait_time_->Increment(MonoDelta(CoarseMonoClock::now() - waiter->start_time).ToMicroseconds());
+  context_.Enqueue(new WaitDoneTask(std::move(waiter->callback), status));
+}
+
+size_t WaitQueue::TEST_num_waiters() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return waiters_by_id_.size();
+}
+
+std::string WaitQueue::LogPrefix() const {
+  return context_.LogPrefix();
+}
+
+} // namespace tablet
+} // namespace yb
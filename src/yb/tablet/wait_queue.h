@@ -0,0 +1,119 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_WAIT_QUEUE_H
+#define YB_TABLET_WAIT_QUEUE_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/transaction.h"
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/tablet/tablet_fwd.h"
+
+#include "yb/util/metrics_fwd.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tablet {
+
+// Queue of transactional writes that conflict with pending transactions, and wait for them to
+// finish instead of resolving the conflict by aborting one of the transactions.
+//
+// A waiter is woken up when any of its blockers is committed or aborted at this tablet, so it
+// could retry conflict resolution. Time that a waiter could spend in the queue is limited by
+// wait_queue_max_wait_ms, and a waiter that would form a cycle with other waiters of this tablet
+// is not enqueued at all. In both cases the waiter falls back to priority based conflict
+// resolution, so deadlocks, including ones that span multiple tablets, are broken by aborting one
+// of the transactions.
+//
+// Callbacks are invoked in the thread pool of the participant context, never from the thread that
+// signals the queue. Thread safe.
+class WaitQueue {
+ public:
+  // Invoked with OK status when some of the blockers finished, and with TimedOut when the waiter
+  // should not wait anymore and should resolve conflicts by priority. Other errors mean that the
+  // tablet is shutting down.
+  using WaitDoneCallback = std::function<void(const Status&)>;
+
+  WaitQueue(TransactionParticipantContext* context, const scoped_refptr<MetricEntity>& entity);
+  ~WaitQueue();
+
+  // Returns the number of finished transactions signaled so far. It should be taken before the
+  // blockers are found and passed to WaitOn, so a blocker that finishes in between is not missed.
+  uint64_t finished_generation();
+
+  // Enqueues waiter transaction that is blocked by blockers. Callback is invoked exactly once.
+  // If some of the blockers finished after finished_generation, the callback is invoked right
+  // away, since their SignalFinished would not wake up the waiter.
+  void WaitOn(const TransactionId& waiter, std::vector<TransactionId> blockers,
+              uint64_t finished_generation, CoarseTimePoint deadline, WaitDoneCallback callback);
+
+  // Wakes up waiters blocked by specified transaction. Should be invoked when transaction is
+  // committed or aborted.
+  void SignalFinished(const TransactionId& id);
+
+  // Wakes up waiters whose wait time expired.
+  void Poll(CoarseTimePoint now);
+
+  // Wakes up all waiters with failure, following calls to WaitOn fail immediately.
+  void StartShutdown();
+
+  size_t TEST_num_waiters();
+
+ private:
+  struct Waiter;
+  using WaiterPtr = std::shared_ptr<Waiter>;
+
+  // Returns true if the waiter would wait for itself through blockers and other waiters.
+  bool HasCycle(const TransactionId& waiter, const std::vector<TransactionId>& blockers)
+      REQUIRES(mutex_);
+
+  // Returns true if some of blockers could have finished after generation.
+  bool BlockerFinishedSince(const std::vector<TransactionId>& blockers, uint64_t generation)
+      REQUIRES(mutex_);
+
+  void RemoveUnlocked(const WaiterPtr& waiter) REQUIRES(mutex_);
+
+  void InvokeCallback(const WaiterPtr& waiter, const Status& status);
+
+  std::string LogPrefix() const;
+
+  TransactionParticipantContext& context_;
+
+  std::mutex mutex_;
+  bool closing_ GUARDED_BY(mutex_) = false;
+  std::unordered_multimap<TransactionId, WaiterPtr, TransactionIdHash> waiters_by_blocker_
+      GUARDED_BY(mutex_);
+  std::unordered_multimap<TransactionId, WaiterPtr, TransactionIdHash> waiters_by_id_
+      GUARDED_BY(mutex_);
+  uint64_t finished_generation_ GUARDED_BY(mutex_) = 0;
+  // Last finished transactions, the last one was signaled at finished_generation_.
+  std::deque<TransactionId> recently_finished_ GUARDED_BY(mutex_);
+
+  scoped_refptr<Histogram> wait_time_;
+  scoped_refptr<AtomicGauge<uint64_t>> num_waiters_;
+  scoped_refptr<Counter> deadlocks_;
+  scoped_refptr<Counter> expired_waits_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_WAIT_QUEUE_H
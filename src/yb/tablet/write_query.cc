@@ -36,16 +36,20 @@
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/transaction_participant.h"
+#include "yb/tablet/wait_queue.h"
 #include "yb/tablet/write_query_context.h"
 
 #include "yb/tserver/tserver.pb.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
 #include "yb/util/trace.h"
 
 using namespace std::placeholders;
 
+DECLARE_bool(enable_wait_queues);
+
 namespace yb {
 namespace tablet {
 
@@ -442,7 +446,8 @@ CHECKED_STATUS WriteQuery::DoExecute() {
   }
 
   if (isolation_level_ == IsolationLevel::SERIALIZABLE_ISOLATION &&
-      prepare_result_.need_read_snapshot) {
+      prepare_result_.need_read_snapshot && !read_pairs_added_) {
+    read_pairs_added_ = true;
     boost::container::small_vector<RefCntPrefix, 16> paths;
     for (const auto& doc_op : doc_ops_) {
       paths.clear();
@@ -461,11 +466,22 @@ CHECKED_STATUS WriteQuery::DoExecute() {
     }
   }
 
+  docdb::WaitForTransactionsCallback wait_callback;
+  if (GetAtomicFlag(&FLAGS_enable_wait_queues) && !wait_expired_) {
+    // Taken before conflicts are resolved, so blockers that finish meanwhile are detected.
+    auto finished_generation = transaction_participant->wait_queue()->finished_generation();
+    wait_callback = [this, finished_generation](
+        const TransactionId& waiter, std::vector<TransactionId> blockers) {
+      WaitForTransactions(waiter, std::move(blockers), finished_generation);
+    };
+  }
+
   docdb::ResolveTransactionConflicts(
       doc_ops_, write_batch, tablet().clock()->Now(),
       read_time_ ? read_time_.read : HybridTime::kMax,
       tablet().doc_db(), partial_range_key_intents,
       transaction_participant, tablet().metrics()->transaction_conflicts.get(),
+      std::move(wait_callback),
       [this](const Result<HybridTime>& result) {
         if (!result.ok()) {
           ExecuteDone(result.status());
@@ -479,6 +495,36 @@ CHECKED_STATUS WriteQuery::DoExecute() {
   return Status::OK();
 }
 
+void WriteQuery::WaitForTransactions(
+    const TransactionId& waiter, std::vector<TransactionId> blockers,
+    uint64_t finished_generation) {
+  // Locks and request scope should not be held while waiting, otherwise blockers could not
+  // proceed, and could not be removed from the participant.
+  prepare_result_.lock_batch.Reset();
+  request_scope_ = RequestScope();
+  TRACE("Wait for $0 transactions", blockers.size());
+  tablet().transaction_participant()->wait_queue()->WaitOn(
+      waiter, std::move(blockers), finished_generation, deadline(), [this](const Status& status) {
+    WaitDone(status);
+  });
+}
+
+void WriteQuery::WaitDone(const Status& status) {
+  TRACE("WaitDone: $0", status.ToString());
+  if (status.IsTimedOut()) {
+    // Do not wait again, resolve conflicts by transaction priority.
+    wait_expired_ = true;
+  } else if (!status.ok()) {
+    ExecuteDone(status);
+    return;
+  }
+
+  auto execute_status = DoExecute();
+  if (!execute_status.ok()) {
+    ExecuteDone(execute_status);
+  }
+}
+
 void WriteQuery::NonTransactionalConflictsResolved(HybridTime now, HybridTime result) {
   if (now != result) {
     tablet().clock()->Update(result);
@@ -139,6 +139,13 @@ class WriteQuery {
   Result<bool> PrepareExecute();
   CHECKED_STATUS DoExecute();
 
+  // Releases locks and waits for blockers to finish, then executes the query again.
+  void WaitForTransactions(
+      const TransactionId& waiter, std::vector<TransactionId> blockers,
+      uint64_t finished_generation);
+
+  void WaitDone(const Status& status);
+
   void NonTransactionalConflictsResolved(HybridTime now, HybridTime result);
 
   void TransactionalConflictsResolved();
@@ -218,6 +225,10 @@ class WriteQuery {
   IsolationLevel isolation_level_;
   docdb::PrepareDocWriteOperationResult prepare_result_;
   RequestScope request_scope_;
+  // Set when the wait for conflicting transactions expired, so conflicts are resolved by priority.
+  bool wait_expired_ = false;
+  // Set when read pairs for serializable isolation were added to the write batch.
+  bool read_pairs_added_ = false;
   std::unique_ptr<WriteQuery> self_; // Keep self while Execute is performed.
 };
 
@@ -39,6 +39,7 @@
 
 #include "yb/tserver/pg_client_session.h"
 #include "yb/tserver/pg_create_table.h"
+#include "yb/tserver/pg_response_cache.h"
 #include "yb/tserver/pg_table_cache.h"
 
 #include "yb/util/net/net_util.h"
@@ -126,11 +127,13 @@ class PgClientServiceImpl::Impl {
       const std::shared_future<client::YBClient*>& client_future,
       const scoped_refptr<ClockBase>& clock,
       TransactionPoolProvider transaction_pool_provider,
+      const scoped_refptr<MetricEntity>& entity,
       rpc::Scheduler* scheduler)
       : client_future_(client_future),
         clock_(clock),
         transaction_pool_provider_(std::move(transaction_pool_provider)),
         table_cache_(client_future),
+        response_cache_(entity),
         check_expired_sessions_(scheduler) {
     ScheduleCheckExpiredSessions(CoarseMonoClock::now());
   }
@@ -147,7 +150,8 @@ class PgClientServiceImpl::Impl {
 
     auto session_id = ++session_serial_no_;
     auto session = std::make_shared<PgClientSession>(
-            &client(), clock_, transaction_pool_provider_, &table_cache_, session_id);
+            &client(), clock_, transaction_pool_provider_, &table_cache_, &response_cache_,
+            session_id);
     resp->set_session_id(session_id);
 
     std::lock_guard<rw_spinlock> lock(mutex_);
@@ -358,6 +362,7 @@ class PgClientServiceImpl::Impl {
   scoped_refptr<ClockBase> clock_;
   TransactionPoolProvider transaction_pool_provider_;
   PgTableCache table_cache_;
+  PgResponseCache response_cache_;
   rw_spinlock mutex_;
 
   class ExpirationTag;
@@ -398,7 +403,8 @@ PgClientServiceImpl::PgClientServiceImpl(
     const scoped_refptr<MetricEntity>& entity,
     rpc::Scheduler* scheduler)
     : PgClientServiceIf(entity),
-      impl_(new Impl(client_future, clock, std::move(transaction_pool_provider), scheduler)) {}
+      impl_(new Impl(
+          client_future, clock, std::move(transaction_pool_provider), entity, scheduler)) {}
 
 PgClientServiceImpl::~PgClientServiceImpl() {}
 
@@ -36,6 +36,7 @@
 
 #include "yb/tserver/pg_client.pb.h"
 #include "yb/tserver/pg_create_table.h"
+#include "yb/tserver/pg_response_cache.h"
 #include "yb/tserver/pg_table_cache.h"
 
 #include "yb/util/logging.h"
@@ -270,6 +271,9 @@ struct PerformData {
   rpc::RpcContext context;
   PgClientSessionOperations ops;
   PgTableCache* table_cache;
+  PgResponseCache* response_cache;
+  // Not empty when the response should be added to the response cache.
+  std::string cache_key;
 
   void FlushDone(client::FlushStatus* flush_status) {
     auto status = CombineErrorsToStatus(flush_status->errors, flush_status->status);
@@ -302,6 +306,10 @@ struct PerformData {
       ++idx;
     }
 
+    if (!cache_key.empty()) {
+      return ProcessCachedResponse();
+    }
+
     auto& responses = *resp->mutable_responses();
     responses.Reserve(narrow_cast<int>(ops.size()));
     for (const auto& op : ops) {
@@ -314,6 +322,25 @@ struct PerformData {
 
     return Status::OK();
   }
+
+  // Fills the response and keeps its copy in the response cache.
+  CHECKED_STATUS ProcessCachedResponse() {
+    auto cached = std::make_shared<PgResponseCache::Response>();
+    auto& responses = *resp->mutable_responses();
+    responses.Reserve(narrow_cast<int>(ops.size()));
+    for (const auto& op : ops) {
+      auto& op_resp = *responses.Add();
+      op_resp.Swap(op->mutable_response());
+      if (op_resp.has_rows_data_sidecar()) {
+        const auto& rows_data = op->rows_data();
+        op_resp.set_rows_data_sidecar(narrow_cast<int>(context.AddRpcSidecar(rows_data)));
+        cached->rows_data.emplace_back(rows_data.cdata(), rows_data.size());
+      }
+    }
+    cached->response = *resp;
+    response_cache->Set(req->options().catalog_cache_version(), cache_key, std::move(cached));
+    return Status::OK();
+  }
 };
 
 client::YBSessionPtr CreateSession(
@@ -329,11 +356,11 @@ client::YBSessionPtr CreateSession(
 PgClientSession::PgClientSession(
     client::YBClient* client, const scoped_refptr<ClockBase>& clock,
     std::reference_wrapper<const TransactionPoolProvider> transaction_pool_provider,
-    PgTableCache* table_cache, uint64_t id)
+    PgTableCache* table_cache, PgResponseCache* response_cache, uint64_t id)
     : client_(*client),
       clock_(clock),
       transaction_pool_provider_(transaction_pool_provider.get()),
-      table_cache_(*table_cache), id_(id) {
+      table_cache_(*table_cache), response_cache_(*response_cache), id_(id) {
 }
 
 uint64_t PgClientSession::id() const {
@@ -549,6 +576,24 @@ Status PgClientSession::FinishTransaction(
 
 Status PgClientSession::Perform(
     const PgPerformRequestPB& req, PgPerformResponsePB* resp, rpc::RpcContext* context) {
+  auto cache_key = PgResponseCache::MakeKey(req);
+  if (!cache_key.empty()) {
+    auto cached = response_cache_.Get(req.options().catalog_cache_version(), cache_key);
+    if (cached) {
+      VLOG_WITH_PREFIX(3) << "Response served from cache";
+      *resp = cached->response;
+      size_t rows_data_idx = 0;
+      for (auto& op_resp : *resp->mutable_responses()) {
+        if (op_resp.has_rows_data_sidecar()) {
+          op_resp.set_rows_data_sidecar(narrow_cast<int>(
+              context->AddRpcSidecar(cached->rows_data[rows_data_idx++].AsSlice())));
+        }
+      }
+      context->RespondSuccess();
+      return Status::OK();
+    }
+  }
+
   auto session = VERIFY_RESULT(SetupSession(req, context->GetClientDeadline()));
 
   auto ops = VERIFY_RESULT(PrepareOperations(req, session, &table_cache_));
@@ -559,6 +604,8 @@ Status PgClientSession::Perform(
     .context = std::move(*context),
     .ops = std::move(ops),
     .table_cache = &table_cache_,
+    .response_cache = &response_cache_,
+    .cache_key = std::move(cache_key),
   });
   session->FlushAsync([data](client::FlushStatus* flush_status) {
     data->FlushDone(flush_status);
@@ -646,6 +693,11 @@ Result<client::YBSession*> PgClientSession::SetupSession(
     session->DeferReadPoint();
   }
 
+  session->SetFollowerReadMaxStaleness(
+      options.follower_read_max_staleness_ms()
+          ? MonoDelta::FromMilliseconds(options.follower_read_max_staleness_ms())
+          : MonoDelta());
+
   if (!options.ddl_mode() && !options.use_catalog_session()) {
     txn_serial_no_ = options.txn_serial_no();
 
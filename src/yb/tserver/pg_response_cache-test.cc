@@ -0,0 +1,124 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/common/pgsql_protocol.pb.h"
+
+#include "yb/tserver/pg_response_cache.h"
+
+#include "yb/util/metrics.h"
+#include "yb/util/test_util.h"
+
+METRIC_DECLARE_counter(pg_response_cache_hits);
+METRIC_DECLARE_counter(pg_response_cache_misses);
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+PgPerformRequestPB CatalogScanRequest(uint64_t catalog_version, uint64_t stmt_id = 1) {
+  PgPerformRequestPB req;
+  req.mutable_options()->set_use_catalog_session(true);
+  req.mutable_options()->set_catalog_cache_version(catalog_version);
+  auto& read = *req.add_ops()->mutable_read();
+  read.set_table_id("pg_class");
+  read.set_stmt_id(stmt_id);
+  read.set_ysql_catalog_version(catalog_version);
+  return req;
+}
+
+PgResponseCache::ResponsePtr MakeResponse(const std::string& rows_data) {
+  auto result = std::make_shared<PgResponseCache::Response>();
+  result->response.add_responses()->set_rows_data_sidecar(0);
+  result->rows_data.emplace_back(rows_data);
+  return result;
+}
+
+} // namespace
+
+class PgResponseCacheTest : public YBTest {
+};
+
+TEST_F(PgResponseCacheTest, MakeKey) {
+  auto req = CatalogScanRequest(1);
+  const auto key = PgResponseCache::MakeKey(req);
+  ASSERT_FALSE(key.empty());
+
+  // Key does not depend on the catalog version, the version is checked separately.
+  ASSERT_EQ(key, PgResponseCache::MakeKey(CatalogScanRequest(2)));
+
+  req.mutable_ops(0)->mutable_read()->set_limit(10);
+  ASSERT_NE(key, PgResponseCache::MakeKey(req));
+
+  // Reads by key are not cached.
+  req.mutable_ops(0)->mutable_read()->add_partition_column_values();
+  ASSERT_TRUE(PgResponseCache::MakeKey(req).empty());
+
+  req = CatalogScanRequest(0);
+  ASSERT_TRUE(PgResponseCache::MakeKey(req).empty());
+
+  req = CatalogScanRequest(1);
+  req.mutable_options()->set_use_catalog_session(false);
+  ASSERT_TRUE(PgResponseCache::MakeKey(req).empty());
+
+  req = CatalogScanRequest(1);
+  req.add_ops()->mutable_write();
+  ASSERT_TRUE(PgResponseCache::MakeKey(req).empty());
+}
+
+TEST_F(PgResponseCacheTest, CatalogVersion) {
+  PgResponseCache cache(nullptr);
+  const auto key = PgResponseCache::MakeKey(CatalogScanRequest(1));
+  ASSERT_EQ(cache.Get(1, key), nullptr);
+
+  cache.Set(1, key, MakeResponse("v1"));
+  auto response = cache.Get(1, key);
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(response->rows_data.front().AsSlice().ToBuffer(), "v1");
+  ASSERT_EQ(cache.Get(2, key), nullptr);
+
+  // Response of an older version does not replace entries of the current one.
+  cache.Set(2, key, MakeResponse("v2"));
+  cache.Set(1, key, MakeResponse("v1"));
+  ASSERT_EQ(cache.Get(1, key), nullptr);
+  response = cache.Get(2, key);
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(response->rows_data.front().AsSlice().ToBuffer(), "v2");
+}
+
+TEST_F(PgResponseCacheTest, SharedBetweenSessions) {
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_server.Instantiate(&registry, "pg_response_cache-test");
+  auto hits = METRIC_pg_response_cache_hits.Instantiate(entity);
+  auto misses = METRIC_pg_response_cache_misses.Instantiate(entity);
+  PgResponseCache cache(entity);
+
+  // Each backend uses its own statement ids, the same read should still be found in the cache.
+  const auto first_key = PgResponseCache::MakeKey(CatalogScanRequest(1, /* stmt_id = */ 0x1000));
+  const auto second_key = PgResponseCache::MakeKey(CatalogScanRequest(1, /* stmt_id = */ 0x2000));
+  ASSERT_EQ(first_key, second_key);
+
+  ASSERT_EQ(cache.Get(1, first_key), nullptr);
+  ASSERT_EQ(misses->value(), 1);
+  cache.Set(1, first_key, MakeResponse("rows"));
+
+  auto response = cache.Get(1, second_key);
+  ASSERT_NE(response, nullptr);
+  ASSERT_EQ(response->rows_data.front().AsSlice().ToBuffer(), "rows");
+  ASSERT_EQ(hits->value(), 1);
+  ASSERT_EQ(misses->value(), 1);
+}
+
+} // namespace tserver
+} // namespace yb
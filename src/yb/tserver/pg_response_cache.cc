@@ -0,0 +1,125 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/tserver/pg_response_cache.h"
+
+#include "yb/common/pgsql_protocol.pb.h"
+
+#include "yb/util/atomic.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+
+DEFINE_uint64(pg_response_cache_capacity, 1024,
+              "Maximal number of catalog read responses cached by the tablet server. The cache "
+              "is cleared when it is full.");
+TAG_FLAG(pg_response_cache_capacity, advanced);
+TAG_FLAG(pg_response_cache_capacity, runtime);
+
+METRIC_DEFINE_counter(server, pg_response_cache_hits,
+                      "PG Response Cache Hits", yb::MetricUnit::kRequests,
+                      "Number of catalog reads served from the tablet server response cache.");
+METRIC_DEFINE_counter(server, pg_response_cache_misses,
+                      "PG Response Cache Misses", yb::MetricUnit::kRequests,
+                      "Number of cacheable catalog reads that were not found in the tablet server "
+                      "response cache.");
+
+namespace yb {
+namespace tserver {
+
+namespace {
+
+// Whether the read scans the whole table, or the range of it between partition bounds.
+bool IsFullScan(const PgsqlReadRequestPB& read) {
+  return read.partition_column_values().empty() && read.range_column_values().empty() &&
+         !read.has_condition_expr() && read.where_clauses().empty() &&
+         !read.has_ybctid_column_value() && read.batch_arguments().empty() &&
+         !read.has_index_request() && !read.has_hash_code() && !read.has_max_hash_code() &&
+         !read.is_for_backfill() && !read.has_sampling_state();
+}
+
+} // namespace
+
+PgResponseCache::PgResponseCache(const scoped_refptr<MetricEntity>& metric_entity) {
+  // We may not have a metric entity in tests.
+  if (metric_entity) {
+    hits_ = METRIC_pg_response_cache_hits.Instantiate(metric_entity);
+    misses_ = METRIC_pg_response_cache_misses.Instantiate(metric_entity);
+  }
+}
+
+PgResponseCache::~PgResponseCache() = default;
+
+std::string PgResponseCache::MakeKey(const PgPerformRequestPB& req) {
+  const auto& options = req.options();
+  if (!options.catalog_cache_version() || !options.use_catalog_session() || req.ops().empty()) {
+    return std::string();
+  }
+  std::string result;
+  PgsqlReadRequestPB read;
+  for (const auto& op : req.ops()) {
+    if (!op.has_read() || !IsFullScan(op.read())) {
+      return std::string();
+    }
+    result += op.read_from_followers() ? 'F' : 'L';
+    // Statement id is the address of the request in the backend, and the catalog version is
+    // checked separately, so they are cleared to let different backends share the entry.
+    read = op.read();
+    read.clear_stmt_id();
+    read.clear_ysql_catalog_version();
+    const auto serialized = read.SerializeAsString();
+    const uint32_t size = serialized.size();
+    result.append(reinterpret_cast<const char*>(&size), sizeof(size));
+    result += serialized;
+  }
+  return result;
+}
+
+PgResponseCache::ResponsePtr PgResponseCache::Get(
+    uint64_t catalog_version, const std::string& key) {
+  ResponsePtr result;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (catalog_version == catalog_version_) {
+      auto it = entries_.find(key);
+      if (it != entries_.end()) {
+        result = it->second;
+      }
+    }
+  }
+  const auto& counter = result ? hits_ : misses_;
+  if (counter) {
+    counter->Increment();
+  }
+  return result;
+}
+
+void PgResponseCache::Set(
+    uint64_t catalog_version, const std::string& key, ResponsePtr response) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (catalog_version < catalog_version_) {
+    return;
+  }
+  if (catalog_version > catalog_version_ ||
+      entries_.size() >= GetAtomicFlag(&FLAGS_pg_response_cache_capacity)) {
+    VLOG(1) << "Clearing " << entries_.size() << " responses of catalog version "
+            << catalog_version_ << ", new catalog version " << catalog_version;
+    entries_.clear();
+    catalog_version_ = catalog_version;
+  }
+  entries_.emplace(key, std::move(response));
+}
+
+}  // namespace tserver
+}  // namespace yb
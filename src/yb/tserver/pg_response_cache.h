@@ -0,0 +1,79 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#ifndef YB_TSERVER_PG_RESPONSE_CACHE_H
+#define YB_TSERVER_PG_RESPONSE_CACHE_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/gutil/thread_annotations.h"
+
+#include "yb/tserver/pg_client.pb.h"
+
+#include "yb/util/metrics_fwd.h"
+#include "yb/util/ref_cnt_buffer.h"
+
+namespace yb {
+namespace tserver {
+
+// Cache of responses to catalog reads, shared by all Postgres backends connected to this tablet
+// server. So new connections that preload their catalog caches get the rows from the tablet
+// server memory, instead of scanning the sys catalog tablet at the master.
+//
+// Entries are valid for the single catalog version, the version is supplied by the backends from
+// the tablet server shared memory. Only full scans of catalog tables are cached. DDLs that do not
+// increment the catalog version only add objects, and Postgres does not cache negative lookups
+// of them, while lookups by key are never served from this cache.
+//
+// Thread safe.
+class PgResponseCache {
+ public:
+  struct Response {
+    PgPerformResponsePB response;
+    std::vector<RefCntBuffer> rows_data;
+  };
+  using ResponsePtr = std::shared_ptr<const Response>;
+
+  // Hits and misses are counted in the metric entity, when it is specified.
+  explicit PgResponseCache(const scoped_refptr<MetricEntity>& metric_entity);
+  ~PgResponseCache();
+
+  // Returns the key of the request, or empty string if response to this request should not be
+  // cached. Fields that differ between backends issuing the same read, like the statement id, are
+  // not part of the key.
+  static std::string MakeKey(const PgPerformRequestPB& req);
+
+  // Returns nullptr if there is no response for the key at the specified catalog version.
+  ResponsePtr Get(uint64_t catalog_version, const std::string& key);
+
+  // Entries of older catalog versions are dropped when a response of a newer version is added.
+  void Set(uint64_t catalog_version, const std::string& key, ResponsePtr response);
+
+ private:
+  scoped_refptr<Counter> hits_;
+  scoped_refptr<Counter> misses_;
+
+  std::mutex mutex_;
+  uint64_t catalog_version_ GUARDED_BY(mutex_) = 0;
+  std::unordered_map<std::string, ResponsePtr> entries_ GUARDED_BY(mutex_);
+};
+
+}  // namespace tserver
+}  // namespace yb
+
+#endif  // YB_TSERVER_PG_RESPONSE_CACHE_H
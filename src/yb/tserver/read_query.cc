@@ -283,7 +283,7 @@ CHECKED_STATUS ReadQuery::DoPerform() {
   } else {
     abstract_tablet_ = VERIFY_RESULT(read_tablet_provider_.GetTabletForRead(
         req_->tablet_id(), std::move(peer_tablet.tablet_peer),
-        req_->consistency_level(), AllowSplitTablet::kFalse));
+        req_->consistency_level(), AllowSplitTablet::kFalse, req_->max_staleness_ms()));
     leader_peer.leader_term = OpId::kUnknownTerm;
   }
 
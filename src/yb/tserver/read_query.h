@@ -40,7 +40,8 @@ class ReadTabletProvider {
  public:
   virtual Result<std::shared_ptr<tablet::AbstractTablet>> GetTabletForRead(
     const TabletId& tablet_id, tablet::TabletPeerPtr tablet_peer,
-    YBConsistencyLevel consistency_level, AllowSplitTablet allow_split_tablet) = 0;
+    YBConsistencyLevel consistency_level, AllowSplitTablet allow_split_tablet,
+    uint64_t max_staleness_ms) = 0;
 
   virtual ~ReadTabletProvider() = default;
 };
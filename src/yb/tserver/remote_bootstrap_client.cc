@@ -288,6 +288,7 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
       table.schema(), &schema), "Cannot deserialize schema from remote superblock");
   string data_root_dir;
   string wal_root_dir;
+  string cold_data_root_dir;
   if (replace_tombstoned_tablet_) {
     // Also validate the term of the bootstrap source peer, in case they are
     // different. This is a sanity check that protects us in case a bug or
@@ -307,6 +308,11 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
     }
     // Replace rocksdb_dir in the received superblock with our rocksdb_dir.
     kv_store->set_rocksdb_dir(meta_->rocksdb_dir());
+    if (meta_->cold_rocksdb_dir().empty()) {
+      kv_store->clear_cold_rocksdb_dir();
+    } else {
+      kv_store->set_cold_rocksdb_dir(meta_->cold_rocksdb_dir());
+    }
 
     // Replace wal_dir in the received superblock with our assigned wal_dir.
     superblock_->set_wal_dir(meta_->wal_dir());
@@ -318,12 +324,14 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
     // Update the directory assignment mapping.
     data_root_dir = meta_->data_root_dir();
     wal_root_dir = meta_->wal_root_dir();
+    cold_data_root_dir = meta_->cold_data_root_dir();
     if (ts_manager != nullptr) {
       ts_manager->RegisterDataAndWalDir(&fs_manager(),
                                         table_id,
                                         meta_->raft_group_id(),
                                         data_root_dir,
-                                        wal_root_dir);
+                                        wal_root_dir,
+                                        cold_data_root_dir);
     }
   } else {
     Partition partition;
@@ -336,7 +344,8 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
                                               table_id,
                                               tablet_id_,
                                               &data_root_dir,
-                                              &wal_root_dir);
+                                              &wal_root_dir,
+                                              &cold_data_root_dir);
     }
     auto table_info = std::make_shared<tablet::TableInfo>(
         table_id, table.namespace_name(), table.table_name(), table.table_type(), schema,
@@ -349,9 +358,10 @@ Status RemoteBootstrapClient::Start(const string& bootstrap_peer_uuid,
         .raft_group_id = tablet_id_,
         .partition = partition,
         .tablet_data_state = tablet::TABLET_DATA_COPYING,
-        .colocated = colocated }, data_root_dir, wal_root_dir);
+        .colocated = colocated }, data_root_dir, wal_root_dir, cold_data_root_dir);
     if (ts_manager != nullptr && !create_result.ok()) {
-      ts_manager->UnregisterDataWalDir(table_id, tablet_id_, data_root_dir, wal_root_dir);
+      ts_manager->UnregisterDataWalDir(
+          table_id, tablet_id_, data_root_dir, wal_root_dir, cold_data_root_dir);
     }
     RETURN_NOT_OK(create_result);
     meta_ = std::move(*create_result);
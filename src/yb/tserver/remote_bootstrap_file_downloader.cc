@@ -23,12 +23,15 @@
 
 #include "yb/tserver/remote_bootstrap.proxy.h"
 
+#include "yb/util/async_util.h"
 #include "yb/util/crc.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/net/rate_limiter.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
+#include "yb/util/status_log.h"
 
 using namespace yb::size_literals;
 
@@ -61,6 +64,18 @@ namespace tserver {
 
 namespace {
 
+// State of a single FetchData call issued by DownloadFile.
+struct FetchDataCall {
+  rpc::RpcController controller;
+  FetchDataRequestPB req;
+  FetchDataResponsePB resp;
+  Synchronizer synchronizer;
+};
+
+} // namespace
+
+namespace {
+
 // Decode the remote error into a human-readable Status object.
 CHECKED_STATUS ExtractRemoteError(
     const rpc::ErrorStatusPB& remote_error, const Status& original_status) {
@@ -167,16 +182,21 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
     rate_limiter = std::make_unique<RateLimiter>();
   }
 
-  rpc::RpcController controller;
-  controller.set_timeout(session_idle_timeout_);
-  FetchDataRequestPB req;
+  // The rate limiter is updated with the size of each received chunk, because fetch calls are
+  // asynchronous.
+  if (!rate_limiter->IsInitialized()) {
+    rate_limiter->Init();
+  }
 
-  bool done = false;
-  while (!done) {
-    controller.Reset();
-    req.set_session_id(session_id_);
-    req.mutable_data_id()->CopyFrom(data_id);
-    req.set_offset(offset);
+  auto send_fetch_data = [this, &data_id, &max_length, &rate_limiter](
+      uint64_t chunk_offset, FetchDataCall* call) {
+    call->controller.Reset();
+    call->controller.set_timeout(session_idle_timeout_);
+    call->synchronizer.Reset();
+    call->resp.Clear();
+    call->req.set_session_id(session_id_);
+    call->req.mutable_data_id()->CopyFrom(data_id);
+    call->req.set_offset(chunk_offset);
     if (rate_limiter->active()) {
       auto max_size = rate_limiter->GetMaxSizeForNextTransmission();
       if (max_size > std::numeric_limits<decltype(max_length)>::max()) {
@@ -184,14 +204,40 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
       }
       max_length = std::min(max_length, decltype(max_length)(max_size));
     }
-    req.set_max_length(max_length);
+    call->req.set_max_length(max_length);
+    auto callback = call->synchronizer.AsStdStatusCallback();
+    proxy_->FetchDataAsync(call->req, &call->resp, &call->controller, [callback, call] {
+      callback(call->controller.status());
+    });
+  };
+
+  // The next chunk is requested before the current one is verified and written, so network
+  // transfer overlaps with checksum verification and disk writes.
+  auto current = std::make_unique<FetchDataCall>();
+  auto next = std::make_unique<FetchDataCall>();
+  bool next_in_flight = false;
+  auto se = ScopeExit([&next, &next_in_flight] {
+    // Response and controller of the outstanding call should outlive it.
+    if (next_in_flight) {
+      WARN_NOT_OK(next->synchronizer.Wait(), "Prefetch of remote bootstrap data failed");
+    }
+  });
 
-    FetchDataResponsePB resp;
-    auto status = rate_limiter->SendOrReceiveData([this, &req, &resp, &controller]() {
-      return proxy_->FetchData(req, &resp, &controller);
-    }, [&resp]() { return resp.ByteSize(); });
-    RETURN_NOT_OK_UNWIND_PREPEND(status, controller, "Unable to fetch data from remote");
-    DCHECK_LE(resp.chunk().data().size(), max_length);
+  send_fetch_data(offset, current.get());
+  bool done = false;
+  while (!done) {
+    auto status = current->synchronizer.Wait();
+    RETURN_NOT_OK_UNWIND_PREPEND(status, current->controller, "Unable to fetch data from remote");
+    const auto& resp = current->resp;
+    rate_limiter->UpdateDataSizeAndMaybeSleep(resp.ByteSize());
+    DCHECK_LE(resp.chunk().data().size(), current->req.max_length());
+
+    auto next_offset = offset + resp.chunk().data().size();
+    done = next_offset == implicit_cast<size_t>(resp.chunk().total_data_length());
+    if (!done) {
+      send_fetch_data(next_offset, next.get());
+      next_in_flight = true;
+    }
 
     // Sanity-check for corruption.
     RETURN_NOT_OK_PREPEND(VerifyData(offset, resp.chunk()),
@@ -202,11 +248,7 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
     VLOG_WITH_PREFIX(3)
         << "resp size: " << resp.ByteSize() << ", chunk size: " << resp.chunk().data().size();
 
-    if (offset + resp.chunk().data().size() ==
-            implicit_cast<size_t>(resp.chunk().total_data_length())) {
-      done = true;
-    }
-    offset += resp.chunk().data().size();
+    offset = next_offset;
     if (FLAGS_bytes_remote_bootstrap_durable_write_mb != 0) {
       periodic_sync_unsynced_bytes += resp.chunk().data().size();
       if (periodic_sync_unsynced_bytes > FLAGS_bytes_remote_bootstrap_durable_write_mb * 1_MB) {
@@ -214,6 +256,9 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
         periodic_sync_unsynced_bytes = 0;
       }
     }
+
+    std::swap(current, next);
+    next_in_flight = false;
   }
 
   VLOG_WITH_PREFIX(2) << "Transmission rate: " << rate_limiter->GetRate();
@@ -164,6 +164,13 @@ void RemoteBootstrapServiceImpl::BeginRemoteBootstrapSession(
   RPC_RETURN_NOT_OK(tablet_peer->CheckRunning(),
                     RemoteBootstrapErrorPB::TABLET_NOT_FOUND,
                     Substitute("Tablet is not running yet: $0", tablet_id));
+  // Witness keeps only the WAL, so a replica bootstrapped from it would have no data.
+  auto tablet = tablet_peer->shared_tablet();
+  if (tablet && tablet->is_witness()) {
+    RPC_RETURN_APP_ERROR(RemoteBootstrapErrorPB::INVALID_REMOTE_BOOTSTRAP_REQUEST,
+                         Substitute("Tablet $0 is a witness and has no data", tablet_id),
+                         STATUS(IllegalState, "Remote bootstrap source is a witness"));
+  }
 
   scoped_refptr<RemoteBootstrapSession> session;
   {
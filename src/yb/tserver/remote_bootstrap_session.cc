@@ -123,6 +123,13 @@ Status RemoteBootstrapSession::ChangeRole() {
         tablet::RaftGroupStatePB_Name(tablet_state), tablet_state));
   }
 
+  // Peer that was bootstrapped from a follower is promoted by the leader once it catches up.
+  if (consensus->role() != PeerRole::LEADER) {
+    LOG(INFO) << "Not changing role of " << requestor_uuid_ << " in bootstrap session "
+              << session_id_ << ", local peer is not the leader";
+    return Status::OK();
+  }
+
   // If peer being bootstrapped is already a VOTER, don't send the ChangeConfig request. This could
   // happen when a tserver that is already a VOTER in the configuration tombstones its tablet, and
   // the leader starts bootstrapping it.
@@ -20,9 +20,11 @@
 #include "yb/util/status.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/ntp_clock.h"
 
 #include "yb/common/wire_protocol.h"
 
+#include "yb/server/hybrid_clock.h"
 #include "yb/server/skewed_clock.h"
 
 #include "yb/consensus/log_util.h"
@@ -47,6 +49,11 @@ Status MasterTServerParseFlagsAndInit(const std::string& server_type, int* argc,
   FLAGS_stderrthreshold = google::FATAL;
 
   server::SkewedClock::Register();
+#if !defined(__APPLE__)
+  server::HybridClock::RegisterProvider(NtpClock::Name(), [](const std::string&) {
+    return std::make_shared<NtpClock>();
+  });
+#endif
 
   ParseCommandLineFlags(argc, argv, /* remove_flag= */ true);
   if (*argc != 1) {
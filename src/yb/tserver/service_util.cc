@@ -13,6 +13,8 @@
 
 #include "yb/tserver/service_util.h"
 
+#include <algorithm>
+
 #include "yb/common/wire_protocol.h"
 
 #include "yb/consensus/consensus.h"
@@ -137,7 +139,18 @@ Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer) {
     typedef consensus::LeaderStatus LeaderStatus;
     auto status = leader_state.CreateStatus();
     switch (leader_state.status) {
-      case LeaderStatus::NOT_LEADER: FALLTHROUGH_INTENDED;
+      case LeaderStatus::NOT_LEADER: {
+        status = status.CloneAndAddErrorCode(
+            TabletServerError(TabletServerErrorPB::NOT_THE_LEADER));
+        // Let the client know who is the leader now, so it could update its cache and retry
+        // without waiting for the master lookup.
+        auto leader_uuid = consensus->ConsensusState(
+            consensus::CONSENSUS_CONFIG_COMMITTED).leader_uuid();
+        if (!leader_uuid.empty() && leader_uuid != tablet_peer.permanent_uuid()) {
+          status = status.CloneAndAddErrorCode(TabletServerLeaderHint({std::move(leader_uuid)}));
+        }
+        return status;
+      }
       case LeaderStatus::LEADER_BUT_NO_MAJORITY_REPLICATED_LEASE:
         // We are returning a NotTheLeader as opposed to LeaderNotReady, because there is a chance
         // that we're a partitioned-away leader, and the client needs to do another leader lookup.
@@ -267,7 +280,7 @@ Result<TabletPeerTablet> LookupTabletPeer(
 Result<std::shared_ptr<tablet::AbstractTablet>> GetTablet(
     TabletPeerLookupIf* tablet_manager, const TabletId& tablet_id,
     tablet::TabletPeerPtr tablet_peer, YBConsistencyLevel consistency_level,
-    AllowSplitTablet allow_split_tablet) {
+    AllowSplitTablet allow_split_tablet, uint64_t max_staleness_ms) {
   tablet::TabletPtr tablet_ptr = nullptr;
   if (tablet_peer) {
     DCHECK_EQ(tablet_peer->tablet_id(), tablet_id);
@@ -295,18 +308,33 @@ Result<std::shared_ptr<tablet::AbstractTablet>> GetTablet(
     auto s = CheckPeerIsLeader(*tablet_peer.get());
 
     // Peer is not the leader, so check that the time since it last heard from the leader is less
-    // than FLAGS_max_stale_read_bound_time_ms.
+    // than FLAGS_max_stale_read_bound_time_ms and the bound requested by the client.
     if (PREDICT_FALSE(!s.ok())) {
-      if (FLAGS_max_stale_read_bound_time_ms > 0) {
+      if (tablet_peer->tablet()->is_witness()) {
+        // Witness does not have tablet data, so the read should be retried on another replica.
+        return STATUS(
+            IllegalState, "Witness does not serve reads",
+            TabletServerError(TabletServerErrorPB::STALE_FOLLOWER));
+      }
+      uint64_t staleness_bound_ms = FLAGS_max_stale_read_bound_time_ms;
+      if (max_staleness_ms > 0 &&
+          (staleness_bound_ms == 0 || max_staleness_ms < staleness_bound_ms)) {
+        staleness_bound_ms = max_staleness_ms;
+      }
+      if (staleness_bound_ms > 0) {
         auto consensus = tablet_peer->shared_consensus();
         // TODO(hector): This safe time could be reused by the read operation.
         auto safe_time_micros = tablet_peer->tablet()->mvcc_manager()->SafeTimeForFollower(
             HybridTime::kMin, CoarseTimePoint::min()).GetPhysicalValueMicros();
         auto now_micros = tablet_peer->clock_ptr()->Now().GetPhysicalValueMicros();
         auto follower_staleness_us = now_micros - safe_time_micros;
-        if (follower_staleness_us > FLAGS_max_stale_read_bound_time_ms * 1000) {
+        auto* metrics = tablet_peer->tablet()->metrics();
+        if (follower_staleness_us > staleness_bound_ms * 1000) {
           VLOG(1) << "Rejecting stale read with staleness "
                      << follower_staleness_us << "us";
+          if (metrics) {
+            metrics->stale_follower_read_rejections->Increment();
+          }
           return STATUS(
               IllegalState, "Stale follower",
               TabletServerError(TabletServerErrorPB::STALE_FOLLOWER));
@@ -319,6 +347,10 @@ Result<std::shared_ptr<tablet::AbstractTablet>> GetTablet(
                      << follower_staleness_us << "us";
         } else {
           VLOG(3) << "Reading from follower with staleness: " << follower_staleness_us << "us";
+          if (metrics) {
+            metrics->follower_read_staleness->Increment(std::max<int64_t>(
+                follower_staleness_us, 0));
+          }
         }
       }
     } else {
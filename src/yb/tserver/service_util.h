@@ -215,10 +215,12 @@ CHECKED_STATUS CheckPeerIsLeader(const tablet::TabletPeer& tablet_peer);
 CHECKED_STATUS CheckPeerIsReady(
     const tablet::TabletPeer& tablet_peer, AllowSplitTablet allow_split_tablet);
 
+// max_staleness_ms is the staleness bound of follower reads requested by the client, zero means
+// that only max_stale_read_bound_time_ms is applied.
 Result<std::shared_ptr<tablet::AbstractTablet>> GetTablet(
     TabletPeerLookupIf* tablet_manager, const TabletId& tablet_id,
     tablet::TabletPeerPtr tablet_peer, YBConsistencyLevel consistency_level,
-    AllowSplitTablet allow_split_tablet);
+    AllowSplitTablet allow_split_tablet, uint64_t max_staleness_ms = 0);
 
 CHECKED_STATUS CheckWriteThrottling(double score, tablet::TabletPeer* tablet_peer);
 
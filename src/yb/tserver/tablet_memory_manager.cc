@@ -13,6 +13,9 @@
 
 #include "yb/tserver/tablet_memory_manager.h"
 
+#include <algorithm>
+
+#include "yb/consensus/log.h"
 #include "yb/consensus/log_cache.h"
 #include "yb/consensus/raft_consensus.h"
 
@@ -21,19 +24,26 @@
 
 #include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/memory_monitor.h"
+#include "yb/rocksdb/persistent_cache.h"
+
+#include "yb/server/clock.h"
 
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_options.h"
 #include "yb/tablet/tablet_peer.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/background_task.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/status_log.h"
 
 using namespace std::literals;
 using namespace std::placeholders;
+using namespace yb::size_literals;
 
 DEFINE_bool(enable_log_cache_gc, true,
             "Set to true to enable log cache garbage collector.");
@@ -59,6 +69,7 @@ namespace {
 
 DEFINE_bool(enable_block_based_table_cache_gc, false,
             "Set to true to enable block based table garbage collector.");
+TAG_FLAG(enable_block_based_table_cache_gc, runtime);
 
 DEFINE_int64(db_block_cache_size_bytes, kDbCacheSizeUsePercentage,
              "Size of RocksDB block cache (in bytes). "
@@ -76,6 +87,96 @@ DEFINE_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_int32(db_block_cache_index_filter_percentage, 0,
+             "Percentage of the block cache size reserved for a separate cache of index and "
+             "filter blocks, so they are not evicted by data blocks during large scans. "
+             "0 means index and filter blocks share the cache with data blocks.");
+TAG_FLAG(db_block_cache_index_filter_percentage, advanced);
+
+DEFINE_bool(db_block_cache_frequency_admission, false,
+            "Admit new blocks to the block cache only when they are accessed at least as often as "
+            "the blocks they would evict (TinyLFU), so large scans do not flush frequently used "
+            "blocks out of the cache.");
+TAG_FLAG(db_block_cache_frequency_admission, advanced);
+
+DEFINE_string(db_persistent_block_cache_path, "",
+              "Directory on a fast local device, e.g. NVMe, used as a secondary cache of SST "
+              "blocks that are looked up on block cache misses. The directory is used "
+              "exclusively by the cache and its content survives restarts. Empty value disables "
+              "the cache.");
+TAG_FLAG(db_persistent_block_cache_path, advanced);
+
+DEFINE_int64(db_persistent_block_cache_size_bytes, 16_GB,
+             "Maximal size of the persistent block cache (in bytes).");
+TAG_FLAG(db_persistent_block_cache_size_bytes, advanced);
+
+DEFINE_int64(db_persistent_block_cache_file_size_bytes, 64_MB,
+             "Size of a single file of the persistent block cache (in bytes). The cache is "
+             "evicted one file at a time, starting from the oldest one.");
+TAG_FLAG(db_persistent_block_cache_file_size_bytes, advanced);
+
+DEFINE_bool(enable_global_memstore_cost_based_flush, false,
+            "When the global memstore limit is reached, pick tablets to flush by a cost model that "
+            "accounts for the size and age of the memtable, the WAL retained by it and the size of "
+            "pending intents, instead of picking the tablet with the oldest memtable write.");
+TAG_FLAG(enable_global_memstore_cost_based_flush, advanced);
+TAG_FLAG(enable_global_memstore_cost_based_flush, runtime);
+
+DEFINE_uint64(global_memstore_flush_age_weight_bytes_per_sec, 1_MB,
+              "Cost based flush: each second since the oldest write to a memtable adds this many "
+              "bytes to the flush score of the tablet.");
+TAG_FLAG(global_memstore_flush_age_weight_bytes_per_sec, advanced);
+TAG_FLAG(global_memstore_flush_age_weight_bytes_per_sec, runtime);
+
+DEFINE_uint64(global_memstore_flush_wal_segment_weight_bytes, 16_MB,
+              "Cost based flush: each WAL segment of the tablet, except the active one, adds this "
+              "many bytes to the flush score of the tablet, since flush allows to GC the WAL.");
+TAG_FLAG(global_memstore_flush_wal_segment_weight_bytes, advanced);
+TAG_FLAG(global_memstore_flush_wal_segment_weight_bytes, runtime);
+
+DEFINE_double(global_memstore_flush_intents_weight, 1.0,
+              "Cost based flush: size of the intents memtable is multiplied by this value and "
+              "added to the flush score of the tablet, in addition to the memtable size.");
+TAG_FLAG(global_memstore_flush_intents_weight, advanced);
+TAG_FLAG(global_memstore_flush_intents_weight, runtime);
+
+DEFINE_uint64(global_memstore_min_flush_batch_bytes, 0,
+              "When the tablet picked for flush has less than this many bytes in memtables, "
+              "the following tablets in flush order are flushed together with it, until this many "
+              "bytes are going to be flushed. 0 disables batching of flushes.");
+TAG_FLAG(global_memstore_min_flush_batch_bytes, advanced);
+TAG_FLAG(global_memstore_min_flush_batch_bytes, runtime);
+
+METRIC_DEFINE_counter(server, global_memstore_flushes_age,
+                      "Global Memstore Flushes By Age", yb::MetricUnit::kOperations,
+                      "Number of flushes started on global memstore limit because the tablet had "
+                      "the oldest memtable.");
+METRIC_DEFINE_counter(server, global_memstore_flushes_size,
+                      "Global Memstore Flushes By Size", yb::MetricUnit::kOperations,
+                      "Number of flushes started on global memstore limit because of the memtable "
+                      "size.");
+METRIC_DEFINE_counter(server, global_memstore_flushes_wal_retention,
+                      "Global Memstore Flushes By WAL Retention", yb::MetricUnit::kOperations,
+                      "Number of flushes started on global memstore limit because of the WAL "
+                      "retained by the memtable.");
+METRIC_DEFINE_counter(server, global_memstore_flushes_intents,
+                      "Global Memstore Flushes By Intents", yb::MetricUnit::kOperations,
+                      "Number of flushes started on global memstore limit because of the size of "
+                      "pending intents.");
+METRIC_DEFINE_counter(server, global_memstore_flushes_batched,
+                      "Global Memstore Batched Flushes", yb::MetricUnit::kOperations,
+                      "Number of flushes started on global memstore limit together with another "
+                      "flush, to avoid a burst of small flushes.");
+
+METRIC_DEFINE_counter(server, block_cache_gc_evicted_bytes,
+                      "Block Cache GC Evicted Bytes", yb::MetricUnit::kBytes,
+                      "Number of bytes evicted from the block cache by the garbage collector, to "
+                      "bring memory consumption under the limit.");
+METRIC_DEFINE_counter(server, log_cache_gc_evicted_bytes,
+                      "Log Cache GC Evicted Bytes", yb::MetricUnit::kBytes,
+                      "Number of bytes evicted from the log cache by the garbage collector, to "
+                      "bring memory consumption under the limit.");
+
 DEFINE_test_flag(bool, pretend_memory_exceeded_enforce_flush, false,
                   "Always pretend memory has been exceeded to enforce background flush.");
 
@@ -102,14 +203,18 @@ class FunctorGC : public GarbageCollector {
 
 class LRUCacheGC : public GarbageCollector {
  public:
-  explicit LRUCacheGC(std::shared_ptr<rocksdb::Cache> cache) : cache_(std::move(cache)) {}
+  LRUCacheGC(std::shared_ptr<rocksdb::Cache> cache, scoped_refptr<Counter> evicted_bytes)
+      : cache_(std::move(cache)), evicted_bytes_(std::move(evicted_bytes)) {}
 
   void CollectGarbage(size_t required) {
-    if (!FLAGS_enable_block_based_table_cache_gc) {
+    if (!GetAtomicFlag(&FLAGS_enable_block_based_table_cache_gc)) {
       return;
     }
 
     auto evicted = cache_->Evict(required);
+    if (evicted_bytes_) {
+      evicted_bytes_->IncrementBy(evicted);
+    }
     LOG(INFO) << "Evicted from table cache: " << HumanReadableNumBytes::ToString(evicted)
               << ", new usage: " << HumanReadableNumBytes::ToString(cache_->GetUsage())
               << ", required: " << HumanReadableNumBytes::ToString(required);
@@ -119,6 +224,7 @@ class LRUCacheGC : public GarbageCollector {
 
  private:
   std::shared_ptr<rocksdb::Cache> cache_;
+  scoped_refptr<Counter> evicted_bytes_;
 };
 
 // Evaluates the target block cache size based on the db_block_cache_size_percentage and
@@ -162,11 +268,25 @@ TabletMemoryManager::TabletMemoryManager(
   peers_fn_ = peers_fn;
 
   InitBlockCache(metrics, default_block_cache_size_percentage, options);
-  InitLogCacheGC();
+  InitLogCacheGC(metrics);
   // Assign background_task_ if necessary.
   ConfigureBackgroundTask(options);
+
+  // We may not have a metric entity in tests.
+  if (metrics) {
+    auto set_counter = [this, &metrics](MemstoreFlushReason reason, CounterPrototype* prototype) {
+      flush_reason_counters_[to_underlying(reason)] = prototype->Instantiate(metrics);
+    };
+    set_counter(MemstoreFlushReason::kAge, &METRIC_global_memstore_flushes_age);
+    set_counter(MemstoreFlushReason::kSize, &METRIC_global_memstore_flushes_size);
+    set_counter(MemstoreFlushReason::kWalRetention, &METRIC_global_memstore_flushes_wal_retention);
+    set_counter(MemstoreFlushReason::kIntents, &METRIC_global_memstore_flushes_intents);
+    set_counter(MemstoreFlushReason::kBatched, &METRIC_global_memstore_flushes_batched);
+  }
 }
 
+TabletMemoryManager::~TabletMemoryManager() = default;
+
 CHECKED_STATUS TabletMemoryManager::Init() {
   if (background_task_) {
     RETURN_NOT_OK(background_task_->Init());
@@ -196,15 +316,52 @@ void TabletMemoryManager::InitBlockCache(
       server_mem_tracker_);
 
   if (block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
+    // We may not have a metric entity in tests.
+    scoped_refptr<Counter> gc_evicted_bytes;
+    if (metrics) {
+      gc_evicted_bytes = METRIC_block_cache_gc_evicted_bytes.Instantiate(metrics);
+    }
+    const auto admission_policy = FLAGS_db_block_cache_frequency_admission
+        ? rocksdb::CacheAdmissionPolicy::kFrequency : rocksdb::CacheAdmissionPolicy::kAlways;
+    if (FLAGS_db_block_cache_index_filter_percentage > 0 &&
+        FLAGS_db_block_cache_index_filter_percentage < 100) {
+      const int64_t index_and_filter_block_cache_size_bytes =
+          block_cache_size_bytes * FLAGS_db_block_cache_index_filter_percentage / 100;
+      block_cache_size_bytes -= index_and_filter_block_cache_size_bytes;
+      options->index_and_filter_block_cache = rocksdb::NewLRUCache(
+          index_and_filter_block_cache_size_bytes, FLAGS_db_block_cache_num_shard_bits,
+          false /* strict_capacity_limit */, admission_policy);
+      options->index_and_filter_block_cache->SetMetrics(metrics);
+      index_and_filter_block_cache_gc_ = std::make_shared<LRUCacheGC>(
+          options->index_and_filter_block_cache, gc_evicted_bytes);
+      block_based_table_mem_tracker_->AddGarbageCollector(index_and_filter_block_cache_gc_);
+    }
     options->block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                FLAGS_db_block_cache_num_shard_bits);
+                                                FLAGS_db_block_cache_num_shard_bits,
+                                                false /* strict_capacity_limit */,
+                                                admission_policy);
     options->block_cache->SetMetrics(metrics);
-    block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache);
+    block_based_table_gc_ = std::make_shared<LRUCacheGC>(options->block_cache, gc_evicted_bytes);
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
   }
+
+  if (!FLAGS_db_persistent_block_cache_path.empty()) {
+    auto status = rocksdb::NewFilePersistentCache(
+        options->rocksdb_env, FLAGS_db_persistent_block_cache_path,
+        FLAGS_db_persistent_block_cache_size_bytes,
+        FLAGS_db_persistent_block_cache_file_size_bytes, &options->persistent_cache);
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to open persistent block cache at "
+                   << FLAGS_db_persistent_block_cache_path << ", running without it: " << status;
+      options->persistent_cache = nullptr;
+    }
+  }
 }
 
-void TabletMemoryManager::InitLogCacheGC() {
+void TabletMemoryManager::InitLogCacheGC(const scoped_refptr<MetricEntity>& metrics) {
+  if (metrics) {
+    log_cache_gc_evicted_bytes_ = METRIC_log_cache_gc_evicted_bytes.Instantiate(metrics);
+  }
   auto log_cache_mem_tracker = consensus::LogCache::GetServerMemTracker(server_mem_tracker_);
   log_cache_gc_ = std::make_shared<FunctorGC>(
       std::bind(&TabletMemoryManager::LogCacheGC, this, log_cache_mem_tracker.get(), _1));
@@ -276,7 +433,9 @@ void TabletMemoryManager::LogCacheGC(MemTracker* log_cache_mem_tracker, size_t b
       break;
     }
   }
-
+  if (log_cache_gc_evicted_bytes_) {
+    log_cache_gc_evicted_bytes_->IncrementBy(total_evicted);
+  }
 
   LOG(INFO) << "Evicted from log cache: " << HumanReadableNumBytes::ToString(total_evicted)
             << ", required: " << HumanReadableNumBytes::ToString(bytes_to_evict);
@@ -289,51 +448,103 @@ void TabletMemoryManager::FlushTabletIfLimitExceeded() {
     YB_LOG_EVERY_N_SECS(INFO, 5) << Format("Memstore global limit of $0 bytes reached, looking for "
                                            "tablet to flush", memory_monitor_->limit());
     auto flush_tick = rocksdb::FlushTick();
-    tablet::TabletPeerPtr peer_to_flush = TabletToFlush();
-    if (peer_to_flush) {
-      auto tablet_to_flush = peer_to_flush->shared_tablet();
-      // TODO(bojanserafimov): If peer_to_flush flushes now because of other reasons,
-      // we will schedule a second flush, which will unnecessarily stall writes for a short time.
-      // This will not happen often, but should be fixed.
-      if (tablet_to_flush) {
-        LOG(INFO)
-            << LogPrefix(peer_to_flush)
-            << "Flushing tablet with oldest memstore write at "
-            << tablet_to_flush->OldestMutableMemtableWriteHybridTime();
-        WARN_NOT_OK(
-            tablet_to_flush->Flush(
-                tablet::FlushMode::kAsync, tablet::FlushFlags::kAllDbs, flush_tick),
-            Substitute("Flush failed on $0", peer_to_flush->tablet_id()));
-        for (auto listener : TEST_listeners) {
-          listener->StartedFlush(peer_to_flush->tablet_id());
-        }
+    // TODO(bojanserafimov): If a tablet to flush flushes now because of other reasons,
+    // we will schedule a second flush, which will unnecessarily stall writes for a short time.
+    // This will not happen often, but should be fixed.
+    for (const auto& candidate : TabletsToFlush()) {
+      const auto& peer_to_flush = candidate.peer;
+      LOG(INFO)
+          << LogPrefix(peer_to_flush)
+          << "Flushing tablet, reason: " << candidate.reason
+          << ", memtable size: " << candidate.memtable_bytes
+          << ", oldest memstore write at " << candidate.oldest_write_hybrid_time;
+      WARN_NOT_OK(
+          candidate.tablet->Flush(
+              tablet::FlushMode::kAsync, tablet::FlushFlags::kAllDbs, flush_tick),
+          Substitute("Flush failed on $0", peer_to_flush->tablet_id()));
+      const auto& counter = flush_reason_counters_[to_underlying(candidate.reason)];
+      if (counter) {
+        counter->Increment();
+      }
+      for (auto listener : TEST_listeners) {
+        listener->StartedFlush(peer_to_flush->tablet_id());
       }
     }
   }
 }
 
-// Return the tablet with the oldest write in memstore, or nullptr if all tablet memstores are
-// empty or about to flush.
-tablet::TabletPeerPtr TabletMemoryManager::TabletToFlush() {
-  HybridTime oldest_write_in_memstores = HybridTime::kMax;
-  tablet::TabletPeerPtr tablet_to_flush;
+std::vector<TabletMemoryManager::FlushCandidate> TabletMemoryManager::TabletsToFlush() {
+  const bool cost_based = FLAGS_enable_global_memstore_cost_based_flush;
+  std::vector<FlushCandidate> candidates;
   for (const tablet::TabletPeerPtr& peer : peers_fn_()) {
-    const auto tablet = peer->shared_tablet();
-    if (tablet) {
-      const auto ht = tablet->OldestMutableMemtableWriteHybridTime();
-      if (ht.ok()) {
-        if (*ht < oldest_write_in_memstores) {
-          oldest_write_in_memstores = *ht;
-          tablet_to_flush = peer;
-        }
-      } else {
-        YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
-            "Failed to get oldest mutable memtable write ht for tablet $0: $1",
-            tablet->tablet_id(), ht.status());
+    auto tablet = peer->shared_tablet();
+    if (!tablet) {
+      continue;
+    }
+    const auto ht = tablet->OldestMutableMemtableWriteHybridTime();
+    if (!ht.ok()) {
+      YB_LOG_EVERY_N_SECS(WARNING, 5) << Format(
+          "Failed to get oldest mutable memtable write ht for tablet $0: $1",
+          tablet->tablet_id(), ht.status());
+      continue;
+    }
+    // Memtables are empty or about to flush.
+    if (*ht == HybridTime::kMax) {
+      continue;
+    }
+
+    FlushCandidate candidate;
+    candidate.peer = peer;
+    candidate.oldest_write_hybrid_time = *ht;
+    uint64_t intents_bytes, regular_bytes;
+    std::tie(intents_bytes, regular_bytes) = tablet->GetMutableMemtablesSize();
+    candidate.memtable_bytes = intents_bytes + regular_bytes;
+
+    const double age_sec = std::max<int64_t>(tablet->clock()->Now().PhysicalDiff(*ht), 0) / 1e6;
+    if (!cost_based) {
+      candidate.score = age_sec;
+    } else {
+      const size_t wal_segments = peer->log_available() ? peer->log()->num_segments() : 0;
+      std::array<double, kMemstoreFlushReasonMapSize> terms = {};
+      terms[to_underlying(MemstoreFlushReason::kSize)] = candidate.memtable_bytes;
+      terms[to_underlying(MemstoreFlushReason::kAge)] =
+          age_sec * FLAGS_global_memstore_flush_age_weight_bytes_per_sec;
+      terms[to_underlying(MemstoreFlushReason::kWalRetention)] =
+          (wal_segments > 1 ? wal_segments - 1 : 0) *
+          FLAGS_global_memstore_flush_wal_segment_weight_bytes;
+      terms[to_underlying(MemstoreFlushReason::kIntents)] =
+          intents_bytes * FLAGS_global_memstore_flush_intents_weight;
+      auto max_term = std::max_element(terms.begin(), terms.end());
+      candidate.reason = static_cast<MemstoreFlushReason>(max_term - terms.begin());
+      for (auto term : terms) {
+        candidate.score += term;
       }
     }
+    candidate.tablet = std::move(tablet);
+    candidates.push_back(std::move(candidate));
+  }
+
+  if (candidates.empty()) {
+    return candidates;
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.score > rhs.score;
+  });
+
+  // Batch small flushes by adding the following tablets, until there is enough data to flush.
+  uint64_t bytes_to_flush = 0;
+  size_t num_to_flush = 0;
+  while (num_to_flush < candidates.size() &&
+         (num_to_flush == 0 || bytes_to_flush < FLAGS_global_memstore_min_flush_batch_bytes)) {
+    if (num_to_flush != 0) {
+      candidates[num_to_flush].reason = MemstoreFlushReason::kBatched;
+    }
+    bytes_to_flush += candidates[num_to_flush].memtable_bytes;
+    ++num_to_flush;
   }
-  return tablet_to_flush;
+  candidates.resize(num_to_flush);
+  return candidates;
 }
 
 std::string TabletMemoryManager::LogPrefix(const tablet::TabletPeerPtr& peer) const {
@@ -14,18 +14,28 @@
 #ifndef YB_TSERVER_TABLET_MEMORY_MANAGER_H_
 #define YB_TSERVER_TABLET_MEMORY_MANAGER_H_
 
+#include <array>
 #include <memory>
 
 #include <boost/optional.hpp>
 
+#include "yb/common/hybrid_time.h"
+
+#include "yb/tablet/tablet_fwd.h"
 #include "yb/tablet/tablet_options.h"
 
 #include "yb/util/background_task.h"
+#include "yb/util/enums.h"
 #include "yb/util/mem_tracker.h"
+#include "yb/util/metrics_fwd.h"
 
 namespace yb {
 namespace tserver {
 
+// Reason why a tablet was picked for flush when the global memstore limit is reached.
+// kBatched is used for tablets flushed together with the picked one, so small flushes are batched.
+YB_DEFINE_ENUM(MemstoreFlushReason, (kAge)(kSize)(kWalRetention)(kIntents)(kBatched));
+
 class TabletMemoryManagerListenerIf {
  public:
   virtual ~TabletMemoryManagerListenerIf() {}
@@ -50,7 +60,7 @@ class TabletMemoryManager {
       const scoped_refptr<MetricEntity>& metrics,
       const std::function<std::vector<tablet::TabletPeerPtr>()>& peers_fn);
 
-  ~TabletMemoryManager() = default;
+  ~TabletMemoryManager();
 
   // Init and Shutdown start/stop the background memstore management task.
   CHECKED_STATUS Init();
@@ -74,7 +84,7 @@ class TabletMemoryManager {
       tablet::TabletOptions* options);
 
   // Initializes the log cache garbage collector.
-  void InitLogCacheGC();
+  void InitLogCacheGC(const scoped_refptr<MetricEntity>& metrics);
 
   // Initializes the background thread that periodically wakes up to flush memory over the
   // shared memstore limit.
@@ -83,9 +93,25 @@ class TabletMemoryManager {
   // Log cache garbage collection function bound to the memory tracker.
   void LogCacheGC(MemTracker* log_cache_mem_tracker, size_t bytes_to_evict);
 
-  // Determines which tablet has the oldest mutable memtable write time.  May return a null ptr
-  // if no tablet meets the criteria.  Uses peers_fn_ to determine the full list of peers to check.
-  tablet::TabletPeerPtr TabletToFlush();
+  struct FlushCandidate {
+    tablet::TabletPeerPtr peer;
+    tablet::TabletPtr tablet;
+    HybridTime oldest_write_hybrid_time;
+    uint64_t memtable_bytes = 0;
+    double score = 0;
+    MemstoreFlushReason reason = MemstoreFlushReason::kAge;
+  };
+
+  // Determines which tablets should be flushed to free memstore memory. The result is empty if
+  // all tablet memstores are empty or about to flush. Uses peers_fn_ to determine the full list
+  // of peers to check.
+  //
+  // By default the tablet with the oldest mutable memtable write time is picked. When cost based
+  // flush is enabled, tablets are ranked by the size and age of their memtables, the number of
+  // WAL segments retained by them and the size of pending intents.
+  // Tablets following the picked one in the ranking are added until at least
+  // global_memstore_min_flush_batch_bytes are going to be flushed.
+  std::vector<FlushCandidate> TabletsToFlush();
 
   // Function to return a log prefix with the tablet's tablet_id and permanent_uuid.
   std::string LogPrefix(const tablet::TabletPeerPtr& peer) const;
@@ -99,11 +125,19 @@ class TabletMemoryManager {
 
   std::shared_ptr<GarbageCollector> block_based_table_gc_;
 
+  std::shared_ptr<GarbageCollector> index_and_filter_block_cache_gc_;
+
   std::shared_ptr<GarbageCollector> log_cache_gc_;
 
+  // Number of bytes evicted from log cache by log_cache_gc_.
+  scoped_refptr<Counter> log_cache_gc_evicted_bytes_;
+
   std::unique_ptr<BackgroundTask> background_task_;
 
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor_;
+
+  // Number of flushes started because of the global memstore limit, by reason.
+  std::array<scoped_refptr<Counter>, kMemstoreFlushReasonMapSize> flush_reason_counters_;
 };
 
 }  // namespace tserver
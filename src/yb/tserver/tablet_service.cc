@@ -106,6 +106,7 @@
 #include "yb/util/status_format.h"
 #include "yb/util/status_log.h"
 #include "yb/util/string_util.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
 
 #include "yb/yql/pgwrapper/ysql_upgrade.h"
@@ -445,9 +446,10 @@ class ScanResultChecksummer {
 
 Result<std::shared_ptr<tablet::AbstractTablet>> TabletServiceImpl::GetTabletForRead(
   const TabletId& tablet_id, tablet::TabletPeerPtr tablet_peer,
-  YBConsistencyLevel consistency_level, tserver::AllowSplitTablet allow_split_tablet) {
+  YBConsistencyLevel consistency_level, tserver::AllowSplitTablet allow_split_tablet,
+  uint64_t max_staleness_ms) {
   return GetTablet(server_->tablet_peer_lookup(), tablet_id, std::move(tablet_peer),
-                   consistency_level, allow_split_tablet);
+                   consistency_level, allow_split_tablet, max_staleness_ms);
 }
 
 TabletServiceImpl::TabletServiceImpl(TabletServerIf* server)
@@ -1673,9 +1675,11 @@ ConsensusServiceImpl::ConsensusServiceImpl(const scoped_refptr<MetricEntity>& me
                                            TabletPeerLookupIf* tablet_manager)
     : ConsensusServiceIf(metric_entity),
       tablet_manager_(tablet_manager) {
+  CHECK_OK(ThreadPoolBuilder("multi-raft-update").Build(&multi_raft_update_pool_));
 }
 
 ConsensusServiceImpl::~ConsensusServiceImpl() {
+  multi_raft_update_pool_->Shutdown();
 }
 
 void ConsensusServiceImpl::CompleteUpdateConsensusResponse(
@@ -1692,53 +1696,83 @@ void ConsensusServiceImpl::MultiRaftUpdateConsensus(
       const consensus::MultiRaftConsensusRequestPB *req,
       consensus::MultiRaftConsensusResponsePB *resp,
       rpc::RpcContext context) {
-    DVLOG(3) << "Received Batch Consensus Update RPC: " << req->ShortDebugString();
-    // Effectively performs ConsensusServiceImpl::UpdateConsensus for
-    // each ConsensusRequestPB in the batch but does not fail the entire
-    // batch if a single request fails.
-    for (int i = 0; i < req->consensus_request_size(); i++) {
-      // Unfortunately, we have to use const_cast here,
-      // because the protobuf-generated interface only gives us a const request
-      // but we need to be able to move messages out of the request for efficiency.
-      auto consensus_req = const_cast<ConsensusRequestPB*>(&req->consensus_request(i));
-      auto consensus_resp = resp->add_consensus_response();;
-
-      auto uuid_match_res = CheckUuidMatch(tablet_manager_, "UpdateConsensus", consensus_req,
-                                           context.requestor_string());
-      if (!uuid_match_res.ok()) {
-        SetupError(consensus_resp->mutable_error(), uuid_match_res.status());
-        continue;
-      }
-
-      auto peer_tablet_res = LookupTabletPeer(tablet_manager_, consensus_req->tablet_id());
-      if (!peer_tablet_res.ok()) {
-        SetupError(consensus_resp->mutable_error(), peer_tablet_res.status());
-        continue;
-      }
-      auto tablet_peer = peer_tablet_res.get().tablet_peer;
+  DVLOG(3) << "Received Batch Consensus Update RPC: " << req->ShortDebugString();
+  // Effectively performs ConsensusServiceImpl::UpdateConsensus for each ConsensusRequestPB in the
+  // batch but does not fail the entire batch if a single request fails.
+  // Updates of different tablets are independent, so they are executed concurrently, and the
+  // response is sent when the last of them completes.
+  const int num_requests = req->consensus_request_size();
+  if (num_requests == 0) {
+    context.RespondSuccess();
+    return;
+  }
+  // Responses are allocated upfront, so their addresses are stable while updates are running.
+  for (int i = 0; i != num_requests; ++i) {
+    resp->add_consensus_response();
+  }
 
-      // Submit the update directly to the TabletPeer's Consensus instance.
-      auto consensus_res = GetConsensus(tablet_peer);
-      if (!consensus_res.ok()) {
-        SetupError(consensus_resp->mutable_error(), consensus_res.status());
-        continue;
+  auto context_ptr = std::make_shared<rpc::RpcContext>(std::move(context));
+  auto pending_requests = std::make_shared<std::atomic<int>>(num_requests);
+  for (int i = 0; i != num_requests; ++i) {
+    // Unfortunately, we have to use const_cast here,
+    // because the protobuf-generated interface only gives us a const request
+    // but we need to be able to move messages out of the request for efficiency.
+    auto consensus_req = const_cast<ConsensusRequestPB*>(&req->consensus_request(i));
+    auto consensus_resp = resp->mutable_consensus_response(i);
+    auto task = [this, consensus_req, consensus_resp, context_ptr, pending_requests] {
+      UpdateConsensusInBatch(consensus_req, consensus_resp, *context_ptr);
+      if (pending_requests->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        context_ptr->RespondSuccess();
       }
-      auto consensus = *consensus_res;
-
-      Status s = consensus->Update(
-        consensus_req, consensus_resp, context.GetClientDeadline());
-      if (PREDICT_FALSE(!s.ok())) {
-        // Clear the response first, since a partially-filled response could
-        // result in confusing a caller, or in having missing required fields
-        // in embedded optional messages.
-        consensus_resp->Clear();
-        SetupError(consensus_resp->mutable_error(), s);
-        continue;
+    };
+    // The last update is executed in the RPC thread, which would otherwise just wait.
+    if (i + 1 == num_requests) {
+      task();
+    } else {
+      auto status = multi_raft_update_pool_->SubmitFunc(task);
+      if (!status.ok()) {
+        LOG(WARNING) << "Failed to submit batched consensus update: " << status;
+        task();
       }
-
-      CompleteUpdateConsensusResponse(tablet_peer, consensus_resp);
     }
-    context.RespondSuccess();
+  }
+}
+
+void ConsensusServiceImpl::UpdateConsensusInBatch(
+    ConsensusRequestPB* req, ConsensusResponsePB* resp, const rpc::RpcContext& context) {
+  auto uuid_match_res = CheckUuidMatch(tablet_manager_, "UpdateConsensus", req,
+                                       context.requestor_string());
+  if (!uuid_match_res.ok()) {
+    SetupError(resp->mutable_error(), uuid_match_res.status());
+    return;
+  }
+
+  auto peer_tablet_res = LookupTabletPeer(tablet_manager_, req->tablet_id());
+  if (!peer_tablet_res.ok()) {
+    SetupError(resp->mutable_error(), peer_tablet_res.status());
+    return;
+  }
+  auto tablet_peer = peer_tablet_res.get().tablet_peer;
+
+  // Submit the update directly to the TabletPeer's Consensus instance.
+  auto consensus_res = GetConsensus(tablet_peer);
+  if (!consensus_res.ok()) {
+    SetupError(resp->mutable_error(), consensus_res.status());
+    return;
+  }
+  auto consensus = *consensus_res;
+
+  Status s = consensus->Update(req, resp, context.GetClientDeadline());
+  if (PREDICT_FALSE(!s.ok())) {
+    // Clear the response first, since a partially-filled response could
+    // result in confusing a caller, or in having missing required fields
+    // in embedded optional messages.
+    resp->Clear();
+    SetupError(resp->mutable_error(), s);
+    return;
+  }
+
+  CompleteUpdateConsensusResponse(tablet_peer, resp);
 }
 
 void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
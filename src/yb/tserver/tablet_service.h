@@ -63,6 +63,7 @@ namespace yb {
 class Schema;
 class Status;
 class HybridTime;
+class ThreadPool;
 
 namespace tserver {
 
@@ -159,7 +160,8 @@ class TabletServiceImpl : public TabletServerServiceIf, public ReadTabletProvide
  private:
   Result<std::shared_ptr<tablet::AbstractTablet>> GetTabletForRead(
     const TabletId& tablet_id, tablet::TabletPeerPtr tablet_peer,
-    YBConsistencyLevel consistency_level, tserver::AllowSplitTablet allow_split_tablet) override;
+    YBConsistencyLevel consistency_level, tserver::AllowSplitTablet allow_split_tablet,
+    uint64_t max_staleness_ms) override;
 
   template<class Resp>
   bool CheckWriteThrottlingOrRespond(
@@ -309,7 +311,16 @@ class ConsensusServiceImpl : public consensus::ConsensusServiceIf {
  private:
   void CompleteUpdateConsensusResponse(std::shared_ptr<tablet::TabletPeer> tablet_peer,
                                        consensus::ConsensusResponsePB* resp);
+
+  // Performs a single update of the MultiRaftUpdateConsensus batch, errors are stored in resp.
+  void UpdateConsensusInBatch(consensus::ConsensusRequestPB* req,
+                              consensus::ConsensusResponsePB* resp,
+                              const rpc::RpcContext& context);
+
   TabletPeerLookupIf* tablet_manager_;
+
+  // Runs updates of a MultiRaftUpdateConsensus batch concurrently.
+  std::unique_ptr<ThreadPool> multi_raft_update_pool_;
 };
 
 class TabletServerForwardServiceImpl : public TabletServerForwardServiceIf {
@@ -72,11 +72,14 @@
 #include "yb/master/master_heartbeat.pb.h"
 #include "yb/master/sys_catalog.h"
 
+#include "yb/rocksdb/rate_limiter.h"
+
 #include "yb/rpc/messenger.h"
 #include "yb/rpc/poller.h"
 
 #include "yb/tablet/metadata.pb.h"
 #include "yb/tablet/operations/split_operation.h"
+#include "yb/tablet/shared_transaction_status_cache.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet.pb.h"
 #include "yb/tablet/tablet_bootstrap_if.h"
@@ -90,6 +93,7 @@
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tserver.pb.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/debug/long_operation_tracker.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/env.h"
@@ -113,7 +117,7 @@ using namespace std::placeholders;
 DEFINE_int32(num_tablets_to_open_simultaneously, 0,
              "Number of threads available to open tablets during startup. If this "
              "is set to 0 (the default), then the number of bootstrap threads will "
-             "be set based on the number of data directories. If the data directories "
+             "be set based on the number of CPUs, data and WAL directories. If the directories "
              "are on some very fast storage device such as SSD or a RAID array, it "
              "may make sense to manually tune this.");
 TAG_FLAG(num_tablets_to_open_simultaneously, advanced);
@@ -188,6 +192,12 @@ DEFINE_int32(cleanup_metrics_interval_sec, 60,
              "The tick interval time for the metrics cleanup background task. "
              "If set to 0, it disables the background task.");
 
+DEFINE_int32(update_rate_limiter_interval_sec, 10,
+             "Interval at which tablet manager applies changes of "
+             "rocksdb_compact_flush_rate_limit_bytes_per_sec to the rate limiter shared across "
+             "the tablet server. If set to 0, the limit is not changed after startup.");
+TAG_FLAG(update_rate_limiter_interval_sec, advanced);
+
 DEFINE_bool(skip_tablet_data_verification, false,
             "Skip checking tablet data for corruption.");
 
@@ -222,6 +232,17 @@ DEFINE_int32(tserver_yb_client_default_timeout_ms, kTServerYbClientDefaultTimeou
 DEFINE_bool(enable_restart_transaction_status_tablets_first, true,
             "Set to true to prioritize bootstrapping transaction status tablets first.");
 
+DEFINE_int32(shared_transaction_status_cache_size, 65536,
+             "Max number of committed transactions, whose commit data is cached for all tablets "
+             "of the tablet server, so transaction status is requested from the coordinator once "
+             "per tablet server. 0 to disable the cache.");
+TAG_FLAG(shared_transaction_status_cache_size, advanced);
+
+DEFINE_int32(shared_transaction_status_cache_ttl_ms, 60000,
+             "Time to keep commit data of transaction in the shared transaction status cache.");
+TAG_FLAG(shared_transaction_status_cache_ttl_ms, advanced);
+
+DECLARE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec);
 DECLARE_string(rocksdb_compact_flush_rate_limit_sharing_mode);
 
 namespace yb {
@@ -267,6 +288,11 @@ METRIC_DEFINE_coarse_histogram(server, ts_bootstrap_time, "TServer Bootstrap Tim
                         MetricUnit::kMicroseconds,
                         "Time that the tablet server takes to bootstrap all of its tablets.");
 
+METRIC_DEFINE_gauge_uint64(server, ts_tablet_metadata_load_time,
+                           "TServer Tablet Metadata Load Time", MetricUnit::kMilliseconds,
+                           "Time that the tablet server took to load metadata of all of its "
+                           "tablets at startup.");
+
 THREAD_POOL_METRICS_DEFINE(
     server, post_split_trigger_compaction_pool, "Thread pool for tablet compaction jobs.");
 
@@ -330,6 +356,18 @@ void TSTabletManager::CleanupOldMetrics() {
   metric_registry_->RetireOldMetrics();
 }
 
+void TSTabletManager::UpdateRateLimiter() {
+  auto bytes_per_sec = GetAtomicFlag(&FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec);
+  // Rate limiter could not be disabled after it was created, so non positive values are ignored.
+  if (bytes_per_sec <= 0 || bytes_per_sec == rate_limit_bytes_per_sec_) {
+    return;
+  }
+  LOG_WITH_PREFIX(INFO) << "Changing flush and compaction rate limit from "
+                        << rate_limit_bytes_per_sec_ << " to " << bytes_per_sec << " bytes/sec";
+  tablet_options_.rate_limiter->SetBytesPerSecond(bytes_per_sec);
+  rate_limit_bytes_per_sec_ = bytes_per_sec;
+}
+
 TSTabletManager::TSTabletManager(FsManager* fs_manager,
                                  TabletServer* server,
                                  MetricRegistry* metric_registry)
@@ -425,6 +463,13 @@ Status TSTabletManager::Init() {
   tablet_options_.listeners = server_->options().listeners;
   if (docdb::GetRocksDBRateLimiterSharingMode() == docdb::RateLimiterSharingMode::TSERVER) {
     tablet_options_.rate_limiter = docdb::CreateRocksDBRateLimiter();
+    rate_limit_bytes_per_sec_ = FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec;
+  }
+  if (FLAGS_shared_transaction_status_cache_size > 0) {
+    tablet_options_.transaction_status_cache =
+        std::make_shared<tablet::SharedTransactionStatusCache>(
+            FLAGS_shared_transaction_status_cache_size,
+            MonoDelta::FromMilliseconds(FLAGS_shared_transaction_status_cache_ttl_ms));
   }
 
   // Start the threadpool we'll use to open tablets.
@@ -436,8 +481,10 @@ Status TSTabletManager::Init() {
     if (num_cpus <= 2) {
       max_bootstrap_threads = 2;
     } else {
-      max_bootstrap_threads = min(
-          num_cpus - 1, narrow_cast<int>(fs_manager_->GetDataRootDirs().size()) * 8);
+      // Bootstrap mostly reads WALs, so take WAL directories into account as well.
+      auto num_dirs = std::max(
+          fs_manager_->GetDataRootDirs().size(), fs_manager_->GetWalRootDirs().size());
+      max_bootstrap_threads = min(num_cpus - 1, narrow_cast<int>(num_dirs) * 8);
     }
     LOG_WITH_PREFIX(INFO) <<  "max_bootstrap_threads=" << max_bootstrap_threads;
   }
@@ -468,18 +515,40 @@ Status TSTabletManager::Init() {
   // First, load all of the tablet metadata. We do this before we start
   // submitting the actual OpenTablet() tasks so that we don't have to compete
   // for disk resources, etc, with bootstrap processes and running tablets.
+  // Metadata files are read and parsed in parallel in the bootstrap pool, while results are
+  // handled in the original order.
   MonoTime start(MonoTime::Now());
-  for (const string& tablet_id : tablet_ids) {
-    RaftGroupMetadataPtr meta;
-    RETURN_NOT_OK_PREPEND(OpenTabletMeta(tablet_id, &meta),
+  std::vector<RaftGroupMetadataPtr> loaded_metas(tablet_ids.size());
+  std::vector<Status> load_statuses(tablet_ids.size());
+  {
+    CountDownLatch latch(tablet_ids.size());
+    auto token = open_tablet_pool_->NewToken(ThreadPool::ExecutionMode::CONCURRENT);
+    for (size_t i = 0; i != tablet_ids.size(); ++i) {
+      auto status = token->SubmitFunc([this, &tablet_ids, &loaded_metas, &load_statuses, &latch,
+                                       i]() {
+        load_statuses[i] = OpenTabletMeta(tablet_ids[i], &loaded_metas[i]);
+        latch.CountDown();
+      });
+      if (!status.ok()) {
+        load_statuses[i] = status;
+        latch.CountDown();
+      }
+    }
+    latch.Wait();
+  }
+
+  for (size_t i = 0; i != tablet_ids.size(); ++i) {
+    const auto& tablet_id = tablet_ids[i];
+    RETURN_NOT_OK_PREPEND(load_statuses[i],
                           "Failed to open tablet metadata for tablet: " + tablet_id);
+    const auto& meta = loaded_metas[i];
     if (PREDICT_FALSE(!CanServeTabletData(meta->tablet_data_state()))) {
       RETURN_NOT_OK(HandleNonReadyTabletOnStartup(meta));
       continue;
     }
     RegisterDataAndWalDir(
         fs_manager_, meta->table_id(), meta->raft_group_id(), meta->data_root_dir(),
-        meta->wal_root_dir());
+        meta->wal_root_dir(), meta->cold_data_root_dir());
     if (FLAGS_enable_restart_transaction_status_tablets_first) {
       // Prioritize bootstrapping transaction status tablets first.
       if (meta->table_type() == TRANSACTION_STATUS_TABLE_TYPE) {
@@ -495,6 +564,8 @@ Status TSTabletManager::Init() {
   MonoDelta elapsed = MonoTime::Now().GetDeltaSince(start);
   LOG(INFO) << "Loaded metadata for " << tablet_ids.size() << " tablet in "
             << elapsed.ToMilliseconds() << " ms";
+  tablet_metadata_load_time_ = METRIC_ts_tablet_metadata_load_time.Instantiate(
+      server_->metric_entity(), elapsed.ToMilliseconds());
 
   // Now submit the "Open" task for each.
   for (const RaftGroupMetadataPtr& meta : metas) {
@@ -523,6 +594,9 @@ Status TSTabletManager::Init() {
   metrics_cleaner_ = std::make_unique<rpc::Poller>(
       LogPrefix(), std::bind(&TSTabletManager::CleanupOldMetrics, this));
 
+  rate_limiter_updater_ = std::make_unique<rpc::Poller>(
+      LogPrefix(), std::bind(&TSTabletManager::UpdateRateLimiter, this));
+
   return Status::OK();
 }
 
@@ -582,6 +656,10 @@ Status TSTabletManager::Start() {
     LOG(INFO)
         << "Old metrics cleanup is disabled by cleanup_metrics_interval_sec flag set to 0";
   }
+  if (tablet_options_.rate_limiter && FLAGS_update_rate_limiter_interval_sec > 0) {
+    rate_limiter_updater_->Start(
+        &server_->messenger()->scheduler(), FLAGS_update_rate_limiter_interval_sec * 1s);
+  }
 
   return Status::OK();
 }
@@ -668,8 +746,10 @@ Result<TabletPeerPtr> TSTabletManager::CreateNewTablet(
   TRACE("Creating new metadata...");
   string data_root_dir;
   string wal_root_dir;
+  string cold_data_root_dir;
   GetAndRegisterDataAndWalDir(
-      fs_manager_, table_info->table_id, tablet_id, &data_root_dir, &wal_root_dir);
+      fs_manager_, table_info->table_id, tablet_id, &data_root_dir, &wal_root_dir,
+      &cold_data_root_dir);
   auto create_result = RaftGroupMetadata::CreateNew(tablet::RaftGroupMetadataData {
     .fs_manager = fs_manager_,
     .table_info = table_info,
@@ -678,9 +758,10 @@ Result<TabletPeerPtr> TSTabletManager::CreateNewTablet(
     .tablet_data_state = TABLET_DATA_READY,
     .colocated = colocated,
     .snapshot_schedules = snapshot_schedules,
-  }, data_root_dir, wal_root_dir);
+  }, data_root_dir, wal_root_dir, cold_data_root_dir);
   if (!create_result.ok()) {
-    UnregisterDataWalDir(table_info->table_id, tablet_id, data_root_dir, wal_root_dir);
+    UnregisterDataWalDir(
+        table_info->table_id, tablet_id, data_root_dir, wal_root_dir, cold_data_root_dir);
   }
   RETURN_NOT_OK_PREPEND(create_result, "Couldn't create tablet metadata")
   RaftGroupMetadataPtr meta = std::move(*create_result);
@@ -862,6 +943,8 @@ Status TSTabletManager::ApplyTabletSplit(tablet::SplitOperation* operation, log:
       VERIFY_RESULT(GetAssignedRootDirForTablet(TabletDirType::kData, table_id, tablet_id));
   const auto wal_root_dir =
       VERIFY_RESULT(GetAssignedRootDirForTablet(TabletDirType::kWal, table_id, tablet_id));
+  // Subtablets use the cold data directory of the parent, see CreateSubtabletMetadata.
+  const auto cold_data_root_dir = meta.cold_data_root_dir();
 
   if (FLAGS_TEST_apply_tablet_split_inject_delay_ms > 0) {
     LOG(INFO) << "TEST: ApplyTabletSplit: injecting delay of "
@@ -876,14 +959,16 @@ Status TSTabletManager::ApplyTabletSplit(tablet::SplitOperation* operation, log:
   RETURN_NOT_OK(StartSubtabletsSplit(meta, &tcmetas));
 
   for (const auto& tcmeta : tcmetas) {
-    RegisterDataAndWalDir(fs_manager_, table_id, tcmeta.tablet_id, data_root_dir, wal_root_dir);
+    RegisterDataAndWalDir(
+        fs_manager_, table_id, tcmeta.tablet_id, data_root_dir, wal_root_dir, cold_data_root_dir);
   }
 
   bool successfully_completed = false;
   auto se = ScopeExit([&] {
     if (!successfully_completed) {
       for (const auto& tcmeta : tcmetas) {
-        UnregisterDataWalDir(table_id, tcmeta.tablet_id, data_root_dir, wal_root_dir);
+        UnregisterDataWalDir(
+            table_id, tcmeta.tablet_id, data_root_dir, wal_root_dir, cold_data_root_dir);
       }
     }
   });
@@ -1288,7 +1373,8 @@ Status TSTabletManager::DeleteTablet(
   UnregisterDataWalDir(meta->table_id(),
                        tablet_id,
                        meta->data_root_dir(),
-                       meta->wal_root_dir());
+                       meta->wal_root_dir(),
+                       meta->cold_data_root_dir());
 
   return Status::OK();
 }
@@ -1398,6 +1484,7 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
       .tablet_splitter = this,
       .allowed_history_cutoff_provider = std::bind(
           &TSTabletManager::AllowedHistoryCutoff, this, _1),
+      .read_pool = read_pool_.get(),
     };
     tablet::BootstrapTabletData data = {
       .tablet_init_data = tablet_init_data,
@@ -1519,6 +1606,8 @@ void TSTabletManager::StartShutdown() {
 
   metrics_cleaner_->Shutdown();
 
+  rate_limiter_updater_->Shutdown();
+
   async_client_init_->Shutdown();
 
   mem_manager_->Shutdown();
@@ -2093,7 +2182,8 @@ void TSTabletManager::GetAndRegisterDataAndWalDir(FsManager* fs_manager,
                                                   const string& table_id,
                                                   const string& tablet_id,
                                                   string* data_root_dir,
-                                                  string* wal_root_dir) {
+                                                  string* wal_root_dir,
+                                                  string* cold_data_root_dir) {
   // Skip sys catalog table and kudu table from modifying the map.
   if (table_id == master::kSysCatalogTableId) {
     return;
@@ -2150,13 +2240,37 @@ void TSTabletManager::GetAndRegisterDataAndWalDir(FsManager* fs_manager,
   *wal_root_dir = min_dir;
   auto wal_assignment_value_iter = table_wal_assignment_map_[table_id].find(min_dir);
   wal_assignment_value_iter->second.insert(tablet_id);
+
+  if (cold_data_root_dir != nullptr) {
+    *cold_data_root_dir = GetAndRegisterRootDirUnlocked(
+        fs_manager->GetColdDataRootDirs(), table_id, tablet_id, &table_cold_data_assignment_map_);
+  }
+}
+
+std::string TSTabletManager::GetAndRegisterRootDirUnlocked(
+    const std::vector<std::string>& root_dirs, const TableId& table_id,
+    const TabletId& tablet_id, TableDiskAssignmentMap* table_assignment_map) {
+  if (root_dirs.empty()) {
+    return std::string();
+  }
+  auto& tablets_by_root_dir = (*table_assignment_map)[table_id];
+  for (const auto& root_dir : root_dirs) {
+    tablets_by_root_dir[root_dir];
+  }
+  auto min_it = std::min_element(
+      tablets_by_root_dir.begin(), tablets_by_root_dir.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second.size() < rhs.second.size();
+  });
+  min_it->second.insert(tablet_id);
+  return min_it->first;
 }
 
 void TSTabletManager::RegisterDataAndWalDir(FsManager* fs_manager,
                                             const string& table_id,
                                             const string& tablet_id,
                                             const string& data_root_dir,
-                                            const string& wal_root_dir) {
+                                            const string& wal_root_dir,
+                                            const string& cold_data_root_dir) {
   // Skip sys catalog table from modifying the map.
   if (table_id == master::kSysCatalogTableId) {
     return;
@@ -2207,6 +2321,10 @@ void TSTabletManager::RegisterDataAndWalDir(FsManager* fs_manager,
   } else {
     wal_assignment_value_iter->second.insert(tablet_id);
   }
+
+  if (!cold_data_root_dir.empty()) {
+    table_cold_data_assignment_map_[table_id][cold_data_root_dir].insert(tablet_id);
+  }
 }
 
 TSTabletManager::TableDiskAssignmentMap* TSTabletManager::GetTableDiskAssignmentMapUnlocked(
@@ -2216,6 +2334,8 @@ TSTabletManager::TableDiskAssignmentMap* TSTabletManager::GetTableDiskAssignment
       return &table_data_assignment_map_;
     case TabletDirType::kWal:
       return &table_wal_assignment_map_;
+    case TabletDirType::kColdData:
+      return &table_cold_data_assignment_map_;
   }
   FATAL_INVALID_ENUM_VALUE(TabletDirType, dir_type);
 }
@@ -2243,7 +2363,8 @@ Result<const std::string&> TSTabletManager::GetAssignedRootDirForTablet(
 void TSTabletManager::UnregisterDataWalDir(const string& table_id,
                                            const string& tablet_id,
                                            const string& data_root_dir,
-                                           const string& wal_root_dir) {
+                                           const string& wal_root_dir,
+                                           const string& cold_data_root_dir) {
   // Skip sys catalog table from modifying the map.
   if (table_id == master::kSysCatalogTableId) {
     return;
@@ -2288,6 +2409,15 @@ void TSTabletManager::UnregisterDataWalDir(const string& table_id,
                    << wal_root_dir << "for table " << table_id;
     }
   }
+  if (!cold_data_root_dir.empty()) {
+    auto table_cold_data_assignment_iter = table_cold_data_assignment_map_.find(table_id);
+    if (table_cold_data_assignment_iter != table_cold_data_assignment_map_.end()) {
+      auto it = table_cold_data_assignment_iter->second.find(cold_data_root_dir);
+      if (it != table_cold_data_assignment_iter->second.end()) {
+        it->second.erase(tablet_id);
+      }
+    }
+  }
 }
 
 client::YBClient& TSTabletManager::client() {
@@ -116,7 +116,7 @@ typedef boost::container::static_vector<TabletCreationMetaData, kNumSplitParts>
   } while (0)
 
 // Type of tablet directory.
-YB_DEFINE_ENUM(TabletDirType, (kData)(kWal));
+YB_DEFINE_ENUM(TabletDirType, (kData)(kWal)(kColdData));
 
 // Keeps track of the tablets hosted on the tablet server side.
 //
@@ -294,24 +294,29 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   // Creates and updates the map of table to the set of tablets assigned per table per disk
   // for both data and wal directories.
+  // If cold_data_root_dir is specified and there are cold data directories, it is also assigned
+  // one, otherwise it is set to empty string.
   void GetAndRegisterDataAndWalDir(FsManager* fs_manager,
                                    const std::string& table_id,
                                    const TabletId& tablet_id,
                                    std::string* data_root_dir,
-                                   std::string* wal_root_dir);
+                                   std::string* wal_root_dir,
+                                   std::string* cold_data_root_dir = nullptr);
   // Updates the map of table to the set of tablets assigned per table per disk
-  // for both of the given data and wal directories.
+  // for both of the given data and wal directories, and for the cold data directory if not empty.
   void RegisterDataAndWalDir(FsManager* fs_manager,
                             const std::string& table_id,
                             const TabletId& tablet_id,
                             const std::string& data_root_dir,
-                            const std::string& wal_root_dir);
+                            const std::string& wal_root_dir,
+                            const std::string& cold_data_root_dir = std::string());
   // Removes the tablet id assigned to the table and disk pair for both the data and WAL directory
-  // as pointed by the data and wal directory map.
+  // as pointed by the data and wal directory map, and for the cold data directory if not empty.
   void UnregisterDataWalDir(const std::string& table_id,
                             const TabletId& tablet_id,
                             const std::string& data_root_dir,
-                            const std::string& wal_root_dir);
+                            const std::string& wal_root_dir,
+                            const std::string& cold_data_root_dir = std::string());
 
   bool IsTabletInTransition(const TabletId& tablet_id) const;
 
@@ -329,6 +334,10 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Background task that Retires old metrics.
   void CleanupOldMetrics();
 
+  // Background task that applies runtime changes of the flush and compaction rate limit to the
+  // rate limiter shared across tablets.
+  void UpdateRateLimiter();
+
   client::YBClient& client();
 
   const std::shared_future<client::YBClient*>& client_future();
@@ -428,9 +437,16 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
       const scoped_refptr<tablet::RaftGroupMetadata>& meta,
       RegisterTabletPeerMode mode);
 
-  // Returns either table_data_assignment_map_ or table_wal_assignment_map_ depending on dir_type.
+  // Returns either table_data_assignment_map_, table_wal_assignment_map_ or
+  // table_cold_data_assignment_map_ depending on dir_type.
   TableDiskAssignmentMap* GetTableDiskAssignmentMapUnlocked(TabletDirType dir_type);
 
+  // Assigns the directory from root_dirs with the least count of tablets for the table to the
+  // tablet. Returns empty string if root_dirs is empty.
+  std::string GetAndRegisterRootDirUnlocked(
+      const std::vector<std::string>& root_dirs, const TableId& table_id,
+      const TabletId& tablet_id, TableDiskAssignmentMap* table_assignment_map);
+
   // Returns assigned root dir of specified type for specified table and tablet.
   // If root dir is not registered for the specified table_id and tablet_id combination - returns
   // error.
@@ -513,6 +529,7 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Map from table ID to count of children in data and wal directories.
   TableDiskAssignmentMap table_data_assignment_map_ GUARDED_BY(dir_assignment_mutex_);
   TableDiskAssignmentMap table_wal_assignment_map_ GUARDED_BY(dir_assignment_mutex_);
+  TableDiskAssignmentMap table_cold_data_assignment_map_ GUARDED_BY(dir_assignment_mutex_);
   mutable std::mutex dir_assignment_mutex_;
 
   // Map of tablet ids -> reason strings where the keys are tablets whose
@@ -579,6 +596,15 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Used for cleaning up old metrics.
   std::unique_ptr<rpc::Poller> metrics_cleaner_;
 
+  // Used for applying changes of the shared rate limiter settings.
+  std::unique_ptr<rpc::Poller> rate_limiter_updater_;
+
+  // Limit of the shared rate limiter, only accessed from rate_limiter_updater_ after startup.
+  int64_t rate_limit_bytes_per_sec_ = 0;
+
+  // Time spent loading tablet metadata at startup.
+  scoped_refptr<AtomicGauge<uint64_t>> tablet_metadata_load_time_;
+
   // For block cache and memory monitor shared across tablets
   tablet::TabletOptions tablet_options_;
 
@@ -15,6 +15,8 @@
 
 #include "yb/tserver/tserver_error.h"
 
+#include "yb/util/format.h"
+
 namespace yb {
 namespace tserver {
 
@@ -28,5 +30,15 @@ static const std::string kTabletServerDelayCategoryName = "tablet server delay";
 static StatusCategoryRegisterer tablet_server_delay_category_registerer(
     StatusCategoryDescription::Make<TabletServerDelayTag>(&kTabletServerDelayCategoryName));
 
+static const std::string kTabletServerLeaderHintCategoryName = "tablet server leader hint";
+
+static StatusCategoryRegisterer tablet_server_leader_hint_category_registerer(
+    StatusCategoryDescription::Make<TabletServerLeaderHintTag>(
+        &kTabletServerLeaderHintCategoryName));
+
+std::string TabletServerLeaderHintTag::ToMessage(const Value& value) {
+  return Format("Leader hint: $0", value);
+}
+
 } // namespace tserver
 } // namespace yb
@@ -66,6 +66,17 @@ struct TabletServerDelayTag : IntegralBackedErrorTag<MonoDeltaTraits> {
 
 typedef StatusErrorCodeImpl<TabletServerDelayTag> TabletServerDelay;
 
+// Attached to NOT_THE_LEADER errors, contains UUID of the replica that this peer believes to be
+// the tablet leader, so client could retry at the new leader without a master lookup.
+struct TabletServerLeaderHintTag : StringVectorBackedErrorTag {
+  // This category id is part of the wire protocol and should not be changed once released.
+  static constexpr uint8_t kCategory = 19;
+
+  static std::string ToMessage(const Value& value);
+};
+
+typedef StatusErrorCodeImpl<TabletServerLeaderHintTag> TabletServerLeaderHint;
+
 } // namespace tserver
 } // namespace yb
 
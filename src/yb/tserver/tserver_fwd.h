@@ -35,6 +35,7 @@ namespace tserver {
 class Heartbeater;
 class LocalTabletServer;
 class MetricsSnapshotter;
+class PgResponseCache;
 class PgTableCache;
 class TSTabletManager;
 class TabletPeerLookupIf;
@@ -306,6 +306,10 @@ Result<uint64_t> EnvWrapper::GetFileINode(const std::string& f) {
   return target_->GetFileINode(f);
 }
 
+Result<uint64_t> EnvWrapper::GetFileLinkCount(const std::string& f) {
+  return target_->GetFileLinkCount(f);
+}
+
 Result<uint64_t> EnvWrapper::GetFileSizeOnDisk(const std::string& f) {
   return target_->GetFileSizeOnDisk(f);
 }
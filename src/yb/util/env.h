@@ -299,6 +299,9 @@ class Env {
 
   virtual Result<uint64_t> GetFileINode(const std::string& fname) = 0;
 
+  // Returns the number of hard links to fname.
+  virtual Result<uint64_t> GetFileLinkCount(const std::string& fname) = 0;
+
   virtual CHECKED_STATUS LinkFile(const std::string& src,
                                   const std::string& target) = 0;
 
@@ -474,10 +477,15 @@ struct WritableFileOptions {
   // See CreateMode for details.
   Env::CreateMode mode;
 
+  // When an existing file is opened with OPEN_EXISTING, write from the beginning of the file,
+  // overwriting its contents, instead of appending to it.
+  bool overwrite_existing;
+
   WritableFileOptions()
     : sync_on_close(false),
       o_direct(false),
-      mode(Env::CREATE_IF_NON_EXISTING_TRUNCATE) { }
+      mode(Env::CREATE_IF_NON_EXISTING_TRUNCATE),
+      overwrite_existing(false) { }
 };
 
 // A file abstraction for sequential writing.  The implementation
@@ -707,6 +715,7 @@ class EnvWrapper : public Env {
   CHECKED_STATUS DeleteRecursively(const std::string& d) override;
   Result<uint64_t> GetFileSize(const std::string& f) override;
   Result<uint64_t> GetFileINode(const std::string& f) override;
+  Result<uint64_t> GetFileLinkCount(const std::string& f) override;
   Result<uint64_t> GetFileSizeOnDisk(const std::string& f) override;
   Result<uint64_t> GetBlockSize(const std::string& f) override;
   Result<FilesystemStats> GetFilesystemStatsBytes(const std::string& f) override;
@@ -1069,6 +1069,11 @@ class PosixEnv : public Env {
         fname, "PosixEnv::GetFileINode", [](const struct stat& sbuf) { return sbuf.st_ino; });
   }
 
+  Result<uint64_t> GetFileLinkCount(const std::string& fname) override {
+    return GetFileStat(
+        fname, "PosixEnv::GetFileLinkCount", [](const struct stat& sbuf) { return sbuf.st_nlink; });
+  }
+
   Result<uint64_t> GetFileSizeOnDisk(const std::string& fname) override {
     return GetFileStat(
         fname, "PosixEnv::GetFileSizeOnDisk", [](const struct stat& sbuf) {
@@ -1586,7 +1591,7 @@ class PosixFileFactory : public FileFactory {
                                     const WritableFileOptions& opts,
                                     std::unique_ptr<WritableFile>* result) {
     uint64_t file_size = 0;
-    if (opts.mode == PosixEnv::OPEN_EXISTING) {
+    if (opts.mode == PosixEnv::OPEN_EXISTING && !opts.overwrite_existing) {
       auto lseek_result = lseek(fd, 0, SEEK_END);
       if (lseek_result < 0) {
         return STATUS_IO_ERROR(fname, errno);
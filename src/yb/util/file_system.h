@@ -166,6 +166,10 @@ class RandomAccessFile : public FileWithUniqueId {
 
   virtual void Hint(AccessPattern pattern) {}
 
+  // Asks the platform to start loading the range [offset, offset + n) in background, so following
+  // reads of this range do not have to wait for the device. Does not block.
+  virtual void Readahead(uint64_t offset, size_t n) const {}
+
   // Remove any kind of caching of data from the offset to offset+length
   // of this file. If the length is 0, then it refers to the end of file.
   // If the system is not caching the file contents, then this is a noop.
@@ -221,6 +225,8 @@ class RandomAccessFileWrapper : public RandomAccessFile {
 
   void Hint(AccessPattern pattern) override { return target_->Hint(pattern); }
 
+  void Readahead(uint64_t offset, size_t n) const override { target_->Readahead(offset, n); }
+
   Status InvalidateCache(size_t offset, size_t length) override;
 
  private:
@@ -247,6 +247,10 @@ void PosixRandomAccessFile::Hint(AccessPattern pattern) {
   }
 }
 
+void PosixRandomAccessFile::Readahead(uint64_t offset, size_t n) const {
+  Fadvise(fd_, static_cast<off_t>(offset), n, POSIX_FADV_WILLNEED);
+}
+
 Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #ifndef __linux__
   return Status::OK();
@@ -49,6 +49,7 @@
 DECLARE_int32(memory_limit_soft_percentage);
 DECLARE_int64(mem_tracker_update_consumption_interval_us);
 DECLARE_int64(mem_tracker_tcmalloc_gc_release_bytes);
+DECLARE_int64(mem_tracker_ancestors_update_batch_bytes);
 
 namespace yb {
 
@@ -132,6 +133,53 @@ TEST(MemTrackerTest, TrackerHierarchy) {
   c2->Release(60);
 }
 
+TEST(MemTrackerTest, BatchedAncestorsUpdate) {
+  FLAGS_mem_tracker_ancestors_update_batch_bytes = 100;
+  shared_ptr<MemTracker> p = MemTracker::CreateTracker("p");
+  shared_ptr<MemTracker> c = MemTracker::CreateTracker("c", p);
+  shared_ptr<MemTracker> gc = MemTracker::CreateTracker("gc", c);
+
+  // Changes below the batch size are not propagated to ancestors.
+  gc->Consume(60);
+  ASSERT_EQ(gc->consumption(), 60);
+  ASSERT_EQ(c->consumption(), 0);
+  ASSERT_EQ(p->consumption(), 0);
+
+  gc->Consume(50);
+  ASSERT_EQ(gc->consumption(), 110);
+  ASSERT_EQ(c->consumption(), 110);
+  ASSERT_EQ(p->consumption(), 110);
+
+  gc->Release(30);
+  ASSERT_EQ(gc->consumption(), 80);
+  ASSERT_EQ(c->consumption(), 110);
+  ASSERT_EQ(p->consumption(), 110);
+
+  // Accumulated changes are flushed as soon as batching is turned off.
+  FLAGS_mem_tracker_ancestors_update_batch_bytes = 0;
+  gc->Release(10);
+  ASSERT_EQ(gc->consumption(), 70);
+  ASSERT_EQ(c->consumption(), 70);
+  ASSERT_EQ(p->consumption(), 70);
+
+  FLAGS_mem_tracker_ancestors_update_batch_bytes = 100;
+  gc->Release(70);
+  ASSERT_EQ(gc->consumption(), 0);
+  ASSERT_EQ(c->consumption(), 70);
+
+  // Not propagated part of consumption is taken into account when tracker is destroyed.
+  gc.reset();
+  ASSERT_EQ(c->consumption(), 0);
+  ASSERT_EQ(p->consumption(), 70);
+
+  FLAGS_mem_tracker_ancestors_update_batch_bytes = 0;
+  c->Consume(10);
+  ASSERT_EQ(c->consumption(), 10);
+  ASSERT_EQ(p->consumption(), 10);
+  c->Release(10);
+  ASSERT_EQ(p->consumption(), 0);
+}
+
 namespace {
 
 class GcTest : public GarbageCollector {
@@ -33,6 +33,7 @@
 #include "yb/util/mem_tracker.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <list>
 #include <memory>
@@ -120,6 +121,15 @@ DEFINE_int64(mem_tracker_tcmalloc_gc_release_bytes, -1,
              "overhead, but more efficient in terms of runtime.");
 TAG_FLAG(mem_tracker_tcmalloc_gc_release_bytes, runtime);
 
+DEFINE_int64(mem_tracker_ancestors_update_batch_bytes, 0,
+             "When positive, consume and release of a tracker update its ancestors only after "
+             "the not yet propagated change of its consumption reaches this number of bytes. "
+             "It reduces contention on shared trackers, i.e. server and root, while consumption "
+             "of an ancestor could lag by up to this number of bytes per each descendant tracker. "
+             "0 means that ancestors are updated on every consume and release.");
+TAG_FLAG(mem_tracker_ancestors_update_batch_bytes, advanced);
+TAG_FLAG(mem_tracker_ancestors_update_batch_bytes, runtime);
+
 namespace yb {
 
 // NOTE: this class has been adapted from Impala, so the code style varies
@@ -389,7 +399,8 @@ MemTracker::~MemTracker() {
   }
   if (parent_) {
     if (add_to_parent_) {
-      parent_->Release(consumption());
+      // Part of consumption that was not propagated to ancestors yet, should not be released.
+      parent_->Release(consumption() - pending_ancestors_delta_.exchange(0));
     }
   }
 }
@@ -525,12 +536,7 @@ void MemTracker::Consume(int64_t bytes) {
   if (PREDICT_FALSE(enable_logging_)) {
     LogUpdate(true, bytes);
   }
-  for (auto& tracker : all_trackers_) {
-    if (!tracker->UpdateConsumption()) {
-      IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
-      DCHECK_GE(tracker->consumption_.current_value(), 0);
-    }
-  }
+  IncrementConsumption(bytes);
 }
 
 bool MemTracker::TryConsume(int64_t bytes, MemTracker** blocking_mem_tracker) {
@@ -609,17 +615,44 @@ void MemTracker::Release(int64_t bytes) {
   if (PREDICT_FALSE(enable_logging_)) {
     LogUpdate(false, bytes);
   }
+  IncrementConsumption(-bytes);
+}
+
+void MemTracker::IncrementConsumption(int64_t bytes) {
+  const auto batch_bytes = GetAtomicFlag(&FLAGS_mem_tracker_ancestors_update_batch_bytes);
+  if (batch_bytes <= 0 &&
+      PREDICT_TRUE(pending_ancestors_delta_.load(std::memory_order_acquire) == 0)) {
+    for (auto& tracker : all_trackers_) {
+      if (!tracker->UpdateConsumption()) {
+        IncrementBy(bytes, &tracker->consumption_, tracker->metrics_);
+        // If a UDF calls FunctionContext::TrackAllocation() but allocates less than the
+        // reported amount, the subsequent call to FunctionContext::Free() may cause the
+        // process mem tracker to go negative until it is synced back to the tcmalloc
+        // metric. Don't blow up in this case. (Note that this doesn't affect non-process
+        // trackers since we can enforce that the reported memory usage is internally
+        // consistent.)
+        DCHECK_GE(tracker->consumption_.current_value(), 0) << "Tracker: " << tracker->ToString();
+      }
+    }
+    return;
+  }
 
-  for (auto& tracker : all_trackers_) {
+  // Consumption of this tracker is always exact, while ancestors receive accumulated changes.
+  IncrementBy(bytes, &consumption_, metrics_);
+  DCHECK_GE(consumption_.current_value(), 0) << "Tracker: " << ToString();
+  auto pending = pending_ancestors_delta_.fetch_add(bytes, std::memory_order_acq_rel) + bytes;
+  // If batching was turned off, changes accumulated before are flushed right away.
+  if (batch_bytes > 0 && std::abs(pending) < batch_bytes) {
+    return;
+  }
+  pending = pending_ancestors_delta_.exchange(0, std::memory_order_acq_rel);
+  if (pending == 0) {
+    return;
+  }
+  for (size_t i = 1; i < all_trackers_.size(); ++i) {
+    auto* tracker = all_trackers_[i];
     if (!tracker->UpdateConsumption()) {
-      IncrementBy(-bytes, &tracker->consumption_, tracker->metrics_);
-      // If a UDF calls FunctionContext::TrackAllocation() but allocates less than the
-      // reported amount, the subsequent call to FunctionContext::Free() may cause the
-      // process mem tracker to go negative until it is synced back to the tcmalloc
-      // metric. Don't blow up in this case. (Note that this doesn't affect non-process
-      // trackers since we can enforce that the reported memory usage is internally
-      // consistent.)
-      DCHECK_GE(tracker->consumption_.current_value(), 0) << "Tracker: " << tracker->ToString();
+      IncrementBy(pending, &tracker->consumption_, tracker->metrics_);
     }
   }
 }
@@ -34,6 +34,7 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -399,6 +400,10 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
   // can cause us to go way over mem limits.
   void GcTcmalloc();
 
+  // Adds bytes, that could be negative, to consumption of this tracker and its ancestors.
+  // Ancestors are updated in batches when mem_tracker_ancestors_update_batch_bytes is positive.
+  void IncrementConsumption(int64_t bytes);
+
   // Logs the stack of the current consume/release. Used for debugging only.
   void LogUpdate(bool is_consume, int64_t bytes) const;
 
@@ -435,6 +440,9 @@ class MemTracker : public std::enable_shared_from_this<MemTracker> {
 
   HighWaterMark consumption_{0};
 
+  // Change of consumption_ that was not propagated to ancestors yet.
+  std::atomic<int64_t> pending_ancestors_delta_{0};
+
   // this tracker plus all of its ancestors
   std::vector<MemTracker*> all_trackers_;
   // all_trackers_ with valid limits
@@ -269,6 +269,16 @@ Status MetricEntity::WriteAsJson(JsonWriter* writer,
 CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer,
                                                 const vector<string>& requested_metrics,
                                                 const MetricPrometheusOptions& opts) const {
+  // Only entities of these types are exported, check it before taking a snapshot of metrics.
+  const bool table_level =
+      strcmp(prototype_->name(), "tablet") == 0 || strcmp(prototype_->name(), "table") == 0;
+  const bool server_level =
+      strcmp(prototype_->name(), "server") == 0 || strcmp(prototype_->name(), "cluster") == 0;
+  const bool cdc_level = strcmp(prototype_->name(), "cdc") == 0;
+  if (!table_level && !server_level && !cdc_level) {
+    return Status::OK();
+  }
+
   bool select_all = MatchMetricInList(id(), requested_metrics);
 
   // We want the keys to be in alphabetical order when printing, so we use an ordered map here.
@@ -303,22 +313,19 @@ CHECKED_STATUS MetricEntity::WriteForPrometheus(PrometheusWriter* writer,
   AttributeMap prometheus_attr;
   // Per tablet metrics come with tablet_id, as well as table_id and table_name attributes.
   // We ignore the tablet part to squash at the table level.
-  if (strcmp(prototype_->name(), "tablet") == 0 || strcmp(prototype_->name(), "table") == 0) {
+  if (table_level) {
     prometheus_attr["table_id"] = attrs["table_id"];
     prometheus_attr["table_name"] = attrs["table_name"];
     prometheus_attr["namespace_name"] = attrs["namespace_name"];
-  } else if (
-      strcmp(prototype_->name(), "server") == 0 || strcmp(prototype_->name(), "cluster") == 0) {
+  } else if (server_level) {
     prometheus_attr = attrs;
     // This is tablet_id in the case of tablet, but otherwise names the server type, eg: yb.master
     prometheus_attr["metric_id"] = id_;
-  } else if (strcmp(prototype_->name(), "cdc") == 0) {
+  } else {
     prometheus_attr["table_id"] = attrs["table_id"];
     prometheus_attr["table_name"] = attrs["table_name"];
     prometheus_attr["namespace_name"] = attrs["namespace_name"];
     prometheus_attr["stream_id"] = attrs["stream_id"];
-  } else {
-    return Status::OK();
   }
   // This is currently tablet / server / cluster / cdc.
   prometheus_attr["metric_type"] = prototype_->name();
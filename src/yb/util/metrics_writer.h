@@ -49,20 +49,23 @@ class PrometheusWriter {
     auto it = attr.find("table_id");
     if (it != attr.end()) {
       // For tablet level metrics, we roll up on the table level.
-      if (per_table_attributes_.find(it->second) == per_table_attributes_.end()) {
+      // This is invoked for each metric of each tablet, so table is looked up only once.
+      auto table_it = per_table_values_.find(it->second);
+      if (table_it == per_table_values_.end()) {
         // If it's the first time we see this table, create the aggregate structures.
         per_table_attributes_[it->second] = attr;
         per_table_values_[it->second][name] = value;
       } else {
+        auto& table_value = table_it->second[name];
         switch (aggregation_function) {
           case kSum:
-            per_table_values_[it->second][name] += value;
+            table_value += value;
             break;
           case kMax:
             // If we have a new max, also update the metadata so that it matches correctly.
-            if (static_cast<double>(value) > per_table_values_[it->second][name]) {
+            if (static_cast<double>(value) > table_value) {
               per_table_attributes_[it->second] = attr;
-              per_table_values_[it->second][name] = value;
+              table_value = value;
             }
             break;
           default:
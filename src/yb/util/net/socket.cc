@@ -33,6 +33,7 @@
 #include "yb/util/net/socket.h"
 
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <sys/types.h>
 
 #include <limits>
@@ -634,4 +635,30 @@ Status Socket::SetReceiveBufferSize(int32_t size) {
   return Status::OK();
 }
 
+Status Socket::SetBusyPoll(int32_t usec) {
+#if defined(SO_BUSY_POLL)
+  DCHECK_GE(fd_, 0);
+  if (setsockopt(fd_, SOL_SOCKET, SO_BUSY_POLL, &usec, sizeof(usec))) {
+    return STATUS(NetworkError, "Failed to set socket busy poll", Errno(errno));
+  }
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "SO_BUSY_POLL is not supported on this platform");
+#endif
+}
+
+Result<MonoDelta> Socket::GetRoundTripTime() const {
+#if defined(__linux__)
+  DCHECK_GE(fd_, 0);
+  struct tcp_info info;
+  socklen_t info_len = sizeof(info);
+  if (getsockopt(fd_, IPPROTO_TCP, TCP_INFO, &info, &info_len)) {
+    return STATUS(NetworkError, "getsockopt(TCP_INFO) failed", Errno(errno));
+  }
+  return MonoDelta::FromMicroseconds(info.tcpi_rtt);
+#else
+  return STATUS(NotSupported, "TCP_INFO is not supported on this platform");
+#endif
+}
+
 } // namespace yb
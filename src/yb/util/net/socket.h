@@ -170,6 +170,13 @@ class Socket {
   Result<int32_t> GetReceiveBufferSize();
   CHECKED_STATUS SetReceiveBufferSize(int32_t size);
 
+  // Implements the SOL_SOCKET/SO_BUSY_POLL socket option, only supported on Linux.
+  CHECKED_STATUS SetBusyPoll(int32_t usec);
+
+  // Smoothed round trip time of the connection as estimated by the kernel, using TCP_INFO.
+  // Only supported on Linux.
+  Result<MonoDelta> GetRoundTripTime() const;
+
  private:
   // Called internally from SetSend/RecvTimeout().
   CHECKED_STATUS SetTimeout(int opt, std::string optname, const MonoDelta& timeout);
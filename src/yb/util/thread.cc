@@ -38,6 +38,8 @@
 #include <sys/types.h>
 
 #if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
 #include <sys/prctl.h>
 #endif // defined(__linux__)
 
@@ -574,6 +576,21 @@ void SetThreadName(const std::string& name) {
   }
 }
 
+Status PinCurrentThreadToCpu(int cpu) {
+#if defined(__linux__)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpu, &cpu_set);
+  int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+  if (err != 0) {
+    return STATUS(RuntimeError, Format("Failed to pin thread to CPU $0", cpu), "", Errno(err));
+  }
+  return Status::OK();
+#else
+  return STATUS(NotSupported, "Thread affinity is not supported on this platform");
+#endif // defined(__linux__)
+}
+
 void InitThreading() {
   std::call_once(init_threading_internal_once_flag, InitThreadingInternal);
 }
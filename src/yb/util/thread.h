@@ -406,6 +406,9 @@ void InitThreading();
 
 void SetThreadName(const std::string& name);
 
+// Pins the current thread to the specified CPU. Only supported on Linux.
+CHECKED_STATUS PinCurrentThreadToCpu(int cpu);
+
 class CDSAttacher {
  public:
   CDSAttacher();
@@ -0,0 +1,41 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/util/test_util.h"
+#include "yb/util/wait_state.h"
+
+namespace yb {
+
+class WaitStateTest : public YBTest {
+};
+
+TEST_F(WaitStateTest, Counters) {
+  auto before = GetWaitEventStats(WaitEvent::kSafeTime);
+  {
+    ScopedWaitEvent wait_event(WaitEvent::kSafeTime);
+    {
+      ScopedWaitEvent nested_wait_event(WaitEvent::kSafeTime);
+      ASSERT_EQ(before.num_waiting + 2, GetWaitEventStats(WaitEvent::kSafeTime).num_waiting);
+    }
+    auto stats = GetWaitEventStats(WaitEvent::kSafeTime);
+    ASSERT_EQ(before.num_waiting + 1, stats.num_waiting);
+    ASSERT_EQ(before.total_waits + 1, stats.total_waits);
+  }
+  auto after = GetWaitEventStats(WaitEvent::kSafeTime);
+  ASSERT_EQ(before.num_waiting, after.num_waiting);
+  ASSERT_EQ(before.total_waits + 2, after.total_waits);
+  ASSERT_GE(after.total_wait_us, before.total_wait_us);
+}
+
+} // namespace yb
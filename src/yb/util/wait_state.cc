@@ -0,0 +1,55 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#include "yb/util/wait_state.h"
+
+#include <atomic>
+
+namespace yb {
+
+namespace {
+
+struct WaitEventCounters {
+  std::atomic<int64_t> num_waiting{0};
+  std::atomic<int64_t> total_waits{0};
+  std::atomic<int64_t> total_wait_us{0};
+};
+
+WaitEventCounters wait_event_counters[kWaitEventMapSize];
+
+} // namespace
+
+ScopedWaitEvent::ScopedWaitEvent(WaitEvent event)
+    : event_(event), start_(CoarseMonoClock::now()) {
+  wait_event_counters[to_underlying(event_)].num_waiting.fetch_add(1, std::memory_order_relaxed);
+}
+
+ScopedWaitEvent::~ScopedWaitEvent() {
+  auto& counters = wait_event_counters[to_underlying(event_)];
+  counters.num_waiting.fetch_sub(1, std::memory_order_relaxed);
+  counters.total_waits.fetch_add(1, std::memory_order_relaxed);
+  counters.total_wait_us.fetch_add(
+      ToMicroseconds(CoarseMonoClock::now() - start_), std::memory_order_relaxed);
+}
+
+WaitEventStats GetWaitEventStats(WaitEvent event) {
+  const auto& counters = wait_event_counters[to_underlying(event)];
+  WaitEventStats result;
+  result.num_waiting = counters.num_waiting.load(std::memory_order_relaxed);
+  result.total_waits = counters.total_waits.load(std::memory_order_relaxed);
+  result.total_wait_us = counters.total_wait_us.load(std::memory_order_relaxed);
+  return result;
+}
+
+} // namespace yb
@@ -0,0 +1,63 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+
+#ifndef YB_UTIL_WAIT_STATE_H
+#define YB_UTIL_WAIT_STATE_H
+
+#include <stdint.h>
+
+#include "yb/util/enums.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+
+// Events that a thread could be blocked on. Used to attribute latency of slow requests to the
+// component that they were waiting for, without enabling tracing.
+YB_DEFINE_ENUM(WaitEvent,
+    // Waiting for conflicting locks in SharedLockManager.
+    (kLockManager)
+    // Waiting for MvccManager safe time to reach the read time.
+    (kSafeTime)
+    // Waiting for fsync of the WAL.
+    (kWalSync));
+
+// Marks the current thread as blocked on the specified event for the lifetime of this object.
+// The overhead is two process wide atomic counter updates and two coarse clock reads, so it is
+// intended to wrap blocking waits only.
+class ScopedWaitEvent {
+ public:
+  explicit ScopedWaitEvent(WaitEvent event);
+  ~ScopedWaitEvent();
+
+  ScopedWaitEvent(const ScopedWaitEvent&) = delete;
+  void operator=(const ScopedWaitEvent&) = delete;
+
+ private:
+  const WaitEvent event_;
+  const CoarseTimePoint start_;
+};
+
+struct WaitEventStats {
+  // Number of threads that are waiting for the event at the moment.
+  int64_t num_waiting = 0;
+  // Number of finished waits and the total time spent in them since the process start.
+  int64_t total_waits = 0;
+  int64_t total_wait_us = 0;
+};
+
+WaitEventStats GetWaitEventStats(WaitEvent event);
+
+} // namespace yb
+
+#endif // YB_UTIL_WAIT_STATE_H
@@ -44,6 +44,13 @@
 
 using namespace std::literals;
 
+METRIC_DEFINE_histogram_with_percentiles(
+    server, handler_latency_yb_cqlserver_CQLServerService_QueueRequest,
+    "Time spent by a CQL request in the service queue before it is handled.",
+    yb::MetricUnit::kMicroseconds,
+    "Time spent from receiving a CQL request on the connection till it is handled by the CQL "
+    "service. High values mean that requests are blocked behind other requests.",
+    60000000LU, 2);
 METRIC_DEFINE_histogram_with_percentiles(
     server, handler_latency_yb_cqlserver_CQLServerService_GetProcessor,
     "Time spent to get a processor for processing a CQL query request.",
@@ -169,6 +176,8 @@ using yb::util::bcrypt_checkpw;
 //------------------------------------------------------------------------------------------------
 CQLMetrics::CQLMetrics(const scoped_refptr<yb::MetricEntity>& metric_entity)
     : QLMetrics(metric_entity) {
+  time_to_queue_cql_request_ =
+      METRIC_handler_latency_yb_cqlserver_CQLServerService_QueueRequest.Instantiate(metric_entity);
   time_to_process_request_ =
       METRIC_handler_latency_yb_cqlserver_CQLServerService_ProcessRequest.Instantiate(
           metric_entity);
@@ -257,6 +266,7 @@ void CQLProcessor::Release() {
   request_ = nullptr;
   stmts_.clear();
   parse_trees_.clear();
+  unprepared_stmts_.clear();
   SetCurrentSession(nullptr);
   is_rescheduled_.store(IsRescheduled::kFalse, std::memory_order_release);
   audit_logger_.SetConnection(nullptr);
@@ -439,8 +449,63 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const QueryRequest& req) {
       return nullptr;
     }
   }
-  RunAsync(req.query(), req.params(), statement_executed_cb_);
-  return nullptr;
+  const shared_ptr<CQLStatement> stmt = service_impl_->AllocateUnpreparedStatement(
+      ql_env_.CurrentKeyspace(), req.query());
+  if (stmt == nullptr) {
+    RunAsync(req.query(), req.params(), statement_executed_cb_);
+    return nullptr;
+  }
+  return ExecuteUnpreparedStatement(stmt, req.params());
+}
+
+unique_ptr<CQLResponse> CQLProcessor::ExecuteUnpreparedStatement(
+    const shared_ptr<CQLStatement>& stmt, const ql::StatementParameters& params) {
+  const auto parse_tree = PrepareUnpreparedStatement(stmt);
+  if (!parse_tree.ok()) {
+    return ProcessError(parse_tree.status());
+  }
+  const Status s = stmt->ExecuteAsync(this, params, statement_executed_cb_);
+  return s.ok() ? nullptr : ProcessError(s);
+}
+
+Result<const ParseTree&> CQLProcessor::PrepareUnpreparedStatement(
+    const shared_ptr<CQLStatement>& stmt) {
+  // The statement could be shared with other clients executing the same query, the first one
+  // prepares it while the rest wait, the same way as for PREPARE requests.
+  Status s = stmt->Prepare(this, service_impl_->unprepared_stmts_mem_tracker());
+  if (!s.ok()) {
+    service_impl_->DeleteUnpreparedStatement(stmt);
+    return s;
+  }
+  auto parse_tree = stmt->GetParseTree();
+  if (!parse_tree.ok()) {
+    service_impl_->DeleteUnpreparedStatement(stmt);
+    return parse_tree;
+  }
+
+  // Keep only DML parse trees in the cache. Other statements, like DDLs or USE, are executed
+  // rarely and their analysis may depend on state that is not covered by the query id.
+  const auto& root = parse_tree->root();
+  bool is_dml = false;
+  if (root != nullptr) {
+    switch (root->opcode()) {
+      case ql::TreeNodeOpcode::kPTSelectStmt: FALLTHROUGH_INTENDED;
+      case ql::TreeNodeOpcode::kPTInsertStmt: FALLTHROUGH_INTENDED;
+      case ql::TreeNodeOpcode::kPTUpdateStmt: FALLTHROUGH_INTENDED;
+      case ql::TreeNodeOpcode::kPTDeleteStmt:
+        is_dml = true;
+        break;
+      default:
+        break;
+    }
+  }
+  if (!is_dml) {
+    service_impl_->DeleteUnpreparedStatement(stmt);
+  }
+
+  // Hold the statement for the duration of the execution, the cache could evict it meanwhile.
+  unprepared_stmts_.insert(stmt);
+  return parse_tree;
 }
 
 unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const BatchRequest& req) {
@@ -475,6 +540,17 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const BatchRequest& req) {
       batch.emplace_back(*parse_tree, query.params);
     } else {
       VLOG(1) << "BATCH QUERY " << query.query;
+      const shared_ptr<CQLStatement> stmt = service_impl_->AllocateUnpreparedStatement(
+          ql_env_.CurrentKeyspace(), query.query);
+      if (stmt != nullptr) {
+        const auto parse_tree = PrepareUnpreparedStatement(stmt);
+        if (!parse_tree.ok()) {
+          result = ProcessError(parse_tree.status());
+          break;
+        }
+        batch.emplace_back(*parse_tree, query.params);
+        continue;
+      }
       ParseTree::UniPtr parse_tree;
       s = Prepare(query.query, &parse_tree);
       if (PREDICT_FALSE(!s.ok())) {
@@ -585,6 +661,12 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessError(const Status& s,
       // (non-prepared statements). In that case, just retry the request (once only). The retry
       // needs to be rescheduled in because this callback may not be executed in the RPC worker
       // thread. Also, rescheduling gives other calls a chance to execute first before we do.
+      // Cached parse trees of the queries could be stale too, so remove them from the cache before
+      // the retry, which will parse and analyze the queries again.
+      for (const auto& stmt : unprepared_stmts_) {
+        service_impl_->DeleteUnpreparedStatement(stmt);
+      }
+      unprepared_stmts_.clear();
       if (++retry_count_ == 1) {
         stmts_.clear();
         parse_trees_.clear();
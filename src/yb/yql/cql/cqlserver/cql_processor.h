@@ -41,6 +41,7 @@ class CQLMetrics : public ql::QLMetrics {
  public:
   explicit CQLMetrics(const scoped_refptr<yb::MetricEntity>& metric_entity);
 
+  scoped_refptr<yb::Histogram> time_to_queue_cql_request_;
   scoped_refptr<yb::Histogram> time_to_process_request_;
   scoped_refptr<yb::Histogram> time_to_get_cql_processor_;
   scoped_refptr<yb::Histogram> time_to_parse_cql_wrapper_;
@@ -95,6 +96,14 @@ class CQLProcessor : public ql::QLProcessor {
   std::unique_ptr<ql::CQLResponse> ProcessRequest(const ql::AuthResponseRequest& req);
   std::unique_ptr<ql::CQLResponse> ProcessRequest(const ql::RegisterRequest& req);
 
+  // Prepare a non-prepared query using the parse tree cache, and execute it.
+  std::unique_ptr<ql::CQLResponse> ExecuteUnpreparedStatement(
+      const std::shared_ptr<CQLStatement>& stmt, const ql::StatementParameters& params);
+
+  // Prepare a statement from the parse tree cache and hold it until the request is processed.
+  Result<const ql::ParseTree&> PrepareUnpreparedStatement(
+      const std::shared_ptr<CQLStatement>& stmt);
+
   // Get a prepared statement and adds it to the set of statements currently being executed.
   std::shared_ptr<const CQLStatement> GetPreparedStatement(const ql::CQLMessage::QueryId& id);
 
@@ -136,6 +145,9 @@ class CQLProcessor : public ql::QLProcessor {
   std::unordered_set<std::shared_ptr<const CQLStatement>> stmts_;
   std::unordered_set<ql::ParseTree::UniPtr> parse_trees_;
 
+  // Cached statements of the non-prepared queries being executed.
+  std::unordered_set<std::shared_ptr<const CQLStatement>> unprepared_stmts_;
+
   // Current retry count.
   int retry_count_ = 0;
 
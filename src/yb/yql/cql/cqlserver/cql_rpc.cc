@@ -23,7 +23,10 @@
 #include "yb/rpc/reactor.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/debug/trace_event.h"
+#include "yb/util/flag_tags.h"
+#include "yb/util/logging.h"
 #include "yb/util/result.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status_format.h"
@@ -56,6 +59,14 @@ DEFINE_int32(throttle_cql_calls_policy, kRejectPolicy,
               "Policy for throttling CQL calls. 1 - drop throttled calls. "
               "0 - respond with OVERLOADED error.");
 
+DEFINE_int32(cql_max_in_flight_calls_per_connection, 0,
+             "The maximum number of CQL calls of a single connection that could be processed "
+             "concurrently. Calls above the limit are rejected with OVERLOADED error, so a "
+             "connection with many streams could not occupy all CQL processors. 0 or negative "
+             "means unlimited.");
+TAG_FLAG(cql_max_in_flight_calls_per_connection, advanced);
+TAG_FLAG(cql_max_in_flight_calls_per_connection, runtime);
+
 DECLARE_uint64(rpc_max_message_size);
 
 // Max msg length for CQL.
@@ -126,6 +137,17 @@ Status CQLConnectionContext::HandleCall(
     }
   }
 
+  const auto max_in_flight_calls = GetAtomicFlag(&FLAGS_cql_max_in_flight_calls_per_connection);
+  if (max_in_flight_calls > 0 &&
+      NumCallsBeingHandled() >= static_cast<size_t>(max_in_flight_calls)) {
+    YB_LOG_EVERY_N_SECS(WARNING, 10)
+        << connection->ToString() << ": rejecting CQL call, " << NumCallsBeingHandled()
+        << " calls of the connection are in flight";
+    call->ResetCallProcessedListener();
+    call->RespondFailure(rpc::ErrorStatusPB::ERROR_SERVER_TOO_BUSY, Status::OK());
+    return Status::OK();
+  }
+
   s = Store(call.get());
   if (!s.ok()) {
     return s;
@@ -27,7 +27,9 @@
 
 #include "yb/tserver/tablet_server_interface.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
@@ -50,6 +52,12 @@ DECLARE_int32(cql_update_system_query_cache_msecs);
 DEFINE_int64(cql_service_max_prepared_statement_size_bytes, 128_MB,
              "The maximum amount of memory the CQL proxy should use to maintain prepared "
              "statements. 0 or negative means unlimited.");
+DEFINE_int32(cql_unprepared_stmts_cache_size, 1024,
+             "The maximum number of parse trees of non-prepared CQL queries to cache, so the "
+             "same query text is not parsed and analyzed again on every execution. 0 or negative "
+             "disables the cache.");
+TAG_FLAG(cql_unprepared_stmts_cache_size, advanced);
+TAG_FLAG(cql_unprepared_stmts_cache_size, runtime);
 DEFINE_int32(cql_ybclient_reactor_threads, 24,
              "The number of reactor threads to be used for processing ybclient "
              "requests originating in the cql layer");
@@ -131,6 +139,9 @@ CQLServiceImpl::CQLServiceImpl(CQLServer* server, const CQLServerOptions& opts)
       FLAGS_cql_service_max_prepared_statement_size_bytes : -1,
       "CQL prepared statements", server->mem_tracker());
 
+  unprepared_stmts_mem_tracker_ = MemTracker::CreateTracker(
+      "CQL unprepared statements", server->mem_tracker());
+
   LOG(INFO) << "CQL processors limit: " << CQLProcessorsLimit();
 
   processors_mem_tracker_ = MemTracker::CreateTracker("CQL processors", server->mem_tracker());
@@ -193,6 +204,8 @@ void CQLServiceImpl::Handle(yb::rpc::InboundCallPtr inbound_call) {
 
   // Process the call.
   MonoTime start = MonoTime::Now();
+  cql_metrics_->time_to_queue_cql_request_->Increment(
+      start.GetDeltaSince(inbound_call->ReceiveTime()).ToMicroseconds());
 
   Result<CQLProcessor*> processor = GetProcessor();
   if (!processor.ok()) {
@@ -301,6 +314,64 @@ void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement
           << ", memory usage = " << prepared_stmts_mem_tracker_->consumption();
 }
 
+shared_ptr<CQLStatement> CQLServiceImpl::AllocateUnpreparedStatement(
+    const string& keyspace, const string& query) {
+  const auto cache_size = GetAtomicFlag(&FLAGS_cql_unprepared_stmts_cache_size);
+  if (cache_size <= 0) {
+    return nullptr;
+  }
+  const auto query_id = CQLStatement::GetQueryId(keyspace, query);
+
+  std::lock_guard<std::mutex> guard(unprepared_stmts_mutex_);
+
+  const auto itr = unprepared_stmts_map_.find(query_id);
+  if (itr != unprepared_stmts_map_.end()) {
+    shared_ptr<CQLStatement> stmt = itr->second;
+    // Return the existing statement unless it was found stale by a previous execution, i.e. the
+    // schema of a referenced object has changed. An unprepared statement is being prepared by
+    // another client, so share it the same way as prepared statements do.
+    if (stmt->unprepared() || !stmt->stale()) {
+      unprepared_stmts_list_.splice(
+          unprepared_stmts_list_.begin(), unprepared_stmts_list_, stmt->pos());
+      return stmt;
+    }
+    DeleteUnpreparedStatementUnlocked(stmt);
+  }
+
+  while (unprepared_stmts_list_.size() >= static_cast<size_t>(cache_size)) {
+    DeleteUnpreparedStatementUnlocked(unprepared_stmts_list_.back());
+  }
+
+  auto stmt = std::make_shared<CQLStatement>(keyspace, query, unprepared_stmts_list_.end());
+  unprepared_stmts_map_.emplace(query_id, stmt);
+  stmt->set_pos(unprepared_stmts_list_.insert(unprepared_stmts_list_.begin(), stmt));
+
+  VLOG(2) << "AllocateUnpreparedStatement: CQL unprepared statement cache count = "
+          << unprepared_stmts_map_.size() << "/" << unprepared_stmts_list_.size()
+          << ", memory usage = " << unprepared_stmts_mem_tracker_->consumption();
+
+  return stmt;
+}
+
+void CQLServiceImpl::DeleteUnpreparedStatement(const shared_ptr<const CQLStatement>& stmt) {
+  std::lock_guard<std::mutex> guard(unprepared_stmts_mutex_);
+  DeleteUnpreparedStatementUnlocked(stmt);
+}
+
+void CQLServiceImpl::DeleteUnpreparedStatementUnlocked(
+    const std::shared_ptr<const CQLStatement> stmt) {
+  // Same as DeletePreparedStatementUnlocked, "stmt" is passed by value so that it is not the very
+  // shared_ptr being erased.
+  const auto itr = unprepared_stmts_map_.find(stmt->query_id());
+  if (itr != unprepared_stmts_map_.end() && itr->second == stmt) {
+    unprepared_stmts_map_.erase(itr);
+  }
+  if (stmt->pos() != unprepared_stmts_list_.end()) {
+    unprepared_stmts_list_.erase(stmt->pos());
+    stmt->set_pos(unprepared_stmts_list_.end());
+  }
+}
+
 bool CQLServiceImpl::CheckPassword(
     const std::string plain,
     const std::string expected_bcrypt_hash) {
@@ -79,6 +79,15 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Delete the prepared statement from the cache.
   void DeletePreparedStatement(const std::shared_ptr<const CQLStatement>& stmt);
 
+  // Allocate a statement for a non-prepared query, so its parse tree could be reused by following
+  // executions of the same query text in the same keyspace. If a statement that is not stale
+  // already exists, return it instead. Nullptr is returned when the cache is disabled.
+  std::shared_ptr<CQLStatement> AllocateUnpreparedStatement(
+      const std::string& keyspace, const std::string& query);
+
+  // Delete the non-prepared query statement from the cache.
+  void DeleteUnpreparedStatement(const std::shared_ptr<const CQLStatement>& stmt);
+
   // Check that the password and hash match.  Leverages shared LRU cache.
   bool CheckPassword(const std::string plain, const std::string expected_bcrypt_hash);
 
@@ -87,6 +96,11 @@ class CQLServiceImpl : public CQLServerServiceIf,
     return prepared_stmts_mem_tracker_;
   }
 
+  // Return the memory tracker for parse trees of non-prepared queries.
+  const MemTrackerPtr& unprepared_stmts_mem_tracker() const {
+    return unprepared_stmts_mem_tracker_;
+  }
+
   const MemTrackerPtr& processors_mem_tracker() const {
     return processors_mem_tracker_;
   }
@@ -126,6 +140,10 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // be locked before this call.
   void DeletePreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
 
+  // Delete a non-prepared query statement from the cache and its LRU list.
+  // "unprepared_stmts_mutex_" needs to be locked before this call.
+  void DeleteUnpreparedStatementUnlocked(const std::shared_ptr<const CQLStatement> stmt);
+
   // Delete the least recently used prepared statement from the cache to free up memory.
   void CollectGarbage(size_t required) override;
 
@@ -156,11 +174,24 @@ class CQLServiceImpl : public CQLServerServiceIf,
   // Mutex that protects the prepared statements and the LRU list.
   std::mutex prepared_stmts_mutex_;
 
+  // Cache of parse trees of non-prepared queries, keyed by the same query id as prepared
+  // statements. The cache is bounded by cql_unprepared_stmts_cache_size entries.
+  CQLStatementMap unprepared_stmts_map_ GUARDED_BY(unprepared_stmts_mutex_);
+
+  // LRU list of non-prepared query statements (least recently used one at the end).
+  CQLStatementList unprepared_stmts_list_ GUARDED_BY(unprepared_stmts_mutex_);
+
+  // Mutex that protects the non-prepared query statements and their LRU list.
+  std::mutex unprepared_stmts_mutex_;
+
   std::shared_ptr<ql::Statement> auth_prepared_stmt_;
 
   // Tracker to measure and limit memory usage of prepared statements.
   MemTrackerPtr prepared_stmts_mem_tracker_;
 
+  // Tracker to measure memory usage of cached parse trees of non-prepared queries.
+  MemTrackerPtr unprepared_stmts_mem_tracker_;
+
   MemTrackerPtr processors_mem_tracker_;
 
   // Password and hash cache. Stores each password-hash pair as a compound key;
@@ -36,6 +36,7 @@
 
 DECLARE_bool(cql_server_always_send_events);
 DECLARE_bool(use_cassandra_authentication);
+DECLARE_int32(cql_unprepared_stmts_cache_size);
 
 namespace yb {
 namespace cqlserver {
@@ -455,6 +456,38 @@ TEST_F(TestCQLService, TestReadSystemTable) {
                     "\x00\x00\x00\x05" "local"));
 }
 
+TEST_F(TestCQLService, TestReadSystemTableWithCachedParseTree) {
+  FLAGS_cql_unprepared_stmts_cache_size = 16;
+
+  SendRequestAndExpectResponse(
+      BINARY_STRING("\x04\x00\x00\x00\x01" "\x00\x00\x00\x16"
+                    "\x00\x01" "\x00\x0b" "CQL_VERSION"
+                               "\x00\x05" "3.0.0"),
+      BINARY_STRING("\x84\x00\x00\x00\x02" // 0x02 = READY
+                    "\x00\x00\x00\x00"));  // zero body size
+
+  // The second and the following executions of the same query use the cached parse tree.
+  for (int i = 0; i != 3; ++i) {
+    SendRequestAndExpectResponse(
+        BINARY_STRING("\x04\x00\x00\x00\x07" // 0x07 = QUERY
+                      "\x00\x00\x00\x23"     // body size
+                      "\x00\x00\x00\x1c" "SELECT key FROM system.local"
+                      "\x00\x01"             // consistency: 0x0001 = ONE
+                      "\x00"),               // bit flags
+        BINARY_STRING("\x84\x00\x00\x00\x08" // 0x08 = RESULT
+                      "\x00\x00\x00\x2f"     // body size
+                      "\x00\x00\x00\x02"     // 0x00000002 = ROWS
+                      "\x00\x00\x00\x01"     // flags: 0x01 = Global_tables_spec
+                      "\x00\x00\x00\x01"     // column count
+                      "\x00\x06" "system"
+                      "\x00\x05" "local"
+                      "\x00\x03" "key"
+                      "\x00\x0d"             // type id: 0x000D = Varchar
+                      "\x00\x00\x00\x01"     // row count
+                      "\x00\x00\x00\x05" "local"));
+  }
+}
+
 class TestCQLServiceWithCassAuth : public TestCQLService {
  public:
   void SetUp() override {
@@ -14,16 +14,23 @@
 
 #include "yb/yql/cql/ql/audit/audit_logger.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/optional/optional_io.hpp>
 #include <boost/preprocessor/seq/for_each.hpp>
 
 #include "yb/rpc/connection.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/date_time.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/result.h"
+#include "yb/util/status_log.h"
 #include "yb/util/string_util.h"
+#include "yb/util/thread.h"
 
 #include "yb/yql/cql/ql/ptree/pt_alter_keyspace.h"
 #include "yb/yql/cql/ql/ptree/pt_alter_table.h"
@@ -89,6 +96,19 @@ DEFINE_string(ycql_audit_excluded_users,
               "Comma separated list of users to be excluded from the audit log");
 TAG_FLAG(ycql_audit_excluded_users, runtime);
 
+DEFINE_bool(ycql_audit_log_async, false,
+            "Write YCQL audit records from a background thread, instead of the thread that "
+            "executes the statement. Records that are still queued when the process terminates "
+            "are lost.");
+TAG_FLAG(ycql_audit_log_async, advanced);
+TAG_FLAG(ycql_audit_log_async, runtime);
+
+DEFINE_int32(ycql_audit_log_async_queue_size, 10000,
+             "Max number of YCQL audit records waiting for the background writer. When the queue "
+             "is full, the thread that executes the statement waits for the writer, so records "
+             "stay in order.");
+TAG_FLAG(ycql_audit_log_async_queue_size, advanced);
+TAG_FLAG(ycql_audit_log_async_queue_size, runtime);
 
 namespace yb {
 namespace ql {
@@ -490,6 +510,69 @@ std::string ObfuscateOperation(const TreeNode& tnode, const std::string& operati
   return copy;
 }
 
+void WriteAuditRecord(google::LogSeverity severity, const std::string& record) {
+  google::LogMessage(__FILE__, __LINE__, severity).stream() << record;
+}
+
+// Writes audit records in a background thread, so a statement does not wait for glog, which
+// holds a global lock while writing, and flushes log files for WARNING and ERROR severities.
+class AsyncAuditWriter {
+ public:
+  static AsyncAuditWriter& Instance() {
+    // Intentionally leaked, so the writer is never destroyed while some thread still uses it.
+    static AsyncAuditWriter* instance = new AsyncAuditWriter();
+    return *instance;
+  }
+
+  // Takes the record and returns true if it was queued. Waits while the queue is full, so records
+  // are written in the order they were added. Returns false when the writer thread could not be
+  // started, so the caller should write the record by itself.
+  bool Enqueue(google::LogSeverity severity, std::string* record) {
+    if (!thread_) {
+      return false;
+    }
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      not_full_cond_.wait(lock, [this] {
+        return queue_.size() < static_cast<size_t>(
+            std::max(GetAtomicFlag(&FLAGS_ycql_audit_log_async_queue_size), 1));
+      });
+      queue_.emplace_back(severity, std::move(*record));
+    }
+    not_empty_cond_.notify_one();
+    return true;
+  }
+
+ private:
+  AsyncAuditWriter() {
+    WARN_NOT_OK(
+        Thread::Create("audit", "audit_writer", &AsyncAuditWriter::Execute, this, &thread_),
+        "Failed to start audit writer, audit records are written synchronously");
+  }
+
+  void Execute() {
+    std::vector<std::pair<google::LogSeverity, std::string>> batch;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_cond_.wait(lock, [this] { return !queue_.empty(); });
+        batch.swap(queue_);
+      }
+      not_full_cond_.notify_all();
+      for (const auto& severity_and_record : batch) {
+        WriteAuditRecord(severity_and_record.first, severity_and_record.second);
+      }
+      batch.clear();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable not_empty_cond_;
+  std::condition_variable not_full_cond_;
+  std::vector<std::pair<google::LogSeverity, std::string>> queue_;
+  scoped_refptr<Thread> thread_;
+};
+
 // Follows Cassandra's view format for prettified binary log.
 CHECKED_STATUS AddLogEntry(const LogEntry& e) {
   std::string str;
@@ -527,22 +610,24 @@ CHECKED_STATUS AddLogEntry(const LogEntry& e) {
     str.append("; ");
     str.append(e.error_message);
   }
-  // Since glog uses macros, it's not too convenient to extract a log level.
-  auto severity = boost::algorithm::to_lower_copy(FLAGS_ycql_audit_log_level);
-  if (severity == "info") {
-    LOG(INFO) << str;
-    return Status::OK();
-  } else if (severity == "warning") {
-    LOG(WARNING) << str;
-    return Status::OK();
-  } else if (severity == "error") {
-    LOG(ERROR) << str;
-    return Status::OK();
+  auto severity_name = boost::algorithm::to_lower_copy(FLAGS_ycql_audit_log_level);
+  google::LogSeverity severity;
+  if (severity_name == "info") {
+    severity = google::GLOG_INFO;
+  } else if (severity_name == "warning") {
+    severity = google::GLOG_WARNING;
+  } else if (severity_name == "error") {
+    severity = google::GLOG_ERROR;
   } else {
     return STATUS_FORMAT(InvalidArgument,
                          "$0 is not a valid severity level",
                          FLAGS_ycql_audit_log_level);
   }
+  if (!GetAtomicFlag(&FLAGS_ycql_audit_log_async) ||
+      !AsyncAuditWriter::Instance().Enqueue(severity, &str)) {
+    WriteAuditRecord(severity, str);
+  }
+  return Status::OK();
 }
 
 } // anonymous namespace
@@ -433,6 +433,16 @@ void QLProcessor::ExecuteAsync(const ParseTree& parse_tree, const StatementParam
 }
 
 void QLProcessor::ExecuteAsync(const StatementBatch& batch, StatementExecutedCallback cb) {
+  // The parse trees of a batch could come from the cache of another session, so the permissions
+  // checked during their analysis are not necessarily those of the current role.
+  if (FLAGS_use_cassandra_authentication) {
+    for (const auto& pair : batch) {
+      const ParseTree& parse_tree = pair.first;
+      if (!parse_tree.internal() && !CheckPermissions(parse_tree, cb)) {
+        return;
+      }
+    }
+  }
   executor_.ExecuteAsync(batch, std::move(cb));
 }
 
@@ -33,6 +33,13 @@ namespace pggate {
 using namespace std::literals;  // NOLINT
 using std::list;
 
+namespace {
+
+// Interval, in rows, between checks whether the prefetched response has arrived.
+constexpr size_t kPrefetchCheckIntervalRows = 64;
+
+} // namespace
+
 // TODO(neil) This should be derived from a GFLAGS.
 static MonoDelta kSessionTimeout = 60s;
 
@@ -429,6 +436,13 @@ Result<bool> PgDml::GetNextRow(PgTuple *pg_tuple) {
 
         // Found the current row. Move cursor to next row.
         current_row_order_++;
+
+        // Accept the next page without waiting for buffered rows to be drained, so the request for
+        // the page after it is sent earlier.
+        if (++rows_since_prefetch_check_ >= kPrefetchCheckIntervalRows) {
+          rows_since_prefetch_check_ = 0;
+          RETURN_NOT_OK(doc_op_->PrefetchIfReady(&rowsets_));
+        }
         return true;
       }
 
@@ -230,6 +230,9 @@ class PgDml : public PgStatement {
   std::list<PgDocResult> rowsets_;
   int64_t current_row_order_ = 0;
 
+  // Number of rows returned since the last check for arrived prefetched response.
+  size_t rows_since_prefetch_check_ = 0;
+
   // Yugabyte has a few IN/OUT parameters of statement execution, "pg_exec_params_" is used to sent
   // OUT value back to postgres.
   const PgExecParameters *pg_exec_params_ = NULL;
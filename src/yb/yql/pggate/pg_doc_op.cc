@@ -193,19 +193,44 @@ Status PgDocOp::GetResult(list<PgDocResult> *rowsets) {
     }
 
     DCHECK(response_.Valid());
-    auto result = response_.Get();
-    auto rows = VERIFY_RESULT(ProcessResponse(result));
-    // In case ProcessResponse doesn't fail with an error
-    // it should return non empty rows and/or set end_of_data_.
-    DCHECK(!rows.empty() || end_of_data_);
-    rowsets->splice(rowsets->end(), rows);
-    // Prefetch next portion of data if needed.
-    if (!(end_of_data_ || suppress_next_result_prefetching_)) {
-      exec_status_ = SendRequest(true /* force_non_bufferable */, false /* use_async_flush */);
-      RETURN_NOT_OK(exec_status_);
-    }
+    RETURN_NOT_OK(ReceiveResponse(rowsets));
+  }
+
+  return Status::OK();
+}
+
+Status PgDocOp::PrefetchIfReady(list<PgDocResult> *rowsets) {
+  const auto buffer_limit = FLAGS_ysql_eager_prefetch_buffer_limit;
+  if (buffer_limit == 0 || !exec_status_.ok() || end_of_data_ ||
+      suppress_next_result_prefetching_ || !response_.Ready()) {
+    return Status::OK();
+  }
+
+  size_t buffered_bytes = 0;
+  for (const auto& rowset : *rowsets) {
+    buffered_bytes += rowset.remaining_bytes();
   }
+  if (buffered_bytes >= buffer_limit) {
+    return Status::OK();
+  }
+
+  VLOG(3) << __func__ << ": accepting prefetched response with " << buffered_bytes
+          << " bytes buffered";
+  return ReceiveResponse(rowsets);
+}
 
+Status PgDocOp::ReceiveResponse(list<PgDocResult> *rowsets) {
+  auto result = response_.Get();
+  auto rows = VERIFY_RESULT(ProcessResponse(result));
+  // In case ProcessResponse doesn't fail with an error
+  // it should return non empty rows and/or set end_of_data_.
+  DCHECK(!rows.empty() || end_of_data_);
+  rowsets->splice(rowsets->end(), rows);
+  // Prefetch next portion of data if needed.
+  if (!(end_of_data_ || suppress_next_result_prefetching_)) {
+    exec_status_ = SendRequest(true /* force_non_bufferable */, false /* use_async_flush */);
+    RETURN_NOT_OK(exec_status_);
+  }
   return Status::OK();
 }
 
@@ -824,6 +849,11 @@ Status PgDocReadOp::ProcessResponseReadStates() {
       // This allows long-running queries to continue in the presence of other DDL statements
       // as long as they do not affect the table(s) being queried.
       req.clear_ysql_catalog_version();
+
+      // Next page is requested only after the executor consumed this one, so grow it.
+      if (prefetch_limit_cap_ != 0 && req.limit() < prefetch_limit_cap_) {
+        req.set_limit(std::min<uint64_t>(req.limit() * 2, prefetch_limit_cap_));
+      }
     }
 
     // Check for batch execution.
@@ -930,12 +960,35 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
     limit = predicted_limit;
     suppress_next_result_prefetching_ = false;
   }
+
+  // With adaptive prefetching the scan starts with a small page, that is doubled each time the
+  // executor consumed the previous one. So short scans do not read rows that are never used, while
+  // long scans quickly reach large pages. Statement LIMIT bounds the page, and the size limit keeps
+  // large pages of wide rows from overflowing the response.
+  prefetch_limit_cap_ = 0;
+  if (FLAGS_ysql_adaptive_prefetch_limit && !suppress_next_result_prefetching_) {
+    uint64_t cap = FLAGS_ysql_adaptive_prefetch_max_limit;
+    if (!req.is_forward_scan()) {
+      cap = cap * FLAGS_ysql_backward_prefetch_scale_factor;
+    }
+    if (!exec_params_.limit_use_default) {
+      cap = std::min<uint64_t>(cap, exec_params_.limit_count + exec_params_.limit_offset);
+    }
+    cap = std::max<uint64_t>(cap, 1);
+    limit = std::min<uint64_t>({
+        limit, cap, std::max<uint64_t>(FLAGS_ysql_adaptive_prefetch_initial_limit, 1)});
+    if (limit < cap) {
+      prefetch_limit_cap_ = cap;
+    }
+    req.set_size_limit(FLAGS_ysql_adaptive_prefetch_size_limit);
+  }
   VLOG(3) << __func__
           << " exec_params_.limit_count=" << exec_params_.limit_count
           << " exec_params_.limit_offset=" << exec_params_.limit_offset
           << " exec_params_.limit_use_default=" << exec_params_.limit_use_default
           << " predicted_limit=" << predicted_limit
-          << " limit=" << limit;
+          << " limit=" << limit
+          << " prefetch_limit_cap_=" << prefetch_limit_cap_;
   req.set_limit(limit);
 }
 
@@ -52,6 +52,11 @@ class PgDocResult {
     return row_count_ == 0 || row_iterator_.empty();
   }
 
+  // Size of rows data that is not yet consumed.
+  size_t remaining_bytes() const {
+    return row_iterator_.size();
+  }
+
   // Get the postgres tuple from this batch.
   CHECKED_STATUS WritePgTuple(const std::vector<PgExpr*>& targets, PgTuple *pg_tuple,
                               int64_t *row_order);
@@ -237,6 +242,12 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
 
   // Get the result of the op. No rows will be added to rowsets in case end of data reached.
   CHECKED_STATUS GetResult(std::list<PgDocResult> *rowsets);
+
+  // If the response for the prefetched request has already arrived and rowsets do not hold more
+  // than ysql_eager_prefetch_buffer_limit bytes of unconsumed rows, appends its rows to rowsets and
+  // sends the request for the next portion of data. So the tablet server scans the next page while
+  // the executor is still processing buffered rows. Does nothing otherwise, never blocks.
+  CHECKED_STATUS PrefetchIfReady(std::list<PgDocResult> *rowsets);
   Result<int32_t> GetRowsAffectedCount() const;
 
   // This operation is requested internally within PgGate, and that request does not go through
@@ -347,6 +358,9 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
   //   should only be done when "wait_for_batch_completion_ == false"
   bool wait_for_batch_completion_ = true;
 
+  // Processes arrived response, appends its rows to rowsets and prefetches next portion of data.
+  CHECKED_STATUS ReceiveResponse(std::list<PgDocResult> *rowsets);
+
   // Future object to fetch a response from DocDB after sending a request.
   // Object's valid() method returns false in case no request is sent
   // or sent request was buffered by the session.
@@ -504,6 +518,10 @@ class PgDocReadOp : public PgDocOp {
   // Template operation, used to fill in pgsql_ops_ by either assigning or cloning.
   PgsqlReadOpPtr read_op_;
 
+  // Max number of rows that adaptive prefetching could grow the request limit to.
+  // Zero means that the request limit stays as it was set by SetRequestPrefetchLimit.
+  uint64_t prefetch_limit_cap_ = 0;
+
   // While sampling is in progress, number of scanned row is accumulated in this variable.
   // After completion the value is extrapolated to account for not scanned partitions and estimate
   // total number of rows in the table.
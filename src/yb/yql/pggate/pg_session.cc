@@ -204,6 +204,10 @@ bool PerformFuture::Valid() const {
   return session_ != nullptr;
 }
 
+bool PerformFuture::Ready() const {
+  return Valid() && future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
 CHECKED_STATUS PerformFuture::Get() {
   auto result = future_.get();
   auto session = session_;
@@ -720,6 +724,12 @@ void PgSession::Perform(PgsqlOps* operations, const PerformCallback& callback) {
     }
     options.set_use_catalog_session(true);
     use_catalog_session_ = false;
+    if (FLAGS_ysql_enable_catalog_response_cache) {
+      auto catalog_version = GetSharedCatalogVersion();
+      if (catalog_version.ok()) {
+        options.set_catalog_cache_version(*catalog_version);
+      }
+    }
   } else {
     pg_txn_manager_->SetupPerformOptions(&options);
 
@@ -109,6 +109,9 @@ class PerformFuture {
 
   bool Valid() const;
 
+  // Whether the response has already arrived, so Get would not block.
+  bool Ready() const;
+
   CHECKED_STATUS Get();
  private:
   std::future<PerformResult> future_;
@@ -417,6 +417,9 @@ void PgTxnManager::SetupPerformOptions(tserver::PgPerformOptionsPB* options) {
   read_time_manipulation_ = tserver::ReadTimeManipulation::NONE;
   if (read_time_for_follower_reads_) {
     ReadHybridTime::SingleTime(read_time_for_follower_reads_).ToPB(options->mutable_read_time());
+    if (FLAGS_ysql_follower_reads_bounded_staleness) {
+      options->set_follower_read_max_staleness_ms(follower_read_staleness_ms_);
+    }
   }
 }
 
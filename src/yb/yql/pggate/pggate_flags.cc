@@ -18,8 +18,11 @@
 #include <gflags/gflags.h>
 
 #include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
 #include "yb/yql/pggate/pggate_flags.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(pgsql_rpc_keepalive_time_ms, 0,
              "If an RPC connection from a client is idle for this amount of time, the server "
              "will disconnect the client. Setting flag to 0 disables this clean up.");
@@ -53,6 +56,39 @@ DEFINE_uint64(ysql_prefetch_limit, 1024,
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
+DEFINE_bool(ysql_adaptive_prefetch_limit, false,
+            "Start scans with a small page and grow it geometrically while the executor keeps "
+            "consuming rows, instead of always prefetching ysql_prefetch_limit rows");
+TAG_FLAG(ysql_adaptive_prefetch_limit, advanced);
+
+DEFINE_uint64(ysql_adaptive_prefetch_initial_limit, 64,
+              "Number of rows in the first page of a scan when ysql_adaptive_prefetch_limit is "
+              "set");
+TAG_FLAG(ysql_adaptive_prefetch_initial_limit, advanced);
+
+DEFINE_uint64(ysql_adaptive_prefetch_max_limit, 16384,
+              "Maximum number of rows in a page of a scan when ysql_adaptive_prefetch_limit is "
+              "set");
+TAG_FLAG(ysql_adaptive_prefetch_max_limit, advanced);
+
+DEFINE_uint64(ysql_adaptive_prefetch_size_limit, 4_MB,
+              "Maximum size of rows data in a page of a scan when ysql_adaptive_prefetch_limit is "
+              "set. Zero means no limit");
+TAG_FLAG(ysql_adaptive_prefetch_size_limit, advanced);
+
+DEFINE_uint64(ysql_eager_prefetch_buffer_limit, 0,
+              "When the response for the next page of a scan arrives while the executor is still "
+              "processing the previous pages, and buffered rows data is below this size, the page "
+              "is accepted right away and the request for the following page is sent. "
+              "Zero disables eager prefetching");
+TAG_FLAG(ysql_eager_prefetch_buffer_limit, advanced);
+
+DEFINE_bool(ysql_enable_catalog_response_cache, false,
+            "Allow full scans of catalog tables, e.g. ones used to preload catalog caches of a new "
+            "connection, to be served from the local tablet server response cache for the same "
+            "catalog version");
+TAG_FLAG(ysql_enable_catalog_response_cache, advanced);
+
 DEFINE_uint64(ysql_session_max_batch_size, 512,
               "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
               "services");
@@ -130,6 +166,11 @@ DEFINE_bool(ysql_sleep_before_retry_on_txn_conflict, true,
 // - Use boolean experimental flag just in case introducing "ybRunContext" is a wrong idea.
 DEFINE_bool(ysql_disable_portal_run_context, false, "Whether to use portal ybRunContext.");
 
+DEFINE_bool(ysql_follower_reads_bounded_staleness, false,
+            "If set, a follower whose safe time is staler than yb_follower_read_staleness_ms of "
+            "the session rejects the follower read, so it is retried on another replica instead "
+            "of waiting for the safe time to catch up.");
+
 DEFINE_bool(yb_enable_read_committed_isolation, false,
             "Defines how READ COMMITTED (which is our default SQL-layer isolation) and"
             "READ UNCOMMITTED are mapped internally. If false (default), both map to the stricter "
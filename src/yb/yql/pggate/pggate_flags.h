@@ -26,6 +26,12 @@ DECLARE_bool(TEST_pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_request_limit);
 DECLARE_uint64(ysql_prefetch_limit);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
+DECLARE_bool(ysql_adaptive_prefetch_limit);
+DECLARE_uint64(ysql_adaptive_prefetch_initial_limit);
+DECLARE_uint64(ysql_adaptive_prefetch_max_limit);
+DECLARE_uint64(ysql_adaptive_prefetch_size_limit);
+DECLARE_uint64(ysql_eager_prefetch_buffer_limit);
+DECLARE_bool(ysql_enable_catalog_response_cache);
 DECLARE_uint64(ysql_session_max_batch_size);
 DECLARE_bool(ysql_non_txn_copy);
 DECLARE_int32(ysql_max_read_restart_attempts);
@@ -45,5 +51,6 @@ DECLARE_bool(ysql_serializable_isolation_for_ddl_txn);
 DECLARE_int32(ysql_max_write_restart_attempts);
 DECLARE_bool(ysql_sleep_before_retry_on_txn_conflict);
 DECLARE_bool(ysql_disable_portal_run_context);
+DECLARE_bool(ysql_follower_reads_bounded_staleness);
 
 #endif  // YB_YQL_PGGATE_PGGATE_FLAGS_H
@@ -24,6 +24,9 @@
 
 #include "yb/docdb/value_type.h"
 
+#include "yb/gutil/casts.h"
+#include "yb/gutil/map-util.h"
+
 #include "yb/integration-tests/mini_cluster.h"
 
 #include "yb/master/catalog_entity_info.h"
@@ -41,7 +44,11 @@
 
 #include "yb/tools/tools_test_utils.h"
 
+#include "yb/tserver/mini_tablet_server.h"
+#include "yb/tserver/tablet_server.h"
+
 #include "yb/util/atomic.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status_log.h"
@@ -69,6 +76,8 @@ DECLARE_int64(db_write_buffer_size);
 DECLARE_bool(rocksdb_use_logging_iterator);
 DECLARE_bool(enable_automatic_tablet_splitting);
 DECLARE_int32(yb_num_shards_per_tserver);
+DECLARE_int32(ysql_aggregate_scan_parallelism);
+DECLARE_bool(ysql_batch_ybctid_multi_get);
 DECLARE_int64(tablet_split_low_phase_size_threshold_bytes);
 DECLARE_int64(tablet_split_high_phase_size_threshold_bytes);
 DECLARE_int64(tablet_split_low_phase_shard_count_per_node);
@@ -84,6 +93,8 @@ DECLARE_int64(db_index_block_size_bytes);
 DECLARE_int64(tablet_force_split_threshold_bytes);
 DECLARE_int64(TEST_inject_random_delay_on_txn_status_response_ms);
 
+METRIC_DECLARE_histogram(handler_latency_yb_tserver_TabletServerService_Read);
+
 namespace yb {
 namespace pgwrapper {
 namespace {
@@ -1692,6 +1703,88 @@ class PgMiniBigPrefetchTest : public PgMiniSingleTServerTest {
   }
 };
 
+class PgMiniAdaptivePrefetchTest : public PgMiniSingleTServerTest {
+ protected:
+  static constexpr uint64_t kInitialLimit = 16;
+  static constexpr uint64_t kMaxLimit = 256;
+
+  void SetUp() override {
+    FLAGS_ysql_adaptive_prefetch_limit = true;
+    FLAGS_ysql_adaptive_prefetch_initial_limit = kInitialLimit;
+    FLAGS_ysql_adaptive_prefetch_max_limit = kMaxLimit;
+    PgMiniTest::SetUp();
+  }
+
+  uint64_t GetReadRPCCount() {
+    auto metric_map =
+        cluster_->mini_tablet_server(0)->server()->metric_entity()->UnsafeMetricsMapForTests();
+    return down_cast<Histogram*>(FindOrDie(
+        metric_map,
+        &METRIC_handler_latency_yb_tserver_TabletServerService_Read).get())->TotalCount();
+  }
+
+  // Returns number of read RPCs used to fetch all rows of the query.
+  Result<uint64_t> CountReads(PGConn* conn, const std::string& query, int expected_rows) {
+    auto initial_count = GetReadRPCCount();
+    auto result = VERIFY_RESULT(conn->Fetch(query));
+    SCHECK_EQ(PQntuples(result.get()), expected_rows, IllegalState, "Wrong number of rows");
+    return GetReadRPCCount() - initial_count;
+  }
+};
+
+// Pages of a scan start with ysql_adaptive_prefetch_initial_limit rows and are doubled until
+// ysql_adaptive_prefetch_max_limit, also when statement LIMIT is bigger than that.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(AdaptivePrefetchGrowth), PgMiniAdaptivePrefetchTest) {
+  constexpr int kRows = 1000;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY) SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat("INSERT INTO t SELECT generate_series(1, $0)", kRows));
+
+  const uint64_t max_limit = kMaxLimit;
+  uint64_t expected_reads = 0;
+  for (uint64_t fetched = 0, page = kInitialLimit; fetched < kRows;
+       page = std::min(page * 2, max_limit)) {
+    fetched += page;
+    ++expected_reads;
+  }
+
+  ASSERT_EQ(ASSERT_RESULT(CountReads(&conn, "SELECT * FROM t", kRows)), expected_reads);
+  // LIMIT is bigger than ysql_prefetch_limit, so pages are still grown, but never beyond
+  // ysql_adaptive_prefetch_max_limit.
+  ASSERT_EQ(ASSERT_RESULT(CountReads(
+      &conn, Format("SELECT * FROM t LIMIT $0", FLAGS_ysql_prefetch_limit + 1), kRows)),
+      expected_reads);
+}
+
+class PgMiniAdaptivePrefetchSizeLimitTest : public PgMiniAdaptivePrefetchTest {
+ protected:
+  static constexpr size_t kSizeLimit = 4_KB;
+
+  void SetUp() override {
+    FLAGS_ysql_adaptive_prefetch_size_limit = kSizeLimit;
+    PgMiniAdaptivePrefetchTest::SetUp();
+  }
+};
+
+// Pages are cut by ysql_adaptive_prefetch_size_limit, before they reach the row limit.
+TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(AdaptivePrefetchSizeLimit),
+          PgMiniAdaptivePrefetchSizeLimitTest) {
+  constexpr int kRows = 64;
+  constexpr size_t kValueSize = 1_KB;
+  auto conn = ASSERT_RESULT(Connect());
+
+  ASSERT_OK(conn.Execute(
+      "CREATE TABLE t (key INT PRIMARY KEY, value TEXT) SPLIT INTO 1 TABLETS"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, repeat('x', $0) FROM generate_series(1, $1) i",
+      kValueSize, kRows));
+
+  // Size limit is checked after each row, so a page contains at most one row over the limit.
+  auto reads = ASSERT_RESULT(CountReads(&conn, "SELECT * FROM t", kRows));
+  ASSERT_GE(reads, kRows * kValueSize / (kSizeLimit + kValueSize));
+}
+
 TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BigRead), PgMiniBigPrefetchTest) {
   constexpr int kRows = RegularBuildVsDebugVsSanitizers(1000000, 100000, 10000);
   constexpr int kBlockSize = 1000;
@@ -2502,5 +2595,75 @@ TEST_F_EX(PgMiniTest, YB_DISABLE_TEST_IN_SANITIZERS_OR_MAC(NonRespondingMaster),
        "create"}));
 }
 
+// Aggregates computed by scanning key ranges of a tablet with several SST files in parallel should
+// match the sequential scan.
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(ParallelAggregateScan)) {
+  constexpr int kNumBatches = 4;
+  constexpr int kRowsPerBatch = 1000;
+  constexpr int kNumColumns = 4;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT) SPLIT INTO 1 TABLETS"));
+  for (int i = 0; i != kNumBatches; ++i) {
+    ASSERT_OK(conn.ExecuteFormat(
+        "INSERT INTO t SELECT i, i % 97 FROM generate_series($0, $1) AS i",
+        i * kRowsPerBatch + 1, (i + 1) * kRowsPerBatch));
+    ASSERT_OK(cluster_->FlushTablets(tablet::FlushMode::kSync));
+  }
+
+  auto fetch = [&conn](const std::string& query) -> Result<std::string> {
+    auto res = VERIFY_RESULT(conn.FetchMatrix(query, 1, kNumColumns));
+    std::string result;
+    for (int column = 0; column != kNumColumns; ++column) {
+      result += VERIFY_RESULT(ToString(res.get(), 0, column)) + " ";
+    }
+    return result;
+  };
+
+  for (const auto* query : {
+      "SELECT COUNT(*), SUM(value), MIN(value), MAX(value) FROM t",
+      "SELECT COUNT(*), SUM(key), MIN(key), MAX(key) FROM t WHERE value < 10"}) {
+    FLAGS_ysql_aggregate_scan_parallelism = 1;
+    const auto expected = ASSERT_RESULT(fetch(query));
+    LOG(INFO) << query << ": " << expected;
+    FLAGS_ysql_aggregate_scan_parallelism = 4;
+    ASSERT_EQ(ASSERT_RESULT(fetch(query)), expected);
+  }
+  ASSERT_EQ(ASSERT_RESULT(conn.FetchValue<int64_t>("SELECT COUNT(*) FROM t")),
+            kNumBatches * kRowsPerBatch);
+}
+
+// Rows of an index scan fetched by a batch of ybctids with a single iterator should be returned in
+// the index order, the same way as when they are fetched one by one.
+TEST_F(PgMiniTest, YB_DISABLE_TEST_IN_TSAN(BatchYbctidMultiGet)) {
+  constexpr int kNumRows = 1000;
+
+  auto conn = ASSERT_RESULT(Connect());
+  ASSERT_OK(conn.Execute("CREATE TABLE t (key INT PRIMARY KEY, value INT, payload TEXT)"));
+  ASSERT_OK(conn.Execute("CREATE INDEX ON t (value ASC)"));
+  ASSERT_OK(conn.ExecuteFormat(
+      "INSERT INTO t SELECT i, (i * 37) % $0, 'payload_' || i FROM generate_series(1, $0) AS i",
+      kNumRows));
+  // Missing rows should be skipped.
+  ASSERT_OK(conn.Execute("DELETE FROM t WHERE key % 10 = 0"));
+
+  auto fetch = [&conn]() -> Result<std::string> {
+    auto res = VERIFY_RESULT(conn.Fetch(
+        "SELECT key, payload FROM t WHERE value < 500 ORDER BY value"));
+    std::string result;
+    for (int row = 0; row != PQntuples(res.get()); ++row) {
+      result += VERIFY_RESULT(ToString(res.get(), row, 0)) + ":" +
+                VERIFY_RESULT(ToString(res.get(), row, 1)) + " ";
+    }
+    return result;
+  };
+
+  FLAGS_ysql_batch_ybctid_multi_get = false;
+  const auto expected = ASSERT_RESULT(fetch());
+  ASSERT_FALSE(expected.empty());
+  FLAGS_ysql_batch_ybctid_multi_get = true;
+  ASSERT_EQ(ASSERT_RESULT(fetch()), expected);
+}
+
 } // namespace pgwrapper
 } // namespace yb
@@ -23,7 +23,9 @@
 #include "yb/rpc/reactor.h"
 #include "yb/rpc/rpc_introspection.pb.h"
 
+#include "yb/util/atomic.h"
 #include "yb/util/debug/trace_event.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/format.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/metrics.h"
@@ -44,6 +46,12 @@ DEFINE_uint64(redis_max_concurrent_commands, 1,
               "Max number of redis commands received from single connection, "
               "that could be processed concurrently");
 DEFINE_uint64(redis_max_batch, 500, "Max number of redis commands that forms batch");
+DEFINE_bool(redis_coalesce_pipelined_commands, true,
+            "While the connection has max concurrent commands in flight, keep received pipelined "
+            "commands in the read buffer instead of queueing them as separate calls, so they are "
+            "executed as a single batch once the running call completes.");
+TAG_FLAG(redis_coalesce_pipelined_commands, advanced);
+TAG_FLAG(redis_coalesce_pipelined_commands, runtime);
 DEFINE_int32(rpcz_max_redis_query_dump_size, 4_KB,
              "The maximum size of the Redis query string in the RPCZ dump.");
 DEFINE_uint64(redis_max_read_buffer_size, 128_MB,
@@ -105,7 +113,17 @@ Result<rpc::ProcessCallsResult> RedisConnectionContext::ProcessCalls(
   // Create call for rest of commands.
   // Do not form new call if we are in a middle of command.
   // It means that soon we should receive remaining data for this command and could wait.
-  if (commands_in_batch_ > 0 && (end_of_batch_ == IoVecsFullSize(data) || read_buffer_full)) {
+  // Also do not form new call if it would just wait in the queue behind running calls, commands
+  // received meanwhile are appended to the same batch. It does not delay the commands, since they
+  // could not start before the running call completes anyway.
+  bool defer = false;
+  if (commands_in_batch_ > 0 && !read_buffer_full && all_call_slots_busy() &&
+      GetAtomicFlag(&FLAGS_redis_coalesce_pipelined_commands)) {
+    CallsDeferred();
+    defer = true;
+  }
+  if (commands_in_batch_ > 0 && !defer &&
+      (end_of_batch_ == IoVecsFullSize(data) || read_buffer_full)) {
     rpc::CallData call_data(end_of_batch_ - begin_of_batch);
     IoVecsToBuffer(data, begin_of_batch, end_of_batch_, call_data.data());
     RETURN_NOT_OK(HandleInboundCall(connection, commands_in_batch_, &call_data));